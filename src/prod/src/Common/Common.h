@@ -288,6 +288,7 @@ typedef int pid_t;
 #include "Common/Threadpool.h"
 #ifdef PLATFORM_UNIX
 #include "Common/TimerQueue.h"
+#include "Common/TimerWheel.h"
 #include "Common/EventLoop.h"
 #endif
 #include "Common/Timer.h"
@@ -521,6 +522,7 @@ typedef int pid_t;
 #include "Common/JsonInterface.h"
 #include "Common/JsonReaderWriter.h"
 #include "Common/JsonReaderHelper.h"
+#include "Common/JsonScanner.h"
 #include "Common/JsonWriter.h"
 #include "Common/JsonReader.h"
 
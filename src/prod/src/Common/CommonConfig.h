@@ -57,6 +57,15 @@ namespace Common
         // Dispatch time threshold for TimerQueue timer, longer dispatch time will be traced out
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Common", TimerQueueDispatchTimeThreshold, Common::TimeSpan::FromSeconds(0.1), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
 
+        // Use sharded timing wheel for Common::Timer instead of one POSIX timer per Timer object
+        INTERNAL_CONFIG_ENTRY(bool, L"Common", TimerWheelEnabled, true, ConfigEntryUpgradePolicy::Dynamic);
+        // Timing wheel resolution, timer due time is rounded up to a multiple of this
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Common", TimerWheelTickInterval, Common::TimeSpan::FromMilliseconds(1), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Count of timing wheel shards, default to 0 to use processor count
+        INTERNAL_CONFIG_ENTRY(uint, L"Common", TimerWheelShardCount, 0, ConfigEntryUpgradePolicy::Static);
+        // Count of expired timers dispatched by each threadpool work item
+        INTERNAL_CONFIG_ENTRY(uint, L"Common", TimerWheelDispatchBatchSize, 16, ConfigEntryUpgradePolicy::Static, Common::UIntGreaterThan(0));
+
         // Count of concurrent event loops for sockets, linux only, default to 0 to use processor current. 
         DEPRECATED_CONFIG_ENTRY(uint, L"Common", EventLoopConcurrency, 0, Common::ConfigEntryUpgradePolicy::Static);
         // Cleanup delay for fd context used in event loop
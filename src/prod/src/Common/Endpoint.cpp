@@ -71,6 +71,10 @@ namespace Common
 {
     using namespace std;
 
+#ifdef PLATFORM_UNIX
+    WStringLiteral const UnixDomainAddressPrefix(L"unix:");
+#endif
+
     // 
     // Returns a 32 bit mask to be used with adresses in network byte order
     //
@@ -150,6 +154,67 @@ namespace Common
     }
 
 
+#ifdef PLATFORM_UNIX
+    bool Endpoint::IsUnixDomainAddress(std::wstring const & str)
+    {
+        return StringUtility::StartsWith(str, UnixDomainAddressPrefix);
+    }
+
+    ErrorCode Endpoint::TryParseUnixDomain(std::wstring const & str, Endpoint & ep)
+    {
+        ::ZeroMemory(&ep.address, sizeof(ep.address));
+
+        if (!IsUnixDomainAddress(str))
+        {
+            return ErrorCodeValue::InvalidAddress;
+        }
+
+        string path;
+        StringUtility::Utf16ToUtf8(str.substr(UnixDomainAddressPrefix.size()), path);
+
+        auto sockAddrUn = reinterpret_cast<sockaddr_un*>(&ep.address);
+        if (path.size() >= sizeof(sockAddrUn->sun_path))
+        {
+            return ErrorCodeValue::InvalidAddress;
+        }
+
+        // An empty path is what accept() reports for an unbound (connecting) peer
+        sockAddrUn->sun_family = AF_UNIX;
+        memcpy(sockAddrUn->sun_path, path.c_str(), path.size());
+        if (!path.empty() && path[0] == '@')
+        {
+            sockAddrUn->sun_path[0] = 0;
+        }
+
+        return ErrorCodeValue::Success;
+    }
+
+    wstring Endpoint::GetUnixDomainPath() const
+    {
+        Invariant(IsUnixDomain());
+
+        auto sockAddrUn = reinterpret_cast<sockaddr_un const*>(&address);
+        string path;
+        if (sockAddrUn->sun_path[0] == 0)
+        {
+            // Abstract names are zero padded to the full length, see get_AddressLength
+            size_t length = strnlen(sockAddrUn->sun_path + 1, sizeof(sockAddrUn->sun_path) - 1);
+            if (length > 0)
+            {
+                path = "@" + string(sockAddrUn->sun_path + 1, length);
+            }
+        }
+        else
+        {
+            path = string(sockAddrUn->sun_path, strnlen(sockAddrUn->sun_path, sizeof(sockAddrUn->sun_path)));
+        }
+
+        wstring result;
+        StringUtility::Utf8ToUtf16(path, result);
+        return result;
+    }
+#endif
+
     //////////////////////////////////////////////////////////////////////
     //
     // Endpoint
@@ -189,12 +254,21 @@ namespace Common
         //
         // It is acceptable for sockaddr to be completely 0
         //
+#ifdef PLATFORM_UNIX
+        ASSERT_IFNOT(
+            addr.sa_family == AF_INET || addr.sa_family == AF_INET6 || addr.sa_family == AF_UNIX || addr.sa_family == 0,
+            "Invalid address family");
+
+        size_t size = ( addr.sa_family == AF_UNIX ) ? sizeof( sockaddr_un ) :
+            (( addr.sa_family == AF_INET ) ? sizeof( sockaddr_in ) : sizeof( sockaddr_in6 ));
+#else
         ASSERT_IFNOT(
             addr.sa_family == AF_INET || addr.sa_family == AF_INET6 || addr.sa_family == 0,
             "Invalid address family");
 
 #pragma prefast(suppress: 24002, "IPv4 and IPv6 code paths provided")
         size_t size = ( addr.sa_family == AF_INET ) ? sizeof( sockaddr_in ) : sizeof( sockaddr_in6 );
+#endif
         ::ZeroMemory( &address, sizeof( address ) );
         KMemCpySafe(&address, sizeof(address), &addr, size);
     }
@@ -245,6 +319,12 @@ namespace Common
 
     bool Endpoint::IsLoopback()const
     {
+        if (IsUnixDomain())
+        {
+            // Unix domain sockets never leave the machine
+            return true;
+        }
+
         if (IsIPv4())
         {
             static const int loopbackMask = INADDR_LOOPBACK & 0xff000000;
@@ -334,6 +414,14 @@ namespace Common
 
     void Endpoint::ToString(std::wstring& result) const
     {
+#ifdef PLATFORM_UNIX
+        if (IsUnixDomain())
+        {
+            result = wstring(UnixDomainAddressPrefix.begin(), UnixDomainAddressPrefix.end()) + GetUnixDomainPath();
+            return;
+        }
+#endif
+
         result = wformatString("{0}:{1}", GetIpString2(), Port);
     }
 
@@ -460,6 +548,16 @@ namespace Common
                             &reinterpret_cast<const struct ::sockaddr_in*>(&rhs.address)->sin_addr,
                             sizeof(in_addr));
             }
+#ifdef PLATFORM_UNIX
+            else if (address.ss_family == AF_UNIX)
+            {
+                return
+                    0 < ::memcmp(
+                    reinterpret_cast<const sockaddr_un*>(&address)->sun_path,
+                    reinterpret_cast<const sockaddr_un*>(&rhs.address)->sun_path,
+                    sizeof(reinterpret_cast<const sockaddr_un*>(&address)->sun_path));
+            }
+#endif
             else
             {
                 return
@@ -7,6 +7,9 @@
 
 #include <ws2ipdef.h>
 #include <mstcpip.h>
+#ifdef PLATFORM_UNIX
+#include <sys/un.h>
+#endif
 
 //#ifndef _PREFAST_
 //#  pragma warning(disable:4068)
@@ -27,7 +30,8 @@ namespace Common
             Unknown             = -1,   // Unknown
             Unspecified = AF_UNSPEC,    // unspecified
             InterNetwork        = AF_INET,
-            InterNetworkV6        = AF_INET6
+            InterNetworkV6        = AF_INET6,
+            Unix                = AF_UNIX
         };
     };
 
@@ -71,6 +75,15 @@ namespace Common
 
         static ErrorCode TryParse(std::wstring const & input, Endpoint & output);
 
+#ifdef PLATFORM_UNIX
+        //
+        // Unix domain socket addresses are written as "unix:<path>", a leading '@' in the path
+        // selects the abstract namespace
+        //
+        static bool IsUnixDomainAddress(std::wstring const & input);
+        static ErrorCode TryParseUnixDomain(std::wstring const & input, Endpoint & output);
+#endif
+
         explicit Endpoint() 
         {
             ZeroMemory( &address, sizeof(address) );
@@ -101,6 +114,10 @@ namespace Common
 
         int get_AddressLength() const
         {
+#ifdef PLATFORM_UNIX
+            // Always the full sockaddr_un, so that abstract names are padded the same way on bind and connect
+            if ( address.ss_family == AF_UNIX ) return sizeof( sockaddr_un );
+#endif
             debug_assert( address.ss_family == AF_INET6 || address.ss_family == AF_INET );
 
 #pragma prefast(suppress: 24002, "IPv4 and IPv6 code paths provided")
@@ -125,12 +142,16 @@ namespace Common
 
         ::USHORT get_Port() const
         {
+            if ( IsUnixDomain() ) return 0;
+
             // note that this works also for sockaddr_in6
             return ntohs(reinterpret_cast<const struct ::sockaddr_in*>(&address)->sin_port);
         }
 
         void put_Port( ::USHORT value )
         {
+            if ( IsUnixDomain() ) return;
+
             // note that this works also for sockaddr_in6
             reinterpret_cast<struct ::sockaddr_in*>(&address)->sin_port = htons(value);
         }
@@ -168,6 +189,16 @@ namespace Common
             return IsIPV6();
         }
 
+        bool IsUnixDomain () const
+        {
+            return (address.ss_family == AF_UNIX);
+        }
+
+#ifdef PLATFORM_UNIX
+        // '@' is returned in place of the leading null of an abstract name
+        std::wstring GetUnixDomainPath() const;
+#endif
+
         // ipString must be large enough to hold INET_ADDRSTRLEN/INET6_ADDRSTRLEN characters, depending on address type
         void GetIpString(_Out_writes_(size) WCHAR * ipString, socklen_t size = INET6_ADDRSTRLEN) const;
         void GetIpString(_Out_ std::wstring & ipString) const;
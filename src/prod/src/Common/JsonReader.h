@@ -81,14 +81,57 @@ namespace Common
 
         void Skip(DWORD dwCharsToSkip)
         {
-            // TODO: Fast path for UTF-16
             while(dwCharsToSkip)
             {
+                // Characters that are a single code unit are skipped in bulk
+                DWORD dwRunLength = JsonBufferManagerTraits<CharType>::GetSingleUnitRunLength(m_pszCharBuffer, __min(dwCharsToSkip, GetRemainingLength(m_pszCharBuffer)));
+                m_pszCharBuffer += dwRunLength;
+                dwCharsToSkip -= dwRunLength;
+                if(!dwCharsToSkip) break;
+
                 if(!Read()) break; // GetChar returns 0 if we hit the end of the buffer
                 dwCharsToSkip--;
             }
         }
 
+        // Advances past json whitespace to the start of the next token or to the end of the buffer
+        //
+        void SkipWhitespace()
+        {
+            if(m_pszCharBuffer == nullptr || m_pszCharBuffer < m_pszCharBufferStart) return;
+
+            m_pszCharBuffer += JsonBufferManagerTraits<CharType>::GetWhitespaceRunLength(m_pszCharBuffer, GetRemainingLength(m_pszCharBuffer));
+        }
+
+        // Same context semantics as Peek. Advances past the characters of a string token that need no decoding, i.e. up to the next
+        // quote, backslash, control character, multi unit character or the end of the buffer, and returns how many were passed.
+        // If pszDest is not nullptr, the characters are also copied to it; it must have room for dwMaxChars characters.
+        //
+        DWORD PeekStringRun(void** ppContext, __out_ecount_opt(dwMaxChars) LPWSTR pszDest, DWORD dwMaxChars) const
+        {
+            if(ppContext == nullptr || m_pszCharBuffer == nullptr) return 0;
+
+            const CharType** ppszBuffer = (const CharType**)ppContext;
+            if(*ppszBuffer == nullptr)
+            {
+                *ppszBuffer = m_pszCharBuffer;
+            }
+
+            if(*ppszBuffer < m_pszCharBufferStart) return 0;
+
+            DWORD dwRunLength = JsonBufferManagerTraits<CharType>::GetStringRunLength(*ppszBuffer, __min(dwMaxChars, GetRemainingLength(*ppszBuffer)));
+            if(pszDest != nullptr)
+            {
+                for(DWORD i = 0; i < dwRunLength; i++)
+                {
+                    pszDest[i] = static_cast<WCHAR>((*ppszBuffer)[i]);
+                }
+            }
+
+            *ppszBuffer += dwRunLength;
+            return dwRunLength;
+        }
+
     private:
         WCHAR GetNextUTF8Char(LPCSTR* ppszBuffer) const
         {
@@ -182,6 +225,11 @@ namespace Common
             return pszStart >= m_pszCharBufferStart + m_nBufferLength; 
         }
 
+        DWORD GetRemainingLength(const CharType* pszStart) const
+        {
+            return IsEOF(pszStart) ? 0 : (DWORD)(m_pszCharBufferStart + m_nBufferLength - pszStart);
+        }
+
     private:
         const CharType*  m_pszCharBuffer;
         const CharType*  m_pszCharBufferStart;
@@ -249,6 +297,21 @@ namespace Common
             *ppszBuffer += 1;
             return 0;
         }
+
+        static DWORD GetSingleUnitRunLength(LPCSTR pszBuffer, DWORD nLength)
+        {
+            return (DWORD)JsonScanner::FindNonAsciiCharacter(pszBuffer, nLength);
+        }
+
+        static DWORD GetWhitespaceRunLength(LPCSTR pszBuffer, DWORD nLength)
+        {
+            return (DWORD)JsonScanner::FindNonWhitespaceCharacter(pszBuffer, nLength);
+        }
+
+        static DWORD GetStringRunLength(LPCSTR pszBuffer, DWORD nLength)
+        {
+            return (DWORD)JsonScanner::FindStringSpecialCharacter(pszBuffer, nLength);
+        }
     };
     //-------------------------------------------------------------------------------------------------------------------------------------------
     template<>
@@ -266,6 +329,27 @@ namespace Common
             WCHAR wc = *(*ppszBuffer)++;
             return (wc & 0xF800) == 0xD800 ? 0 : wc;
         }
+
+        static DWORD GetSingleUnitRunLength(LPCWSTR pszBuffer, DWORD nLength)
+        {
+            DWORD i = 0;
+            while(i < nLength && pszBuffer[i] != 0 && (pszBuffer[i] & 0xF800) != 0xD800) i++;
+            return i;
+        }
+
+        static DWORD GetWhitespaceRunLength(LPCWSTR pszBuffer, DWORD nLength)
+        {
+            DWORD i = 0;
+            while(i < nLength && (pszBuffer[i] == L' ' || pszBuffer[i] == L'\t' || pszBuffer[i] == L'\r' || pszBuffer[i] == L'\n')) i++;
+            return i;
+        }
+
+        static DWORD GetStringRunLength(LPCWSTR pszBuffer, DWORD nLength)
+        {
+            DWORD i = 0;
+            while(i < nLength && pszBuffer[i] >= 0x20 && pszBuffer[i] < 0x80 && pszBuffer[i] != L'"' && pszBuffer[i] != L'\\') i++;
+            return i;
+        }
     };
     //-------------------------------------------------------------------------------------------------------------------------------------------
     class JsonReader2
@@ -391,6 +475,10 @@ namespace Common
 
             for(DWORD i=0;i < m_dwStringLength;i++)
             {
+                // Copy the characters that need no unescaping or decoding in bulk
+                i += m_bufferManager.PeekStringRun(&pContext, pszBuffer + i, m_dwStringLength - i);
+                if(i == m_dwStringLength) break;
+
                 wcCurrent = m_bufferManager.Peek(&pContext);
                 if(wcCurrent == L'\\')
                 {
@@ -460,10 +548,7 @@ namespace Common
 
             // Skip past whitespace to the start of the next token (or to the end of the
             // buffer if the whitespace is trailing)
-            while(IsWhitespace(m_bufferManager.Peek()))
-            {
-                m_bufferManager.Read();
-            }
+            m_bufferManager.SkipWhitespace();
 
             switch(m_bufferManager.Peek())
             {
@@ -718,6 +803,13 @@ namespace Common
                 }
 
                 wcPrevious = wcCurrent;
+
+                // Count the following run of plain characters in bulk. They are never a quote or a backslash,
+                // so the closing quote is still detected after the run.
+                DWORD dwRunLength = m_bufferManager.PeekStringRun(&pContext, nullptr, (DWORD)-1);
+                dwTokenLength += dwRunLength;
+                dwStringLength += dwRunLength;
+
                 wcCurrent = m_bufferManager.Peek(&pContext);
             }
 
@@ -0,0 +1,258 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define JSON_SCANNER_SSE2_SUPPORTED
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace Common
+{
+    //-------------------------------------------------------------------------------------------------------------------------------------------
+    // Block scanning helpers used by the json reader and writer to find the next character that needs per character processing.
+    // Each method returns the index of the first such character, or the length of the input if there is none.
+    // Sixteen bytes are classified at a time with SSE2 on x64, and eight bytes at a time with plain 64 bit arithmetic elsewhere.
+    //
+    class JsonScanner
+    {
+    public:
+        // Finds the first byte that is a quote, a backslash, a control character or the start of a multi byte UTF-8 sequence.
+        // All bytes before it are single byte characters that can be copied into a string value as is.
+        //
+        static size_t FindStringSpecialCharacter(LPCSTR pszBuffer, size_t nLength)
+        {
+            size_t i = 0;
+#if defined(JSON_SCANNER_SSE2_SUPPORTED)
+            __m128i const quote = _mm_set1_epi8('"');
+            __m128i const backslash = _mm_set1_epi8('\\');
+            __m128i const space = _mm_set1_epi8(' ');
+
+            for (; i + 16 <= nLength; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pszBuffer + i));
+
+                // Signed comparison: bytes >= 0x80 are negative, so they are reported together with 0x00-0x1F
+                __m128i special = _mm_or_si128(
+                    _mm_cmplt_epi8(block, space),
+                    _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)));
+
+                int mask = _mm_movemask_epi8(special);
+                if (mask != 0)
+                {
+                    return i + FindFirstSetBit(mask);
+                }
+            }
+#else
+            for (; i + 8 <= nLength; i += 8)
+            {
+                uint64 block;
+                memcpy(&block, pszBuffer + i, sizeof(block));
+
+                uint64 special = HasByteLessThan(block, 0x20) | HasByte(block, '"') | HasByte(block, '\\') | (block & HighBits);
+                if (special != 0)
+                {
+                    break;
+                }
+            }
+#endif
+
+            for (; i < nLength; i++)
+            {
+                BYTE b = static_cast<BYTE>(pszBuffer[i]);
+                if (b < 0x20 || b >= 0x80 || b == '"' || b == '\\')
+                {
+                    break;
+                }
+            }
+
+            return i;
+        }
+
+        // Finds the first byte that is zero or the start of a multi byte UTF-8 sequence.
+        //
+        static size_t FindNonAsciiCharacter(LPCSTR pszBuffer, size_t nLength)
+        {
+            size_t i = 0;
+#if defined(JSON_SCANNER_SSE2_SUPPORTED)
+            __m128i const one = _mm_set1_epi8(1);
+
+            for (; i + 16 <= nLength; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pszBuffer + i));
+
+                int mask = _mm_movemask_epi8(_mm_cmplt_epi8(block, one));
+                if (mask != 0)
+                {
+                    return i + FindFirstSetBit(mask);
+                }
+            }
+#else
+            for (; i + 8 <= nLength; i += 8)
+            {
+                uint64 block;
+                memcpy(&block, pszBuffer + i, sizeof(block));
+
+                if ((HasByteLessThan(block, 1) | (block & HighBits)) != 0)
+                {
+                    break;
+                }
+            }
+#endif
+
+            for (; i < nLength; i++)
+            {
+                BYTE b = static_cast<BYTE>(pszBuffer[i]);
+                if (b == 0 || b >= 0x80)
+                {
+                    break;
+                }
+            }
+
+            return i;
+        }
+
+        // Finds the first byte that is not json whitespace (space, tab, carriage return or line feed).
+        //
+        static size_t FindNonWhitespaceCharacter(LPCSTR pszBuffer, size_t nLength)
+        {
+            size_t i = 0;
+
+            // Whitespace between tokens is usually a single character, so only switch to block scanning
+            // for indented documents.
+            //
+            for (; i < nLength && i < 4; i++)
+            {
+                if (!IsWhitespace(pszBuffer[i]))
+                {
+                    return i;
+                }
+            }
+
+#if defined(JSON_SCANNER_SSE2_SUPPORTED)
+            __m128i const space = _mm_set1_epi8(' ');
+            __m128i const tab = _mm_set1_epi8('\t');
+            __m128i const carriageReturn = _mm_set1_epi8('\r');
+            __m128i const lineFeed = _mm_set1_epi8('\n');
+
+            for (; i + 16 <= nLength; i += 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pszBuffer + i));
+
+                __m128i whitespace = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                    _mm_or_si128(_mm_cmpeq_epi8(block, carriageReturn), _mm_cmpeq_epi8(block, lineFeed)));
+
+                int mask = _mm_movemask_epi8(whitespace) ^ 0xFFFF;
+                if (mask != 0)
+                {
+                    return i + FindFirstSetBit(mask);
+                }
+            }
+#endif
+
+            for (; i < nLength; i++)
+            {
+                if (!IsWhitespace(pszBuffer[i]))
+                {
+                    break;
+                }
+            }
+
+            return i;
+        }
+
+        // Finds the first character that the json writer has to escape or encode as a multi byte UTF-8 sequence:
+        // a quote, a backslash, a solidus, a control character or any character >= 0x80.
+        //
+        static size_t FindEscapeCharacter(LPCWSTR pszBuffer, size_t nLength)
+        {
+            size_t i = 0;
+#if defined(JSON_SCANNER_SSE2_SUPPORTED)
+            static_assert(sizeof(WCHAR) == 2, "WCHAR must be two bytes for 16 bit lane comparisons");
+
+            __m128i const quote = _mm_set1_epi16('"');
+            __m128i const backslash = _mm_set1_epi16('\\');
+            __m128i const solidus = _mm_set1_epi16('/');
+            __m128i const space = _mm_set1_epi16(' ');
+            __m128i const nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+            __m128i const zero = _mm_setzero_si128();
+
+            for (; i + 8 <= nLength; i += 8)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(pszBuffer + i));
+
+                // Characters >= 0x80 have a bit set under 0xFF80. Those < 0x80 compare correctly against the space as signed values.
+                __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(block, nonAsciiBits), zero);
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_andnot_si128(ascii, _mm_set1_epi16(-1)), _mm_cmplt_epi16(block, space)),
+                    _mm_or_si128(
+                        _mm_cmpeq_epi16(block, quote),
+                        _mm_or_si128(_mm_cmpeq_epi16(block, backslash), _mm_cmpeq_epi16(block, solidus))));
+
+                int mask = _mm_movemask_epi8(special);
+                if (mask != 0)
+                {
+                    // Two mask bits per character
+                    return i + FindFirstSetBit(mask) / 2;
+                }
+            }
+#endif
+
+            for (; i < nLength; i++)
+            {
+                WCHAR c = pszBuffer[i];
+                if (c < 0x20 || c >= 0x80 || c == L'"' || c == L'\\' || c == L'/')
+                {
+                    break;
+                }
+            }
+
+            return i;
+        }
+
+    private:
+        static bool IsWhitespace(CHAR c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+#if defined(JSON_SCANNER_SSE2_SUPPORTED)
+        static size_t FindFirstSetBit(int mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, static_cast<unsigned long>(mask));
+            return index;
+#else
+            return static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+#endif
+        }
+#else
+        static const uint64 LowBits = 0x0101010101010101ull;
+        static const uint64 HighBits = 0x8080808080808080ull;
+
+        // Sets the high bit of every byte that equals b. The result is only used as a zero / non zero test.
+        //
+        static uint64 HasByte(uint64 block, BYTE b)
+        {
+            return HasByteLessThan(block ^ (LowBits * b), 1);
+        }
+
+        // Sets the high bit of a byte that is less than n (n <= 128) when the byte itself is < 0x80.
+        // Bytes >= 0x80 are detected separately by the callers.
+        //
+        static uint64 HasByteLessThan(uint64 block, BYTE n)
+        {
+            return (block - LowBits * n) & ~block & HighBits;
+        }
+#endif
+    };
+    //-------------------------------------------------------------------------------------------------------------------------------------------
+}
@@ -838,6 +838,21 @@ namespace Common
         unsigned __int64 uint64_;
     };
 
+    class NodeQueryResultList : public IFabricJsonSerializable
+    {
+    public:
+        NodeQueryResultList()
+        {
+        }
+
+        BEGIN_JSON_SERIALIZABLE_PROPERTIES()
+            SERIALIZABLE_PROPERTY(L"ContinuationToken", continuationToken_)
+            SERIALIZABLE_PROPERTY(L"Items", items_)
+        END_JSON_SERIALIZABLE_PROPERTIES()
+
+        wstring continuationToken_;
+        vector<NodeQueryResult> items_;
+    };
 
     class JSonSerializationTest
     {
@@ -2228,5 +2243,100 @@ namespace Common
         VERIFY_IS_TRUE(StringUtility::AreEqualCaseInsensitive(containerInfoData.Content, containerInfoDataDeserialized.Content));
     }
 
+    BOOST_AUTO_TEST_CASE(LongStringEscapeTest)
+    {
+        // Places characters that need escaping or multi byte encoding at every offset of strings that span
+        // several scanned blocks, so both the bulk and the per character paths are exercised.
+        //
+        WCHAR specialCharacters[] = { L'"', L'\\', L'/', L'\n', L'\t', L'\x1f', L'\x7f', L'\x00e9', L'\x4e2d' };
+
+        for (WCHAR specialCharacter : specialCharacters)
+        {
+            for (size_t length = 1; length <= 40; length++)
+            {
+                for (size_t position = 0; position < length; position++)
+                {
+                    wstring testData(length, L'a');
+                    testData[position] = specialCharacter;
+
+                    ContainerInfoData containerInfoData(wstring(testData));
+                    wstring data;
+
+                    auto error = JsonHelper::Serialize(containerInfoData, data);
+                    VERIFY_IS_TRUE(error.IsSuccess());
+
+                    ContainerInfoData containerInfoDataDeserialized;
+                    error = JsonHelper::Deserialize(containerInfoDataDeserialized, data);
+                    VERIFY_IS_TRUE(error.IsSuccess());
+
+                    VERIFY_ARE_EQUAL(testData, containerInfoDataDeserialized.Content);
+                }
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(QueryResultSerializationPerfTest, * boost::unit_test::disabled())
+    {
+        int const nodeCount = 10000;
+        int const iterationCount = 20;
+
+        NodeQueryResultList nodes;
+        for (int i = 0; i < nodeCount; i++)
+        {
+            nodes.items_.push_back(NodeQueryResult(
+                wformatString("Node{0}", i),
+                wformatString("10.0.{0}.{1}", i / 256, i % 256),
+                L"NodeType0",
+                L"6.0.0.0",
+                L"1.0",
+                FABRIC_QUERY_NODE_STATUS_UP,
+                3600,
+                0,
+                DateTime::Now(),
+                DateTime::Zero,
+                (i % 5) == 0,
+                wformatString("UD{0}", i % 5),
+                wformatString("fd:/dc1/rack{0}", i % 20),
+                Federation::NodeId(LargeInteger(0, i)),
+                0,
+                NodeDeactivationQueryResult()));
+        }
+
+        ByteBufferUPtr bytes;
+        int64 serializeElapsedMilliseconds = 0;
+        int64 deserializeElapsedMilliseconds = 0;
+
+        for (int i = 0; i < iterationCount; i++)
+        {
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            auto error = JsonHelper::Serialize(nodes, bytes);
+            stopwatch.Stop();
+            VERIFY_IS_TRUE(error.IsSuccess());
+            serializeElapsedMilliseconds += stopwatch.ElapsedMilliseconds;
+
+            NodeQueryResultList deserializedNodes;
+            stopwatch.Restart();
+            error = JsonHelper::Deserialize(deserializedNodes, bytes);
+            stopwatch.Stop();
+            VERIFY_IS_TRUE(error.IsSuccess());
+            VERIFY_ARE_EQUAL(nodes.items_.size(), deserializedNodes.items_.size());
+            deserializeElapsedMilliseconds += stopwatch.ElapsedMilliseconds;
+        }
+
+        double totalMegabytes = static_cast<double>(bytes->size()) * iterationCount / (1024 * 1024);
+
+        Trace.WriteInfo(
+            "JsonSerializationTest",
+            "Nodes={0}, PayloadBytes={1}, Iterations={2}, Serialize={3} ms ({4} MB/s), Deserialize={5} ms ({6} MB/s)",
+            nodeCount,
+            bytes->size(),
+            iterationCount,
+            serializeElapsedMilliseconds,
+            totalMegabytes * 1000 / max(serializeElapsedMilliseconds, static_cast<int64>(1)),
+            deserializeElapsedMilliseconds,
+            totalMegabytes * 1000 / max(deserializeElapsedMilliseconds, static_cast<int64>(1)));
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
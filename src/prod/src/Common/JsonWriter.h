@@ -501,8 +501,24 @@ namespace Common
 
         void AppendEscapeString(LPCWSTR pszStr)
         {
-            for(int i = 0; pszStr[i] != '\0'; i++)
+            size_t nLength = wcslen(pszStr);
+            for(size_t i = 0; i < nLength; i++)
             {
+                // Characters that need neither escaping nor multi byte encoding are appended in bulk
+                size_t nRunLength = JsonScanner::FindEscapeCharacter(pszStr + i, nLength - i);
+                if(nRunLength > 0)
+                {
+                    size_t nOffset = m_strBuffer.length();
+                    m_strBuffer.resize(nOffset + nRunLength);
+                    for(size_t j = 0; j < nRunLength; j++)
+                    {
+                        m_strBuffer[nOffset + j] = static_cast<char>(pszStr[i + j]);
+                    }
+
+                    i += nRunLength;
+                    if(i == nLength) break;
+                }
+
                 LPCSTR pszEscapedSequence = GetEscapeSequence(pszStr[i]);
 
                 if(pszEscapedSequence  == NULL)
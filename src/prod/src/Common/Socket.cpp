@@ -232,6 +232,11 @@ ErrorCode Socket::Open(
 {
     int type    = (SocketType::Tcp == socketType) ? SOCK_STREAM : SOCK_DGRAM;
     int proto    = (SocketType::Tcp == socketType) ? IPPROTO_TCP : IPPROTO_UDP;
+    if (addressFamily == AddressFamily::Unix)
+    {
+        // Unix domain sockets take the default protocol for the socket type
+        proto = 0;
+    }
 
     handle_ = socket(static_cast<int>(addressFamily), type | SOCK_CLOEXEC, proto);
     if (handle_ == -1)
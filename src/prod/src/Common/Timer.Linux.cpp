@@ -398,7 +398,15 @@ void Timer::Change(TimeSpan dueTime, TimeSpan period)
         {
             if (!started_)
             {
-                if (!CreatePosixTimer_CallerHoldingLock())
+                if (CommonConfig::GetConfig().TimerWheelEnabled)
+                {
+                    useTimerWheel_ = true;
+                    thisSPtr_ = shared_from_this();
+                    wheelTimer_ = TimerWheel::GetDefault().CreateTimer(
+                        StringLiteral(tag_, tag_+strlen(tag_)),
+                        [thisSPtr = thisSPtr_] { thisSPtr->Callback(); });
+                }
+                else if (!CreatePosixTimer_CallerHoldingLock())
                 {
                     useTimerQueue_ = true;
                     queuedTimer_ = timerQueue->CreateTimer(
@@ -412,7 +420,12 @@ void Timer::Change(TimeSpan dueTime, TimeSpan period)
                 Invariant(!oneShotOnly_);
             }
 
-            if (useTimerQueue_)
+            if (useTimerWheel_)
+            {
+                period_ = period;
+                TimerWheel::GetDefault().Enqueue(wheelTimer_, dueTime);
+            }
+            else if (useTimerQueue_)
             {
                 period_ = period;
                 timerQueue->Enqueue(queuedTimer_, dueTime);
@@ -457,6 +470,7 @@ void Timer::Cancel(bool disposeNow)
     bool shouldDelayDispose = false; 
     TimerCallback callback; //avoid reset callback_ under lock
     TimerQueue::TimerSPtr queuedTimer;
+    TimerWheel::TimerSPtr wheelTimer;
     TimerSPtr thisSPtr;
     {
         AcquireWriteLock grab(thisLock_);
@@ -474,7 +488,13 @@ void Timer::Cancel(bool disposeNow)
 
             if (started_)
             {
-                if (useTimerQueue_)
+                if (useTimerWheel_)
+                {
+                    Invariant(wheelTimer_);
+                    wheelTimer = move(wheelTimer_);
+                    shouldDelayDispose = false;
+                }
+                else if (useTimerQueue_)
                 {
                     Invariant(queuedTimer_);
                     queuedTimer = move(queuedTimer_);
@@ -510,6 +530,10 @@ void Timer::Cancel(bool disposeNow)
     {
         timerQueue->Dequeue(queuedTimer);
     }
+    else if (wheelTimer)
+    {
+        TimerWheel::GetDefault().Dequeue(wheelTimer);
+    }
     
     WaitForCancelCompletionIfNeeded();
 }
@@ -583,7 +607,15 @@ void Timer::Callback()
                 callback = callback_;
                 thisSPtr = thisSPtr_; //copy in case timer is disposed inside callback_
 
-                if (useTimerQueue_)
+                if (useTimerWheel_)
+                {
+                    bool periodEnabled = (TimeSpan::Zero < period_) && (period_ < TimeSpan::MaxValue);
+                    if (periodEnabled)
+                    {
+                        TimerWheel::GetDefault().Enqueue(wheelTimer_, period_);
+                    }
+                }
+                else if (useTimerQueue_)
                 {
                     bool periodEnabled = (period_ < TimeSpan::MaxValue);
                     if(periodEnabled)
@@ -662,6 +694,11 @@ bool Timer::Test_IsSet() const
     AcquireReadLock grab(thisLock_);
 
     if (!started_ || cancelCalled_) return false;
+
+    if (useTimerWheel_)
+    {
+        return TimerWheel::GetDefault().IsTimerArmed(wheelTimer_) || (callbackRunning_.load() > 1);
+    }
     
     if (useTimerQueue_)
     {
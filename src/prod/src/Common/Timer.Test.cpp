@@ -294,6 +294,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         BasicTest(TimeSpan::Zero);
 
         LEAVE;
@@ -307,6 +311,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         BasicTest(TimeSpan::FromTicks(1));
 
         LEAVE;
@@ -320,6 +328,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         TestCancelInCallback();
 
         LEAVE;
@@ -333,6 +345,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         TestRecurringNoConcurrency();
 
         LEAVE;
@@ -346,6 +362,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         TestRecurringNoConcurrencyCancelInCallback();
 
         LEAVE;
@@ -359,6 +379,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         TestRecurringWithConcurrency();
 
         LEAVE;
@@ -372,6 +396,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         TestRecurringWithConcurrencyCancelInCallback();
 
         LEAVE;
@@ -472,6 +500,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 0;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         ScaleTestFunc(TimeSpan::Zero, false);
 
         LEAVE;
@@ -485,6 +517,10 @@ namespace Common
         CommonConfig::GetConfig().PosixTimerLimit = 10;
         KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
 
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
         ScaleTestFunc(TimeSpan::Zero, false);
 
         LEAVE;
@@ -508,6 +544,289 @@ namespace Common
         LEAVE;
     }
 
+    void TimerPerfTestFunc(uint timerCount)
+    {
+        Common::ManualResetEvent allFired(false);
+        atomic_long callCount(0);
+
+        vector<TimerSPtr> timers;
+        timers.reserve(timerCount);
+        for(uint i = 0; i < timerCount; ++i)
+        {
+            timers.emplace_back(Timer::Create(
+                TimerTagDefault,
+                [&](TimerSPtr const &)
+                {
+                    if (++callCount == timerCount)
+                    {
+                        allFired.Set();
+                    }
+                }));
+        }
+
+        Stopwatch stopwatch;
+
+        // arm: spread due time over one minute, so timers land on every wheel level
+        stopwatch.Start();
+        for(uint i = 0; i < timerCount; ++i)
+        {
+            timers[i]->Change(TimeSpan::FromMilliseconds(60000 + (i % 60000)));
+        }
+        stopwatch.Stop();
+        auto armTime = stopwatch.Elapsed;
+
+        // re-arm: move every armed timer
+        stopwatch.Restart();
+        for(uint i = 0; i < timerCount; ++i)
+        {
+            timers[i]->Change(TimeSpan::FromMilliseconds(1 + (i % 1000)));
+        }
+        stopwatch.Stop();
+        auto rearmTime = stopwatch.Elapsed;
+
+        // fire: from the last re-arm until all callbacks have run
+        stopwatch.Restart();
+        BOOST_REQUIRE(allFired.WaitOne(TimeSpan::FromSeconds(120)));
+        stopwatch.Stop();
+        auto fireTime = stopwatch.Elapsed;
+
+        // cancel: re-arm all again, then cancel before they fire
+        for(uint i = 0; i < timerCount; ++i)
+        {
+            timers[i]->Change(TimeSpan::FromMinutes(10));
+        }
+
+        stopwatch.Restart();
+        for(auto const & timer : timers)
+        {
+            timer->Cancel();
+        }
+        stopwatch.Stop();
+        auto cancelTime = stopwatch.Elapsed;
+
+        timers.clear();
+
+        Trace.WriteInfo(
+            TraceType,
+            "timerCount = {0}, arm = {1} ms, rearm = {2} ms, fire = {3} ms, cancel = {4} ms, callCount = {5}",
+            timerCount,
+            armTime.TotalMillisecondsAsDouble(),
+            rearmTime.TotalMillisecondsAsDouble(),
+            fireTime.TotalMillisecondsAsDouble(),
+            cancelTime.TotalMillisecondsAsDouble(),
+            callCount.load());
+
+        VERIFY_IS_TRUE(callCount.load() == timerCount);
+    }
+
+    // Fires once and records how long after the stopwatch was started it fired
+    struct WheelTimerProbe
+    {
+        WheelTimerProbe(Stopwatch const & stopwatch)
+            : callCount(0)
+            , fired(false)
+            , elapsed()
+        {
+            timer = Timer::Create(
+                TimerTagDefault,
+                [this, &stopwatch](TimerSPtr const &)
+                {
+                    elapsed = stopwatch.Elapsed;
+                    ++callCount;
+                    fired.Set();
+                });
+        }
+
+        ~WheelTimerProbe()
+        {
+            timer->Cancel();
+        }
+
+        TimerSPtr timer;
+        atomic_long callCount;
+        ManualResetEvent fired;
+        TimeSpan elapsed;
+    };
+
+    BOOST_AUTO_TEST_CASE(TimerWheel_CascadeFromUpperLevels)
+    {
+        ENTER;
+
+        auto saved = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = true;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = saved; });
+
+        // Level 0 spans 256 ticks and level 1 spans 16384 ticks, so with the default 1ms tick these
+        // due times are placed on level 1 and level 2 and must be cascaded down before they fire.
+        vector<TimeSpan> dueTimes =
+        {
+            TimeSpan::FromMilliseconds(300),
+            TimeSpan::FromMilliseconds(1000),
+            TimeSpan::FromMilliseconds(5000),
+            TimeSpan::FromMilliseconds(17000),
+        };
+
+        Stopwatch stopwatch;
+        vector<unique_ptr<WheelTimerProbe>> probes;
+        for (auto const & dueTime : dueTimes)
+        {
+            probes.push_back(make_unique<WheelTimerProbe>(stopwatch));
+        }
+
+        stopwatch.Start();
+        for (size_t i = 0; i < dueTimes.size(); ++i)
+        {
+            probes[i]->timer->Change(dueTimes[i]);
+        }
+
+        for (size_t i = 0; i < dueTimes.size(); ++i)
+        {
+            VERIFY_IS_TRUE(probes[i]->fired.WaitOne(dueTimes[i] + TimeSpan::FromSeconds(10)));
+
+            Trace.WriteInfo(TraceType, "due = {0}, fired after {1}", dueTimes[i], probes[i]->elapsed);
+
+            VERIFY_IS_TRUE(probes[i]->elapsed >= dueTimes[i]);
+        }
+
+        // Give any duplicate expiration from a bad cascade time to show up
+        Sleep(500);
+
+        for (auto const & probe : probes)
+        {
+            VERIFY_ARE_EQUAL2(probe->callCount.load(), 1);
+        }
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(TimerWheel_ChangeAcrossLevels)
+    {
+        ENTER;
+
+        auto saved = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = true;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = saved; });
+
+        Stopwatch stopwatch;
+
+        // Upper level to level 0
+        WheelTimerProbe moveDown(stopwatch);
+
+        // Level 0 to an upper level
+        WheelTimerProbe moveUp(stopwatch);
+
+        // Re-armed after it has been cascaded from level 1 into level 0
+        WheelTimerProbe moveAfterCascade(stopwatch);
+
+        stopwatch.Start();
+        moveDown.timer->Change(TimeSpan::FromSeconds(20));
+        moveUp.timer->Change(TimeSpan::FromMilliseconds(50));
+        moveAfterCascade.timer->Change(TimeSpan::FromMilliseconds(600));
+
+        moveDown.timer->Change(TimeSpan::FromMilliseconds(50));
+        moveUp.timer->Change(TimeSpan::FromMilliseconds(1500));
+
+        VERIFY_IS_TRUE(moveDown.fired.WaitOne(TimeSpan::FromSeconds(10)));
+        VERIFY_IS_TRUE(moveDown.elapsed < TimeSpan::FromSeconds(10));
+
+        // By now the 600ms timer is within 256ms of its due time and sits on level 0
+        Sleep(400);
+        auto rearmTime = stopwatch.Elapsed;
+        moveAfterCascade.timer->Change(TimeSpan::FromMilliseconds(2000));
+
+        VERIFY_IS_TRUE(moveUp.fired.WaitOne(TimeSpan::FromSeconds(10)));
+        VERIFY_IS_TRUE(moveUp.elapsed >= TimeSpan::FromMilliseconds(1500));
+
+        VERIFY_IS_TRUE(moveAfterCascade.fired.WaitOne(TimeSpan::FromSeconds(10)));
+        VERIFY_IS_TRUE(moveAfterCascade.elapsed >= rearmTime + TimeSpan::FromMilliseconds(2000));
+
+        Sleep(500);
+
+        VERIFY_ARE_EQUAL2(moveDown.callCount.load(), 1);
+        VERIFY_ARE_EQUAL2(moveUp.callCount.load(), 1);
+        VERIFY_ARE_EQUAL2(moveAfterCascade.callCount.load(), 1);
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(TimerWheel_CancelAcrossLevels)
+    {
+        ENTER;
+
+        auto saved = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = true;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = saved; });
+
+        Stopwatch stopwatch;
+        WheelTimerProbe level0(stopwatch);
+        WheelTimerProbe level1(stopwatch);
+        WheelTimerProbe level2(stopwatch);
+        WheelTimerProbe cascaded(stopwatch);
+
+        stopwatch.Start();
+        level0.timer->Change(TimeSpan::FromMilliseconds(100));
+        level1.timer->Change(TimeSpan::FromMilliseconds(300));
+        level2.timer->Change(TimeSpan::FromSeconds(20));
+        cascaded.timer->Change(TimeSpan::FromMilliseconds(600));
+
+        VERIFY_IS_TRUE(level0.timer->Test_IsSet());
+        VERIFY_IS_TRUE(level1.timer->Test_IsSet());
+        VERIFY_IS_TRUE(level2.timer->Test_IsSet());
+
+        level0.timer->Cancel();
+        level1.timer->Cancel();
+        level2.timer->Cancel();
+
+        VERIFY_IS_FALSE(level0.timer->Test_IsSet());
+        VERIFY_IS_FALSE(level1.timer->Test_IsSet());
+        VERIFY_IS_FALSE(level2.timer->Test_IsSet());
+
+        // Cancel the last one after it has been cascaded down to level 0
+        Sleep(400);
+        VERIFY_IS_TRUE(cascaded.timer->Test_IsSet());
+        cascaded.timer->Cancel();
+        VERIFY_IS_FALSE(cascaded.timer->Test_IsSet());
+
+        Sleep(1000);
+
+        VERIFY_ARE_EQUAL2(level0.callCount.load(), 0);
+        VERIFY_ARE_EQUAL2(level1.callCount.load(), 0);
+        VERIFY_ARE_EQUAL2(level2.callCount.load(), 0);
+        VERIFY_ARE_EQUAL2(cascaded.callCount.load(), 0);
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(TimerWheelPerf_1M, * boost::unit_test::disabled())
+    {
+        ENTER;
+
+        auto saved = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = true;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = saved; });
+
+        TimerPerfTestFunc(1000000);
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(TimerQueuePerf_1M, * boost::unit_test::disabled())
+    {
+        ENTER;
+
+        auto saved = CommonConfig::GetConfig().PosixTimerLimit;
+        CommonConfig::GetConfig().PosixTimerLimit = 0;
+        KFinally([=] { CommonConfig::GetConfig().PosixTimerLimit = saved; });
+
+        auto savedWheelEnabled = CommonConfig::GetConfig().TimerWheelEnabled;
+        CommonConfig::GetConfig().TimerWheelEnabled = false;
+        KFinally([=] { CommonConfig::GetConfig().TimerWheelEnabled = savedWheelEnabled; });
+
+        TimerPerfTestFunc(1000000);
+
+        LEAVE;
+    }
+
 #endif
 
     BOOST_AUTO_TEST_CASE(TestTimerWaitOnCancel)
@@ -101,12 +101,14 @@ namespace Common
         TimerSPtr thisSPtr_;
         timer_t timer_ = nullptr;
         TimerQueue::TimerSPtr queuedTimer_;
+        TimerWheel::TimerSPtr wheelTimer_;
         TimeSpan period_ = TimeSpan::MaxValue;
         volatile pthread_t callbackThreadId_ = 0;
         bool oneShotOnly_ = false;
         bool callbackCalled_ = false;
         bool callbackTidSet_ = false;
         bool useTimerQueue_ = false;
+        bool useTimerWheel_ = false;
         std::unique_ptr<ManualResetEvent> allCallbackCompleted_;
         StopwatchTime cancelTime_ = StopwatchTime::MaxValue;
 
@@ -0,0 +1,477 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Common/FabricSignal.h"
+#include <sys/timerfd.h>
+#include <sched.h>
+
+using namespace Common;
+using namespace std;
+
+namespace
+{
+    const StringLiteral TraceType("TimerWheel");
+
+    // Level 0 has one slot per tick, each higher level has 64 slots covering a full revolution of the level below.
+    // With the default 1 millisecond tick, the levels span 256ms, 16s, 17min, 18h and 49 days.
+    constexpr uint Level0Bits = 8;
+    constexpr uint64 Level0Size = 1ull << Level0Bits;
+    constexpr uint64 Level0Mask = Level0Size - 1;
+    constexpr uint LevelBits = 6;
+    constexpr uint64 LevelSize = 1ull << LevelBits;
+    constexpr uint64 LevelMask = LevelSize - 1;
+    constexpr uint UpperLevelCount = 4;
+    constexpr uint64 MaxTickDelta = (1ull << (Level0Bits + UpperLevelCount * LevelBits)) - 1;
+    constexpr uint64 InvalidTick = numeric_limits<uint64>::max();
+
+    uint LevelShift(uint upperLevel)
+    {
+        return Level0Bits + upperLevel * LevelBits;
+    }
+}
+
+class TimerWheel::Timer
+{
+    DENY_COPY(Timer);
+
+public:
+    Timer(TimerWheel::Shard & shard, StringLiteral const tag, Callback const & callback)
+        : shard_(shard)
+        , tag_(tag.cbegin())
+        , callback_(callback)
+    {
+    }
+
+    TimerWheel::Shard & GetShard() const noexcept { return shard_; }
+    const char* Tag() const noexcept { return tag_; }
+
+    void Fire() const
+    {
+        callback_();
+    }
+
+    bool IsLinked() const noexcept { return slot_ != nullptr; }
+
+private:
+    friend class TimerWheel::Shard;
+
+    TimerWheel::Shard & shard_;
+    const char * const tag_; //only stores string literal
+    const Callback callback_;
+
+    uint64 dueTick_ = 0;
+
+    // Intrusive slot list, self_ keeps the timer alive while it is linked
+    Timer** slot_ = nullptr;
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+    TimerSPtr self_;
+};
+
+class TimerWheel::Shard : public TextTraceComponent<TraceTaskCodes::Timer>
+{
+    DENY_COPY(Shard);
+
+public:
+    Shard(uint index, TimeSpan tickInterval)
+        : index_(index)
+        , tickInterval_(tickInterval)
+        , start_(Stopwatch::Now())
+    {
+        for (auto & slot : level0_)
+        {
+            slot = nullptr;
+        }
+
+        for (auto & level : upperLevels_)
+        {
+            for (auto & slot : level)
+            {
+                slot = nullptr;
+            }
+        }
+
+        timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        ASSERT_IF(timerFd_ < 0, "timerfd_create failed with errno = {0:x}", errno);
+
+        pthread_t tid;
+        ZeroRetValAssert(pthread_create(&tid, nullptr, &ExpirationLoopStatic, this));
+    }
+
+    void Enqueue(TimerSPtr const & timer, TimeSpan dueTime)
+    {
+        WriteNoise(TraceType, "{0}: Enqueue, due in {1}", TextTracePtr(timer.get()), dueTime);
+
+        AcquireWriteLock grab(lock_);
+
+        if (timer->IsLinked())
+        {
+            Unlink_LockHeld(*timer);
+        }
+        else
+        {
+            if (count_ == 0)
+            {
+                // Nothing to cascade, skip the ticks passed while the shard was idle
+                currentTick_ = max(currentTick_, NowTick());
+            }
+
+            timer->self_ = timer;
+            ++count_;
+        }
+
+        timer->dueTick_ = DueTick(dueTime);
+        auto wakeTick = Insert_LockHeld(*timer);
+        if (wakeTick < armedTick_)
+        {
+            Arm_LockHeld(wakeTick);
+        }
+    }
+
+    bool Dequeue(TimerSPtr const & timer)
+    {
+        AcquireWriteLock grab(lock_);
+
+        if (!timer->IsLinked())
+        {
+            WriteNoise(TraceType, "{0}: Dequeue: false", TextTracePtr(timer.get()));
+            return false;
+        }
+
+        // Leave timerfd armed, an early wakeup with nothing to expire is cheaper than the syscall
+        Unlink_LockHeld(*timer);
+        --count_;
+        timer->self_.reset(); // caller still holds a reference, so this does not destruct under lock
+
+        WriteNoise(TraceType, "{0}: Dequeue: true", TextTracePtr(timer.get()));
+        return true;
+    }
+
+    bool IsTimerArmed(TimerSPtr const & timer)
+    {
+        AcquireReadLock grab(lock_);
+        return timer->IsLinked();
+    }
+
+private:
+    uint64 NowTick() const
+    {
+        return (Stopwatch::Now() - start_).Ticks / tickInterval_.Ticks;
+    }
+
+    uint64 DueTick(TimeSpan dueTime) const
+    {
+        // Round up, a timer never fires before its due time
+        auto maxDueTime = TimeSpan::FromTicks(MaxTickDelta * tickInterval_.Ticks);
+        auto due = (Stopwatch::Now() - start_) + min(max(dueTime, TimeSpan::Zero), maxDueTime);
+        return (due.Ticks + tickInterval_.Ticks - 1) / tickInterval_.Ticks;
+    }
+
+    // Returns the tick at which the shard must wake up to process the timer
+    uint64 Insert_LockHeld(Timer & timer)
+    {
+        auto dueTick = max(timer.dueTick_, currentTick_);
+        auto delta = dueTick - currentTick_;
+
+        if (delta < Level0Size)
+        {
+            Link_LockHeld(timer, level0_[dueTick & Level0Mask]);
+            return dueTick;
+        }
+
+        if (delta > MaxTickDelta)
+        {
+            // Cascading re-inserts with the real due tick
+            dueTick = currentTick_ + MaxTickDelta;
+            delta = MaxTickDelta;
+        }
+
+        uint level = 0;
+        while ((level < UpperLevelCount - 1) && (delta >= (1ull << LevelShift(level + 1))))
+        {
+            ++level;
+        }
+
+        Link_LockHeld(timer, upperLevels_[level][(dueTick >> LevelShift(level)) & LevelMask]);
+        return NextCascadeTick();
+    }
+
+    uint64 NextCascadeTick() const
+    {
+        return (currentTick_ | Level0Mask) + 1;
+    }
+
+    void Link_LockHeld(Timer & timer, Timer* & slot)
+    {
+        timer.slot_ = &slot;
+        timer.prev_ = nullptr;
+        timer.next_ = slot;
+        if (slot)
+        {
+            slot->prev_ = &timer;
+        }
+
+        slot = &timer;
+    }
+
+    void Unlink_LockHeld(Timer & timer)
+    {
+        if (timer.prev_)
+        {
+            timer.prev_->next_ = timer.next_;
+        }
+        else
+        {
+            *timer.slot_ = timer.next_;
+        }
+
+        if (timer.next_)
+        {
+            timer.next_->prev_ = timer.prev_;
+        }
+
+        timer.slot_ = nullptr;
+        timer.prev_ = nullptr;
+        timer.next_ = nullptr;
+    }
+
+    void Cascade_LockHeld(Timer* & slot)
+    {
+        auto timer = slot;
+        slot = nullptr;
+
+        while (timer)
+        {
+            auto next = timer->next_;
+            timer->slot_ = nullptr;
+            Insert_LockHeld(*timer);
+            timer = next;
+        }
+    }
+
+    void ProcessTick_LockHeld(vector<TimerSPtr> & expired)
+    {
+        auto index = currentTick_ & Level0Mask;
+        if (index == 0)
+        {
+            for (uint level = 0; level < UpperLevelCount; ++level)
+            {
+                auto levelIndex = (currentTick_ >> LevelShift(level)) & LevelMask;
+                Cascade_LockHeld(upperLevels_[level][levelIndex]);
+                if (levelIndex != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        auto timer = level0_[index];
+        level0_[index] = nullptr;
+
+        while (timer)
+        {
+            auto next = timer->next_;
+            timer->slot_ = nullptr;
+            timer->prev_ = nullptr;
+            timer->next_ = nullptr;
+
+            if (timer->dueTick_ <= currentTick_)
+            {
+                --count_;
+                expired.emplace_back(move(timer->self_));
+            }
+            else
+            {
+                Insert_LockHeld(*timer);
+            }
+
+            timer = next;
+        }
+
+        ++currentTick_;
+    }
+
+    uint64 NextWakeTick_LockHeld() const
+    {
+        if (count_ == 0)
+        {
+            return InvalidTick;
+        }
+
+        auto cascadeTick = NextCascadeTick();
+        for (auto tick = currentTick_; tick < cascadeTick; ++tick)
+        {
+            if (level0_[tick & Level0Mask])
+            {
+                return tick;
+            }
+        }
+
+        return cascadeTick;
+    }
+
+    void Arm_LockHeld(uint64 wakeTick)
+    {
+        armedTick_ = wakeTick;
+
+        itimerspec timerSpec = {};
+        if (wakeTick != InvalidTick)
+        {
+            auto delay = TimeSpan::FromTicks(wakeTick * tickInterval_.Ticks) - (Stopwatch::Now() - start_);
+            timerSpec.it_value = Common::Timer::ToTimeSpecWithLowerBound(delay);
+        }
+
+        ZeroRetValAssert(timerfd_settime(timerFd_, 0, &timerSpec, nullptr));
+    }
+
+    static void* ExpirationLoopStatic(void* arg)
+    {
+        ((Shard*)arg)->ExpirationLoop();
+        return nullptr;
+    }
+
+    void ExpirationLoop()
+    {
+        SigUtil::BlockAllFabricSignalsOnCallingThread();
+
+        size_t batchSize = CommonConfig::GetConfig().TimerWheelDispatchBatchSize;
+
+        WriteInfo(TraceType, "shard {0}: start expiration loop, tick = {1}, batch = {2}", index_, tickInterval_, batchSize);
+
+        vector<TimerSPtr> expired;
+        for(;;)
+        {
+            uint64 expirations;
+            auto len = read(timerFd_, &expirations, sizeof(expirations));
+            if (len < 0)
+            {
+                ASSERT_IF(errno != EINTR, "shard {0}: timerfd read failed with errno = {1:x}", index_, errno);
+                continue;
+            }
+
+            {
+                AcquireWriteLock grab(lock_);
+
+                auto nowTick = NowTick();
+                while (currentTick_ <= nowTick)
+                {
+                    ProcessTick_LockHeld(expired);
+                }
+
+                Arm_LockHeld(NextWakeTick_LockHeld());
+            }
+
+            if (expired.empty())
+            {
+                continue;
+            }
+
+            WriteNoise(TraceType, "shard {0}: dispatching {1} expired timers", index_, expired.size());
+
+            for (size_t i = 0; i < expired.size(); i += batchSize)
+            {
+                auto batchEnd = expired.begin() + min(i + batchSize, expired.size());
+                vector<TimerSPtr> batch(make_move_iterator(expired.begin() + i), make_move_iterator(batchEnd));
+
+                Threadpool::Post([batch = move(batch)]
+                {
+                    for (auto const & timer : batch)
+                    {
+                        timer->Fire();
+                    }
+                });
+            }
+
+            expired.clear();
+        }
+    }
+
+    uint const index_;
+    TimeSpan const tickInterval_;
+    StopwatchTime const start_;
+
+    RwLock lock_;
+    int timerFd_ = -1;
+
+    // Next tick to process
+    uint64 currentTick_ = 0;
+    uint64 armedTick_ = InvalidTick;
+    size_t count_ = 0;
+
+    Timer* level0_[Level0Size];
+    Timer* upperLevels_[UpperLevelCount][LevelSize];
+};
+
+TimerWheel::TimerWheel()
+{
+    auto const & config = CommonConfig::GetConfig();
+
+    uint shardCount = config.TimerWheelShardCount;
+    if (shardCount == 0)
+    {
+        shardCount = Environment::GetNumberOfProcessors();
+    }
+
+    WriteInfo(TraceType, "{0}: shardCount = {1}, tickInterval = {2}", TextTraceThis, shardCount, config.TimerWheelTickInterval);
+
+    for (uint i = 0; i < shardCount; ++i)
+    {
+        shards_.push_back(make_unique<Shard>(i, config.TimerWheelTickInterval));
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+    // The default wheel lives for the life of the process, expiration threads are never stopped
+}
+
+TimerWheel::TimerSPtr TimerWheel::CreateTimer(Common::StringLiteral const tag, Callback const & callback)
+{
+    auto cpu = sched_getcpu();
+    auto & shard = *shards_[(cpu < 0 ? 0 : cpu) % shards_.size()];
+    return make_shared<Timer>(shard, tag, callback);
+}
+
+void TimerWheel::Enqueue(TimerSPtr const & timer, TimeSpan dueTime)
+{
+    Invariant(timer);
+
+    if (dueTime == TimeSpan::MaxValue)
+    {
+        Dequeue(timer);
+        return;
+    }
+
+    timer->GetShard().Enqueue(timer, dueTime);
+}
+
+bool TimerWheel::Dequeue(TimerSPtr const & timer)
+{
+    Invariant(timer);
+    return timer->GetShard().Dequeue(timer);
+}
+
+bool TimerWheel::IsTimerArmed(TimerSPtr const & timer)
+{
+    return timer->GetShard().IsTimerArmed(timer);
+}
+
+static INIT_ONCE initOnce;
+static Global<TimerWheel> singleton;
+
+static BOOL CALLBACK InitOnceFunc(PINIT_ONCE, PVOID, PVOID *)
+{
+    singleton = make_global<TimerWheel>();
+    return TRUE;
+}
+
+TimerWheel & TimerWheel::GetDefault()
+{
+    PVOID lpContext = NULL;
+    BOOL result = ::InitOnceExecuteOnce(&initOnce, InitOnceFunc, NULL, &lpContext);
+    Invariant(result);
+    return *singleton;
+}
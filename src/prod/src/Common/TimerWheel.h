@@ -0,0 +1,41 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    // Hierarchical timing wheel sharded per processor. Each shard is driven by a single timerfd and its own
+    // thread, arming and disarming are O(1) and expired timers are dispatched to threadpool in batches.
+    // A timer stays on the shard of the processor it was created on.
+    class TimerWheel : public TextTraceComponent<TraceTaskCodes::Timer>
+    {
+        DENY_COPY(TimerWheel);
+
+    public:
+        typedef std::function<void(void)> Callback;
+
+        class Timer;
+        typedef std::shared_ptr<Timer> TimerSPtr;
+        TimerSPtr CreateTimer(StringLiteral tag, Callback const & callback);
+
+        static TimerWheel & GetDefault();
+        TimerWheel();
+        ~TimerWheel();
+
+        // TimeSpan::MaxValue disarms the timer
+        void Enqueue(TimerSPtr const & timer, TimeSpan dueTime);
+        bool Dequeue(TimerSPtr const & timer);
+
+        bool IsTimerArmed(TimerSPtr const & timer);
+
+        size_t ShardCount() const { return shards_.size(); }
+
+    private:
+        class Shard;
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+}
@@ -21,6 +21,7 @@ ServiceCommunicationClient::SendRequestAsyncOperation::SendRequestAsyncOperation
     AsyncOperationSPtr const& parent)
     : AsyncOperation(callback, parent),
     owner_(owner),
+    requestReply_(nullptr),
     timeoutHelper_(timeout),
     request_(move(message))
 {
@@ -87,7 +88,7 @@ void ServiceCommunicationClient::SendRequestAsyncOperation::OnSendRequestComplet
         return;
     }
 
-    auto error = this->owner_.requestReply_.EndRequest(operation, this->reply_);
+    auto error = this->requestReply_->EndRequest(operation, this->reply_);
 
     if (error.IsSuccess())
     {
@@ -120,8 +121,11 @@ void ServiceCommunicationClient::SendRequestAsyncOperation::OnSendRequestComplet
 
 void ServiceCommunicationClient::SendRequestAsyncOperation::SendRequest(AsyncOperationSPtr const& thisSPtr)
 {
-    auto operation = this->owner_.requestReply_.BeginRequest(move(this->request_),
-        this->owner_.serverSendTarget_,
+    ISendTarget::SPtr target;
+    this->requestReply_ = &this->owner_.SelectRequestChannel(target);
+
+    auto operation = this->requestReply_->BeginRequest(move(this->request_),
+        target,
         TransportPriority::Normal,
         this->timeoutHelper_.GetRemainingTime(),
         [this](AsyncOperationSPtr const& operation)
@@ -35,6 +35,7 @@ namespace Communication
             void OnSendRequestComplete(Common::AsyncOperationSPtr const & operation, bool expectedCompletedSynchronously);
 
             ServiceCommunicationClient  &  owner_;
+            Transport::RequestReply * requestReply_;
             Transport::MessageUPtr request_;
             std::wstring clientId_;
             Transport::ReceiverContextUPtr receiverContext_;
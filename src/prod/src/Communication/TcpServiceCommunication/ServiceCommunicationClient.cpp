@@ -111,6 +111,87 @@ private:
     MessageUPtr reply_;
 };
 
+class ServiceCommunicationClient::RequestChannel
+{
+    DENY_COPY(RequestChannel);
+
+public:
+    RequestChannel(
+        __in ServiceCommunicationClient & owner,
+        ServiceCommunicationTransportSettings const & settings,
+        size_t index)
+        : owner_(owner)
+        , traceId_(wformatString("{0}-{1}", owner.clientId_, index))
+        , transport_(DatagramTransportFactory::CreateTcpClient(traceId_, L"ServiceCommunicationClient"))
+        , demuxer_(make_unique<Demuxer>(owner, transport_))
+        , requestReply_(owner, transport_, false /* dispatchOnTransportThread */)
+    {
+        transport_->SetMaxOutgoingFrameSize(settings.MaxMessageSize);
+        transport_->EnableInboundActivityTracing();
+        transport_->SetKeepAliveTimeout(settings.KeepAliveTimeout);
+        transport_->SetConnectionIdleTimeout(TimeSpan::Zero);
+        demuxer_->SetReplyHandler(requestReply_);
+        requestReply_.EnableDifferentTimeoutError();
+    }
+
+    __declspec(property(get = get_RequestReply)) RequestReply & RequestReplyObj;
+    RequestReply & get_RequestReply() { return requestReply_; }
+
+    __declspec(property(get = get_SendTarget)) ISendTarget::SPtr const & SendTarget;
+    ISendTarget::SPtr const & get_SendTarget() const { return sendTarget_; }
+
+    ErrorCode Open()
+    {
+        requestReply_.Open();
+
+        auto errorCode = transport_->SetSecurity(owner_.securitySettings_);
+        if (!errorCode.IsSuccess())
+        {
+            return errorCode;
+        }
+
+        errorCode = demuxer_->Open();
+        if (!errorCode.IsSuccess())
+        {
+            return errorCode;
+        }
+
+        // The transport reconnects on the next request sent through this channel. The channel needs no handshake
+        // of its own: the server matches its requests to the primary connection by client id, and requests are
+        // only routed here while the primary connection is connected.
+        auto root = owner_.CreateComponentRoot();
+        auto const & traceId = traceId_;
+        transport_->SetConnectionFaultHandler([root, &traceId](ISendTarget const & target, ErrorCode const & error)
+        {
+            WriteInfo(TraceType, traceId, "Request connection to SendTarget : {0} faulted with ErrorCode : {1}", target.TraceId(), error);
+        });
+
+        errorCode = transport_->Start();
+        if (errorCode.IsSuccess())
+        {
+            sendTarget_ = transport_->ResolveTarget(owner_.serverAddress_);
+        }
+
+        return errorCode;
+    }
+
+    void Close()
+    {
+        transport_->RemoveConnectionFaultHandler();
+        transport_->Stop();
+        requestReply_.Close();
+        demuxer_->Close();
+    }
+
+private:
+    ServiceCommunicationClient & owner_;
+    wstring traceId_;
+    shared_ptr<IDatagramTransport> transport_;
+    DemuxerUPtr demuxer_;
+    RequestReply requestReply_;
+    ISendTarget::SPtr sendTarget_;
+};
+
 ServiceCommunicationClient::ServiceCommunicationClient(ServiceCommunicationTransportSettingsUPtr  const & settings,
                                                        wstring const & serverAddress,
                                                        IServiceCommunicationMessageHandlerPtr const &  messageHandler,
@@ -135,6 +216,11 @@ ServiceCommunicationClient::ServiceCommunicationClient(ServiceCommunicationTrans
     demuxer_->SetReplyHandler(this->requestReply_);
     requestReply_.EnableDifferentTimeoutError();
     this->connectTimeout_ = settings->ConnectTimeout;
+
+    for (size_t i = 1; i < settings->ClientConnectionCount; ++i)
+    {
+        requestChannels_.push_back(make_unique<RequestChannel>(*this, *settings, i));
+    }
 }
 
 ErrorCode ServiceCommunicationClient::Release()
@@ -142,6 +228,12 @@ ErrorCode ServiceCommunicationClient::Release()
     transport_->RemoveConnectionFaultHandler();
     this->transport_->Stop();
     this->requestReply_.Close();
+
+    for (auto const & channel : requestChannels_)
+    {
+        channel->Close();
+    }
+
     return this->demuxer_->Close();
 }
 
@@ -234,6 +326,16 @@ ErrorCode ServiceCommunicationClient::OnOpen()
         serverSendTarget_ = transport_->ResolveTarget(serverAddress_);
     }
 
+    for (auto const & channel : requestChannels_)
+    {
+        if (!errorCode.IsSuccess())
+        {
+            break;
+        }
+
+        errorCode = channel->Open();
+    }
+
     if (explicitConnect_)
     {
         //It needs to be called after we set set service location
@@ -303,6 +405,28 @@ ErrorCode ServiceCommunicationClient::EndRequest(
     return SendRequestAsyncOperation::End(operation, reply);
 }
 
+RequestReply & ServiceCommunicationClient::SelectRequestChannel(__out ISendTarget::SPtr & target)
+{
+    // The server only accepts requests for a client id after the connect handshake on the primary connection,
+    // and forgets the client id when that connection faults. Extra channels are therefore only used while the
+    // primary connection is connected; otherwise the request goes to the primary connection, which reconnects
+    // or fails the request with the connection error.
+    if (!requestChannels_.empty() && (this->GetState() == this->Connected))
+    {
+        // Requests are pipelined on every connection, round robin spreads them across connections
+        auto index = (nextRequestChannel_++) % (requestChannels_.size() + 1);
+        if (index > 0)
+        {
+            auto & channel = *requestChannels_[index - 1];
+            target = channel.SendTarget;
+            return channel.RequestReplyObj;
+        }
+    }
+
+    target = serverSendTarget_;
+    return requestReply_;
+}
+
 ErrorCode ServiceCommunicationClient::SendOneWay(
     Transport::MessageUPtr && message)
 {
@@ -105,6 +105,14 @@ namespace Communication
             Api::IServiceConnectionEventHandlerPtr eventHandler_;
             Api::IServiceCommunicationMessageHandlerPtr messageHandler_;
             Transport::SecuritySettings securitySettings_;
+
+            // Additional connections to the server that only carry requests, they reuse clientId_ and rely on the
+            // connect handshake done on the primary connection, see SelectRequestChannel
+            class RequestChannel;
+            std::vector<std::unique_ptr<RequestChannel>> requestChannels_;
+            Common::atomic_uint64 nextRequestChannel_;
+            Transport::RequestReply & SelectRequestChannel(__out Transport::ISendTarget::SPtr & target);
+
             class ProcessRequestAsyncOperation;
             class SendRequestAsyncOperation;
             class TryConnectAsyncOperation;
@@ -48,7 +48,8 @@ namespace Communication
                     connectionHandler,
                     transport_->GetSettings().MaxConcurrentCalls,
                     transport_->GetSettings().MaxQueueSize,
-                    transport_->GetSettings().OperationTimeout);
+                    transport_->GetSettings().OperationTimeout,
+                    transport_->GetSettings().InlineDispatchEnabled);
             }
 
             virtual Common::AsyncOperationSPtr BeginOpen(
@@ -14,16 +14,7 @@ namespace Communication
             DENY_COPY(ServiceCommunicationTransportSettings);
 
         public:
-            ServiceCommunicationTransportSettings()
-                : maxMessageSize_(0)
-                , maxConcurrentCalls_(0)
-                , maxQueueSize_(INT_MAX)/*Default Queue Size*/
-                , securitySettings_()
-                , operationTimeout_(Common::TimeSpan::MaxValue)
-                , keepAliveTimeout_(Common::TimeSpan::MaxValue)
-                , connectTimeout_(Common::TimeSpan::FromSeconds(5))
-            {
-            }
+            ServiceCommunicationTransportSettings();
 
             ServiceCommunicationTransportSettings(
                 int maxMessageSize,
@@ -32,16 +23,7 @@ namespace Communication
                 Transport::SecuritySettings securitySettings,
                 Common::TimeSpan operationTimeout,
                 Common::TimeSpan keepAliveTimeout,
-                Common::TimeSpan connectTimeout)
-                : maxMessageSize_(maxMessageSize)
-                , maxConcurrentCalls_(maxConcurrentCalls)
-                , securitySettings_(securitySettings)
-                , operationTimeout_(operationTimeout)
-                , keepAliveTimeout_(keepAliveTimeout)
-                , maxQueueSize_(maxQueueSize)
-                , connectTimeout_(connectTimeout)
-            {
-            }
+                Common::TimeSpan connectTimeout);
 
             static Common::ErrorCode FromPublicApi(
                 __in FABRIC_SERVICE_TRANSPORT_SETTINGS const& settings,
@@ -75,6 +57,17 @@ namespace Communication
             __declspec(property(get = get_SecuritySetting)) Transport::SecuritySettings const & SecuritySetting;
             Transport::SecuritySettings const & get_SecuritySetting() const { return securitySettings_; }
 
+            // Dispatch requests on the receiving thread when MaxConcurrentCalls allows, listener side only. Opt-in, since
+            // the service handler then starts on the transport receive thread and must not block before it goes async.
+            __declspec(property(get = get_InlineDispatchEnabled, put = set_InlineDispatchEnabled)) bool InlineDispatchEnabled;
+            bool get_InlineDispatchEnabled() const { return inlineDispatchEnabled_; }
+            void set_InlineDispatchEnabled(bool value) { inlineDispatchEnabled_ = value; }
+
+            // Count of connections requests are spread over, client side only
+            __declspec(property(get = get_ClientConnectionCount, put = set_ClientConnectionCount)) uint ClientConnectionCount;
+            uint get_ClientConnectionCount() const { return clientConnectionCount_; }
+            void set_ClientConnectionCount(uint value) { clientConnectionCount_ = value; }
+
         private:
             static Common::ErrorCode Validate(
                 __in ServiceCommunicationTransportSettingsUPtr & toBeValidated);
@@ -86,6 +79,8 @@ namespace Communication
             Common::TimeSpan operationTimeout_;
             Common::TimeSpan keepAliveTimeout_;
             Common::TimeSpan connectTimeout_;
+            bool inlineDispatchEnabled_;
+            uint clientConnectionCount_;
         };
     }
 }
@@ -218,6 +218,11 @@ void ServiceMethodCallDispatcher::AddToQueue(MessageUPtr & message, ReceiverCont
         timeout = this->timeout_;
     }
 
+    if (this->TryDispatchInline(message, context, timeout))
+    {
+        return;
+    }
+
     //Creating copy as it will be moved when its Enqueue and we needed this in case Enqueue fails
     auto recieverContext =  *context;
 
@@ -249,8 +254,43 @@ void ServiceMethodCallDispatcher::AddToQueue(MessageUPtr & message, ReceiverCont
      }
  }
 
+bool ServiceMethodCallDispatcher::TryDispatchInline(MessageUPtr & message, ReceiverContextUPtr & context, TimeSpan const & timeout)
+{
+    // Requests already waiting in the queue go first, so inline dispatch does not reorder a backlog
+    if (!inlineDispatchEnabled_ || closed_.load() || (requestQueue_->GetQueueLength() > 0))
+    {
+        return false;
+    }
+
+    if (++activeInlineDispatches_ > maxInlineDispatches_)
+    {
+        --activeInlineDispatches_;
+        return false;
+    }
+
+    Transport::FabricActivityHeader activityHeader;
+    if (message->Headers.TryReadFirst(activityHeader))
+    {
+        WriteNoise(TraceType, serviceInfo_, "Dispatching Message {0} inline to Service: {1}", activityHeader.ActivityId, serviceInfo_);
+    }
+
+    // The reply is sent by the operation itself, handlers that complete synchronously reply on this thread
+    AsyncOperation::CreateAndStart<DispatchMessageAsyncOperation>(
+        *rootedServicePtr_.get(),
+        move(message),
+        move(context),
+        timeout,
+        serviceInfo_,
+        [](AsyncOperationSPtr const & operation) { DispatchMessageAsyncOperation::End(operation); },
+        rootedServicePtr_.get_Root()->CreateAsyncOperationRoot());
+
+    --activeInlineDispatches_;
+    return true;
+}
+
 void ServiceMethodCallDispatcher::Close()
 {
+    closed_.store(true);
     requestQueue_->Close();
 }
 
@@ -22,12 +22,17 @@ namespace Communication
                 Api::IServiceConnectionHandlerPtr const & connectionHandler,
                 int maxConcurrentCalls,
                 int maxQueueSize,
-                Common::TimeSpan const & timeout)
+                Common::TimeSpan const & timeout,
+                bool inlineDispatchEnabled = false)
                 : Common::RootedObject(root)
                 , rootedServicePtr_(rootedServicePtr)
                 , serviceInfo_(location)
                 , connectionHandler_(connectionHandler)
                 , timeout_(timeout)
+                , inlineDispatchEnabled_(inlineDispatchEnabled)
+                , maxInlineDispatches_(maxConcurrentCalls > 0 ? maxConcurrentCalls : static_cast<LONG>(Common::Environment::GetNumberOfProcessors()))
+                , activeInlineDispatches_(0)
+                , closed_(false)
             {
                 auto name = Common::wformatString("ServiceMethodCallDispatcher queue for {0}", location);
                 requestQueue_ = Common::make_unique<Common::CommonTimedJobQueue<ServiceCommunicationListener>>(
@@ -67,7 +72,11 @@ namespace Communication
 
            
         private:
-            
+
+            // Starts the service handler on the calling thread, bounded by MaxConcurrentCalls like the queue. The calling
+            // thread is the transport receive thread, so this is only done when the listener opted in.
+            bool TryDispatchInline(Transport::MessageUPtr & message, Transport::ReceiverContextUPtr & context, Common::TimeSpan const & timeout);
+
             std::unique_ptr<Common::CommonTimedJobQueue<ServiceCommunicationListener>> requestQueue_;
             Api::IServiceCommunicationMessageHandlerPtr rootedServicePtr_;
             Api::IServiceConnectionHandlerPtr connectionHandler_;
@@ -75,6 +84,10 @@ namespace Communication
 
             std::wstring serviceInfo_;
             Common::TimeSpan timeout_;
+            bool inlineDispatchEnabled_;
+            LONG maxInlineDispatches_;
+            Common::atomic_long activeInlineDispatches_;
+            Common::atomic_bool closed_;
             class DispatchMessageAsyncOperation;
             class ServiceMethodCallWorkItem;
         };
@@ -12,6 +12,39 @@ using  namespace Communication::TcpServiceCommunication;
 
 static const StringLiteral TraceType("ServiceCommunicationTransportSettings");
 
+ServiceCommunicationTransportSettings::ServiceCommunicationTransportSettings()
+    : maxMessageSize_(0)
+    , maxConcurrentCalls_(0)
+    , maxQueueSize_(INT_MAX)/*Default Queue Size*/
+    , securitySettings_()
+    , operationTimeout_(TimeSpan::MaxValue)
+    , keepAliveTimeout_(TimeSpan::MaxValue)
+    , connectTimeout_(TimeSpan::FromSeconds(5))
+    , inlineDispatchEnabled_(TransportConfig::GetConfig().ServiceCommunicationInlineDispatchEnabled)
+    , clientConnectionCount_(TransportConfig::GetConfig().ServiceCommunicationClientConnectionCount)
+{
+}
+
+ServiceCommunicationTransportSettings::ServiceCommunicationTransportSettings(
+    int maxMessageSize,
+    int maxConcurrentCalls,
+    int maxQueueSize,
+    SecuritySettings securitySettings,
+    TimeSpan operationTimeout,
+    TimeSpan keepAliveTimeout,
+    TimeSpan connectTimeout)
+    : maxMessageSize_(maxMessageSize)
+    , maxConcurrentCalls_(maxConcurrentCalls)
+    , maxQueueSize_(maxQueueSize)
+    , securitySettings_(securitySettings)
+    , operationTimeout_(operationTimeout)
+    , keepAliveTimeout_(keepAliveTimeout)
+    , connectTimeout_(connectTimeout)
+    , inlineDispatchEnabled_(TransportConfig::GetConfig().ServiceCommunicationInlineDispatchEnabled)
+    , clientConnectionCount_(TransportConfig::GetConfig().ServiceCommunicationClientConnectionCount)
+{
+}
+
 ErrorCode ServiceCommunicationTransportSettings::FromPublicApi(
     __in FABRIC_SERVICE_TRANSPORT_SETTINGS const & settings,
     __out ServiceCommunicationTransportSettingsUPtr & output)
@@ -204,6 +237,9 @@ bool ServiceCommunicationTransportSettings::operator == (ServiceCommunicationTra
     if (maxQueueSize_ != otherSettings.MaxQueueSize){
         return false;
     }
+    if (inlineDispatchEnabled_ != otherSettings.InlineDispatchEnabled){
+        return false;
+    }
     return true;
 }
 
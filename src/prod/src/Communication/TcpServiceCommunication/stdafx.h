@@ -7,6 +7,7 @@
 
 #include "Common/Common.h"
 #include "Transport/Transport.h"
+#include "Transport/TransportConfig.h"
 #include "api/definitions/ApiDefinitions.h"
 #include "Communication/TcpServiceCommunication/TcpClientServerPointers.h"
 #include "Communication/TcpServiceCommunication/ServiceCommunicationHelper.h"
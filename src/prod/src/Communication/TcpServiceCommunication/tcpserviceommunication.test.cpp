@@ -155,6 +155,15 @@ namespace Communication
                 IServiceCommunicationMessageHandlerPtr messageHandler,
                 IServiceConnectionEventHandlerPtr eventhandler);
 
+            // Keeps concurrency requests outstanding from one client until requestCount replies are received,
+            // then traces requests/sec and reply latency percentiles
+            static void LoopbackRpcTest(
+                ULONG port,
+                bool inlineDispatchEnabled,
+                uint clientConnectionCount,
+                uint requestCount,
+                uint concurrency);
+
         };
 
 
@@ -843,8 +852,155 @@ namespace Communication
 
         }
 
+        BOOST_AUTO_TEST_CASE(InlineDispatchWithConnectionPoolTest)
+        {
+            Trace.WriteInfo(TestSource, "Entering {0}", __FUNCTION__);
+            LoopbackRpcTest(10016, true, 4, 1000, 32);
+            Trace.WriteInfo(TestSource, "Leaving {0}", __FUNCTION__);
+        }
+
+        BOOST_AUTO_TEST_CASE(LoopbackRpcPerf, * boost::unit_test::disabled())
+        {
+            LoopbackRpcTest(10017, false, 1, 200000, 256);
+            LoopbackRpcTest(10017, true, 1, 200000, 256);
+            LoopbackRpcTest(10017, false, 4, 200000, 256);
+            LoopbackRpcTest(10017, true, 4, 200000, 256);
+        }
+
         BOOST_AUTO_TEST_SUITE_END()
 
+        void TcpServiceCommunicationTests::LoopbackRpcTest(
+            ULONG port,
+            bool inlineDispatchEnabled,
+            uint clientConnectionCount,
+            uint requestCount,
+            uint concurrency)
+        {
+            auto servicePtr = make_shared<DummyService>();
+            auto service = RootedObjectPointer<IServiceCommunicationMessageHandler>(servicePtr.get(), servicePtr->CreateComponentRoot());
+
+            auto serverSettings = make_unique<ServiceCommunicationTransportSettings>();
+            serverSettings->InlineDispatchEnabled = inlineDispatchEnabled;
+
+            IServiceCommunicationListenerPtr server;
+            auto error = ServiceCommunicationListenerFactory::GetServiceCommunicationListenerFactory().CreateServiceCommunicationListener(
+                move(serverSettings),
+                wformatString("localhost:{0}", port),
+                Guid::NewGuid().ToString(),
+                service,
+                IServiceConnectionHandlerPtr(),
+                server);
+            VERIFY_IS_TRUE(error.IsSuccess());
+
+            AutoResetEvent openEvent(false);
+            auto openOperation = server->BeginOpen(
+                [&](AsyncOperationSPtr const &) { openEvent.Set(); },
+                AsyncOperationSPtr());
+            VERIFY_IS_TRUE(openEvent.WaitOne(TimeSpan::FromSeconds(3)));
+            wstring endpointAddress;
+            VERIFY_IS_TRUE(server->EndOpen(openOperation, endpointAddress).IsSuccess());
+
+            auto clientSettings = make_unique<ServiceCommunicationTransportSettings>();
+            clientSettings->ClientConnectionCount = clientConnectionCount;
+
+            IServiceCommunicationClientPtr client;
+            error = ServiceCommunicationClientFactory::Create()->CreateServiceCommunicationClient(
+                endpointAddress,
+                clientSettings,
+                IServiceCommunicationMessageHandlerPtr(),
+                IServiceConnectionEventHandlerPtr(),
+                client);
+            VERIFY_IS_TRUE(error.IsSuccess());
+
+            ExclusiveLock lock;
+            vector<int64> latencies;
+            latencies.reserve(requestCount);
+            uint sent = 0;
+            uint failed = 0;
+            ManualResetEvent allReplied(false);
+
+            function<void()> sendNext = [&]
+            {
+                {
+                    AcquireExclusiveLock grab(lock);
+                    if (sent == requestCount)
+                    {
+                        return;
+                    }
+
+                    ++sent;
+                }
+
+                auto sendTime = Stopwatch::Now();
+                client->BeginRequest(
+                    make_unique<Message>(),
+                    TimeSpan::FromSeconds(30),
+                    [&, sendTime](AsyncOperationSPtr const & operation)
+                    {
+                        MessageUPtr reply;
+                        auto error = client->EndRequest(operation, reply);
+                        auto latency = (Stopwatch::Now() - sendTime).Ticks;
+                        {
+                            AcquireExclusiveLock grab(lock);
+                            latencies.push_back(latency);
+                            if (!error.IsSuccess())
+                            {
+                                ++failed;
+                            }
+
+                            if (latencies.size() == requestCount)
+                            {
+                                allReplied.Set();
+                                return;
+                            }
+                        }
+
+                        sendNext();
+                    },
+                    client.get_Root()->CreateAsyncOperationRoot());
+            };
+
+            Stopwatch stopwatch;
+            stopwatch.Start();
+            for (uint i = 0; i < concurrency; ++i)
+            {
+                sendNext();
+            }
+
+            VERIFY_IS_TRUE(allReplied.WaitOne(TimeSpan::FromMinutes(5)));
+            stopwatch.Stop();
+
+            VERIFY_ARE_EQUAL2(failed, 0u);
+
+            sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) { return TimeSpan::FromTicks(latencies[static_cast<size_t>(p * (latencies.size() - 1))]); };
+
+            Trace.WriteInfo(
+                TestSource,
+                "inline dispatch {0}, {1} connections, {2} outstanding: {3} requests in {4}, {5} requests/sec, p50 {6}, p99 {7}, max {8}",
+                inlineDispatchEnabled,
+                clientConnectionCount,
+                concurrency,
+                requestCount,
+                stopwatch.Elapsed,
+                static_cast<uint64>(requestCount * 1000.0 / stopwatch.Elapsed.TotalMillisecondsAsDouble()),
+                percentile(0.5),
+                percentile(0.99),
+                TimeSpan::FromTicks(latencies.back()));
+
+            client->CloseClient();
+
+            AutoResetEvent closeEvent(false);
+            server->BeginClose(
+                [&](AsyncOperationSPtr const & operation)
+                {
+                    server->EndClose(operation);
+                    closeEvent.Set();
+                },
+                AsyncOperationSPtr());
+            VERIFY_IS_TRUE(closeEvent.WaitOne(TimeSpan::FromSeconds(10)));
+        }
+
 
             IServiceCommunicationClientPtr TcpServiceCommunicationTests::CreateClient(bool secureMode, TimeSpan defaultTimeout, wstring const &  serverAddress, IServiceCommunicationMessageHandlerPtr messageHandler, IServiceConnectionEventHandlerPtr eventhandler)
         {
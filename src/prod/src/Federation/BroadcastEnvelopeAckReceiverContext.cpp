@@ -0,0 +1,72 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+using namespace Federation;
+using namespace std;
+
+BroadcastEnvelopeAck::BroadcastEnvelopeAck(
+    BroadcastManager & manager,
+    MessageId const & envelopeId,
+    size_t itemCount)
+    :   manager_(manager),
+        envelopeId_(envelopeId),
+        pendingCount_(itemCount),
+        completed_(false)
+{
+}
+
+void BroadcastEnvelopeAck::OnItemAck(ErrorCode const & error)
+{
+    {
+        AcquireExclusiveLock grab(lock_);
+        if (completed_)
+        {
+            return;
+        }
+
+        if (error.IsSuccess() && --pendingCount_ > 0)
+        {
+            return;
+        }
+
+        completed_ = true;
+    }
+
+    manager_.ProcessBroadcastLocalAck(envelopeId_, error);
+}
+
+BroadcastEnvelopeAckReceiverContext::BroadcastEnvelopeAckReceiverContext(
+    BroadcastEnvelopeAckSPtr const & envelopeAck,
+    MessageId const & broadcastId,
+    PartnerNodeSPtr const & from,
+    NodeInstance const & fromInstance)
+    :   OneWayReceiverContext(from, fromInstance, broadcastId),
+        envelopeAck_(envelopeAck)
+{
+}
+
+BroadcastEnvelopeAckReceiverContext::~BroadcastEnvelopeAckReceiverContext()
+{
+}
+
+void BroadcastEnvelopeAckReceiverContext::Accept()
+{
+    envelopeAck_->OnItemAck(ErrorCode::Success());
+}
+
+void BroadcastEnvelopeAckReceiverContext::Reject(ErrorCode const & error, ActivityId const & activityId)
+{
+    UNREFERENCED_PARAMETER(activityId);
+    envelopeAck_->OnItemAck(error);
+}
+
+void BroadcastEnvelopeAckReceiverContext::Ignore()
+{
+    Reject(ErrorCodeValue::NotReady);
+}
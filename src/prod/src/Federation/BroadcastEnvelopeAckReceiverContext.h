@@ -0,0 +1,55 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Federation
+{
+    // Local ack of a reliable broadcast envelope, sent once every item of the envelope is accepted,
+    // or as soon as one of them is rejected
+    class BroadcastEnvelopeAck
+    {
+        DENY_COPY(BroadcastEnvelopeAck);
+
+    public:
+        BroadcastEnvelopeAck(
+            BroadcastManager & manager,
+            Transport::MessageId const & envelopeId,
+            size_t itemCount);
+
+        void OnItemAck(Common::ErrorCode const & error);
+
+    private:
+        BroadcastManager & manager_;
+        Transport::MessageId envelopeId_;
+        size_t pendingCount_;
+        bool completed_;
+        Common::ExclusiveLock lock_;
+    };
+
+    typedef std::shared_ptr<BroadcastEnvelopeAck> BroadcastEnvelopeAckSPtr;
+
+    // Receiver context of one item of a reliable broadcast envelope
+    class BroadcastEnvelopeAckReceiverContext : public OneWayReceiverContext
+    {
+    public:
+        BroadcastEnvelopeAckReceiverContext(
+            BroadcastEnvelopeAckSPtr const & envelopeAck,
+            Transport::MessageId const & broadcastId,
+            PartnerNodeSPtr const & from,
+            NodeInstance const & fromInstance);
+
+        ~BroadcastEnvelopeAckReceiverContext();
+
+        virtual void Accept();
+
+        virtual void Reject(Common::ErrorCode const & error, Common::ActivityId const & activityId = Common::ActivityId::Empty);
+
+        virtual void Ignore();
+
+    private:
+        BroadcastEnvelopeAckSPtr envelopeAck_;
+    };
+}
@@ -0,0 +1,93 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Federation
+{
+    // A broadcast message packed into a broadcast envelope, carried as its serialized headers and body
+    class BroadcastEnvelopeItem : public Serialization::FabricSerializable
+    {
+    public:
+        BroadcastEnvelopeItem()
+        {
+        }
+
+        BroadcastEnvelopeItem(Transport::MessageId const & broadcastId, __in Transport::Message & message)
+            : broadcastId_(broadcastId)
+        {
+            for (Transport::BiqueChunkIterator chunk = message.BeginHeaderChunks(); chunk != message.EndHeaderChunks(); ++chunk)
+            {
+                headers_.insert(headers_.end(), chunk->cbegin(), chunk->cend());
+            }
+
+            for (Transport::BufferIterator chunk = message.BeginBodyChunks(); chunk != message.EndBodyChunks(); ++chunk)
+            {
+                body_.insert(body_.end(), chunk->cbegin(), chunk->cend());
+            }
+        }
+
+        __declspec(property(get=get_BroadcastId)) Transport::MessageId const & BroadcastId;
+        Transport::MessageId const & get_BroadcastId() const { return broadcastId_; }
+
+        size_t Size() const { return headers_.size() + body_.size(); }
+
+        Transport::MessageUPtr CreateMessage() const
+        {
+            Transport::ByteBique headerBytes;
+            Transport::BiqueWriteStream(headerBytes).WriteBytes(headers_.data(), headers_.size());
+
+            Transport::ByteBique bodyBytes;
+            Transport::BiqueWriteStream(bodyBytes).WriteBytes(body_.data(), body_.size());
+
+            return Common::make_unique<Transport::Message>(
+                Transport::ByteBiqueRange(std::move(headerBytes)),
+                Transport::ByteBiqueRange(std::move(bodyBytes)),
+                Transport::Message::NullReceiveTime());
+        }
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const
+        {
+            w.Write("{0}:{1}+{2}", broadcastId_, headers_.size(), body_.size());
+        }
+
+        FABRIC_FIELDS_03(broadcastId_, headers_, body_);
+
+    private:
+        Transport::MessageId broadcastId_;
+        std::vector<byte> headers_;
+        std::vector<byte> body_;
+    };
+
+    // Body of a broadcast envelope, which carries broadcasts issued by one node within a short window
+    // through a single broadcast tree
+    class BroadcastEnvelopeBody : public Serialization::FabricSerializable
+    {
+    public:
+        BroadcastEnvelopeBody()
+        {
+        }
+
+        explicit BroadcastEnvelopeBody(std::vector<BroadcastEnvelopeItem> && items)
+            : items_(std::move(items))
+        {
+        }
+
+        __declspec(property(get=get_Items)) std::vector<BroadcastEnvelopeItem> const & Items;
+        std::vector<BroadcastEnvelopeItem> const & get_Items() const { return items_; }
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const
+        {
+            w.Write("{0}", items_);
+        }
+
+        FABRIC_FIELDS_01(items_);
+
+    private:
+        std::vector<BroadcastEnvelopeItem> items_;
+    };
+}
+
+DEFINE_USER_ARRAY_UTILITY(Federation::BroadcastEnvelopeItem);
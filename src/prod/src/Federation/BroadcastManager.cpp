@@ -13,6 +13,7 @@ using namespace std;
 const int BroadcastStepCountMax = 10; // If the step count has ever gone this far, rebroadcast the message to the whole ring
 
 StringLiteral const BroadcastTimerTag("Broadcast");
+StringLiteral const BroadcastCoalescingTimerTag("BroadcastCoalescing");
 
 StringLiteral const TraceStart("Start");
 StringLiteral const TraceRoute("Route");
@@ -21,6 +22,7 @@ StringLiteral const TraceReceive("Receive");
 StringLiteral const TraceDrop("Drop");
 StringLiteral const TraceFault("Fault");
 StringLiteral const TraceCancel("Cancel");
+StringLiteral const TraceEnvelope("Envelope");
 
 class BroadcastManager::ReliableOneWayBroadcastOperation : public AsyncOperation
 {
@@ -39,6 +41,8 @@ BroadcastManager::BroadcastManager(SiteNode & siteNode)
     :   siteNode_(siteNode),
         broadcastMessagesAlreadySeen_(FederationConfig::GetConfig().BroadcastContextKeepDuration),
         reliableBroadcastContexts_(FederationConfig::GetConfig().BroadcastContextKeepDuration),
+        pendingEnvelopeSize_(0),
+        pendingReliableSize_(0),
         closed_(false)
 {
     SiteNodeSPtr siteNodeSPtr = siteNode.GetSiteNodeSPtr();
@@ -52,6 +56,14 @@ BroadcastManager::BroadcastManager(SiteNode & siteNode)
 
     TimeSpan interval = FederationConfig::GetConfig().BroadcastContextKeepDuration;
     timer_->Change(interval, interval);
+
+    coalescingTimer_ = Timer::Create(
+        BroadcastCoalescingTimerTag,
+        [this, siteNodeSPtr] (TimerSPtr const &)
+        {
+            this->OnCoalescingTimer();
+        },
+        true);
 }
 
 BroadcastManager::~BroadcastManager()
@@ -65,7 +77,7 @@ void BroadcastManager::OnTimer()
     this->reliableBroadcastContexts_.RemoveExpiredEntries();
 }
 
-BroadcastHeader BroadcastManager::AddBroadcastHeaders(__in Message & message, bool expectsReply, bool expectsAck)
+BroadcastHeader BroadcastManager::CreateBroadcastHeader(__in Message & message, bool expectsReply, bool expectsAck)
 {
     MessageId id = message.MessageId;
     if (id.IsEmpty())
@@ -79,7 +91,12 @@ BroadcastHeader BroadcastManager::AddBroadcastHeaders(__in Message & message, bo
 
     message.Idempotent = true;
 
-    auto header = BroadcastHeader(this->siteNode_.Instance, id, expectsReply, expectsAck, siteNode_.RingName);
+    return BroadcastHeader(this->siteNode_.Instance, id, expectsReply, expectsAck, siteNode_.RingName);
+}
+
+BroadcastHeader BroadcastManager::AddBroadcastHeaders(__in Message & message, bool expectsReply, bool expectsAck)
+{
+    auto header = this->CreateBroadcastHeader(message, expectsReply, expectsAck);
 
     message.Headers.Add(header);
 
@@ -93,12 +110,185 @@ void BroadcastManager::OnBroadcastCompleted(MessageId const & broadcastId)
 
 void BroadcastManager::Broadcast(MessageUPtr && message)
 {
+    if (FederationConfig::GetConfig().BroadcastCoalescingInterval > TimeSpan::Zero)
+    {
+        this->CoalesceBroadcast(std::move(message), nullptr);
+        return;
+    }
+
     auto header = this->AddBroadcastHeaders(*message, false, false);
     this->InternalBroadcast(std::move(message), header);
 }
 
+bool BroadcastManager::CoalesceBroadcast(MessageUPtr && message, AsyncOperationSPtr const & operation)
+{
+    bool expectsAck = (operation != nullptr);
+
+    // Items in an envelope carry their own broadcast id but no broadcast header, the envelope header is used for forwarding
+    auto header = this->CreateBroadcastHeader(*message, false, expectsAck);
+    BroadcastEnvelopeItem item(header.BroadcastId, *message);
+
+    auto const & config = FederationConfig::GetConfig();
+    vector<BroadcastEnvelopeItem> items;
+    vector<AsyncOperationSPtr> operations;
+    bool startTimer = false;
+    {
+        AcquireWriteLock grab(lock_);
+        if (closed_)
+        {
+            WriteInfo(TraceStart, "dropping broadcast {0}, broadcast manager closed", header.BroadcastId);
+            return false;
+        }
+
+        // One way and reliable broadcasts are packed into separate envelopes, only the latter are acked
+        auto & pendingItems = (expectsAck ? pendingReliableItems_ : pendingEnvelopeItems_);
+        auto & pendingSize = (expectsAck ? pendingReliableSize_ : pendingEnvelopeSize_);
+
+        startTimer = (pendingEnvelopeItems_.empty() && pendingReliableItems_.empty());
+
+        pendingSize += item.Size();
+        pendingItems.push_back(move(item));
+        if (expectsAck)
+        {
+            pendingReliableOperations_.push_back(operation);
+        }
+
+        if (pendingItems.size() >= static_cast<size_t>(config.BroadcastCoalescingMaxCount) ||
+            pendingSize >= static_cast<size_t>(config.BroadcastCoalescingMaxSize))
+        {
+            items.swap(pendingItems);
+            pendingSize = 0;
+            if (expectsAck)
+            {
+                operations.swap(pendingReliableOperations_);
+            }
+
+            startTimer = false;
+        }
+    }
+
+    WriteInfo(
+        TraceStart,
+        "Broadcast coalesced for {0}",
+        header);
+
+    if (startTimer)
+    {
+        coalescingTimer_->Change(config.BroadcastCoalescingInterval);
+    }
+
+    if (expectsAck)
+    {
+        // Local delivery of a reliable broadcast is part of its envelope, so that it is acked with the other items
+        this->SendReliableBroadcastEnvelope(move(items), move(operations));
+        return true;
+    }
+
+    this->SendBroadcastEnvelope(move(items));
+
+    // Local delivery does not wait for the envelope
+    message->Headers.Add(header);
+    this->DispatchBroadcastMessage(message, header);
+
+    return true;
+}
+
+void BroadcastManager::OnCoalescingTimer()
+{
+    vector<BroadcastEnvelopeItem> items;
+    vector<BroadcastEnvelopeItem> reliableItems;
+    vector<AsyncOperationSPtr> reliableOperations;
+    {
+        AcquireWriteLock grab(lock_);
+        if (closed_)
+        {
+            return;
+        }
+
+        items.swap(pendingEnvelopeItems_);
+        pendingEnvelopeSize_ = 0;
+
+        reliableItems.swap(pendingReliableItems_);
+        reliableOperations.swap(pendingReliableOperations_);
+        pendingReliableSize_ = 0;
+    }
+
+    this->SendBroadcastEnvelope(move(items));
+    this->SendReliableBroadcastEnvelope(move(reliableItems), move(reliableOperations));
+}
+
+void BroadcastManager::SendBroadcastEnvelope(vector<BroadcastEnvelopeItem> && items)
+{
+    if (items.empty())
+    {
+        return;
+    }
+
+    size_t count = items.size();
+    auto envelope = FederationMessage::GetBroadcastEnvelope().CreateMessage(BroadcastEnvelopeBody(move(items)));
+    auto header = this->AddBroadcastHeaders(*envelope, false, false);
+
+    WriteInfo(
+        TraceEnvelope,
+        "Broadcast envelope started for {0} with {1} messages",
+        header,
+        count);
+
+    this->BroadcastMessageToRange(envelope, NodeIdRange::Full, header);
+    auto from = dynamic_pointer_cast<PartnerNode>(this->siteNode_.shared_from_this());
+    this->BroadcastToSuccessorAndPredecessor(envelope, from, 0, header);
+}
+
+void BroadcastManager::SendReliableBroadcastEnvelope(vector<BroadcastEnvelopeItem> && items, vector<AsyncOperationSPtr> && operations)
+{
+    if (items.empty())
+    {
+        return;
+    }
+
+    size_t count = items.size();
+    auto envelope = FederationMessage::GetBroadcastEnvelope().CreateMessage(BroadcastEnvelopeBody(move(items)));
+    auto header = this->AddBroadcastHeaders(*envelope, false, true);
+
+    WriteInfo(
+        TraceEnvelope,
+        "Reliable broadcast envelope started for {0} with {1} messages",
+        header,
+        count);
+
+    // Every node acks the envelope once it has accepted all of its items, so the broadcasts packed into it
+    // complete together, with the error of the envelope
+    auto envelopeOperation = AsyncOperation::CreateAndStart<ReliableOneWayBroadcastOperation>(
+        [operations](AsyncOperationSPtr const & envelopeOperation)
+        {
+            ErrorCode error = AsyncOperation::End<ReliableOneWayBroadcastOperation>(envelopeOperation)->Error;
+            for (auto const & operation : operations)
+            {
+                operation->TryComplete(operation, error);
+            }
+        },
+        AsyncOperationSPtr());
+
+    if (!this->BroadcastWithAck(envelope, false, NodeIdRange::Full, header, nullptr, envelopeOperation))
+    {
+        envelopeOperation->TryComplete(envelopeOperation, ErrorCodeValue::ObjectClosed);
+    }
+}
+
 AsyncOperationSPtr BroadcastManager::BeginBroadcast(MessageUPtr && message, bool toAllRings, AsyncCallback const & callback, AsyncOperationSPtr const & parent)
 {
+    // Envelopes are only broadcast on the local ring, so broadcasts to all rings keep their own tree
+    if (!toAllRings && FederationConfig::GetConfig().BroadcastCoalescingInterval > TimeSpan::Zero)
+    {
+        AsyncOperationSPtr operation = AsyncOperation::CreateAndStart<ReliableOneWayBroadcastOperation>(callback, parent);
+        if (!this->CoalesceBroadcast(std::move(message), operation))
+        {
+            operation->TryComplete(operation, ErrorCodeValue::ObjectClosed);
+        }
+
+        return operation;
+    }
+
     auto header = this->AddBroadcastHeaders(*message, false, true);
     WriteInfo(
         TraceStart,
@@ -213,6 +403,12 @@ bool BroadcastManager::DispatchBroadcastMessage(
     BroadcastHeader const & broadcastHeader,
     RequestReceiverContextUPtr && routedRequestContext)
 {
+    if (message->Actor == FederationMessage::Actor &&
+        message->Action == FederationMessage::GetBroadcastEnvelope().Action)
+    {
+        return this->DispatchBroadcastEnvelope(*message, broadcastHeader);
+    }
+
     // An application may expect the same messageid it gave to a broadcast message on the other side, this is also useful for testing
     ASSERT_IF(!message->MessageId.IsEmpty(), "MessageId not removed for {0}", *message);
     message->Headers.Add(MessageIdHeader(broadcastHeader.BroadcastId));
@@ -254,6 +450,67 @@ bool BroadcastManager::DispatchBroadcastMessage(
     return true;
 }
 
+bool BroadcastManager::DispatchBroadcastEnvelope(__in Message & envelope, BroadcastHeader const & broadcastHeader)
+{
+    BroadcastEnvelopeBody body;
+    if (!envelope.GetBody(body))
+    {
+        WriteError(
+            TraceFault,
+            "Could not deserialize broadcast envelope {0} at node {1}: {2:x}",
+            broadcastHeader.BroadcastId,
+            this->siteNode_.Instance,
+            envelope.GetStatus());
+        return false;
+    }
+
+    PartnerNodeSPtr from = this->siteNode_.Table.Get(broadcastHeader.From, broadcastHeader.FromRing);
+    if (!from)
+    {
+        WriteWarning(
+            TraceFault,
+            "Could not get the nodeId, {0}, from the routing table at node {1} for broadcast envelope {2}",
+            broadcastHeader.From,
+            this->siteNode_.Instance,
+            broadcastHeader.BroadcastId);
+        return false;
+    }
+
+    WriteInfo(
+        TraceEnvelope,
+        "Dispatching broadcast envelope {0} with {1} messages at node {2}",
+        broadcastHeader.BroadcastId,
+        body.Items.size(),
+        this->siteNode_.Instance);
+
+    // Items of a reliable envelope are acked separately, the envelope is acked locally once all of them are
+    BroadcastEnvelopeAckSPtr envelopeAck;
+    if (broadcastHeader.ExpectsAck)
+    {
+        envelopeAck = make_shared<BroadcastEnvelopeAck>(*this, broadcastHeader.BroadcastId, body.Items.size());
+    }
+
+    for (auto const & item : body.Items)
+    {
+        MessageUPtr message = item.CreateMessage();
+        message->Headers.Add(MessageIdHeader(item.BroadcastId));
+
+        OneWayReceiverContextUPtr context;
+        if (envelopeAck)
+        {
+            context = make_unique<BroadcastEnvelopeAckReceiverContext>(envelopeAck, item.BroadcastId, from, broadcastHeader.From);
+        }
+        else
+        {
+            context = make_unique<OneWayReceiverContext>(from, broadcastHeader.From, item.BroadcastId);
+        }
+
+        this->siteNode_.GetPointToPointManager().ActorDispatchOneWay(message, context);
+    }
+
+    return true;
+}
+
 void BroadcastManager::ForwardAndDispatch(
     MessageUPtr & message, 
     PartnerNodeSPtr const & hopFrom,
@@ -769,6 +1026,7 @@ void BroadcastManager::Stop()
         broadcastReplyContext->Cancel();
     }
 
+    vector<AsyncOperationSPtr> pendingReliableOperations;
     {
         AcquireWriteLock grab(lock_);
         for (auto it = reliableBroadcastContexts_.begin(); it != reliableBroadcastContexts_.end(); ++it)
@@ -778,8 +1036,21 @@ void BroadcastManager::Stop()
 
         reliableBroadcastContexts_.clear();
 
+        pendingEnvelopeItems_.clear();
+        pendingEnvelopeSize_ = 0;
+
+        pendingReliableItems_.clear();
+        pendingReliableOperations.swap(pendingReliableOperations_);
+        pendingReliableSize_ = 0;
+
         closed_ = true;
     }
 
     timer_->Cancel();
+    coalescingTimer_->Cancel();
+
+    for (auto const & operation : pendingReliableOperations)
+    {
+        operation->TryComplete(operation, ErrorCodeValue::OperationCanceled);
+    }
 }
@@ -41,12 +41,26 @@ namespace Federation
 
         void InternalBroadcast(Transport::MessageUPtr && message, BroadcastHeader const & header);
 
+        // Packs a broadcast into the pending envelope. A reliable broadcast passes its operation, which is completed
+        // when the envelope it was packed into is acked by the whole ring. Returns false if the manager is closed.
+        bool CoalesceBroadcast(Transport::MessageUPtr && message, Common::AsyncOperationSPtr const & operation);
+
+        void SendBroadcastEnvelope(std::vector<BroadcastEnvelopeItem> && items);
+
+        void SendReliableBroadcastEnvelope(std::vector<BroadcastEnvelopeItem> && items, std::vector<Common::AsyncOperationSPtr> && operations);
+
+        void OnCoalescingTimer();
+
+        BroadcastHeader CreateBroadcastHeader(__in Transport::Message & message, bool expectsReply, bool expectsAck);
+
         BroadcastHeader AddBroadcastHeaders(__in Transport::Message & message, bool expectsReply, bool expectsAck);
 
         void ProcessBroadcastMessage(__in Transport::MessageUPtr & message, PartnerNodeSPtr const & hopFrom);
 
         bool DispatchBroadcastMessage(__in Transport::MessageUPtr & message, BroadcastHeader const & broadcastHeader, RequestReceiverContextUPtr && routedRequestContext = nullptr);
 
+        bool DispatchBroadcastEnvelope(__in Transport::Message & envelope, BroadcastHeader const & broadcastHeader);
+
         void ForwardAndDispatch(Transport::MessageUPtr & message, PartnerNodeSPtr const & hopFrom, BroadcastHeader const & header, RequestReceiverContextUPtr && requestContext);
 
         void BroadcastToSuccessorAndPredecessor(Transport::MessageUPtr & message, PartnerNodeSPtr const & hopFrom, int broadcastStepCount, BroadcastHeader const & header);
@@ -68,6 +82,12 @@ namespace Federation
         Common::ExpiringSet<Transport::MessageId, BroadcastForwardContext> reliableBroadcastContexts_;
         Common::SynchronizedMap<Transport::MessageId, BroadcastReplyContextSPtr> requestTable_;
         Common::TimerSPtr timer_;
+        Common::TimerSPtr coalescingTimer_;
+        std::vector<BroadcastEnvelopeItem> pendingEnvelopeItems_;
+        size_t pendingEnvelopeSize_;
+        std::vector<BroadcastEnvelopeItem> pendingReliableItems_;
+        std::vector<Common::AsyncOperationSPtr> pendingReliableOperations_;
+        size_t pendingReliableSize_;
         bool closed_;
         RWLOCK(Federation.BroadcastManager, lock_);
 
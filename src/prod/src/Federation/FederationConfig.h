@@ -94,6 +94,14 @@ namespace Federation
         INTERNAL_CONFIG_ENTRY(int, L"Federation", BroadcastPropagationFactor, 8, Common::ConfigEntryUpgradePolicy::Static, Common::GreaterThan(1));
         // The max number of nodes in each child of spanning tree.
         INTERNAL_CONFIG_ENTRY(int, L"Federation", MaxMulticastSubtreeSize, 1000, Common::ConfigEntryUpgradePolicy::Static, Common::GreaterThan(1));
+        // One way broadcasts issued within this interval are packed into one envelope and share a single broadcast tree,
+        // set to 0 to disable. All nodes must understand broadcast envelopes before this is enabled.
+        // Broadcast and BeginBroadcast on the local ring are coalesced. Broadcasts to all rings, BroadcastRequest and multicasts are not.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Federation", BroadcastCoalescingInterval, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Static);
+        // The max number of broadcasts packed into one envelope.
+        INTERNAL_CONFIG_ENTRY(int, L"Federation", BroadcastCoalescingMaxCount, 256, Common::ConfigEntryUpgradePolicy::Static, Common::GreaterThan(0));
+        // The max total size in bytes of broadcasts packed into one envelope.
+        INTERNAL_CONFIG_ENTRY(int, L"Federation", BroadcastCoalescingMaxSize, 1024 * 1024, Common::ConfigEntryUpgradePolicy::Static, Common::GreaterThan(0));
 
         /* -------------- Join protocol -------------- */
 
@@ -80,6 +80,8 @@ namespace Federation
     Global<FederationMessage> FederationMessage::BroadcastAck = make_global<FederationMessage>(L"BroadcastAck", Actor::Empty);
     Global<FederationMessage> FederationMessage::MulticastAck = make_global<FederationMessage>(L"MulticastAck", Actor::Empty);
 
+    Global<FederationMessage> FederationMessage::BroadcastEnvelope = make_global<FederationMessage>(L"BroadcastEnvelope");
+
     Global<FederationMessage> FederationMessage::LivenessUpdate = make_global<FederationMessage>(L"LivenessUpdate");
 
     Global<FederationMessage> FederationMessage::ExternalRingPing = make_global<FederationMessage>(L"ExternalRingPing");
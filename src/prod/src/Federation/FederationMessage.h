@@ -65,6 +65,7 @@ namespace Federation
         static FederationMessage const & GetLivenessQueryReply() {return LivenessQueryReply; }
 
         static FederationMessage const & GetBroadcastAck() {return BroadcastAck; }
+        static FederationMessage const & GetBroadcastEnvelope() {return BroadcastEnvelope; }
         static FederationMessage const & GetMulticastAck() {return MulticastAck; }
 
         static FederationMessage const & GetLivenessUpdate() {return LivenessUpdate; }
@@ -157,6 +158,7 @@ namespace Federation
         static Common::Global<FederationMessage> LivenessQueryRequest;
         static Common::Global<FederationMessage> LivenessQueryReply;
         static Common::Global<FederationMessage> BroadcastAck;
+        static Common::Global<FederationMessage> BroadcastEnvelope;
         static Common::Global<FederationMessage> MulticastAck;
         static Common::Global<FederationMessage> LivenessUpdate;
         static Common::Global<FederationMessage> ExternalRingPing;
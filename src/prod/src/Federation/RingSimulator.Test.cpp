@@ -0,0 +1,196 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+#include "SiteNodeHelper.h"
+#include "RingSimulator.h"
+
+namespace FederationUnitTests
+{
+    using namespace std;
+    using namespace Common;
+    using namespace Federation;
+
+    const StringLiteral TraceType("RingSimulatorTest");
+
+    class RingSimulatorTests
+    {
+    protected:
+        static void RingScaleTest(size_t nodeCount, TimeSpan linkLatency);
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(RingSimulatorTestsSuite, RingSimulatorTests)
+
+    BOOST_AUTO_TEST_CASE(SmallRingTest)
+    {
+        size_t const nodeCount = 8;
+        RingSimulator ring(nodeCount, 3);
+
+        auto error = ring.Open(nodeCount, TimeSpan::FromSeconds(60));
+        VERIFY_IS_TRUE(error.IsSuccess());
+        VERIFY_ARE_EQUAL2(ring.JoinLatency().Count(), nodeCount);
+
+        error = ring.RouteRequests(50, 10, TimeSpan::FromSeconds(30));
+        VERIFY_IS_TRUE(error.IsSuccess());
+        VERIFY_ARE_EQUAL2(ring.RouteLatency().Count(), 50u);
+
+        error = ring.Broadcast(5, TimeSpan::FromSeconds(30));
+        VERIFY_IS_TRUE(error.IsSuccess());
+        VERIFY_ARE_EQUAL2(ring.BroadcastLatency().Count(), 5u);
+        VERIFY_IS_TRUE(ring.GetBroadcastFanout() >= nodeCount - 1);
+
+        VERIFY_IS_TRUE(ring.GetTotalMessageCount() > 0);
+        ring.TraceStatistics();
+    }
+
+    BOOST_AUTO_TEST_CASE(BroadcastCoalescingTest)
+    {
+        size_t const nodeCount = 16;
+        size_t const broadcastCount = 100;
+
+        uint64 separateMessages;
+        {
+            RingSimulator ring(nodeCount, 3);
+            VERIFY_IS_TRUE(ring.Open(nodeCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            ring.ResetStatistics();
+            VERIFY_IS_TRUE(ring.BroadcastOneWay(broadcastCount, TimeSpan::FromSeconds(30)).IsSuccess());
+
+            separateMessages = ring.GetMessageCount(L"SimulatorBroadcast");
+            VERIFY_ARE_EQUAL2(ring.GetMessageCount(L"BroadcastEnvelope"), 0u);
+            ring.TraceStatistics();
+        }
+
+        uint64 envelopeMessages;
+        {
+            RingSimulator ring(nodeCount, 3);
+
+            // the simulator resets FederationConfig when it is constructed and destroyed
+            FederationConfig::GetConfig().BroadcastCoalescingInterval = TimeSpan::FromMilliseconds(200);
+
+            VERIFY_IS_TRUE(ring.Open(nodeCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            ring.ResetStatistics();
+            VERIFY_IS_TRUE(ring.BroadcastOneWay(broadcastCount, TimeSpan::FromSeconds(30)).IsSuccess());
+
+            envelopeMessages = ring.GetMessageCount(L"BroadcastEnvelope");
+            VERIFY_ARE_EQUAL2(ring.GetMessageCount(L"SimulatorBroadcast"), 0u);
+            ring.TraceStatistics();
+        }
+
+        Trace.WriteInfo(
+            TraceType,
+            "{0} broadcasts on {1} nodes: {2} messages without coalescing, {3} with coalescing",
+            broadcastCount,
+            nodeCount,
+            separateMessages,
+            envelopeMessages);
+
+        VERIFY_IS_TRUE(envelopeMessages * 10 < separateMessages);
+    }
+
+    BOOST_AUTO_TEST_CASE(ReliableBroadcastCoalescingTest)
+    {
+        size_t const nodeCount = 16;
+        size_t const broadcastCount = 100;
+
+        uint64 separateMessages;
+        {
+            RingSimulator ring(nodeCount, 3);
+            VERIFY_IS_TRUE(ring.Open(nodeCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            ring.ResetStatistics();
+            VERIFY_IS_TRUE(ring.BroadcastBatch(broadcastCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            separateMessages = ring.GetMessageCount(L"SimulatorBroadcast");
+            VERIFY_ARE_EQUAL2(ring.GetMessageCount(L"BroadcastEnvelope"), 0u);
+            VERIFY_IS_TRUE(ring.GetBroadcastFanout() >= nodeCount - 1);
+            ring.TraceStatistics();
+        }
+
+        uint64 envelopeMessages;
+        {
+            RingSimulator ring(nodeCount, 3);
+
+            // the simulator resets FederationConfig when it is constructed and destroyed
+            FederationConfig::GetConfig().BroadcastCoalescingInterval = TimeSpan::FromMilliseconds(200);
+
+            VERIFY_IS_TRUE(ring.Open(nodeCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            ring.ResetStatistics();
+
+            // every broadcast completes only once every node has accepted it, the items of an envelope are acked together
+            VERIFY_IS_TRUE(ring.BroadcastBatch(broadcastCount, TimeSpan::FromSeconds(60)).IsSuccess());
+
+            envelopeMessages = ring.GetMessageCount(L"BroadcastEnvelope");
+            VERIFY_ARE_EQUAL2(ring.GetMessageCount(L"SimulatorBroadcast"), 0u);
+            VERIFY_IS_TRUE(ring.GetBroadcastFanout() >= nodeCount - 1);
+            ring.TraceStatistics();
+        }
+
+        Trace.WriteInfo(
+            TraceType,
+            "{0} reliable broadcasts on {1} nodes: {2} messages without coalescing, {3} with coalescing",
+            broadcastCount,
+            nodeCount,
+            separateMessages,
+            envelopeMessages);
+
+        VERIFY_IS_TRUE(envelopeMessages * 10 < separateMessages);
+    }
+
+    BOOST_AUTO_TEST_CASE(RingScale500Perf, * boost::unit_test::disabled())
+    {
+        RingScaleTest(500, TimeSpan::Zero);
+    }
+
+    BOOST_AUTO_TEST_CASE(RingScale1000Perf, * boost::unit_test::disabled())
+    {
+        RingScaleTest(1000, TimeSpan::Zero);
+    }
+
+    BOOST_AUTO_TEST_CASE(RingScale2000Perf, * boost::unit_test::disabled())
+    {
+        RingScaleTest(2000, TimeSpan::Zero);
+    }
+
+    BOOST_AUTO_TEST_CASE(RingScale1000WithLatencyPerf, * boost::unit_test::disabled())
+    {
+        RingScaleTest(1000, TimeSpan::FromMilliseconds(1));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    void RingSimulatorTests::RingScaleTest(size_t nodeCount, TimeSpan linkLatency)
+    {
+        RingSimulator ring(nodeCount, 5, linkLatency);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        VERIFY_IS_TRUE(ring.Open(50, TimeSpan::FromMinutes(5)).IsSuccess());
+        stopwatch.Stop();
+
+        Trace.WriteInfo(TraceType, "{0} nodes joined in {1}", nodeCount, stopwatch.Elapsed);
+        ring.TraceStatistics();
+
+        ring.ResetStatistics();
+        VERIFY_IS_TRUE(ring.RouteRequests(10000, 100, TimeSpan::FromMinutes(1)).IsSuccess());
+        ring.TraceStatistics();
+
+        ring.ResetStatistics();
+        VERIFY_IS_TRUE(ring.Broadcast(20, TimeSpan::FromMinutes(1)).IsSuccess());
+        ring.TraceStatistics();
+
+        // steady state neighborhood maintenance traffic
+        ring.ResetStatistics();
+        Sleep(30000);
+        Trace.WriteInfo(TraceType, "idle ring of {0} nodes sent {1} messages in 30 seconds", nodeCount, ring.GetTotalMessageCount());
+        ring.TraceStatistics();
+    }
+}
@@ -0,0 +1,681 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "Transport/MemoryTransport.h"
+#include "SiteNodeHelper.h"
+#include "RingSimulator.h"
+
+using namespace Federation;
+using namespace Transport;
+using namespace Common;
+using namespace std;
+using namespace FederationUnitTests;
+
+namespace
+{
+    const StringLiteral TraceType("RingSimulator");
+
+    Actor::Enum const SimulatorActor = Actor::GenericTestActor;
+    GlobalWString const RoutedAction = make_global<wstring>(L"SimulatorRouted");
+    GlobalWString const BroadcastAction = make_global<wstring>(L"SimulatorBroadcast");
+
+    // Deterministic port ranges for the in-memory addresses, nothing is bound
+    USHORT const FederationBasePort = 20000;
+    USHORT const LeaseAgentBasePort = 30000;
+
+    // Bounds the number of asynchronous operations in flight. Acquire and WaitForAll are called from
+    // a single thread, Release from completion callbacks. Acquire fails once an operation has failed.
+    class OperationThrottle
+    {
+        DENY_COPY(OperationThrottle);
+
+    public:
+        explicit OperationThrottle(size_t limit)
+            : limit_(max<size_t>(limit, 1))
+            , pending_(0)
+        {
+        }
+
+        bool Acquire()
+        {
+            for (;;)
+            {
+                {
+                    AcquireExclusiveLock grab(lock_);
+                    if (!error_.IsSuccess())
+                    {
+                        return false;
+                    }
+
+                    if (pending_ < limit_)
+                    {
+                        ++pending_;
+                        return true;
+                    }
+                }
+
+                released_.WaitOne();
+            }
+        }
+
+        void Release(ErrorCode const & error)
+        {
+            // signal under the lock, the throttle may be destroyed as soon as the lock is released
+            AcquireExclusiveLock grab(lock_);
+            --pending_;
+            if (error_.IsSuccess())
+            {
+                error_ = error;
+            }
+
+            released_.Set();
+        }
+
+        ErrorCode WaitForAll()
+        {
+            for (;;)
+            {
+                {
+                    AcquireExclusiveLock grab(lock_);
+                    if (pending_ == 0)
+                    {
+                        return error_;
+                    }
+                }
+
+                released_.WaitOne();
+            }
+        }
+
+    private:
+        size_t const limit_;
+        ExclusiveLock lock_;
+        AutoResetEvent released_;
+        size_t pending_;
+        ErrorCode error_;
+    };
+}
+
+LatencyHistogram::LatencyHistogram()
+    : buckets_(BucketCount)
+    , count_(0)
+    , total_(TimeSpan::Zero)
+    , max_(TimeSpan::Zero)
+{
+}
+
+void LatencyHistogram::Add(TimeSpan value)
+{
+    int64 microseconds = value.Ticks / 10;
+    size_t bucket = 0;
+    while ((bucket + 1 < BucketCount) && ((1LL << bucket) <= microseconds))
+    {
+        ++bucket;
+    }
+
+    ++buckets_[bucket];
+    ++count_;
+    total_ = total_ + value;
+    max_ = max(max_, value);
+}
+
+TimeSpan LatencyHistogram::Mean() const
+{
+    return (count_ == 0) ? TimeSpan::Zero : TimeSpan::FromTicks(total_.Ticks / static_cast<int64>(count_));
+}
+
+TimeSpan LatencyHistogram::Percentile(double percentile) const
+{
+    uint64 threshold = static_cast<uint64>(count_ * percentile / 100);
+    uint64 seen = 0;
+    for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+    {
+        seen += buckets_[bucket];
+        if (seen > threshold)
+        {
+            return min(TimeSpan::FromTicks((1LL << bucket) * 10), max_);
+        }
+    }
+
+    return max_;
+}
+
+void LatencyHistogram::WriteTo(TextWriter & w, FormatOptions const &) const
+{
+    w.Write(
+        "count={0} mean={1} p50={2} p90={3} p99={4} max={5}",
+        count_,
+        Mean(),
+        Percentile(50),
+        Percentile(90),
+        Percentile(99),
+        max_);
+}
+
+RingSimulator::ActionStatistics::ActionStatistics()
+    : Count(0)
+    , Bytes(0)
+{
+}
+
+RingSimulator::RingSimulator(size_t nodeCount, size_t seedNodeCount, TimeSpan linkLatency)
+    : seedNodeCount_(min(seedNodeCount, nodeCount))
+    , random_(static_cast<int>(nodeCount))
+    , broadcastDeliveries_(0)
+    , broadcastCount_(0)
+{
+    auto & transportConfig = TransportConfig::GetConfig();
+    savedInMemoryTransportEnabled_ = transportConfig.InMemoryTransportEnabled;
+    savedInMemoryTransportLatency_ = transportConfig.InMemoryTransportLatency;
+    transportConfig.InMemoryTransportEnabled = true;
+    transportConfig.InMemoryTransportLatency = linkLatency;
+
+    auto & leaseConfig = LeaseWrapper::LeaseConfig::GetConfig();
+    savedDebugLeaseDriverEnabled_ = leaseConfig.DebugLeaseDriverEnabled;
+    leaseConfig.DebugLeaseDriverEnabled = true;
+
+    FederationConfig::Test_Reset();
+
+    // Node ids are evenly spaced on the ring and seed nodes are evenly spaced among them,
+    // so that a given node count always produces the same ring.
+    vector<NodeId> nodeIds;
+    uint64 spacing = numeric_limits<uint64>::max() / nodeCount;
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        nodeIds.push_back(NodeId(LargeInteger(spacing * i, 0)));
+    }
+
+    VoteConfig seedNodes;
+    vector<size_t> order;
+    for (size_t i = 0; i < seedNodeCount_; ++i)
+    {
+        order.push_back(i * nodeCount / seedNodeCount_);
+    }
+
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        if (find(order.begin(), order.end(), i) == order.end())
+        {
+            order.push_back(i);
+        }
+    }
+
+    vector<NodeConfig> configs;
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        NodeId nodeId = nodeIds[order[i]];
+        wstring address = SiteNodeHelper::BuildAddress(
+            SiteNodeHelper::GetLoopbackAddress(),
+            wformatString("{0}", FederationBasePort + order[i]));
+        wstring leaseAgentAddress = SiteNodeHelper::BuildAddress(
+            SiteNodeHelper::GetLoopbackAddress(),
+            wformatString("{0}", LeaseAgentBasePort + order[i]));
+
+        if (i < seedNodeCount_)
+        {
+            seedNodes.push_back(VoteEntryConfig(nodeId, Federation::Constants::SeedNodeVoteType, address));
+        }
+
+        configs.push_back(NodeConfig(nodeId, address, leaseAgentAddress, SiteNodeHelper::GetWorkingDir()));
+    }
+
+    FederationConfig::GetConfig().Votes = seedNodes;
+
+    for (auto const & config : configs)
+    {
+        SiteNodeHelper::DeleteTicketFile(config.Id);
+        nodes_.push_back(SiteNode::Create(config, FabricCodeVersion(), nullptr));
+    }
+
+    MemoryTransport::Test_SetDispatchObserver(
+        [this](Message & message, wstring const &, wstring const &, TimeSpan delay) { OnDispatch(message, delay); });
+}
+
+RingSimulator::~RingSimulator()
+{
+    Close();
+
+    MemoryTransport::Test_SetDispatchObserver(nullptr);
+
+    for (auto const & node : nodes_)
+    {
+        SiteNodeHelper::DeleteTicketFile(node->Id);
+    }
+
+    FederationConfig::Test_Reset();
+
+    TransportConfig::GetConfig().InMemoryTransportEnabled = savedInMemoryTransportEnabled_;
+    TransportConfig::GetConfig().InMemoryTransportLatency = savedInMemoryTransportLatency_;
+    LeaseWrapper::LeaseConfig::GetConfig().DebugLeaseDriverEnabled = savedDebugLeaseDriverEnabled_;
+}
+
+ErrorCode RingSimulator::Open(size_t joinConcurrency, TimeSpan timeout)
+{
+    for (auto const & node : nodes_)
+    {
+        RegisterHandlers(node);
+    }
+
+    // Seed nodes have to be opened together to form the initial ring
+    auto error = OpenNodes(0, seedNodeCount_, seedNodeCount_, timeout);
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    Trace.WriteInfo(TraceType, "{0} seed nodes opened, joining {1} nodes", seedNodeCount_, nodes_.size() - seedNodeCount_);
+
+    return OpenNodes(seedNodeCount_, nodes_.size(), joinConcurrency, timeout);
+}
+
+ErrorCode RingSimulator::OpenNodes(size_t begin, size_t end, size_t concurrency, TimeSpan timeout)
+{
+    OperationThrottle throttle(concurrency);
+
+    for (size_t i = begin; i < end && throttle.Acquire(); ++i)
+    {
+        auto node = nodes_[i];
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        node->BeginOpen(
+            timeout,
+            [this, &throttle, node, stopwatch](AsyncOperationSPtr const & operation) mutable
+            {
+                auto error = node->EndOpen(operation);
+                stopwatch.Stop();
+
+                if (error.IsSuccess())
+                {
+                    AcquireExclusiveLock grab(statisticsLock_);
+                    joinLatency_.Add(stopwatch.Elapsed);
+                }
+                else
+                {
+                    Trace.WriteWarning(TraceType, "open of {0} failed: {1}", node->Id, error);
+                }
+
+                throttle.Release(error);
+            });
+    }
+
+    return throttle.WaitForAll();
+}
+
+void RingSimulator::Close()
+{
+    for (auto const & node : nodes_)
+    {
+        node->UnRegisterMessageHandler(SimulatorActor);
+        node->Abort();
+    }
+}
+
+void RingSimulator::RegisterHandlers(SiteNodeSPtr const & node)
+{
+    node->RegisterMessageHandler(
+        SimulatorActor,
+        [this](MessageUPtr & message, OneWayReceiverContextUPtr & context)
+        {
+            if (message->Action == *BroadcastAction)
+            {
+                OnBroadcastDelivered();
+            }
+
+            context->Accept();
+        },
+        [](MessageUPtr &, RequestReceiverContextUPtr & context) { context->Reply(make_unique<Message>()); },
+        true /*dispatchOnTransportThread*/);
+}
+
+ErrorCode RingSimulator::RouteRequests(size_t requestCount, size_t concurrency, TimeSpan timeout)
+{
+    OperationThrottle throttle(concurrency);
+
+    for (size_t i = 0; i < requestCount && throttle.Acquire(); ++i)
+    {
+        SiteNodeSPtr from;
+        NodeId to;
+        {
+            AcquireExclusiveLock grab(statisticsLock_);
+            from = nodes_[random_.Next(static_cast<int>(nodes_.size()))];
+            to = RandomNodeId();
+        }
+
+        auto request = make_unique<Message>();
+        request->Headers.Add(ActorHeader(SimulatorActor));
+        request->Headers.Add(ActionHeader(*RoutedAction));
+        request->Headers.Add(MessageIdHeader());
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        from->BeginRouteRequest(
+            move(request),
+            to,
+            0,
+            false,
+            timeout,
+            [this, &throttle, from, stopwatch](AsyncOperationSPtr const & operation) mutable
+            {
+                MessageUPtr reply;
+                auto error = from->EndRouteRequest(operation, reply);
+                stopwatch.Stop();
+
+                if (error.IsSuccess())
+                {
+                    AcquireExclusiveLock grab(statisticsLock_);
+                    routeLatency_.Add(stopwatch.Elapsed);
+                }
+
+                throttle.Release(error);
+            },
+            from->CreateAsyncOperationRoot());
+    }
+
+    return throttle.WaitForAll();
+}
+
+ErrorCode RingSimulator::Broadcast(size_t broadcastCount, TimeSpan timeout)
+{
+    for (size_t i = 0; i < broadcastCount; ++i)
+    {
+        SiteNodeSPtr from;
+        {
+            AcquireExclusiveLock grab(statisticsLock_);
+            from = nodes_[random_.Next(static_cast<int>(nodes_.size()))];
+            ++broadcastCount_;
+        }
+
+        auto message = make_unique<Message>();
+        message->Headers.Add(ActorHeader(SimulatorActor));
+        message->Headers.Add(ActionHeader(*BroadcastAction));
+        message->Headers.Add(MessageIdHeader());
+
+        ManualResetEvent completed(false);
+        ErrorCode error;
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        from->BeginBroadcast(
+            move(message),
+            false,
+            [&, from](AsyncOperationSPtr const & operation)
+            {
+                error = from->EndBroadcast(operation);
+                completed.Set();
+            },
+            from->CreateAsyncOperationRoot());
+
+        if (!completed.WaitOne(timeout))
+        {
+            return ErrorCodeValue::Timeout;
+        }
+
+        stopwatch.Stop();
+
+        if (!error.IsSuccess())
+        {
+            return error;
+        }
+
+        AcquireExclusiveLock grab(statisticsLock_);
+        broadcastLatency_.Add(stopwatch.Elapsed);
+    }
+
+    return ErrorCode::Success();
+}
+
+ErrorCode RingSimulator::BroadcastBatch(size_t broadcastCount, TimeSpan timeout)
+{
+    SiteNodeSPtr from;
+    {
+        AcquireExclusiveLock grab(statisticsLock_);
+        from = nodes_[random_.Next(static_cast<int>(nodes_.size()))];
+        broadcastCount_ += broadcastCount;
+    }
+
+    ExclusiveLock lock;
+    size_t pendingCount = broadcastCount;
+    ErrorCode error;
+    ManualResetEvent completed(false);
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    for (size_t i = 0; i < broadcastCount; ++i)
+    {
+        auto message = make_unique<Message>();
+        message->Headers.Add(ActorHeader(SimulatorActor));
+        message->Headers.Add(ActionHeader(*BroadcastAction));
+        message->Headers.Add(MessageIdHeader());
+
+        from->BeginBroadcast(
+            move(message),
+            false,
+            [&, from](AsyncOperationSPtr const & operation)
+            {
+                auto broadcastError = from->EndBroadcast(operation);
+
+                AcquireExclusiveLock grab(lock);
+                if (!broadcastError.IsSuccess() && error.IsSuccess())
+                {
+                    error = broadcastError;
+                }
+
+                if (--pendingCount == 0)
+                {
+                    completed.Set();
+                }
+            },
+            from->CreateAsyncOperationRoot());
+    }
+
+    if (!completed.WaitOne(timeout))
+    {
+        return ErrorCodeValue::Timeout;
+    }
+
+    stopwatch.Stop();
+
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    AcquireExclusiveLock grab(statisticsLock_);
+    broadcastLatency_.Add(stopwatch.Elapsed);
+
+    return ErrorCode::Success();
+}
+
+ErrorCode RingSimulator::BroadcastOneWay(size_t broadcastCount, TimeSpan timeout)
+{
+    SiteNodeSPtr from;
+    uint64 expectedDeliveries;
+    {
+        AcquireExclusiveLock grab(statisticsLock_);
+        from = nodes_[random_.Next(static_cast<int>(nodes_.size()))];
+        broadcastCount_ += broadcastCount;
+        expectedDeliveries = broadcastDeliveries_ + broadcastCount * nodes_.size();
+    }
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    for (size_t i = 0; i < broadcastCount; ++i)
+    {
+        auto message = make_unique<Message>();
+        message->Headers.Add(ActorHeader(SimulatorActor));
+        message->Headers.Add(ActionHeader(*BroadcastAction));
+        message->Headers.Add(MessageIdHeader());
+
+        from->Broadcast(move(message));
+    }
+
+    // one way broadcasts have no completion, wait until every node has received every broadcast
+    for (;;)
+    {
+        {
+            AcquireExclusiveLock grab(statisticsLock_);
+            if (broadcastDeliveries_ >= expectedDeliveries)
+            {
+                broadcastLatency_.Add(stopwatch.Elapsed);
+                return ErrorCode::Success();
+            }
+        }
+
+        if (stopwatch.Elapsed > timeout)
+        {
+            return ErrorCodeValue::Timeout;
+        }
+
+        Sleep(10);
+    }
+}
+
+void RingSimulator::OnDispatch(Message & message, TimeSpan delay)
+{
+    wstring key = wformatString("{0}.{1}", message.Actor, message.Action);
+    uint size = message.SerializedSize();
+
+    RoutingHeader routingHeader;
+    bool isRoutedRequest = (message.Actor == SimulatorActor) && (message.Action == *RoutedAction) && message.Headers.TryReadFirst(routingHeader);
+
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    auto & statistics = actionStatistics_[key];
+    ++statistics.Count;
+    statistics.Bytes += size;
+    statistics.Delay.Add(delay);
+
+    if (isRoutedRequest)
+    {
+        ++routeHops_[routingHeader.MessageId];
+    }
+}
+
+void RingSimulator::OnBroadcastDelivered()
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+    ++broadcastDeliveries_;
+}
+
+NodeId RingSimulator::RandomNodeId()
+{
+    uint64 high = (static_cast<uint64>(random_.Next()) << 33) ^ (static_cast<uint64>(random_.Next()) << 2) ^ random_.Next(4);
+    uint64 low = (static_cast<uint64>(random_.Next()) << 33) ^ static_cast<uint64>(random_.Next());
+    return NodeId(LargeInteger(high, low));
+}
+
+void RingSimulator::ResetStatistics()
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    actionStatistics_.clear();
+    routeHops_.clear();
+    broadcastDeliveries_ = 0;
+    broadcastCount_ = 0;
+    joinLatency_ = LatencyHistogram();
+    routeLatency_ = LatencyHistogram();
+    broadcastLatency_ = LatencyHistogram();
+}
+
+uint64 RingSimulator::GetMessageCount(wstring const & action) const
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    uint64 count = 0;
+    for (auto const & entry : actionStatistics_)
+    {
+        if (StringUtility::EndsWith<wstring>(entry.first, L"." + action))
+        {
+            count += entry.second.Count;
+        }
+    }
+
+    return count;
+}
+
+uint64 RingSimulator::GetTotalMessageCount() const
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    uint64 count = 0;
+    for (auto const & entry : actionStatistics_)
+    {
+        count += entry.second.Count;
+    }
+
+    return count;
+}
+
+vector<uint64> RingSimulator::GetRouteHopDistribution() const
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    vector<uint64> distribution;
+    for (auto const & entry : routeHops_)
+    {
+        if (distribution.size() <= entry.second)
+        {
+            distribution.resize(entry.second + 1);
+        }
+
+        ++distribution[entry.second];
+    }
+
+    return distribution;
+}
+
+double RingSimulator::GetBroadcastFanout() const
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+    return (broadcastCount_ == 0) ? 0 : static_cast<double>(broadcastDeliveries_) / broadcastCount_;
+}
+
+void RingSimulator::TraceStatistics() const
+{
+    AcquireExclusiveLock grab(statisticsLock_);
+
+    Trace.WriteInfo(TraceType, "nodes={0} seeds={1}", nodes_.size(), seedNodeCount_);
+    Trace.WriteInfo(TraceType, "join latency: {0}", joinLatency_);
+    Trace.WriteInfo(TraceType, "route latency: {0}", routeLatency_);
+    Trace.WriteInfo(TraceType, "broadcast latency: {0}", broadcastLatency_);
+
+    for (auto const & entry : actionStatistics_)
+    {
+        Trace.WriteInfo(
+            TraceType,
+            "{0}: messages={1} bytes={2} delay: {3}",
+            entry.first,
+            entry.second.Count,
+            entry.second.Bytes,
+            entry.second.Delay);
+    }
+
+    wstring hops;
+    StringWriter writer(hops);
+    map<uint, uint64> distribution;
+    for (auto const & entry : routeHops_)
+    {
+        ++distribution[entry.second];
+    }
+
+    for (auto const & entry : distribution)
+    {
+        writer.Write(" {0}:{1}", entry.first, entry.second);
+    }
+
+    Trace.WriteInfo(TraceType, "route hops (hops:requests):{0}", hops);
+    Trace.WriteInfo(
+        TraceType,
+        "broadcast deliveries per broadcast: {0}",
+        (broadcastCount_ == 0) ? 0 : static_cast<double>(broadcastDeliveries_) / broadcastCount_);
+}
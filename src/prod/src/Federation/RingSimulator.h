@@ -0,0 +1,118 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace FederationUnitTests
+{
+    // Latency distribution with power of two microsecond buckets
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram();
+
+        void Add(Common::TimeSpan value);
+
+        uint64 Count() const { return count_; }
+        Common::TimeSpan Mean() const;
+        Common::TimeSpan Max() const { return max_; }
+
+        // Upper bound of the bucket containing the given percentile
+        Common::TimeSpan Percentile(double percentile) const;
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
+
+    private:
+        static const size_t BucketCount = 40;
+
+        std::vector<uint64> buckets_;
+        uint64 count_;
+        Common::TimeSpan total_;
+        Common::TimeSpan max_;
+    };
+
+    // Hosts a ring of SiteNodes in this process over the in-memory transport with the debug lease driver,
+    // and collects per action message counts, delivery delays, join and route latencies and routing hop
+    // counts, so that ring scale behavior can be measured without a network.
+    class RingSimulator
+    {
+        DENY_COPY(RingSimulator);
+
+    public:
+        RingSimulator(size_t nodeCount, size_t seedNodeCount, Common::TimeSpan linkLatency = Common::TimeSpan::Zero);
+        ~RingSimulator();
+
+        // Opens seed nodes first, then joins the remaining nodes with at most joinConcurrency joins in flight
+        Common::ErrorCode Open(size_t joinConcurrency, Common::TimeSpan timeout);
+        void Close();
+
+        // Routes requests from random nodes to random node ids
+        Common::ErrorCode RouteRequests(size_t requestCount, size_t concurrency, Common::TimeSpan timeout);
+
+        // Issues reliable broadcasts from random nodes one at a time
+        Common::ErrorCode Broadcast(size_t broadcastCount, Common::TimeSpan timeout);
+
+        // Issues one way broadcasts back to back from one random node and waits until all nodes have received them
+        Common::ErrorCode BroadcastOneWay(size_t broadcastCount, Common::TimeSpan timeout);
+
+        // Issues reliable broadcasts back to back from one random node and waits until all of them are acked
+        Common::ErrorCode BroadcastBatch(size_t broadcastCount, Common::TimeSpan timeout);
+
+        void ResetStatistics();
+        void TraceStatistics() const;
+
+        size_t NodeCount() const { return nodes_.size(); }
+        Federation::SiteNodeSPtr const & GetNode(size_t index) const { return nodes_[index]; }
+
+        LatencyHistogram const & JoinLatency() const { return joinLatency_; }
+        LatencyHistogram const & RouteLatency() const { return routeLatency_; }
+        LatencyHistogram const & BroadcastLatency() const { return broadcastLatency_; }
+
+        uint64 GetMessageCount(std::wstring const & action) const;
+        uint64 GetTotalMessageCount() const;
+
+        // Number of transport hops taken by each routed request, indexed by hop count
+        std::vector<uint64> GetRouteHopDistribution() const;
+
+        // Average number of nodes a broadcast message was delivered to, including the sender
+        double GetBroadcastFanout() const;
+
+    private:
+        struct ActionStatistics
+        {
+            ActionStatistics();
+
+            uint64 Count;
+            uint64 Bytes;
+            LatencyHistogram Delay;
+        };
+
+        void OnDispatch(Transport::Message & message, Common::TimeSpan delay);
+        void OnBroadcastDelivered();
+
+        Common::ErrorCode OpenNodes(size_t begin, size_t end, size_t concurrency, Common::TimeSpan timeout);
+
+        void RegisterHandlers(Federation::SiteNodeSPtr const & node);
+
+        Federation::NodeId RandomNodeId();
+
+        std::vector<Federation::SiteNodeSPtr> nodes_;
+        size_t seedNodeCount_;
+        Common::Random random_;
+
+        mutable Common::ExclusiveLock statisticsLock_;
+        std::map<std::wstring, ActionStatistics> actionStatistics_;
+        std::map<Transport::MessageId, uint> routeHops_;
+        uint64 broadcastDeliveries_;
+        uint64 broadcastCount_;
+        LatencyHistogram joinLatency_;
+        LatencyHistogram routeLatency_;
+        LatencyHistogram broadcastLatency_;
+
+        bool savedInMemoryTransportEnabled_;
+        Common::TimeSpan savedInMemoryTransportLatency_;
+        bool savedDebugLeaseDriverEnabled_;
+    };
+}
@@ -30,6 +30,7 @@
 #include "Federation/NeighborhoodQueryRequestBody.h"
 #include "Federation/LivenessQueryBody.h"
 #include "Federation/BroadcastHeader.h"
+#include "Federation/BroadcastEnvelopeBody.h"
 #include "Federation/PToPActor.h"
 #include "Federation/PToPHeader.h"
 #include "Federation/ArbitrationType.h"
@@ -83,6 +84,7 @@
 #include "Federation/BroadcastManager.h"
 #include "Federation/RouteAsyncOperation.h"
 #include "Federation/BroadcastAckReceiverContext.h"
+#include "Federation/BroadcastEnvelopeAckReceiverContext.h"
 #include "Federation/BroadcastRequestReceiverContext.h"
 
 #include "Federation/VoterStoreHeader.h"
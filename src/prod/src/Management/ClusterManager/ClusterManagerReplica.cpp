@@ -6415,9 +6415,13 @@ AsyncOperationSPtr ClusterManagerReplica::BeginProcessRequest(
     ErrorCode error(ErrorCodeValue::Success);
 
     // rolloutManagerUPtr_ is set once during the first ChangeRole() to primary and not
-    // reset until destruction of this class
+    // reset until destruction of this class.
     //
-    if (!rolloutManagerUPtr_ || !rolloutManagerUPtr_->IsActive)
+    // Queries are read-only, so they can be accepted as soon as recovery has loaded
+    // the pending contexts.
+    //
+    bool isQuery = (request->Action == QueryTcpMessage::QueryAction);
+    if (!rolloutManagerUPtr_ || !(isQuery ? rolloutManagerUPtr_->IsQueryable : rolloutManagerUPtr_->IsActive))
     {
         error = ErrorCodeValue::NotPrimary;
 
@@ -798,6 +798,8 @@ public:
         , registryUserName_(registryUserName)
         , registryPassword_(registryPassword)
         , isPasswordEncrypted_(isPasswordEncrypted)
+        , isCacheable_(false)
+        , cacheKey_()
     {
     }
 
@@ -838,6 +840,11 @@ protected:
 
         auto error = this->Owner.EndRunImageBuilderExe(operation);
 
+        if (isCacheable_ && error.IsError(ErrorCodeValue::ImageBuilderValidationError))
+        {
+            this->Owner.resultCache_.Put(cacheKey_, error);
+        }
+
         if (error.IsSuccess())
         {
             BuildLayoutSpecification layout(outputDirectory_);
@@ -873,6 +880,9 @@ protected:
 
     wstring GetOutputDirectory() { return outputDirectory_; }
 
+    // Whether the result is fully determined by the compose content and the Image Builder arguments
+    virtual bool IsResultCacheable() const { return true; }
+
 private:
 
     void DoBuildApplicationType(AsyncOperationSPtr const & thisSPtr)
@@ -885,6 +895,44 @@ private:
             typeName_,
             typeVersion_);
 
+        // Provisioning uploads the generated application type to the image store, so
+        // only validation errors are cached and a successful build always runs Image Builder.
+        // The key covers every argument passed to Image Builder below.
+        //
+        if (this->IsResultCacheable())
+        {
+            isCacheable_ = this->Owner.TryCreateResultCacheKey(
+                OperationBuildComposeDeploymentType,
+                { composeFile_.get(), overridesFile_.get() },
+                {
+                    appName_.ToString(),
+                    typeName_.Value,
+                    typeVersion_.Value,
+                    registryUserName_,
+                    registryPassword_,
+                    isPasswordEncrypted_ ? L"true" : L"false",
+                    ClusterManagerReplica::IsDnsServiceEnabled() ? L"true" : L"false",
+                    ManagementConfig::GetConfig().DisableChecksumValidation ? L"true" : L"false"
+                },
+                cacheKey_);
+        }
+
+        ErrorCode cachedResult;
+        if (isCacheable_ && this->Owner.resultCache_.TryGet(cacheKey_, cachedResult))
+        {
+            this->Owner.WriteInfo(
+                TraceComponent,
+                "{0}+{1}: using cached build compose application type result {2} for {3} ({4})",
+                ImageBuilderAsyncOperationBase::TraceId,
+                this->ActivityId,
+                cachedResult,
+                typeName_,
+                typeVersion_);
+
+            TryComplete(thisSPtr, cachedResult);
+            return;
+        }
+
         wstring cmdLineArgs;
         this->Owner.InitializeCommandLineArguments(cmdLineArgs);
 
@@ -988,6 +1036,8 @@ private:
     ApplicationHealthPolicy healthPolicy_;
     map<wstring, wstring> defaultParamList_;
 
+    bool isCacheable_;
+    string cacheKey_;
 };
 
 class ImageBuilderProxy::BuildComposeApplicationTypeForUpgradeAsyncOperation : public BuildComposeDeploymentAppTypeAsyncOperation
@@ -1027,6 +1077,11 @@ public:
     {
     }
 
+protected:
+
+    // Upgrades also validate the current and target versions
+    bool IsResultCacheable() const override { return false; }
+
 private:
 
     virtual void RunImageBuilderExe(AsyncOperationSPtr const &thisSPtr, wstring &cmdLineArgs)
@@ -1821,6 +1876,8 @@ ImageBuilderProxy::ImageBuilderProxy(
     , securitySettingsLock_()
     , applicationJobQueue_()
     , upgradeJobQueue_()
+    , imageBuilderVersion_()
+    , resultCache_(static_cast<size_t>(ManagementConfig::GetConfig().ImageBuilderResultCacheSize))
 {
     WriteInfo(
         TraceComponent, 
@@ -1859,6 +1916,18 @@ void ImageBuilderProxy::Initialize()
     // Delete any leaked directories and files inside appTypeOutputBaseDirectory_.
     // This prevents directory for application packages downloaded from external store to be leaked.
     this->DeleteDirectory(appTypeOutputBaseDirectory_);
+
+    auto error = FabricEnvironment::GetFabricVersion(imageBuilderVersion_);
+    if (!error.IsSuccess())
+    {
+        WriteWarning(
+            TraceComponent,
+            "{0} failed to get Image Builder version, result cache disabled: error={1}",
+            NodeTraceComponent::TraceId,
+            error);
+
+        imageBuilderVersion_.clear();
+    }
 }
 
 ImageBuilderProxy::~ImageBuilderProxy()
@@ -1982,6 +2051,33 @@ bool ImageBuilderProxy::TryRemoveProcessHandle(HANDLE hProcess)
     }
 }
 
+bool ImageBuilderProxy::TryCreateResultCacheKey(
+    wstring const & operation,
+    vector<ByteBuffer const *> const & contents,
+    vector<wstring> const & arguments,
+    __out string & key)
+{
+    if (imageBuilderVersion_.empty())
+    {
+        return false;
+    }
+
+    auto error = ImageBuilderResultCache::CreateKey(operation, imageBuilderVersion_, contents, arguments, key);
+    if (!error.IsSuccess())
+    {
+        WriteWarning(
+            TraceComponent,
+            "{0} failed to create Image Builder result cache key for {1}: error={2}",
+            NodeTraceComponent::TraceId,
+            operation,
+            error);
+
+        return false;
+    }
+
+    return true;
+}
+
 ErrorCode ImageBuilderProxy::GetApplicationTypeInfo(
     wstring const & buildPath, 
     TimeSpan const timeout,
@@ -2339,6 +2435,30 @@ ErrorCode ImageBuilderProxy::ValidateComposeFile(
     ServiceModelVersion const &applicationTypeVersion,
     TimeSpan const &timeout)
 {
+    // The key covers the compose file and every argument passed to Image Builder below
+    //
+    string cacheKey;
+    bool isCacheable = TryCreateResultCacheKey(
+        OperationValidateComposeFile,
+        { &composeFile },
+        { appName.ToString(), applicationTypeName.Value, applicationTypeVersion.Value },
+        cacheKey);
+
+    ErrorCode cachedResult;
+    if (isCacheable && resultCache_.TryGet(cacheKey, cachedResult))
+    {
+        WriteInfo(
+            TraceComponent,
+            "{0} using cached docker compose validation result {1}: app={2} type={3} version={4}",
+            NodeTraceComponent::TraceId,
+            cachedResult,
+            appName,
+            applicationTypeName,
+            applicationTypeVersion);
+
+        return cachedResult;
+    }
+
     wstring cmdLineArgs;
     InitializeCommandLineArguments(cmdLineArgs);
     
@@ -2377,6 +2497,11 @@ ErrorCode ImageBuilderProxy::ValidateComposeFile(
         cmdLineArgs,
         timeout);
 
+    if (isCacheable && (error.IsSuccess() || error.IsError(ErrorCodeValue::ImageBuilderValidationError)))
+    {
+        resultCache_.Put(cacheKey, error);
+    }
+
     // The temp files are deleted by Image Builder
     return error;
 }
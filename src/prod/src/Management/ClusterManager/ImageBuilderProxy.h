@@ -560,6 +560,12 @@ namespace Management
 
             bool TryRemoveProcessHandle(HANDLE);
 
+            bool TryCreateResultCacheKey(
+                std::wstring const & operation,
+                std::vector<Common::ByteBuffer const *> const & contents,
+                std::vector<std::wstring> const & arguments,
+                __out std::string & key);
+
             std::wstring GetServiceManifestFileName(
                 Management::ImageModel::BuildLayoutSpecification const&,
                 std::wstring const &appTypeName,
@@ -594,6 +600,11 @@ namespace Management
             std::unique_ptr<ApplicationJobQueue> applicationJobQueue_;
             std::unique_ptr<UpgradeJobQueue> upgradeJobQueue_;
             ImageBuilderPerformanceCountersSPtr perfCounters_;
+
+            // Image Builder is deployed with the Fabric code package, so the Fabric version
+            // identifies the Image Builder version for cached results
+            std::wstring imageBuilderVersion_;
+            ImageBuilderResultCache resultCache_;
         };
     }
 }
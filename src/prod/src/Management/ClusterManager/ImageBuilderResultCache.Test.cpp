@@ -0,0 +1,191 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Management
+{
+    namespace ClusterManager
+    {
+        class ImageBuilderResultCacheTest
+        {
+        protected:
+            static ByteBuffer CreateContent(string const & text)
+            {
+                return ByteBuffer(text.begin(), text.end());
+            }
+
+            static string CreateKey(
+                wstring const & operation,
+                wstring const & version,
+                vector<ByteBuffer const *> const & contents,
+                vector<wstring> const & arguments = vector<wstring>())
+            {
+                string key;
+                auto error = ImageBuilderResultCache::CreateKey(operation, version, contents, arguments, key);
+                VERIFY_IS_TRUE(error.IsSuccess());
+
+                return key;
+            }
+        };
+
+        BOOST_FIXTURE_TEST_SUITE2(ImageBuilderResultCacheTestSuite, ImageBuilderResultCacheTest)
+
+        BOOST_AUTO_TEST_CASE(CreateKeyTest)
+        {
+            auto compose = CreateContent("version: '3'");
+            auto otherCompose = CreateContent("version: '3.1'");
+            auto overrides = CreateContent("services: {}");
+
+            auto key = CreateKey(L"Validate", L"6.0.0.0", { &compose });
+
+            VERIFY_IS_TRUE(key == CreateKey(L"Validate", L"6.0.0.0", { &compose }));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Validate", L"6.0.0.0", { &otherCompose }));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Validate", L"6.1.0.0", { &compose }));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Build", L"6.0.0.0", { &compose }));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Validate", L"6.0.0.0", { &compose, &overrides }));
+
+            // Null content is treated as empty, but the number of buffers is still part of the key
+            //
+            auto empty = CreateContent("");
+            VERIFY_IS_TRUE(
+                CreateKey(L"Validate", L"6.0.0.0", { &compose, nullptr }) ==
+                CreateKey(L"Validate", L"6.0.0.0", { &compose, &empty }));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Validate", L"6.0.0.0", { &compose, nullptr }));
+
+            // Moving bytes between buffers changes the key
+            //
+            auto first = CreateContent("ab");
+            auto second = CreateContent("c");
+            auto firstShifted = CreateContent("a");
+            auto secondShifted = CreateContent("bc");
+            VERIFY_ARE_NOT_EQUAL(
+                CreateKey(L"Validate", L"6.0.0.0", { &first, &second }),
+                CreateKey(L"Validate", L"6.0.0.0", { &firstShifted, &secondShifted }));
+        }
+
+        BOOST_AUTO_TEST_CASE(CreateKeyArgumentsTest)
+        {
+            auto compose = CreateContent("version: '3'");
+            vector<wstring> arguments = { L"fabric:/app", L"AppType", L"1.0", L"user", L"password", L"false", L"true", L"false" };
+
+            auto key = CreateKey(L"Build", L"6.0.0.0", { &compose }, arguments);
+            VERIFY_IS_TRUE(key == CreateKey(L"Build", L"6.0.0.0", { &compose }, arguments));
+            VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Build", L"6.0.0.0", { &compose }));
+
+            // Every argument is part of the key
+            //
+            for (size_t i = 0; i < arguments.size(); ++i)
+            {
+                auto changed = arguments;
+                changed[i] += L"x";
+                VERIFY_ARE_NOT_EQUAL(key, CreateKey(L"Build", L"6.0.0.0", { &compose }, changed));
+            }
+
+            // Moving characters between arguments changes the key
+            //
+            VERIFY_ARE_NOT_EQUAL(
+                CreateKey(L"Validate", L"6.0.0.0", { &compose }, { L"fabric:/app", L"Type" }),
+                CreateKey(L"Validate", L"6.0.0.0", { &compose }, { L"fabric:/appT", L"ype" }));
+
+            // Credentials are only part of the digest
+            //
+            VERIFY_IS_TRUE(key.find("password") == string::npos);
+        }
+
+        BOOST_AUTO_TEST_CASE(HitAndMissTest)
+        {
+            ImageBuilderResultCache cache(4);
+
+            auto compose = CreateContent("version: '3'");
+            auto otherCompose = CreateContent("version: '3.1'");
+            auto key = CreateKey(L"Validate", L"6.0.0.0", { &compose });
+
+            ErrorCode result;
+            VERIFY_IS_FALSE(cache.TryGet(key, result));
+
+            cache.Put(key, ErrorCode::Success());
+            VERIFY_ARE_EQUAL2(cache.Size(), 1u);
+
+            result = ErrorCodeValue::OperationFailed;
+            VERIFY_IS_TRUE(cache.TryGet(key, result));
+            VERIFY_IS_TRUE(result.IsSuccess());
+
+            VERIFY_IS_FALSE(cache.TryGet(CreateKey(L"Validate", L"6.0.0.0", { &otherCompose }), result));
+            VERIFY_IS_FALSE(cache.TryGet(CreateKey(L"Validate", L"6.1.0.0", { &compose }), result));
+        }
+
+        BOOST_AUTO_TEST_CASE(ErrorResultTest)
+        {
+            ImageBuilderResultCache cache(4);
+
+            auto compose = CreateContent("services: [");
+            auto key = CreateKey(L"Validate", L"6.0.0.0", { &compose });
+
+            cache.Put(key, ErrorCode(ErrorCodeValue::ImageBuilderValidationError, L"invalid compose file"));
+
+            ErrorCode result;
+            VERIFY_IS_TRUE(cache.TryGet(key, result));
+            VERIFY_IS_TRUE(result.IsError(ErrorCodeValue::ImageBuilderValidationError));
+            VERIFY_ARE_EQUAL2(result.Message, wstring(L"invalid compose file"));
+
+            // A later result for the same key replaces the earlier one
+            //
+            cache.Put(key, ErrorCode::Success());
+            VERIFY_ARE_EQUAL2(cache.Size(), 1u);
+
+            VERIFY_IS_TRUE(cache.TryGet(key, result));
+            VERIFY_IS_TRUE(result.IsSuccess());
+        }
+
+        BOOST_AUTO_TEST_CASE(EvictionTest)
+        {
+            ImageBuilderResultCache cache(2);
+
+            auto content1 = CreateContent("1");
+            auto content2 = CreateContent("2");
+            auto content3 = CreateContent("3");
+            auto key1 = CreateKey(L"Validate", L"6.0.0.0", { &content1 });
+            auto key2 = CreateKey(L"Validate", L"6.0.0.0", { &content2 });
+            auto key3 = CreateKey(L"Validate", L"6.0.0.0", { &content3 });
+
+            cache.Put(key1, ErrorCode::Success());
+            cache.Put(key2, ErrorCode::Success());
+
+            // Reading key1 makes key2 the least recently used entry
+            //
+            ErrorCode result;
+            VERIFY_IS_TRUE(cache.TryGet(key1, result));
+
+            cache.Put(key3, ErrorCode::Success());
+            VERIFY_ARE_EQUAL2(cache.Size(), 2u);
+
+            VERIFY_IS_TRUE(cache.TryGet(key1, result));
+            VERIFY_IS_FALSE(cache.TryGet(key2, result));
+            VERIFY_IS_TRUE(cache.TryGet(key3, result));
+        }
+
+        BOOST_AUTO_TEST_CASE(DisabledTest)
+        {
+            ImageBuilderResultCache cache(0);
+
+            auto compose = CreateContent("version: '3'");
+            auto key = CreateKey(L"Validate", L"6.0.0.0", { &compose });
+
+            cache.Put(key, ErrorCode::Success());
+            VERIFY_ARE_EQUAL2(cache.Size(), 0u);
+
+            ErrorCode result;
+            VERIFY_IS_FALSE(cache.TryGet(key, result));
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -0,0 +1,175 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Common;
+using namespace std;
+using namespace Management::ClusterManager;
+
+ImageBuilderResultCache::ImageBuilderResultCache(size_t sizeLimit)
+    : sizeLimit_(sizeLimit)
+    , entries_()
+    , lru_()
+    , lock_()
+{
+}
+
+ErrorCode ImageBuilderResultCache::CreateKey(
+    wstring const & operation,
+    wstring const & imageBuilderVersion,
+    vector<ByteBuffer const *> const & contents,
+    vector<wstring> const & arguments,
+    __out string & key)
+{
+    // Prefix each content buffer and argument with its length so that splitting
+    // the same bytes differently across them cannot produce the same digest.
+    // Arguments are part of the digest rather than the key, since they can
+    // include credentials.
+    //
+    ByteBuffer input;
+    auto appendField = [&input](BYTE const * data, uint64 size)
+    {
+        auto sizeBytes = reinterpret_cast<BYTE const *>(&size);
+        input.insert(input.end(), sizeBytes, sizeBytes + sizeof(size));
+        input.insert(input.end(), data, data + size);
+    };
+
+    for (auto const content : contents)
+    {
+        if (content == nullptr)
+        {
+            appendField(nullptr, 0);
+        }
+        else
+        {
+            appendField(content->data(), content->size());
+        }
+    }
+
+    for (auto const & argument : arguments)
+    {
+        auto utf8 = StringUtility::Utf16ToUtf8(argument);
+        appendField(reinterpret_cast<BYTE const *>(utf8.data()), utf8.size());
+    }
+
+    ByteBuffer hash;
+    auto error = ComputeHash(input, hash);
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    key.clear();
+    auto append = [&key](string const & field)
+    {
+        key.append(to_string(field.size()));
+        key.push_back(':');
+        key.append(field);
+    };
+
+    append(StringUtility::Utf16ToUtf8(operation));
+    append(StringUtility::Utf16ToUtf8(imageBuilderVersion));
+    append(string(hash.begin(), hash.end()));
+
+    return error;
+}
+
+ErrorCode ImageBuilderResultCache::ComputeHash(ByteBuffer const & input, __out ByteBuffer & hash)
+{
+#if defined(PLATFORM_UNIX)
+
+    return LinuxCryptUtil().ComputeHash(input, hash);
+
+#else
+
+    HCRYPTPROV hCryptProv = NULL;
+    HCRYPTHASH hHash = NULL;
+
+    BOOL result = CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_AES, CRYPT_VERIFYCONTEXT);
+    KFinally([=] { if (hCryptProv) CryptReleaseContext(hCryptProv, 0); });
+    if (result)
+    {
+        result = CryptCreateHash(hCryptProv, CALG_SHA_256, 0, 0, &hHash);
+    }
+
+    KFinally([=] { if (hHash) CryptDestroyHash(hHash); });
+
+    if (result)
+    {
+        result = CryptHashData(hHash, input.data(), static_cast<DWORD>(input.size()), 0);
+    }
+
+    DWORD hashSize = 0;
+    DWORD hashSizeLength = sizeof(hashSize);
+    if (result)
+    {
+        result = CryptGetHashParam(hHash, HP_HASHSIZE, (BYTE *)&hashSize, &hashSizeLength, 0);
+    }
+
+    if (result)
+    {
+        hash.resize(hashSize);
+        result = CryptGetHashParam(hHash, HP_HASHVAL, hash.data(), &hashSize, 0);
+    }
+
+    return result ? ErrorCode::Success() : ErrorCode::FromWin32Error();
+
+#endif
+}
+
+bool ImageBuilderResultCache::TryGet(string const & key, __out ErrorCode & result)
+{
+    if (sizeLimit_ == 0) { return false; }
+
+    AcquireWriteLock lock(lock_);
+
+    auto entry = entries_.find(key);
+    if (entry == entries_.end())
+    {
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, entry->second.LruPosition);
+
+    result = ErrorCode(entry->second.Value, wstring(entry->second.Message));
+
+    return true;
+}
+
+void ImageBuilderResultCache::Put(string const & key, ErrorCode const & result)
+{
+    if (sizeLimit_ == 0) { return; }
+
+    AcquireWriteLock lock(lock_);
+
+    auto entry = entries_.find(key);
+    if (entry != entries_.end())
+    {
+        entry->second.Value = result.ReadValue();
+        entry->second.Message = result.Message;
+        lru_.splice(lru_.begin(), lru_, entry->second.LruPosition);
+        return;
+    }
+
+    if (entries_.size() >= sizeLimit_)
+    {
+        auto oldest = entries_.find(lru_.back());
+        ASSERT_IF(oldest == entries_.end(), "ImageBuilderResultCache: LRU entry not found");
+
+        lru_.pop_back();
+        entries_.erase(oldest);
+    }
+
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{ result.ReadValue(), result.Message, lru_.begin() });
+}
+
+size_t ImageBuilderResultCache::Size() const
+{
+    AcquireReadLock lock(lock_);
+
+    return entries_.size();
+}
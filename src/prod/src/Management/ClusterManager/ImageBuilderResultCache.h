@@ -0,0 +1,60 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Management
+{
+    namespace ClusterManager
+    {
+        // Caches the results of Image Builder operations that are fully determined by their inputs.
+        // Entries are keyed by a SHA-256 digest of the input content and of every argument passed to
+        // Image Builder, and by the Image Builder version, so an upgraded Image Builder never returns
+        // results computed by the previous version. The least recently used entry is evicted once the
+        // size limit is reached.
+        //
+        class ImageBuilderResultCache
+        {
+            DENY_COPY(ImageBuilderResultCache);
+
+        public:
+            explicit ImageBuilderResultCache(size_t sizeLimit);
+
+            // Builds a cache key from the Image Builder operation, the Image Builder version and a digest
+            // of the input content and arguments. Every argument that can change the result (application
+            // name, type, version, credentials, flags) must be passed. Null content is treated as empty.
+            //
+            static Common::ErrorCode CreateKey(
+                std::wstring const & operation,
+                std::wstring const & imageBuilderVersion,
+                std::vector<Common::ByteBuffer const *> const & contents,
+                std::vector<std::wstring> const & arguments,
+                __out std::string & key);
+
+            // Only results that are fully determined by the inputs should be cached (i.e. success
+            // or validation errors, but not timeouts or other transient failures)
+            //
+            bool TryGet(std::string const & key, __out Common::ErrorCode & result);
+            void Put(std::string const & key, Common::ErrorCode const & result);
+
+            size_t Size() const;
+
+        private:
+            static Common::ErrorCode ComputeHash(Common::ByteBuffer const & input, __out Common::ByteBuffer & hash);
+
+            struct Entry
+            {
+                Common::ErrorCodeValue::Enum Value;
+                std::wstring Message;
+                std::list<std::string>::iterator LruPosition;
+            };
+
+            size_t sizeLimit_;
+            std::unordered_map<std::string, Entry> entries_;
+            std::list<std::string> lru_;
+            mutable Common::RwLock lock_;
+        };
+    }
+}
@@ -21,6 +21,7 @@ RolloutManager::RolloutManager(
     , replicaSPtr_(replica.CreateComponentRoot())
     , replica_(replica)
     , state_(RolloutManagerState::NotActive)
+    , contextsRecovered_(false)
     , stateLock_()
     , activeContexts_()
     , contextsLock_()
@@ -58,6 +59,7 @@ Common::ErrorCode RolloutManager::Start()
         case RolloutManagerState::Active:
 
             state_ = RolloutManagerState::Recovery;
+            contextsRecovered_ = false;
 
             this->SchedulePendingContextCheck(TimeSpan::Zero);
 
@@ -154,6 +156,52 @@ void RolloutManager::ScheduleRecovery(ErrorCode const & error)
     recoveryTimer_->Change(delay);
 }
 
+// Contexts loaded by the recovery jobs of one RecoveryCallback() and the progress of those jobs
+//
+struct RolloutManager::RecoveryState
+{
+    RecoveryState() 
+        : AppTypeCount(0)
+        , AppCount(0)
+        , ServiceCount(0)
+        , ApplicationUpgradeCount(0)
+        , FabricProvisionCount(0)
+        , FabricUpgradeCount(0)
+        , InfraTaskCount(0)
+        , ComposeDeploymentCount(0)
+        , ComposeUpgradeCount(0)
+        , AllAppTypeContexts()
+        , AllApplicationContexts()
+        , Jobs()
+        , NextJob(0)
+        , PendingWorkers(0)
+        , ErrorLock()
+        , Error(ErrorCodeValue::Success)
+        , RecoveryStopwatch()
+    {
+    }
+
+    size_t AppTypeCount;
+    size_t AppCount;
+    size_t ServiceCount;
+    size_t ApplicationUpgradeCount;
+    size_t FabricProvisionCount;
+    size_t FabricUpgradeCount;
+    size_t InfraTaskCount;
+    size_t ComposeDeploymentCount;
+    size_t ComposeUpgradeCount;
+
+    vector<ApplicationTypeContext> AllAppTypeContexts;
+    vector<ApplicationContext> AllApplicationContexts;
+
+    vector<function<ErrorCode(void)>> Jobs;
+    Common::atomic_long NextJob;
+    Common::atomic_long PendingWorkers;
+    ExclusiveLock ErrorLock;
+    ErrorCode Error;
+    Common::Stopwatch RecoveryStopwatch;
+};
+
 // This function will retry recovery of pending contexts indefinitely (or until stopped) on errors. 
 // Since the store layer will return reconfiguration-related errors until OnChangeRole()
 // completes, this function cannot be called on the OnChangeRole() thread or
@@ -190,130 +238,154 @@ void RolloutManager::RecoveryCallback()
         }   // end switch (state)
     }   // end state lock
 
-    size_t appTypeCount = 0; 
-    size_t appCount = 0; 
-    size_t serviceCount = 0;
-    size_t applicationUpgradeCount = 0;
-    size_t fabricProvisionCount = 0;
-    size_t fabricUpgradeCount = 0;
-    size_t infraTaskCount = 0;
-    size_t composeDeploymentCount = 0;
-    size_t composeUpgradeCount = 0;
+    auto recovery = make_shared<RecoveryState>();
+    auto & r = *recovery;
 
-    auto storeTx = StoreTransaction::Create(replica_.ReplicatedStore, replica_.PartitionedReplicaId);
+    // The context types are stored independently of each other, so each type is 
+    // recovered in its own read-only transaction and the scans can run in parallel.
+    // The jobs are owned by recovery and only reference it, so they capture it by reference.
+    //
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ApplicationTypeContext>(Constants::StoreType_ApplicationTypeContext, r.AppTypeCount, r.AllAppTypeContexts); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ApplicationContext>(Constants::StoreType_ApplicationContext, r.AppCount, r.AllApplicationContexts); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ServiceContext>(Constants::StoreType_ServiceContext, r.ServiceCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ApplicationUpgradeContext>(Constants::StoreType_ApplicationUpgradeContext, r.ApplicationUpgradeCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<FabricProvisionContext>(Constants::StoreType_FabricProvisionContext, r.FabricProvisionCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<FabricUpgradeContext>(Constants::StoreType_FabricUpgradeContext, r.FabricUpgradeCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<InfrastructureTaskContext>(Constants::StoreType_InfrastructureTaskContext, r.InfraTaskCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ComposeDeploymentContext>(Constants::StoreType_ComposeDeploymentContext, r.ComposeDeploymentCount); 
+    });
+    r.Jobs.push_back([this, &r]() 
+    { 
+        return this->RecoverRolloutContexts<ComposeDeploymentUpgradeContext>(Constants::StoreType_ComposeDeploymentUpgradeContext, r.ComposeUpgradeCount); 
+    });
+
+    r.RecoveryStopwatch.Start();
+
+    this->RunRecoveryJobs(recovery);
+}
 
-    auto activityId = storeTx.ActivityId.GetNestedActivity();
+// Runs the recovery jobs on at most RolloutContextRecoveryParallelism threads, including the 
+// calling thread. Remaining jobs are skipped on error. The last worker to finish calls 
+// OnRecoveryJobsComplete(), so no thread waits for the others: the workers run on the same 
+// threadpool, and blocking one of its threads on them could starve the pool.
+//
+void RolloutManager::RunRecoveryJobs(RecoveryStateSPtr const & recovery)
+{
+    auto parallelism = min(
+        static_cast<size_t>(ManagementConfig::GetConfig().RolloutContextRecoveryParallelism),
+        recovery->Jobs.size());
+    if (parallelism < 1) { parallelism = 1; }
 
-    vector<ApplicationTypeContext> allAppTypeContexts;
-    ErrorCode error = this->RecoverRolloutContexts<ApplicationTypeContext>(
-        storeTx,
-        Constants::StoreType_ApplicationTypeContext,
-        activityId,
-        appTypeCount,
-        allAppTypeContexts);
+    recovery->PendingWorkers.store(static_cast<LONG>(parallelism));
 
-    vector<ApplicationContext> allApplicationContexts;
-    if (error.IsSuccess())
-    {
-        error = this->RecoverRolloutContexts<ApplicationContext>(
-            storeTx, 
-            Constants::StoreType_ApplicationContext, 
-            activityId,
-            appCount,
-            allApplicationContexts);
-    }
-    
-    if (error.IsSuccess())
+    auto root = replica_.CreateAsyncOperationRoot();
+    auto worker = [this, recovery, root]()
     {
-        vector<ServiceContext> allServiceContexts;
-
-        error = this->RecoverRolloutContexts<ServiceContext>(
-            storeTx, 
-            Constants::StoreType_ServiceContext, 
-            activityId,
-            serviceCount,
-            allServiceContexts);
-    }
+        auto & jobs = recovery->Jobs;
+        for (LONG index = recovery->NextJob++; index < static_cast<LONG>(jobs.size()); index = recovery->NextJob++)
+        {
+            {
+                AcquireExclusiveLock lock(recovery->ErrorLock);
 
-    if (error.IsSuccess())
-    {
-        error = this->RecoverRolloutContexts<ApplicationUpgradeContext>(
-            storeTx, 
-            Constants::StoreType_ApplicationUpgradeContext, 
-            activityId,
-            applicationUpgradeCount);
-    }
+                if (!recovery->Error.IsSuccess()) { break; }
+            }
 
-    if (error.IsSuccess())
-    {
-        error = this->RecoverRolloutContexts<FabricProvisionContext>(
-            storeTx, 
-            Constants::StoreType_FabricProvisionContext, 
-            activityId,
-            fabricProvisionCount);
-    }
+            auto error = jobs[index]();
 
-    if (error.IsSuccess())
-    {
-        error = this->RecoverRolloutContexts<FabricUpgradeContext>(
-            storeTx, 
-            Constants::StoreType_FabricUpgradeContext, 
-            activityId,
-            fabricUpgradeCount);
-    }
+            if (!error.IsSuccess())
+            {
+                AcquireExclusiveLock lock(recovery->ErrorLock);
 
-    if (error.IsSuccess())
-    {
-        error = this->RecoverRolloutContexts<InfrastructureTaskContext>(
-            storeTx, 
-            Constants::StoreType_InfrastructureTaskContext, 
-            activityId,
-            infraTaskCount);
-    }
+                if (recovery->Error.IsSuccess())
+                {
+                    recovery->Error = error;
+                }
+            }
+        }
 
-    if (error.IsSuccess())
+        if (--recovery->PendingWorkers == 0)
+        {
+            this->OnRecoveryJobsComplete(*recovery);
+        }
+    };
+
+    for (size_t ix = 1; ix < parallelism; ++ix)
     {
-        error = this->RecoverRolloutContexts<ComposeDeploymentContext>(
-            storeTx, 
-            Constants::StoreType_ComposeDeploymentContext, 
-            activityId,
-            composeDeploymentCount);
+        Threadpool::Post(worker);
     }
 
-    if (error.IsSuccess())
+    worker();
+}
+
+void RolloutManager::OnRecoveryJobsComplete(__in RecoveryState & recovery)
+{
+    recovery.RecoveryStopwatch.Stop();
+
+    ErrorCode error;
     {
-        error = this->RecoverRolloutContexts<ComposeDeploymentUpgradeContext>(
-            storeTx, 
-            Constants::StoreType_ComposeDeploymentUpgradeContext, 
-            activityId,
-            composeUpgradeCount);
+        AcquireExclusiveLock lock(recovery.ErrorLock);
+
+        error = recovery.Error;
     }
 
     if (error.IsSuccess())
     {
+        ActivityId activityId;
+
         WriteInfo(
             TraceComponent, 
-            "{0} recovered pending contexts [AppProv = {1}, Apps = {2}, Svcs = {3}, AppUpgrades = {4} FabProv = {5} FabUpgrades = {6} InfraTasks = {7} composeDeploymentCount = {8} composeUpgradeCount = {9}]", 
-            storeTx.ReplicaActivityId, 
-            appTypeCount,
-            appCount,
-            serviceCount,
-            applicationUpgradeCount,
-            fabricProvisionCount,
-            fabricUpgradeCount,
-            infraTaskCount,
-            composeDeploymentCount,
-            composeUpgradeCount);
+            "{0} recovered pending contexts in {1}: [AppProv = {2}, Apps = {3}, Svcs = {4}, AppUpgrades = {5} FabProv = {6} FabUpgrades = {7} InfraTasks = {8} composeDeploymentCount = {9} composeUpgradeCount = {10}]", 
+            ReplicaActivityId(this->PartitionedReplicaId, activityId), 
+            recovery.RecoveryStopwatch.Elapsed,
+            recovery.AppTypeCount,
+            recovery.AppCount,
+            recovery.ServiceCount,
+            recovery.ApplicationUpgradeCount,
+            recovery.FabricProvisionCount,
+            recovery.FabricUpgradeCount,
+            recovery.InfraTaskCount,
+            recovery.ComposeDeploymentCount,
+            recovery.ComposeUpgradeCount);
 
-        storeTx.CommitReadOnly();
+        {
+            AcquireWriteLock lock(stateLock_);
+
+            if (state_ == RolloutManagerState::Recovery)
+            {
+                contextsRecovered_ = true;
+            }
+        }
 
         auto nextActivityId = activityId.GetNestedActivity();
 
         auto operation = AsyncOperation::CreateAndStart<MigrateDataAsyncOperation>(
             *this,
             nextActivityId,
-            move(allAppTypeContexts),
-            move(allApplicationContexts),
+            move(recovery.AllAppTypeContexts),
+            move(recovery.AllApplicationContexts),
             ManagementConfig::GetConfig().MaxCommunicationTimeout,
             [this, nextActivityId](AsyncOperationSPtr const & operation) { this->OnMigrateDataComplete(nextActivityId, operation, false); },
             replica_.CreateAsyncOperationRoot());
@@ -321,8 +393,6 @@ void RolloutManager::RecoveryCallback()
     }
     else
     {
-        storeTx.Rollback();
-
         this->ScheduleRecovery(error);
     }
 }
@@ -413,6 +483,16 @@ void RolloutManager::Stop()
     {
         state_ = RolloutManagerState::NotActive;
     }
+
+    contextsRecovered_ = false;
+}
+
+bool RolloutManager::get_IsQueryable() const
+{
+    AcquireReadLock lock(stateLock_);
+
+    return (state_ == RolloutManagerState::Active) 
+        || (state_ == RolloutManagerState::Recovery && contextsRecovered_);
 }
 
 void RolloutManager::Close()
@@ -421,6 +501,7 @@ void RolloutManager::Close()
         AcquireWriteLock lock(stateLock_);
 
         state_ = RolloutManagerState::Closed;
+        contextsRecovered_ = false;
     }
 
     // Pending contexts will keep the replica alive
@@ -1457,79 +1538,98 @@ void RolloutManager::RemoveActiveContext(__in RolloutContext & context)
 // Template functions
 // ******************
 
-template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationTypeContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<ServiceContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationUpgradeContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<FabricProvisionContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<FabricUpgradeContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<InfrastructureTaskContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationTypeContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ServiceContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationUpgradeContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<FabricProvisionContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<FabricUpgradeContext>(wstring const &, __out size_t &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<InfrastructureTaskContext>(wstring const &, __out size_t &);
 
-template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationTypeContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &, __out vector<ApplicationTypeContext> &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &, __out vector<ApplicationContext> &);
-template ErrorCode RolloutManager::RecoverRolloutContexts<ServiceContext>(StoreTransaction const &, wstring const &, __inout ActivityId &, __out size_t &, __out vector<ServiceContext> &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationTypeContext>(wstring const &, __out size_t &, __out vector<ApplicationTypeContext> &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ApplicationContext>(wstring const &, __out size_t &, __out vector<ApplicationContext> &);
+template ErrorCode RolloutManager::RecoverRolloutContexts<ServiceContext>(wstring const &, __out size_t &, __out vector<ServiceContext> &);
 
 template <class T>
 ErrorCode RolloutManager::RecoverRolloutContexts(
-    StoreTransaction const & storeTx, 
     std::wstring const & type, 
-    __inout ActivityId & activityId,
     __out size_t & recoveryCount)
 {
     vector<T> unused;
-    return RecoverRolloutContexts(storeTx, type, activityId, recoveryCount, unused);
+    return RecoverRolloutContexts(type, recoveryCount, unused);
 }
 
 template <class T>
 ErrorCode RolloutManager::RecoverRolloutContexts(
-    StoreTransaction const & storeTx, 
     std::wstring const & type, 
-    __inout ActivityId & activityId,
     __out size_t & recoveryCount,
     __out vector<T> & allContexts)
 {
-    int count = 0;
-    vector<T> typedContexts;
-    ErrorCode error = storeTx.ReadPrefix(type, L"", typedContexts);
+    auto storeTx = StoreTransaction::Create(replica_.ReplicatedStore, replica_.PartitionedReplicaId);
 
-    if (error.IsSuccess())
-    {
-        // Take the lock once instead of releasing/re-acquiring for
-        // each recovered context
-        //
-        AcquireExclusiveLock lock(contextsLock_);
+    auto activityId = storeTx.ActivityId.GetNestedActivity();
 
-        for (auto & typedContext : typedContexts)
+    int count = 0;
+    vector<T> recoveredContexts;
+    ErrorCode error = storeTx.ReadPrefixInBatches<T>(
+        type, 
+        L"", 
+        static_cast<size_t>(ManagementConfig::GetConfig().RolloutContextRecoveryBatchSize),
+        [&](vector<T> && typedContexts) -> ErrorCode
         {
-            if (!typedContext.IsComplete && !typedContext.IsFailed)
+            // Take the lock once per batch instead of releasing/re-acquiring for
+            // each recovered context, while still letting other context types 
+            // recover in parallel
+            //
+            AcquireExclusiveLock lock(contextsLock_);
+
+            for (auto & typedContext : typedContexts)
             {
-                shared_ptr<T> context(new T(move(typedContext)));
-                context->ReInitializeContext(*replicaSPtr_);
+                if (!typedContext.IsComplete && !typedContext.IsFailed)
+                {
+                    shared_ptr<T> context(new T(move(typedContext)));
+                    context->ReInitializeContext(*replicaSPtr_);
 
-                // Give each recovered context a different activityId - correlated
-                // with the recovery transaction's activityId
-                // 
-                activityId = activityId.GetNestedActivity();
-                context->ReInitializeTracing(Store::ReplicaActivityId(storeTx.ReplicaActivityId.PartitionedReplicaId, activityId));
+                    // Give each recovered context a different activityId - correlated
+                    // with the recovery transaction's activityId
+                    // 
+                    activityId = activityId.GetNestedActivity();
+                    context->ReInitializeTracing(Store::ReplicaActivityId(storeTx.ReplicaActivityId.PartitionedReplicaId, activityId));
 
-                shared_ptr<RolloutContext> activeContext;
-                if (this->TryAddActiveContextCallerHoldsLock(context, activeContext))
-                {
-                    ++count;
+                    shared_ptr<RolloutContext> activeContext;
+                    if (this->TryAddActiveContextCallerHoldsLock(context, activeContext))
+                    {
+                        ++count;
 
-                    WriteNoise(
-                        TraceComponent, 
-                        "{0} recovering {1}",
-                        activeContext->TraceId, 
-                        *activeContext); 
+                        WriteNoise(
+                            TraceComponent, 
+                            "{0} recovering {1}",
+                            activeContext->TraceId, 
+                            *activeContext); 
 
-                    this->PostRolloutContextProcessing(*activeContext);
+                        this->PostRolloutContextProcessing(*activeContext);
+                    }
                 }
             }
-        }
+
+            recoveredContexts.insert(
+                recoveredContexts.end(), 
+                make_move_iterator(typedContexts.begin()), 
+                make_move_iterator(typedContexts.end()));
+
+            return ErrorCodeValue::Success;
+        });
+
+    if (error.IsSuccess())
+    {
+        storeTx.CommitReadOnly();
 
         recoveryCount = count;
-        allContexts.swap(typedContexts);
+        allContexts.swap(recoveredContexts);
+    }
+    else
+    {
+        storeTx.Rollback();
     }
 
     return error;
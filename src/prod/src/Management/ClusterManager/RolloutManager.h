@@ -26,6 +26,12 @@ namespace Management
             __declspec(property(get=get_IsActive)) bool IsActive;
             bool get_IsActive() const { Common::AcquireReadLock lock(stateLock_); return (state_ == RolloutManagerState::Active); }
 
+            // Read-only queries are accepted once recovery has loaded all pending contexts, which is
+            // before the migration and baseline steps of recovery complete
+            //
+            __declspec(property(get=get_IsQueryable)) bool IsQueryable;
+            bool get_IsQueryable() const;
+
             __declspec(property(get=get_PerfCounters)) ClusterManagerPerformanceCounters const & PerfCounters;
             ClusterManagerPerformanceCounters const & get_PerfCounters() const { return *perfCounters_; }
 
@@ -53,18 +59,20 @@ namespace Management
             void OnBaselineComplete(Common::AsyncOperationSPtr const &, bool expectedCompletedSynchronously);
             void RecoveryComplete();
             
+            struct RecoveryState;
+            typedef std::shared_ptr<RecoveryState> RecoveryStateSPtr;
+
+            void RunRecoveryJobs(RecoveryStateSPtr const &);
+            void OnRecoveryJobsComplete(__in RecoveryState &);
+
             template <class T>
             Common::ErrorCode RecoverRolloutContexts(
-                Store::StoreTransaction const &, 
                 std::wstring const & type, 
-                __inout Common::ActivityId &,
                 __out size_t & recoveryCount);
 
             template <class T>
             Common::ErrorCode RecoverRolloutContexts(
-                Store::StoreTransaction const &, 
                 std::wstring const & type, 
-                __inout Common::ActivityId &,
                 __out size_t & recoveryCount,
                 __out std::vector<T> & allContexts);
 
@@ -124,7 +132,8 @@ namespace Management
             // [done] corresponds to completion of recovery, which occurs in the
             // private member function RecoveryCallback().
             //
-            // Client requests are only accepted in the Active state.
+            // Client requests are only accepted in the Active state. Queries are also
+            // accepted in the Recovery state once all pending contexts have been loaded.
             // 
             //             
             // ==============+===========+==========+========+========+
@@ -140,6 +149,7 @@ namespace Management
             // --------------+-----------+----------+--------+--------+
             //
             RolloutManagerState::Enum state_;
+            bool contextsRecovered_;
             mutable Common::RwLock stateLock_;
 
             // Active contexts will keep the ClusterManagerReplica alive
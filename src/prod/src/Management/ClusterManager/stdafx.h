@@ -99,6 +99,7 @@
 // ImageBuilder
 #include "Management/ClusterManager/DigestedApplicationDescription.h"
 #include "Management/ClusterManager/IImageBuilder.h"
+#include "Management/ClusterManager/ImageBuilderResultCache.h"
 #include "Management/ClusterManager/ImageBuilderProxy.h"
 #include "Management/ClusterManager/TestDockerComposeImageBuilderProxy.h"
 
@@ -116,6 +116,8 @@ namespace Management
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ClusterManager", ImageBuilderJobQueueDelay, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Dynamic);
         // Interval at which CM will poll for operation progress information from Image Builder (<= 0 to disable)
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ClusterManager", ImageBuilderProgressTrackingInterval, Common::TimeSpan::FromSeconds(2), Common::ConfigEntryUpgradePolicy::Dynamic);
+        // The max number of Image Builder compose validation and provisioning results cached by content and arguments on each node, so that identical requests do not run Image Builder again. 0 disables the cache.
+        INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", ImageBuilderResultCacheSize, 128, Common::ConfigEntryUpgradePolicy::Static, Common::GreaterThan(-1));
         // Maximum application type name string allowed when provisioning (depends on the underlying local store)
         INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", MaxApplicationTypeNameLength, 256, Common::ConfigEntryUpgradePolicy::Dynamic);
         // Maximum application type version string allowed when provisioning (depends on the underlying local store)
@@ -141,6 +143,10 @@ namespace Management
         INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", NamingJobQueueSize, 1000, Common::ConfigEntryUpgradePolicy::Dynamic);
         // The max number Naming work items that can be started in parallel.
         INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", NamingJobQueueMaxPendingWorkCount, 500, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // The max number of rollout context types that are recovered from the store in parallel when the ClusterManager becomes primary.
+        INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", RolloutContextRecoveryParallelism, 4, Common::ConfigEntryUpgradePolicy::Dynamic, Common::GreaterThan(0));
+        // The number of rollout contexts read from the store and registered for processing at a time during recovery.
+        INTERNAL_CONFIG_ENTRY(int, L"ClusterManager", RolloutContextRecoveryBatchSize, 1000, Common::ConfigEntryUpgradePolicy::Dynamic, Common::GreaterThan(0));
 
         //
         // These config entries help in mocking out some features so that we can test the docker compose based application deployment path
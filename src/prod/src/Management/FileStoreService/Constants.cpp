@@ -21,6 +21,7 @@ GlobalWString Constants::StoreRootDirectoryName = make_global<wstring>(L"Store")
 GlobalWString Constants::StagingRootDirectoryName = make_global<wstring>(L"Staging");
 GlobalWString Constants::StoreShareName= make_global<wstring>(L"StoreShare");
 GlobalWString Constants::StagingShareName = make_global<wstring>(L"StagingShare");
+GlobalWString Constants::BuildCompletedMarkerFileName = make_global<wstring>(L"BuildCompleted");
 
 GlobalWString Constants::DatabaseDirectory = make_global<wstring>(L"FS");
 GlobalWString Constants::DatabaseFilename = make_global<wstring>(L"FS.edb");
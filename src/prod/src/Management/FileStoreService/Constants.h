@@ -23,6 +23,7 @@ namespace Management
             static Common::GlobalWString StagingRootDirectoryName;
             static Common::GlobalWString StoreShareName;
             static Common::GlobalWString StagingShareName;
+            static Common::GlobalWString BuildCompletedMarkerFileName;
 
             static Common::GlobalWString DatabaseDirectory;
             static Common::GlobalWString DatabaseFilename;
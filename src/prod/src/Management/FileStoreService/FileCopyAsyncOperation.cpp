@@ -222,6 +222,7 @@ ErrorCode FileCopyAsyncOperation::TransitionToIntermediateState(StoreTransaction
         metadata.State = FileState::Updating;
         metadata.PreviousVersion = metadata.CurrentVersion;
         metadata.CurrentVersion = destinationFileVersion_;
+        metadata.FileSize = FileMetadata::UnknownFileSize;
 
         metadata.CopyDesc = copyDesc;
 
@@ -273,6 +274,14 @@ ErrorCode FileCopyAsyncOperation::TransitionToReplicatingState(StoreTransaction
         }
     }
 
+    // The file is in place at this point, so record its size for secondaries to verify their copies
+    int64 fileSize = FileMetadata::UnknownFileSize;
+    if (!File::GetSize(destinationStoreFullPath_, fileSize).IsSuccess())
+    {
+        fileSize = FileMetadata::UnknownFileSize;
+    }
+
+    metadata.FileSize = fileSize;
     metadata.State = this->UseTwoPhaseCommit ? FileState::Replicating : FileState::Available_V1;
     error = storeTx.Update(metadata);
     WriteTrace(
@@ -332,9 +341,16 @@ ErrorCode FileCopyAsyncOperation::TransitionToRolledbackState(StoreTransaction c
     }
     else
     {
+        int64 fileSize = FileMetadata::UnknownFileSize;
+        if (!File::GetSize(Utility::GetVersionedFileFullPath(this->RequestManagerObj.ReplicaObj.StoreRoot, this->StoreRelativePath, metadata.PreviousVersion), fileSize).IsSuccess())
+        {
+            fileSize = FileMetadata::UnknownFileSize;
+        }
+
         metadata.CurrentVersion = metadata.PreviousVersion;
         metadata.PreviousVersion = StoreFileVersion::Default;
         metadata.State = FileState::Committed;
+        metadata.FileSize = fileSize;
 
         metadata.CopyDesc = CopyDescription();
 
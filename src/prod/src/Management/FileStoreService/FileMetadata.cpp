@@ -15,6 +15,7 @@ FileMetadata::FileMetadata()
     , previousVersion_()
     , state_()
     , copyDesc_()
+    , fileSize_(UnknownFileSize)
 {
 }
 
@@ -24,6 +25,7 @@ FileMetadata::FileMetadata(std::wstring const & storeRelativeLocation)
     , previousVersion_()
     , state_()
     , copyDesc_()
+    , fileSize_(UnknownFileSize)
 {
 }
 
@@ -33,6 +35,7 @@ FileMetadata::FileMetadata(std::wstring const & storeRelativeLocation, StoreFile
 , previousVersion_()
 , state_(state)
 , copyDesc_()
+, fileSize_(UnknownFileSize)
 {
 }
 
@@ -42,6 +45,7 @@ FileMetadata::FileMetadata(std::wstring const & storeRelativeLocation, StoreFile
     , previousVersion_()
     , state_(state)
     , copyDesc_(copyDesc)
+    , fileSize_(UnknownFileSize)
 {
 }
 
@@ -62,5 +66,5 @@ wstring FileMetadata::ConstructKey() const
 
 void FileMetadata::WriteTo(TextWriter & w, FormatOptions const &) const
 {    
-    w.Write("FileMetadata[{0}, {1}, {2}, {3}, {4}]", storeRelativeLocation_, currentVersion_, previousVersion_, state_, copyDesc_);
+    w.Write("FileMetadata[{0}, {1}, {2}, {3}, {4}, {5}]", storeRelativeLocation_, currentVersion_, previousVersion_, state_, copyDesc_, fileSize_);
 }
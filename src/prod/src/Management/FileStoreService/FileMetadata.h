@@ -12,6 +12,8 @@ namespace Management
         class FileMetadata : public Store::StoreData
         {        
         public:
+            static int64 const UnknownFileSize = -1;
+
             FileMetadata();
             FileMetadata(std::wstring const & relativeLocation);
             FileMetadata(std::wstring const & relativeLocation, StoreFileVersion const currentVersion, FileState::Enum const state);
@@ -39,12 +41,18 @@ namespace Management
             CopyDescription get_CopyDesc() const { return copyDesc_; }
             void set_CopyDesc(CopyDescription const & value) { copyDesc_ = value; }
 
+            // Size of the current version of the file. Secondaries use it to detect incomplete
+            // copies. UnknownFileSize for metadata written by older versions.
+            __declspec(property(get = get_FileSize, put = set_FileSize)) int64 FileSize;
+            int64 get_FileSize() const { return fileSize_; }
+            void set_FileSize(int64 const value) { fileSize_ = value; }
+
             __declspec (property(get=get_Type)) std::wstring const & Type;
             virtual std::wstring const & get_Type() const { return *(Constants::StoreType::FileMetadata); }
 
             virtual void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;        
 
-            FABRIC_FIELDS_05(storeRelativeLocation_, currentVersion_, previousVersion_, state_, copyDesc_);
+            FABRIC_FIELDS_06(storeRelativeLocation_, currentVersion_, previousVersion_, state_, copyDesc_, fileSize_);
 
         protected:
             virtual std::wstring ConstructKey() const;
@@ -55,6 +63,7 @@ namespace Management
             StoreFileVersion previousVersion_;
             FileState::Enum state_;
             CopyDescription copyDesc_;
+            int64 fileSize_;
         };
     }
 }
@@ -38,6 +38,8 @@ namespace Management
             PUBLIC_CONFIG_ENTRY(uint, L"FileStoreService", MaxRequestProcessingThreads, 200, Common::ConfigEntryUpgradePolicy::Static);
             // The maximum number of file copy retries on the secondary before giving up
             PUBLIC_CONFIG_ENTRY(uint, L"FileStoreService", MaxSecondaryFileCopyFailureThreshold, 25, Common::ConfigEntryUpgradePolicy::Dynamic);
+            // When building a new secondary, spread the file copies across the primary and all other secondaries that have completed their own build instead of copying every file from the primary first
+            INTERNAL_CONFIG_ENTRY(bool, L"FileStoreService", EnableSecondaryCopyFromAllReplicas, false, Common::ConfigEntryUpgradePolicy::Dynamic);
             // The file copy retry delay (in milliseconds)
             PUBLIC_CONFIG_ENTRY(uint, L"FileStoreService", SecondaryFileCopyRetryDelayMilliseconds, 500, Common::ConfigEntryUpgradePolicy::Dynamic);
             // Enable/Disable anonymous access to the FileStoreService shares
@@ -128,6 +130,8 @@ namespace Management
 			
             // The maximum number of parallel threads allowed during upload/download of files in the client. '0' == number of cores
             INTERNAL_CONFIG_ENTRY(uint, L"FileStoreService", MaxClientOperationThreads, 25, Common::ConfigEntryUpgradePolicy::Static);
+            // The size of the blocks used to join uploaded chunks into the committed file
+            INTERNAL_CONFIG_ENTRY(uint, L"FileStoreService", JoinFileBufferSizeInKB, 4096, Common::ConfigEntryUpgradePolicy::Dynamic, Common::UIntGreaterThan(0));
             // The backoff interval for StoreTransaction failures
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FileStoreService", StoreTransactionRetryInterval, Common::TimeSpan::FromSeconds(3.0), Common::ConfigEntryUpgradePolicy::Dynamic);
             // The max backoff interval for StoreTransaction failures
@@ -213,6 +213,7 @@ ErrorCode FileUploadAsyncOperation::TransitionToIntermediateState(StoreTransacti
         metadata.State = FileState::Updating;        
         metadata.PreviousVersion = metadata.CurrentVersion;
         metadata.CurrentVersion = fileVersion_;
+        metadata.FileSize = FileMetadata::UnknownFileSize;
 
         metadata.CopyDesc = CopyDescription();
         
@@ -269,6 +270,14 @@ ErrorCode FileUploadAsyncOperation::TransitionToReplicatingState(StoreTransactio
         }
     }
 
+    // The file is in place at this point, so record its size for secondaries to verify their copies
+    int64 fileSize = FileMetadata::UnknownFileSize;
+    if (!File::GetSize(storeFullPath_, fileSize).IsSuccess())
+    {
+        fileSize = FileMetadata::UnknownFileSize;
+    }
+
+    metadata.FileSize = fileSize;
     metadata.State = this->UseTwoPhaseCommit ? FileState::Replicating : FileState::Available_V1;
     error = storeTx.Update(metadata);
     WriteTrace(
@@ -328,9 +337,16 @@ ErrorCode FileUploadAsyncOperation::TransitionToRolledbackState(StoreTransaction
     }
     else
     {
+        int64 fileSize = FileMetadata::UnknownFileSize;
+        if (!File::GetSize(Utility::GetVersionedFileFullPath(this->RequestManagerObj.ReplicaObj.StoreRoot, this->StoreRelativePath, metadata.PreviousVersion), fileSize).IsSuccess())
+        {
+            fileSize = FileMetadata::UnknownFileSize;
+        }
+
         metadata.CurrentVersion = metadata.PreviousVersion;
         metadata.PreviousVersion = StoreFileVersion::Default;
         metadata.State = FileState::Committed;
+        metadata.FileSize = fileSize;
 
         metadata.CopyDesc = CopyDescription();
 
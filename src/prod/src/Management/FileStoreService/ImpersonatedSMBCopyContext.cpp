@@ -260,7 +260,17 @@ ErrorCode ImpersonatedSMBCopyContext::ImpersonateAndCopyFile(
 #if !defined(PLATFORM_UNIX)
     auto error = File::SafeCopy(sourcePath, destinationPath, true /*overwrite*/, false /*shouldAcquireLock*/);
 #else
-    auto error = File::Copy(sourcePath, destinationPath, accessToken->AccountName, accessToken->Password, true /*overwrite*/);
+    // The scp copy writes straight to its destination, so copy to a temporary file and
+    // move it into place like SafeCopy does. Otherwise a failed copy leaves a partial
+    // file at the destination that looks complete to the next reader.
+    //
+    auto copy = [&sourcePath, &accessToken](wstring const & copyDestinationPath)
+    {
+        return File::Copy(sourcePath, copyDestinationPath, accessToken->AccountName, accessToken->Password, true /*overwrite*/);
+    };
+
+    bool isLocalDestination = (destinationPath.find(L":/") == wstring::npos);
+    auto error = isLocalDestination ? Utility::CopyThroughTempFile(destinationPath, copy) : copy(destinationPath);
 #endif
     watch.Stop();
     WriteTrace(
@@ -46,15 +46,16 @@ class ReplicationManager::ProcessCopyJobItem : public JobItem<ReplicationManager
     DENY_COPY(ProcessCopyJobItem)
 
 public:
-    ProcessCopyJobItem(FileMetadata const & metadata, atomic_uint64 & failureCount)
+    ProcessCopyJobItem(FileMetadata const & metadata, size_t sourceIndex, atomic_uint64 & failureCount)
         : metadata_(metadata)
+        , sourceIndex_(sourceIndex)
         , failureCount_(failureCount)
     {
     }
 
     virtual void Process(ReplicationManager & replicationManager)
     {        
-        if(!replicationManager.ReplicateFileAndDeleteOlderVersion(metadata_))
+        if(!replicationManager.ReplicateFileAndDeleteOlderVersion(metadata_, sourceIndex_))
         {
             failureCount_++;
         }
@@ -62,6 +63,7 @@ public:
 
 private:
     FileMetadata metadata_;
+    size_t sourceIndex_;
     atomic_uint64 & failureCount_;
 };
 
@@ -72,6 +74,7 @@ ReplicationManager::ReplicationManager(
     : serviceReplicaHolder_(serviceReplicaHolder)
     , currentPrimaryStoreLocation_()
     , secondaryStoreLocations_()
+    , builtSecondaryStoreLocations_()
     , lock_()
 {
     this->SetTraceId(serviceReplicaHolder.Value.PartitionedReplicaId.TraceId);
@@ -89,11 +92,43 @@ bool ReplicationManager::ProcessCopyNotification(IStoreItemEnumeratorPtr const &
         return false;
     }
 
+    // This replica must not be used as a copy source until the build completes
+    //
+    auto buildCompletedMarker = Path::Combine(this->ReplicaObj.StoreRoot, Constants::BuildCompletedMarkerFileName);
+    if (File::Exists(buildCompletedMarker))
+    {
+        error = File::Delete2(buildCompletedMarker, true /*deleteReadOnlyFiles*/);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(
+                TraceComponent,
+                TraceId,
+                "Failed to delete build completed marker. Path:{0}, Error:{1}",
+                buildCompletedMarker,
+                error);
+
+            return false;
+        }
+    }
+
+    // Spread the copies across the secondaries that have completed their own build so
+    // that the primary is not the only source. Those secondaries may still be missing
+    // files that were added after their build, in which case the copy falls through
+    // to the next replica and eventually the primary.
+    //
+    bool copyFromAllReplicas = FileStoreServiceConfig::GetConfig().EnableSecondaryCopyFromAllReplicas;
+    if (copyFromAllReplicas)
+    {
+        this->TryRefreshShareLocations(L"");
+        this->RefreshBuiltSecondaryStoreLocations();
+    }
+
     // Get all the files in the store folder and put it in a set for faster lookup
     auto filesToDelete = Utility::GetAllFiles(this->ReplicaObj.StoreRoot);
 
     ProcessCopyJobQueue jobQueue(this->TraceId, *this, FileStoreServiceConfig::GetConfig().MaxCopyOperationThreads);
     atomic_uint64 failureCount(0);
+    size_t copyCount = 0;
 
     while ((error = storeItemEnumerator->MoveNext()).IsSuccess() && failureCount.load() == 0)
     {
@@ -113,16 +148,20 @@ bool ReplicationManager::ProcessCopyNotification(IStoreItemEnumeratorPtr const &
         {
             auto availableFile = Utility::GetVersionedFileFullPath(this->ReplicaObj.StoreRoot, metadata.StoreRelativeLocation, metadata.CurrentVersion);
             auto iter = filesToDelete.find(availableFile);
+            bool isAvailable = false;
             if (iter != filesToDelete.end())
             {
                 // The file is in a stable state and it is already present in the local file store
-                // Hence we can skip copy and remove it from the list of files which will be deleted
+                // Hence remove it from the list of files which will be deleted. The copy can only be
+                // skipped if the local file is complete, otherwise it has been deleted and is copied again.
                 filesToDelete.erase(iter);
+                isAvailable = Utility::IsFileComplete(availableFile, metadata.FileSize);
             }
-            else
+
+            if (!isAvailable)
             {
                 // Need to copy the file from another replica in the partition. Add it to job queue
-                jobQueue.Enqueue(make_unique<ProcessCopyJobItem>(metadata, failureCount));
+                jobQueue.Enqueue(make_unique<ProcessCopyJobItem>(metadata, copyFromAllReplicas ? copyCount++ : 0, failureCount));
             }
         }
     }
@@ -164,6 +203,15 @@ bool ReplicationManager::ProcessCopyNotification(IStoreItemEnumeratorPtr const &
             error);
     }    
 
+    error = File::Touch(buildCompletedMarker);
+    WriteTrace(
+        error.ToLogLevel(),
+        TraceComponent,
+        TraceId,
+        "Writing build completed marker. Path:{0}, Error:{1}",
+        buildCompletedMarker,
+        error);
+
     return true;
 }
 
@@ -207,7 +255,7 @@ bool ReplicationManager::ProcessReplicationNotification(IStoreNotificationEnumer
                 ++jobCount;
 
                 // Need to copy the file from primary. Add it to job queue
-                jobQueue.Enqueue(make_unique<ProcessCopyJobItem>(metadata, failureCount));
+                jobQueue.Enqueue(make_unique<ProcessCopyJobItem>(metadata, 0, failureCount));
             }
         }
 
@@ -247,7 +295,7 @@ bool ReplicationManager::ProcessReplicationNotification(IStoreNotificationEnumer
     return true;
 }
 
-bool ReplicationManager::ReplicateFileAndDeleteOlderVersion(FileMetadata const & metadata)
+bool ReplicationManager::ReplicateFileAndDeleteOlderVersion(FileMetadata const & metadata, size_t sourceIndex)
 {
     // TODO: Demote to noise after testing
     WriteInfo(
@@ -256,7 +304,7 @@ bool ReplicationManager::ReplicateFileAndDeleteOlderVersion(FileMetadata const &
         "ReplicateFile: {0}",
         metadata);
 
-    bool success = this->ReplicateFile(metadata);
+    bool success = this->ReplicateFile(metadata, sourceIndex);
 
     if(success && metadata.PreviousVersion != StoreFileVersion::Default)
     {
@@ -277,10 +325,10 @@ bool ReplicationManager::ReplicateFileAndDeleteOlderVersion(FileMetadata const &
     return success;
 }
 
-bool ReplicationManager::ReplicateFile(FileMetadata const & metadata)
+bool ReplicationManager::ReplicateFile(FileMetadata const & metadata, size_t sourceIndex)
 {
     wstring currentDestinationFilePath = Utility::GetVersionedFileFullPath(this->ReplicaObj.StoreRoot, metadata.StoreRelativeLocation, metadata.CurrentVersion);
-    if(File::Exists(currentDestinationFilePath))
+    if(Utility::IsFileComplete(currentDestinationFilePath, metadata.FileSize))
     {
         // If file is already in the secondary's store, skip copy
         return true;
@@ -324,61 +372,76 @@ bool ReplicationManager::ReplicateFile(FileMetadata const & metadata)
         }
     }
 
+    auto copyFile = [this](wstring const & sourcePath, wstring const & destinationPath)
+    {
+        return this->ReplicaObj.SmbContext->CopyFileW(sourcePath, destinationPath);
+    };
+
+    // Only the first attempt starts from the selected replica, and only considers
+    // the secondaries that have completed their build. Retries fall back to
+    // trying the primary first.
+    //
+    bool useSourceIndex = (sourceIndex > 0);
     uint failureCount = 0;
 
-    do
+    while (failureCount < FileStoreServiceConfig::GetConfig().MaxSecondaryFileCopyFailureThreshold)
     {
+        wstring primaryStoreLocation;
         vector<wstring> storeLocations;
         {
             AcquireReadLock lock(lock_);
 
+            auto const & secondaryStoreLocations = useSourceIndex ? builtSecondaryStoreLocations_ : secondaryStoreLocations_;
+
+            primaryStoreLocation = currentPrimaryStoreLocation_;
             storeLocations.push_back(currentPrimaryStoreLocation_);
-            storeLocations.insert(storeLocations.end(), secondaryStoreLocations_.begin(), secondaryStoreLocations_.end());
+            storeLocations.insert(storeLocations.end(), secondaryStoreLocations.begin(), secondaryStoreLocations.end());
+        }
+
+        if (useSourceIndex && storeLocations.size() > 1)
+        {
+            rotate(storeLocations.begin(), storeLocations.begin() + (sourceIndex % storeLocations.size()), storeLocations.end());
         }
 
+        storeLocations.erase(
+            remove(storeLocations.begin(), storeLocations.end(), this->ReplicaObj.ShareRoot),
+            storeLocations.end());
+
         // Attempt secondaries after trying the primary since the primary itself
         // may still be recovering and not have the file yet.
         //
-        for (auto ix=0; ix<storeLocations.size(); ++ix)
+        bool isCopyFailed = false;
+        if (Utility::TryCopyFromStoreLocations(
+            storeLocations,
+            primaryStoreLocation,
+            metadata.StoreRelativeLocation,
+            metadata.CurrentVersion,
+            metadata.FileSize,
+            currentDestinationFilePath,
+            copyFile,
+            isCopyFailed))
         {
-            auto const & storeLocation = storeLocations[ix];
-
-            if (storeLocation == this->ReplicaObj.ShareRoot)
-            {
-                continue;
-            }
+            return true;
+        }
 
-            auto currentSourceFilePath = Utility::GetVersionedFileFullPath(
-                storeLocation, 
-                metadata.StoreRelativeLocation, 
+        if (useSourceIndex && !isCopyFailed)
+        {
+            // None of the built secondaries had the file yet and the primary was not
+            // tried. That is not a failure, so try all replicas right away.
+            //
+            WriteInfo(
+                TraceComponent,
+                TraceId,
+                "File not found on built secondaries - retrying from all replicas: file={0} version={1}",
+                metadata.StoreRelativeLocation,
                 metadata.CurrentVersion);
 
-            auto error = this->ReplicaObj.SmbContext->CopyFileW(currentSourceFilePath, currentDestinationFilePath);
-
-            if (error.IsSuccess()) 
-            { 
-                // TODO: Demote to noise when Image Store Service stabilizes
-                WriteInfo(
-                    TraceComponent,
-                    TraceId,
-                    "CopyFile succeeded: current src={0} dest={1}",
-                    currentSourceFilePath,
-                    currentDestinationFilePath);
-
-                return true; 
-            }
-            else if (ix < storeLocations.size() - 1)
-            {
-                WriteInfo(
-                    TraceComponent,
-                    TraceId,
-                    "CopyFile failed - retrying from a different replica: current src={0} dest={1} error={2}",
-                    currentSourceFilePath,
-                    currentDestinationFilePath,
-                    error);
-            }
+            useSourceIndex = false;
+            continue;
         }
 
+        useSourceIndex = false;
+
         // Since the file wasn't found on any replica, check the metadata state of the file
         // on the primary. There are two scenarios where the file may no longer exist on
         // the primary:
@@ -433,7 +496,8 @@ bool ReplicationManager::ReplicateFile(FileMetadata const & metadata)
 
         this->TryRefreshShareLocations(metadata.StoreRelativeLocation);
 
-    } while (++failureCount < FileStoreServiceConfig::GetConfig().MaxSecondaryFileCopyFailureThreshold);
+        ++failureCount;
+    }
 
     return false;
 }
@@ -455,7 +519,7 @@ void ReplicationManager::TryRefreshShareLocations(wstring const & relativeStoreP
 
     if (error.IsSuccess())
     {
-        AcquireReadLock lock(lock_);
+        AcquireWriteLock lock(lock_);
 
         secondaryStoreLocations_ = secondaryShares;
     }
@@ -470,6 +534,41 @@ void ReplicationManager::TryRefreshShareLocations(wstring const & relativeStoreP
         error);
 }
 
+void ReplicationManager::RefreshBuiltSecondaryStoreLocations()
+{
+    auto copyFile = [this](wstring const & sourcePath, wstring const & destinationPath)
+    {
+        return this->ReplicaObj.SmbContext->CopyFileW(sourcePath, destinationPath);
+    };
+
+    vector<wstring> secondaryStoreLocations;
+    {
+        AcquireReadLock lock(lock_);
+
+        secondaryStoreLocations = secondaryStoreLocations_;
+    }
+
+    vector<wstring> builtSecondaryStoreLocations;
+    for (auto const & storeLocation : secondaryStoreLocations)
+    {
+        if (storeLocation != this->ReplicaObj.ShareRoot && Utility::IsBuildCompleted(storeLocation, this->ReplicaObj.StoreRoot, copyFile))
+        {
+            builtSecondaryStoreLocations.push_back(storeLocation);
+        }
+    }
+
+    WriteInfo(
+        TraceComponent,
+        TraceId,
+        "RefreshBuiltSecondaryStoreLocations: secondaries={0} built={1}",
+        secondaryStoreLocations,
+        builtSecondaryStoreLocations);
+
+    AcquireWriteLock lock(lock_);
+
+    builtSecondaryStoreLocations_ = move(builtSecondaryStoreLocations);
+}
+
 // Currently, FileStoreService uses a Naming property for resolving the primary
 // store location. Since the V2 storage stack notifications do not block reconfiguration,
 // this can be optimized to use the normal service resolution mechanism (i.e. combine
@@ -28,10 +28,16 @@ namespace Management
             class ProcessCopyJobItem;
             friend class ProcessCopyJobItem;
 
-            bool ReplicateFileAndDeleteOlderVersion(FileMetadata const & metadata);
-            bool ReplicateFile(FileMetadata const & metadata);            
+            // sourceIndex selects the replica to copy from first. Index 0 is the primary.
+            bool ReplicateFileAndDeleteOlderVersion(FileMetadata const & metadata, size_t sourceIndex);
+            bool ReplicateFile(FileMetadata const & metadata, size_t sourceIndex);
             Common::ErrorCode EnsurePrimaryStoreShareLocation();
             void TryRefreshShareLocations(std::wstring const & relativeStorePath);
+
+            // A replica writes the build completed marker to its store once its copy has finished,
+            // so only those secondaries have every stable file and can be used as copy sources.
+            void RefreshBuiltSecondaryStoreLocations();
+
             Common::ErrorCode IsFilePresentInPrimary(
                 std::wstring const & relativeStorePath, 
                 __out bool & isPresent,
@@ -48,6 +54,7 @@ namespace Management
             Common::RwLock lock_;
             std::wstring currentPrimaryStoreLocation_;
             std::vector<std::wstring> secondaryStoreLocations_;
+            std::vector<std::wstring> builtSecondaryStoreLocations_;
             ImageStoreServiceReplicaHolder serviceReplicaHolder_;            
         };
     }
@@ -0,0 +1,338 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Management
+{
+    namespace FileStoreService
+    {
+        class UtilityTest
+        {
+        protected:
+            UtilityTest()
+                : root_(Path::Combine(Directory::GetCurrentDirectory(), L"FileStoreServiceUtilityTest.Data"))
+                , joinFileBufferSizeInKB_(FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB)
+            {
+                if (Directory::Exists(root_))
+                {
+                    Directory::Delete(root_, true, true).ReadValue();
+                }
+
+                VERIFY_IS_TRUE(Directory::Create2(root_).IsSuccess());
+            }
+
+            ~UtilityTest()
+            {
+                FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB = joinFileBufferSizeInKB_;
+
+                Directory::Delete(root_, true, true).ReadValue();
+            }
+
+            static vector<BYTE> CreateContent(size_t size, BYTE seed)
+            {
+                vector<BYTE> content(size);
+                for (size_t ix = 0; ix < size; ++ix)
+                {
+                    content[ix] = static_cast<BYTE>(seed + ix * 7);
+                }
+
+                return content;
+            }
+
+            static void WriteFile(wstring const & path, vector<BYTE> const & content)
+            {
+                auto directory = Path::GetDirectoryName(path);
+                if (!Directory::Exists(directory))
+                {
+                    VERIFY_IS_TRUE(Directory::Create2(directory).IsSuccess());
+                }
+
+                File file;
+                VERIFY_IS_TRUE(file.TryOpen(path, FileMode::Create, FileAccess::Write, FileShare::None).IsSuccess());
+
+                DWORD bytesWritten = 0;
+                if (!content.empty())
+                {
+                    VERIFY_IS_TRUE(file.TryWrite2(content.data(), static_cast<int>(content.size()), bytesWritten).IsSuccess());
+                }
+
+                VERIFY_ARE_EQUAL2(bytesWritten, content.size());
+
+                file.Close2();
+            }
+
+            static vector<BYTE> ReadFile(wstring const & path)
+            {
+                int64 size = 0;
+                VERIFY_IS_TRUE(File::GetSize(path, size).IsSuccess());
+
+                File file;
+                VERIFY_IS_TRUE(file.TryOpen(path, FileMode::Open, FileAccess::Read, FileShare::Read).IsSuccess());
+
+                vector<BYTE> content(static_cast<size_t>(size));
+                DWORD bytesRead = 0;
+                if (!content.empty())
+                {
+                    VERIFY_IS_TRUE(file.TryRead2(content.data(), static_cast<int>(content.size()), bytesRead).IsSuccess());
+                }
+
+                VERIFY_ARE_EQUAL2(bytesRead, content.size());
+
+                file.Close2();
+
+                return content;
+            }
+
+            // Writes one source file per size and verifies that joining them produces their concatenation
+            void JoinAndVerify(vector<size_t> const & sizes)
+            {
+                vector<wstring> sourceFiles;
+                vector<BYTE> expected;
+                for (size_t ix = 0; ix < sizes.size(); ++ix)
+                {
+                    auto content = CreateContent(sizes[ix], static_cast<BYTE>(ix));
+                    auto sourceFile = Path::Combine(root_, wformatString("chunk{0}", ix));
+                    WriteFile(sourceFile, content);
+
+                    sourceFiles.push_back(sourceFile);
+                    expected.insert(expected.end(), content.begin(), content.end());
+                }
+
+                auto destinationFile = Path::Combine(root_, L"joined");
+
+                auto error = Utility::JoinFiles(sourceFiles, destinationFile);
+                VERIFY_IS_TRUE(error.IsSuccess());
+
+                VERIFY_IS_TRUE(ReadFile(destinationFile) == expected);
+            }
+
+            size_t GetFileCount() const
+            {
+                return Directory::GetFiles(root_).size();
+            }
+
+            wstring root_;
+            uint joinFileBufferSizeInKB_;
+        };
+
+        BOOST_FIXTURE_TEST_SUITE2(FileStoreServiceUtilityTestSuite, UtilityTest)
+
+        BOOST_AUTO_TEST_CASE(JoinFilesEmptyTest)
+        {
+            JoinAndVerify({});
+            JoinAndVerify({ 0 });
+            JoinAndVerify({ 0, 100, 0 });
+        }
+
+        BOOST_AUTO_TEST_CASE(JoinFilesMultipleBlocksTest)
+        {
+            FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB = 4;
+
+            // Whole blocks, chunks spanning several blocks and more chunks than blocks
+            JoinAndVerify({ 4096, 4096 });
+            JoinAndVerify({ 3 * 4096, 2 * 4096 + 1 });
+            JoinAndVerify({ 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 });
+
+            // The block size is rounded down to the alignment
+            FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB = 7;
+            JoinAndVerify({ 5 * 4096 + 17, 7 * 1024 });
+        }
+
+        BOOST_AUTO_TEST_CASE(JoinFilesUnalignedTailTest)
+        {
+            FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB = 4;
+
+            JoinAndVerify({ 1 });
+            JoinAndVerify({ 4095 });
+            JoinAndVerify({ 4097 });
+            JoinAndVerify({ 1, 4095, 4097, 123 });
+        }
+
+        BOOST_AUTO_TEST_CASE(JoinFilesSizeChangeTest)
+        {
+            FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB = 4;
+
+            vector<wstring> sourceFiles = { Path::Combine(root_, L"chunk0"), Path::Combine(root_, L"chunk1") };
+            WriteFile(sourceFiles[0], CreateContent(5000, 0));
+            WriteFile(sourceFiles[1], CreateContent(300, 1));
+
+            auto destinationFile = Path::Combine(root_, L"joined");
+
+            // The sizes are taken before the sources are read, so a chunk that grew or
+            // shrank in the meantime no longer adds up to the size that was taken
+            //
+            VERIFY_IS_FALSE(Utility::JoinFiles(sourceFiles, 5301, destinationFile).IsSuccess());
+            VERIFY_IS_FALSE(File::Exists(destinationFile));
+
+            VERIFY_IS_FALSE(Utility::JoinFiles(sourceFiles, 5299, destinationFile).IsSuccess());
+            VERIFY_IS_FALSE(File::Exists(destinationFile));
+
+            VERIFY_IS_TRUE(Utility::JoinFiles(sourceFiles, 5300, destinationFile).IsSuccess());
+            VERIFY_IS_TRUE(File::Exists(destinationFile));
+
+            // A chunk that disappeared
+            VERIFY_IS_TRUE(File::Delete2(sourceFiles[1], true).IsSuccess());
+            VERIFY_IS_FALSE(Utility::JoinFiles(sourceFiles, 5300, destinationFile).IsSuccess());
+            VERIFY_IS_FALSE(File::Exists(destinationFile));
+        }
+
+        BOOST_AUTO_TEST_CASE(IsFileCompleteTest)
+        {
+            auto filePath = Path::Combine(root_, L"file");
+
+            VERIFY_IS_FALSE(Utility::IsFileComplete(filePath, 100));
+
+            WriteFile(filePath, CreateContent(100, 0));
+            VERIFY_IS_TRUE(Utility::IsFileComplete(filePath, 100));
+            VERIFY_IS_TRUE(Utility::IsFileComplete(filePath, FileMetadata::UnknownFileSize));
+
+            // An incomplete file is deleted so that it is copied again
+            VERIFY_IS_FALSE(Utility::IsFileComplete(filePath, 101));
+            VERIFY_IS_FALSE(File::Exists(filePath));
+        }
+
+        BOOST_AUTO_TEST_CASE(CopyThroughTempFileTest)
+        {
+            auto destinationPath = Path::Combine(root_, L"destination");
+            auto original = CreateContent(100, 0);
+            auto updated = CreateContent(200, 1);
+            WriteFile(destinationPath, original);
+
+            // A failed copy leaves neither a partial file at the destination nor the temporary file
+            //
+            auto error = Utility::CopyThroughTempFile(destinationPath, [&](wstring const & tempPath)
+            {
+                WriteFile(tempPath, CreateContent(50, 1));
+                return ErrorCode(ErrorCodeValue::OperationFailed);
+            });
+
+            VERIFY_IS_TRUE(error.IsError(ErrorCodeValue::OperationFailed));
+            VERIFY_IS_TRUE(ReadFile(destinationPath) == original);
+            VERIFY_ARE_EQUAL2(GetFileCount(), 1u);
+
+            error = Utility::CopyThroughTempFile(destinationPath, [&](wstring const & tempPath)
+            {
+                VERIFY_ARE_NOT_EQUAL(tempPath, destinationPath);
+                WriteFile(tempPath, updated);
+                return ErrorCode::Success();
+            });
+
+            VERIFY_IS_TRUE(error.IsSuccess());
+            VERIFY_IS_TRUE(ReadFile(destinationPath) == updated);
+            VERIFY_ARE_EQUAL2(GetFileCount(), 1u);
+        }
+
+        BOOST_AUTO_TEST_CASE(IsBuildCompletedTest)
+        {
+            auto storeLocation = Path::Combine(root_, L"secondary");
+            auto localRoot = Path::Combine(root_, L"local");
+            VERIFY_IS_TRUE(Directory::Create2(storeLocation).IsSuccess());
+            VERIFY_IS_TRUE(Directory::Create2(localRoot).IsSuccess());
+
+            auto copyFile = [](wstring const & sourcePath, wstring const & destinationPath)
+            {
+                return File::Copy(sourcePath, destinationPath, true);
+            };
+
+            VERIFY_IS_FALSE(Utility::IsBuildCompleted(storeLocation, localRoot, copyFile));
+
+            VERIFY_IS_TRUE(File::Touch(Path::Combine(storeLocation, Constants::BuildCompletedMarkerFileName)).IsSuccess());
+            VERIFY_IS_TRUE(Utility::IsBuildCompleted(storeLocation, localRoot, copyFile));
+
+            // The local copy of the marker is not left behind
+            VERIFY_IS_TRUE(Directory::GetFiles(localRoot).empty());
+        }
+
+        BOOST_AUTO_TEST_CASE(TryCopyFromStoreLocationsTest)
+        {
+            auto relativePath = L"file";
+            StoreFileVersion version(1, 1, 1);
+            auto content = CreateContent(1000, 0);
+
+            auto primary = Path::Combine(root_, L"primary");
+            auto missing = Path::Combine(root_, L"missing");
+            auto incomplete = Path::Combine(root_, L"incomplete");
+            VERIFY_IS_TRUE(Directory::Create2(missing).IsSuccess());
+            WriteFile(Utility::GetVersionedFileFullPath(primary, relativePath, version), content);
+            WriteFile(Utility::GetVersionedFileFullPath(incomplete, relativePath, version), CreateContent(500, 0));
+
+            auto destination = Path::Combine(root_, L"destination");
+
+            vector<wstring> sources;
+            auto copyFile = [&sources](wstring const & sourcePath, wstring const & destinationPath)
+            {
+                sources.push_back(sourcePath);
+                return File::Copy(sourcePath, destinationPath, true);
+            };
+
+            // A secondary without the file is skipped and the size mismatch of an incomplete copy
+            // is a failure. Both fall through to the next replica, which has the complete file.
+            //
+            bool isCopyFailed = false;
+            VERIFY_IS_TRUE(Utility::TryCopyFromStoreLocations(
+                { missing, incomplete, primary },
+                primary,
+                relativePath,
+                version,
+                static_cast<int64>(content.size()),
+                destination,
+                copyFile,
+                isCopyFailed));
+            VERIFY_IS_TRUE(isCopyFailed);
+            VERIFY_ARE_EQUAL2(sources.size(), 3u);
+            VERIFY_IS_TRUE(ReadFile(destination) == content);
+
+            // The incomplete copy is deleted rather than kept as the destination
+            //
+            VERIFY_IS_TRUE(File::Delete2(destination, true).IsSuccess());
+            VERIFY_IS_FALSE(Utility::TryCopyFromStoreLocations(
+                { incomplete },
+                primary,
+                relativePath,
+                version,
+                static_cast<int64>(content.size()),
+                destination,
+                copyFile,
+                isCopyFailed));
+            VERIFY_IS_TRUE(isCopyFailed);
+            VERIFY_IS_FALSE(File::Exists(destination));
+
+            // Secondaries without the file are not failures
+            //
+            VERIFY_IS_FALSE(Utility::TryCopyFromStoreLocations(
+                { missing },
+                primary,
+                relativePath,
+                version,
+                static_cast<int64>(content.size()),
+                destination,
+                copyFile,
+                isCopyFailed));
+            VERIFY_IS_FALSE(isCopyFailed);
+            VERIFY_IS_FALSE(File::Exists(destination));
+
+            // The primary not having the file is
+            //
+            VERIFY_IS_FALSE(Utility::TryCopyFromStoreLocations(
+                { missing },
+                missing,
+                relativePath,
+                version,
+                static_cast<int64>(content.size()),
+                destination,
+                copyFile,
+                isCopyFailed));
+            VERIFY_IS_TRUE(isCopyFailed);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
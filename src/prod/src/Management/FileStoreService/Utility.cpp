@@ -7,6 +7,7 @@
 #if defined(PLATFORM_UNIX)
 #include <pwd.h>
 #include <grp.h>
+#include <fcntl.h>
 #endif
 
 using namespace std;
@@ -207,6 +208,304 @@ ErrorCode Utility::RetriableOperation(std::function<ErrorCode()> const & operati
     return result;
 }
 
+ErrorCode Utility::JoinFiles(vector<wstring> const & sourceFiles, wstring const & destinationFile)
+{
+    int64 totalSize = 0;
+    for (auto const & sourceFile : sourceFiles)
+    {
+        int64 size = 0;
+        auto error = File::GetSize(sourceFile, size);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(TraceComponent, "JoinFiles: failed to get size of {0}: {1}", sourceFile, error);
+            return error;
+        }
+
+        totalSize += size;
+    }
+
+    return JoinFiles(sourceFiles, totalSize, destinationFile);
+}
+
+ErrorCode Utility::JoinFiles(vector<wstring> const & sourceFiles, int64 totalSize, wstring const & destinationFile)
+{
+    File destination;
+#if defined(PLATFORM_UNIX)
+    {
+        // Reserve the blocks up front so that the file system does not extend the file on every write
+        //
+        string destinationFileA;
+        StringUtility::Utf16ToUtf8(destinationFile, destinationFileA);
+
+        int fd = open(destinationFileA.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd < 0)
+        {
+            auto error = ErrorCode::FromErrno();
+            WriteWarning(TraceComponent, "JoinFiles: failed to create {0}: {1}", destinationFile, error);
+            return error;
+        }
+
+        int result = (totalSize > 0) ? posix_fallocate(fd, 0, totalSize) : 0;
+        close(fd);
+
+        if (result != 0)
+        {
+            // Not all file systems support preallocation, so continue without it
+            WriteInfo(TraceComponent, "JoinFiles: preallocation of {0} bytes for {1} failed: {2}", totalSize, destinationFile, ErrorCode::FromErrno(result));
+        }
+    }
+
+    auto error = destination.TryOpen(destinationFile, FileMode::Open, FileAccess::Write, FileShare::None);
+#else
+    auto error = destination.TryOpen(destinationFile, FileMode::Create, FileAccess::Write, FileShare::None);
+    if (error.IsSuccess() && totalSize > 0)
+    {
+        destination.resize(totalSize);
+        destination.Seek(0, SeekOrigin::Begin);
+    }
+#endif
+
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceComponent, "JoinFiles: failed to open {0}: {1}", destinationFile, error);
+        File::Delete2(destinationFile, true /*deleteReadOnlyFiles*/);
+        return error;
+    }
+
+    // Sources are packed into full blocks so that every write except the last one
+    // is a whole block at a block aligned offset in the destination
+    //
+    size_t const alignment = 4096;
+    size_t bufferSize = static_cast<size_t>(FileStoreServiceConfig::GetConfig().JoinFileBufferSizeInKB) * 1024;
+    bufferSize = max(alignment, (bufferSize / alignment) * alignment);
+
+    vector<BYTE> buffer(bufferSize);
+    size_t bufferedBytes = 0;
+    int64 writtenBytes = 0;
+
+    auto flush = [&]() -> ErrorCode
+    {
+        DWORD bytesWritten = 0;
+        auto error = destination.TryWrite2(buffer.data(), static_cast<int>(bufferedBytes), bytesWritten);
+        if (error.IsSuccess() && bytesWritten != bufferedBytes)
+        {
+            error = ErrorCodeValue::OperationFailed;
+        }
+
+        writtenBytes += bytesWritten;
+        bufferedBytes = 0;
+
+        return error;
+    };
+
+    for (auto it = sourceFiles.begin(); it != sourceFiles.end() && error.IsSuccess(); ++it)
+    {
+        File source;
+        error = source.TryOpen(*it, FileMode::Open, FileAccess::Read, FileShare::Read);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(TraceComponent, "JoinFiles: failed to open {0}: {1}", *it, error);
+            break;
+        }
+
+        while (error.IsSuccess())
+        {
+            DWORD bytesRead = 0;
+            error = source.TryRead2(buffer.data() + bufferedBytes, static_cast<int>(bufferSize - bufferedBytes), bytesRead);
+            if (!error.IsSuccess() || bytesRead == 0)
+            {
+                break;
+            }
+
+            bufferedBytes += bytesRead;
+
+            if (bufferedBytes == bufferSize)
+            {
+                error = flush();
+            }
+        }
+
+        source.Close2();
+    }
+
+    if (error.IsSuccess() && bufferedBytes > 0)
+    {
+        error = flush();
+    }
+
+    if (error.IsSuccess() && writtenBytes != totalSize)
+    {
+        // A chunk changed size while it was being joined
+        error = ErrorCodeValue::OperationFailed;
+    }
+
+    destination.Close2();
+
+    if (!error.IsSuccess())
+    {
+        File::Delete2(destinationFile, true /*deleteReadOnlyFiles*/);
+    }
+
+    WriteTrace(
+        error.ToLogLevel(),
+        TraceComponent,
+        "JoinFiles: joined {0} files into {1}: size={2} written={3} error={4}",
+        sourceFiles.size(),
+        destinationFile,
+        totalSize,
+        writtenBytes,
+        error);
+
+    return error;
+}
+
+bool Utility::IsFileComplete(wstring const & filePath, int64 expectedSize)
+{
+    if (!File::Exists(filePath))
+    {
+        return false;
+    }
+
+    // Metadata written by older versions does not record the size. Copies are only
+    // moved into place once they complete, so the file is trusted in that case.
+    //
+    if (expectedSize == FileMetadata::UnknownFileSize)
+    {
+        return true;
+    }
+
+    int64 fileSize = 0;
+    auto error = File::GetSize(filePath, fileSize);
+    if (error.IsSuccess() && fileSize == expectedSize)
+    {
+        return true;
+    }
+
+    WriteWarning(
+        TraceComponent,
+        "Deleting incomplete file. Path:{0}, Size:{1}, ExpectedSize:{2}, Error:{3}",
+        filePath,
+        fileSize,
+        expectedSize,
+        error);
+
+    File::Delete2(filePath, true /*deleteReadOnlyFiles*/).ReadValue();
+
+    return false;
+}
+
+ErrorCode Utility::CopyThroughTempFile(
+    wstring const & destinationPath,
+    function<ErrorCode(wstring const & tempPath)> const & copy)
+{
+    auto tempPath = File::GetTempFileName(Path::GetDirectoryName(destinationPath));
+
+    auto error = copy(tempPath);
+    if (error.IsSuccess())
+    {
+        error = File::MoveTransacted(tempPath, destinationPath, true /*overwrite*/);
+    }
+
+    if (!error.IsSuccess() && File::Exists(tempPath))
+    {
+        File::Delete2(tempPath, true /*deleteReadOnlyFiles*/).ReadValue();
+    }
+
+    return error;
+}
+
+bool Utility::IsBuildCompleted(
+    wstring const & storeLocation,
+    wstring const & localRoot,
+    CopyFileCallback const & copyFile)
+{
+    // The copy context can only copy files from other replicas, so check for
+    // the marker by copying it
+    //
+    auto localMarkerCopy = File::GetTempFileName(localRoot);
+
+    auto error = copyFile(Path::Combine(storeLocation, Constants::BuildCompletedMarkerFileName), localMarkerCopy);
+
+    if (File::Exists(localMarkerCopy))
+    {
+        File::Delete2(localMarkerCopy, true /*deleteReadOnlyFiles*/).ReadValue();
+    }
+
+    return error.IsSuccess();
+}
+
+bool Utility::TryCopyFromStoreLocations(
+    vector<wstring> const & storeLocations,
+    wstring const & primaryStoreLocation,
+    wstring const & relativeFilePath,
+    StoreFileVersion const version,
+    int64 fileSize,
+    wstring const & destinationFilePath,
+    CopyFileCallback const & copyFile,
+    __out bool & isCopyFailed)
+{
+    isCopyFailed = false;
+
+    for (auto const & storeLocation : storeLocations)
+    {
+        auto sourceFilePath = GetVersionedFileFullPath(storeLocation, relativeFilePath, version);
+
+        auto error = copyFile(sourceFilePath, destinationFilePath);
+
+        if (error.IsSuccess() && !IsFileComplete(destinationFilePath, fileSize))
+        {
+            // The source replica has an incomplete copy of the file
+            error = ErrorCodeValue::OperationFailed;
+        }
+
+        if (error.IsSuccess())
+        {
+            // TODO: Demote to noise when Image Store Service stabilizes
+            WriteInfo(
+                TraceComponent,
+                "CopyFile succeeded: current src={0} dest={1}",
+                sourceFilePath,
+                destinationFilePath);
+
+            return true;
+        }
+
+        // A secondary is not guaranteed to have the file even once its build has completed,
+        // since it may not have processed the replication of the file yet. Only the primary
+        // not having the file is a failure.
+        //
+        if (storeLocation != primaryStoreLocation && IsFileNotFoundError(error))
+        {
+            WriteInfo(
+                TraceComponent,
+                "CopyFile skipped replica without the file: current src={0} dest={1} error={2}",
+                sourceFilePath,
+                destinationFilePath,
+                error);
+
+            continue;
+        }
+
+        isCopyFailed = true;
+
+        WriteInfo(
+            TraceComponent,
+            "CopyFile failed: current src={0} dest={1} error={2}",
+            sourceFilePath,
+            destinationFilePath,
+            error);
+    }
+
+    return false;
+}
+
+bool Utility::IsFileNotFoundError(ErrorCode const & error)
+{
+    return error.IsError(ErrorCodeValue::FileNotFound) ||
+        error.IsWin32Error(ERROR_FILE_NOT_FOUND) ||
+        error.IsWin32Error(ERROR_PATH_NOT_FOUND);
+}
+
 ErrorCode Utility::GetPrimaryAccessToken(__inout Common::AccessTokenSPtr & primaryAccessToken)
 {
     return GetAccessToken(
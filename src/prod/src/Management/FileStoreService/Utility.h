@@ -13,6 +13,10 @@ namespace Management
         using AccessTokensCollection = std::map<std::wstring, Common::AccessTokenSPtr>;
         using AccessTokensList = std::vector<Common::AccessTokenSPtr>;
 
+        using CopyFileCallback = std::function<Common::ErrorCode(
+            std::wstring const & sourcePath,
+            std::wstring const & destinationPath)>;
+
         class Utility
             : private Common::TextTraceComponent<Common::TraceTaskCodes::FileStoreService>
         {
@@ -32,6 +36,44 @@ namespace Management
 
             static Common::ErrorCode RetriableOperation(std::function<Common::ErrorCode()> const & operation, uint const maxRetryCount);
 
+            // Concatenates the source files into the destination file. The destination is preallocated to the
+            // total size and written in blocks of JoinFileBufferSizeInKB regardless of the source file sizes.
+            static Common::ErrorCode JoinFiles(std::vector<std::wstring> const & sourceFiles, std::wstring const & destinationFile);
+
+            // Same as above, with the total size of the source files taken by the caller. Fails if the
+            // sources no longer add up to that size by the time they are read.
+            static Common::ErrorCode JoinFiles(std::vector<std::wstring> const & sourceFiles, int64 totalSize, std::wstring const & destinationFile);
+
+            // Deletes the file if its size does not match the expected size. Any existing file is
+            // complete if the expected size is FileMetadata::UnknownFileSize.
+            static bool IsFileComplete(std::wstring const & filePath, int64 expectedSize);
+
+            // Copies to a temporary file in the destination directory and moves it into place once the
+            // copy succeeds, so that a failed copy never leaves a partial file at the destination.
+            static Common::ErrorCode CopyThroughTempFile(
+                std::wstring const & destinationPath,
+                std::function<Common::ErrorCode(std::wstring const & tempPath)> const & copy);
+
+            // Checks for the build completed marker of the store at storeLocation by copying it
+            // to a temporary file under localRoot.
+            static bool IsBuildCompleted(
+                std::wstring const & storeLocation,
+                std::wstring const & localRoot,
+                CopyFileCallback const & copyFile);
+
+            // Copies the versioned file from the first store location, in order, that has a complete copy of it.
+            // A location other than the primary that does not have the file is skipped. isCopyFailed is set
+            // if any other copy failed.
+            static bool TryCopyFromStoreLocations(
+                std::vector<std::wstring> const & storeLocations,
+                std::wstring const & primaryStoreLocation,
+                std::wstring const & relativeFilePath,
+                StoreFileVersion const version,
+                int64 fileSize,
+                std::wstring const & destinationFilePath,
+                CopyFileCallback const & copyFile,
+                __out bool & isCopyFailed);
+
             // tokenMap is the full list, while newTokens contains the values which are not in the original tokenMap
             static Common::ErrorCode GetAccessTokens(
                 __inout AccessTokensCollection & tokenMap,
@@ -52,6 +94,8 @@ namespace Management
 
         private:
 
+            static bool IsFileNotFoundError(Common::ErrorCode const & error);
+
             class CommonNameConfig
             {
 
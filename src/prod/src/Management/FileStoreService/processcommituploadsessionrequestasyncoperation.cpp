@@ -4,7 +4,6 @@
 // ------------------------------------------------------------
 
 #include "stdafx.h"
-#include <fstream>
 
 using namespace std;
 using namespace Common;
@@ -97,35 +96,21 @@ private:
         AsyncOperationSPtr const & parent)
     {
         this->joinedFileName_ = Path::Combine(this->requestManager_.get_LocalStagingLocation(), Common::Guid::NewGuid().ToString());
-        ofstream joinedFile;
-#if !defined(PLATFORM_UNIX)
-        joinedFile.open(this->joinedFileName_ , ios::out | ios::binary | ios::app);
-#else
-        std::string joinedFileName(this->joinedFileName_.begin(), this->joinedFileName_.end());
-        joinedFile.open(joinedFileName.c_str(), ios::out | ios::binary | ios::app);
-#endif
-        if (joinedFile.is_open())
-        {     
-            for (auto it = sortedStagingLocation.begin(); it != sortedStagingLocation.end(); ++it)
-            {
-                ifstream chunkStream;
-                string chunkName((*it).begin(), (*it).end());
-                chunkStream.open(chunkName, ios::in | ios::binary);
-                if (chunkStream.is_open())
-                {
-                    chunkStream.seekg(0, ios::end);
-                    uint64 size = chunkStream.tellg();
-                    chunkStream.seekg(ios::beg);
-                    char *chunkBuffer = new char[size];
-                    chunkStream.read(chunkBuffer, size);
-                    joinedFile.write(chunkBuffer, size);
-                    delete(chunkBuffer);
-                    chunkStream.close();
-                }
-            }
+
+        auto error = Utility::JoinFiles(sortedStagingLocation, this->joinedFileName_);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(
+                TraceComponent,
+                "{0}: failed to join {1} chunks of upload session {2}: {3}",
+                this->activityId_,
+                sortedStagingLocation.size(),
+                this->sessionId_,
+                error);
+
+            return AsyncOperation::CreateAndStart<CompletedAsyncOperation>(error, callback, parent);
         }
 
-        joinedFile.close();
         return AsyncOperation::CreateAndStart<CompletedAsyncOperation>(callback, parent);
     }
 
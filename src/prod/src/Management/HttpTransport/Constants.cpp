@@ -14,6 +14,7 @@ ULONG HttpConstants::DefaultEntityBodyChunkSize = 2048;
 ULONG HttpConstants::MaxEntityBodySize = 4 * 1024 * 1024;
 ULONG HttpConstants::DefaultHeaderBufferSize = 8192;
 ULONG HttpConstants::StatusCodeGone = 410;
+ULONG HttpConstants::MaxPendingResponseBodySize = 256 * 1024;
 
 GlobalWString HttpConstants::HttpUriScheme = make_global<wstring>(L"http");
 GlobalWString HttpConstants::HttpsUriScheme = make_global<wstring>(L"https");
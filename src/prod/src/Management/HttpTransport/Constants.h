@@ -16,6 +16,7 @@ namespace HttpCommon
         static ULONG MaxEntityBodySize; // TODO: This should be allowd to be overridden by settings.xml
         static ULONG DefaultHeaderBufferSize;
         static ULONG StatusCodeGone;
+        static ULONG MaxPendingResponseBodySize;
 
         static Common::GlobalWString HttpUriScheme;
         static Common::GlobalWString HttpsUriScheme;
@@ -32,6 +32,7 @@
 #else
 #include "requestmessagecontext.linux.h"
 #include "RequestMessageContext.SendResponseAsyncOperation.Linux.h"
+#include "RequestMessageContext.SendResponseChunkAsyncOperation.Linux.h"
 #include "requestmessagecontext.getfilefromuploadasyncoperation.linux.h"
 #include "SimpleHttpServer.h"
 #include "HttpServer.LinuxAsyncServiceBaseOperation.h"
@@ -204,6 +204,37 @@ namespace HttpServer
 
         virtual Common::ErrorCode EndSendResponse(
             __in Common::AsyncOperationSPtr const& operation) = 0;
+
+        //
+        // Chunked responses. BeginSendResponseHeaders starts a response whose body is sent with chunked
+        // transfer encoding, and each BeginSendResponseChunk appends the given buffer to that body. A chunk
+        // completes once the body data that is not yet written to the socket is below
+        // HttpConstants::MaxPendingResponseBodySize, so a slow client throttles the sender. A chunk that
+        // cannot drain within the timeout completes with Timeout and aborts the response.
+        //
+        // Once the headers are sent the status cannot change, so a sender that fails part way through the
+        // body calls AbortResponse. The connection is dropped without ending the chunked body, and the
+        // client sees a failed request instead of a truncated success.
+        //
+        virtual Common::AsyncOperationSPtr BeginSendResponseHeaders(
+            __in Common::ErrorCode operationStatus,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) = 0;
+
+        virtual Common::ErrorCode EndSendResponseHeaders(
+            __in Common::AsyncOperationSPtr const& operation) = 0;
+
+        virtual Common::AsyncOperationSPtr BeginSendResponseChunk(
+            __in Common::ByteBufferUPtr chunk,
+            __in bool isLastSegment,
+            __in Common::TimeSpan const& timeout,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent) = 0;
+
+        virtual Common::ErrorCode EndSendResponseChunk(
+            __in Common::AsyncOperationSPtr const& operation) = 0;
+
+        virtual void AbortResponse(__in Common::ErrorCode const& error) = 0;
     };
 #endif
 
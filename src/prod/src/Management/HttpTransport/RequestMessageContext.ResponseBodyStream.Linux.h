@@ -0,0 +1,65 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#include "cpprest/producerconsumerstream.h"
+
+namespace HttpServer
+{
+    //
+    // The body of a chunked response. The chunks are queued in the producer consumer buffer, and the http
+    // listener reads them from the other end of the buffer as it writes them to the socket. Since the
+    // response has no content length, the listener sends the body with chunked transfer encoding.
+    //
+    // This is only included by the translation units that use cpprest.
+    //
+    class RequestMessageContext::ResponseBodyStream
+    {
+        DENY_COPY(ResponseBodyStream)
+
+    public:
+        ResponseBodyStream()
+            : Buffer()
+            , ReplyTask()
+            , isFailed_(false)
+        {
+        }
+
+        __declspec(property(get=get_IsFailed)) bool IsFailed;
+        bool get_IsFailed() const { return isFailed_.load(); }
+
+        void SetFailed() { isFailed_.store(true); }
+
+        //
+        // Closes the write end with an exception instead of ending the body. The listener fails the
+        // reply and drops the connection without sending the terminating chunk, so the client sees an
+        // incomplete response rather than a truncated body that looks complete.
+        //
+        void Abort(std::exception_ptr const & eptr)
+        {
+            SetFailed();
+            Buffer.close(std::ios_base::out, eptr).then([](pplx::task<void> t)
+            {
+                try
+                {
+                    t.get();
+                }
+                catch (...)
+                {
+                    // The stream is being abandoned, so there is nothing left to report
+                }
+            });
+        }
+
+        concurrency::streams::producer_consumer_buffer<uint8_t> Buffer;
+
+        // Completes when the whole response has been written to the socket
+        pplx::task<void> ReplyTask;
+
+    private:
+        Common::atomic_bool isFailed_;
+    };
+}
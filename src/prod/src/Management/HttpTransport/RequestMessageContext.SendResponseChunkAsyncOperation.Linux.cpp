@@ -0,0 +1,173 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "cpprest/json.h"
+#include "cpprest/http_listener.h"
+#include "cpprest/uri.h"
+#include "cpprest/asyncrt_utils.h"
+#include "RequestMessageContext.ResponseBodyStream.Linux.h"
+
+using namespace std;
+using namespace Common;
+using namespace HttpServer;
+using namespace HttpCommon;
+
+StringLiteral const TraceType("HttpRequestSendResponseChunk");
+
+// The producer consumer buffer does not signal when the listener has read from it, so the amount of
+// pending body data is polled at this interval while the client is slower than the sender.
+static TimeSpan const PendingDataPollInterval = TimeSpan::FromMilliseconds(10);
+
+RequestMessageContext::SendResponseChunkAsyncOperation::SendResponseChunkAsyncOperation(
+    Common::ByteBufferUPtr chunkUPtr,
+    bool isLastSegment,
+    TimeSpan const & timeout,
+    RequestMessageContext & messageContext,
+    Common::AsyncCallback const & callback,
+    Common::AsyncOperationSPtr const & parent)
+    : Common::AsyncOperation(callback, parent)
+    , messageContext_(messageContext)
+    , responseBodyStream_(messageContext.responseBodyStream_)
+    , chunkUPtr_(move(chunkUPtr))
+    , isLastSegment_(isLastSegment)
+    , timeoutHelper_(timeout)
+{
+}
+
+void RequestMessageContext::SendResponseChunkAsyncOperation::OnStart(AsyncOperationSPtr const& thisSPtr)
+{
+    if (!responseBodyStream_)
+    {
+        WriteWarning(TraceType, "Response headers were not sent before the response chunk. ClientRequestId: {0}", messageContext_.GetClientRequestId());
+        TryComplete(thisSPtr, ErrorCodeValue::InvalidState);
+        return;
+    }
+
+    if (responseBodyStream_->IsFailed)
+    {
+        TryComplete(thisSPtr, ErrorCodeValue::OperationFailed);
+        return;
+    }
+
+    if (!chunkUPtr_ || chunkUPtr_->empty())
+    {
+        OnChunkQueued(thisSPtr);
+        return;
+    }
+
+    // The chunk is owned by this operation, so it stays valid until the buffer has taken it.
+    responseBodyStream_->Buffer.putn_nocopy(chunkUPtr_->data(), chunkUPtr_->size()).then([this, thisSPtr](pplx::task<size_t> t)
+    {
+        try
+        {
+            t.get();
+        }
+        catch (...)
+        {
+            auto eptr = std::current_exception();
+            RequestMessageContext::HandleException(eptr, messageContext_.GetClientRequestId());
+            responseBodyStream_->SetFailed();
+            TryComplete(thisSPtr, ErrorCodeValue::OperationFailed);
+            return;
+        }
+
+        chunkUPtr_.reset();
+        OnChunkQueued(thisSPtr);
+    });
+}
+
+void RequestMessageContext::SendResponseChunkAsyncOperation::OnChunkQueued(AsyncOperationSPtr const& thisSPtr)
+{
+    if (!isLastSegment_)
+    {
+        WaitForPendingData(thisSPtr);
+        return;
+    }
+
+    // Closing the write end lets the listener finish the chunked body; the reply task completes
+    // once the remaining data has been written to the socket.
+    auto responseBodyStream = responseBodyStream_;
+    responseBodyStream_->Buffer.close(std::ios_base::out).then([this, thisSPtr, responseBodyStream](pplx::task<void> closeTask)
+    {
+        try
+        {
+            closeTask.get();
+        }
+        catch (...)
+        {
+            auto eptr = std::current_exception();
+            RequestMessageContext::HandleException(eptr, messageContext_.GetClientRequestId());
+            responseBodyStream->SetFailed();
+        }
+
+        responseBodyStream->ReplyTask.then([this, thisSPtr, responseBodyStream](pplx::task<void>)
+        {
+            TryComplete(thisSPtr, responseBodyStream->IsFailed ? ErrorCodeValue::OperationFailed : ErrorCodeValue::Success);
+        });
+    });
+}
+
+void RequestMessageContext::SendResponseChunkAsyncOperation::WaitForPendingData(AsyncOperationSPtr const& thisSPtr)
+{
+    // Cancel has already completed the operation and aborted the response
+    if (this->IsCancelRequested || this->InternalIsCompleted)
+    {
+        return;
+    }
+
+    if (responseBodyStream_->IsFailed)
+    {
+        TryComplete(thisSPtr, ErrorCodeValue::OperationFailed);
+        return;
+    }
+
+    if (responseBodyStream_->Buffer.in_avail() <= HttpConstants::MaxPendingResponseBodySize)
+    {
+        TryComplete(thisSPtr, ErrorCodeValue::Success);
+        return;
+    }
+
+    if (timeoutHelper_.IsExpired)
+    {
+        // The client has stopped reading. Waiting longer would keep the serialized body and the
+        // request alive for as long as the connection stays open.
+        WriteWarning(
+            TraceType,
+            "Pending response body data did not drain within {0}. ClientRequestId: {1}",
+            timeoutHelper_.OriginalTimeout,
+            messageContext_.GetClientRequestId());
+
+        AbortResponse(ErrorCodeValue::Timeout);
+        TryComplete(thisSPtr, ErrorCodeValue::Timeout);
+        return;
+    }
+
+    Threadpool::Post([this, thisSPtr]() { WaitForPendingData(thisSPtr); }, PendingDataPollInterval);
+}
+
+void RequestMessageContext::SendResponseChunkAsyncOperation::AbortResponse(ErrorCode const& error)
+{
+    if (responseBodyStream_)
+    {
+        messageContext_.AbortResponse(error);
+    }
+}
+
+void RequestMessageContext::SendResponseChunkAsyncOperation::OnCancel()
+{
+    WriteInfo(TraceType, "Cancellation requested for http_request chunk. ClientRequestId: {0}", messageContext_.GetClientRequestId());
+
+    // The operation completes with OperationCanceled once this returns. The rest of the body will not
+    // be sent, so the response is aborted rather than ended; this also stops the pending data poll.
+    AbortResponse(ErrorCodeValue::OperationCanceled);
+}
+
+ErrorCode RequestMessageContext::SendResponseChunkAsyncOperation::End(__in Common::AsyncOperationSPtr const& thisSPtr)
+{
+    auto operation = AsyncOperation::End<SendResponseChunkAsyncOperation>(thisSPtr);
+    return operation->Error;
+}
@@ -0,0 +1,45 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpServer
+{
+    class RequestMessageContext::SendResponseChunkAsyncOperation
+        : public Common::AsyncOperation
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::HttpGateway>
+    {
+        DENY_COPY(SendResponseChunkAsyncOperation);
+
+    public:
+
+        SendResponseChunkAsyncOperation(
+            Common::ByteBufferUPtr chunkUPtr,
+            bool isLastSegment,
+            Common::TimeSpan const & timeout,
+            RequestMessageContext & messageContext,
+            Common::AsyncCallback const & callback,
+            Common::AsyncOperationSPtr const & parent);
+
+        static Common::ErrorCode End(__in Common::AsyncOperationSPtr const & asyncOperation);
+
+    protected:
+
+        void OnStart(Common::AsyncOperationSPtr const& thisSPtr);
+        void OnCancel();
+
+    private:
+
+        void OnChunkQueued(Common::AsyncOperationSPtr const& thisSPtr);
+        void WaitForPendingData(Common::AsyncOperationSPtr const& thisSPtr);
+        void AbortResponse(Common::ErrorCode const& error);
+
+        RequestMessageContext & messageContext_;
+        std::shared_ptr<ResponseBodyStream> responseBodyStream_;
+        Common::ByteBufferUPtr chunkUPtr_;
+        bool isLastSegment_;
+        Common::TimeoutHelper timeoutHelper_;
+    };
+}
@@ -10,6 +10,7 @@
 #include "cpprest/uri.h"
 #include "cpprest/asyncrt_utils.h"
 #include "requestmessagecontext.linux.h"
+#include "RequestMessageContext.ResponseBodyStream.Linux.h"
 #include "Common/CryptoUtility.Linux.h"
 
 using namespace Common;
@@ -171,6 +172,78 @@ ErrorCode RequestMessageContext::EndSendResponse(
     return SendResponseAsyncOperation::End(operation);
 }
 
+AsyncOperationSPtr RequestMessageContext::BeginSendResponseHeaders(
+    __in ErrorCode operationStatus,
+    __in Common::AsyncCallback const& callback,
+    __in Common::AsyncOperationSPtr const& parent)
+{
+    USHORT httpStatus;
+    wstring httpStatusLine;
+    HttpCommon::HttpUtil::ErrorCodeToHttpStatus(operationStatus.ReadValue(), httpStatus, httpStatusLine);
+
+    string reasonPhrase;
+    StringUtility::Utf16ToUtf8(httpStatusLine, reasonPhrase);
+    responseUPtr_->set_status_code(httpStatus);
+    responseUPtr_->set_reason_phrase(reasonPhrase);
+
+    // The body stream has no length, so the listener writes the body with chunked transfer
+    // encoding as the chunks are added to the stream.
+    responseBodyStream_ = make_shared<ResponseBodyStream>();
+    responseUPtr_->set_body(responseBodyStream_->Buffer.create_istream(), responseUPtr_->headers().content_type());
+
+    auto responseBodyStream = responseBodyStream_;
+    auto clientRequestId = clientRequestId_;
+    responseBodyStream_->ReplyTask = requestUPtr_->reply(*responseUPtr_).then([responseBodyStream, clientRequestId](pplx::task<void> t)
+    {
+        try
+        {
+            t.get();
+        }
+        catch (...)
+        {
+            auto eptr = std::current_exception();
+            RequestMessageContext::HandleException(eptr, clientRequestId);
+            responseBodyStream->SetFailed();
+        }
+    });
+
+    return AsyncOperation::CreateAndStart<CompletedAsyncOperation>(callback, parent);
+}
+
+ErrorCode RequestMessageContext::EndSendResponseHeaders(
+    __in AsyncOperationSPtr const& operation)
+{
+    return CompletedAsyncOperation::End(operation);
+}
+
+AsyncOperationSPtr RequestMessageContext::BeginSendResponseChunk(
+    __in ByteBufferUPtr chunkUPtr,
+    __in bool isLastSegment,
+    __in TimeSpan const& timeout,
+    __in Common::AsyncCallback const& callback,
+    __in Common::AsyncOperationSPtr const& parent)
+{
+    return AsyncOperation::CreateAndStart<SendResponseChunkAsyncOperation>(move(chunkUPtr), isLastSegment, timeout, *this, callback, parent);
+}
+
+ErrorCode RequestMessageContext::EndSendResponseChunk(
+    __in AsyncOperationSPtr const& operation)
+{
+    return SendResponseChunkAsyncOperation::End(operation);
+}
+
+void RequestMessageContext::AbortResponse(__in ErrorCode const& error)
+{
+    if (!responseBodyStream_)
+    {
+        return;
+    }
+
+    Trace.WriteWarning(TraceType, "Aborting chunked response with {0}. Client Request Id : {1}", error, clientRequestId_);
+
+    responseBodyStream_->Abort(std::make_exception_ptr(std::runtime_error(StringUtility::Utf16ToUtf8(error.ErrorCodeValueToString()))));
+}
+
 AsyncOperationSPtr RequestMessageContext::BeginGetMessageBody(
     __in Common::AsyncCallback const& callback,
     __in Common::AsyncOperationSPtr const& parent) const
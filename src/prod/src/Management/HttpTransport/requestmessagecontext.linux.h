@@ -94,6 +94,26 @@ namespace HttpServer
         Common::ErrorCode EndSendResponse(
             __in Common::AsyncOperationSPtr const& operation);
 
+        Common::AsyncOperationSPtr BeginSendResponseHeaders(
+            __in Common::ErrorCode operationStatus,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::ErrorCode EndSendResponseHeaders(
+            __in Common::AsyncOperationSPtr const& operation);
+
+        Common::AsyncOperationSPtr BeginSendResponseChunk(
+            __in Common::ByteBufferUPtr chunk,
+            __in bool isLastSegment,
+            __in Common::TimeSpan const& timeout,
+            __in Common::AsyncCallback const& callback,
+            __in Common::AsyncOperationSPtr const& parent);
+
+        Common::ErrorCode EndSendResponseChunk(
+            __in Common::AsyncOperationSPtr const& operation);
+
+        void AbortResponse(__in Common::ErrorCode const& error);
+
         Common::ErrorCode TryParseRequest();
 
         static void HandleException(std::exception_ptr eptr, std::wstring const& clientRequestId);
@@ -101,6 +121,9 @@ namespace HttpServer
     private:
         class GetFileFromUploadAsyncOperation;
         class SendResponseAsyncOperation;
+        class SendResponseChunkAsyncOperation;
+        class ResponseBodyStream;
+
         std::wstring url_;
         std::wstring suffix_;
         std::wstring verb_;
@@ -108,5 +131,8 @@ namespace HttpServer
 
         httpRequestUPtr requestUPtr_;
         httpResponseUPtr responseUPtr_;
+
+        // Set when the response body is sent with chunked transfer encoding
+        std::shared_ptr<ResponseBodyStream> responseBodyStream_;
     };
 }
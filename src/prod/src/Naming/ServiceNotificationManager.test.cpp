@@ -3975,6 +3975,126 @@ BOOST_AUTO_TEST_CASE(DeleteNotificationTest)
     gateway->Close();
 }
 
+BOOST_AUTO_TEST_CASE(ConnectionMatchingPerfTest, * boost::unit_test::disabled())
+{
+    class MockClientRegistration : public IClientRegistration
+    {
+    public:
+        virtual bool IsSenderStopped() const { return false; }
+    };
+
+    int const groupCount = 10;
+    int const appsPerGroup = 100;
+    int const servicesPerApp = 10;
+    int const partitionsPerService = 10;
+    int const updatedPartitionCount = 1000;
+    int const clientCount = 10000;
+
+    auto getServiceName = [](int group, int app, int service)
+    {
+        return wformatString("fabric:/group{0}/app{1}/svc{2}", group, app, service);
+    };
+
+    NotificationCacheIndex cacheIndex(L"ConnectionMatchingPerfTest");
+
+    vector<ServiceTableEntrySPtr> partitions;
+    int64 version = 1;
+
+    for (auto group=0; group<groupCount; ++group)
+    {
+        for (auto app=0; app<appsPerGroup; ++app)
+        {
+            for (auto service=0; service<servicesPerApp; ++service)
+            {
+                auto serviceName = getServiceName(group, app, service);
+
+                for (auto partition=0; partition<partitionsPerService; ++partition)
+                {
+                    vector<wstring> locations;
+                    locations.push_back(wformatString("endpoint_{0}", version));
+
+                    partitions.push_back(make_shared<ServiceTableEntry>(
+                        ConsistencyUnitId(),
+                        serviceName,
+                        ServiceReplicaSet(false, false, L"", move(locations), version)));
+
+                    ++version;
+                }
+            }
+        }
+    }
+
+    cacheIndex.AddOrUpdateEntries(ActivityId(), partitions);
+
+    // Clients know every version up to this point
+    //
+    auto clientVersions = make_shared<VersionRangeCollection>(1, version);
+
+    map<wstring, size_t> updatedCountsByGroup;
+    map<wstring, size_t> updatedCountsByService;
+
+    for (auto ix=0; ix<updatedPartitionCount; ++ix)
+    {
+        auto const & existing = partitions[(ix * partitions.size()) / updatedPartitionCount + (ix % partitionsPerService)];
+
+        vector<wstring> locations;
+        locations.push_back(wformatString("endpoint_{0}", version));
+
+        auto updated = make_shared<ServiceTableEntry>(
+            existing->ConsistencyUnitId,
+            existing->ServiceName,
+            ServiceReplicaSet(false, false, L"", move(locations), version));
+
+        cacheIndex.AddOrUpdateEntry(ActivityId(), updated);
+
+        ++version;
+
+        ++updatedCountsByGroup[NamingUri(existing->ServiceName).GetParentName().GetParentName().ToString()];
+        ++updatedCountsByService[existing->ServiceName];
+    }
+
+    // Each client has a broad prefix filter on one group and an exact filter
+    // on a service in a different group.
+    //
+    MockClientRegistration clientRegistration;
+    size_t totalMatches = 0;
+
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    for (auto ix=0; ix<clientCount; ++ix)
+    {
+        auto group = ix % groupCount;
+        auto groupName = wformatString("fabric:/group{0}", group);
+        auto serviceName = getServiceName((group + 1) % groupCount, ix % appsPerGroup, ix % servicesPerApp);
+
+        vector<ServiceNotificationFilterSPtr> filters;
+        filters.push_back(make_shared<ServiceNotificationFilter>(NamingUri(groupName), ServiceNotificationFilterFlags::NamePrefix));
+        filters.push_back(make_shared<ServiceNotificationFilter>(NamingUri(serviceName), ServiceNotificationFilterFlags::None));
+
+        auto results = cacheIndex.GetMatches(ActivityId(), clientRegistration, filters, clientVersions);
+
+        auto expected = updatedCountsByGroup[groupName] + updatedCountsByService[serviceName];
+        VERIFY(results.size() == expected, "Client {0}: matches={1} expected={2}", ix, results.size(), expected);
+
+        totalMatches += results.size();
+    }
+
+    stopwatch.Stop();
+
+    Trace.WriteInfo(
+        TraceComponent,
+        "ConnectionMatchingPerfTest: clients={0} partitions={1} updated={2} matches={3} elapsed={4}ms ({5}us/client)",
+        clientCount,
+        partitions.size(),
+        updatedPartitionCount,
+        totalMatches,
+        stopwatch.ElapsedMilliseconds,
+        stopwatch.ElapsedMilliseconds * 1000 / clientCount);
+
+    cacheIndex.Clear();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 void ServiceNotificationManagerTest::DeadlockedClientTest()
@@ -42,6 +42,7 @@
 #include "Reliability/Failover/fm/BasicFailoverReplyMessageBody.h"
 
 #include "Reliability/Failover/fm/ServiceTableRequestMessageBody.h"
+#include "Reliability/Failover/fm/ServiceTableEntryDelta.h"
 #include "Reliability/Failover/fm/ServiceTableUpdateMessageBody.h"
 
 #include "Reliability/Failover/fm/CreateServiceMessageBody.h"
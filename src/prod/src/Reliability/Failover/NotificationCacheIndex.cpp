@@ -40,6 +40,9 @@ public:
     __declspec(property(get=get_IsEmpty)) bool IsEmpty;
     bool get_IsEmpty() const { return cachedEntriesByCuid_.empty(); }
 
+    __declspec(property(get=get_Count)) size_t Count;
+    size_t get_Count() const { return cachedEntriesByCuid_.size(); }
+
     __declspec(property(get=get_CachedEntries)) CachedEntryMap const & CachedEntries;
     CachedEntryMap get_CachedEntries() const { return cachedEntriesByCuid_; }
 
@@ -58,10 +61,12 @@ public:
     CachedServiceTableEntrySPtr AddOrUpdateEntry(
         ActivityId const & activityId,
         ServiceTableEntrySPtr const & entry,
-        __out int64 & previousVersion)
+        __out int64 & previousVersion,
+        __out int64 & previousPrimaryVersion)
     {
         CachedServiceTableEntrySPtr cachedEntry;
         previousVersion = -1;
+        previousPrimaryVersion = -1;
 
         auto findIt = cachedEntriesByCuid_.find(entry->ConsistencyUnitId);
         if (findIt == cachedEntriesByCuid_.end())
@@ -80,6 +85,7 @@ public:
             cachedEntry = findIt->second;
 
             previousVersion = cachedEntry->Version;
+            previousPrimaryVersion = cachedEntry->LastPrimaryVersion;
 
             cachedEntry->UpdateServiceTableEntry(activityId, entry);
         }
@@ -130,6 +136,8 @@ private:
 NotificationCacheIndex::NotificationCacheIndex(wstring const & traceId)
     : traceId_(traceId)
     , indexEntriesByName_()
+    , cachedEntriesByVersion_()
+    , cachedEntriesByPrimaryVersion_()
     , emptyPartitionsByVersion_()
     , allPartitionsByCuid_()
     , lastDeletedEmptyPartitionVersion_(0)
@@ -151,6 +159,8 @@ void NotificationCacheIndex::Clear()
     }
 
     indexEntriesByName_.clear();
+    cachedEntriesByVersion_.clear();
+    cachedEntriesByPrimaryVersion_.clear();
     emptyPartitionsByVersion_.clear();
     allPartitionsByCuid_.clear();
     lastDeletedEmptyPartitionVersion_ = 0;
@@ -187,6 +197,7 @@ CachedServiceTableEntrySPtr NotificationCacheIndex::AddOrUpdateEntry(
     {
         NameIndexEntrySPtr indexEntry;
         int64 previousVersion = 0;
+        int64 previousPrimaryVersion = 0;
 
         auto findIt = indexEntriesByName_.find(uri);
         if (findIt == indexEntriesByName_.end())
@@ -202,7 +213,9 @@ CachedServiceTableEntrySPtr NotificationCacheIndex::AddOrUpdateEntry(
             indexEntry = findIt->second;
         }
 
-        result = indexEntry->AddOrUpdateEntry(activityId, entry, previousVersion);
+        result = indexEntry->AddOrUpdateEntry(activityId, entry, previousVersion, previousPrimaryVersion);
+
+        this->UpdateVersionIndexes(previousVersion, previousPrimaryVersion, result);
 
         this->UpdateVersionMapAndTrimEmptyPartitions(activityId, previousVersion, result);
     }
@@ -226,6 +239,42 @@ MatchedServiceTableEntryMap NotificationCacheIndex::GetMatches(
         filters.size(), 
         (clientVersions ? *clientVersions : VersionRangeCollection()));
 
+    // Re-connecting clients are usually mostly up-to-date, in which case
+    // only the few entries with versions unknown to the client need to be
+    // checked against its filters. Broad prefix filters would otherwise
+    // visit (and discard) every entry under the prefix. Fall back to
+    // matching by name when that is expected to visit fewer entries.
+    // Collecting version candidates stops as soon as there are as many
+    // as name candidates, so a stale client never builds a candidate list
+    // larger than the entries matching by name would visit.
+    //
+    if (clientVersions)
+    {
+        auto nameCandidatesCount = this->GetNameMatchCandidatesCount(filters, numeric_limits<size_t>::max());
+
+        vector<CachedServiceTableEntrySPtr> candidates;
+        if (this->TryGetVersionMatchCandidates(clientVersions, nameCandidatesCount, candidates))
+        {
+            WriteInfo(
+                TraceComponent, 
+                this->TraceId,
+                "{0}: matching by version: candidates={1}",
+                activityId,
+                candidates.size());
+
+            this->GetVersionMatches(activityId, clientRegistration, filters, candidates, clientVersions, results);
+
+            return results;
+        }
+
+        WriteInfo(
+            TraceComponent, 
+            this->TraceId,
+            "{0}: matching by name: candidates={1}",
+            activityId,
+            nameCandidatesCount);
+    }
+
     for (auto const & filter : filters)
     {
         WriteInfo(
@@ -248,6 +297,41 @@ MatchedServiceTableEntryMap NotificationCacheIndex::GetMatches(
     return results;
 }
 
+void NotificationCacheIndex::UpdateVersionIndexes(
+    int64 previousVersion,
+    int64 previousPrimaryVersion,
+    CachedServiceTableEntrySPtr const & updatedEntry)
+{
+    if (previousVersion >= 0)
+    {
+        auto findIt = cachedEntriesByVersion_.find(previousVersion);
+        if (findIt != cachedEntriesByVersion_.end() && findIt->second == updatedEntry)
+        {
+            cachedEntriesByVersion_.erase(findIt);
+        }
+
+        cachedEntriesByPrimaryVersion_.erase(make_pair(previousPrimaryVersion, updatedEntry));
+    }
+
+    cachedEntriesByVersion_[updatedEntry->Version] = updatedEntry;
+
+    if (updatedEntry->Partition->ServiceReplicaSet.IsStateful && updatedEntry->LastPrimaryVersion != updatedEntry->Version)
+    {
+        cachedEntriesByPrimaryVersion_.insert(make_pair(updatedEntry->LastPrimaryVersion, updatedEntry));
+    }
+}
+
+void NotificationCacheIndex::DeleteFromVersionIndexes(CachedServiceTableEntrySPtr const & deletedEntry)
+{
+    auto findIt = cachedEntriesByVersion_.find(deletedEntry->Version);
+    if (findIt != cachedEntriesByVersion_.end() && findIt->second == deletedEntry)
+    {
+        cachedEntriesByVersion_.erase(findIt);
+    }
+
+    cachedEntriesByPrimaryVersion_.erase(make_pair(deletedEntry->LastPrimaryVersion, deletedEntry));
+}
+
 void NotificationCacheIndex::UpdateVersionMapAndTrimEmptyPartitions(
     ActivityId const & activityId,
     int64 previousVersion,
@@ -324,6 +408,8 @@ void NotificationCacheIndex::UpdateVersionMapAndTrimEmptyPartitions(
             }
         }
 
+        this->DeleteFromVersionIndexes(it);
+
         allPartitionsByCuid_.erase(it->Partition->ConsistencyUnitId);
     }
 }
@@ -395,48 +481,141 @@ void NotificationCacheIndex::GetExactMatch(
     }
 }
 
-void NotificationCacheIndex::GetPrefixMatches(
-    ActivityId const & activityId,
-    IClientRegistration const & clientRegistration,
-    ServiceNotificationFilterSPtr const & filter,
+size_t NotificationCacheIndex::GetNameMatchCandidatesCount(
+    vector<ServiceNotificationFilterSPtr> const & filters,
+    size_t limit)
+{
+    size_t count = 0;
+
+    for (auto const & filter : filters)
+    {
+        if (count > limit)
+        {
+            break;
+        }
+
+        if (filter->IsPrefix)
+        {
+            this->VisitPrefixEntries(
+                ActivityId(),
+                filter->Name,
+                [&count, limit](NameIndexEntrySPtr const & indexEntry) -> bool
+                {
+                    count += indexEntry->Count;
+                    return (count <= limit);
+                });
+        }
+        else
+        {
+            auto it = indexEntriesByName_.find(filter->Name);
+            if (it != indexEntriesByName_.end())
+            {
+                count += it->second->Count;
+            }
+        }
+    }
+
+    return count;
+}
+
+bool NotificationCacheIndex::TryGetVersionMatchCandidates(
     VersionRangeCollectionSPtr const & clientVersions,
-    __inout MatchedServiceTableEntryMap & results)
+    size_t limit,
+    __out vector<CachedServiceTableEntrySPtr> & candidates)
 {
-    auto const & prefixName = filter->Name;
+    unordered_set<CachedServiceTableEntry const *> visited;
 
-    // Seek to position preceeding first possible prefix match
-    // before iterating through remainder of index.
-    //
-    // Note that there is another possible heuristic here.
-    // We can also diff the client and cache version ranges to
-    // determine which versions are potentially interesting to
-    // the client and lookup each entry using the version.
-    // This alternative is better if re-connecting clients
-    // tend to be mostly up-to-date and use very broad
-    // prefix filters.
+    // Returns false once the limit is reached
     //
-    // It is also possible to combine the two approaches.
-    // For example, search for the upper and lower bounds
-    // and compare the total number of potential matches by
-    // name to the number of potential matches by version.
-    // The approach with the smaller number of potential
-    // matches can then be used. There is some upfront
-    // cost to both finding the bounds and computing the
-    // version range diff, so the benefits will depend
-    // largely on workload patterns.
+    auto addCandidate = [&](CachedServiceTableEntrySPtr const & entry) -> bool
+    {
+        if (visited.insert(entry.get()).second)
+        {
+            candidates.push_back(entry);
+        }
+
+        return (candidates.size() < limit);
+    };
+
+    // Walk the gaps between the client's version ranges. Each range
+    // is skipped in its entirety with a single seek into the indexes.
     //
-    auto it = std::lower_bound(
-        indexEntriesByName_.begin(), 
-        indexEntriesByName_.end(), 
-        make_pair(prefixName, NameIndexEntrySPtr()),
-        [](NameEntryPair const & left, NameEntryPair const & right) -> bool
+    int64 gapStart = numeric_limits<int64>::min();
+
+    auto const & ranges = clientVersions->VersionRanges;
+
+    for (size_t ix = 0; ix <= ranges.size(); ++ix)
+    {
+        int64 gapEnd = (ix < ranges.size() ? ranges[ix].StartVersion : numeric_limits<int64>::max());
+
+        if (gapStart < gapEnd)
         {
-            return (left.first < right.first);
-        });
+            for (auto it = cachedEntriesByVersion_.lower_bound(gapStart); it != cachedEntriesByVersion_.end() && it->first < gapEnd; ++it)
+            {
+                if (!addCandidate(it->second))
+                {
+                    return false;
+                }
+            }
 
-    auto prefixNameString = prefixName.ToString();
+            for (auto it = cachedEntriesByPrimaryVersion_.lower_bound(make_pair(gapStart, CachedServiceTableEntrySPtr())); 
+                it != cachedEntriesByPrimaryVersion_.end() && it->first < gapEnd; 
+                ++it)
+            {
+                if (!addCandidate(it->second))
+                {
+                    return false;
+                }
+            }
+        }
 
-    while (it != indexEntriesByName_.end())
+        if (ix < ranges.size())
+        {
+            gapStart = ranges[ix].EndVersion;
+        }
+    }
+
+    return (candidates.size() < limit);
+}
+
+void NotificationCacheIndex::GetVersionMatches(
+    ActivityId const & activityId,
+    IClientRegistration const & clientRegistration,
+    vector<ServiceNotificationFilterSPtr> const & filters,
+    vector<CachedServiceTableEntrySPtr> const & candidates,
+    VersionRangeCollectionSPtr const & clientVersions,
+    __inout MatchedServiceTableEntryMap & results)
+{
+    FiltersByNameMap exactFilters;
+    FiltersByNameMap prefixFilters;
+
+    for (auto const & filter : filters)
+    {
+        auto & index = (filter->IsPrefix ? prefixFilters : exactFilters);
+
+        index[filter->Name].push_back(filter);
+    }
+
+    auto matchFilters = [&](CachedServiceTableEntrySPtr const & candidate, vector<ServiceNotificationFilterSPtr> const & matchedFilters)
+    {
+        for (auto const & filter : matchedFilters)
+        {
+            ServiceTableEntrySPtr unusedEntry;
+            if (candidate->TryGetServiceTableEntry(
+                activityId,
+                clientVersions,
+                filter->IsPrimaryOnly,
+                unusedEntry))
+            {
+                this->AddMatchedEntryResult(
+                    candidate,
+                    filter->IsPrimaryOnly,
+                    results);
+            }
+        }
+    };
+
+    for (auto const & candidate : candidates)
     {
         if (clientRegistration.IsSenderStopped())
         {
@@ -451,11 +630,70 @@ void NotificationCacheIndex::GetPrefixMatches(
             break;
         }
 
-        auto const & entryUri = it->first;
-        auto const & indexEntry = it->second;
+        auto const & uri = candidate->Uri;
 
-        if (prefixName.IsPrefixOf(it->first) || prefixName == it->first)
+        if (!exactFilters.empty())
         {
+            auto findIt = exactFilters.find(uri);
+            if (findIt != exactFilters.end())
+            {
+                matchFilters(candidate, findIt->second);
+            }
+        }
+
+        if (!prefixFilters.empty())
+        {
+            auto prefixUri = uri;
+            auto parentUri = uri.GetParentName();
+            bool done = false;
+
+            while (!done)
+            {
+                auto findIt = prefixFilters.find(prefixUri);
+                if (findIt != prefixFilters.end())
+                {
+                    matchFilters(candidate, findIt->second);
+                }
+
+                if (prefixUri == parentUri)
+                {
+                    done = true;
+                }
+                else
+                {
+                    prefixUri = parentUri;
+                    parentUri = prefixUri.GetParentName();
+                }
+            }
+        }
+    }
+}
+
+void NotificationCacheIndex::GetPrefixMatches(
+    ActivityId const & activityId,
+    IClientRegistration const & clientRegistration,
+    ServiceNotificationFilterSPtr const & filter,
+    VersionRangeCollectionSPtr const & clientVersions,
+    __inout MatchedServiceTableEntryMap & results)
+{
+    this->VisitPrefixEntries(
+        activityId,
+        filter->Name,
+        [&](NameIndexEntrySPtr const & indexEntry) -> bool
+        {
+            if (clientRegistration.IsSenderStopped())
+            {
+                WriteInfo(
+                    TraceComponent, 
+                    this->TraceId,
+                    "{0}: aborting notification filter processing",
+                    activityId);
+
+                results.clear();
+
+                return false;
+            }
+
             auto cachedEntries = indexEntry->TryGetCachedServiceTableEntries(
                 activityId,
                 clientVersions,
@@ -469,6 +707,33 @@ void NotificationCacheIndex::GetPrefixMatches(
                     results);
             }
 
+            return true;
+        });
+}
+
+void NotificationCacheIndex::VisitPrefixEntries(
+    ActivityId const & activityId,
+    NamingUri const & prefixName,
+    function<bool(NameIndexEntrySPtr const &)> const & visitor)
+{
+    // Seek to position preceeding first possible prefix match
+    // before iterating through remainder of index.
+    //
+    auto it = indexEntriesByName_.lower_bound(prefixName);
+
+    auto prefixNameString = prefixName.ToString();
+
+    while (it != indexEntriesByName_.end())
+    {
+        auto const & entryUri = it->first;
+
+        if (prefixName.IsPrefixOf(entryUri) || prefixName == entryUri)
+        {
+            if (!visitor(it->second))
+            {
+                break;
+            }
+
             ++it;
         }
         else if (StringUtility::StartsWith(entryUri.ToString(), prefixNameString))
@@ -52,13 +52,44 @@ namespace Reliability
         typedef std::pair<Common::NamingUri, NameIndexEntrySPtr> NameEntryPair;
         typedef std::map<Common::NamingUri, NameIndexEntrySPtr> NameEntriesMap;
         typedef std::map<int64, CachedServiceTableEntrySPtr> VersionedPartitionsMap;
+        typedef std::set<std::pair<int64, CachedServiceTableEntrySPtr>> PrimaryVersionedPartitionsSet;
         typedef std::unordered_set<ConsistencyUnitId, ConsistencyUnitId::Hasher> PartitionHash;
+        typedef std::unordered_map<Common::NamingUri, std::vector<ServiceNotificationFilterSPtr>, Common::NamingUri::Hasher> FiltersByNameMap;
+
+        void UpdateVersionIndexes(
+            int64 previousVersion,
+            int64 previousPrimaryVersion,
+            CachedServiceTableEntrySPtr const & updatedEntry);
+
+        void DeleteFromVersionIndexes(CachedServiceTableEntrySPtr const &);
 
         void UpdateVersionMapAndTrimEmptyPartitions(
             Common::ActivityId const &,
             int64 previousVersion,
             CachedServiceTableEntrySPtr const & updatedEntry);
 
+        // Stops counting once the count exceeds the limit
+        //
+        size_t GetNameMatchCandidatesCount(
+            std::vector<ServiceNotificationFilterSPtr> const & filters,
+            size_t limit);
+
+        // Fails (leaving a partial candidate list) once the number of
+        // candidates reaches the limit
+        //
+        bool TryGetVersionMatchCandidates(
+            Common::VersionRangeCollectionSPtr const & clientVersions,
+            size_t limit,
+            __out std::vector<CachedServiceTableEntrySPtr> &);
+
+        void GetVersionMatches(
+            Common::ActivityId const &,
+            IClientRegistration const &,
+            std::vector<ServiceNotificationFilterSPtr> const & filters,
+            std::vector<CachedServiceTableEntrySPtr> const & candidates,
+            Common::VersionRangeCollectionSPtr const & clientVersions,
+            __inout MatchedServiceTableEntryMap &);
+
         void GetExactMatch(
             Common::ActivityId const &,
             ServiceNotificationFilterSPtr const &,
@@ -72,6 +103,11 @@ namespace Reliability
             Common::VersionRangeCollectionSPtr const & clientVersions,
             __inout MatchedServiceTableEntryMap &);
 
+        void VisitPrefixEntries(
+            Common::ActivityId const &,
+            Common::NamingUri const & prefixName,
+            std::function<bool(NameIndexEntrySPtr const &)> const & visitor);
+
         void AddMatchedEntryResult(
             CachedServiceTableEntrySPtr const &,
             bool matchedPrimaryOnly,
@@ -80,6 +116,15 @@ namespace Reliability
         std::wstring traceId_;
         NameEntriesMap indexEntriesByName_;
 
+        // Secondary indexes used to find the entries whose versions are
+        // unknown to a re-connecting client without visiting every entry
+        // matching its filters by name. Stateful entries whose last primary
+        // change version differs from their current version are also indexed
+        // by the former since primary-only filters match on it.
+        //
+        VersionedPartitionsMap cachedEntriesByVersion_;
+        PrimaryVersionedPartitionsSet cachedEntriesByPrimaryVersion_;
+
         // Empty partitions can happen normally if all replicas go down but
         // are also used by the FM to indicate deleted services. Index all
         // observed empty partitions reported by the FM for
@@ -0,0 +1,211 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "Failover.stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace Reliability
+{
+    using namespace Common;
+    using namespace std;
+
+    class ServiceResolverCacheTest
+    {
+    protected:
+        ServiceResolverCacheTest() : root_(make_shared<ComponentRoot>()) { }
+
+        static ServiceTableEntry CreateStatefulEntry(
+            ConsistencyUnitId const & cuid,
+            wstring const & primaryLocation,
+            vector<wstring> && secondaryLocations,
+            int64 version);
+
+        static ServiceTableEntryDelta CreateDelta(ServiceTableEntry const & baseEntry, ServiceTableEntry const & entry);
+
+        // Returns whether the cache is up to date, which is what ServiceResolverImpl::ProcessServiceTableUpdate
+        // uses to decide whether to refresh the cache from the FM.
+        static bool StoreUpdate(
+            ServiceResolverCache & cache,
+            vector<ServiceTableEntry> const & entries,
+            vector<ServiceTableEntryDelta> const & deltas,
+            GenerationNumber const & generation,
+            VersionRangeCollection const & ranges,
+            int64 endVersion);
+
+        ComponentRootSPtr root_;
+    };
+
+    BOOST_FIXTURE_TEST_SUITE2(ServiceResolverCacheTestSuite, ServiceResolverCacheTest)
+
+    BOOST_AUTO_TEST_CASE(ApplyDeltaTest)
+    {
+        ServiceResolverCache cache(*root_);
+        GenerationNumber generation(1, Federation::NodeId());
+        ConsistencyUnitId cuid(Guid::NewGuid());
+
+        auto entry1 = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 1);
+        auto entry2 = CreateStatefulEntry(cuid, L"B", { L"A", L"D" }, 2);
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry1 }, {}, generation, VersionRangeCollection(1, 2), 2));
+        VERIFY_IS_TRUE(StoreUpdate(cache, {}, { CreateDelta(entry1, entry2) }, generation, VersionRangeCollection(2, 3), 3));
+
+        ServiceTableEntry cachedEntry;
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry2);
+
+        // A rebroadcast of a delta that has already been applied changes nothing
+        VERIFY_IS_TRUE(StoreUpdate(cache, {}, { CreateDelta(entry1, entry2) }, generation, VersionRangeCollection(2, 3), 3));
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry2);
+        VERIFY_IS_TRUE(cache.GetKnownVersions().Contains(2));
+    }
+
+    BOOST_AUTO_TEST_CASE(EntriesAndDeltasTest)
+    {
+        ServiceResolverCache cache(*root_);
+        GenerationNumber generation(1, Federation::NodeId());
+        ConsistencyUnitId cuid1(Guid::NewGuid());
+        ConsistencyUnitId cuid2(Guid::NewGuid());
+
+        auto entry1 = CreateStatefulEntry(cuid1, L"A", { L"B", L"C" }, 1);
+        auto entry2 = CreateStatefulEntry(cuid1, L"B", { L"A", L"D" }, 2);
+        auto entry3 = CreateStatefulEntry(cuid2, L"C", { L"A", L"B" }, 3);
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry1 }, {}, generation, VersionRangeCollection(1, 2), 2));
+
+        // Full entries and deltas of the same broadcast are both applied
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry3 }, { CreateDelta(entry1, entry2) }, generation, VersionRangeCollection(2, 4), 4));
+
+        ServiceTableEntry cachedEntry;
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid1, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry2);
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid2, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry3);
+    }
+
+    BOOST_AUTO_TEST_CASE(MissedBroadcastTest)
+    {
+        ServiceResolverCache cache(*root_);
+        GenerationNumber generation(1, Federation::NodeId());
+        ConsistencyUnitId cuid(Guid::NewGuid());
+
+        auto entry1 = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 1);
+        auto entry2 = CreateStatefulEntry(cuid, L"B", { L"A", L"C" }, 2);
+        auto entry3 = CreateStatefulEntry(cuid, L"B", { L"A", L"D" }, 3);
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry1 }, {}, generation, VersionRangeCollection(1, 2), 2));
+
+        // The broadcast of version 2 is missed, so the delta from version 2 cannot be applied
+        VERIFY_IS_FALSE(StoreUpdate(cache, {}, { CreateDelta(entry2, entry3) }, generation, VersionRangeCollection(3, 4), 4));
+
+        auto knownVersions = cache.GetKnownVersions();
+        VERIFY_IS_FALSE(knownVersions.Contains(2));
+        VERIFY_IS_FALSE(knownVersions.Contains(3));
+
+        ServiceTableEntry cachedEntry;
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry1);
+
+        // The refresh from the FM returns the full entry
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry3 }, {}, generation, VersionRangeCollection(1, 4), 4));
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry3);
+    }
+
+    BOOST_AUTO_TEST_CASE(BaseVersionMismatchTest)
+    {
+        ServiceResolverCache cache(*root_);
+        GenerationNumber generation(1, Federation::NodeId());
+        ConsistencyUnitId cuid(Guid::NewGuid());
+
+        auto entry1 = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 1);
+        auto entry2 = CreateStatefulEntry(cuid, L"B", { L"A", L"C" }, 2);
+        auto entry3 = CreateStatefulEntry(cuid, L"B", { L"A", L"D" }, 3);
+
+        // Version 2 was received from a lookup request, but the FM last broadcast version 1
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry2 }, {}, generation, VersionRangeCollection(1, 3), 3));
+
+        // Without the fallback the known versions would be contiguous and the stale entry would be kept
+        VERIFY_IS_FALSE(StoreUpdate(cache, {}, { CreateDelta(entry1, entry3) }, generation, VersionRangeCollection(3, 4), 4));
+
+        auto knownVersions = cache.GetKnownVersions();
+        VERIFY_IS_TRUE(knownVersions.Contains(2));
+        VERIFY_IS_FALSE(knownVersions.Contains(3));
+
+        ServiceTableEntry cachedEntry;
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry2);
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry3 }, {}, generation, VersionRangeCollection(3, 4), 4));
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry3);
+    }
+
+    BOOST_AUTO_TEST_CASE(GenerationChangeTest)
+    {
+        ServiceResolverCache cache(*root_);
+        GenerationNumber generation(1, Federation::NodeId());
+        GenerationNumber newGeneration(2, Federation::NodeId());
+        ConsistencyUnitId cuid(Guid::NewGuid());
+
+        auto entry1 = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 1);
+        auto entry2 = CreateStatefulEntry(cuid, L"B", { L"A", L"D" }, 2);
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry1 }, {}, generation, VersionRangeCollection(1, 2), 2));
+
+        // A new generation clears the cache, so there is no base entry for the delta
+        VERIFY_IS_FALSE(StoreUpdate(cache, {}, { CreateDelta(entry1, entry2) }, newGeneration, VersionRangeCollection(2, 3), 3));
+
+        VERIFY_ARE_EQUAL2(cache.Generation, newGeneration);
+        VERIFY_IS_FALSE(cache.GetKnownVersions().Contains(2));
+
+        ServiceTableEntry cachedEntry;
+        VERIFY_IS_FALSE(cache.TryGetEntry(cuid, cachedEntry));
+
+        VERIFY_IS_TRUE(StoreUpdate(cache, { entry2 }, {}, newGeneration, VersionRangeCollection(1, 3), 3));
+        VERIFY_IS_TRUE(cache.TryGetEntry(cuid, cachedEntry));
+        VERIFY_IS_TRUE(cachedEntry == entry2);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    ServiceTableEntry ServiceResolverCacheTest::CreateStatefulEntry(
+        ConsistencyUnitId const & cuid,
+        wstring const & primaryLocation,
+        vector<wstring> && secondaryLocations,
+        int64 version)
+    {
+        return ServiceTableEntry(
+            cuid,
+            L"fabric:/TestApp/TestService",
+            ServiceReplicaSet(true, true, wstring(primaryLocation), move(secondaryLocations), version));
+    }
+
+    ServiceTableEntryDelta ServiceResolverCacheTest::CreateDelta(ServiceTableEntry const & baseEntry, ServiceTableEntry const & entry)
+    {
+        ServiceTableEntryDelta delta;
+        VERIFY_IS_TRUE(ServiceTableEntryDelta::TryCreate(baseEntry, entry, delta));
+
+        return delta;
+    }
+
+    bool ServiceResolverCacheTest::StoreUpdate(
+        ServiceResolverCache & cache,
+        vector<ServiceTableEntry> const & entries,
+        vector<ServiceTableEntryDelta> const & deltas,
+        GenerationNumber const & generation,
+        VersionRangeCollection const & ranges,
+        int64 endVersion)
+    {
+        ServiceCuidMap updatedCuids;
+        ServiceCuidMap removedCuids;
+
+        AcquireWriteLock lock(cache.ServiceLookupTableLock);
+
+        return cache.StoreUpdate_CallerHoldsLock(entries, deltas, generation, ranges, endVersion, updatedCuids, removedCuids);
+    }
+}
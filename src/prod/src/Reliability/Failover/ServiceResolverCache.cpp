@@ -46,8 +46,9 @@ namespace Reliability
 
     bool ServiceResolverCache::StoreUpdate_CallerHoldsLock(
         vector<ServiceTableEntry> const & newEntries,
+        vector<ServiceTableEntryDelta> const & newEntryDeltas,
         GenerationNumber const & generationNumber,
-        VersionRangeCollection const & coveredRanges,
+        VersionRangeCollection const & incomingRanges,
         int64 endVersion,
         __inout ServiceCuidMap & updatedCuids,
         __inout ServiceCuidMap & removedCuids)
@@ -56,7 +57,7 @@ namespace Reliability
         removedCuids.clear();
 
         vector<ServiceTableEntrySPtr> indexedCacheEntries;
-        indexedCacheEntries.reserve(newEntries.size());
+        indexedCacheEntries.reserve(newEntries.size() + newEntryDeltas.size());
 
         if (this->generationNumber_ > generationNumber)
         {
@@ -86,22 +87,65 @@ namespace Reliability
             ClearCallerHoldingLock();
         }
 
-        for (auto const & iter : newEntries)
+        VersionRangeCollection coveredRanges(incomingRanges);
+
+        vector<ServiceTableEntrySPtr> tableEntries;
+        tableEntries.reserve(newEntries.size() + newEntryDeltas.size());
+
+        for (auto const & entry : newEntries)
+        {
+            tableEntries.push_back(make_shared<ServiceTableEntry>(entry));
+        }
+
+        for (auto const & delta : newEntryDeltas)
+        {
+            auto cachedEntry = this->GetEntryCallerHoldingLock(delta.ConsistencyUnitId);
+            if (cachedEntry && cachedEntry->Version >= delta.Version)
+            {
+                // Already known. Forward duplicates like full entries (see below).
+                // The cached entry is shared rather than copied: cached entries always
+                // have replicas, so it is only passed on to the notification index.
+                if (cachedEntry->Version == delta.Version)
+                {
+                    tableEntries.push_back(move(cachedEntry));
+                }
+
+                continue;
+            }
+
+            ServiceTableEntry entry;
+            if (cachedEntry && delta.TryApply(*cachedEntry, entry))
+            {
+                tableEntries.push_back(make_shared<ServiceTableEntry>(move(entry)));
+            }
+            else
+            {
+                WriteNoise(
+                    Constants::ServiceResolverSource,
+                    Root.TraceId,
+                    "Cannot apply delta {0} to cached version {1}",
+                    delta,
+                    cachedEntry ? cachedEntry->Version : -1);
+
+                coveredRanges.Remove(VersionRange(delta.Version, delta.Version + 1));
+            }
+        }
+
+        for (auto & tableEntry : tableEntries)
         {
             bool isUpdated = false;
 
-            auto tableEntry = make_shared<ServiceTableEntry>(iter);
             auto tableEntryPtr = tableEntry.get();
 
-            if (acceptAll || this->GetVersionForEntryCallerHoldingLock(iter.ConsistencyUnitId) < iter.Version)
+            if (acceptAll || this->GetVersionForEntryCallerHoldingLock(tableEntry->ConsistencyUnitId) < tableEntry->Version)
             {
                 WriteNoise(
                     Constants::ServiceResolverSource, 
                     Root.TraceId, 
                     "Broadcast updated for name={0} cuid={1} vers={2}",
                     tableEntry->ServiceName,
-                    iter.ConsistencyUnitId,
-                    iter.Version);
+                    tableEntry->ConsistencyUnitId,
+                    tableEntry->Version);
 
                 updatedCuids[tableEntry->ServiceName].push_back(tableEntry->ConsistencyUnitId);
             }
@@ -112,8 +156,8 @@ namespace Reliability
                     Root.TraceId, 
                     "Broadcast stale for name={0} cuid={1} vers={2}",
                     tableEntry->ServiceName,
-                    iter.ConsistencyUnitId,
-                    iter.Version);
+                    tableEntry->ConsistencyUnitId,
+                    tableEntry->Version);
             }
 
             // Do not filter indexed updates since the updates in
@@ -130,7 +174,7 @@ namespace Reliability
 
             if (!tableEntry->IsFound)
             {
-                if (coveredRanges.IsEmpty)
+                if (incomingRanges.IsEmpty)
                 {
                     WriteNoise(
                         Constants::ServiceResolverSource,
@@ -145,7 +189,7 @@ namespace Reliability
                     // EndVersion is exclusive, which means that the next update
                     // could be equal to EndVersion
                     //
-                    int64 highRange = coveredRanges.VersionRanges.back().EndVersion - 1;
+                    int64 highRange = incomingRanges.VersionRanges.back().EndVersion - 1;
                     if (TryRemoveEntryCallerHoldingLock(tableEntry->ConsistencyUnitId, highRange))
                     {
                         WriteInfo(
@@ -202,7 +246,7 @@ namespace Reliability
                     tableEntryPtr->ConsistencyUnitId,
                     tableEntryPtr->ServiceReplicaSet);
             }
-        } // for newEntries
+        } // for tableEntries
 
         knownVersions_.Merge(coveredRanges);
          
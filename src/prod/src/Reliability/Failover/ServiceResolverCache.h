@@ -24,8 +24,12 @@ namespace Reliability
         __declspec(property(get=get_ServiceLookupTableLock)) Common::RwLock& ServiceLookupTableLock;
         Common::RwLock& get_ServiceLookupTableLock() const { return this->LockObject; }
 
+        // Deltas that cannot be applied to the cached entries are not added to the known versions,
+        // so that the missing versions are requested from the FM.
+        //
         bool StoreUpdate_CallerHoldsLock(
             std::vector<ServiceTableEntry> const & newEntries, 
+            std::vector<ServiceTableEntryDelta> const & newEntryDeltas,
             GenerationNumber const & generationNumber, 
             Common::VersionRangeCollection const & coveredRanges, 
             int64 endVersion,
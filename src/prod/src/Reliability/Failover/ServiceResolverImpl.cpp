@@ -579,6 +579,7 @@ namespace Reliability
 
             isUpToDate = cache_.StoreUpdate_CallerHoldsLock(
                 body.ServiceTableEntries, 
+                body.ServiceTableEntryDeltas,
                 body.Generation, 
                 body.VersionRangeCollection, 
                 body.EndVersion,
@@ -73,6 +73,10 @@ namespace Reliability
         // The PeriodicStateScanInterval determines how often the FM background thread activates to scan for changes and kick off actions
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", PeriodicStateScanInterval, Common::TimeSpan::FromSeconds(5.0), Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // The FullStateScanInterval determines how often the FM background thread scans every FailoverUnit. In between, a periodic scan only
+        // visits the FailoverUnits that have changed or still have pending work. Set to zero to scan every FailoverUnit on every periodic scan.
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", FullStateScanInterval, Common::TimeSpan::FromSeconds(60.0), Common::ConfigEntryUpgradePolicy::Dynamic);
+
         // When the FM sends a particular action for a specific replica, it starts this timer.  Before it expires, the FM will not send additional
         // actions to the replica
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", MinActionRetryIntervalPerReplica, Common::TimeSpan::FromSeconds(10.0), Common::ConfigEntryUpgradePolicy::Dynamic);
@@ -218,6 +222,12 @@ namespace Reliability
         // Interval between empty service table update broadcast messages
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"FailoverManager", ServiceLookupTableEmptyBroadcastInterval, Common::TimeSpan::FromSeconds(15.0), Common::ConfigEntryUpgradePolicy::Dynamic);
 
+        // Broadcast updated service locations as the difference from the previously broadcast locations instead of the full entries.
+        // Nodes running an older version skip these differences but still consider their versions known, so this must only be
+        // enabled by a config upgrade after the code upgrade has completed on all nodes. Deltas are not broadcast while a Fabric
+        // upgrade or rollback is in progress.
+        INTERNAL_CONFIG_ENTRY(bool, L"FailoverManager", EnableServiceTableUpdateDeltas, false, Common::ConfigEntryUpgradePolicy::Dynamic);
+
         // The fraction of MaxMessageSize to use as the available buffer limit when calculating how much data
         // to put in a single message (should be in the range [0.0, 1.0])
         INTERNAL_CONFIG_ENTRY(double, L"FailoverManager", MessageContentBufferRatio, 0.75, Common::ConfigEntryUpgradePolicy::Dynamic, Common::InRange<double>(0.0, 1.0));
@@ -39,6 +39,9 @@ BackgroundManager::BackgroundManager(FailoverManager & fm, Common::ComponentRoot
     activeThreadCount_(0),
     enumerationAborted_(false),
     enumerationCompleted_(true),
+    isFullScan_(true),
+    fullScanRequested_(0),
+    lastFullScanTime_(StopwatchTime::Zero),
     isThrottled_(false),
     actionCount_(0),
     asyncCommitCount_(0),
@@ -123,6 +126,11 @@ void BackgroundManager::ScheduleRun()
     });
 }
 
+void BackgroundManager::RequestFullScan()
+{
+    InterlockedExchange(&fullScanRequested_, 1);
+}
+
 void BackgroundManager::CreateThreadContexts()
 {
     fm_.Events.PeriodicTaskBegin(fm_.Id, PeriodicTaskName::CreateContexts);
@@ -270,7 +278,28 @@ void BackgroundManager::RunPeriodicTask()
         activeThreadCount_ = Environment::GetNumberOfProcessors();
     }
 
-    visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(true, TimeSpan::Zero, true);
+    isFullScan_ = IsFullScanNeeded();
+    if (isFullScan_)
+    {
+        lastFullScanTime_ = iterationStartTime_;
+
+        // Every FailoverUnit is processed, so the dirty set is covered by this scan.
+        dirtyFailoverUnits_ = fm_.FailoverUnitCacheObj.TakeDirtyFailoverUnits();
+        fm_.FailoverUnitCounters->NumberOfDirtyFailoverUnits.Value = static_cast<PerformanceCounterValue>(dirtyFailoverUnits_.size());
+        dirtyFailoverUnits_.clear();
+
+        visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(true, TimeSpan::Zero, true);
+    }
+    else
+    {
+        // The remaining contexts only need to see every FailoverUnit eventually, so they wait for the next full scan.
+        currentContexts_.clear();
+
+        dirtyFailoverUnits_ = fm_.FailoverUnitCacheObj.TakeDirtyFailoverUnits();
+        fm_.FailoverUnitCounters->NumberOfDirtyFailoverUnits.Value = static_cast<PerformanceCounterValue>(dirtyFailoverUnits_.size());
+
+        visitor_ = fm_.FailoverUnitCacheObj.CreateVisitor(vector<FailoverUnitId>(dirtyFailoverUnits_), TimeSpan::Zero, true);
+    }
 
     // This thread itself will be performing the task as well.
     int threadsToInvoke = activeThreadCount_ - 1;
@@ -291,6 +320,27 @@ void BackgroundManager::OnPeriodicTaskEnd()
 
     visitor_ = nullptr;
 
+    // FailoverUnits that could not be locked, or were not reached because the enumeration
+    // was aborted, have to be processed by the next periodic task.
+    if (!unprocessedFailoverUnits_.empty())
+    {
+        fm_.FailoverUnitCacheObj.MarkFailoverUnitsDirty(vector<FailoverUnitId>(unprocessedFailoverUnits_.begin(), unprocessedFailoverUnits_.end()));
+    }
+
+    if (enumerationAborted_)
+    {
+        if (isFullScan_)
+        {
+            RequestFullScan();
+        }
+        else
+        {
+            fm_.FailoverUnitCacheObj.MarkFailoverUnitsDirty(dirtyFailoverUnits_);
+        }
+    }
+
+    dirtyFailoverUnits_.clear();
+
     for (auto it = currentContexts_.begin(); it != currentContexts_.end(); ++it)
     {
         bool isReady = (*it)->ReadyToComplete();
@@ -332,7 +382,8 @@ void BackgroundManager::OnPeriodicTaskEnd()
     }
 
     TimeSpan duration = Stopwatch::Now() - iterationStartTime_;
-    fm_.Events.FTPeriodicTaskEnd(Id, enumerationAborted_, unprocessedFailoverUnits_.size(), actionCount_, duration.TotalMilliseconds());
+    fm_.FailoverUnitCounters->BackgroundPassDuration.Value = static_cast<PerformanceCounterValue>(duration.TotalMilliseconds());
+    fm_.Events.FTPeriodicTaskEnd(Id, enumerationAborted_, unprocessedFailoverUnits_.size(), actionCount_, duration.TotalMilliseconds(), isFullScan_);
 
     ScheduleNextRun();
 }
@@ -390,6 +441,36 @@ bool BackgroundManager::IsEnumerationCompleted()
     return enumerationCompleted_;
 }
 
+bool BackgroundManager::IsFullScanNeeded()
+{
+    if (InterlockedExchange(&fullScanRequested_, 0) != 0 ||
+        Stopwatch::Now() - lastFullScanTime_ >= FailoverConfig::GetConfig().FullStateScanInterval)
+    {
+        return true;
+    }
+
+    for (BackgroundThreadContextUPtr const & context : currentContexts_)
+    {
+        if (!context->CanWaitForFullScan())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool BackgroundManager::IsBackgroundProcessingNeeded(FailoverUnit const& failoverUnit)
+{
+    return (!failoverUnit.IsStable ||
+        failoverUnit.IsToBeDeleted ||
+        failoverUnit.IsOrphaned ||
+        failoverUnit.IsUpgrading ||
+        failoverUnit.IsSwappingPrimary ||
+        failoverUnit.IsPlacementNeeded ||
+        failoverUnit.IsPersistencePending);
+}
+
 bool BackgroundManager::EnableThrottledThread()
 {
     AcquireExclusiveLock lock(throttleLock_);
@@ -651,6 +732,13 @@ void BackgroundManager::PostProcessFailoverUnit(
             actionCount_ += actionCount;
         }
     }
+
+    // Keep processing the FailoverUnit until it settles so that retries and timeouts
+    // are not left to the next full scan.
+    if (!actions.empty() || IsBackgroundProcessingNeeded(*failoverUnit))
+    {
+        fm_.FailoverUnitCacheObj.MarkFailoverUnitDirty(failoverUnit->Id);
+    }
 }
 
 bool BackgroundManager::ProcessFailoverUnit(
@@ -29,6 +29,9 @@ namespace Reliability
             void Stop();
             void ScheduleRun();
 
+            // Requests that the next periodic task processes every FailoverUnit instead of only the dirty ones.
+            void RequestFullScan();
+
             bool IsThrottled() const
             {
                 return isThrottled_;
@@ -91,6 +94,14 @@ namespace Reliability
 
             bool enumerationAborted_;
             bool enumerationCompleted_;
+
+            // Whether the current periodic task processes every FailoverUnit. Otherwise, only the
+            // FailoverUnits that were marked dirty in the FailoverUnitCache since the last one are processed.
+            bool isFullScan_;
+            LONG fullScanRequested_;
+            Common::StopwatchTime lastFullScanTime_;
+            std::vector<FailoverUnitId> dirtyFailoverUnits_;
+
             std::set<FailoverUnitId> unprocessedFailoverUnits_;
 
             // The state machine tasks for stateless services and stateful services
@@ -134,6 +145,11 @@ namespace Reliability
 
             bool IsEnumerationCompleted();
 
+            bool IsFullScanNeeded();
+
+            // Whether the FailoverUnit has pending work and must be processed again by the next incremental scan.
+            static bool IsBackgroundProcessingNeeded(FailoverUnit const& failoverUnit);
+
             // This is executed by each worker thread. It processes FailoverUnits until there is no one left.
             void Process();
             bool Process(EnumerationContext & enumerationContext, bool isThrottledThread);
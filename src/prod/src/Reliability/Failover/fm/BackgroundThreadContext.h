@@ -30,6 +30,9 @@ namespace Reliability
 
             virtual bool ReadyToComplete() { return false; }
 
+            // Whether the context can wait for the next full scan. Otherwise, it forces every periodic task to process all FailoverUnits.
+            virtual bool CanWaitForFullScan() const { return false; }
+
             virtual void Complete(FailoverManager & fm, bool isIterationCompleted, bool isEnumerationAborted) = 0;
 
             void TransferUnprocessedFailoverUnits(BackgroundThreadContext & orginal); 
@@ -30,7 +30,7 @@ namespace Reliability
 
             Common::TraceEventWriter<std::wstring, PeriodicTaskName::Trace> PeriodicTaskBegin;
             Common::TraceEventWriter<std::wstring, PeriodicTaskName::Trace> PeriodicTaskBeginNoise;
-            Common::TraceEventWriter<std::wstring, bool, uint64, int, int64> FTPeriodicTaskEnd;
+            Common::TraceEventWriter<std::wstring, bool, uint64, int, int64, bool> FTPeriodicTaskEnd;
             Common::TraceEventWriter<bool, bool, int> BackgroundEnumerationAborted;
             Common::TraceEventWriter<> BackgroundThreadStart;
             Common::TraceEventWriter<int, size_t, int, int, bool, bool> BackgroundThreadEndStatistics;
@@ -84,7 +84,7 @@ namespace Reliability
 
                 PeriodicTaskBegin(id, 21, "TaskBegin_BG", Common::LogLevel::Info, "{0}: {1} periodic task started", "fmId", "task"),
                 PeriodicTaskBeginNoise(id, 22, "TaskBeginNoise_BG", Common::LogLevel::Noise, "{0}: {1} periodic task started", "fmId", "task"),
-                FTPeriodicTaskEnd(id, 23, "BGTaskEnd_BG", Common::LogLevel::Info, "{0}: FT BackgroundManager periodic task ended: IsEnumerationAborted={1}, Unprocessed={2}, Actions={3}, Duration={4} ms", "fmId", "isEnumertionAborted", "failed", "actions", "duration"),
+                FTPeriodicTaskEnd(id, 23, "BGTaskEnd_BG", Common::LogLevel::Info, "{0}: FT BackgroundManager periodic task ended: IsEnumerationAborted={1}, Unprocessed={2}, Actions={3}, Duration={4} ms, IsFullScan={5}", "fmId", "isEnumertionAborted", "failed", "actions", "duration", "isFullScan"),
 
                 BackgroundEnumerationAborted(id, 24, "BGEnumAbort_BG", Common::LogLevel::Info, "Background enumeration aborted: IsActive={0}, IsRescheduled={1}, Actions={2}", "isActive", "isRescheduled", "actions"),
                 BackgroundThreadStart(id, 25, "BGThreadStart_BG", Common::LogLevel::Info, "Background thread started"),
@@ -21,7 +21,8 @@ FMServiceLookupTable::FMServiceLookupTable(
     : ServiceLookupTable(root),
     fm_(fm),
     endVersion_(savedLookupVersion + 1),
-    lastBroadcast_(DateTime::Zero)
+    lastBroadcast_(DateTime::Zero),
+    broadcastEntries_()
 {
     for (FailoverUnitUPtr const& failoverUnit : failoverUnits)
     {
@@ -53,6 +54,8 @@ void FMServiceLookupTable::set_EndVersion(int64 value)
 
     // Set the VersionRangeCollection as this is called from GFUM Transfer
     versionRangeCollection_ = VersionRangeCollection(1, value);
+
+    broadcastEntries_.clear();
 }
 
 void FMServiceLookupTable::Dispose()
@@ -101,6 +104,8 @@ void FMServiceLookupTable::RemoveEntry(FailoverUnit const& failoverUnit)
 
     UpdateVersionRangesCallerHoldingLock(failoverUnit);
     TryRemoveEntryCallerHoldingLock(ConsistencyUnitId(failoverUnit.Id.Guid));
+
+    broadcastEntries_.erase(ConsistencyUnitId(failoverUnit.Id.Guid));
 }
 
 void FMServiceLookupTable::GetUpdatesCallerHoldingLock(
@@ -175,6 +180,11 @@ void FMServiceLookupTable::StartBroadcastTimer()
 
 bool FMServiceLookupTable::TryGetServiceTableUpdateMessageBody(__out ServiceTableUpdateMessageBody & body)
 {
+    bool isDeltaSupported =
+        !fm_.IsMaster &&
+        FailoverConfig::GetConfig().EnableServiceTableUpdateDeltas &&
+        !fm_.FabricUpgradeManager.Upgrade;
+
     AcquireWriteLock grab(LockObject);
 
     fm_.ServiceEvents.LookupTableBroadcastRanges(versionRangeCollection_, broadcastVersionRangeCollections_[0]);
@@ -206,10 +216,60 @@ bool FMServiceLookupTable::TryGetServiceTableUpdateMessageBody(__out ServiceTabl
 
     int64 endVersion = (versionRangesToBroadcast.IsEmpty ? versionRangeCollection_.EndVersion : versionRangesToBroadcast.EndVersion);
 
-    body = ServiceTableUpdateMessageBody(move(entries), fm_.Generation, move(versionRangesToBroadcast), endVersion, fm_.IsMaster);
+    vector<ServiceTableEntryDelta> deltas;
+    if (isDeltaSupported)
+    {
+        CreateDeltasCallerHoldingLock(entries, deltas);
+    }
+    else
+    {
+        broadcastEntries_.clear();
+    }
+
+    body = ServiceTableUpdateMessageBody(move(entries), move(deltas), fm_.Generation, move(versionRangesToBroadcast), endVersion, fm_.IsMaster);
     return true;
 }
 
+void FMServiceLookupTable::CreateDeltasCallerHoldingLock(
+    __inout vector<ServiceTableEntry> & entries,
+    __out vector<ServiceTableEntryDelta> & deltas)
+{
+    vector<ServiceTableEntry> fullEntries;
+
+    for (auto & entry : entries)
+    {
+        auto current = GetEntryCallerHoldingLock(entry.ConsistencyUnitId);
+        if (!current || current->Version != entry.Version)
+        {
+            fullEntries.push_back(move(entry));
+            continue;
+        }
+
+        auto & broadcast = broadcastEntries_[entry.ConsistencyUnitId];
+        if (!broadcast.Last)
+        {
+            broadcast.Last = move(current);
+        }
+        else if (broadcast.Last->Version < entry.Version)
+        {
+            broadcast.Previous = move(broadcast.Last);
+            broadcast.Last = move(current);
+        }
+
+        ServiceTableEntryDelta delta;
+        if (broadcast.Previous && ServiceTableEntryDelta::TryCreate(*broadcast.Previous, entry, delta))
+        {
+            deltas.push_back(move(delta));
+        }
+        else
+        {
+            fullEntries.push_back(move(entry));
+        }
+    }
+
+    entries = move(fullEntries);
+}
+
 void FMServiceLookupTable::BroadcastTimerCallback()
 {
     if (fm_.IsActive)
@@ -54,6 +54,14 @@ namespace Reliability
             void Dispose();
 
         private:
+            // The last two versions of an entry that have been broadcast. Deltas for a newer version are
+            // created from the last version, while rebroadcasts of the last version use the one before it.
+            struct BroadcastEntries
+            {
+                ServiceTableEntrySPtr Previous;
+                ServiceTableEntrySPtr Last;
+            };
+
             FailoverManager& fm_;
 
             // The previous broadcast version ranges. The index [0, n) stores the ranges at the time of broadcast.
@@ -70,6 +78,9 @@ namespace Reliability
 
             Common::DateTime lastBroadcast_;
 
+            // The entries most recently broadcast for each partition, shared with the lookup table.
+            std::unordered_map<ConsistencyUnitId, BroadcastEntries, ConsistencyUnitId::Hasher> broadcastEntries_;
+
             // Timer for broadcast lookup table updates.
             Common::TimerSPtr broadcastTimer_;
 
@@ -79,6 +90,11 @@ namespace Reliability
             // This removes all the holes in the version range collection for the given FailoverUnit.
             void UpdateVersionRangesCallerHoldingLock(FailoverUnit const& failoverUnit);
 
+            // Replaces the entries that can be sent as the difference from their previous broadcast with deltas.
+            void CreateDeltasCallerHoldingLock(
+                __inout std::vector<ServiceTableEntry> & entries,
+                __out std::vector<ServiceTableEntryDelta> & deltas);
+
             void StartBroadcastTimer();
             void BroadcastTimerCallback();
         };
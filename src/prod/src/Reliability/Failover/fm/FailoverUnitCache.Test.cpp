@@ -27,7 +27,9 @@ namespace FailoverManagerUnitTest
         ~TestFailoverUnitCache() { BOOST_REQUIRE(MethodCleanup()); }
         TEST_METHOD_CLEANUP(MethodCleanup);
 
-        void CreateFailoverUnitsFromService(ServiceInfoSPtr const& serviceInfo, vector<FailoverUnitUPtr> & failoverUnits);
+        void CreateFailoverUnitsFromService(ServiceInfoSPtr const& serviceInfo, vector<FailoverUnitUPtr> & failoverUnits, int count = 10);
+
+        void RunMessageProcessingBenchmark(int failoverUnitCount);
 
         ComponentRootSPtr root_;
         FailoverManagerSPtr fm_;
@@ -64,11 +66,65 @@ namespace FailoverManagerUnitTest
         cache.ServiceLookupTable.Dispose();
     }
 
+    BOOST_AUTO_TEST_CASE(DirtyVisitorTest)
+    {
+        vector<FailoverUnitId> dirtyFailoverUnitIds;
+        for (size_t i = 0; i < failoverUnits_.size(); i += 3)
+        {
+            dirtyFailoverUnitIds.push_back(failoverUnits_[i]->Id);
+        }
+
+        FailoverUnitCache cache(*fm_, failoverUnits_, 0, *root_);
+
+        VERIFY_ARE_EQUAL(0u, cache.DirtyFailoverUnitCount);
+
+        for (FailoverUnitId const& failoverUnitId : dirtyFailoverUnitIds)
+        {
+            cache.MarkFailoverUnitDirty(failoverUnitId);
+        }
+
+        // Marking a FailoverUnit again does not change the dirty set.
+        cache.MarkFailoverUnitDirty(dirtyFailoverUnitIds[0]);
+
+        VERIFY_ARE_EQUAL(dirtyFailoverUnitIds.size(), cache.DirtyFailoverUnitCount);
+
+        vector<FailoverUnitId> failoverUnitIds = cache.TakeDirtyFailoverUnits();
+
+        VERIFY_ARE_EQUAL(dirtyFailoverUnitIds.size(), failoverUnitIds.size());
+        VERIFY_ARE_EQUAL(0u, cache.DirtyFailoverUnitCount);
+
+        FailoverUnitCache::VisitorSPtr visitor = cache.CreateVisitor(move(failoverUnitIds), FailoverConfig::GetConfig().LockAcquireTimeout, false);
+
+        set<FailoverUnitId> fuSet;
+        while (auto failoverUnit = visitor->MoveNext())
+        {
+            fuSet.insert(failoverUnit->Id);
+        }
+
+        VERIFY_ARE_EQUAL(dirtyFailoverUnitIds.size(), fuSet.size());
+        for (FailoverUnitId const& failoverUnitId : dirtyFailoverUnitIds)
+        {
+            VERIFY_IS_TRUE(fuSet.find(failoverUnitId) != fuSet.end());
+        }
+
+        cache.ServiceLookupTable.Dispose();
+    }
+
+    BOOST_AUTO_TEST_CASE(MessageProcessingPerf_100K, * boost::unit_test::disabled())
+    {
+        RunMessageProcessingBenchmark(100000);
+    }
+
+    BOOST_AUTO_TEST_CASE(MessageProcessingPerf_1M, * boost::unit_test::disabled())
+    {
+        RunMessageProcessingBenchmark(1000000);
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 
-    void TestFailoverUnitCache::CreateFailoverUnitsFromService(ServiceInfoSPtr const& serviceInfo, vector<FailoverUnitUPtr> & failoverUnits)
+    void TestFailoverUnitCache::CreateFailoverUnitsFromService(ServiceInfoSPtr const& serviceInfo, vector<FailoverUnitUPtr> & failoverUnits, int count)
     {
-        for (int i=0; i < 10; i++)
+        for (int i=0; i < count; i++)
         {
             // TODO: create a helper class for creating failover units in dev code
             ConsistencyUnitDescription consistencyUnitDescription;
@@ -80,6 +136,79 @@ namespace FailoverManagerUnitTest
         }
     }
 
+    void TestFailoverUnitCache::RunMessageProcessingBenchmark(int failoverUnitCount)
+    {
+        vector<FailoverUnitUPtr> failoverUnits;
+        CreateFailoverUnitsFromService(services_[0], failoverUnits, failoverUnitCount);
+
+        vector<FailoverUnitId> failoverUnitIds;
+        for (FailoverUnitUPtr const& failoverUnit : failoverUnits)
+        {
+            failoverUnitIds.push_back(failoverUnit->Id);
+        }
+
+        FailoverUnitCache cache(*fm_, failoverUnits, 0, *root_);
+
+        // Each message looks up and locks a random FailoverUnit, the same way the FM message handlers do.
+        int const messageCount = 1000000;
+        int threadCount = static_cast<int>(Environment::GetNumberOfProcessors());
+        int messagesPerThread = messageCount / threadCount;
+
+        Common::atomic_long pendingThreadCount(threadCount);
+        Common::atomic_long lockFailureCount(0);
+        ManualResetEvent completedEvent(false);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (int i = 0; i < threadCount; i++)
+        {
+            Threadpool::Post([&, i]
+            {
+                Random random(i);
+                for (int j = 0; j < messagesPerThread; j++)
+                {
+                    FailoverUnitId const& failoverUnitId = failoverUnitIds[random.Next(static_cast<int>(failoverUnitIds.size()))];
+
+                    LockedFailoverUnitPtr failoverUnit;
+                    if (!cache.TryGetLockedFailoverUnit(failoverUnitId, failoverUnit) || !failoverUnit)
+                    {
+                        lockFailureCount++;
+                    }
+                }
+
+                if (--pendingThreadCount == 0)
+                {
+                    completedEvent.Set();
+                }
+            });
+        }
+
+        // A background scan enumerates the cache while the messages are processed.
+        size_t visitedCount = 0;
+        FailoverUnitCache::VisitorSPtr visitor = cache.CreateVisitor(true);
+        while (auto failoverUnit = visitor->MoveNext())
+        {
+            visitedCount++;
+        }
+
+        completedEvent.WaitOne();
+        stopwatch.Stop();
+
+        Trace.WriteInfo(
+            "FailoverUnitCacheTestSource",
+            "FailoverUnits={0}, Threads={1}, Messages={2}, LockFailures={3}, Visited={4}, Duration={5} ms, Messages/s={6}",
+            failoverUnitCount,
+            threadCount,
+            messagesPerThread * threadCount,
+            lockFailureCount.load(),
+            visitedCount,
+            stopwatch.ElapsedMilliseconds,
+            static_cast<int64>(messagesPerThread * threadCount * 1000.0 / max(stopwatch.ElapsedMilliseconds, static_cast<int64>(1))));
+
+        cache.ServiceLookupTable.Dispose();
+    }
+
     bool TestFailoverUnitCache::MethodSetup()
     {
         FailoverConfig::Test_Reset();
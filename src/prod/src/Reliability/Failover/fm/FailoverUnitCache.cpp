@@ -69,9 +69,16 @@ FailoverUnitCache::Visitor::Visitor(FailoverUnitCache const& cache,
                                     bool executeStateMachine)
     : cache_(cache), index_(-1), timeout_(timeout), executeStateMachine_(executeStateMachine)
 {
-    for (auto it = cache.failoverUnits_.begin(); it != cache.failoverUnits_.end(); it++)
+    // Each shard is only locked while its IDs are copied, so writers are not blocked for the whole snapshot.
+    for (Shard const& shard : cache.shards_)
     {
-        shuffleTable_.push_back(it->first);
+        AcquireReadLock grab(shard.Lock);
+
+        shuffleTable_.reserve(shuffleTable_.size() + shard.FailoverUnits.size());
+        for (auto it = shard.FailoverUnits.begin(); it != shard.FailoverUnits.end(); it++)
+        {
+            shuffleTable_.push_back(it->first);
+        }
     }
 
     if (randomAccess)
@@ -80,6 +87,19 @@ FailoverUnitCache::Visitor::Visitor(FailoverUnitCache const& cache,
     }
 }
 
+FailoverUnitCache::Visitor::Visitor(FailoverUnitCache const& cache,
+                                    vector<FailoverUnitId> && failoverUnitIds,
+                                    bool randomAccess,
+                                    TimeSpan timeout,
+                                    bool executeStateMachine)
+    : cache_(cache), shuffleTable_(move(failoverUnitIds)), index_(-1), timeout_(timeout), executeStateMachine_(executeStateMachine)
+{
+    if (randomAccess)
+    {
+        random_shuffle(shuffleTable_.begin(), shuffleTable_.end());
+    }
+}
+
 LockedFailoverUnitPtr FailoverUnitCache::Visitor::MoveNext()
 {
     LockedFailoverUnitPtr failoverUnit;
@@ -163,7 +183,7 @@ FailoverUnitCache::FailoverUnitCache(
         }
 
         FailoverUnitId failoverUnitId = failoverUnits[i]->Id;
-        failoverUnits_.insert(make_pair(failoverUnitId, make_shared<FailoverUnitCacheEntry>(fm_, move(failoverUnits[i]))));
+        GetShard(failoverUnitId).FailoverUnits.insert(make_pair(failoverUnitId, make_shared<FailoverUnitCacheEntry>(fm_, move(failoverUnits[i]))));
     }
 
     fm_.InBuildFailoverUnitCacheObj.InitializeHealthSequence(healthSequence_);
@@ -181,17 +201,111 @@ FailoverUnitCache::FailoverUnitCache(
 
 size_t FailoverUnitCache::get_Count() const
 {
-    AcquireReadLock grab(lock_);
-    return failoverUnits_.size(); 
+    size_t count = 0;
+    for (Shard const& shard : shards_)
+    {
+        AcquireReadLock grab(shard.Lock);
+        count += shard.FailoverUnits.size();
+    }
+
+    return count;
 }
 
-void FailoverUnitCache::InsertFailoverUnitInCache(FailoverUnitUPtr && failoverUnit)
+FailoverUnitCache::Shard & FailoverUnitCache::GetShard(FailoverUnitId const& failoverUnitId)
 {
-    AcquireWriteLock grab(lock_);
+    // The hash used by the shard map does not include this byte, so the FailoverUnits of a shard still spread over its buckets.
+    return shards_[failoverUnitId.Guid.AsGUID().Data4[5] % ShardCount];
+}
 
+FailoverUnitCache::Shard const& FailoverUnitCache::GetShard(FailoverUnitId const& failoverUnitId) const
+{
+    return shards_[failoverUnitId.Guid.AsGUID().Data4[5] % ShardCount];
+}
+
+FailoverUnitCacheEntrySPtr FailoverUnitCache::GetEntry(FailoverUnitId const& failoverUnitId) const
+{
+    Shard const& shard = GetShard(failoverUnitId);
+
+    AcquireReadLock grab(shard.Lock);
+
+    auto it = shard.FailoverUnits.find(failoverUnitId);
+    return (it != shard.FailoverUnits.end() ? it->second : nullptr);
+}
+
+void FailoverUnitCache::RemoveFailoverUnit(FailoverUnit const& failoverUnit)
+{
+    Shard & shard = GetShard(failoverUnit.Id);
+
+    AcquireWriteLock grab(shard.Lock);
+
+    auto it = shard.FailoverUnits.find(failoverUnit.Id);
+
+    if (it != shard.FailoverUnits.end())
+    {
+        it->second->IsDeleted = true;
+        shard.FailoverUnits.erase(it);
+        serviceLookupTable_.RemoveEntry(failoverUnit);
+    }
+    else
+    {
+        fm_.FTEvents.FTUpdateFailureBecauseAlreadyDeleted(failoverUnit.Id.Guid);
+    }
+}
+
+size_t FailoverUnitCache::get_DirtyFailoverUnitCount() const
+{
+    size_t count = 0;
+    for (Shard const& shard : shards_)
+    {
+        AcquireExclusiveLock grab(shard.DirtyLock);
+        count += shard.DirtyFailoverUnits.size();
+    }
+
+    return count;
+}
+
+void FailoverUnitCache::MarkFailoverUnitDirty(FailoverUnitId const& failoverUnitId) const
+{
+    Shard const& shard = GetShard(failoverUnitId);
+
+    AcquireExclusiveLock grab(shard.DirtyLock);
+    shard.DirtyFailoverUnits.insert(failoverUnitId);
+}
+
+void FailoverUnitCache::MarkFailoverUnitsDirty(vector<FailoverUnitId> const& failoverUnitIds) const
+{
+    for (FailoverUnitId const& failoverUnitId : failoverUnitIds)
+    {
+        MarkFailoverUnitDirty(failoverUnitId);
+    }
+}
+
+vector<FailoverUnitId> FailoverUnitCache::TakeDirtyFailoverUnits()
+{
+    vector<FailoverUnitId> dirtyFailoverUnits;
+
+    for (Shard & shard : shards_)
+    {
+        unordered_set<FailoverUnitId, FailoverUnitId::Hasher> shardDirtyFailoverUnits;
+        {
+            AcquireExclusiveLock grab(shard.DirtyLock);
+            swap(shardDirtyFailoverUnits, shard.DirtyFailoverUnits);
+        }
+
+        dirtyFailoverUnits.insert(dirtyFailoverUnits.end(), shardDirtyFailoverUnits.begin(), shardDirtyFailoverUnits.end());
+    }
+
+    return dirtyFailoverUnits;
+}
+
+void FailoverUnitCache::InsertFailoverUnitInCache(FailoverUnitUPtr && failoverUnit)
+{
     FailoverUnitId failoverUnitId = failoverUnit->Id;
+    Shard & shard = GetShard(failoverUnitId);
+
+    AcquireWriteLock grab(shard.Lock);
 
-    if (failoverUnits_.find(failoverUnitId) != failoverUnits_.end())
+    if (shard.FailoverUnits.find(failoverUnitId) != shard.FailoverUnits.end())
     {
         fm_.WriteError(TraceFTCache, failoverUnit->IdString,
             "Cannot insert FailoverUnit. A FailoverUnit with the same ID already exists: {0}", failoverUnitId);
@@ -199,7 +313,7 @@ void FailoverUnitCache::InsertFailoverUnitInCache(FailoverUnitUPtr && failoverUn
     }
 
     auto failoverUnitCacheEntry = make_shared<FailoverUnitCacheEntry>(fm_, move(failoverUnit));
-    auto result = failoverUnits_.insert(make_pair(failoverUnitId, failoverUnitCacheEntry));
+    auto result = shard.FailoverUnits.insert(make_pair(failoverUnitId, failoverUnitCacheEntry));
 
     FailoverUnit & insertedFailoverUnit = *(result.first->second->FailoverUnit);
 
@@ -230,6 +344,8 @@ void FailoverUnitCache::InsertFailoverUnitInCache(FailoverUnitUPtr && failoverUn
     fm_.FTEvents.FTUpdateBackground(failoverUnitId.Guid, *(failoverUnitCacheEntry->FailoverUnit), noActions, insertedFailoverUnit.ReplicaDifference, 0, plbElapsedMilliseconds);
 
     insertedFailoverUnit.ReplicaDifference = 0;   
+
+    MarkFailoverUnitDirty(failoverUnitId);
 }
 
 FABRIC_SEQUENCE_NUMBER FailoverUnitCache::GetHealthSequence()
@@ -358,20 +474,7 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
     {
         if (persistenceState == PersistenceState::ToBeDeleted)
         {
-            AcquireWriteLock grab(lock_);
-
-            auto it = failoverUnits_.find(failoverUnit->Id);
-
-            if (it != failoverUnits_.end())
-            {
-                it->second->IsDeleted = true;
-                failoverUnits_.erase(it);
-                serviceLookupTable_.RemoveEntry(*failoverUnit);
-            }
-            else
-            {
-                fm_.FTEvents.FTUpdateFailureBecauseAlreadyDeleted(failoverUnit->Id.Guid);
-            }
+            RemoveFailoverUnit(*failoverUnit);
 
             fm_.FTEvents.PartitionDeleted(failoverUnit->IdString, failoverUnit->CurrentConfigurationVersion);
         }
@@ -443,6 +546,11 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
         }
 
         failoverUnit.Submit();
+
+        if (persistenceState != PersistenceState::ToBeDeleted)
+        {
+            MarkFailoverUnitDirty(failoverUnit->Id);
+        }
     }
     else
     {
@@ -464,6 +572,7 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
             failoverUnit->UpdatePointers(fm_, nodeCache_, serviceCache_);
 
             failoverUnit.Submit();
+            MarkFailoverUnitDirty(failoverUnit->Id);
 
             error = ErrorCodeValue::FMStoreUpdateFailed;
         }
@@ -473,20 +582,7 @@ ErrorCode FailoverUnitCache::PostUpdateFailoverUnit(
             {
                 if (error.ReadValue() == ErrorCodeValue::FMFailoverUnitNotFound)
                 {
-                    AcquireWriteLock grab(lock_);
-
-                    auto it = failoverUnits_.find(failoverUnit->Id);
-
-                    if (it != failoverUnits_.end())
-                    {
-                        it->second->IsDeleted = true;
-                        failoverUnits_.erase(it);
-                        serviceLookupTable_.RemoveEntry(*failoverUnit);
-                    }
-                    else
-                    {
-                        fm_.FTEvents.FTUpdateFailureBecauseAlreadyDeleted(failoverUnit->Id.Guid);
-                    }
+                    RemoveFailoverUnit(*failoverUnit);
 
                     fm_.FTEvents.PartitionDeleted(failoverUnit->IdString, failoverUnit->CurrentConfigurationVersion);
                 }
@@ -586,28 +682,26 @@ FailoverUnitCache::VisitorSPtr FailoverUnitCache::CreateVisitor(bool randomAcces
 
 FailoverUnitCache::VisitorSPtr FailoverUnitCache::CreateVisitor(bool randomAccess, TimeSpan timeout, bool executeStateMachine) const
 {
-    AcquireReadLock grab(lock_);
     return make_shared<Visitor>(*this, randomAccess, timeout, executeStateMachine);
 }
 
-bool FailoverUnitCache::TryProcessTaskAsync(FailoverUnitId failoverUnitId, DynamicStateMachineTaskUPtr & task, Federation::NodeInstance const & from, bool const isFromPLB) const
+FailoverUnitCache::VisitorSPtr FailoverUnitCache::CreateVisitor(vector<FailoverUnitId> && failoverUnitIds, TimeSpan timeout, bool executeStateMachine) const
 {
-    FailoverUnitCacheEntrySPtr entry;
+    return make_shared<Visitor>(*this, move(failoverUnitIds), true, timeout, executeStateMachine);
+}
 
+bool FailoverUnitCache::TryProcessTaskAsync(FailoverUnitId failoverUnitId, DynamicStateMachineTaskUPtr & task, Federation::NodeInstance const & from, bool const isFromPLB) const
+{
+    FailoverUnitCacheEntrySPtr entry = GetEntry(failoverUnitId);
+    if (!entry)
     {
-        AcquireReadLock grab(lock_);
-
-        auto it = failoverUnits_.find(failoverUnitId);
-        if (it == failoverUnits_.end())
-        {
-            return false;
-        }
-
-        entry = it->second;
+        return false;
     }
 
     entry->ProcessTaskAsync(move(task), from, isFromPLB);
 
+    MarkFailoverUnitDirty(failoverUnitId);
+
     return true;
 }
 
@@ -624,18 +718,10 @@ bool FailoverUnitCache::TryGetLockedFailoverUnit(
     TimeSpan timeout,
     bool executeStateMachine) const
 {
-    FailoverUnitCacheEntrySPtr entry;
-
+    FailoverUnitCacheEntrySPtr entry = GetEntry(failoverUnitId);
+    if (!entry)
     {
-        AcquireReadLock grab(lock_);
-
-        auto it = failoverUnits_.find(failoverUnitId);
-        if (it == failoverUnits_.end())
-        {
-            return true;
-        }
-
-        entry = it->second;
+        return true;
     }
 
     bool isDeleted;
@@ -655,17 +741,21 @@ bool FailoverUnitCache::TryGetLockedFailoverUnit(
 
 bool FailoverUnitCache::IsFailoverUnitValid(FailoverUnitId const& failoverUnitId) const
 {
-    AcquireReadLock grab(lock_);
+    Shard const& shard = GetShard(failoverUnitId);
 
-    auto it = failoverUnits_.find(failoverUnitId);
-    return (it != failoverUnits_.end() && !it->second->FailoverUnit->IsToBeDeleted);
+    AcquireReadLock grab(shard.Lock);
+
+    auto it = shard.FailoverUnits.find(failoverUnitId);
+    return (it != shard.FailoverUnits.end() && !it->second->FailoverUnit->IsToBeDeleted);
 }
 
 bool FailoverUnitCache::FailoverUnitExists(FailoverUnitId const& failoverUnitId) const
 {
-    AcquireReadLock grab(lock_);
-    auto it = failoverUnits_.find(failoverUnitId);
-    return (it != failoverUnits_.end());
+    Shard const& shard = GetShard(failoverUnitId);
+
+    AcquireReadLock grab(shard.Lock);
+    auto it = shard.FailoverUnits.find(failoverUnitId);
+    return (it != shard.FailoverUnits.end());
 }
 
 bool FailoverUnitCache::IsSafeToRemove(FailoverUnit const& failoverUnit) const
@@ -768,6 +858,9 @@ void FailoverUnitCache::AddThreadContexts()
 
         invalidateSequence_ = initialSequence_ = progress;
 
+        // FailoverUnits below the invalidated sequence have to report health again.
+        fm_.BackgroundManagerObj.RequestFullScan();
+
         FABRIC_SEQUENCE_NUMBER currentSequence = healthSequence_;
         while (currentSequence < progress)
         {
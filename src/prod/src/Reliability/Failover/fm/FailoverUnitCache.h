@@ -12,6 +12,8 @@ namespace Reliability
         /// <summary>
         /// This class acts as a write-through cache for the FailoverUnit
         /// information in the store.
+        /// The FailoverUnits are spread over shards by their ID, each shard has
+        /// its own lock so that lookups of different FailoverUnits do not contend.
         /// </summary>
         class FailoverUnitCache
         {
@@ -33,6 +35,7 @@ namespace Reliability
 
             public:
                 Visitor(FailoverUnitCache const& cache, bool randomAccess, Common::TimeSpan timeout, bool executeStateMachine);
+                Visitor(FailoverUnitCache const& cache, std::vector<FailoverUnitId> && failoverUnitIds, bool randomAccess, Common::TimeSpan timeout, bool executeStateMachine);
 
                 LockedFailoverUnitPtr MoveNext();
                 LockedFailoverUnitPtr MoveNext(__out bool & result, FailoverUnitId & failoverUnitId);
@@ -58,6 +61,9 @@ namespace Reliability
             __declspec(property(get=get_Count)) size_t Count;
             size_t get_Count() const;
 
+            __declspec(property(get=get_DirtyFailoverUnitCount)) size_t DirtyFailoverUnitCount;
+            size_t get_DirtyFailoverUnitCount() const;
+
             __declspec(property(get=get_ServiceLookupTable)) FMServiceLookupTable& ServiceLookupTable;
             FMServiceLookupTable& get_ServiceLookupTable() { return serviceLookupTable_; }
 
@@ -85,6 +91,16 @@ namespace Reliability
             VisitorSPtr CreateVisitor(bool randomAccess, Common::TimeSpan timeout, bool executeStateMachine = false) const;
             VisitorSPtr CreateVisitor(bool randomAccess = false) const;
 
+            // Creates a visitor that only enumerates the given FailoverUnits.
+            VisitorSPtr CreateVisitor(std::vector<FailoverUnitId> && failoverUnitIds, Common::TimeSpan timeout, bool executeStateMachine) const;
+
+            // Records that the FailoverUnit has to be processed by the next incremental background scan.
+            void MarkFailoverUnitDirty(FailoverUnitId const& failoverUnitId) const;
+            void MarkFailoverUnitsDirty(std::vector<FailoverUnitId> const& failoverUnitIds) const;
+
+            // Returns the FailoverUnits marked dirty since the last call and clears the dirty sets of all the shards.
+            std::vector<FailoverUnitId> TakeDirtyFailoverUnits();
+
             bool TryProcessTaskAsync(FailoverUnitId failoverUnitId, DynamicStateMachineTaskUPtr & task, Federation::NodeInstance const & from, bool const isFromPLB = false) const;
 
             bool TryGetLockedFailoverUnit(
@@ -131,6 +147,26 @@ namespace Reliability
 
             void UpdatePlacementAndLoadBalancer(LockedFailoverUnitPtr & failoverUnit, PersistenceState::Enum pstate, __out int64 & plbDuration) const;
 
+            struct Shard
+            {
+                std::unordered_map<FailoverUnitId, FailoverUnitCacheEntrySPtr, FailoverUnitId::Hasher> FailoverUnits;
+                mutable Common::RwLock Lock;
+
+                // FailoverUnits of the shard that changed since the last background scan. Protected by DirtyLock, which
+                // is separate from Lock so that marking a FailoverUnit dirty never waits for the FailoverUnit map.
+                mutable std::unordered_set<FailoverUnitId, FailoverUnitId::Hasher> DirtyFailoverUnits;
+                mutable Common::ExclusiveLock DirtyLock;
+            };
+
+            static const size_t ShardCount = 64;
+
+            Shard & GetShard(FailoverUnitId const& failoverUnitId);
+            Shard const& GetShard(FailoverUnitId const& failoverUnitId) const;
+
+            FailoverUnitCacheEntrySPtr GetEntry(FailoverUnitId const& failoverUnitId) const;
+
+            void RemoveFailoverUnit(FailoverUnit const& failoverUnit);
+
             FailoverManager& fm_;
             FailoverManagerStore& fmStore_;
             InstrumentedPLB & plb_;
@@ -139,7 +175,7 @@ namespace Reliability
             ServiceCache & serviceCache_;
             LoadCache & loadCache_;
 
-            std::map<FailoverUnitId, FailoverUnitCacheEntrySPtr> failoverUnits_;
+            Shard shards_[ShardCount];
 
             FMServiceLookupTable serviceLookupTable_;
             int64 savedLookupVersion_;
@@ -150,6 +186,7 @@ namespace Reliability
             FABRIC_SEQUENCE_NUMBER invalidateSequence_;
             bool healthInitialized_;
 
+            // Protects the saved lookup version and the health sequences, the FailoverUnits are protected by their shard.
             MUTABLE_RWLOCK(FM.FailoverUnitCache, lock_);
         };
     }
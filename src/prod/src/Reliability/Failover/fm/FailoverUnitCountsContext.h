@@ -54,6 +54,8 @@ namespace Reliability
 
             virtual bool ReadyToComplete();
 
+            virtual bool CanWaitForFullScan() const { return true; }
+
             virtual void Complete(FailoverManager & fm, bool isContextCompleted, bool isEnumerationAborted);
 
         private:
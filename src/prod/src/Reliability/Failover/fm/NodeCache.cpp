@@ -1317,6 +1317,8 @@ ErrorCode NodeCache::NodeDown(NodeInstance const& nodeInstance)
 
         if (fm_.IsReady)
         {
+            // The replicas on the node are marked down by the next periodic task, which has to process every FailoverUnit.
+            fm_.BackgroundManagerObj.RequestFullScan();
             fm_.BackgroundManagerObj.ScheduleRun();
         }
     }
@@ -132,6 +132,9 @@ namespace Reliability
                 COUNTER_DEFINITION(78, Common::PerformanceCounterType::AverageBase, L"Base for PLB OnFMBusy", L"", noDisplay)
                 COUNTER_DEFINITION_WITH_BASE(79, 78, Common::PerformanceCounterType::AverageCount64, L"PLB OnFMBusy", L"Time taken for the PLB OnFMBusy function call")
 
+                COUNTER_DEFINITION(80, Common::PerformanceCounterType::RawData64, L"Background Pass Duration", L"Time taken by the last background processing pass")
+                COUNTER_DEFINITION(81, Common::PerformanceCounterType::RawData64, L"#Dirty Failover Units", L"Number of failover units that were marked dirty when the last background processing pass started")
+
                 END_COUNTER_SET_DEFINITION()
 
             DECLARE_COUNTER_INSTANCE(NumberOfUnhealthyFailoverUnits)
@@ -213,6 +216,8 @@ namespace Reliability
             DECLARE_COUNTER_INSTANCE(PlbUpdateClusterUpgrade)
             DECLARE_COUNTER_INSTANCE(PlbOnFMBusyBase)
             DECLARE_COUNTER_INSTANCE(PlbOnFMBusy)
+            DECLARE_COUNTER_INSTANCE(BackgroundPassDuration)
+            DECLARE_COUNTER_INSTANCE(NumberOfDirtyFailoverUnits)
 
             BEGIN_COUNTER_SET_INSTANCE(FailoverUnitCounters)
                 DEFINE_COUNTER_INSTANCE(NumberOfUnhealthyFailoverUnits, 1)
@@ -294,6 +299,8 @@ namespace Reliability
                 DEFINE_COUNTER_INSTANCE(PlbUpdateClusterUpgrade, 77)
                 DEFINE_COUNTER_INSTANCE(PlbOnFMBusyBase, 78)
                 DEFINE_COUNTER_INSTANCE(PlbOnFMBusy, 79)
+                DEFINE_COUNTER_INSTANCE(BackgroundPassDuration, 80)
+                DEFINE_COUNTER_INSTANCE(NumberOfDirtyFailoverUnits, 81)
                 END_COUNTER_SET_INSTANCE()
         };
 
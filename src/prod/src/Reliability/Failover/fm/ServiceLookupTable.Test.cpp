@@ -30,6 +30,22 @@ namespace FailoverManagerUnitTest
         vector<ConsistencyUnitDescription> GetConsistencyUnitDescriptions(int count) const;
         LockedFailoverUnitPtr GetFailoverUnit(int64 lookupVersion);
 
+        static ServiceTableEntry CreateStatefulEntry(
+            ConsistencyUnitId const & cuid,
+            wstring const & primaryLocation,
+            vector<wstring> && secondaryLocations,
+            int64 version);
+
+        static void RunDeltaBroadcastBenchmark(int partitionCount);
+
+        static FailoverUnitUPtr CreateStatefulFailoverUnit(vector<wstring> const & locations);
+        static void SetServiceLocations(FailoverUnit & failoverUnit, vector<wstring> const & locations);
+
+        void EnableDeltaBroadcast();
+        void UpdateLookupTable(FailoverUnit & failoverUnit);
+        ServiceTableUpdateMessageBody Broadcast();
+        ServiceTableEntry GetEntry(FailoverUnit const & failoverUnit);
+
         ComponentRootSPtr root_;
         FailoverManagerSPtr fm_;
     };
@@ -453,8 +469,325 @@ namespace FailoverManagerUnitTest
         VERIFY_ARE_EQUAL(body9.ServiceTableEntries.size(), 3);
     }
 
+    BOOST_AUTO_TEST_CASE(TestServiceTableEntryDelta)
+    {
+        ConsistencyUnitId cuid(Guid::NewGuid());
+
+        auto baseEntry = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 5);
+
+        // The primary moves to B and C is replaced by D
+        auto entry = CreateStatefulEntry(cuid, L"B", { L"A", L"D" }, 7);
+
+        ServiceTableEntryDelta delta;
+        VERIFY_IS_TRUE(ServiceTableEntryDelta::TryCreate(baseEntry, entry, delta));
+        VERIFY_ARE_EQUAL(delta.BaseVersion, 5);
+        VERIFY_ARE_EQUAL(delta.Version, 7);
+
+        // Round trip the delta in a broadcast
+        vector<ServiceTableEntryDelta> deltas;
+        deltas.push_back(delta);
+        ServiceTableUpdateMessageBody body(vector<ServiceTableEntry>(), move(deltas), GenerationNumber(), VersionRangeCollection(7, 8), 8, false);
+
+        vector<byte> bytes;
+        VERIFY_IS_TRUE(FabricSerializer::Serialize(&body, bytes).IsSuccess());
+
+        ServiceTableUpdateMessageBody receivedBody;
+        VERIFY_IS_TRUE(FabricSerializer::Deserialize(receivedBody, bytes).IsSuccess());
+        VERIFY_ARE_EQUAL(receivedBody.ServiceTableEntryDeltas.size(), 1u);
+
+        ServiceTableEntry appliedEntry;
+        VERIFY_IS_TRUE(receivedBody.ServiceTableEntryDeltas[0].TryApply(baseEntry, appliedEntry));
+        VERIFY_IS_TRUE(appliedEntry == entry);
+
+        // A delta only applies to the version it was created from
+        auto otherBaseEntry = CreateStatefulEntry(cuid, L"A", { L"B", L"C" }, 6);
+        VERIFY_IS_FALSE(delta.TryApply(otherBaseEntry, appliedEntry));
+
+        // Deleted partitions are always sent as full entries
+        ServiceTableEntry deletedEntry(cuid);
+        deletedEntry.EnsureEmpty(8);
+        VERIFY_IS_FALSE(ServiceTableEntryDelta::TryCreate(entry, deletedEntry, delta));
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBroadcastDeltas)
+    {
+        EnableDeltaBroadcast();
+
+        auto failoverUnit = CreateStatefulFailoverUnit({ L"A", L"B", L"C" });
+        UpdateLookupTable(*failoverUnit);
+        auto entry1 = GetEntry(*failoverUnit);
+
+        //
+        // There is no earlier broadcast to create a delta from, so both broadcasts send the full entry
+        //
+        for (int i = 0; i < 2; i++)
+        {
+            auto body = Broadcast();
+            VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 1u);
+            VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 0u);
+            VERIFY_IS_TRUE(body.ServiceTableEntries[0] == entry1);
+        }
+
+        //
+        // The next version is sent as a delta from the last broadcast, also when it is rebroadcast
+        //
+        SetServiceLocations(*failoverUnit, { L"A", L"B", L"D" });
+        UpdateLookupTable(*failoverUnit);
+        auto entry2 = GetEntry(*failoverUnit);
+
+        for (int i = 0; i < 2; i++)
+        {
+            auto body = Broadcast();
+            VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 0u);
+            VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 1u);
+            VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas[0].BaseVersion, entry1.Version);
+            VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas[0].Version, entry2.Version);
+
+            ServiceTableEntry appliedEntry;
+            VERIFY_IS_TRUE(body.ServiceTableEntryDeltas[0].TryApply(entry1, appliedEntry));
+            VERIFY_IS_TRUE(appliedEntry == entry2);
+        }
+
+        //
+        // Versions that are not broadcast are skipped, so the delta is from the last broadcast version
+        //
+        SetServiceLocations(*failoverUnit, { L"A", L"E", L"D" });
+        UpdateLookupTable(*failoverUnit);
+        SetServiceLocations(*failoverUnit, { L"F", L"E", L"D" });
+        UpdateLookupTable(*failoverUnit);
+        auto entry4 = GetEntry(*failoverUnit);
+
+        auto body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 0u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 1u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas[0].BaseVersion, entry2.Version);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas[0].Version, entry4.Version);
+
+        ServiceTableEntry appliedEntry;
+        VERIFY_IS_TRUE(body.ServiceTableEntryDeltas[0].TryApply(entry2, appliedEntry));
+        VERIFY_IS_TRUE(appliedEntry == entry4);
+
+        // A node that missed the broadcast of entry2 cannot apply it
+        VERIFY_IS_FALSE(body.ServiceTableEntryDeltas[0].TryApply(entry1, appliedEntry));
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBroadcastDeltasResetOnRemove)
+    {
+        EnableDeltaBroadcast();
+
+        auto failoverUnit = CreateStatefulFailoverUnit({ L"A", L"B", L"C" });
+        UpdateLookupTable(*failoverUnit);
+        Broadcast();
+
+        FMServiceLookupTable & lookupTable = fm_->FailoverUnitCacheObj.ServiceLookupTable;
+        lookupTable.UpdateLookupVersion(*failoverUnit);
+        lookupTable.RemoveEntry(*failoverUnit);
+
+        SetServiceLocations(*failoverUnit, { L"A", L"B", L"D" });
+        UpdateLookupTable(*failoverUnit);
+        auto entry = GetEntry(*failoverUnit);
+
+        auto body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 0u);
+        VERIFY_IS_TRUE(find(body.ServiceTableEntries.begin(), body.ServiceTableEntries.end(), entry) != body.ServiceTableEntries.end());
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBroadcastDeltasResetOnEndVersion)
+    {
+        EnableDeltaBroadcast();
+
+        auto failoverUnit = CreateStatefulFailoverUnit({ L"A", L"B", L"C" });
+        UpdateLookupTable(*failoverUnit);
+        Broadcast();
+
+        FMServiceLookupTable & lookupTable = fm_->FailoverUnitCacheObj.ServiceLookupTable;
+        lookupTable.EndVersion = lookupTable.EndVersion;
+
+        SetServiceLocations(*failoverUnit, { L"A", L"B", L"D" });
+        UpdateLookupTable(*failoverUnit);
+
+        auto body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 1u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 0u);
+        VERIFY_IS_TRUE(body.ServiceTableEntries[0] == GetEntry(*failoverUnit));
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBroadcastDeltasRequireConfig)
+    {
+        // Deltas are only sent once they are enabled after the upgrade
+        VERIFY_IS_FALSE(FailoverConfig::GetConfig().EnableServiceTableUpdateDeltas);
+
+        auto failoverUnit = CreateStatefulFailoverUnit({ L"A", L"B", L"C" });
+        UpdateLookupTable(*failoverUnit);
+        Broadcast();
+
+        SetServiceLocations(*failoverUnit, { L"A", L"B", L"D" });
+        UpdateLookupTable(*failoverUnit);
+
+        auto body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 1u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 0u);
+
+        // The entries broadcast while deltas were disabled are not kept, so the first
+        // broadcast after enabling them sends the full entry
+        //
+        EnableDeltaBroadcast();
+
+        SetServiceLocations(*failoverUnit, { L"A", L"C", L"D" });
+        UpdateLookupTable(*failoverUnit);
+
+        body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 1u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 0u);
+
+        SetServiceLocations(*failoverUnit, { L"A", L"C", L"E" });
+        UpdateLookupTable(*failoverUnit);
+
+        body = Broadcast();
+        VERIFY_ARE_EQUAL(body.ServiceTableEntries.size(), 0u);
+        VERIFY_ARE_EQUAL(body.ServiceTableEntryDeltas.size(), 1u);
+    }
+
+    BOOST_AUTO_TEST_CASE(ServiceTableUpdateDeltaPerf_100K, * boost::unit_test::disabled())
+    {
+        RunDeltaBroadcastBenchmark(100000);
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 
+    ServiceTableEntry TestFMServiceLookupTable::CreateStatefulEntry(
+        ConsistencyUnitId const & cuid,
+        wstring const & primaryLocation,
+        vector<wstring> && secondaryLocations,
+        int64 version)
+    {
+        return ServiceTableEntry(
+            cuid,
+            L"fabric:/TestApp/TestService",
+            ServiceReplicaSet(true, true, wstring(primaryLocation), move(secondaryLocations), version));
+    }
+
+    FailoverUnitUPtr TestFMServiceLookupTable::CreateStatefulFailoverUnit(vector<wstring> const & locations)
+    {
+        auto failoverUnit = TestHelper::FailoverUnitFromString(L"3 2 SP 000/111 [1 N/P RD - Up] [2 N/S RD - Up] [3 N/S RD - Up]");
+        SetServiceLocations(*failoverUnit, locations);
+
+        return failoverUnit;
+    }
+
+    void TestFMServiceLookupTable::SetServiceLocations(FailoverUnit & failoverUnit, vector<wstring> const & locations)
+    {
+        size_t i = 0;
+        for (auto it = failoverUnit.BeginIterator; it != failoverUnit.EndIterator; ++it)
+        {
+            it->ServiceLocation = locations[i++];
+        }
+    }
+
+    void TestFMServiceLookupTable::EnableDeltaBroadcast()
+    {
+        FailoverConfig::GetConfig().EnableServiceTableUpdateDeltas = true;
+    }
+
+    void TestFMServiceLookupTable::UpdateLookupTable(FailoverUnit & failoverUnit)
+    {
+        FMServiceLookupTable & lookupTable = fm_->FailoverUnitCacheObj.ServiceLookupTable;
+        lookupTable.UpdateLookupVersion(failoverUnit);
+        lookupTable.Update(failoverUnit);
+    }
+
+    ServiceTableUpdateMessageBody TestFMServiceLookupTable::Broadcast()
+    {
+        ServiceTableUpdateMessageBody body;
+        VERIFY_IS_TRUE(fm_->FailoverUnitCacheObj.ServiceLookupTable.TryGetServiceTableUpdateMessageBody(body));
+
+        return body;
+    }
+
+    ServiceTableEntry TestFMServiceLookupTable::GetEntry(FailoverUnit const & failoverUnit)
+    {
+        ServiceTableEntry entry;
+        VERIFY_IS_TRUE(fm_->FailoverUnitCacheObj.ServiceLookupTable.TryGetEntry(ConsistencyUnitId(failoverUnit.Id.Guid), entry));
+
+        return entry;
+    }
+
+    // Simulates a failover of every partition in which the primary moves to the first secondary
+    // and the old primary is replaced by a replica on another node, and compares the size and
+    // processing time of broadcasting the new entries in full and as deltas.
+    void TestFMServiceLookupTable::RunDeltaBroadcastBenchmark(int partitionCount)
+    {
+        auto getLocation = [](int partition, int replica)
+        {
+            return wformatString("net.tcp://10.0.{0}.{1}:20001/{2}-{3}", partition % 256, replica, partition, replica);
+        };
+
+        vector<ServiceTableEntry> baseEntries;
+        vector<ServiceTableEntry> entries;
+        for (int i = 0; i < partitionCount; i++)
+        {
+            ConsistencyUnitId cuid(Guid::NewGuid());
+            baseEntries.push_back(CreateStatefulEntry(cuid, getLocation(i, 0), { getLocation(i, 1), getLocation(i, 2) }, i + 1));
+            entries.push_back(CreateStatefulEntry(cuid, getLocation(i, 1), { getLocation(i, 2), getLocation(i, 3) }, partitionCount + i + 1));
+        }
+
+        Stopwatch stopwatch;
+
+        // Full entries
+        stopwatch.Start();
+        ServiceTableUpdateMessageBody fullBody(vector<ServiceTableEntry>(entries), GenerationNumber(), VersionRangeCollection(1, 2 * partitionCount + 1), 2 * partitionCount + 1, false);
+        vector<byte> fullBytes;
+        VERIFY_IS_TRUE(FabricSerializer::Serialize(&fullBody, fullBytes).IsSuccess());
+        stopwatch.Stop();
+        auto fullSendTime = stopwatch.Elapsed;
+
+        stopwatch.Restart();
+        ServiceTableUpdateMessageBody receivedFullBody;
+        VERIFY_IS_TRUE(FabricSerializer::Deserialize(receivedFullBody, fullBytes).IsSuccess());
+        stopwatch.Stop();
+        auto fullReceiveTime = stopwatch.Elapsed;
+
+        // Deltas
+        stopwatch.Restart();
+        vector<ServiceTableEntryDelta> deltas;
+        for (int i = 0; i < partitionCount; i++)
+        {
+            ServiceTableEntryDelta delta;
+            VERIFY_IS_TRUE(ServiceTableEntryDelta::TryCreate(baseEntries[i], entries[i], delta));
+            deltas.push_back(move(delta));
+        }
+
+        ServiceTableUpdateMessageBody deltaBody(vector<ServiceTableEntry>(), move(deltas), GenerationNumber(), VersionRangeCollection(1, 2 * partitionCount + 1), 2 * partitionCount + 1, false);
+        vector<byte> deltaBytes;
+        VERIFY_IS_TRUE(FabricSerializer::Serialize(&deltaBody, deltaBytes).IsSuccess());
+        stopwatch.Stop();
+        auto deltaSendTime = stopwatch.Elapsed;
+
+        stopwatch.Restart();
+        ServiceTableUpdateMessageBody receivedDeltaBody;
+        VERIFY_IS_TRUE(FabricSerializer::Deserialize(receivedDeltaBody, deltaBytes).IsSuccess());
+        for (int i = 0; i < partitionCount; i++)
+        {
+            ServiceTableEntry entry;
+            VERIFY_IS_TRUE(receivedDeltaBody.ServiceTableEntryDeltas[i].TryApply(baseEntries[i], entry));
+        }
+        stopwatch.Stop();
+        auto deltaReceiveTime = stopwatch.Elapsed;
+
+        Trace.WriteInfo(
+            "ServiceLookupTableTestSource",
+            "Partitions={0}: full entries {1} bytes, send {2} ms, receive {3} ms; deltas {4} bytes, send {5} ms, receive {6} ms",
+            partitionCount,
+            fullBytes.size(),
+            fullSendTime.TotalMilliseconds(),
+            fullReceiveTime.TotalMilliseconds(),
+            deltaBytes.size(),
+            deltaSendTime.TotalMilliseconds(),
+            deltaReceiveTime.TotalMilliseconds());
+
+        VERIFY_IS_TRUE(deltaBytes.size() < fullBytes.size());
+    }
+
     bool TestFMServiceLookupTable::MethodSetup()
     {
         LoadBalancingComponent::PLBConfig::Test_Reset();
@@ -99,6 +99,19 @@ __int64 ServiceLookupTable::GetVersionForEntryCallerHoldingLock(ConsistencyUnitI
     }
 }
 
+ServiceTableEntrySPtr ServiceLookupTable::GetEntryCallerHoldingLock(ConsistencyUnitId const & cuid) const
+{
+    auto entryIter = idEntries_.find(cuid);
+    if (entryIter == idEntries_.end())
+    {
+        return nullptr;
+    }
+    else
+    {
+        return entryIter->second;
+    }
+}
+
 int64 ServiceLookupTable::GetUpdatedEntriesCallerHoldingLock(
     size_t pageSizeLimit,
     vector<ServiceTableEntry> & entries,
@@ -27,6 +27,9 @@ namespace Reliability
 
         __int64 GetVersionForEntryCallerHoldingLock(ConsistencyUnitId const & cuid) const;
 
+        // Entries are never modified once they are in the table, so the returned entry can be shared.
+        ServiceTableEntrySPtr GetEntryCallerHoldingLock(ConsistencyUnitId const & cuid) const;
+
         // If the newEntry does not already exists, inserts it to the table.
         // Otherwise, updates the existing entry.
         bool TryUpdateEntryCallerHoldingLock(ServiceTableEntrySPtr && newEntry);
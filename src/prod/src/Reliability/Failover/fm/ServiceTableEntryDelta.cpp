@@ -0,0 +1,172 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace Reliability;
+
+INITIALIZE_SIZE_ESTIMATION(ServiceTableEntryDelta)
+
+ServiceTableEntryDelta::ServiceTableEntryDelta()
+    : consistencyUnitId_(Guid::Empty()),
+    baseVersion_(0),
+    isPrimaryLocationValid_(false),
+    locationIndexes_(),
+    newLocations_(),
+    lookupVersion_(0)
+{
+}
+
+void ServiceTableEntryDelta::GetLocations(ServiceReplicaSet const & replicaSet, __out vector<wstring const *> & locations)
+{
+    locations.clear();
+
+    if (replicaSet.IsStateful)
+    {
+        if (replicaSet.IsPrimaryLocationValid)
+        {
+            locations.push_back(&replicaSet.PrimaryLocation);
+        }
+
+        for (auto const & location : replicaSet.SecondaryLocations)
+        {
+            locations.push_back(&location);
+        }
+    }
+    else
+    {
+        for (auto const & location : replicaSet.ReplicaLocations)
+        {
+            locations.push_back(&location);
+        }
+    }
+}
+
+bool ServiceTableEntryDelta::TryCreate(
+    ServiceTableEntry const & baseEntry,
+    ServiceTableEntry const & entry,
+    __out ServiceTableEntryDelta & delta)
+{
+    auto const & baseReplicaSet = baseEntry.ServiceReplicaSet;
+    auto const & replicaSet = entry.ServiceReplicaSet;
+
+    if (!baseEntry.IsFound ||
+        !entry.IsFound ||
+        baseEntry.ConsistencyUnitId != entry.ConsistencyUnitId ||
+        baseEntry.Version >= entry.Version ||
+        baseEntry.ServiceName != entry.ServiceName ||
+        baseReplicaSet.IsStateful != replicaSet.IsStateful ||
+        baseReplicaSet.IsEmpty() ||
+        replicaSet.IsEmpty())
+    {
+        return false;
+    }
+
+    vector<wstring const *> baseLocations;
+    GetLocations(baseReplicaSet, baseLocations);
+
+    vector<wstring const *> locations;
+    GetLocations(replicaSet, locations);
+
+    delta.consistencyUnitId_ = entry.ConsistencyUnitId;
+    delta.baseVersion_ = baseEntry.Version;
+    delta.isPrimaryLocationValid_ = (replicaSet.IsStateful && replicaSet.IsPrimaryLocationValid);
+    delta.locationIndexes_.clear();
+    delta.newLocations_.clear();
+    delta.lookupVersion_ = entry.Version;
+
+    // Replica sets are small, so a linear search is cheaper than building a map
+    //
+    for (auto location : locations)
+    {
+        auto it = find_if(baseLocations.begin(), baseLocations.end(), [location](wstring const * baseLocation) { return *baseLocation == *location; });
+        if (it == baseLocations.end())
+        {
+            delta.locationIndexes_.push_back(NewLocationIndex);
+            delta.newLocations_.push_back(*location);
+        }
+        else
+        {
+            delta.locationIndexes_.push_back(static_cast<int>(it - baseLocations.begin()));
+        }
+    }
+
+    return true;
+}
+
+bool ServiceTableEntryDelta::TryApply(ServiceTableEntry const & baseEntry, __out ServiceTableEntry & entry) const
+{
+    auto const & baseReplicaSet = baseEntry.ServiceReplicaSet;
+
+    if (baseEntry.ConsistencyUnitId != consistencyUnitId_ ||
+        baseEntry.Version != baseVersion_ ||
+        !baseEntry.IsFound ||
+        (isPrimaryLocationValid_ && !baseReplicaSet.IsStateful) ||
+        (isPrimaryLocationValid_ && locationIndexes_.empty()))
+    {
+        return false;
+    }
+
+    vector<wstring const *> baseLocations;
+    GetLocations(baseReplicaSet, baseLocations);
+
+    vector<wstring> locations;
+    locations.reserve(locationIndexes_.size());
+
+    size_t nextNewLocation = 0;
+    for (auto index : locationIndexes_)
+    {
+        if (index == NewLocationIndex)
+        {
+            if (nextNewLocation >= newLocations_.size())
+            {
+                return false;
+            }
+
+            locations.push_back(newLocations_[nextNewLocation++]);
+        }
+        else if (index >= 0 && static_cast<size_t>(index) < baseLocations.size())
+        {
+            locations.push_back(*baseLocations[index]);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    wstring primaryLocation;
+    if (isPrimaryLocationValid_)
+    {
+        primaryLocation = move(locations.front());
+        locations.erase(locations.begin());
+    }
+
+    entry = ServiceTableEntry(
+        consistencyUnitId_,
+        baseEntry.ServiceName,
+        ServiceReplicaSet(
+            baseReplicaSet.IsStateful,
+            isPrimaryLocationValid_,
+            move(primaryLocation),
+            move(locations),
+            lookupVersion_));
+
+    return true;
+}
+
+void ServiceTableEntryDelta::WriteTo(TextWriter & w, FormatOptions const &) const
+{
+    w.Write(
+        "{0} {1}->{2} IsPrimaryLocationValid={3} Indexes={4} NewLocations={5}",
+        consistencyUnitId_,
+        baseVersion_,
+        lookupVersion_,
+        isPrimaryLocationValid_,
+        locationIndexes_,
+        newLocations_);
+}
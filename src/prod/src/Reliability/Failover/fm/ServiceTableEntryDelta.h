@@ -0,0 +1,68 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Reliability
+{
+    //
+    // Encodes a ServiceTableEntry as the difference from an earlier version of the same entry.
+    // The service name, statefulness and found state are taken from the base entry. Each replica
+    // location is sent as an index into the locations of the base entry (the primary location,
+    // if valid, followed by the secondary or replica locations), or as a new location if it does
+    // not appear in the base entry. Moving the primary or replacing a replica therefore only
+    // sends the indexes and the new endpoints.
+    //
+    class ServiceTableEntryDelta
+        : public Serialization::FabricSerializable
+        , public Common::ISizeEstimator
+    {
+    public:
+        ServiceTableEntryDelta();
+
+        __declspec(property(get=get_ConsistencyUnitId)) Reliability::ConsistencyUnitId const & ConsistencyUnitId;
+        Reliability::ConsistencyUnitId const & get_ConsistencyUnitId() const { return consistencyUnitId_; }
+
+        __declspec(property(get=get_BaseVersion)) int64 BaseVersion;
+        int64 get_BaseVersion() const { return baseVersion_; }
+
+        __declspec(property(get=get_Version)) int64 Version;
+        int64 get_Version() const { return lookupVersion_; }
+
+        // Fails if the entry cannot be expressed as a delta from the base entry (e.g. it has been
+        // deleted, has no replicas, or belongs to a different service).
+        static bool TryCreate(
+            ServiceTableEntry const & baseEntry,
+            ServiceTableEntry const & entry,
+            __out ServiceTableEntryDelta & delta);
+
+        // Fails if the version of the base entry is not the version the delta was created from.
+        bool TryApply(ServiceTableEntry const & baseEntry, __out ServiceTableEntry & entry) const;
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
+
+        FABRIC_FIELDS_06(consistencyUnitId_, baseVersion_, isPrimaryLocationValid_, locationIndexes_, newLocations_, lookupVersion_);
+
+        BEGIN_DYNAMIC_SIZE_ESTIMATION()
+            DYNAMIC_SIZE_ESTIMATION_MEMBER(consistencyUnitId_)
+            DYNAMIC_SIZE_ESTIMATION_MEMBER(locationIndexes_)
+            DYNAMIC_SIZE_ESTIMATION_MEMBER(newLocations_)
+        END_DYNAMIC_SIZE_ESTIMATION()
+
+    private:
+        static int const NewLocationIndex = -1;
+
+        static void GetLocations(ServiceReplicaSet const & replicaSet, __out std::vector<std::wstring const *> & locations);
+
+        Reliability::ConsistencyUnitId consistencyUnitId_;
+        int64 baseVersion_;
+        bool isPrimaryLocationValid_;
+        std::vector<int> locationIndexes_;
+        std::vector<std::wstring> newLocations_;
+        int64 lookupVersion_;
+    };
+}
+
+DEFINE_USER_ARRAY_UTILITY(Reliability::ServiceTableEntryDelta);
@@ -24,7 +24,24 @@ namespace Reliability
             generation_(generation),
             versionRangeCollection_(std::move(versionRangeCollection)),
             endVersion_(endVersion),
-            isFromFMM_(isFromFMM)
+            isFromFMM_(isFromFMM),
+            serviceTableEntryDeltas_()
+        {
+        }
+
+        ServiceTableUpdateMessageBody(
+            std::vector<ServiceTableEntry> && serviceTableEntries,
+            std::vector<ServiceTableEntryDelta> && serviceTableEntryDeltas,
+            GenerationNumber const & generation,
+            Common::VersionRangeCollection && versionRangeCollection,
+            int64 endVersion,
+            bool isFromFMM)
+            :serviceTableEntries_(std::move(serviceTableEntries)),
+            generation_(generation),
+            versionRangeCollection_(std::move(versionRangeCollection)),
+            endVersion_(endVersion),
+            isFromFMM_(isFromFMM),
+            serviceTableEntryDeltas_(std::move(serviceTableEntryDeltas))
         {
         }
 
@@ -34,6 +51,11 @@ namespace Reliability
         __declspec (property(get=get_ServiceTableEntries)) std::vector<ServiceTableEntry> const& ServiceTableEntries;
         std::vector<ServiceTableEntry> const& get_ServiceTableEntries() const { return serviceTableEntries_; }
 
+        // Entries sent as the difference from the version in the previous broadcast. These are in
+        // addition to ServiceTableEntries and are covered by the same VersionRangeCollection.
+        __declspec (property(get=get_ServiceTableEntryDeltas)) std::vector<ServiceTableEntryDelta> const& ServiceTableEntryDeltas;
+        std::vector<ServiceTableEntryDelta> const& get_ServiceTableEntryDeltas() const { return serviceTableEntryDeltas_; }
+
         __declspec (property(get=get_VersionRangeCollection)) Common::VersionRangeCollection const& VersionRangeCollection;
         Common::VersionRangeCollection const& get_VersionRangeCollection() const { return versionRangeCollection_; }
 
@@ -46,13 +68,13 @@ namespace Reliability
         void WriteTo(Common::TextWriter& w, Common::FormatOptions const&) const
         {
             w.Write(
-                "Generation={0}, Entries={1}, VersionRanges={2}, EndVersion={3}, IsFromFMM={4}",
-                generation_, serviceTableEntries_.size(), versionRangeCollection_, endVersion_, isFromFMM_);
+                "Generation={0}, Entries={1}, Deltas={2}, VersionRanges={3}, EndVersion={4}, IsFromFMM={5}",
+                generation_, serviceTableEntries_.size(), serviceTableEntryDeltas_.size(), versionRangeCollection_, endVersion_, isFromFMM_);
         }
 
         void WriteToEtw(uint16 contextSequenceId) const;
 
-        FABRIC_FIELDS_05(serviceTableEntries_, generation_, versionRangeCollection_, endVersion_, isFromFMM_);
+        FABRIC_FIELDS_06(serviceTableEntries_, generation_, versionRangeCollection_, endVersion_, isFromFMM_, serviceTableEntryDeltas_);
 
     private:
         std::vector<ServiceTableEntry> serviceTableEntries_;
@@ -60,5 +82,6 @@ namespace Reliability
         Common::VersionRangeCollection versionRangeCollection_;
         int64 endVersion_;
         bool isFromFMM_;
+        std::vector<ServiceTableEntryDelta> serviceTableEntryDeltas_;
     };
 }
@@ -31,6 +31,7 @@
 #include "Reliability/Failover/fm/UpdateServiceMessageBody.h"
 #include "Reliability/Failover/fm/UpdateServiceReplyMessageBody.h"
 #include "Reliability/Failover/fm/ServiceTableRequestMessageBody.h"
+#include "Reliability/Failover/fm/ServiceTableEntryDelta.h"
 #include "Reliability/Failover/fm/ServiceTableUpdateMessageBody.h"
 #include "Reliability/Failover/fm/ActivateNodeRequestMessageBody.h"
 #include "Reliability/Failover/fm/UpdateSystemServiceMessageBody.h"
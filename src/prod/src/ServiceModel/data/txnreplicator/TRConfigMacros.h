@@ -8,7 +8,7 @@
 namespace TxnReplicator
 {
 
-#define TR_GLOBAL_SETTINGS_COUNT 9
+#define TR_GLOBAL_SETTINGS_COUNT 11
 #define TR_OVERRIDABLE_STATIC_SETTINGS_COUNT 8
 #define TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT 10
 #define TR_OVERRIDABLE_SETTINGS_COUNT (TR_OVERRIDABLE_STATIC_SETTINGS_COUNT + TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT)
@@ -72,6 +72,10 @@ namespace TxnReplicator
             double get_TestLogDelayProcessExitRatio() const; \
             __declspec(property(get=get_FlushedRecordsTraceVectorSize)) int64 FlushedRecordsTraceVectorSize ; \
             int64 get_FlushedRecordsTraceVectorSize() const; \
+            __declspec(property(get=get_BackupCompressionCodec)) int64 BackupCompressionCodec ; \
+            int64 get_BackupCompressionCodec() const; \
+            __declspec(property(get=get_BackupDegreeOfParallelism)) int64 BackupDegreeOfParallelism ; \
+            int64 get_BackupDegreeOfParallelism() const; \
 
 #define DEFINE_GET_TR_CONFIG_METHOD() \
             void GetTransactionalReplicatorSettingsStructValues(TxnReplicator::TRConfigValues & config) const \
@@ -134,6 +138,8 @@ namespace TxnReplicator
             int64 test_LogMaxDelayIntervalMilliseconds_; \
             double test_LogDelayRatio_; \
             double test_LogDelayProcessExitRatio_; \
+            int64 backupCompressionCodec_; \
+            int64 backupDegreeOfParallelism_; \
 
 /*ProgressVectorMaxEntires is set to the maximum number of records that can be traced*/
 #define TR_CONFIG_PROPERTIES(section_name)\
@@ -158,6 +164,8 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(uint, section_name, MaxStreamSizeInMB, 1024, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, ProgressVectorMaxEntries, 800, Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, FlushedRecordsTraceVectorSize, 32, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, BackupCompressionCodec, 0, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, BackupDegreeOfParallelism, 4, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, SerializationVersion, 0, Common::ConfigEntryUpgradePolicy::Static); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
@@ -189,6 +197,8 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, SlowLogIOHealthReportTTL, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, ProgressVectorMaxEntries, 800, Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, FlushedRecordsTraceVectorSize, 32, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, BackupCompressionCodec, 0, Common::ConfigEntryUpgradePolicy::Static); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, BackupDegreeOfParallelism, 4, Common::ConfigEntryUpgradePolicy::Static); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMaxDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
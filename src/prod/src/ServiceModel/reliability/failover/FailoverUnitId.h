@@ -12,6 +12,14 @@ namespace Reliability
         , public Common::IFabricJsonSerializable
     {
     public:
+        struct Hasher
+        {
+            size_t operator() (FailoverUnitId const & key) const
+            {
+                return (key.guid_.GetHashCode());
+            }
+        };
+
         FailoverUnitId()
             : guid_(ConsistencyUnitId::CreateNonreservedGuid())
         {
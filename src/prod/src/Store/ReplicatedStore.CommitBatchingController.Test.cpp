@@ -0,0 +1,137 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Store
+{
+    int const BatchingPeriodInMilliseconds = 50;
+    int const BatchingSizeLimit = 100;
+    int const LowWatermark = 0;
+    int const HighWatermark = 11;
+
+    class CommitBatchingControllerTest
+    {
+    protected:
+        typedef ReplicatedStore::CommitBatchingController Controller;
+
+        CommitBatchingControllerTest()
+            : settings_(
+                BatchingPeriodInMilliseconds,
+                BatchingSizeLimit,
+                LowWatermark,
+                HighWatermark,
+                0, // commitBatchingPeriodExtension
+                0, // throttleReplicationQueueOperationCount
+                0, // throttleReplicationQueueSizeBytes
+                false) // enableFlushOnDrain
+        {
+        }
+
+        static int GetMaxSizeLimit()
+        {
+            return BatchingSizeLimit * max(StoreConfig::GetConfig().AdaptiveCommitBatchingMaxSizeLimitFactor, 1);
+        }
+
+        ReplicatedStoreSettings settings_;
+    };
+
+    BOOST_FIXTURE_TEST_SUITE2(CommitBatchingControllerTestSuite, CommitBatchingControllerTest)
+
+    BOOST_AUTO_TEST_CASE(IdleTest)
+    {
+        Controller controller(settings_);
+        controller.OnGroupCommitted(TimeSpan::FromMilliseconds(20), 10);
+
+        // Only the transaction creating the group is pending, so the group is committed immediately
+        //
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(0), TimeSpan::Zero);
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(LowWatermark + 1), TimeSpan::Zero);
+        VERIFY_ARE_EQUAL2(controller.GetBatchingSizeLimit(LowWatermark + 1), BatchingSizeLimit);
+    }
+
+    BOOST_AUTO_TEST_CASE(GrowthUnderLoadTest)
+    {
+        Controller controller(settings_);
+        controller.OnGroupCommitted(TimeSpan::FromMilliseconds(20), 10);
+
+        // Half way between the watermarks
+        //
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(6), TimeSpan::FromMilliseconds(10));
+
+        // At the high watermark the period reaches the commit latency and the size limit reaches its maximum
+        //
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(20));
+        VERIFY_ARE_EQUAL2(controller.GetBatchingSizeLimit(HighWatermark), GetMaxSizeLimit());
+        VERIFY_ARE_EQUAL2(controller.GetBatchingSizeLimit(10 * HighWatermark), GetMaxSizeLimit());
+
+        auto previousPeriod = TimeSpan::Zero;
+        auto previousSizeLimit = 0;
+        for (int pending = LowWatermark + 1; pending <= HighWatermark; ++pending)
+        {
+            auto period = controller.GetBatchingPeriod(pending);
+            auto sizeLimit = controller.GetBatchingSizeLimit(pending);
+
+            VERIFY_IS_TRUE(period >= previousPeriod);
+            VERIFY_IS_TRUE(sizeLimit >= previousSizeLimit);
+
+            previousPeriod = period;
+            previousSizeLimit = sizeLimit;
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(ShrinkTest)
+    {
+        Controller controller(settings_);
+        controller.OnGroupCommitted(TimeSpan::FromMilliseconds(20), 10);
+
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(20));
+
+        // Faster commits shrink the batching period under the same load
+        //
+        for (int i = 0; i < 100; ++i)
+        {
+            controller.OnGroupCommitted(TimeSpan::FromMilliseconds(1), 10);
+        }
+
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(1));
+
+        // Groups with no committed transactions are not samples
+        //
+        controller.OnGroupCommitted(TimeSpan::FromMilliseconds(40), 0);
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(1));
+
+        // Once the load drops, groups are committed immediately again
+        //
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(LowWatermark + 1), TimeSpan::Zero);
+        VERIFY_ARE_EQUAL2(controller.GetBatchingSizeLimit(LowWatermark + 1), BatchingSizeLimit);
+    }
+
+    BOOST_AUTO_TEST_CASE(FlushOnTimeoutTest)
+    {
+        Controller controller(settings_);
+
+        // Without a latency sample, a loaded group still waits at least 1ms for the group timer
+        // so that it can fill up
+        //
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(1));
+
+        // Slow commits never delay the group timer beyond CommitBatchingPeriod, so a group that does
+        // not reach its size limit is still flushed when the configured period expires
+        //
+        controller.OnGroupCommitted(TimeSpan::FromSeconds(2), 10);
+
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(HighWatermark), TimeSpan::FromMilliseconds(BatchingPeriodInMilliseconds));
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(6), TimeSpan::FromMilliseconds(BatchingPeriodInMilliseconds));
+        VERIFY_ARE_EQUAL2(controller.GetBatchingPeriod(2), TimeSpan::FromMilliseconds(BatchingPeriodInMilliseconds));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
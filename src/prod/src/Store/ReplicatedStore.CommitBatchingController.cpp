@@ -0,0 +1,97 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Store
+{
+    // Weight of each new latency sample is 1/2^AvgCommitLatencyShift
+    //
+    static const int AvgCommitLatencyShift = 3;
+
+    ReplicatedStore::CommitBatchingController::CommitBatchingController(ReplicatedStoreSettings const & settings)
+        : configuredPeriodInMilliseconds_(settings.CommitBatchingPeriod)
+        , configuredSizeLimit_(settings.CommitBatchingSizeLimit)
+        , maxSizeLimitFactor_(max(StoreConfig::GetConfig().AdaptiveCommitBatchingMaxSizeLimitFactor, 1))
+        , lowWatermark_(settings.TransactionLowWatermark)
+        , highWatermark_(settings.TransactionHighWatermark)
+        , avgCommitLatencyInMicroseconds_(0)
+    {
+    }
+
+    TimeSpan ReplicatedStore::CommitBatchingController::GetBatchingPeriod(int pendingTransactions) const
+    {
+        auto loadFactor = this->GetLoadFactor(pendingTransactions);
+
+        if (loadFactor <= 0.0)
+        {
+            return TimeSpan::Zero;
+        }
+
+        // Waiting longer than a group commit currently takes only adds latency
+        // since the next group can start filling as soon as this one is closed.
+        //
+        auto latencyInMilliseconds = static_cast<double>(avgCommitLatencyInMicroseconds_.load()) / 1000;
+        auto targetInMilliseconds = static_cast<int64>(latencyInMilliseconds * loadFactor);
+
+        targetInMilliseconds = max<int64>(targetInMilliseconds, 1);
+        targetInMilliseconds = min<int64>(targetInMilliseconds, configuredPeriodInMilliseconds_);
+
+        return TimeSpan::FromMilliseconds(static_cast<double>(targetInMilliseconds));
+    }
+
+    int ReplicatedStore::CommitBatchingController::GetBatchingSizeLimit(int pendingTransactions) const
+    {
+        auto loadFactor = this->GetLoadFactor(pendingTransactions);
+
+        auto limit = static_cast<double>(configuredSizeLimit_) * (1.0 + (maxSizeLimitFactor_ - 1) * loadFactor);
+
+        return static_cast<int>(min<double>(limit, numeric_limits<int>::max()));
+    }
+
+    void ReplicatedStore::CommitBatchingController::OnGroupCommitted(TimeSpan const commitLatency, size_t committedTxCount)
+    {
+        if (committedTxCount == 0)
+        {
+            return;
+        }
+
+        auto sample = static_cast<uint64>(max<int64>(commitLatency.Ticks / (TimeSpan::TicksPerMillisecond / 1000), 0));
+        auto current = avgCommitLatencyInMicroseconds_.load();
+
+        if (current == 0)
+        {
+            avgCommitLatencyInMicroseconds_.store(sample);
+        }
+        else
+        {
+            auto delta = static_cast<int64>(sample) - static_cast<int64>(current);
+            avgCommitLatencyInMicroseconds_.store(static_cast<uint64>(static_cast<int64>(current) + (delta >> AvgCommitLatencyShift)));
+        }
+    }
+
+    double ReplicatedStore::CommitBatchingController::GetLoadFactor(int pendingTransactions) const
+    {
+        // pendingTransactions includes the transaction that is about to be
+        // grouped, so anything at or below one above the low watermark is idle.
+        //
+        if (pendingTransactions <= lowWatermark_ + 1)
+        {
+            return 0.0;
+        }
+
+        if (highWatermark_ <= lowWatermark_ + 1)
+        {
+            return 1.0;
+        }
+
+        auto factor = static_cast<double>(pendingTransactions - lowWatermark_ - 1) / (highWatermark_ - lowWatermark_ - 1);
+
+        return min(factor, 1.0);
+    }
+}
@@ -0,0 +1,45 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Store
+{
+    //
+    // Adapts the simple transaction group batching period and size limit to the
+    // current load. When the store is idle (no transactions pending other than
+    // the one creating the group), groups are committed immediately. As the
+    // number of pending transactions grows towards the high watermark, the
+    // batching period grows towards the smaller of the configured period and
+    // the observed group commit latency, and the batch size limit grows towards
+    // CommitBatchingSizeLimit * AdaptiveCommitBatchingMaxSizeLimitFactor.
+    //
+    class ReplicatedStore::CommitBatchingController
+    {
+        DENY_COPY(CommitBatchingController);
+
+    public:
+        explicit CommitBatchingController(ReplicatedStoreSettings const &);
+
+        Common::TimeSpan GetBatchingPeriod(int pendingTransactions) const;
+        int GetBatchingSizeLimit(int pendingTransactions) const;
+
+        void OnGroupCommitted(Common::TimeSpan const commitLatency, size_t committedTxCount);
+
+    private:
+        double GetLoadFactor(int pendingTransactions) const;
+
+        int configuredPeriodInMilliseconds_;
+        int configuredSizeLimit_;
+        int maxSizeLimitFactor_;
+        int lowWatermark_;
+        int highWatermark_;
+
+        // Exponentially weighted moving average of group commit latency. Updates
+        // can race with each other, which only loses a sample.
+        //
+        Common::atomic_uint64 avgCommitLatencyInMicroseconds_;
+    };
+}
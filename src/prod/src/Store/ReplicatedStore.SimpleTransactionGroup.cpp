@@ -170,6 +170,8 @@ namespace Store
 
         if (txReplicatorSPtr_)
         {
+            commitStopwatch_.Restart();
+
             WriteInfo(
                 TraceComponent, 
                 "{0}: SimpleTransactionGroup::BeginCommit: data size = {1}, total tx = {2}", 
@@ -204,6 +206,13 @@ namespace Store
 
         auto error = txReplicatorSPtr_->EndReplicate(operation, operationLSN);
 
+        if (error.IsSuccess())
+        {
+            commitStopwatch_.Stop();
+
+            replicatedStore_.OnSimpleTransactionGroupCommitted(commitStopwatch_.Elapsed, committedTxCount_);
+        }
+
         thisSPtr->TryComplete(thisSPtr, error);
 
         this->PostCompletions(error, operationLSN);
@@ -113,6 +113,7 @@ namespace Store
         // map of replicate async operations of all simple transactions.
         CommittedOperationMap commitMap_;
         size_t committedTxCount_;
+        Common::Stopwatch commitStopwatch_;
         
         ::FABRIC_SEQUENCE_NUMBER operationLSN_;
     };
@@ -286,6 +286,11 @@ namespace Store
 
         pendingTransactions_ = 0;
 
+        if (settings_.CommitBatchingPeriod > 0 && StoreConfig::GetConfig().EnableAdaptiveCommitBatching)
+        {
+            commitBatchingControllerUPtr_ = make_unique<CommitBatchingController>(settings_);
+        }
+
         test_SecondaryPumpEnabled_ = true;
         test_SlowCommitEnabled_ = StoreConfig::GetConfig().EnableSlowCommitTest;
         test_SecondaryApplyFaultInjectionEnabled_ = false;
@@ -523,6 +528,14 @@ namespace Store
         }
     }
 
+    void ReplicatedStore::OnSimpleTransactionGroupCommitted(TimeSpan const commitLatency, size_t committedTxCount)
+    {
+        if (commitBatchingControllerUPtr_)
+        {
+            commitBatchingControllerUPtr_->OnGroupCommitted(commitLatency, committedTxCount);
+        }
+    }
+
     ErrorCode ReplicatedStore::CreateSimpleTransaction(
         __out IStoreBase::TransactionSPtr & transactionSPtr)
     {
@@ -616,13 +629,22 @@ namespace Store
 
                     groupToCloseSPtr = move(simpleTransactionGroupSPtr_);
 
+                    auto sizeLimit = settings_.CommitBatchingSizeLimit;
+                    auto batchingPeriod = TimeSpan::FromMilliseconds(settings_.CommitBatchingPeriod);
+
+                    if (commitBatchingControllerUPtr_)
+                    {
+                        sizeLimit = commitBatchingControllerUPtr_->GetBatchingSizeLimit(pendingTransactions_);
+                        batchingPeriod = commitBatchingControllerUPtr_->GetBatchingPeriod(pendingTransactions_);
+                    }
+
                     simpleTransactionGroupSPtr_ = make_shared<SimpleTransactionGroup>(
                         *this,
-                        settings_.CommitBatchingSizeLimit,
+                        sizeLimit,
                         this->TryGetTxReplicator(),
                         move(innerTxSPtr),
                         activityId);
-                    simpleTransactionGroupTimer_->Change(TimeSpan::FromMilliseconds(settings_.CommitBatchingPeriod));
+                    simpleTransactionGroupTimer_->Change(batchingPeriod);
 
                     simpleTxSPtr = simpleTransactionGroupSPtr_->CreateSimpleTransaction(activityId);
                 }
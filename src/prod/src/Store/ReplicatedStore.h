@@ -21,6 +21,7 @@ namespace ReliabilityUnitTest
 namespace Store
 {
     class ReplicatedStoreTest;
+    class CommitBatchingControllerTest;
     class ComFabricStore_ReplicatedStoreRoot;
     class FabricTimeController;
     class FileStreamFullCopyManager;
@@ -537,12 +538,14 @@ namespace Store
         class SecondaryPump;
         class SimpleTransaction;
         class SimpleTransactionGroup;
+        class CommitBatchingController;
         class StateMachine;
         class TransactionReplicator;
         class TransactionTracker;
 
         friend class Reliability::FailoverManagerComponent::FailoverManager;
         friend class ReliabilityUnitTest::FailoverManagerStoreTest;
+        friend class CommitBatchingControllerTest;
 
         typedef std::shared_ptr<ReplicatedStore::SimpleTransactionGroup> SimpleTransactionGroupSPtr;
 
@@ -681,6 +684,7 @@ namespace Store
         void OnRollbackSimpleTransactionGroup(SimpleTransactionGroup * group);
         void CloseCurrentSimpleTransactionGroup();
         void InnerCloseCurrentSimpleTransactionGroup();
+        void OnSimpleTransactionGroupCommitted(Common::TimeSpan const commitLatency, size_t committedTxCount);
 
         Common::ErrorCode InitializeLocalStore(bool shouldExist);
         Common::ErrorCode InnerInitializeLocalStoreAndSerializer();
@@ -828,6 +832,7 @@ namespace Store
         Common::DateTime lastSimpleTransactionTimestamp_;
         Common::TimerSPtr simpleTransactionGroupTimer_;
         std::shared_ptr<SimpleTransactionGroup> simpleTransactionGroupSPtr_;
+        std::unique_ptr<CommitBatchingController> commitBatchingControllerUPtr_;
         RWLOCK(StoreTranscationGroup, transactionGroupLock_);
 
         // Used for testing error paths
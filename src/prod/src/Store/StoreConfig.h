@@ -116,6 +116,11 @@ namespace Store
         INTERNAL_CONFIG_ENTRY(int, L"ReplicatedStore", TombstoneMigrationBatchSize, 200000, Common::ConfigEntryUpgradePolicy::Dynamic);
         // The transaction batch size to use when replaying on a secondary replica in FABRIC_KEY_VALUE_STORE_FULL_COPY_MODE_REBUILD mode (dynamic, but requires replica restart)
         INTERNAL_CONFIG_ENTRY(int, L"ReplicatedStore", DatabaseRebuildBatchSizeInBytes, 2 * 1024 * 1024, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Adapts the simple transaction group batching period and size limit to the number of pending transactions
+        // and the observed group commit latency (requires replica restart). Only applies when CommitBatchingPeriod > 0.
+        INTERNAL_CONFIG_ENTRY(bool, L"ReplicatedStore", EnableAdaptiveCommitBatching, false, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Upper bound on the adaptive batch size limit as a multiple of CommitBatchingSizeLimit, reached at TransactionHighWatermark
+        INTERNAL_CONFIG_ENTRY(int, L"ReplicatedStore", AdaptiveCommitBatchingMaxSizeLimitFactor, 8, Common::ConfigEntryUpgradePolicy::Dynamic);
         
         INTERNAL_CONFIG_ENTRY(int, L"ReplicatedStore", ThrottleCountersRefreshIntervalInOperationCount, 256, Common::ConfigEntryUpgradePolicy::Static);
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"ReplicatedStore", ThrottleCountersRefreshInterval, Common::TimeSpan::FromSeconds(1), Common::ConfigEntryUpgradePolicy::Static);
@@ -55,6 +55,17 @@ namespace Store
             std::wstring const & keyPrefix,
             __out std::vector<TStoreData> &) const;
 
+        // Enumerates the matching entries and hands them to the callback in batches of at most batchSize,
+        // so that callers do not need to hold all entries of a type in memory at once. Enumeration stops
+        // on the first error returned by the callback.
+        //
+        template <class TStoreData>
+        Common::ErrorCode ReadPrefixInBatches(
+            std::wstring const & type,
+            std::wstring const & keyPrefix,
+            size_t batchSize,
+            std::function<Common::ErrorCode(std::vector<TStoreData> &&)> const & batchCallback) const;
+
         Common::ErrorCode TryReadOrInsertIfNotFound(__inout StoreData &, __out bool & readExisting) const;
         Common::ErrorCode InsertIfNotFound(__in StoreData &, __out bool & inserted) const;
         Common::ErrorCode InsertIfNotFound(__in StoreData &) const;
@@ -143,10 +154,49 @@ namespace Store
         std::wstring const & type,
         std::wstring const & keyPrefix,
         __out std::vector<TStoreData> & results) const
+    {
+        std::vector<TStoreData> tempResults;
+        ErrorCode error = this->ReadPrefixInBatches<TStoreData>(
+            type,
+            keyPrefix,
+            std::numeric_limits<size_t>::max(),
+            [&tempResults](std::vector<TStoreData> && batch) -> ErrorCode
+            {
+                if (tempResults.empty())
+                {
+                    tempResults.swap(batch);
+                }
+                else
+                {
+                    tempResults.insert(
+                        tempResults.end(), 
+                        std::make_move_iterator(batch.begin()), 
+                        std::make_move_iterator(batch.end()));
+                }
+
+                return ErrorCodeValue::Success;
+            });
+
+        if (error.IsSuccess())
+        {
+            results.swap(tempResults);
+        }
+
+        return error;
+    }
+
+    template <class TReplicatedStore> template <class TStoreData>
+    Common::ErrorCode StoreTransactionTemplate<TReplicatedStore>::ReadPrefixInBatches(
+        std::wstring const & type,
+        std::wstring const & keyPrefix,
+        size_t batchSize,
+        std::function<Common::ErrorCode(std::vector<TStoreData> &&)> const & batchCallback) const
     {
         if (!storeError_.IsSuccess()) { return storeError_; }
 
-        std::vector<TStoreData> tempResults;
+        if (batchSize == 0) { batchSize = 1; }
+
+        std::vector<TStoreData> batch;
         IStoreBase::EnumerationSPtr enumSPtr;
         ErrorCode error = store_->CreateEnumerationByTypeAndKey(
             txSPtr_,
@@ -196,7 +246,18 @@ namespace Store
                         obj.SetSequenceNumber(operationLSN);
                         obj.ReInitializeTracing(this->ReplicaActivityId);
 
-                        tempResults.push_back(std::move(obj));
+                        batch.push_back(std::move(obj));
+
+                        if (batch.size() >= batchSize)
+                        {
+                            error = batchCallback(std::move(batch));
+                            batch.clear();
+
+                            if (!error.IsSuccess())
+                            {
+                                break;
+                            }
+                        }
                     }
                     else
                     {
@@ -212,9 +273,9 @@ namespace Store
             }
         }
 
-        if (error.IsSuccess())
+        if (error.IsSuccess() && !batch.empty())
         {
-            results.swap(tempResults);
+            error = batchCallback(std::move(batch));
         }
 
         return error;
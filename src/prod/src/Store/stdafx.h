@@ -95,6 +95,7 @@ this assumption, we fail compilation here if that assumption is no longer valid.
 #include "Store/ReplicatedStore.TransactionBase.h"
 #include "Store/ReplicatedStore.Transaction.h"
 #include "Store/ReplicatedStore.Enumeration.h"
+#include "Store/ReplicatedStore.CommitBatchingController.h"
 #include "Store/ReplicatedStore.SimpleTransactionGroup.h"
 #include "Store/ReplicatedStore.SimpleTransaction.h"
 #include "Store/ReplicatedStore.TransactionReplicator.h"
@@ -52,6 +52,7 @@ namespace Transport
 
         virtual bool IsInbound() const = 0;
         virtual bool IsLoopback() const = 0; // Connected to loopback or local address?
+        virtual std::wstring TargetAddress() const = 0;
 
         virtual void UpdateInstance(ListenInstance const & remoteListenInstance) = 0;
 
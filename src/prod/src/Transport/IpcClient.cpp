@@ -43,7 +43,11 @@ IpcClient::IpcClient(
     : clientId_(clientId),
     traceId_(clientId.empty()? wformatString("{0}", TextTraceThis) : wformatString("{0}-{1}", TextTraceThis, clientId)),
     processId_(GetCurrentProcessId()),
+#ifdef PLATFORM_UNIX
+    serverTransportAddress_(TcpTransportUtility::GetIpcTransportAddress(serverTransportAddress)),
+#else
     serverTransportAddress_(serverTransportAddress),
+#endif
     transport_(CreateTransport(root, clientId, owner, useUnreliableTransport)),
     demuxer_(root, transport_),
     requestReply_(root, transport_, false /* dispatchOnTransportThread */),
@@ -32,9 +32,10 @@ namespace Transport
         Actor::Enum serverSideActor_;
         Actor::Enum clientSideActor_;
 
-        void OnewayTest(bool secureMode);
+        void OnewayTest(bool secureMode, std::wstring const & serverListenAddress = TTestUtil::GetListenAddress());
         void RequestReplyTest(bool secureMode);
         void ReconnectTest(bool secureMode);
+        void RoundTripPerfTest(std::wstring const & serverListenAddress, LONG roundTripCount, LONG burstCount);
 
         IpcServerSPtr OpenServer(std::wstring const & serverAddress, bool secureMode);
         IpcServerSPtr OpenServer(
@@ -87,6 +88,24 @@ namespace Transport
     }
 #endif
 
+#ifdef PLATFORM_UNIX
+    BOOST_AUTO_TEST_CASE(UnixDomainSocketOnewayTest)
+    {
+        ENTER;
+        OnewayTest(false, wformatString("unix:@IpcTest-{0}", ::GetCurrentProcessId()));
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(LoopbackVsUnixDomainSocketPerf, * boost::unit_test::disabled())
+    {
+        ENTER;
+        RoundTripPerfTest(TTestUtil::GetListenAddress(), 20000, 100000);
+        Setup();
+        RoundTripPerfTest(wformatString("unix:@IpcTest-{0}", ::GetCurrentProcessId()), 20000, 100000);
+        LEAVE;
+    }
+#endif
+
     BOOST_AUTO_TEST_CASE(InvalidAddressTest)
     {
         ENTER;
@@ -396,7 +415,7 @@ namespace Transport
         return true;
     }
 
-    void IpcTestBase::OnewayTest(bool secureMode)
+    void IpcTestBase::OnewayTest(bool secureMode, std::wstring const & serverListenAddress)
     {
         KFinally([this] { Cleanup(); });
 
@@ -407,7 +426,6 @@ namespace Transport
         auto& clients = root_->clients_;
 
         // set up IpcServer
-        std::wstring serverListenAddress = TTestUtil::GetListenAddress();
         server = OpenServer(serverListenAddress, secureMode);
         Common::atomic_long serverRequestCounter;
         Common::ManualResetEvent serverReceiveDone(false);
@@ -734,6 +752,79 @@ namespace Transport
         root_.reset();
     }
 
+    void IpcTestBase::RoundTripPerfTest(wstring const & serverListenAddress, LONG roundTripCount, LONG burstCount)
+    {
+        KFinally([this] { Cleanup(); });
+
+        auto& server = root_->server_;
+        auto& client = root_->client_;
+
+        server = OpenServer(serverListenAddress, false);
+        Common::atomic_long serverMessageCount;
+        Common::AutoResetEvent serverReceivedBurst(false);
+        server->RegisterMessageHandler(
+            serverSideActor_,
+            [&] (MessageUPtr &, IpcReceiverContextUPtr & context)
+            {
+                if (serverMessageCount.load() < 0)
+                {
+                    // latency phase, bounce the message back
+                    server->SendOneWay(context->From, CreateServerMessage(clientSideActor_));
+                }
+                else if (++ serverMessageCount == burstCount)
+                {
+                    serverReceivedBurst.Set();
+                }
+            },
+            true/*dispatchOnTransportThread*/);
+
+        client = OpenClient(L"client0", server->TransportListenAddress, false);
+        Common::AutoResetEvent clientReceivedReply(false);
+        client->RegisterMessageHandler(
+            clientSideActor_,
+            [&] (MessageUPtr &, IpcReceiverContextUPtr &)
+            {
+                clientReceivedReply.Set();
+            },
+            true/*dispatchOnTransportThread*/);
+
+        // Round trip latency: one message in flight at a time
+        serverMessageCount.store(-1);
+        client->SendOneWay(CreateClientMessage(serverSideActor_));
+        VERIFY_IS_TRUE(clientReceivedReply.WaitOne(TimeSpan::FromSeconds(30)));
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        for (LONG i = 0; i < roundTripCount; ++ i)
+        {
+            client->SendOneWay(CreateClientMessage(serverSideActor_));
+            VERIFY_IS_TRUE(clientReceivedReply.WaitOne(TimeSpan::FromSeconds(30)));
+        }
+
+        stopwatch.Stop();
+        double roundTripMicroseconds = stopwatch.Elapsed.TotalMillisecondsAsDouble() * 1000 / roundTripCount;
+
+        // Throughput: client to server oneway burst
+        serverMessageCount.store(0);
+        stopwatch.Restart();
+        for (LONG i = 0; i < burstCount; ++ i)
+        {
+            client->SendOneWay(CreateClientMessage(serverSideActor_));
+        }
+
+        VERIFY_IS_TRUE(serverReceivedBurst.WaitOne(TimeSpan::FromMinutes(2)));
+        stopwatch.Stop();
+
+        Trace.WriteInfo(
+            TraceType,
+            "{0}: average round trip {1} us over {2} messages, oneway throughput {3} messages/sec over {4} messages",
+            server->TransportListenAddress,
+            roundTripMicroseconds,
+            roundTripCount,
+            burstCount * 1000.0 / max<int64>(stopwatch.ElapsedMilliseconds, 1),
+            burstCount);
+    }
+
     IpcServerSPtr IpcTestBase::OpenServer(std::wstring const & serverAddress, bool secureMode)
     {
         return OpenServer(serverAddress, L"", secureMode);
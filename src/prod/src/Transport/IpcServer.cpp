@@ -206,7 +206,11 @@ IpcServer::IpcServer(
     wstring const & owner) :
     serverId_(serverId),
     traceId_(serverId.empty() ? wformatString("{0}", TextTraceThis) : wformatString("{0}-{1}", TextTraceThis, serverId)),
+#ifdef PLATFORM_UNIX
+    localUnit_(this, root, TcpTransportUtility::GetIpcTransportAddress(listenAddress), serverId, owner, traceId_, useUnreliableTransport),
+#else
     localUnit_(this, root, listenAddress, serverId, owner, traceId_, useUnreliableTransport),
+#endif
     tlsUnit_(listenAddressTls.empty() ? nullptr : make_unique<TransportUnit>(this, root, listenAddressTls, serverId, owner, traceId_, useUnreliableTransport))
 {
     ipcTrace.ServerCreated(traceId_, owner);
@@ -120,36 +120,32 @@ ErrorCode LTSendBuffer::Frame::EncryptIfNeeded(LTSendBuffer & sendBuffer)
     Invariant(securityContext->TransportSecurity().SecurityProvider == SecurityProvider::Ssl);
     auto securityContextSsl = (SecurityContextSsl*)securityContext;
     
-    //LINUXTODO avoid data copying during encryption
-    auto reserveSize = sizeof(header_) + message_->SerializedBodySize();
-    ByteBuffer2 buffer(reserveSize);
-    TcpConnection::WriteNoise(
-        TraceType, sendBuffer.connection_->TraceId(),
-        "Encrypt: {0}, plaintext length (including frame header) = {1}",
-        message_->TraceId(), buffer.size());
-
-    buffer.append(&header_, sizeof(header_));
+    // Encrypt from frame chunks directly, no plaintext copy of the frame
+    auto plaintextSize = sizeof(header_) + message_->SerializedBodySize();
+    vector<const_buffer> plaintext;
+    plaintext.emplace_back(&header_, sizeof(header_));
 
     for (BufferIterator chunk = message_->BeginBodyChunks(); chunk != message_->EndBodyChunks(); ++chunk)
     {
-        buffer.append(chunk->cbegin(), chunk->size());
+        plaintext.emplace_back(chunk->cbegin(), chunk->size());
     }
 
-    Invariant(buffer.size() == reserveSize); 
+    TcpConnection::WriteNoise(
+        TraceType, sendBuffer.connection_->TraceId(),
+        "Encrypt: {0}, plaintext length (including frame header) = {1}, chunks = {2}",
+        message_->TraceId(), plaintextSize, plaintext.size());
 
-    auto error = securityContextSsl->Encrypt(buffer.data(), buffer.size());
+    auto error = securityContextSsl->Encrypt(plaintext, encrypted_);
     if (!error.IsSuccess()) return error;
-
-    encrypted_ = securityContextSsl->EncryptFinal();
    
     // adjust for size change due to encryption
     auto bufferedBefore = sendBuffer.totalBufferedBytes_; 
-    sendBuffer.totalBufferedBytes_ -= buffer.size(); 
+    sendBuffer.totalBufferedBytes_ -= plaintextSize; 
     sendBuffer.totalBufferedBytes_ += encrypted_.size(); 
     TcpConnection::WriteNoise(
         TraceType, sendBuffer.connection_->TraceId(),
         "Encrypt: plain = {0}, encrypted = {1}, totalBufferedBytes_: before = {2}, after = {3}",
-        buffer.size(), encrypted_.size(), bufferedBefore, sendBuffer.totalBufferedBytes_);
+        plaintextSize, encrypted_.size(), bufferedBefore, sendBuffer.totalBufferedBytes_);
  
     return error;
 #else
@@ -50,7 +50,7 @@ void ListenSocket::AcceptCallback(int sd, uint events)
         return;
     }
 
-    socklen_t addrLen = sizeof(sockaddr_in6);
+    socklen_t addrLen = sizeof(sockaddr_storage);
     auto acceptedSd = accept(
         listenSocket_.GetHandle(),
         acceptedRemoteEndpoint_.as_sockaddr(),
@@ -92,13 +92,20 @@ ErrorCode ListenSocket::OnOpen()
         return error;
     }
 
-    error = listenSocket_.SetSocketOption(SOL_SOCKET, SO_REUSEADDR, 1);
-    if (!error.IsSuccess())
+    if (listenEndpoint_.IsUnixDomain())
     {
-         WriteError(
-            TraceType, traceId_,
-            "failed to enable SO_REUSEADDR: {0}", 
-            error);
+        RemoveStaleUnixDomainPath();
+    }
+    else
+    {
+        error = listenSocket_.SetSocketOption(SOL_SOCKET, SO_REUSEADDR, 1);
+        if (!error.IsSuccess())
+        {
+             WriteError(
+                TraceType, traceId_,
+                "failed to enable SO_REUSEADDR: {0}", 
+                error);
+        }
     }
  
     error = Bind();
@@ -175,6 +182,26 @@ ErrorCode ListenSocket::OnOpen()
     return error;
 }
 
+void ListenSocket::RemoveStaleUnixDomainPath()
+{
+    // SO_REUSEADDR has no effect on unix domain sockets, a path left behind by a previous
+    // listener must be removed before bind. Abstract names go away with the last socket.
+    auto sockAddrUn = reinterpret_cast<sockaddr_un const*>(listenEndpoint_.AsSockAddr);
+    if (sockAddrUn->sun_path[0] == 0)
+    {
+        return;
+    }
+
+    if ((unlink(sockAddrUn->sun_path) < 0) && (errno != ENOENT))
+    {
+        WriteWarning(
+            TraceType, traceId_,
+            "failed to remove {0}: {1}",
+            listenEndpoint_.ToString(),
+            ErrorCode::FromErrno());
+    }
+}
+
 ErrorCode ListenSocket::OnClose()
 {
     if (fdContext_)
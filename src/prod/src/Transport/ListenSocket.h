@@ -31,6 +31,7 @@ namespace Transport
     private:
 #ifdef PLATFORM_UNIX
         void AcceptCallback(int sd, uint events);
+        void RemoveStaleUnixDomainPath();
 
         Common::EventLoop & eventLoop_;
         Common::EventLoop::FdContext* fdContext_;
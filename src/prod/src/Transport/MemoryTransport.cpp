@@ -11,6 +11,8 @@ using namespace std;
 
 static Global<ExclusiveLock> transportTableLock = make_global<ExclusiveLock>();
 static Global<TransportTable> transportTable = make_global<TransportTable>();
+static Global<RwLock> dispatchObserverLock = make_global<RwLock>();
+static Global<MemoryTransport::DispatchObserver> dispatchObserver = make_global<MemoryTransport::DispatchObserver>();
 
 // static
 size_t MemoryTransport::TransportCount()
@@ -18,6 +20,13 @@ size_t MemoryTransport::TransportCount()
     return transportTable->Count();
 }
 
+// static
+void MemoryTransport::Test_SetDispatchObserver(DispatchObserver const & observer)
+{
+    AcquireWriteLock grab(*dispatchObserverLock);
+    *dispatchObserver = observer;
+}
+
 MemoryTransport::MemoryTransport(wstring const & name, std::wstring const & id)
     : started_(false)
     , stopped_(false)
@@ -186,17 +195,42 @@ Common::ErrorCode MemoryTransport::SendOneWay(
 
     // the target of the message will add the message into it's queue for processing and start a thread if needed.  Pass myTarget_ so the receiver knows who sent it
     ASSERT_IFNOT(this->myTarget_, "Send target is not set");
-    lockedTarget->EnqueueMessage(lockedTarget, make_unique<Message>(*message), this->myTarget_);
+    auto sendTime = Stopwatch::Now();
+    auto latency = TransportConfig::GetConfig().InMemoryTransportLatency;
+    if (latency > TimeSpan::Zero)
+    {
+        // simulated network latency, ordering between messages sent close together is not guaranteed
+        auto copy = make_shared<MessageUPtr>(make_unique<Message>(*message));
+        auto sender = this->myTarget_;
+        Threadpool::Post(
+            [lockedTarget, copy, sender, sendTime]() mutable
+            {
+                lockedTarget->EnqueueMessage(lockedTarget, move(*copy), sender, sendTime);
+            },
+            latency);
+    }
+    else
+    {
+        lockedTarget->EnqueueMessage(lockedTarget, make_unique<Message>(*message), this->myTarget_, sendTime);
+    }
 
     message = nullptr;
 
     return ErrorCodeValue::Success;
 }
 
-void MemoryTransport::HandleMessage(MessageUPtr && message, ISendTarget::SPtr const & sender)
+void MemoryTransport::HandleMessage(MessageUPtr && message, ISendTarget::SPtr const & sender, StopwatchTime sendTime)
 {
     ASSERT_IFNOT(this->started_, "Transport has not been started");
 
+    {
+        AcquireReadLock grab(*dispatchObserverLock);
+        if (*dispatchObserver)
+        {
+            (*dispatchObserver)(*message, sender->Address(), name_, Stopwatch::Now() - sendTime);
+        }
+    }
+
     // incoming message, handle it with default handler
     MessageHandler tempHandler;
     {
@@ -216,7 +250,11 @@ void MemoryTransport::HandleMessage(MessageUPtr && message, ISendTarget::SPtr co
 }
 
 // place message in target transport's queue and invoke a thread to drain it
-void MemoryTransport::EnqueueMessage(shared_ptr<MemoryTransport> & transport, MessageUPtr && message, ISendTarget::SPtr const & sender)
+void MemoryTransport::EnqueueMessage(
+    shared_ptr<MemoryTransport> & transport,
+    MessageUPtr && message,
+    ISendTarget::SPtr const & sender,
+    StopwatchTime sendTime)
 {
     ASSERT_IFNOT(this->started_, "Transport has not been started");
 
@@ -224,7 +262,7 @@ void MemoryTransport::EnqueueMessage(shared_ptr<MemoryTransport> & transport, Me
 
     AcquireExclusiveLock lock(this->messageTableLock_);
 
-    this->incomingMessages_.push(std::make_pair(std::move(message), sender));
+    this->incomingMessages_.push(IncomingMessage{ std::move(message), sender, sendTime });
 
     if (this->incomingMessages_.size() == 1)
     {
@@ -248,6 +286,7 @@ void MemoryTransport::PumpIncomingMessages()
     {
         MessageUPtr message;
         ISendTarget::SPtr target;
+        StopwatchTime sendTime;
 
         {   // scope the lock
             AcquireExclusiveLock lock(this->messageTableLock_);
@@ -258,14 +297,15 @@ void MemoryTransport::PumpIncomingMessages()
                 break;
             }
 
-            message = std::move(this->incomingMessages_.front().first);
-            target = std::move(this->incomingMessages_.front().second);
+            message = std::move(this->incomingMessages_.front().Msg);
+            target = std::move(this->incomingMessages_.front().Sender);
+            sendTime = this->incomingMessages_.front().SendTime;
 
             this->incomingMessages_.pop();
         }
 
         // dispatch outside lock
-        this->HandleMessage(std::move(message), target);
+        this->HandleMessage(std::move(message), target, sendTime);
     }
 }
 
@@ -15,6 +15,11 @@ namespace Transport
     public:
         static size_t TransportCount();
 
+        // Invoked on every message dispatched by any in-memory transport, with the time the message spent
+        // in flight and in the receive queue. Used by in-process simulations to collect protocol statistics.
+        typedef std::function<void(Message & message, std::wstring const & from, std::wstring const & to, Common::TimeSpan delay)> DispatchObserver;
+        static void Test_SetDispatchObserver(DispatchObserver const & observer);
+
         MemoryTransport(std::wstring const & name, std::wstring const & id);
         ~MemoryTransport() override;
 
@@ -102,9 +107,13 @@ namespace Transport
             std::wstring const & sspiTarget,
             uint64 instance) override;
 
-        void HandleMessage(MessageUPtr && message, ISendTarget::SPtr const & sender);
+        void HandleMessage(MessageUPtr && message, ISendTarget::SPtr const & sender, Common::StopwatchTime sendTime);
 
-        void EnqueueMessage(std::shared_ptr<MemoryTransport> & transport, MessageUPtr && message, ISendTarget::SPtr const & sender);
+        void EnqueueMessage(
+            std::shared_ptr<MemoryTransport> & transport,
+            MessageUPtr && message,
+            ISendTarget::SPtr const & sender,
+            Common::StopwatchTime sendTime);
 
         void PumpIncomingMessages();
 
@@ -118,7 +127,14 @@ namespace Transport
         ISendTarget::SPtr myTarget_;
 
         Common::ExclusiveLock messageTableLock_;
-        std::queue<std::pair<MessageUPtr, ISendTarget::SPtr >> incomingMessages_;
+        struct IncomingMessage
+        {
+            MessageUPtr Msg;
+            ISendTarget::SPtr Sender;
+            Common::StopwatchTime SendTime;
+        };
+
+        std::queue<IncomingMessage> incomingMessages_;
 
         TransportSecuritySPtr security_;
 
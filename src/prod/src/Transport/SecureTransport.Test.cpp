@@ -90,6 +90,17 @@ namespace Transport
 
         void FramingProtectionEnabled_Negotiate_ByConfig(ProtectionLevel::Enum protectionLevel);
 
+#ifdef PLATFORM_UNIX
+        static void SslThroughputPerf(uint messageCount, uint messageBodySize);
+        static void SslHandshakeRatePerf(uint connectionCount, bool sessionResumptionEnabled);
+        static void SslSessionResumption(bool authorizeResumedPeer);
+        static bool SslRoundTripOverNewTransport(
+            std::wstring const & receiverAddress,
+            SecuritySettings const & senderSecSettings,
+            std::wstring const & action,
+            Common::TimeSpan timeout);
+#endif
+
         SecurityTestSetup securityTestSetup_;
     };
 
@@ -1027,6 +1038,88 @@ namespace Transport
         LEAVE;
     }
 
+    BOOST_AUTO_TEST_CASE(SslThroughputPerfTest, * boost::unit_test::disabled())
+    {
+        ENTER;
+        SslThroughputPerf(1000, 64 * 1024);
+        SslThroughputPerf(100000, 256);
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SslHandshakeRatePerfTest, * boost::unit_test::disabled())
+    {
+        ENTER;
+        SslHandshakeRatePerf(200, false);
+        SslHandshakeRatePerf(200, true);
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SslSessionResumptionTest)
+    {
+        ENTER;
+        SslSessionResumption(true);
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SslSessionResumption_UnauthorizedPeerTest)
+    {
+        ENTER;
+        SslSessionResumption(false);
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SslSessionCacheTest)
+    {
+        ENTER;
+
+        auto sslCtx = SSL_CTX_new(SSLv23_method());
+        VERIFY_IS_TRUE(sslCtx != nullptr);
+        KFinally([=] { SSL_CTX_free(sslCtx); });
+
+        SslUPtr ssl(SSL_new(sslCtx));
+        VERIFY_IS_TRUE(ssl != nullptr);
+
+        SslSessionCache cache(2, TimeSpan::FromMinutes(5));
+
+        cache.Put(L"a", SslSessionUPtr(SSL_SESSION_new()));
+        cache.Put(L"b", SslSessionUPtr(SSL_SESSION_new()));
+        VERIFY_ARE_EQUAL2(cache.Size(), 2u);
+
+        // resuming "a" leaves "b" as the least recently used entry, which is evicted when "c" is added
+        VERIFY_IS_TRUE(cache.TrySetSession(L"a", ssl.get()));
+        cache.Put(L"c", SslSessionUPtr(SSL_SESSION_new()));
+        VERIFY_ARE_EQUAL2(cache.Size(), 2u);
+        VERIFY_IS_FALSE(cache.TrySetSession(L"b", ssl.get()));
+        VERIFY_IS_TRUE(cache.TrySetSession(L"a", ssl.get()));
+        VERIFY_IS_TRUE(cache.TrySetSession(L"c", ssl.get()));
+
+        // a new session of a cached peer replaces the old one
+        cache.Put(L"c", SslSessionUPtr(SSL_SESSION_new()));
+        VERIFY_ARE_EQUAL2(cache.Size(), 2u);
+
+        cache.Remove(L"a");
+        VERIFY_ARE_EQUAL2(cache.Size(), 1u);
+        VERIFY_IS_FALSE(cache.TrySetSession(L"a", ssl.get()));
+        VERIFY_IS_TRUE(cache.TrySetSession(L"c", ssl.get()));
+
+        cache.Remove(L"a");
+        VERIFY_ARE_EQUAL2(cache.Size(), 1u);
+
+        // "c" is the only entry left, so it is the least recently used one as well
+        cache.Put(L"d", SslSessionUPtr(SSL_SESSION_new()));
+        cache.Put(L"e", SslSessionUPtr(SSL_SESSION_new()));
+        VERIFY_ARE_EQUAL2(cache.Size(), 2u);
+        VERIFY_IS_FALSE(cache.TrySetSession(L"c", ssl.get()));
+
+        SslSessionCache expiringCache(2, TimeSpan::FromMilliseconds(100));
+        expiringCache.Put(L"a", SslSessionUPtr(SSL_SESSION_new()));
+        Sleep(200);
+        VERIFY_IS_FALSE(expiringCache.TrySetSession(L"a", ssl.get()));
+        VERIFY_ARE_EQUAL2(expiringCache.Size(), 0u);
+
+        LEAVE;
+    }
+
 #else
 
     BOOST_AUTO_TEST_CASE(ClaimsAuthTestsWithClientRoles)
@@ -3448,6 +3541,243 @@ namespace Transport
         ManyMessageTest(senderAddress, senderSecSettings, receiverAddress, receiverSecSettings);
     }
 
+#ifdef PLATFORM_UNIX
+
+    void SecureTransportTests::SslThroughputPerf(uint messageCount, uint messageBodySize)
+    {
+        InstallTestCertInScope senderCert(L"CN=sender.test.com");
+        InstallTestCertInScope receiverCert(L"CN=receiver.test.com");
+
+        auto sender = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+        auto receiver = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+
+        VERIFY_IS_TRUE(sender->SetSecurity(TTestUtil::CreateX509SettingsTp(
+            senderCert.Thumbprint()->PrimaryToString(), L"", receiverCert.Thumbprint()->PrimaryToString(), L"")).IsSuccess());
+        VERIFY_IS_TRUE(receiver->SetSecurity(TTestUtil::CreateX509SettingsTp(
+            receiverCert.Thumbprint()->PrimaryToString(), L"", senderCert.Thumbprint()->PrimaryToString(), L"")).IsSuccess());
+
+        auto action = TTestUtil::GetGuidAction();
+        TTestUtil::SetMessageHandler(sender, action, [](MessageUPtr &, ISendTarget::SPtr const &) {});
+
+        // one extra message completes negotiation before measuring
+        uint64 const expectedCount = messageCount + 1;
+        atomic_uint64 receiveCount(0);
+        ManualResetEvent allReceived(false);
+        TTestUtil::SetMessageHandler(
+            receiver,
+            action,
+            [&receiveCount, &allReceived, expectedCount](MessageUPtr &, ISendTarget::SPtr const &)
+            {
+                if (++receiveCount == expectedCount)
+                {
+                    allReceived.Set();
+                }
+            });
+
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+
+        auto target = sender->ResolveTarget(receiver->ListenAddress(), L"", TransportSecurity().LocalWindowsIdentity());
+        VERIFY_IS_TRUE(target);
+
+        auto warmup = make_unique<Message>(TestMessageBody(0));
+        warmup->Headers.Add(ActionHeader(action));
+        warmup->Headers.Add(MessageIdHeader());
+        sender->SendOneWay(target, move(warmup));
+        while (receiveCount.load() == 0)
+        {
+            this_thread::yield();
+        }
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (uint i = 0; i < messageCount; ++i)
+        {
+            auto message = make_unique<Message>(TestMessageBody(messageBodySize));
+            message->Headers.Add(ActionHeader(action));
+            message->Headers.Add(MessageIdHeader());
+            sender->SendOneWay(target, move(message));
+        }
+
+        VERIFY_IS_TRUE(allReceived.WaitOne(TimeSpan::FromMinutes(5)));
+        stopwatch.Stop();
+
+        double bytes = (double)messageCount * messageBodySize;
+        double seconds = stopwatch.Elapsed.TotalMillisecondsAsDouble() / 1000;
+        Trace.WriteInfo(
+            TraceType,
+            "SslThroughputPerf: {0} messages of {1} bytes in {2}, {3} MB/s, {4} messages/s",
+            messageCount,
+            messageBodySize,
+            stopwatch.Elapsed,
+            bytes / seconds / (1024 * 1024),
+            messageCount / seconds);
+
+        sender->Stop();
+        receiver->Stop();
+    }
+
+    void SecureTransportTests::SslHandshakeRatePerf(uint connectionCount, bool sessionResumptionEnabled)
+    {
+        auto saved = TransportConfig::GetConfig().SslSessionResumptionEnabled;
+        TransportConfig::GetConfig().SslSessionResumptionEnabled = sessionResumptionEnabled;
+        KFinally([=] { TransportConfig::GetConfig().SslSessionResumptionEnabled = saved; });
+
+        InstallTestCertInScope senderCert(L"CN=sender.test.com");
+        InstallTestCertInScope receiverCert(L"CN=receiver.test.com");
+
+        auto senderSecSettings = TTestUtil::CreateX509SettingsTp(
+            senderCert.Thumbprint()->PrimaryToString(), L"", receiverCert.Thumbprint()->PrimaryToString(), L"");
+
+        auto receiver = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+        VERIFY_IS_TRUE(receiver->SetSecurity(TTestUtil::CreateX509SettingsTp(
+            receiverCert.Thumbprint()->PrimaryToString(), L"", senderCert.Thumbprint()->PrimaryToString(), L"")).IsSuccess());
+
+        auto action = TTestUtil::GetGuidAction();
+        AutoResetEvent messageReceived;
+        TTestUtil::SetMessageHandler(
+            receiver,
+            action,
+            [&messageReceived](MessageUPtr &, ISendTarget::SPtr const &) { messageReceived.Set(); });
+
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        // every sender is a new transport, so every round trip requires a new connection and handshake
+        for (uint i = 0; i < connectionCount; ++i)
+        {
+            auto sender = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+            VERIFY_IS_TRUE(sender->SetSecurity(senderSecSettings).IsSuccess());
+            TTestUtil::SetMessageHandler(sender, action, [](MessageUPtr &, ISendTarget::SPtr const &) {});
+            VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+            auto target = sender->ResolveTarget(receiver->ListenAddress(), L"", TransportSecurity().LocalWindowsIdentity());
+            VERIFY_IS_TRUE(target);
+
+            auto message = make_unique<Message>(TestMessageBody(0));
+            message->Headers.Add(ActionHeader(action));
+            message->Headers.Add(MessageIdHeader());
+            sender->SendOneWay(target, move(message));
+
+            VERIFY_IS_TRUE(messageReceived.WaitOne(TimeSpan::FromSeconds(10)));
+            sender->Stop();
+        }
+
+        stopwatch.Stop();
+
+        Trace.WriteInfo(
+            TraceType,
+            "SslHandshakeRatePerf: sessionResumptionEnabled = {0}, {1} connections in {2}, {3} connections/s",
+            sessionResumptionEnabled,
+            connectionCount,
+            stopwatch.Elapsed,
+            connectionCount * 1000.0 / stopwatch.Elapsed.TotalMillisecondsAsDouble());
+
+        receiver->Stop();
+    }
+
+    void SecureTransportTests::SslSessionResumption(bool authorizeResumedPeer)
+    {
+        auto saved = TransportConfig::GetConfig().SslSessionResumptionEnabled;
+        TransportConfig::GetConfig().SslSessionResumptionEnabled = true;
+        KFinally([=] { TransportConfig::GetConfig().SslSessionResumptionEnabled = saved; });
+
+        InstallTestCertInScope senderCert(L"CN=sender.test.com");
+        InstallTestCertInScope receiverCert(L"CN=receiver.test.com");
+        InstallTestCertInScope otherCert(L"CN=other.test.com");
+
+        auto senderSecSettings = TTestUtil::CreateX509SettingsTp(
+            senderCert.Thumbprint()->PrimaryToString(), L"", receiverCert.Thumbprint()->PrimaryToString(), L"");
+
+        auto receiver = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+        VERIFY_IS_TRUE(receiver->SetSecurity(TTestUtil::CreateX509SettingsTp(
+            receiverCert.Thumbprint()->PrimaryToString(), L"", senderCert.Thumbprint()->PrimaryToString(), L"")).IsSuccess());
+
+        auto action = TTestUtil::GetGuidAction();
+        TTestUtil::SetMessageHandler(
+            receiver,
+            action,
+            [&receiver, &action](MessageUPtr &, ISendTarget::SPtr const & st)
+            {
+                auto reply = make_unique<Message>();
+                reply->Headers.Add(ActionHeader(action));
+                reply->Headers.Add(MessageIdHeader());
+                receiver->SendOneWay(st, move(reply));
+            });
+
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+
+        auto resumedCount = SecurityContextSsl::ResumedSessionCount();
+
+        // the first connection goes through a full handshake and caches the session
+        VERIFY_IS_TRUE(SslRoundTripOverNewTransport(receiver->ListenAddress(), senderSecSettings, action, TimeSpan::FromSeconds(10)));
+        VERIFY_ARE_EQUAL2(SecurityContextSsl::ResumedSessionCount(), resumedCount);
+
+        auto cachedCount = SslSessionCache::GetDefault().Size();
+        VERIFY_IS_TRUE(cachedCount > 0);
+
+        if (authorizeResumedPeer)
+        {
+            VERIFY_IS_TRUE(SslRoundTripOverNewTransport(receiver->ListenAddress(), senderSecSettings, action, TimeSpan::FromSeconds(10)));
+            VERIFY_ARE_EQUAL2(SecurityContextSsl::ResumedSessionCount(), resumedCount + 1);
+            VERIFY_ARE_EQUAL2(SslSessionCache::GetDefault().Size(), cachedCount);
+        }
+        else
+        {
+            // same local certificate and target, so the session is resumed, but the receiver certificate is not accepted
+            auto unauthorizedSecSettings = TTestUtil::CreateX509SettingsTp(
+                senderCert.Thumbprint()->PrimaryToString(), L"", otherCert.Thumbprint()->PrimaryToString(), L"");
+
+            VERIFY_IS_FALSE(SslRoundTripOverNewTransport(receiver->ListenAddress(), unauthorizedSecSettings, action, TimeSpan::FromSeconds(3)));
+            VERIFY_ARE_EQUAL2(SecurityContextSsl::ResumedSessionCount(), resumedCount + 1);
+            VERIFY_ARE_EQUAL2(SslSessionCache::GetDefault().Size(), cachedCount - 1);
+
+            // the session was removed from the cache, so the next connection goes through a full handshake
+            VERIFY_IS_TRUE(SslRoundTripOverNewTransport(receiver->ListenAddress(), senderSecSettings, action, TimeSpan::FromSeconds(10)));
+            VERIFY_ARE_EQUAL2(SecurityContextSsl::ResumedSessionCount(), resumedCount + 1);
+            VERIFY_ARE_EQUAL2(SslSessionCache::GetDefault().Size(), cachedCount);
+        }
+
+        receiver->Stop();
+    }
+
+    bool SecureTransportTests::SslRoundTripOverNewTransport(
+        wstring const & receiverAddress,
+        SecuritySettings const & senderSecSettings,
+        wstring const & action,
+        TimeSpan timeout)
+    {
+        // a new transport has no connection to reuse, so every round trip requires a new handshake
+        auto sender = DatagramTransportFactory::CreateTcp(L"127.0.0.1:0");
+        VERIFY_IS_TRUE(sender->SetSecurity(senderSecSettings).IsSuccess());
+
+        AutoResetEvent replyReceived;
+        TTestUtil::SetMessageHandler(
+            sender,
+            action,
+            [&replyReceived](MessageUPtr &, ISendTarget::SPtr const &) { replyReceived.Set(); });
+
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+        auto target = sender->ResolveTarget(receiverAddress, L"", TransportSecurity().LocalWindowsIdentity());
+        VERIFY_IS_TRUE(target);
+
+        auto message = make_unique<Message>();
+        message->Headers.Add(ActionHeader(action));
+        message->Headers.Add(MessageIdHeader());
+        sender->SendOneWay(target, move(message));
+
+        // session tickets are sent ahead of the reply, so the session is cached by the time the reply is received
+        auto replied = replyReceived.WaitOne(timeout);
+        sender->Stop();
+        return replied;
+    }
+
+#endif
+
     void SecureTransportTests::X509ManySmallMessage_SelfSigned(
         std::wstring const & senderAddress,
         std::wstring const & receiverAddress)
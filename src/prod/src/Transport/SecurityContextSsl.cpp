@@ -13,6 +13,15 @@ using namespace std;
 static const StringLiteral TraceType("SecurityContextSsl");
 static const Global<ThumbprintSet> emptyThumbprintSet = make_global<ThumbprintSet>();
 
+#ifdef PLATFORM_UNIX
+// Plaintext size limit of a TLS record
+static constexpr size_t SslRecordPlaintextMax = 16 * 1024;
+// Header, IV, MAC and padding, large enough for common cipher suites, larger overhead is handled by growing output buffer
+static constexpr size_t SslRecordOverheadEstimate = 96;
+
+atomic_uint64 SecurityContextSsl::resumedSessionCount_(0);
+#endif
+
 SecurityContextSsl::SecurityContextSsl(
     IConnectionSPtr const & connection,
     TransportSecuritySPtr const & transportSecurity,
@@ -196,45 +205,52 @@ SECURITY_STATUS SecurityContextSsl::OnNegotiateSecurityContext(
     }
 
 #ifdef PLATFORM_UNIX
-    if (!input.empty())
     {
-        //LINUXTODO consider avoid copying
-        //BUF_MEM bm = { .data = (char*)input.data(), .max = input.size(), .length = input.size() };
-        //BIO_set_mem_buf(inBio_, &bm, BIO_NOCLOSE);
-        auto retval = BIO_write(inBio_, input.data(), input.size());
-        Invariant(retval == input.size());
-    }
+        AcquireExclusiveLock grab(sslLock_);
 
-    auto retval = SSL_do_handshake(ssl_.get());
-    if (retval == 1)
-    {
-        negotiationState_ = SEC_E_OK;
-        WriteInfo(TraceType, id_, "SSL_do_handshake:1, handshake was successfully completed");
-    }
-    else
-    {
-        auto sslErr = SSL_get_error(ssl_.get(), retval);
-        WriteInfo(TraceType, id_, "SSL_do_handshake:{0}, SSL_get_error:{1}", retval, sslErr);
+        if (!input.empty())
+        {
+            AddDataToDecrypt(input.data(), input.size());
+        }
 
-        if (sslErr == SSL_ERROR_WANT_READ) // SSL_ERROR_WANT_WRITE is not possible with our socket layer 
+        auto retval = SSL_do_handshake(ssl_.get());
+        if (retval == 1)
         {
-            negotiationState_ = SEC_I_CONTINUE_NEEDED;
+            negotiationState_ = SEC_E_OK;
+            WriteInfo(
+                TraceType, id_,
+                "SSL_do_handshake:1, handshake was successfully completed, session reused = {0}",
+                SSL_session_reused(ssl_.get()));
+
+            if (!inbound_ && SSL_session_reused(ssl_.get()))
+            {
+                ++resumedSessionCount_;
+            }
         }
         else
         {
-            negotiationState_ = E_FAIL;
+            auto sslErr = SSL_get_error(ssl_.get(), retval);
+            WriteInfo(TraceType, id_, "SSL_do_handshake:{0}, SSL_get_error:{1}", retval, sslErr);
+
+            if (sslErr == SSL_ERROR_WANT_READ) // SSL_ERROR_WANT_WRITE is not possible with our socket layer 
+            {
+                negotiationState_ = SEC_I_CONTINUE_NEEDED;
+            }
+            else
+            {
+                negotiationState_ = E_FAIL;
+                RemoveCachedSession();
+            }
         }
-    }
 
-    char* data = nullptr;
-    SecBuffer& output = pOutput->pBuffers[0];
-    output.cbBuffer = BIO_ctrl_pending(outBio_);
-    Invariant(output.cbBuffer >= 0);
-    if (output.cbBuffer > 0)
-    {
-        output.pvBuffer = new BYTE[output.cbBuffer];
-        auto read = BIO_read(outBio_, output.pvBuffer, output.cbBuffer);//LINUXTODO avoid memory copy
-        Invariant(read == output.cbBuffer);
+        SecBuffer& output = pOutput->pBuffers[0];
+        output.cbBuffer = pendingOutput_.size();
+        if (output.cbBuffer > 0)
+        {
+            output.pvBuffer = new BYTE[output.cbBuffer];
+            memcpy(output.pvBuffer, pendingOutput_.data(), output.cbBuffer);
+            pendingOutput_.clear();
+        }
     }
 
 #else
@@ -378,7 +394,84 @@ SECURITY_STATUS SecurityContextSsl::ProcessClaimsMessage(MessageUPtr & message)
 
 #ifdef PLATFORM_UNIX
 
-ErrorCode SecurityContextSsl::Encrypt(void const* buffer, size_t len)
+ErrorCode SecurityContextSsl::Encrypt(vector<const_buffer> const & plaintext, ByteBuffer2 & encrypted)
+{
+    size_t plaintextSize = 0;
+    for (auto const & buffer : plaintext)
+    {
+        plaintextSize += buffer.len;
+    }
+
+    // ssl_ and the ciphertext buffers it writes to through bio_ are shared with DecodeMessage
+    AcquireExclusiveLock grab(sslLock_);
+
+    auto recordCount = plaintextSize / SslRecordPlaintextMax + 1;
+    ByteBuffer2 output(pendingOutput_.size() + plaintextSize + recordCount * SslRecordOverheadEstimate);
+
+    // Records written outside of Encrypt, e.g. alerts generated by SSL_read, must be sent first
+    if (!pendingOutput_.empty())
+    {
+        output.append(pendingOutput_.data(), pendingOutput_.size());
+        pendingOutput_.clear();
+    }
+
+    encryptOutput_ = &output;
+    KFinally([this] { encryptOutput_ = nullptr; encryptStaging_.clear(); });
+
+    ErrorCode error;
+    for (auto const & buffer : plaintext)
+    {
+        auto data = (byte const*)buffer.buf;
+        size_t remaining = buffer.len;
+        while (remaining > 0)
+        {
+            if (encryptStaging_.empty() && (remaining >= SslRecordPlaintextMax))
+            {
+                // Encrypt whole records straight from the chunk
+                auto toWrite = remaining - (remaining % SslRecordPlaintextMax);
+                error = SslWrite(data, toWrite);
+                if (!error.IsSuccess()) return error;
+
+                data += toWrite;
+                remaining -= toWrite;
+                continue;
+            }
+
+            // Coalesce small chunks, e.g. frame header and message headers, so they do not each take a record
+            auto toCopy = min(remaining, SslRecordPlaintextMax - encryptStaging_.size());
+            encryptStaging_.insert(encryptStaging_.end(), data, data + toCopy);
+            data += toCopy;
+            remaining -= toCopy;
+
+            if (encryptStaging_.size() == SslRecordPlaintextMax)
+            {
+                error = FlushEncryptStaging();
+                if (!error.IsSuccess()) return error;
+            }
+        }
+    }
+
+    error = FlushEncryptStaging();
+    if (!error.IsSuccess()) return error;
+
+    output.SetSizeAfterAppend();
+    encrypted = move(output);
+    return error;
+}
+
+ErrorCode SecurityContextSsl::FlushEncryptStaging()
+{
+    if (encryptStaging_.empty())
+    {
+        return ErrorCode();
+    }
+
+    auto error = SslWrite(encryptStaging_.data(), encryptStaging_.size());
+    encryptStaging_.clear();
+    return error;
+}
+
+ErrorCode SecurityContextSsl::SslWrite(void const* buffer, size_t len)
 {
     auto retval = SSL_write(ssl_.get(), buffer, len);
     ErrorCode error;
@@ -391,11 +484,6 @@ ErrorCode SecurityContextSsl::Encrypt(void const* buffer, size_t len)
     return error;
 }
 
-ByteBuffer2 SecurityContextSsl::EncryptFinal()
-{
-    return BioMemToByteBuffer2(outBio_);
-}
-
 SECURITY_STATUS SecurityContextSsl::DecodeMessage(MessageUPtr & message)
 {
     message;
@@ -404,18 +492,13 @@ SECURITY_STATUS SecurityContextSsl::DecodeMessage(MessageUPtr & message)
 
 SECURITY_STATUS SecurityContextSsl::DecodeMessage(bique<byte> & receiveQueue, bique<byte> & decrypted)
 {
-    // prepare data for decryption
-    size_t totalBufferUsed = receiveQueue.end() - receiveQueue.begin();
-    auto iter = receiveQueue.begin();
-    auto endIter = receiveQueue.end();
-    while (iter < endIter)
-    {
-        size_t chunkSize = (iter + iter.fragment_size() <= endIter)? iter.fragment_size() : (endIter - iter);
-        AddDataToDecrypt(&(*iter), chunkSize); 
-        iter += chunkSize;
-    }
+    // SSL_read pulls ciphertext from receiveQueue through bio_, see BioRead. SSL_read may also write, e.g.
+    // alerts and TLS 1.3 key update responses, so it must not run concurrently with Encrypt.
+    AcquireExclusiveLock grab(sslLock_);
 
-    receiveQueue.truncate_before(endIter);
+    size_t totalBufferUsed = receiveQueue.end() - receiveQueue.begin();
+    decryptInput_ = &receiveQueue;
+    KFinally([this] { decryptInput_ = nullptr; });
 
     // decryption
     auto beforeCapacity = decrypted.capacity();
@@ -463,6 +546,18 @@ SECURITY_STATUS SecurityContextSsl::DecodeMessage(bique<byte> & receiveQueue, bi
         Invariant(decryptIter < decryptLimit);
     }
 
+    // Keep ciphertext not consumed by SSL_read, e.g. after close_notify, for the next call
+    auto iter = receiveQueue.begin();
+    auto endIter = receiveQueue.end();
+    while (iter < endIter)
+    {
+        size_t chunkSize = (iter + iter.fragment_size() <= endIter)? iter.fragment_size() : (endIter - iter);
+        AddDataToDecrypt(&(*iter), chunkSize); 
+        iter += chunkSize;
+    }
+
+    receiveQueue.truncate_before(endIter);
+
     if (decryptedTotal) return SEC_E_OK; 
 
     return status;
@@ -470,16 +565,10 @@ SECURITY_STATUS SecurityContextSsl::DecodeMessage(bique<byte> & receiveQueue, bi
 
 void SecurityContextSsl::AddDataToDecrypt(void const* buffer, size_t len)
 {
-    //LINUXTODO do we need to clean up inBio_ or SSL_read will clean up?
-    auto written = BIO_write(inBio_, buffer, len);
-    ASSERT_IFNOT(
-        written == len,
-        "BIO_write returned {0}, input len = {1}, error = {2}",
-        written,
-        len,
-        cryptUtil_.GetOpensslErr().Message);
+    auto data = (byte const*)buffer;
+    pendingInput_.insert(pendingInput_.end(), data, data + len);
 
-    WriteNoise(TraceType, id_, "AddDataToDecrypt: written = {0}, BIO_ctrl_pending = {1}", written, BIO_ctrl_pending(inBio_));
+    WriteNoise(TraceType, id_, "AddDataToDecrypt: written = {0}, BIO_ctrl_pending = {1}", len, BIO_ctrl_pending(bio_));
 }
 
 constexpr size_t SecurityContextSsl::DecryptedPendingMax()
@@ -490,7 +579,7 @@ constexpr size_t SecurityContextSsl::DecryptedPendingMax()
 
 SECURITY_STATUS SecurityContextSsl::Decrypt(void* buffer, _Inout_ int64& len)
 {
-    auto pending = BIO_ctrl_pending(inBio_);
+    auto pending = BIO_ctrl_pending(bio_);
     auto bufferSize = len;
     len = SSL_read(ssl_.get(), buffer, len);
     if (len < 0)
@@ -499,13 +588,13 @@ SECURITY_STATUS SecurityContextSsl::Decrypt(void* buffer, _Inout_ int64& len)
         auto sslError = SSL_get_error(ssl_.get(), len);
         if (sslError == SSL_ERROR_WANT_READ)
         {
-            WriteNoise(TraceType, id_, "Decrypt: SSL_ERROR_WANT_READ, BIO_ctrl_pending = {0}", BIO_ctrl_pending(inBio_));
+            WriteNoise(TraceType, id_, "Decrypt: SSL_ERROR_WANT_READ, BIO_ctrl_pending = {0}", BIO_ctrl_pending(bio_));
             return STATUS_PENDING;
         }
 
         if (sslError == SSL_ERROR_SYSCALL)
         {
-            WriteNoise(TraceType, id_, "Decrypt: SSL_ERROR_SYSCALL, errno = {0}, BIO_ctrl_pending = {1}", err, BIO_ctrl_pending(inBio_));
+            WriteNoise(TraceType, id_, "Decrypt: SSL_ERROR_SYSCALL, errno = {0}, BIO_ctrl_pending = {1}", err, BIO_ctrl_pending(bio_));
             return STATUS_PENDING;
         }
 
@@ -537,15 +626,11 @@ void SecurityContextSsl::OnInitialize()
     auto param = SSL_get0_param(ssl_.get());
     LinuxCryptUtil::ApplyCrlCheckingFlag(param, transportSecurity_->Settings().X509CertChainFlags());
 
-    inBio_ = BIO_new(BIO_s_mem());
-    Invariant(inBio_);
-    BIO_set_mem_eof_return(inBio_, -1);
-
-    outBio_ = BIO_new(BIO_s_mem()); 
-    Invariant(outBio_);
-    BIO_set_mem_eof_return(outBio_, -1);
-
-    SSL_set_bio(ssl_.get(), inBio_, outBio_);
+    // One BIO for both directions, SSL_set_bio takes a single reference when rbio and wbio are the same.
+    // kTLS offload is not attempted, it requires a socket BIO, while records here are framed by transport.
+    bio_ = CreateBio(this);
+    Invariant(bio_);
+    SSL_set_bio(ssl_.get(), bio_, bio_);
 
     if (inbound_)
     {
@@ -554,7 +639,302 @@ void SecurityContextSsl::OnInitialize()
     else
     {
         SSL_set_connect_state(ssl_.get());
+        TryResumeSession();
+    }
+}
+
+void SecurityContextSsl::TryResumeSession()
+{
+    if (!TransportConfig::GetConfig().SslSessionResumptionEnabled)
+    {
+        return;
+    }
+
+    auto connection = connection_.lock();
+    if (!connection)
+    {
+        return;
+    }
+
+    // Local certificate is part of the key, so that certificate rollover starts a new session
+    sessionCacheKey_ = wformatString(
+        "{0};{1};{2}",
+        connection->TargetAddress(),
+        targetName_,
+        credentials_.front()->X509CertThumbprint());
+
+    auto resuming = SslSessionCache::GetDefault().TrySetSession(sessionCacheKey_, ssl_.get());
+    WriteInfo(TraceType, id_, "TryResumeSession: '{0}': {1}", sessionCacheKey_, resuming);
+}
+
+void SecurityContextSsl::RemoveCachedSession()
+{
+    if (inbound_ || sessionCacheKey_.empty())
+    {
+        return;
+    }
+
+    WriteInfo(TraceType, id_, "RemoveCachedSession: '{0}'", sessionCacheKey_);
+    sessionRemoved_.store(true);
+    SslSessionCache::GetDefault().Remove(sessionCacheKey_);
+}
+
+uint64 SecurityContextSsl::ResumedSessionCount()
+{
+    return resumedSessionCount_.load();
+}
+
+int SecurityContextSsl::NewSessionCallbackStatic(SSL* ssl, SSL_SESSION* session)
+{
+    // TLS 1.3 sends session tickets after the handshake, possibly more than one, so sessions are cached as
+    // they are received instead of being queried when SSL_do_handshake completes
+    auto thisPtr = (SecurityContextSsl*)SSL_get_app_data(ssl);
+    if (!thisPtr || thisPtr->inbound_ || thisPtr->sessionCacheKey_.empty() || thisPtr->sessionRemoved_.load())
+    {
+        // Not taking the reference, server side sessions are kept in the SSL_CTX session cache
+        return 0;
+    }
+
+    thisPtr->WriteInfo(TraceType, thisPtr->id_, "NewSessionCallback: caching session for '{0}'", thisPtr->sessionCacheKey_);
+
+    // Returning 1 passes the reference held by session to the cache
+    SslSessionCache::GetDefault().Put(thisPtr->sessionCacheKey_, SslSessionUPtr(session));
+    return 1;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+
+BIO* SecurityContextSsl::CreateBio(SecurityContextSsl* thisPtr)
+{
+    static BIO_METHOD* method = []
+    {
+        auto method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "SecurityContextSsl");
+        Invariant(method);
+        BIO_meth_set_write(method, BioWrite);
+        BIO_meth_set_read(method, BioRead);
+        BIO_meth_set_ctrl(method, BioCtrl);
+        BIO_meth_set_create(method, BioCreate);
+        BIO_meth_set_destroy(method, BioDestroy);
+        return method;
+    }();
+
+    auto bio = BIO_new(method);
+    if (bio)
+    {
+        BIO_set_data(bio, thisPtr);
+        BIO_set_init(bio, 1);
+    }
+
+    return bio;
+}
+
+SecurityContextSsl* SecurityContextSsl::GetBioContext(BIO* bio)
+{
+    return (SecurityContextSsl*)BIO_get_data(bio);
+}
+
+int SecurityContextSsl::BioCreate(BIO* bio)
+{
+    BIO_set_data(bio, nullptr);
+    BIO_set_init(bio, 0);
+    return 1;
+}
+
+int SecurityContextSsl::BioDestroy(BIO* bio)
+{
+    if (!bio) return 0;
+
+    BIO_set_data(bio, nullptr);
+    BIO_set_init(bio, 0);
+    return 1;
+}
+
+#else
+
+BIO* SecurityContextSsl::CreateBio(SecurityContextSsl* thisPtr)
+{
+    static BIO_METHOD method =
+    {
+        BIO_TYPE_SOURCE_SINK,
+        "SecurityContextSsl",
+        BioWrite,
+        BioRead,
+        nullptr, // bputs
+        nullptr, // bgets
+        BioCtrl,
+        BioCreate,
+        BioDestroy,
+        nullptr, // callback_ctrl
+    };
+
+    auto bio = BIO_new(&method);
+    if (bio)
+    {
+        bio->ptr = thisPtr;
+        bio->init = 1;
+    }
+
+    return bio;
+}
+
+SecurityContextSsl* SecurityContextSsl::GetBioContext(BIO* bio)
+{
+    return (SecurityContextSsl*)bio->ptr;
+}
+
+int SecurityContextSsl::BioCreate(BIO* bio)
+{
+    bio->ptr = nullptr;
+    bio->init = 0;
+    bio->num = 0;
+    bio->flags = 0;
+    return 1;
+}
+
+int SecurityContextSsl::BioDestroy(BIO* bio)
+{
+    if (!bio) return 0;
+
+    bio->ptr = nullptr;
+    bio->init = 0;
+    return 1;
+}
+
+#endif
+
+int SecurityContextSsl::BioWrite(BIO* bio, const char* buffer, int len)
+{
+    BIO_clear_retry_flags(bio);
+    if (len <= 0) return 0;
+
+    auto thisPtr = GetBioContext(bio);
+    auto output = thisPtr->encryptOutput_;
+    if (!output)
+    {
+        thisPtr->pendingOutput_.insert(thisPtr->pendingOutput_.end(), buffer, buffer + len);
+        return len;
+    }
+
+    size_t appended = output->AppendCursor() - output->data();
+    if ((appended + len) > output->size())
+    {
+        // Overhead estimate in Encrypt was short, resize() resets append cursor
+        output->resize(max(output->size() * 2, appended + len));
+        output->AdvanceAppendCursor(appended);
+    }
+
+    output->append(buffer, len);
+    return len;
+}
+
+int SecurityContextSsl::BioRead(BIO* bio, char* buffer, int len)
+{
+    BIO_clear_retry_flags(bio);
+    if (len <= 0) return 0;
+
+    auto thisPtr = GetBioContext(bio);
+    size_t read = 0;
+
+    auto & pending = thisPtr->pendingInput_;
+    if (thisPtr->pendingInputOffset_ < pending.size())
+    {
+        auto toRead = min((size_t)len, pending.size() - thisPtr->pendingInputOffset_);
+        memcpy(buffer, pending.data() + thisPtr->pendingInputOffset_, toRead);
+        thisPtr->pendingInputOffset_ += toRead;
+        read += toRead;
+
+        if (thisPtr->pendingInputOffset_ == pending.size())
+        {
+            pending.clear();
+            thisPtr->pendingInputOffset_ = 0;
+        }
     }
+
+    auto input = thisPtr->decryptInput_;
+    while (input && (read < (size_t)len) && (input->begin() < input->end()))
+    {
+        auto iter = input->begin();
+        auto endIter = input->end();
+        size_t chunkSize = (iter + iter.fragment_size() <= endIter)? iter.fragment_size() : (endIter - iter);
+        auto toRead = min(chunkSize, len - read);
+        memcpy(buffer + read, &(*iter), toRead);
+        input->truncate_before(iter + toRead);
+        read += toRead;
+    }
+
+    if (read == 0)
+    {
+        BIO_set_retry_read(bio);
+        return -1;
+    }
+
+    return (int)read;
+}
+
+long SecurityContextSsl::BioCtrl(BIO* bio, int cmd, long, void*)
+{
+    auto thisPtr = GetBioContext(bio);
+    switch (cmd)
+    {
+    case BIO_CTRL_PENDING:
+    {
+        size_t pending = thisPtr->pendingInput_.size() - thisPtr->pendingInputOffset_;
+        if (thisPtr->decryptInput_)
+        {
+            pending += thisPtr->decryptInput_->end() - thisPtr->decryptInput_->begin();
+        }
+
+        return pending;
+    }
+
+    case BIO_CTRL_WPENDING:
+        return thisPtr->pendingOutput_.size();
+
+    case BIO_CTRL_FLUSH:
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
+SECURITY_STATUS SecurityContextSsl::VerifyResumedSessionPeer(X509StackUPtr & peerChain)
+{
+    // Certificates are not exchanged on session resumption, CertVerifyCallback has not been called on this
+    // connection, so verify the peer certificate kept in session to collect chain errors for AuthorizeRemoteEnd
+    CertContextUPtr peerCert(SSL_get_peer_certificate(ssl_.get()));
+    if (!peerCert)
+    {
+        WriteInfo(TraceType, id_, "VerifyResumedSessionPeer: SSL_get_peer_certificate returned null");
+        return E_FAIL;
+    }
+
+    X509_STORE_CTX *storeCtx = X509_STORE_CTX_new();
+    Invariant(storeCtx);
+    KFinally([=] { X509_STORE_CTX_free(storeCtx); });
+
+    auto store = SSL_CTX_get_cert_store(SSL_get_SSL_CTX(ssl_.get()));
+    if (!X509_STORE_CTX_init(storeCtx, store, (X509*)peerCert.get(), SSL_get_peer_cert_chain(ssl_.get())))
+    {
+        WriteWarning(TraceType, id_, "VerifyResumedSessionPeer: X509_STORE_CTX_init failed: {0}", cryptUtil_.GetOpensslErr());
+        return E_FAIL;
+    }
+
+    X509_STORE_CTX_set_ex_data(storeCtx, SSL_get_ex_data_X509_STORE_CTX_idx(), ssl_.get());
+    X509_STORE_CTX_set_default(storeCtx, inbound_ ? "ssl_client" : "ssl_server");
+    X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(storeCtx), SSL_get0_param(ssl_.get()));
+    X509_STORE_CTX_set_verify_cb(storeCtx, CertVerifyCallbackStatic);
+
+    certChainErrors_.clear();
+    if (X509_verify_cert(storeCtx) <= 0)
+    {
+        auto err = X509_STORE_CTX_get_error(storeCtx);
+        WriteInfo(TraceType, id_, "VerifyResumedSessionPeer: X509_verify_cert failed: {0}:{1}", err, X509_verify_cert_error_string(err));
+        return E_FAIL;
+    }
+
+    peerChain = X509StackUPtr(X509_STORE_CTX_get1_chain(storeCtx));
+    return peerChain ? SEC_E_OK : E_FAIL;
 }
 
 int SecurityContextSsl::CertVerifyCallbackStatic(int preverify_ok, X509_STORE_CTX* ctx)
@@ -675,7 +1055,18 @@ SECURITY_STATUS SecurityContextSsl::AuthorizeRemoteEnd()
     //the auth checking here, but if we need to use it afterwards, e.g. AccessCheck(), we
     //will increment ref count in case the stack gets reset by renegotiation
     //https://www.openssl.org/docs/manmaster/ssl/SSL_get_peer_cert_chain.html
-    auto remoteCertChain = SSL_get_peer_cert_chain(ssl_.get());
+    X509StackUPtr resumedPeerChain;
+    if (SSL_session_reused(ssl_.get()))
+    {
+        auto status = VerifyResumedSessionPeer(resumedPeerChain);
+        if (FAILED(status))
+        {
+            RemoveCachedSession();
+            return status;
+        }
+    }
+
+    auto remoteCertChain = resumedPeerChain ? resumedPeerChain.get() : SSL_get_peer_cert_chain(ssl_.get());
     if (!remoteCertChain)
     {
         WriteInfo(TraceType, id_, "SSL_get_peer_cert_chain returned null");
@@ -695,7 +1086,7 @@ SECURITY_STATUS SecurityContextSsl::AuthorizeRemoteEnd()
 
     TryAuthenticateRemoteAsPeer();
 
-    if (inbound_)
+    if (inbound_ && !resumedPeerChain) // chain built on resumption already starts with peer certificate
     {
         clientCertStack = X509StackShallowUPtr(sk_X509_dup(remoteCertChain));
         sk_X509_insert(clientCertStack.get(), remoteCertContext_.get(), 0);
@@ -716,6 +1107,8 @@ SECURITY_STATUS SecurityContextSsl::AuthorizeRemoteEnd()
 
     if (!err.IsSuccess())
     {
+        // The session may have been cached when the handshake completed, it must not be resumed with a peer that failed authorization
+        RemoveCachedSession();
         return err.ToHResult(); 
     }
 
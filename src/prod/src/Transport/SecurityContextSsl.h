@@ -55,8 +55,14 @@ namespace Transport
         static SECURITY_STATUS Test_VerifyCertificate(_In_ PCCERT_CONTEXT certContext, std::wstring const & commonNameToMatch);
 
 #ifdef PLATFORM_UNIX
-        Common::ErrorCode Encrypt(void const* buffer, size_t len);
-        Common::ByteBuffer2 EncryptFinal();
+        // Encrypts a frame from its plaintext chunks directly into encrypted, without merging the chunks first
+        Common::ErrorCode Encrypt(std::vector<Common::const_buffer> const & plaintext, _Out_ Common::ByteBuffer2 & encrypted);
+
+        // SSL_CTX new session callback, caches sessions of outbound connections for resumption
+        static int NewSessionCallbackStatic(SSL* ssl, SSL_SESSION* session);
+
+        // Number of outbound handshakes completed by resuming a cached session
+        static uint64 ResumedSessionCount();
 #endif
 
         SECURITY_STATUS ProcessClaimsMessage(MessageUPtr & message) override;
@@ -143,15 +149,53 @@ namespace Transport
         static int CertVerifyCallbackStatic(int, X509_STORE_CTX*);
         int CertVerifyCallback(int, X509_STORE_CTX*);
 
+        // BIO connecting ssl_ to transport buffers, ciphertext is read from receive queue and written to send
+        // buffer directly during DecodeMessage and Encrypt, instead of going through memory BIOs
+        static BIO* CreateBio(SecurityContextSsl* thisPtr);
+        static SecurityContextSsl* GetBioContext(BIO* bio);
+        static int BioCreate(BIO* bio);
+        static int BioDestroy(BIO* bio);
+        static int BioWrite(BIO* bio, const char* buffer, int len);
+        static int BioRead(BIO* bio, char* buffer, int len);
+        static long BioCtrl(BIO* bio, int cmd, long num, void* ptr);
+
         void AddDataToDecrypt(void const* buffer, size_t len);
         SECURITY_STATUS Decrypt(void* buffer, _Inout_ int64& len);
         static constexpr size_t DecryptedPendingMax();
 
+        Common::ErrorCode SslWrite(void const* buffer, size_t len);
+        Common::ErrorCode FlushEncryptStaging();
+
+        void TryResumeSession();
+        void RemoveCachedSession();
+        SECURITY_STATUS VerifyResumedSessionPeer(_Out_ Common::X509StackUPtr & peerChain);
+
         Common::LinuxCryptUtil cryptUtil_;
-        BIO* inBio_ = nullptr;
-        BIO* outBio_ = nullptr;
+        BIO* bio_ = nullptr;
         SslUPtr ssl_;
+        // Serializes use of ssl_ between Encrypt, DecodeMessage and negotiation. OpenSSL does not support
+        // concurrent calls on one SSL object, and bio_ callbacks share the buffers below between directions.
+        Common::ExclusiveLock sslLock_;
         Common::LinuxCryptUtil::CertChainErrors certChainErrors_;
+
+        // Ciphertext destination of SSL_write, only set during Encrypt
+        Common::ByteBuffer2* encryptOutput_ = nullptr;
+        // Ciphertext written outside of Encrypt, e.g. handshake messages and alerts
+        std::vector<byte> pendingOutput_;
+        // Plaintext coalescing buffer for chunks smaller than a TLS record
+        std::vector<byte> encryptStaging_;
+
+        // Ciphertext source of SSL_read, only set during DecodeMessage
+        Common::bique<byte>* decryptInput_ = nullptr;
+        // Ciphertext not yet consumed by ssl_, read before decryptInput_
+        std::vector<byte> pendingInput_;
+        size_t pendingInputOffset_ = 0;
+
+        std::wstring sessionCacheKey_;
+        // Set once the cached session is removed, so that session tickets received afterwards are not cached
+        Common::atomic_bool sessionRemoved_;
+
+        static Common::atomic_uint64 resumedSessionCount_;
 #else
         std::vector<SecurityCredentialsSPtr> svrCredentials_;
         SecPkgContext_StreamSizes streamSizes_;
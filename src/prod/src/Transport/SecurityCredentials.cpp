@@ -15,6 +15,10 @@ namespace
 
     atomic_uint64 objCount(0);
 
+#ifdef PLATFORM_UNIX
+    const unsigned char SslSessionIdContext[] = "ServiceFabric.Transport";
+#endif
+
     struct SecurityCredentialsLess
     {
         bool operator() (SecurityCredentialsSPtr const & a, SecurityCredentialsSPtr const & b) const
@@ -93,6 +97,30 @@ SecurityCredentials::SecurityCredentials()
         auto err = LinuxCryptUtil().GetOpensslErr();
         Assert::CodingError("SSL_CTX_set_default_verify_paths failed: {0}:{1}", err.ReadValue(), err.Message);
     }
+
+    auto const & transportConfig = TransportConfig::GetConfig();
+    if (transportConfig.SslSessionResumptionEnabled)
+    {
+        // Server side session cache, shared by connections accepted with these credentials. Session id context
+        // must be set, or OpenSSL refuses to resume sessions when client certificates are verified.
+        // Client side caching must be on for OpenSSL to call the new session callback on outbound connections,
+        // which is how sessions from TLS 1.3 post-handshake tickets reach SslSessionCache.
+        SSL_CTX_set_session_cache_mode(sslCtx_, SSL_SESS_CACHE_BOTH);
+        SSL_CTX_sess_set_new_cb(sslCtx_, SecurityContextSsl::NewSessionCallbackStatic);
+        SSL_CTX_sess_set_cache_size(sslCtx_, transportConfig.SslSessionCacheSize);
+        SSL_CTX_set_timeout(sslCtx_, (long)transportConfig.SslSessionCacheTimeout.TotalSeconds());
+        retval = SSL_CTX_set_session_id_context(sslCtx_, SslSessionIdContext, sizeof(SslSessionIdContext) - 1);
+        if (!retval)
+        {
+            auto err = LinuxCryptUtil().GetOpensslErr();
+            Assert::CodingError("SSL_CTX_set_session_id_context failed: {0}:{1}", err.ReadValue(), err.Message);
+        }
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(sslCtx_, SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(sslCtx_, SSL_OP_NO_TICKET);
+    }
 #endif
 
     SecInvalidateHandle(&credentials_);
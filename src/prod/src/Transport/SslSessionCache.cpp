@@ -0,0 +1,116 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+namespace
+{
+    const StringLiteral TraceType("SslSessionCache");
+
+    INIT_ONCE initOnce = INIT_ONCE_STATIC_INIT;
+    Global<SslSessionCache> defaultCache;
+
+    BOOL CALLBACK InitFunction(PINIT_ONCE, PVOID, PVOID *)
+    {
+        auto const & config = TransportConfig::GetConfig();
+        defaultCache = make_global<SslSessionCache>(config.SslSessionCacheSize, config.SslSessionCacheTimeout);
+        return TRUE;
+    }
+}
+
+SslSessionCache & SslSessionCache::GetDefault()
+{
+    PVOID lpContext = NULL;
+    BOOL result = ::InitOnceExecuteOnce(&initOnce, InitFunction, NULL, &lpContext);
+    Invariant(result);
+    return *defaultCache;
+}
+
+SslSessionCache::SslSessionCache(size_t sizeLimit, TimeSpan timeout)
+    : sizeLimit_(sizeLimit)
+    , timeout_(timeout)
+{
+    WriteInfo(TraceType, "ctor: sizeLimit = {0}, timeout = {1}", sizeLimit_, timeout_);
+}
+
+bool SslSessionCache::TrySetSession(wstring const & peer, SSL* ssl)
+{
+    AcquireWriteLock grab(lock_);
+
+    auto entry = entries_.find(peer);
+    if (entry == entries_.end())
+    {
+        return false;
+    }
+
+    if (entry->second.Expiration <= Stopwatch::Now())
+    {
+        WriteNoise(TraceType, "session for {0} expired", peer);
+        Evict_CallerHoldingLock(entry);
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, entry->second.LruPosition);
+
+    // SSL_set_session takes its own reference on the session
+    return SSL_set_session(ssl, entry->second.Session.get()) == 1;
+}
+
+void SslSessionCache::Put(wstring const & peer, SslSessionUPtr && session)
+{
+    if (!session || (sizeLimit_ == 0))
+    {
+        return;
+    }
+
+    AcquireWriteLock grab(lock_);
+
+    auto expiration = Stopwatch::Now() + timeout_;
+    auto entry = entries_.find(peer);
+    if (entry != entries_.end())
+    {
+        entry->second.Session = move(session);
+        entry->second.Expiration = expiration;
+        lru_.splice(lru_.begin(), lru_, entry->second.LruPosition);
+        return;
+    }
+
+    if (entries_.size() >= sizeLimit_)
+    {
+        auto oldest = entries_.find(lru_.back());
+        Invariant(oldest != entries_.end());
+        Evict_CallerHoldingLock(oldest);
+    }
+
+    lru_.push_front(peer);
+    entries_.emplace(peer, Entry{ move(session), expiration, lru_.begin() });
+}
+
+void SslSessionCache::Remove(wstring const & peer)
+{
+    AcquireWriteLock grab(lock_);
+
+    auto entry = entries_.find(peer);
+    if (entry != entries_.end())
+    {
+        Evict_CallerHoldingLock(entry);
+    }
+}
+
+size_t SslSessionCache::Size() const
+{
+    AcquireReadLock grab(lock_);
+    return entries_.size();
+}
+
+void SslSessionCache::Evict_CallerHoldingLock(unordered_map<wstring, Entry>::iterator entry)
+{
+    lru_.erase(entry->second.LruPosition);
+    entries_.erase(entry);
+}
@@ -0,0 +1,46 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Client side TLS session cache, keyed on remote peer, so that reconnecting to the same peer
+    // can resume the previous session instead of going through a full handshake. Server side
+    // session state is cached by OpenSSL on the SSL_CTX of SecurityCredentials.
+    class SslSessionCache : public Common::TextTraceComponent<Common::TraceTaskCodes::Transport>
+    {
+        DENY_COPY(SslSessionCache);
+
+    public:
+        static SslSessionCache & GetDefault();
+
+        SslSessionCache(size_t sizeLimit, Common::TimeSpan timeout);
+
+        // Offers the cached session of peer for resumption on ssl, returns false if there is none
+        bool TrySetSession(std::wstring const & peer, SSL* ssl);
+        void Put(std::wstring const & peer, SslSessionUPtr && session);
+        void Remove(std::wstring const & peer);
+
+        size_t Size() const;
+
+    private:
+        struct Entry
+        {
+            SslSessionUPtr Session;
+            Common::StopwatchTime Expiration;
+            std::list<std::wstring>::iterator LruPosition;
+        };
+
+        void Evict_CallerHoldingLock(std::unordered_map<std::wstring, Entry>::iterator entry);
+
+        size_t const sizeLimit_;
+        Common::TimeSpan const timeout_;
+
+        mutable Common::RwLock lock_;
+        std::unordered_map<std::wstring, Entry> entries_;
+        std::list<std::wstring> lru_; // most recently used at front
+    };
+}
@@ -257,7 +257,7 @@ bool TcpConnection::FinishSocketInit()
         "FinishSocketInit: local message size limits:(incoming={0}/0x{0:x}, outgoing={1}/0x{1:x}), TcpNoDelayEnabled = {2}",
         maxIncomingFrameSizeInBytes_, maxOutgoingFrameSizeInBytes_, tcpNoDelayEnabled);
 
-    if (tcpNoDelayEnabled)
+    if (tcpNoDelayEnabled && !remoteEndpoint_.IsUnixDomain())
     {
         auto error = socket_.SetSocketOption(IPPROTO_TCP, TCP_NODELAY, 1);
         if (!error.IsSuccess())
@@ -1794,6 +1794,12 @@ bool TcpConnection::IsLoopback() const
     return TcpTransportUtility::IsLocalEndpoint(remoteEndpoint_);
 }
 
+wstring TcpConnection::TargetAddress() const
+{
+    AcquireReadLock grab(lock_);
+    return targetAddress_;
+}
+
 void TcpConnection::SetKeepAliveTimeout(Common::TimeSpan timeout)
 {
     keepAliveTimeout_ = timeout;
@@ -2206,12 +2212,20 @@ bool TcpConnection::PrepareConnect_CallerHoldingLock(Endpoint & sockName, ErrorC
 
     trace.BeginConnect(traceId_, localAddress_, targetAddress_, connectToAddress_);
 
-    Endpoint const * connectFrom = &::IPv4AnyAddress;
-    if (!remoteEndpoint_.IsIPv4())
+    // Unix domain sockets are left unbound on the connecting side
+    Endpoint const * connectFrom = nullptr;
+    if (remoteEndpoint_.IsIPv4())
+    {
+        connectFrom = &::IPv4AnyAddress;
+    }
+    else if (remoteEndpoint_.IsIPv6())
     {
-        ASSERT_IFNOT(remoteEndpoint_.IsIPv6(), "unexpected Endpoint type");
         connectFrom = &::IPv6AnyAddress;
     }
+    else
+    {
+        ASSERT_IFNOT(remoteEndpoint_.IsUnixDomain(), "unexpected Endpoint type");
+    }
 
     if (!socket_.closed())
     {
@@ -2226,7 +2240,7 @@ bool TcpConnection::PrepareConnect_CallerHoldingLock(Endpoint & sockName, ErrorC
         socket_.Close(SocketShutdown::None); // this is not the first connect attempt
     }
 
-    error = socket_.Open(Common::SocketType::Tcp, connectFrom->AddressFamily);
+    error = socket_.Open(Common::SocketType::Tcp, remoteEndpoint_.AddressFamily);
     if (!error.IsSuccess())
     {
         WriteError(
@@ -2236,14 +2250,17 @@ bool TcpConnection::PrepareConnect_CallerHoldingLock(Endpoint & sockName, ErrorC
         return false;
     }
 
-    error = socket_.Bind(*connectFrom);
-    if (!error.IsSuccess())
+    if (connectFrom)
     {
-        WriteError(
-            TraceType, traceId_,
-            "{0}-{1} failed to bind to local port for connecting: {2}",
-            localAddress_, targetAddress_, error);
-        return false;
+        error = socket_.Bind(*connectFrom);
+        if (!error.IsSuccess())
+        {
+            WriteError(
+                TraceType, traceId_,
+                "{0}-{1} failed to bind to local port for connecting: {2}",
+                localAddress_, targetAddress_, error);
+            return false;
+        }
     }
 
     error = Endpoint::GetSockName(socket_, sockName);
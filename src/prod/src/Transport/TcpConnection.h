@@ -89,6 +89,7 @@ namespace Transport
 
         bool IsInbound() const override;
         bool IsLoopback() const override;
+        std::wstring TargetAddress() const override;
 
         void UpdateInstance(ListenInstance const & remoteListenInstance) override;
 
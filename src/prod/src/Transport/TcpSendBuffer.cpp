@@ -98,36 +98,35 @@ ErrorCode TcpSendBuffer::Frame::EncryptIfNeeded(TcpSendBuffer & sendBuffer)
     Invariant(provider == SecurityProvider::Ssl || provider == SecurityProvider::Claims);
     auto securityContextSsl = (SecurityContextSsl*)securityContext;
     
-    //LINUXTODO avoid data copying during encryption
-    ByteBuffer2 buffer(header_.FrameLength());
-    TcpConnection::WriteNoise(
-        TraceType, sendBuffer.connection_->TraceId(),
-        "Encrypt: {0}, plaintext length (including frame header) = {1}",
-        message_->TraceId(), buffer.size());
-
-    buffer.append(&header_, sizeof(header_));
+    // Encrypt from frame chunks directly, no plaintext copy of the frame
+    vector<const_buffer> plaintext;
+    plaintext.emplace_back(&header_, sizeof(header_));
 
     for (BiqueChunkIterator chunk = message_->BeginHeaderChunks(); chunk != message_->EndHeaderChunks(); ++chunk)
     {
-        buffer.append(chunk->cbegin(), chunk->size());
+        plaintext.emplace_back(chunk->cbegin(), chunk->size());
     }
 
     for (BufferIterator chunk = message_->BeginBodyChunks(); chunk != message_->EndBodyChunks(); ++chunk)
     {
-        buffer.append(chunk->cbegin(), chunk->size());
+        plaintext.emplace_back(chunk->cbegin(), chunk->size());
     }
 
-    auto error = securityContextSsl->Encrypt(buffer.data(), buffer.size());
+    TcpConnection::WriteNoise(
+        TraceType, sendBuffer.connection_->TraceId(),
+        "Encrypt: {0}, plaintext length (including frame header) = {1}, chunks = {2}",
+        message_->TraceId(), header_.FrameLength(), plaintext.size());
+
+    auto error = securityContextSsl->Encrypt(plaintext, encrypted_);
     if (!error.IsSuccess()) return error;
 
-    encrypted_ = securityContextSsl->EncryptFinal();
     TcpConnection::WriteNoise(
         TraceType, sendBuffer.connection_->TraceId(),
         "Encrypt: ciphertext length = {0}",
         encrypted_.size());
 
     // adjust for size change due to encryption
-    sendBuffer.totalBufferedBytes_ -= buffer.size(); 
+    sendBuffer.totalBufferedBytes_ -= header_.FrameLength(); 
     sendBuffer.totalBufferedBytes_ += encrypted_.size(); 
 
     return error;
@@ -71,6 +71,35 @@ bool TcpTransportUtility::IsLoopbackAddress(wstring const & address)
     return StringUtility::StartsWithCaseInsensitive(address, localhost);
 }
 
+#ifdef PLATFORM_UNIX
+
+wstring TcpTransportUtility::GetIpcTransportAddress(wstring const & address)
+{
+    if (!TransportConfig::GetConfig().IpcUseUnixDomainSocket || Endpoint::IsUnixDomainAddress(address))
+    {
+        return address;
+    }
+
+    Endpoint endpoint;
+    if (!TryParseEndpointString(address, endpoint).IsSuccess() || !endpoint.IsLoopback())
+    {
+        return address;
+    }
+
+    // Abstract names are derived from the port, so that a client configured with the same loopback
+    // address maps it to the server's name. Dynamic ports get a name unique to this process instead,
+    // clients learn it from the server's listen address.
+    if (endpoint.Port == 0)
+    {
+        static atomic_uint64 dynamicAddressCount(0);
+        return wformatString("unix:@SFIpc-{0}-{1}", ::GetCurrentProcessId(), ++dynamicAddressCount);
+    }
+
+    return wformatString("unix:@SFIpc-{0}", endpoint.Port);
+}
+
+#endif
+
 ErrorCode TcpTransportUtility::GetLocalFqdn(std::wstring & hostname)
 {
     ADDRINFOW hint = {};
@@ -436,6 +465,13 @@ USHORT TcpTransportUtility::ParsePortString(wstring const & address)
 
 ErrorCode TcpTransportUtility::TryParseEndpointString(std::wstring const & address, Common::Endpoint & endpoint)
 {
+#ifdef PLATFORM_UNIX
+    if (Endpoint::IsUnixDomainAddress(address))
+    {
+        return Endpoint::TryParseUnixDomain(address, endpoint);
+    }
+#endif
+
     wstring host;
     wstring port;
 
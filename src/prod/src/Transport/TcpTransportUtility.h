@@ -58,6 +58,12 @@ namespace Transport
 
         static bool IsLoopbackAddress(std::wstring const & address);
 
+#ifdef PLATFORM_UNIX
+        // Returns the unix domain socket address to use in place of a loopback IPC address when
+        // TransportConfig::IpcUseUnixDomainSocket is enabled, other addresses are returned as is
+        static std::wstring GetIpcTransportAddress(std::wstring const & address);
+#endif
+
         // Note: local != loopback
         static bool IsLocalEndpoint(Common::Endpoint const & endpoint);
 
@@ -248,6 +248,32 @@ namespace TransportUnitTest
  
     }
 
+#ifdef PLATFORM_UNIX
+    BOOST_AUTO_TEST_CASE(TryParseUnixDomainEndpointString)
+    {
+        Endpoint ep;
+        auto err = TcpTransportUtility::TryParseEndpointString(L"unix:@SFIpc-1234-1", ep);
+        VERIFY_ARE_EQUAL2(err.ReadValue(), ErrorCodeValue::Success);
+        VERIFY_IS_TRUE(ep.IsUnixDomain());
+        VERIFY_IS_TRUE(ep.IsLoopback());
+        VERIFY_ARE_EQUAL2(ep.Port, 0);
+        VERIFY_ARE_EQUAL2(ep.ToString(), L"unix:@SFIpc-1234-1");
+        VERIFY_IS_TRUE(TcpTransportUtility::IsLoopbackAddress(L"unix:@SFIpc-1234-1"));
+
+        err = TcpTransportUtility::TryParseEndpointString(L"unix:/tmp/SFIpc.sock", ep);
+        VERIFY_ARE_EQUAL2(err.ReadValue(), ErrorCodeValue::Success);
+        VERIFY_ARE_EQUAL2(ep.ToString(), L"unix:/tmp/SFIpc.sock");
+
+        // accept() reports unbound peers with an empty path
+        err = TcpTransportUtility::TryParseEndpointString(L"unix:", ep);
+        VERIFY_ARE_EQUAL2(err.ReadValue(), ErrorCodeValue::Success);
+        VERIFY_ARE_EQUAL2(ep.ToString(), L"unix:");
+
+        err = TcpTransportUtility::TryParseEndpointString(L"unix:@" + wstring(200, L'x'), ep);
+        VERIFY_IS_FALSE(err.IsSuccess());
+    }
+#endif
+
     BOOST_AUTO_TEST_CASE(IsValidEndpointString)
     {
         VERIFY_IS_TRUE(TcpTransportUtility::IsValidEndpointString(L"127.0.0.1:65535"));
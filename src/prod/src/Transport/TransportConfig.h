@@ -61,6 +61,13 @@ namespace Transport
         // SecPkgContext_StreamSizes{cbHeader + cbMaximumMessage + cbTrailer}
         INTERNAL_CONFIG_ENTRY(uint, L"Transport", SslReceiveChunkSize, 64*1024, Common::ConfigEntryUpgradePolicy::Static, Common::InRange<uint>(32*1024, 8*1024*1024));
 
+        // Resume TLS sessions on reconnect instead of going through a full handshake, Linux only
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", SslSessionResumptionEnabled, true, Common::ConfigEntryUpgradePolicy::Static);
+        // Count of TLS sessions cached for resumption, per process on client side, per credentials on server side
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", SslSessionCacheSize, 1024, Common::ConfigEntryUpgradePolicy::Static);
+        // How long a cached TLS session can be resumed
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Transport", SslSessionCacheTimeout, Common::TimeSpan::FromMinutes(5), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+
         // Indicate how long an outgoing message can be queued until being sent or dropped, set to 0 to disable
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Transport", DefaultOutgoingMessageExpiration, Common::TimeSpan::FromSeconds(180), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanNoLessThan(Common::TimeSpan::Zero));
         // Indicate how often periodic outgoing message expiration check is done, set to 0 to disable
@@ -107,6 +114,9 @@ namespace Transport
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Transport", IpcReconnectDelay, Common::TimeSpan::FromSeconds(3), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanNoLessThan(Common::TimeSpan::Zero));
         // IpcClient exits process when disconnect count reaches the following limit, set to 0 to disable such process exit.
         INTERNAL_CONFIG_ENTRY(uint, L"Transport", IpcClientDisconnectLimit, 100, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Linux only: IPC servers and clients use unix domain sockets in place of loopback TCP addresses.
+        // Servers and clients must agree on this setting, and IPC to container hosts still goes over TCP.
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", IpcUseUnixDomainSocket, false, Common::ConfigEntryUpgradePolicy::Static);
 
         // Default close delay for scheduled close
         DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, L"Transport", DefaultCloseDelay, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic, Common::TimeSpanNoLessThan(Common::TimeSpan::Zero));
@@ -132,8 +142,19 @@ namespace Transport
         // Specifies if we support multi homing for non loopback addresses.
         INTERNAL_CONFIG_ENTRY(bool, L"Transport", AlwaysListenOnAnyAddress, true, Common::ConfigEntryUpgradePolicy::Static);
 
+        // Whether service communication listeners dispatch requests on the receiving thread when fewer than MaxConcurrentCalls
+        // requests are being dispatched, instead of handing every request to the dispatch queue. Off by default: when enabled,
+        // IServiceCommunicationMessageHandler::BeginProcessRequest runs on the transport receive thread, so a handler that
+        // blocks before returning its async operation stalls all further receives on that connection.
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", ServiceCommunicationInlineDispatchEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+        // Count of connections a service communication client opens to its service, requests are spread over them round robin.
+        // The extra connections are only used while the primary connection is connected.
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", ServiceCommunicationClientConnectionCount, 1, Common::ConfigEntryUpgradePolicy::Static, Common::UIntGreaterThan(0));
+
         // Whether to enable in-memory channel.
         TEST_CONFIG_ENTRY(bool, L"Transport", InMemoryTransportEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+        // Simulated one way latency of in-memory channel
+        TEST_CONFIG_ENTRY(Common::TimeSpan, L"Transport", InMemoryTransportLatency, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Static);
         
         // Count of concurrent event loops for sockets, linux only, default to 0 to use processor current. 
         DEPRECATED_CONFIG_ENTRY(uint, L"Transport", EventLoopConcurrency, 0, Common::ConfigEntryUpgradePolicy::Static);
@@ -66,6 +66,16 @@ struct SSL_Deleter
 
 typedef std::unique_ptr<SSL, SSL_Deleter> SslUPtr; 
 
+struct SSL_SESSION_Deleter
+{
+    void operator()(SSL_SESSION* session) const
+    {
+        if (session) SSL_SESSION_free(session);
+    }
+};
+
+typedef std::unique_ptr<SSL_SESSION, SSL_SESSION_Deleter> SslSessionUPtr;
+
 //typedef struct {} SecPkgContext_StreamSizes;
 
 struct CtxtHandle
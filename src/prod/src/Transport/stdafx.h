@@ -62,6 +62,9 @@
 #include "Transport/SecurityBuffers.h"
 #include "Transport/SecurityCredentials.h"
 #include "Transport/SecurityContext.h"
+#ifdef PLATFORM_UNIX
+#include "Transport/SslSessionCache.h"
+#endif
 #include "Transport/SecurityContextSsl.h"
 #include "Transport/SecurityContextWin.h"
 #include "Transport/CredentialType.h"
@@ -61,7 +61,20 @@ namespace Data
                 __in bool immediatelyClose,
                 __in FABRIC_REPLICA_ROLE replicaRole);
 
+            Awaitable<void> Test_BackupRestore_Throughput(
+                __in wstring const & workFolder,
+                __in wstring const & backupFolder,
+                __in Data::Log::LogManager & logManager,
+                __in KGuid const & partitionId,
+                __in FABRIC_REPLICA_ID replicaID,
+                __in int numberOfStateProviders,
+                __in int numberOfTxnPerSP,
+                __in int numberOfOperationPerTxn);
+
         protected:
+            static void SetBackupCompressionCodec(
+                __in CompressionCodec::Enum codec);
+
             static bool IsSameReplica(
                 __in KGuid const & sourcePartitionId,
                 __in FABRIC_REPLICA_ID sourceReplicaID,
@@ -557,6 +570,216 @@ namespace Data
             co_return;
         }
 
+        // Full backup and restore of TStore state providers, timing both.
+        // The codec used is the one set through SetBackupCompressionCodec.
+        Awaitable<void> BackupTests::Test_BackupRestore_Throughput(
+            __in wstring const & workFolder,
+            __in wstring const & backupFolder,
+            __in Data::Log::LogManager & logManager,
+            __in KGuid const & partitionId,
+            __in FABRIC_REPLICA_ID replicaID,
+            __in int numberOfStateProviders,
+            __in int numberOfTxnPerSP,
+            __in int numberOfOperationPerTxn)
+        {
+            NTSTATUS status = STATUS_UNSUCCESSFUL;
+
+            KAllocator & allocator = underlyingSystem_->PagedAllocator();
+
+            KString::SPtr backupFolderPath = KPath::CreatePath(backupFolder.c_str(), allocator);
+            TestBackupCallbackHandler::SPtr backupCallbackHandler = TestBackupCallbackHandler::Create(
+                *backupFolderPath,
+                allocator);
+
+            Data::Utilities::OperationData::SPtr initParams = Data::Utilities::OperationData::Create(allocator);
+            Data::Utilities::BinaryWriter bw(allocator);
+            bw.Write(L"Initial Value", Data::Utilities::UTF16);
+            initParams->Append(*bw.GetBuffer(0));
+
+            LONG64 const expectedCount = static_cast<LONG64>(numberOfTxnPerSP) * numberOfOperationPerTxn;
+
+            // Setting min log size in MB to 200 to avoid truncation of the log.
+            TRANSACTIONAL_REPLICATOR_SETTINGS txnReplicatorSettings = { 0 };
+            txnReplicatorSettings.Flags = FABRIC_TRANSACTIONAL_REPLICATOR_CHECKPOINT_THRESHOLD_MB;
+            txnReplicatorSettings.CheckpointThresholdInMB = 200;
+
+            {
+                Replica::SPtr replica = Replica::Create(
+                    partitionId,
+                    replicaID,
+                    workFolder,
+                    logManager,
+                    allocator,
+                    nullptr,
+                    &txnReplicatorSettings);
+
+                co_await replica->OpenAsync();
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_RECONFIGURATION_PENDING);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_RECONFIGURATION_PENDING);
+
+                FABRIC_EPOCH epoch1; epoch1.DataLossNumber = 1; epoch1.ConfigurationNumber = 1; epoch1.Reserved = nullptr;
+                co_await replica->ChangeRoleAsync(epoch1, FABRIC_REPLICA_ROLE_PRIMARY);
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+
+                for (int i = 0; i < numberOfStateProviders; ++i)
+                {
+                    Transaction::SPtr txn;
+                    replica->TxnReplicator->CreateTransaction(txn);
+                    KFinally([&] {txn->Dispose(); });
+
+                    KUri::CSPtr stateProviderName = GetStateProviderName(i);
+                    status = co_await replica->TxnReplicator->AddAsync(
+                        *txn,
+                        *stateProviderName,
+                        L"StoreType",
+                        initParams.RawPtr());
+                    VERIFY_IS_TRUE(NT_SUCCESS(status));
+                    co_await txn->CommitAsync();
+                }
+
+                KArray<Awaitable<NTSTATUS>> awaitableArray(allocator);
+                for (int i = 0; i < numberOfStateProviders; ++i)
+                {
+                    KUri::CSPtr stateProviderName = GetStateProviderName(i);
+                    Data::TStore::IStore<int, int>::SPtr store;
+                    status = GetStore<int, int>(*replica->TxnReplicator, *stateProviderName, store);
+                    VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+                    Awaitable<NTSTATUS> awaitable = PopulateAsync(*underlyingSystem_, *replica->TxnReplicator, *store, 0, numberOfTxnPerSP, numberOfOperationPerTxn);
+                    status = awaitableArray.Append(Ktl::Move(awaitable));
+                    VERIFY_IS_TRUE(NT_SUCCESS(status));
+                }
+
+                status = co_await Data::Utilities::TaskUtilities<NTSTATUS>::WhenAll_NoException(awaitableArray);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+                // Checkpoint so that the backup contains the store files instead of only the log.
+                status = replica->TxnReplicator->Test_RequestCheckpointAfterNextTransaction();
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+                {
+                    Transaction::SPtr txn;
+                    replica->TxnReplicator->CreateTransaction(txn);
+                    KFinally([&] {txn->Dispose(); });
+
+                    status = co_await replica->TxnReplicator->AddAsync(
+                        *txn,
+                        *GetStateProviderName(numberOfStateProviders),
+                        L"StoreType",
+                        initParams.RawPtr());
+                    VERIFY_IS_TRUE(NT_SUCCESS(status));
+                    co_await txn->CommitAsync();
+                }
+
+                Stopwatch backupStopwatch;
+                backupStopwatch.Start();
+
+                BackupInfo result;
+                status = co_await replica->TxnReplicator->BackupAsync(*backupCallbackHandler, result);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+                backupStopwatch.Stop();
+
+                Trace.WriteInfo(
+                    TraceComponent,
+                    "Full backup of {0} state providers with {1} items each took {2} ms",
+                    numberOfStateProviders,
+                    expectedCount,
+                    backupStopwatch.ElapsedMilliseconds);
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+
+                co_await replica->CloseAsync();
+            }
+
+            {
+                TestDataLossHandler::SPtr dataLossHandler = TestDataLossHandler::Create(
+                    allocator,
+                    backupFolderPath.RawPtr(),
+                    FABRIC_RESTORE_POLICY_FORCE);
+
+                Replica::SPtr replica = Replica::Create(
+                    partitionId,
+                    replicaID,
+                    workFolder,
+                    logManager,
+                    allocator,
+                    nullptr,
+                    &txnReplicatorSettings,
+                    dataLossHandler.RawPtr());
+
+                dataLossHandler->Initialize(*replica->TxnReplicator);
+
+                co_await replica->OpenAsync();
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_RECONFIGURATION_PENDING);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_RECONFIGURATION_PENDING);
+
+                FABRIC_EPOCH epoch2; epoch2.DataLossNumber = 2; epoch2.ConfigurationNumber = 2; epoch2.Reserved = nullptr;
+                co_await replica->ChangeRoleAsync(epoch2, FABRIC_REPLICA_ROLE_PRIMARY);
+
+                Stopwatch restoreStopwatch;
+                restoreStopwatch.Start();
+
+                BOOLEAN isStateChanged = false;
+                status = co_await replica->OnDataLossAsync(isStateChanged);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_TRUE(isStateChanged == TRUE);
+
+                restoreStopwatch.Stop();
+
+                Trace.WriteInfo(
+                    TraceComponent,
+                    "Restore of {0} state providers with {1} items each took {2} ms",
+                    numberOfStateProviders,
+                    expectedCount,
+                    restoreStopwatch.ElapsedMilliseconds);
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_GRANTED);
+
+                // Verify restored state
+                for (int i = 0; i < numberOfStateProviders; ++i)
+                {
+                    Data::TStore::IStore<int, int>::SPtr store;
+                    status = GetStore<int, int>(*replica->TxnReplicator, *GetStateProviderName(i), store);
+                    VERIFY_IS_TRUE(NT_SUCCESS(status));
+                    VERIFY_ARE_EQUAL(expectedCount, store->Count);
+                }
+
+                replica->SetReadStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+                replica->SetWriteStatus(FABRIC_SERVICE_PARTITION_ACCESS_STATUS_NOT_PRIMARY);
+
+                FABRIC_EPOCH epoch3; epoch3.DataLossNumber = 2; epoch3.ConfigurationNumber = 3; epoch3.Reserved = nullptr;
+                co_await replica->ChangeRoleAsync(epoch3, FABRIC_REPLICA_ROLE_NONE);
+
+                co_await replica->CloseAsync();
+            }
+
+            co_return;
+        }
+
+        void BackupTests::SetBackupCompressionCodec(
+            __in CompressionCodec::Enum codec)
+        {
+            ConfigSettings settings;
+            ConfigSection section;
+            section.Name = L"TransactionalReplicator2";
+
+            ConfigParameter parameter;
+            parameter.Name = L"BackupCompressionCodec";
+            parameter.Value = wformatString(L"{0}", static_cast<int>(codec));
+
+            section.Parameters[parameter.Name] = parameter;
+            settings.Sections[section.Name] = section;
+
+            Config::SetConfigStore(make_shared<ConfigSettingsConfigStore>(settings));
+        }
+
         bool BackupTests::IsSameReplica(
             __in KGuid const & sourcePartitionId,
             __in FABRIC_REPLICA_ID sourceReplicaID,
@@ -1061,6 +1284,165 @@ namespace Data
             }
         }
 
+        //
+        // Scenario:        Full backup and restore of populated stores without compression
+        // Expected Result: All the state is restored. Backup and restore times are traced.
+        //
+        BOOST_AUTO_TEST_CASE(BackupRestore_Uncompressed_Throughput)
+        {
+            int const StateProviderCount = 8;
+            int const NumberOfTxnPerSP = 64;
+            int const NumberOfOpPerTxn = 256;
+
+            // Setup
+            wstring testName(L"BackupRestore_Uncompressed_Throughput");
+            wstring testFolderPath = CreateFileName(testName);
+
+            // Start up cleanup.
+            Directory::Delete_WithRetry(testFolderPath, true, true);
+
+            wstring workFolder = Path::Combine(testFolderPath, L"work");
+            wstring backupFolder = Path::Combine(testFolderPath, L"backup");
+
+            SetBackupCompressionCodec(CompressionCodec::None);
+            KFinally([] { SetBackupCompressionCodec(CompressionCodec::None); });
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                KGuid partitionId;
+                partitionId.CreateNew();
+                FABRIC_REPLICA_ID const replicaId = 777;
+
+                KtlLogger::SharedLogSettingsSPtr sharedLogSettings;
+                InitializeKtlConfig(testFolderPath, TestLogFileName, underlyingSystem_->NonPagedAllocator(), sharedLogSettings);
+
+                Data::Log::LogManager::SPtr logManager;
+                status = Data::Log::LogManager::Create(underlyingSystem_->NonPagedAllocator(), logManager);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                status = SyncAwait(logManager->OpenAsync(CancellationToken::None, sharedLogSettings));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                SyncAwait(Test_BackupRestore_Throughput(
+                    workFolder,
+                    backupFolder,
+                    *logManager,
+                    partitionId,
+                    replicaId,
+                    StateProviderCount,
+                    NumberOfTxnPerSP,
+                    NumberOfOpPerTxn));
+
+                status = SyncAwait(logManager->CloseAsync(CancellationToken::None));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+                logManager = nullptr;
+            }
+
+            // Post-clean up
+            if (Directory::Exists(testFolderPath))
+            {
+                Directory::Delete_WithRetry(testFolderPath, true, true);
+            }
+        }
+
+        //
+        // Scenario:        Full backup and restore of populated stores with compressed checkpoint files
+        // Expected Result: All the state is restored. Backup and restore times are traced.
+        //
+        BOOST_AUTO_TEST_CASE(BackupRestore_Compressed_Throughput)
+        {
+            int const StateProviderCount = 8;
+            int const NumberOfTxnPerSP = 64;
+            int const NumberOfOpPerTxn = 256;
+
+            // Setup
+            wstring testName(L"BackupRestore_Compressed_Throughput");
+            wstring testFolderPath = CreateFileName(testName);
+
+            // Start up cleanup.
+            Directory::Delete_WithRetry(testFolderPath, true, true);
+
+            wstring workFolder = Path::Combine(testFolderPath, L"work");
+            wstring backupFolder = Path::Combine(testFolderPath, L"backup");
+
+            SetBackupCompressionCodec(CompressionCodec::Lz);
+            KFinally([] { SetBackupCompressionCodec(CompressionCodec::None); });
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                KGuid partitionId;
+                partitionId.CreateNew();
+                FABRIC_REPLICA_ID const replicaId = 777;
+
+                KtlLogger::SharedLogSettingsSPtr sharedLogSettings;
+                InitializeKtlConfig(testFolderPath, TestLogFileName, underlyingSystem_->NonPagedAllocator(), sharedLogSettings);
+
+                Data::Log::LogManager::SPtr logManager;
+                status = Data::Log::LogManager::Create(underlyingSystem_->NonPagedAllocator(), logManager);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                status = SyncAwait(logManager->OpenAsync(CancellationToken::None, sharedLogSettings));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                SyncAwait(Test_BackupRestore_Throughput(
+                    workFolder,
+                    backupFolder,
+                    *logManager,
+                    partitionId,
+                    replicaId,
+                    StateProviderCount,
+                    NumberOfTxnPerSP,
+                    NumberOfOpPerTxn));
+
+                // The checkpoint files must have been backed up compressed, and be smaller than the files they restore to
+                vector<wstring> compressedFiles = Directory::GetFiles(backupFolder, L"*.cmp", true, false);
+                VERIFY_IS_TRUE(compressedFiles.size() > 0);
+
+                ULONG64 totalCompressedSize = 0;
+                ULONG64 totalRawSize = 0;
+                for (wstring const & compressedFile : compressedFiles)
+                {
+                    int64 compressedSize = 0;
+                    ErrorCode error = File::GetSize(compressedFile, compressedSize);
+                    VERIFY_IS_TRUE(error.IsSuccess());
+
+                    wstring rawFile = compressedFile + L".raw";
+                    KString::SPtr compressedPath = KPath::CreatePath(compressedFile.c_str(), underlyingSystem_->PagedAllocator());
+                    KString::SPtr rawPath = KPath::CreatePath(rawFile.c_str(), underlyingSystem_->PagedAllocator());
+
+                    ULONG64 rawSize = SyncAwait(Data::Utilities::CompressedFile::DecompressAsync(
+                        *compressedPath,
+                        *rawPath,
+                        1,
+                        underlyingSystem_->PagedAllocator(),
+                        CancellationToken::None));
+                    File::Delete(rawFile);
+
+                    totalCompressedSize += static_cast<ULONG64>(compressedSize);
+                    totalRawSize += rawSize;
+                }
+
+                Trace.WriteInfo(
+                    TraceComponent,
+                    "{0} compressed files, {1} bytes for {2} bytes of checkpoint files",
+                    compressedFiles.size(),
+                    totalCompressedSize,
+                    totalRawSize);
+
+                VERIFY_IS_TRUE(totalCompressedSize < totalRawSize);
+
+                status = SyncAwait(logManager->CloseAsync(CancellationToken::None));
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+                logManager = nullptr;
+            }
+
+            // Post-clean up
+            if (Directory::Exists(testFolderPath))
+            {
+                Directory::Delete_WithRetry(testFolderPath, true, true);
+            }
+        }
+
         BOOST_AUTO_TEST_SUITE_END();
     }
 }
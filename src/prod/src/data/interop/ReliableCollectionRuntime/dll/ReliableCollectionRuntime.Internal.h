@@ -110,6 +110,30 @@ typedef HRESULT(*pfnStore_ContainsKeyAsync)(
     __in void* ctx,
     __out BOOL* synchronousComplete);
 
+typedef HRESULT (*pfnStore_MultiGetAsync)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in LPCWSTR const* keys,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out Store_GetResult* results,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
+typedef HRESULT (*pfnStore_MultiAddAsync)(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in Store_AddItem const* items,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
 typedef void (*pfnTransaction_Release)(
     __in TransactionHandle txn);
 
@@ -288,6 +312,20 @@ typedef HRESULT (*pfnStoreKeyValueEnumerator_MoveNextAsync)(
     __in void* ctx,
     __out BOOL* synchronousComplete);
 
+typedef HRESULT (*pfnStoreKeyValueEnumerator_MoveNextBatchAsync)(
+    __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+    __in BOOL includeCurrent,
+    __in uint32_t maxItems,
+    __out StoreKeyValueEnumerator_Item* items,
+    __out char* arena,
+    __in uint32_t arenaSize,
+    __out uint32_t* itemCount,
+    __out BOOL* hasPendingItem,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete);
+
 typedef void (*pfnBuffer_Release)(
     __in BufferHandle handle);
 
@@ -380,6 +418,9 @@ struct ReliableCollectionApis
     pfnTransaction_Release Transaction_Release2;
     pfnStore_CreateRangedEnumeratorAsync Store_CreateRangedEnumeratorAsync;
     pfnStore_ContainsKeyAsync Store_ContainsKeyAsync;
+    pfnStore_MultiGetAsync Store_MultiGetAsync;
+    pfnStore_MultiAddAsync Store_MultiAddAsync;
+    pfnStoreKeyValueEnumerator_MoveNextBatchAsync StoreKeyValueEnumerator_MoveNextBatchAsync;
 };
 
 extern "C" HRESULT FabricGetReliableCollectionApiTable(
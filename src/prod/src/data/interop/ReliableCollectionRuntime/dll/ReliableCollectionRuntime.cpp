@@ -292,6 +292,56 @@ extern "C" HRESULT Store_ContainsKeyAsync(
         synchronousComplete);
 }
 
+extern "C" HRESULT Store_MultiGetAsync(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in LPCWSTR const* keys,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out Store_GetResult* results,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_MultiGetAsync(
+        stateProvider,
+        txn,
+        count,
+        keys,
+        timeout,
+        lockMode,
+        results,
+        cts,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
+extern "C" HRESULT Store_MultiAddAsync(
+    __in StateProviderHandle stateProvider,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in Store_AddItem const* items,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.Store_MultiAddAsync(
+        stateProvider,
+        txn,
+        count,
+        items,
+        timeout,
+        cts,
+        callback,
+        ctx,
+        synchronousComplete);
+}
+
 extern "C" HRESULT Store_SetNotifyStoreChangeCallback(
     __in StateProviderHandle stateProvider,
     __in fnNotifyStoreChangeCallback callback,
@@ -662,6 +712,34 @@ extern "C" HRESULT StoreKeyValueEnumerator_MoveNextAsync(
         synchronousComplete);
 }
 
+extern "C" HRESULT StoreKeyValueEnumerator_MoveNextBatchAsync(
+    __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+    __in BOOL includeCurrent,
+    __in uint32_t maxItems,
+    __out StoreKeyValueEnumerator_Item* items,
+    __out char* arena,
+    __in uint32_t arenaSize,
+    __out uint32_t* itemCount,
+    __out BOOL* hasPendingItem,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    return g_reliableCollectionApis.StoreKeyValueEnumerator_MoveNextBatchAsync(
+        enumerator,
+        includeCurrent,
+        maxItems,
+        items,
+        arena,
+        arenaSize,
+        itemCount,
+        hasPendingItem,
+        cts,
+        callback,
+        ctx,
+        synchronousComplete);
+}
 
 extern "C" void Test_UseEnv(BOOL enable)
 {
@@ -343,6 +343,53 @@ extern "C"
         __in void* ctx,
         __out BOOL* synchronousComplete);
 
+    // Result of one key of Store_MultiGetAsync.
+    // Value.Handle is set when Found and must be released with Buffer_Release.
+    struct Store_GetResult
+    {
+        BOOL Found;
+        size_t ObjectHandle;
+        Buffer Value;
+        int64_t VersionSequenceNumber;
+    };
+
+    // Reads all the keys within the transaction with a single call.
+    // results must hold count entries and stay valid until the call completes; they are filled in for both completions.
+    // On failure no buffer is returned.
+    CLASS_DECLSPEC HRESULT Store_MultiGetAsync(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in uint32_t count,
+        __in LPCWSTR const* keys,
+        __in int64_t timeout,
+        __in Store_LockMode lockMode,
+        __out Store_GetResult* results,
+        __out CancellationTokenSourceHandle* cts,
+        __in fnNotifyAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
+    struct Store_AddItem
+    {
+        LPCWSTR Key;
+        size_t ObjectHandle;                // handle of object to be stored
+        void* Bytes;                        // serailized byte array of object
+        uint32_t BytesLength;               // byte array length
+    };
+
+    // Adds all the items within the transaction with a single call, in order, stopping at the first failure.
+    // The items are copied before the call returns.
+    CLASS_DECLSPEC HRESULT Store_MultiAddAsync(
+        __in StateProviderHandle store,
+        __in TransactionHandle txn,
+        __in uint32_t count,
+        __in Store_AddItem const* items,
+        __in int64_t timeout,
+        __out CancellationTokenSourceHandle* cts,
+        __in fnNotifyAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
     /*************************************
     * StateProvider APIs
     *************************************/
@@ -540,6 +587,39 @@ extern "C"
         __in void* ctx,
         __out BOOL* synchronousComplete);
 
+    // Item of StoreKeyValueEnumerator_MoveNextBatchAsync, offsets are relative to the caller's arena.
+    // The key is a null terminated string, KeyLength includes the terminator.
+    struct StoreKeyValueEnumerator_Item
+    {
+        uint32_t KeyOffset;
+        uint32_t KeyLength;
+        uint32_t ValueOffset;
+        uint32_t ValueLength;
+        size_t ObjectHandle;
+        int64_t VersionSequenceNumber;
+    };
+
+    typedef void(*fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion)(void* ctx, HRESULT status, uint32_t itemCount, BOOL hasPendingItem);
+
+    // Copies up to maxItems key/value pairs into items and arena with a single call. itemCount is 0 at the end of the enumeration.
+    // When the next pair does not fit in the arena, it is left as the current item of the enumerator and hasPendingItem is set;
+    // the caller passes it back as includeCurrent on the next call. If it does not fit in an empty arena the call fails with
+    // the buffer too small error, and can be retried with a larger arena.
+    // items and arena must stay valid until the call completes.
+    CLASS_DECLSPEC HRESULT StoreKeyValueEnumerator_MoveNextBatchAsync(
+        __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+        __in BOOL includeCurrent,
+        __in uint32_t maxItems,
+        __out StoreKeyValueEnumerator_Item* items,
+        __out char* arena,
+        __in uint32_t arenaSize,
+        __out uint32_t* itemCount,
+        __out BOOL* hasPendingItem,
+        __out CancellationTokenSourceHandle* cts,
+        __in fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion callback,
+        __in void* ctx,
+        __out BOOL* synchronousComplete);
+
     CLASS_DECLSPEC void Buffer_Release(BufferHandle handle);
 
     /*************************************
@@ -61,7 +61,10 @@ void GetReliableCollectionImplApiTable(ReliableCollectionApis* reliableCollectio
         Transaction_Dispose,
         Transaction_Release2,
         Store_CreateRangedEnumeratorAsync,
-        Store_ContainsKeyAsync
+        Store_ContainsKeyAsync,
+        Store_MultiGetAsync,
+        Store_MultiAddAsync,
+        StoreKeyValueEnumerator_MoveNextBatchAsync
     };
 }
 
@@ -64,6 +64,25 @@ namespace Data
                 __in wstring const &key,
                 __in size_t objHandle,
                 __in wstring const &value);
+
+            void MultiAdd(
+                __in IStateProvider2* stateProvider,
+                __in Transaction & txn,
+                __in vector<Store_AddItem> const & items);
+            void MultiGet(
+                __in IStateProvider2* stateProvider,
+                __in Transaction & txn,
+                __in vector<LPCWSTR> const & keys,
+                __out vector<Store_GetResult> & results);
+            StoreKeyValueAsyncEnumeratorHandle CreateEnumerator(
+                __in IStateProvider2* stateProvider,
+                __in Transaction & txn);
+            uint32_t MoveNextBatch(
+                __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+                __in BOOL includeCurrent,
+                __in vector<StoreKeyValueEnumerator_Item> & items,
+                __in vector<char> & arena,
+                __out BOOL & hasPendingItem);
    
         protected:
             CommonConfig config; // load the config object as its needed for the tracing to work
@@ -277,6 +296,130 @@ namespace Data
             return txn->CommitSequenceNumber;
         }
 
+        void ReliableCollectionRuntimeImplTests::MultiAdd(
+            __in IStateProvider2* stateProvider,
+            __in Transaction & txn,
+            __in vector<Store_AddItem> const & items)
+        {
+            BOOL synchronouscomplete;
+            ktl::CancellationTokenSource* cts;
+            AwaitableCompletionSource<void>::SPtr acs = nullptr;
+            AwaitableCompletionSource<void>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+            HRESULT hresult = Store_MultiAddAsync(stateProvider, &txn, (uint32_t)items.size(), items.data(), std::numeric_limits<int64>::max(), (CancellationTokenSourceHandle*)&cts,
+                [](void* acsHandle, HRESULT _hresult) {
+                    AwaitableCompletionSource<void>* acs = (AwaitableCompletionSource<void>*)acsHandle;
+                    if (!SUCCEEDED(_hresult))
+                        acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                    else
+                        acs->Set();
+                }, acs.RawPtr(), &synchronouscomplete);
+
+            VERIFY_IS_TRUE(SUCCEEDED(hresult));
+            if (!synchronouscomplete)
+            {
+                CancellationTokenSource_Release(cts);
+                SyncAwait(acs->GetAwaitable());
+            }
+        }
+
+        void ReliableCollectionRuntimeImplTests::MultiGet(
+            __in IStateProvider2* stateProvider,
+            __in Transaction & txn,
+            __in vector<LPCWSTR> const & keys,
+            __out vector<Store_GetResult> & results)
+        {
+            BOOL synchronouscomplete;
+            ktl::CancellationTokenSource* cts;
+            AwaitableCompletionSource<void>::SPtr acs = nullptr;
+            AwaitableCompletionSource<void>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+            results.resize(keys.size());
+            HRESULT hresult = Store_MultiGetAsync(stateProvider, &txn, (uint32_t)keys.size(), keys.data(), std::numeric_limits<int64>::max(), Store_LockMode::Store_LockMode_Free, results.data(), (CancellationTokenSourceHandle*)&cts,
+                [](void* acsHandle, HRESULT _hresult) {
+                    AwaitableCompletionSource<void>* acs = (AwaitableCompletionSource<void>*)acsHandle;
+                    if (!SUCCEEDED(_hresult))
+                        acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                    else
+                        acs->Set();
+                }, acs.RawPtr(), &synchronouscomplete);
+
+            VERIFY_IS_TRUE(SUCCEEDED(hresult));
+            if (!synchronouscomplete)
+            {
+                CancellationTokenSource_Release(cts);
+                SyncAwait(acs->GetAwaitable());
+            }
+        }
+
+        StoreKeyValueAsyncEnumeratorHandle ReliableCollectionRuntimeImplTests::CreateEnumerator(
+            __in IStateProvider2* stateProvider,
+            __in Transaction & txn)
+        {
+            BOOL synchronouscomplete;
+            StoreKeyValueAsyncEnumeratorHandle enumerator = nullptr;
+            AwaitableCompletionSource<StoreKeyValueAsyncEnumeratorHandle>::SPtr acs = nullptr;
+            AwaitableCompletionSource<StoreKeyValueAsyncEnumeratorHandle>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+            HRESULT hresult = Store_CreateEnumeratorAsync(stateProvider, &txn, &enumerator,
+                [](void* ctx, HRESULT _hresult, StoreKeyValueAsyncEnumeratorHandle result) {
+                    auto acs = (AwaitableCompletionSource<StoreKeyValueAsyncEnumeratorHandle>*)ctx;
+                    if (!SUCCEEDED(_hresult))
+                        acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                    else
+                        acs->SetResult(result);
+                }, acs.RawPtr(), &synchronouscomplete);
+
+            VERIFY_IS_TRUE(SUCCEEDED(hresult));
+            if (!synchronouscomplete)
+                enumerator = SyncAwait(acs->GetAwaitable());
+
+            return enumerator;
+        }
+
+        uint32_t ReliableCollectionRuntimeImplTests::MoveNextBatch(
+            __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+            __in BOOL includeCurrent,
+            __in vector<StoreKeyValueEnumerator_Item> & items,
+            __in vector<char> & arena,
+            __out BOOL & hasPendingItem)
+        {
+            BOOL synchronouscomplete;
+            uint32_t itemCount = 0;
+            ktl::CancellationTokenSource* cts;
+            AwaitableCompletionSource<tuple<uint32_t, BOOL>>::SPtr acs = nullptr;
+            AwaitableCompletionSource<tuple<uint32_t, BOOL>>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+            HRESULT hresult = StoreKeyValueEnumerator_MoveNextBatchAsync(
+                enumerator,
+                includeCurrent,
+                (uint32_t)items.size(),
+                items.data(),
+                arena.data(),
+                (uint32_t)arena.size(),
+                &itemCount,
+                &hasPendingItem,
+                (CancellationTokenSourceHandle*)&cts,
+                [](void* acsHandle, HRESULT _hresult, uint32_t count, BOOL pending) {
+                    auto acs = (AwaitableCompletionSource<tuple<uint32_t, BOOL>>*)acsHandle;
+                    if (!SUCCEEDED(_hresult))
+                        acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                    else
+                        acs->SetResult(make_tuple(count, pending));
+                },
+                acs.RawPtr(),
+                &synchronouscomplete);
+
+            VERIFY_IS_TRUE(SUCCEEDED(hresult));
+            if (!synchronouscomplete)
+            {
+                CancellationTokenSource_Release(cts);
+                tie(itemCount, hasPendingItem) = SyncAwait(acs->GetAwaitable());
+            }
+
+            return itemCount;
+        }
+
         BOOST_FIXTURE_TEST_SUITE(ReliableCollectionRuntimeImplTestsSuite, ReliableCollectionRuntimeImplTests);
 
         BOOST_AUTO_TEST_CASE(TxnReplicator_CreateTransaction_SUCCESS)
@@ -1071,6 +1214,360 @@ namespace Data
             }
         }
 
+        BOOST_AUTO_TEST_CASE(Store_MultiAddAsync_MultiGetAsync_SUCCESS)
+        {
+            wstring testName(L"Store_MultiAddAsync_MultiGetAsync_SUCCESS");
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                uint32_t const count = 16;
+                IStateProvider2::SPtr stateProvider;
+
+                KUri::CSPtr stateProviderName = GetStateProviderName(5);
+                AddStateProvider(stateProviderName);
+
+                NTSTATUS status = replica_->TxnReplicator->Get(*stateProviderName, stateProvider);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_NOT_NULL(stateProvider);
+
+                vector<wstring> keys;
+                vector<wstring> values;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    keys.push_back(wformatString(L"key{0}", i));
+                    values.push_back(wformatString(L"value{0}", i));
+                }
+
+                vector<Store_AddItem> items;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    items.push_back(Store_AddItem{ keys[i].c_str(), i, (void*)values[i].c_str(), (uint32_t)((values[i].size() + 1) * sizeof(values[i][0])) });
+                }
+
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    MultiAdd(stateProvider.RawPtr(), *txn, items);
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                int64_t storeCount = 0;
+                Store_GetCount(stateProvider.RawPtr(), &storeCount);
+                VERIFY_IS_TRUE(storeCount == count);
+
+                // The last key does not exist
+                vector<LPCWSTR> getKeys;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    getKeys.push_back(keys[i].c_str());
+                }
+                getKeys.push_back(L"missingKey");
+
+                Transaction::SPtr txn;
+                status = replica_->TxnReplicator->CreateTransaction(txn);
+                THROW_ON_FAILURE(status);
+                KFinally([&] {txn->Dispose(); });
+
+                vector<Store_GetResult> results;
+                MultiGet(stateProvider.RawPtr(), *txn, getKeys, results);
+
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    VERIFY_IS_TRUE(results[i].Found);
+#ifdef FEATURE_CACHE_OBJHANDLE
+                    VERIFY_IS_TRUE(results[i].ObjectHandle == i);
+#endif
+                    wstring value((wchar_t*)results[i].Value.Bytes);
+                    VERIFY_IS_TRUE(values[i].compare(value) == 0);
+                    Buffer_Release(results[i].Value.Handle);
+                }
+
+                VERIFY_IS_FALSE(results[count].Found);
+                VERIFY_IS_TRUE(results[count].Value.Handle == nullptr);
+
+                SyncAwait(txn->CommitAsync());
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(StoreKeyValueEnumerator_MoveNextBatchAsync_SUCCESS)
+        {
+            wstring testName(L"StoreKeyValueEnumerator_MoveNextBatchAsync_SUCCESS");
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                IStateProvider2::SPtr stateProvider;
+
+                KUri::CSPtr stateProviderName = GetStateProviderName(6);
+                AddStateProvider(stateProviderName);
+
+                NTSTATUS status = replica_->TxnReplicator->Get(*stateProviderName, stateProvider);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_NOT_NULL(stateProvider);
+
+                for (ULONG i = 1; i <= 9; i++)
+                {
+                    AddKeyValuePair(stateProvider.RawPtr(), wformatString(L"key{0}", i), i, wformatString(L"value{0}", i));
+                }
+
+                Transaction::SPtr txn;
+                status = replica_->TxnReplicator->CreateTransaction(txn);
+                THROW_ON_FAILURE(status);
+                KFinally([&] {txn->Dispose(); });
+
+                StoreKeyValueAsyncEnumeratorHandle enumerator = CreateEnumerator(stateProvider.RawPtr(), *txn);
+                KFinally([&] {StoreKeyValueEnumerator_Release(enumerator); });
+
+                // Room for 4 items but only for about 2 pairs, so that batches also end on a pending pair
+                vector<StoreKeyValueEnumerator_Item> items(4);
+                vector<char> arena(64);
+                BOOL hasPendingItem = false;
+                ULONG count = 0;
+
+                while (true)
+                {
+                    uint32_t itemCount = MoveNextBatch(enumerator, hasPendingItem, items, arena, hasPendingItem);
+                    if (itemCount == 0)
+                    {
+                        VERIFY_IS_FALSE(hasPendingItem);
+                        break;
+                    }
+
+                    for (uint32_t i = 0; i < itemCount; i++)
+                    {
+                        count++;
+                        wstring expectedKey = wformatString(L"key{0}", count);
+                        wstring expectedValue = wformatString(L"value{0}", count);
+                        wstring key((wchar_t*)(arena.data() + items[i].KeyOffset));
+                        wstring value((wchar_t*)(arena.data() + items[i].ValueOffset));
+                        VERIFY_IS_TRUE(expectedKey.compare(key) == 0);
+                        VERIFY_IS_TRUE(items[i].KeyLength == key.size() + 1);
+                        VERIFY_IS_TRUE(expectedValue.compare(value) == 0);
+#ifdef FEATURE_CACHE_OBJHANDLE
+                        VERIFY_IS_TRUE(items[i].ObjectHandle == count);
+#endif
+                    }
+                }
+
+                VERIFY_IS_TRUE(count == 9);
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(Store_BatchedApis_VersusPerItemApis_Perf)
+        {
+            wstring testName(L"Store_BatchedApis_VersusPerItemApis_Perf");
+
+            TEST_TRACE_BEGIN(testName)
+            {
+                uint32_t const count = 10000;
+                uint32_t const batchSize = 256;
+                IStateProvider2::SPtr stateProvider;
+
+                KUri::CSPtr stateProviderName = GetStateProviderName(7);
+                AddStateProvider(stateProviderName);
+
+                NTSTATUS status = replica_->TxnReplicator->Get(*stateProviderName, stateProvider);
+                VERIFY_IS_TRUE(NT_SUCCESS(status));
+                VERIFY_IS_NOT_NULL(stateProvider);
+
+                vector<wstring> keys;
+                wstring value(64, L'v');
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    keys.push_back(wformatString(L"key{0}", 100000 + i));
+                }
+
+                // Populate in batches
+                for (uint32_t start = 0; start < count; start += batchSize)
+                {
+                    vector<Store_AddItem> items;
+                    for (uint32_t i = start; i < count && i < start + batchSize; i++)
+                    {
+                        items.push_back(Store_AddItem{ keys[i].c_str(), i, (void*)value.c_str(), (uint32_t)((value.size() + 1) * sizeof(value[0])) });
+                    }
+
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    MultiAdd(stateProvider.RawPtr(), *txn, items);
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                Stopwatch stopwatch;
+
+                // Point reads, one call per key
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    stopwatch.Restart();
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        BOOL found = false;
+                        BOOL synchronouscomplete;
+                        size_t objectHandle;
+                        Buffer buffer;
+                        LONG64 versionSequenceNumber;
+                        ktl::CancellationTokenSource* cts;
+                        AwaitableCompletionSource<bool>::SPtr acs = nullptr;
+                        AwaitableCompletionSource<bool>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+                        HRESULT hresult = Store_ConditionalGetAsync(
+                            stateProvider.RawPtr(), txn.RawPtr(), keys[i].c_str(), std::numeric_limits<int64>::max(), Store_LockMode::Store_LockMode_Free,
+                            &objectHandle, &buffer, &versionSequenceNumber, (CancellationTokenSourceHandle*)&cts, &found,
+                            [](void* acsHandle, HRESULT _hresult, BOOL r, size_t, void*, uint32_t, LONG64) {
+                                auto acs = (AwaitableCompletionSource<bool>*)acsHandle;
+                                if (!SUCCEEDED(_hresult))
+                                    acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                                else
+                                    acs->SetResult(r);
+                            }, acs.RawPtr(), &synchronouscomplete);
+
+                        VERIFY_IS_TRUE(SUCCEEDED(hresult));
+                        if (synchronouscomplete)
+                        {
+                            Buffer_Release(buffer.Handle);
+                        }
+                        else
+                        {
+                            CancellationTokenSource_Release(cts);
+                            found = SyncAwait(acs->GetAwaitable());
+                        }
+
+                        VERIFY_IS_TRUE(found);
+                    }
+                    stopwatch.Stop();
+
+                    Trace.WriteInfo(TraceComponent, "{0}: Store_ConditionalGetAsync x {1}: {2} ms", testName, count, stopwatch.ElapsedMilliseconds);
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                // Point reads, one call per batch
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    stopwatch.Restart();
+                    vector<Store_GetResult> results;
+                    for (uint32_t start = 0; start < count; start += batchSize)
+                    {
+                        vector<LPCWSTR> batchKeys;
+                        for (uint32_t i = start; i < count && i < start + batchSize; i++)
+                        {
+                            batchKeys.push_back(keys[i].c_str());
+                        }
+
+                        MultiGet(stateProvider.RawPtr(), *txn, batchKeys, results);
+                        for (auto & result : results)
+                        {
+                            VERIFY_IS_TRUE(result.Found);
+                            Buffer_Release(result.Value.Handle);
+                        }
+                    }
+                    stopwatch.Stop();
+
+                    Trace.WriteInfo(TraceComponent, "{0}: Store_MultiGetAsync x {1} (batch {2}): {3} ms", testName, count, batchSize, stopwatch.ElapsedMilliseconds);
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                // Enumeration, one call per pair
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    StoreKeyValueAsyncEnumeratorHandle enumerator = CreateEnumerator(stateProvider.RawPtr(), *txn);
+                    KFinally([&] {StoreKeyValueEnumerator_Release(enumerator); });
+
+                    uint32_t enumerated = 0;
+                    stopwatch.Restart();
+                    while (true)
+                    {
+                        BOOL advanced = false;
+                        BOOL synchronouscomplete;
+                        LPCWSTR key;
+                        size_t objectHandle;
+                        Buffer buffer;
+                        LONG64 versionSequenceNumber;
+                        ktl::CancellationTokenSource* cts;
+                        AwaitableCompletionSource<bool>::SPtr acs = nullptr;
+                        AwaitableCompletionSource<bool>::Create(underlyingSystem_->PagedAllocator(), TEST_CEXPORT_TAG, acs);
+
+                        HRESULT hresult = StoreKeyValueEnumerator_MoveNextAsync(
+                            enumerator, (CancellationTokenSourceHandle*)&cts, &advanced, &key, &objectHandle, &buffer, &versionSequenceNumber,
+                            [](void* acsHandle, HRESULT _hresult, BOOL r, LPCWSTR, size_t, void*, uint32_t, LONG64) {
+                                auto acs = (AwaitableCompletionSource<bool>*)acsHandle;
+                                if (!SUCCEEDED(_hresult))
+                                    acs->SetException(ktl::Exception(StatusConverter::Convert(_hresult)));
+                                else
+                                    acs->SetResult(r);
+                            }, acs.RawPtr(), &synchronouscomplete);
+
+                        VERIFY_IS_TRUE(SUCCEEDED(hresult));
+                        if (!synchronouscomplete)
+                        {
+                            CancellationTokenSource_Release(cts);
+                            advanced = SyncAwait(acs->GetAwaitable());
+                        }
+                        else if (advanced)
+                        {
+                            Buffer_Release(buffer.Handle);
+                        }
+
+                        if (!advanced)
+                            break;
+
+                        enumerated++;
+                    }
+                    stopwatch.Stop();
+
+                    VERIFY_IS_TRUE(enumerated == count);
+                    Trace.WriteInfo(TraceComponent, "{0}: StoreKeyValueEnumerator_MoveNextAsync x {1}: {2} ms", testName, count, stopwatch.ElapsedMilliseconds);
+                    SyncAwait(txn->CommitAsync());
+                }
+
+                // Enumeration, one call per batch
+                {
+                    Transaction::SPtr txn;
+                    status = replica_->TxnReplicator->CreateTransaction(txn);
+                    THROW_ON_FAILURE(status);
+                    KFinally([&] {txn->Dispose(); });
+
+                    StoreKeyValueAsyncEnumeratorHandle enumerator = CreateEnumerator(stateProvider.RawPtr(), *txn);
+                    KFinally([&] {StoreKeyValueEnumerator_Release(enumerator); });
+
+                    vector<StoreKeyValueEnumerator_Item> items(batchSize);
+                    vector<char> arena(64 * 1024);
+                    BOOL hasPendingItem = false;
+                    uint32_t enumerated = 0;
+
+                    stopwatch.Restart();
+                    while (true)
+                    {
+                        uint32_t itemCount = MoveNextBatch(enumerator, hasPendingItem, items, arena, hasPendingItem);
+                        if (itemCount == 0)
+                            break;
+
+                        enumerated += itemCount;
+                    }
+                    stopwatch.Stop();
+
+                    VERIFY_IS_TRUE(enumerated == count);
+                    Trace.WriteInfo(TraceComponent, "{0}: StoreKeyValueEnumerator_MoveNextBatchAsync x {1} (batch {2}): {3} ms", testName, count, batchSize, stopwatch.ElapsedMilliseconds);
+                    SyncAwait(txn->CommitAsync());
+                }
+            }
+        }
+
         BOOST_AUTO_TEST_CASE(TxnReplicator_AddStateProvider2_SUCCESS)
         {
             wstring testName(L"TxnReplicator_AddStateProvider2_SUCCESS");
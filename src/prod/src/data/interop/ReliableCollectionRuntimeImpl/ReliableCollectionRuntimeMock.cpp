@@ -551,6 +551,9 @@ void GetReliableCollectionMockApiTable(ReliableCollectionApis* reliableCollectio
         nullptr, // Transaction_Dispose
         nullptr, // Transaction_Release2
         MOCK_Store_CreateRangedEnumeratorAsync,
-        MOCK_Store_ContainsKeyAsync
+        MOCK_Store_ContainsKeyAsync,
+        nullptr, // Store_MultiGetAsync
+        nullptr, // Store_MultiAddAsync
+        nullptr  // StoreKeyValueEnumerator_MoveNextBatchAsync
     };
 }
@@ -45,6 +45,50 @@ void StoreKeyValueEnumeratorCurrent(
     kBufferSptr.Detach();
 }
 
+// Copies the current pair of the enumerator into the arena after arenaUsed, returns false if it does not fit.
+bool StoreKeyValueEnumeratorCopyCurrent(
+    __in IAsyncEnumerator<KeyValuePair<KString::SPtr, KeyValuePair<LONG64, KBuffer::SPtr>>>* enumerator,
+    __in char* arena,
+    __in uint32_t arenaSize,
+    __inout uint32_t& arenaUsed,
+    __out StoreKeyValueEnumerator_Item& item)
+{
+    auto result = enumerator->GetCurrent();
+    KString::SPtr key = result.Key;
+    KBuffer::SPtr kBufferSptr = result.Value.Value;
+    char* buffer = (char*)kBufferSptr->GetBuffer();
+    ULONG bufferLength = kBufferSptr->QuerySize();
+
+#ifdef FEATURE_CACHE_OBJHANDLE
+    item.ObjectHandle = *(size_t*)buffer;
+    buffer += sizeof(size_t);
+    bufferLength -= sizeof(size_t);
+#else
+    item.ObjectHandle = 0;
+#endif
+
+    // Keys are kept aligned on character boundaries
+    ULONG keyLength = key->Length();
+    ULONG64 keyOffset = (arenaUsed + sizeof(WCHAR) - 1) & ~(static_cast<ULONG64>(sizeof(WCHAR)) - 1);
+    ULONG64 valueOffset = keyOffset + (static_cast<ULONG64>(keyLength) + 1) * sizeof(WCHAR);
+    if (valueOffset + bufferLength > arenaSize)
+        return false;
+
+    WCHAR* keyBuffer = (WCHAR*)(arena + keyOffset);
+    memcpy(keyBuffer, static_cast<LPCWSTR>(*key), keyLength * sizeof(WCHAR));
+    keyBuffer[keyLength] = 0;
+    memcpy(arena + valueOffset, buffer, bufferLength);
+
+    item.KeyOffset = static_cast<uint32_t>(keyOffset);
+    item.KeyLength = keyLength + 1;
+    item.ValueOffset = static_cast<uint32_t>(valueOffset);
+    item.ValueLength = bufferLength;
+    item.VersionSequenceNumber = result.Value.Key;
+
+    arenaUsed = static_cast<uint32_t>(valueOffset + bufferLength);
+    return true;
+}
+
 extern "C" void StoreKeyValueEnumerator_Release(
     __in StoreKeyValueAsyncEnumeratorHandle enumerator)
 {
@@ -135,3 +179,118 @@ extern "C" HRESULT StoreKeyValueEnumerator_MoveNextAsync(
         versionSequenceNumber, callback, ctx, status, *synchronousComplete);
     return StatusConverter::ToHResult(status);
 }
+
+ktl::Task StoreKeyValueEnumeratorMoveNextBatchAsyncInternal(
+    __in IAsyncEnumerator<KeyValuePair<KString::SPtr, KeyValuePair<LONG64, KBuffer::SPtr>>>* enumerator,
+    __in BOOL includeCurrent,
+    __in uint32_t maxItems,
+    __out StoreKeyValueEnumerator_Item* items,
+    __out char* arena,
+    __in uint32_t arenaSize,
+    __out uint32_t* itemCount,
+    __out BOOL* hasPendingItem,
+    __out ktl::CancellationTokenSource** cts,
+    __in fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion callback,
+    __in void* ctx,
+    __out NTSTATUS& status,
+    __out BOOL& synchronousComplete)
+{
+    ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
+    ktl::CancellationTokenSource::SPtr cancellationTokenSource = nullptr;
+    NTSTATUS ntstatus = STATUS_SUCCESS;
+    uint32_t count = 0;
+    uint32_t arenaUsed = 0;
+    bool isPending = false;
+    bool isAsync = false;
+
+    status = STATUS_SUCCESS;
+    synchronousComplete = false;
+
+    if (cts != nullptr)
+    {
+        status = ktl::CancellationTokenSource::Create(GetAllocator(), RELIABLECOLLECTIONRUNTIME_TAG, cancellationTokenSource);
+        CO_RETURN_VOID_ON_FAILURE(status);
+        cancellationToken = cancellationTokenSource->Token;
+    }
+
+    // The pair that did not fit in the previous batch goes first
+    if (includeCurrent && maxItems > 0)
+    {
+        if (StoreKeyValueEnumeratorCopyCurrent(enumerator, arena, arenaSize, arenaUsed, items[count]))
+        {
+            count++;
+        }
+        else
+        {
+            isPending = true;
+            ntstatus = STATUS_BUFFER_TOO_SMALL;
+        }
+    }
+
+    while (!isPending && count < maxItems)
+    {
+        auto awaitable = enumerator->MoveNextAsync(cancellationToken);
+
+        // The call completes synchronously as long as every pair is read from memory
+        if (!isAsync && !IsComplete(awaitable))
+        {
+            isAsync = true;
+            if (cts != nullptr)
+                *cts = cancellationTokenSource.Detach();
+        }
+
+        bool advanced = false;
+        EXCEPTION_TO_STATUS(advanced = co_await awaitable, ntstatus);
+        if (!NT_SUCCESS(ntstatus) || !advanced)
+            break;
+
+        if (!StoreKeyValueEnumeratorCopyCurrent(enumerator, arena, arenaSize, arenaUsed, items[count]))
+        {
+            isPending = true;
+            if (count == 0)
+                ntstatus = STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        count++;
+    }
+
+    if (!isAsync)
+    {
+        synchronousComplete = true;
+        status = ntstatus;
+        *itemCount = count;
+        *hasPendingItem = isPending;
+        co_return;
+    }
+
+    callback(ctx, StatusConverter::ToHResult(ntstatus), count, isPending);
+}
+
+extern "C" HRESULT StoreKeyValueEnumerator_MoveNextBatchAsync(
+    __in StoreKeyValueAsyncEnumeratorHandle enumerator,
+    __in BOOL includeCurrent,
+    __in uint32_t maxItems,
+    __out StoreKeyValueEnumerator_Item* items,
+    __out char* arena,
+    __in uint32_t arenaSize,
+    __out uint32_t* itemCount,
+    __out BOOL* hasPendingItem,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyStoreKeyValueEnumeratorMoveNextBatchAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    NTSTATUS status;
+
+    if (maxItems > 0 && (items == nullptr || arena == nullptr))
+        return E_INVALIDARG;
+
+    StoreKeyValueEnumeratorMoveNextBatchAsyncInternal(
+        (IAsyncEnumerator<KeyValuePair<KString::SPtr, KeyValuePair<LONG64, KBuffer::SPtr>>>*)enumerator,
+        includeCurrent, maxItems, items, arena, arenaSize,
+        itemCount, hasPendingItem,
+        (ktl::CancellationTokenSource**)cts,
+        callback, ctx, status, *synchronousComplete);
+    return StatusConverter::ToHResult(status);
+}
@@ -366,6 +366,228 @@ ktl::Task StoreContainsKeyAsyncInternal(
     callback(ctx, StatusConverter::ToHResult(ntstatus), isFound);
 }
 
+NTSTATUS StoreCreateValueBuffer(
+    __in KAllocator& allocator,
+    __in size_t objectHandle,
+    __in void* bytes,
+    __in uint32_t bytesLength,
+    __out KBuffer::SPtr& result)
+{
+    ULONG kBufferLength = bytesLength;
+
+#ifdef FEATURE_CACHE_OBJHANDLE
+    kBufferLength += sizeof(size_t);
+#endif
+
+    NTSTATUS status = KBuffer::Create(kBufferLength, result, allocator);
+    if (!NT_SUCCESS(status))
+        return status;
+
+    auto buffer = result->GetBuffer();
+#ifdef FEATURE_CACHE_OBJHANDLE
+    *(size_t*)buffer = objectHandle;
+    buffer = (byte*)buffer + sizeof(size_t);
+#else
+    UNREFERENCED_PARAMETER(objectHandle);
+#endif
+    memcpy(buffer, bytes, bytesLength);
+    return STATUS_SUCCESS;
+}
+
+void StoreGetResultSet(
+    __in Data::KeyValuePair<LONG64, KBuffer::SPtr>& kvpair,
+    __out Store_GetResult& result)
+{
+    KBuffer::SPtr kBufferSptr = kvpair.Value;
+    char* buffer = (char*)kBufferSptr->GetBuffer();
+    uint32_t bufferLength = kBufferSptr->QuerySize();
+
+#ifdef FEATURE_CACHE_OBJHANDLE
+    result.ObjectHandle = *(size_t*)buffer;
+    buffer += sizeof(size_t);
+    bufferLength -= sizeof(size_t);
+#else
+    result.ObjectHandle = 0;
+#endif
+
+    result.Found = true;
+    result.Value.Bytes = buffer;
+    result.Value.Length = bufferLength;
+    result.Value.Handle = kBufferSptr.Detach();
+    result.VersionSequenceNumber = kvpair.Key;
+}
+
+void StoreGetResultRelease(
+    __in Store_GetResult* results,
+    __in uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (results[i].Value.Handle != nullptr)
+            Buffer_Release(results[i].Value.Handle);
+
+        results[i] = Store_GetResult();
+    }
+}
+
+ktl::Task StoreMultiGetAsyncInternal(
+    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    Transaction* txn,
+    uint32_t count,
+    LPCWSTR const* keys,
+    int64 timeout,
+    Store_GetResult* results,
+    ktl::CancellationTokenSource** cts,
+    fnNotifyAsyncCompletion callback,
+    void* ctx,
+    NTSTATUS& status,
+    BOOL& synchronousComplete)
+{
+    ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
+    ktl::CancellationTokenSource::SPtr cancellationTokenSource = nullptr;
+    KSharedPtr<IStoreTransaction<KString::SPtr, KBuffer::SPtr>> storeTxn;
+    NTSTATUS ntstatus = STATUS_SUCCESS;
+    bool isAsync = false;
+
+    status = STATUS_SUCCESS;
+    synchronousComplete = false;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        results[i] = Store_GetResult();
+    }
+
+    EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
+    CO_RETURN_VOID_ON_FAILURE(status);
+
+    if (cts != nullptr)
+    {
+        status = ktl::CancellationTokenSource::Create(txn->GetThisAllocator(), RELIABLECOLLECTIONRUNTIME_TAG, cancellationTokenSource);
+        CO_RETURN_VOID_ON_FAILURE(status);
+        cancellationToken = cancellationTokenSource->Token;
+    }
+
+    storeTxn->ReadIsolationLevel = IsolationHelper::GetIsolationLevel(*txn, IsolationHelper::OperationType::SingleEntity);
+
+    for (uint32_t i = 0; i < count && NT_SUCCESS(ntstatus); i++)
+    {
+        KString::SPtr kstringkey;
+        ntstatus = KString::Create(kstringkey, txn->GetThisAllocator(), keys[i]);
+        if (!NT_SUCCESS(ntstatus))
+            break;
+
+        Data::KeyValuePair<LONG64, KBuffer::SPtr> kvpair(-1, nullptr);
+        auto awaitable = store->ConditionalGetAsync(*storeTxn, kstringkey, Common::TimeSpan::FromTicks(timeout), kvpair, cancellationToken);
+
+        // The call completes synchronously as long as every read does
+        if (!isAsync && !IsComplete(awaitable))
+        {
+            isAsync = true;
+            if (cts != nullptr)
+                *cts = cancellationTokenSource.Detach();
+        }
+
+        bool found = false;
+        EXCEPTION_TO_STATUS(found = co_await awaitable, ntstatus);
+        if (NT_SUCCESS(ntstatus) && found)
+            StoreGetResultSet(kvpair, results[i]);
+    }
+
+    if (!NT_SUCCESS(ntstatus))
+        StoreGetResultRelease(results, count);
+
+    if (!isAsync)
+    {
+        synchronousComplete = true;
+        status = ntstatus;
+        co_return;
+    }
+
+    callback(ctx, StatusConverter::ToHResult(ntstatus));
+}
+
+ktl::Task StoreMultiAddAsyncInternal(
+    IStore<KString::SPtr, KBuffer::SPtr>* store,
+    Transaction* txn,
+    uint32_t count,
+    Store_AddItem const* items,
+    int64 timeout,
+    ktl::CancellationTokenSource** cts,
+    fnNotifyAsyncCompletion callback,
+    void* ctx,
+    NTSTATUS& status,
+    BOOL& synchronousComplete)
+{
+    KArray<KString::SPtr> kstringKeys(txn->GetThisAllocator());
+    KArray<KBuffer::SPtr> values(txn->GetThisAllocator());
+    ktl::CancellationToken cancellationToken = ktl::CancellationToken::None;
+    ktl::CancellationTokenSource::SPtr cancellationTokenSource;
+    KSharedPtr<IStoreTransaction<KString::SPtr, KBuffer::SPtr>> storeTxn;
+    NTSTATUS ntstatus = STATUS_SUCCESS;
+    bool isAsync = false;
+
+    status = STATUS_SUCCESS;
+    synchronousComplete = false;
+
+    status = kstringKeys.Status();
+    CO_RETURN_VOID_ON_FAILURE(status);
+
+    status = values.Status();
+    CO_RETURN_VOID_ON_FAILURE(status);
+
+    // The items are copied before the first suspension, the caller's array is not used afterwards
+    for (uint32_t i = 0; i < count; i++)
+    {
+        KString::SPtr kstringkey;
+        status = KString::Create(kstringkey, txn->GetThisAllocator(), items[i].Key);
+        CO_RETURN_VOID_ON_FAILURE(status);
+
+        KBuffer::SPtr bufferSptr;
+        status = StoreCreateValueBuffer(txn->GetThisAllocator(), items[i].ObjectHandle, items[i].Bytes, items[i].BytesLength, bufferSptr);
+        CO_RETURN_VOID_ON_FAILURE(status);
+
+        status = kstringKeys.Append(kstringkey);
+        CO_RETURN_VOID_ON_FAILURE(status);
+
+        status = values.Append(bufferSptr);
+        CO_RETURN_VOID_ON_FAILURE(status);
+    }
+
+    EXCEPTION_TO_STATUS(store->CreateOrFindTransaction(*txn, storeTxn), status);
+    CO_RETURN_VOID_ON_FAILURE(status);
+
+    if (cts != nullptr)
+    {
+        status = ktl::CancellationTokenSource::Create(txn->GetThisAllocator(), RELIABLECOLLECTIONRUNTIME_TAG, cancellationTokenSource);
+        CO_RETURN_VOID_ON_FAILURE(status);
+        cancellationToken = cancellationTokenSource->Token;
+    }
+
+    for (uint32_t i = 0; i < count && NT_SUCCESS(ntstatus); i++)
+    {
+        auto awaitable = store->AddAsync(*storeTxn, kstringKeys[i], values[i], Common::TimeSpan::FromTicks(timeout), cancellationToken);
+
+        // The call completes synchronously as long as every add does
+        if (!isAsync && !IsComplete(awaitable))
+        {
+            isAsync = true;
+            if (cts != nullptr)
+                *cts = cancellationTokenSource.Detach();
+        }
+
+        EXCEPTION_TO_STATUS(co_await awaitable, ntstatus);
+    }
+
+    if (!isAsync)
+    {
+        synchronousComplete = true;
+        status = ntstatus;
+        co_return;
+    }
+
+    callback(ctx, StatusConverter::ToHResult(ntstatus));
+}
+
 extern "C" HRESULT Store_ConditionalGetAsync(
     __in StateProviderHandle stateProviderHandle,
     __in TransactionHandle txn,
@@ -774,3 +996,68 @@ extern "C" HRESULT Store_ContainsKeyAsync(
 
     return StatusConverter::ToHResult(status);
 }
+
+extern "C" HRESULT Store_MultiGetAsync(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in LPCWSTR const* keys,
+    __in int64_t timeout,
+    __in Store_LockMode lockMode,
+    __out Store_GetResult* results,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    NTSTATUS status;
+    UNREFERENCED_PARAMETER(lockMode);
+
+    IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
+    IStore<KString::SPtr, KBuffer::SPtr>* store = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
+    if (store == nullptr)
+        return E_INVALIDARG;
+
+    if (count > 0 && (keys == nullptr || results == nullptr))
+        return E_INVALIDARG;
+
+    StoreMultiGetAsyncInternal(
+        store,
+        (Transaction*)txn,
+        count, keys, timeout, results,
+        (ktl::CancellationTokenSource**)cts,
+        callback, ctx, status, *synchronousComplete);
+
+    return StatusConverter::ToHResult(status);
+}
+
+extern "C" HRESULT Store_MultiAddAsync(
+    __in StateProviderHandle stateProviderHandle,
+    __in TransactionHandle txn,
+    __in uint32_t count,
+    __in Store_AddItem const* items,
+    __in int64_t timeout,
+    __out CancellationTokenSourceHandle* cts,
+    __in fnNotifyAsyncCompletion callback,
+    __in void* ctx,
+    __out BOOL* synchronousComplete)
+{
+    NTSTATUS status;
+
+    IStateProvider2* stateProvider = reinterpret_cast<IStateProvider2*>(stateProviderHandle);
+    IStore<KString::SPtr, KBuffer::SPtr>* store = dynamic_cast<IStore<KString::SPtr, KBuffer::SPtr>*>(stateProvider);
+    if (store == nullptr)
+        return E_INVALIDARG;
+
+    if (count > 0 && items == nullptr)
+        return E_INVALIDARG;
+
+    StoreMultiAddAsyncInternal(
+        store,
+        (Transaction*)txn,
+        count, items, timeout,
+        (ktl::CancellationTokenSource**)cts,
+        callback, ctx, status, *synchronousComplete);
+
+    return StatusConverter::ToHResult(status);
+}
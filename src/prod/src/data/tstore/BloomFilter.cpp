@@ -0,0 +1,111 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Data::TStore;
+
+BloomFilter::BloomFilter(
+    __in ULONG64 bitCount,
+    __in ULONG32 hashCount)
+    : bitCount_(bitCount)
+    , hashCount_(hashCount)
+    , bits_(GetThisAllocator(), static_cast<ULONG>((bitCount + 63) / 64))
+{
+    if (!NT_SUCCESS(bits_.Status()))
+    {
+        SetConstructorStatus(bits_.Status());
+        return;
+    }
+
+    ULONG wordCount = static_cast<ULONG>((bitCount + 63) / 64);
+    for (ULONG i = 0; i < wordCount; i++)
+    {
+        NTSTATUS status = bits_.Append(0);
+        if (!NT_SUCCESS(status))
+        {
+            SetConstructorStatus(status);
+            return;
+        }
+    }
+}
+
+BloomFilter::~BloomFilter()
+{
+}
+
+NTSTATUS BloomFilter::Create(
+    __in ULONG64 expectedCount,
+    __in ULONG32 bitsPerKey,
+    __in KAllocator & allocator,
+    __out BloomFilter::SPtr & result)
+{
+    if (bitsPerKey == 0)
+    {
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    // Minimum of one word so that an empty file still gets a valid (and always negative) filter
+    ULONG64 bitCount = expectedCount * bitsPerKey;
+    if (bitCount < 64)
+    {
+        bitCount = 64;
+    }
+
+    // k = bitsPerKey * ln(2) minimizes the false positive rate
+    ULONG32 hashCount = static_cast<ULONG32>(bitsPerKey * 69 / 100);
+    if (hashCount < 1)
+    {
+        hashCount = 1;
+    }
+    else if (hashCount > 30)
+    {
+        hashCount = 30;
+    }
+
+    result = _new(BLOOMFILTER_TAG, allocator) BloomFilter(bitCount, hashCount);
+
+    if (!result)
+    {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    NTSTATUS status = result->Status();
+    if (!NT_SUCCESS(status))
+    {
+        result = nullptr;
+    }
+
+    return status;
+}
+
+void BloomFilter::Add(__in ULONG64 hash)
+{
+    ULONG64 h1 = hash;
+    ULONG64 h2 = (hash >> 32) | 1;
+
+    for (ULONG32 i = 0; i < hashCount_; i++)
+    {
+        ULONG64 bit = (h1 + i * h2) % bitCount_;
+        bits_[static_cast<ULONG>(bit >> 6)] |= (1ULL << (bit & 63));
+    }
+}
+
+bool BloomFilter::MayContain(__in ULONG64 hash) const
+{
+    ULONG64 h1 = hash;
+    ULONG64 h2 = (hash >> 32) | 1;
+
+    for (ULONG32 i = 0; i < hashCount_; i++)
+    {
+        ULONG64 bit = (h1 + i * h2) % bitCount_;
+        if ((bits_[static_cast<ULONG>(bit >> 6)] & (1ULL << (bit & 63))) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,49 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define BLOOMFILTER_TAG 'flBB'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Bloom filter over 64 bit key hashes (CRC64 of the serialized key). Used to skip checkpoint files that cannot contain a key.
+        // Adds are not thread safe; the filter is built once and then only read.
+        //
+        class BloomFilter : public KObject<BloomFilter>, public KShared<BloomFilter>
+        {
+            K_FORCE_SHARED(BloomFilter)
+
+        public:
+            static NTSTATUS Create(
+                __in ULONG64 expectedCount,
+                __in ULONG32 bitsPerKey,
+                __in KAllocator & allocator,
+                __out BloomFilter::SPtr & result);
+
+            __declspec(property(get = get_SizeInBytes)) ULONG64 SizeInBytes;
+            ULONG64 get_SizeInBytes() const
+            {
+                return bits_.Count() * sizeof(ULONG64);
+            }
+
+            void Add(__in ULONG64 hash);
+
+            bool MayContain(__in ULONG64 hash) const;
+
+        private:
+            BloomFilter(
+                __in ULONG64 bitCount,
+                __in ULONG32 hashCount);
+
+            ULONG64 bitCount_;
+            ULONG32 hashCount_;
+            KArray<ULONG64> bits_;
+        };
+    }
+}
@@ -66,6 +66,12 @@ namespace Data
                 return keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle;
             }
 
+            __declspec(property(get = get_KeyCheckpointFile)) KSharedPtr<KeyCheckpointFile> KeyCheckpointFileSPtr;
+            KSharedPtr<KeyCheckpointFile> get_KeyCheckpointFile() const
+            {
+                return keyCheckpointFileSPtr_;
+            }
+
             __declspec(property(get = get_ValueBlockHandle)) KSharedPtr<BlockHandle> ValueBlockHandleSPtr;
             KSharedPtr<BlockHandle> get_ValueBlockHandle() const
             {
@@ -222,6 +228,32 @@ namespace Data
                  return enumeratorSPtr;
             }
 
+            //
+            // Enumerates the keys starting from the key block at the given offset.
+            //
+            template<typename TKey, typename TValue>
+            KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> GetAsyncEnumerator(
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __in ULONG64 startOffset)
+            {
+                 STORE_ASSERT(
+                     startOffset >= keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->Offset && startOffset <= keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->EndOffset(),
+                     "startOffset={1} must be within the keys section",
+                     startOffset);
+
+                 KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr = nullptr;
+                 NTSTATUS status = KeyCheckpointFileAsyncEnumerator<TKey, TValue>::Create(
+                     *keyCheckpointFileSPtr_,
+                     keySerializer,
+                     startOffset,
+                     keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->EndOffset(),
+                     *traceComponent_,
+                     GetThisAllocator(),
+                     enumeratorSPtr);
+                 Diagnostics::Validate(status);
+                 return enumeratorSPtr;
+            }
+
             ktl::Awaitable<void> CloseAsync()
             {
                 co_await keyCheckpointFileSPtr_->CloseAsync();
@@ -48,16 +48,27 @@ namespace Data
                 return size_;
             }
 
+            // Index of the keys that are only on disk. Set when the store keeps its consolidated keys on disk, null otherwise
+            __declspec(property(get = get_DiskKeyIndex, put = set_DiskKeyIndex)) KSharedPtr<DiskKeyIndex<TKey, TValue>> DiskKeyIndexSPtr;
+            KSharedPtr<DiskKeyIndex<TKey, TValue>> get_DiskKeyIndex() const
+            {
+                return diskKeyIndexSPtr_;
+            }
+
+            void set_DiskKeyIndex(__in KSharedPtr<DiskKeyIndex<TKey, TValue>> const & value)
+            {
+                diskKeyIndexSPtr_ = value;
+            }
+
             void Add(__in TKey& key, __in VersionedItem<TValue>& value)
             {
                 KInvariant(value.GetRecordKind() != RecordKind::DeletedVersion);
-                KSharedPtr<VersionedItem<TValue>> valueSPtr = &value;
 
                 // There are no concurrent checkpoint, so it is okay to do it without a lock.
-                auto existingValue = Read(key);
-                KInvariant(existingValue == nullptr);
+                KInvariant(ContainsKey(key) == false);
 
-                componentSPtr_->Add(key, valueSPtr);
+                PackedVersionedItem<TValue> entry(value);
+                componentSPtr_->Add(key, entry);
 
                 if (value.IsInMemory() == true)
                 {
@@ -65,25 +76,46 @@ namespace Data
                 }
             }
 
+            //
+            // Adds an entry enumerated from another consolidated state without creating a versioned item for it.
+            // Items whose value has been swept since are packed.
+            //
+            void Add(__in TKey& key, __in PackedVersionedItem<TValue> const & entry)
+            {
+                auto versionedItemSPtr = entry.TryGetVersionedItem();
+                if (versionedItemSPtr != nullptr)
+                {
+                    Add(key, *versionedItemSPtr);
+                    return;
+                }
+
+                KInvariant(entry.GetRecordKind() != RecordKind::DeletedVersion);
+                KInvariant(ContainsKey(key) == false);
+
+                componentSPtr_->Add(key, entry);
+            }
+
             void Update(__in TKey& key, VersionedItem<TValue>& value)
             {
-                auto existingValue = Read(key);
-                ASSERT_IFNOT(existingValue != nullptr, "Existing value should not be null");
+                PackedVersionedItem<TValue> existingEntry;
+                bool exists = componentSPtr_->TryGetValue(key, existingEntry);
+                ASSERT_IFNOT(exists, "Existing value should not be null");
 
-                auto existingSequenceNumber = existingValue->GetVersionSequenceNumber();
+                auto existingSequenceNumber = existingEntry.GetVersionSequenceNumber();
                 auto updateSequenceNumber = value.GetVersionSequenceNumber();
                 ASSERT_IFNOT(existingSequenceNumber == updateSequenceNumber, "Sequence numbers should match: Existing {0} != Update {1}", existingSequenceNumber, updateSequenceNumber);
 
-                componentSPtr_->UpdateValue(key, &value);
+                PackedVersionedItem<TValue> entry(value);
+                componentSPtr_->UpdateValue(key, entry);
 
                 // Increase size by new value and decrease by existing value
 
                 if (value.IsInMemory() == true)
                 {
                    // Existing value might or might be in memory
-                   if (existingValue->IsInMemory() == true)
+                   if (existingEntry.IsInMemory() == true)
                    {
-                      InterlockedAdd64(&size_, value.GetValueSize() - existingValue->GetValueSize());
+                      InterlockedAdd64(&size_, value.GetValueSize() - existingEntry.GetValueSize());
                    }
                    else
                    {
@@ -93,10 +125,10 @@ namespace Data
                 }
                 else
                 {
-                   if (existingValue->IsInMemory() == true)
+                   if (existingEntry.IsInMemory() == true)
                    {
                       // Subtract the existing value
-                      InterlockedAdd64(&size_, -existingValue->GetValueSize());
+                      InterlockedAdd64(&size_, -existingEntry.GetValueSize());
                    }
                    else
                    {
@@ -112,18 +144,27 @@ namespace Data
 
             KSharedPtr<VersionedItem<TValue>> Read(__in TKey& key) const
             {
-                KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = nullptr;
-                componentSPtr_->TryGetValue(key, versionedItemSPtr);
-                return versionedItemSPtr;
+                Index index(-1, -1);
+                if (!componentSPtr_->TryGetIndex(key, index))
+                {
+                    return nullptr;
+                }
+
+                return GetVersionedItem(componentSPtr_->GetValueReference(index));
             }
 
             KSharedPtr<VersionedItem<TValue>> Read(__in TKey& key, __in LONG64 visibilitySequenceNumber) const
             {
-               KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = Read(key);
+               Index index(-1, -1);
+               if (!componentSPtr_->TryGetIndex(key, index))
+               {
+                   return nullptr;
+               }
 
-               if (versionedItemSPtr != nullptr && versionedItemSPtr->GetVersionSequenceNumber() <= visibilitySequenceNumber)
+               PackedVersionedItem<TValue> & entry = componentSPtr_->GetValueReference(index);
+               if (entry.GetVersionSequenceNumber() <= visibilitySequenceNumber)
                {
-                  return versionedItemSPtr;
+                  return GetVersionedItem(entry);
                }
 
                return nullptr;
@@ -139,7 +180,7 @@ namespace Data
                 return componentSPtr_->Count();
             }
 
-            KSharedPtr<PartitionedListEnumerator<TKey, KSharedPtr<VersionedItem<TValue>>>> EnumerateEntries() const
+            KSharedPtr<PartitionedListEnumerator<TKey, PackedVersionedItem<TValue>>> EnumerateEntries() const
             {
                 return componentSPtr_->GetKeys();
             }
@@ -147,8 +188,8 @@ namespace Data
             KSharedPtr<IFilterableEnumerator<TKey>> EnumerateKeys() const
             {
                 auto keyValueEnumerator = componentSPtr_->GetEnumerator();
-                KSharedPtr<PartitionedSortedListKeysFilterableEnumerator<TKey, KSharedPtr<VersionedItem<TValue>>>> enumerator = nullptr;
-                PartitionedSortedListKeysFilterableEnumerator<TKey, KSharedPtr<VersionedItem<TValue>>>::Create(*keyValueEnumerator, this->GetThisAllocator(), enumerator);
+                KSharedPtr<PartitionedSortedListKeysFilterableEnumerator<TKey, PackedVersionedItem<TValue>>> enumerator = nullptr;
+                PartitionedSortedListKeysFilterableEnumerator<TKey, PackedVersionedItem<TValue>>::Create(*keyValueEnumerator, this->GetThisAllocator(), enumerator);
 
                 return enumerator.RawPtr();
             }
@@ -170,15 +211,27 @@ namespace Data
             }
 
         private:
-            KSharedPtr<PartitionedSortedList<TKey, KSharedPtr<VersionedItem<TValue>>>> componentSPtr_;
+            KSharedPtr<VersionedItem<TValue>> GetVersionedItem(__in PackedVersionedItem<TValue> & entry) const
+            {
+                if (!entry.IsPacked())
+                {
+                    return entry.TryGetVersionedItem();
+                }
+
+                bool isPublished = false;
+                return entry.GetVersionedItem(this->GetThisAllocator(), isPublished);
+            }
+
+            KSharedPtr<PartitionedSortedList<TKey, PackedVersionedItem<TValue>>> componentSPtr_;
+            KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr_;
             ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer);
             LONG64 size_;
         };
 
         template <typename TKey, typename TValue>
-        ConsolidatedStoreComponent<TKey, TValue>::ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer) : size_(0)
+        ConsolidatedStoreComponent<TKey, TValue>::ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer) : diskKeyIndexSPtr_(nullptr), size_(0)
         {
-           NTSTATUS status = PartitionedSortedList<TKey, KSharedPtr<VersionedItem<TValue>>>::Create(keyComparer, this->GetThisAllocator(), componentSPtr_);
+           NTSTATUS status = PartitionedSortedList<TKey, PackedVersionedItem<TValue>>::Create(keyComparer, this->GetThisAllocator(), componentSPtr_);
            this->SetConstructorStatus(status);
         }
 
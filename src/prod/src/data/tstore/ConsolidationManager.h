@@ -139,6 +139,17 @@ namespace Data
                   auto oldConsolidatedStateSPtr = cachedAggregatedComponentSPtr->GetConsolidatedState();
                   STORE_ASSERT(oldConsolidatedStateSPtr != nullptr, "oldConsolidatedStateSPtr != nullptr");
 
+                  // When the consolidated keys are kept on disk, the consolidated state stays empty and the keys are looked up in the files instead.
+                  KSharedPtr<DiskKeyIndex<TKey, TValue>> oldDiskKeyIndexSPtr = nullptr;
+                  if (consolidationProviderSPtr_->EnableDiskResidentKeys)
+                  {
+                     oldDiskKeyIndexSPtr = oldConsolidatedStateSPtr->DiskKeyIndexSPtr;
+                     if (oldDiskKeyIndexSPtr == nullptr)
+                     {
+                        oldDiskKeyIndexSPtr = CreateDiskKeyIndex();
+                     }
+                  }
+
                   KSharedPtr<SharedPriorityQueue<KSharedPtr<DifferentialStateEnumerator<TKey, TValue>>>> priorityQueueSPtr = nullptr;
 
                   status = SharedPriorityQueue<KSharedPtr<DifferentialStateEnumerator<TKey, TValue>>>::Create(
@@ -199,13 +210,11 @@ namespace Data
                      // Key in consolidation is smaller than key in differential.
                      if (keyComparison > 0)
                      {
-                        auto consolidatedVersionedItemSPtr = oldConsolidatedStateSPtr->Read(consolidatedStateKey);
-                        STORE_ASSERT(consolidatedVersionedItemSPtr != nullptr, "consolidatedVersionedItemSPtr != nullptr");
-
+                        // Move the entry as is, to avoid creating versioned items for packed entries.
                         // Note: On Hydrate, we load all the items including deleted because we could read in any order. Ignore adding them here.
-                        if (consolidatedVersionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion)
+                        if (consolidatedStateEntry.Value.GetRecordKind() != RecordKind::DeletedVersion)
                         {
-                           newConsolidatedStateSPtr->Add(consolidatedStateKey, *consolidatedVersionedItemSPtr);
+                           newConsolidatedStateSPtr->Add(consolidatedStateKey, consolidatedStateEntry.Value);
                         }
 
                         isConsolidatedStateDrained = !consolidatedStateEnumeratorSPtr->MoveNext();
@@ -303,12 +312,10 @@ namespace Data
                      {
                         auto consolidatedStateEntry = consolidatedStateEnumeratorSPtr->Current();
                         TKey consolidatedStateKey = consolidatedStateEntry.Key;
-                        auto valueInConsolidatedStateSPtr = oldConsolidatedStateSPtr->Read(consolidatedStateKey);
-                        STORE_ASSERT(valueInConsolidatedStateSPtr != nullptr, "valueInConsolidatedStateSPtr != nullptr");
 
-                        if (valueInConsolidatedStateSPtr->GetRecordKind() != RecordKind::DeletedVersion)
+                        if (consolidatedStateEntry.Value.GetRecordKind() != RecordKind::DeletedVersion)
                         {
-                           newConsolidatedStateSPtr->Add(consolidatedStateKey, *valueInConsolidatedStateSPtr);
+                           newConsolidatedStateSPtr->Add(consolidatedStateKey, consolidatedStateEntry.Value);
                         }
 
                         isConsolidatedStateDrained = !consolidatedStateEnumeratorSPtr->MoveNext();
@@ -329,6 +336,34 @@ namespace Data
 
                         auto previousVersionSPtr = differentialStateVersionsSPtr->PreviousVersionSPtr;
 
+                        if (oldDiskKeyIndexSPtr != nullptr)
+                        {
+                           // Same as a key found in the consolidated state above, with the version on disk.
+                           KSharedPtr<VersionedItem<TValue>> valueOnDiskSPtr = nullptr;
+                           bool isRead = co_await oldDiskKeyIndexSPtr->TryReadAsync(differentialStateKey, Constants::InvalidLsn, valueOnDiskSPtr);
+                           STORE_ASSERT(isRead, "Files of the consolidated state cannot be released during consolidation");
+
+                           if (valueOnDiskSPtr != nullptr && valueOnDiskSPtr->GetRecordKind() != RecordKind::DeletedVersion)
+                           {
+                              FileMetadata::SPtr fileMetadataSPtr = nullptr;
+                              if (!metadataTableSPtr->Table->TryGetValue(valueOnDiskSPtr->GetFileId(), fileMetadataSPtr))
+                              {
+                                 STORE_ASSERT(
+                                    fileMetadataSPtr != nullptr,
+                                    "Failed to find file metadata for versioned item on disk with file id {1}.",
+                                    valueOnDiskSPtr->GetFileId());
+                              }
+
+                              fileMetadataSPtr->DecrementValidEntries();
+
+                              STORE_ASSERT(valueOnDiskSPtr->GetVersionSequenceNumber() < currentVersionSPtr->GetVersionSequenceNumber(),
+                                 "valueOnDiskSPtr->GetVersionSequenceNumber {1} < currentVersionSPtr->GetVersionSequenceNumber {2}",
+                                 valueOnDiskSPtr->GetVersionSequenceNumber(),
+                                 currentVersionSPtr->GetVersionSequenceNumber());
+                              versionedItems->Append(valueOnDiskSPtr);
+                           }
+                        }
+
                         if (previousVersionSPtr != nullptr)
                         {
                            STORE_ASSERT(currentVersionSPtr->GetVersionSequenceNumber() > previousVersionSPtr->GetVersionSequenceNumber(),
@@ -337,11 +372,15 @@ namespace Data
                               previousVersionSPtr->GetVersionSequenceNumber());
 
                            versionedItems->Append(previousVersionSPtr);
+                        }
+
+                        if (versionedItems->Count() > 0)
+                        {
                            versionedItems->Append(currentVersionSPtr);
                            ProcessToBeRemovedVersions(differentialStateKey, *versionedItems, *metadataTableSPtr);
                         }
 
-                        if (currentVersionSPtr->GetRecordKind() != RecordKind::DeletedVersion)
+                        if (oldDiskKeyIndexSPtr == nullptr && currentVersionSPtr->GetRecordKind() != RecordKind::DeletedVersion)
                         {
                            newConsolidatedStateSPtr->Add(differentialStateKey, *currentVersionSPtr);
                         }
@@ -352,6 +391,12 @@ namespace Data
 
                   differentialDataEnumeratorSPtr = nullptr;
 
+                  if (oldDiskKeyIndexSPtr != nullptr)
+                  {
+                     // Index the files written since the last consolidation
+                     newConsolidatedStateSPtr->DiskKeyIndexSPtr = co_await oldDiskKeyIndexSPtr->CreateForTableAsync(*metadataTableSPtr, cancellationToken);
+                  }
+
                   // Call merge before switching states
 
                   // If any files fall below the threshold, merge them together
@@ -362,6 +407,14 @@ namespace Data
                      postMergeMetadataTableInformation = co_await MergeAsync(*metadataTableSPtr, *mergeFileIds, *newConsolidatedStateSPtr, cancellationToken);
                      STORE_ASSERT(postMergeMetadataTableInformation != nullptr, "Merge result cannot be null");
                      STORE_ASSERT(postMergeMetadataTableInformation->DeletedFileIdsSPtr != nullptr, "Deleted list cannot be null");
+
+                     if (oldDiskKeyIndexSPtr != nullptr)
+                     {
+                        newConsolidatedStateSPtr->DiskKeyIndexSPtr = co_await newConsolidatedStateSPtr->DiskKeyIndexSPtr->CreateAfterMergeAsync(
+                           *postMergeMetadataTableInformation->DeletedFileIdsSPtr,
+                           postMergeMetadataTableInformation->NewMergedFileSPtr.RawPtr(),
+                           cancellationToken);
+                     }
                   }
 
                   KSharedPtr<AggregatedStoreComponent<TKey, TValue>> newAggregatedComponentSPtr = nullptr;
@@ -477,6 +530,110 @@ namespace Data
                return cachedAggregratedStoreComponentSPtr->Read(key, visbilityLsn);
             }
 
+            //
+            // Same as Read, but also looks up the checkpoint files when the consolidated keys are kept on disk.
+            // Items read from disk can be deleted versions.
+            //
+            ktl::Awaitable<KSharedPtr<VersionedItem<TValue>>> ReadAsync(
+               __in TKey & key,
+               __in LONG64 visibilityLsn = Constants::InvalidLsn)
+            {
+               TKey snapKey = key;
+
+               while (true)
+               {
+                  auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+                  STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+                  KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = visibilityLsn == Constants::InvalidLsn ?
+                     cachedAggregratedStoreComponentSPtr->Read(snapKey) :
+                     cachedAggregratedStoreComponentSPtr->Read(snapKey, visibilityLsn);
+
+                  if (versionedItemSPtr != nullptr)
+                  {
+                     co_return versionedItemSPtr;
+                  }
+
+                  KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->DiskKeyIndexSPtr;
+                  if (diskKeyIndexSPtr == nullptr)
+                  {
+                     co_return nullptr;
+                  }
+
+                  if (co_await diskKeyIndexSPtr->TryReadAsync(snapKey, visibilityLsn, versionedItemSPtr))
+                  {
+                     co_return versionedItemSPtr;
+                  }
+
+                  // A merged file was released after this aggregated state was replaced, retry with the new one.
+               }
+            }
+
+            //
+            // Returns an enumerator over the keys that are only on disk, null if the consolidated keys are kept in memory.
+            //
+            ktl::Awaitable<KSharedPtr<IAsyncEnumerator<TKey>>> CreateDiskKeyEnumeratorAsync(
+               __in bool useFirstKey,
+               __in TKey & firstKey,
+               __in bool useLastKey,
+               __in TKey & lastKey,
+               __in LONG64 visibilityLsn)
+            {
+               TKey snapFirstKey = firstKey;
+               TKey snapLastKey = lastKey;
+
+               while (true)
+               {
+                  auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+                  STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+                  KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->DiskKeyIndexSPtr;
+                  if (diskKeyIndexSPtr == nullptr)
+                  {
+                     co_return nullptr;
+                  }
+
+                  KSharedPtr<IAsyncEnumerator<TKey>> enumeratorSPtr = nullptr;
+                  if (co_await diskKeyIndexSPtr->TryCreateKeyEnumeratorAsync(useFirstKey, snapFirstKey, useLastKey, snapLastKey, visibilityLsn, enumeratorSPtr))
+                  {
+                     co_return enumeratorSPtr;
+                  }
+               }
+            }
+
+            KSharedPtr<DiskKeyIndex<TKey, TValue>> CreateDiskKeyIndex()
+            {
+               KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = nullptr;
+               NTSTATUS status = DiskKeyIndex<TKey, TValue>::Create(
+                  *consolidationProviderSPtr_->KeyComparerSPtr,
+                  *consolidationProviderSPtr_->KeyConverterSPtr,
+                  *keyBlockCacheSPtr_,
+                  *traceComponent_,
+                  this->GetThisAllocator(),
+                  diskKeyIndexSPtr);
+               Diagnostics::Validate(status);
+
+               return diskKeyIndexSPtr;
+            }
+
+            // Only called on recovery, before the consolidated state is shared.
+            void SetDiskKeyIndex(__in DiskKeyIndex<TKey, TValue> & diskKeyIndex)
+            {
+               auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+               STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+               cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->DiskKeyIndexSPtr = &diskKeyIndex;
+            }
+
+            LONG64 GetDiskKeyIndexSize()
+            {
+               auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+               STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+               KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->DiskKeyIndexSPtr;
+               return diskKeyIndexSPtr == nullptr ? 0 : diskKeyIndexSPtr->MemorySize;
+            }
+
             KSharedPtr<IEnumerator<TKey>> GetSortedKeyEnumerable(__in bool useFirstKey, __in TKey & firstKey, __in bool useLastKey, __in TKey & lastKey)
             {
                auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
@@ -501,6 +658,14 @@ namespace Data
                return cachedAggregratedStoreComponentSPtr->GetMemorySize();
             }
 
+            KSharedPtr<ConsolidatedStoreComponent<TKey, TValue>> GetConsolidatedState()
+            {
+               auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+               STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+               return cachedAggregratedStoreComponentSPtr->GetConsolidatedState();
+            }
+
             void AddToMemorySize(__in LONG64 size)
             {
                auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
@@ -613,7 +778,13 @@ namespace Data
                {
                   cancellationToken.ThrowIfCancellationRequested();
                   auto item = consolidatedComponentEnumerator->Current();
-                  auto versionedItem = item.Value;
+
+                  // Packed entries do not hold a value
+                  auto versionedItem = item.Value.TryGetVersionedItem();
+                  if (versionedItem == nullptr)
+                  {
+                     continue;
+                  }
 
                   if (versionedItem->GetRecordKind() != RecordKind::DeletedVersion)
                   {
@@ -702,6 +873,7 @@ namespace Data
                     MetadataTable::SPtr mergeTableSPtr = &mergeTable;
                     KSharedPtr<ConsolidatedStoreComponent<TKey, TValue>> newConsolidatedStateSPtr = &newConsolidatedState;
                     KSharedArray<ULONG32>::SPtr listOfFileIdsSPtr = &listOfFileIds;
+                    KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = newConsolidatedStateSPtr->DiskKeyIndexSPtr;
 
                     // TODO: trace
                     FileMetadata::SPtr mergedFileMetadataSPtr = nullptr;
@@ -818,6 +990,18 @@ namespace Data
                         }
 
                         auto latestValueSPtr = newConsolidatedStateSPtr->Read(keyToWrite);
+                        if (diskKeyIndexSPtr != nullptr)
+                        {
+                            // The consolidated state is empty, the latest version is the one on disk.
+                            bool isRead = co_await diskKeyIndexSPtr->TryReadAsync(keyToWrite, Constants::InvalidLsn, latestValueSPtr);
+                            STORE_ASSERT(isRead, "Files of the consolidated state cannot be released during merge");
+
+                            if (latestValueSPtr != nullptr && latestValueSPtr->GetRecordKind() == RecordKind::DeletedVersion)
+                            {
+                                latestValueSPtr = nullptr;
+                            }
+                        }
+
                         bool shouldKeyBeWritten = false;
                         bool shouldWriteSerializedValue = false;
                         KBuffer::SPtr serializedValueSPtr = nullptr;
@@ -905,7 +1089,7 @@ namespace Data
                                 co_await blockAlignedWriterSPtr->BlockAlignedWriteItemAsync(kvpToWrite, nullptr, true);
                             }
 
-                            if (kvpToWrite.Value->GetRecordKind() != RecordKind::DeletedVersion)
+                            if (diskKeyIndexSPtr == nullptr && kvpToWrite.Value->GetRecordKind() != RecordKind::DeletedVersion)
                             {
                                 // Copy-on-write the versioned value in-memory into the next consolidated state, to avoid taking locks.
                                 // TODO: check on perf testing for this allocation
@@ -1196,6 +1380,9 @@ namespace Data
             ULONG32 numberOfDeltasToBeConsolidated_;
             ULONG32 snapshotOfHighestIndexOnConsolidation_;
 
+            // Shared by all the disk key indexes of the store
+            KSharedPtr<KeyBlockCache<TKey, TValue>> keyBlockCacheSPtr_;
+
             StoreTraceComponent::SPtr traceComponent_;
         };
 
@@ -1207,7 +1394,8 @@ namespace Data
            consolidationProviderSPtr_(&consolidationProvider),
            aggregatedStoreComponentSPtr_(nullptr),
            newAggregatedStoreComponentSPtr_(nullptr),
-           numberOfDeltasToBeConsolidated_(Constants::DefaultNumberOfDeltasTobeConsolidated)
+           numberOfDeltasToBeConsolidated_(Constants::DefaultNumberOfDeltasTobeConsolidated),
+           keyBlockCacheSPtr_(nullptr)
         {
            KSharedPtr<AggregatedStoreComponent<TKey, TValue>> aggregatedStoreComponentSPtr = nullptr;
            NTSTATUS status = AggregatedStoreComponent<TKey, TValue>::Create(*consolidationProviderSPtr_->KeyComparerSPtr, traceComponent, this->GetThisAllocator(), aggregatedStoreComponentSPtr);
@@ -1217,6 +1405,13 @@ namespace Data
               return;
            }
 
+           status = KeyBlockCache<TKey, TValue>::Create(Constants::DiskKeyIndexBlockCacheSize, this->GetThisAllocator(), keyBlockCacheSPtr_);
+           if (!NT_SUCCESS(status))
+           {
+              this->SetConstructorStatus(status);
+              return;
+           }
+
            aggregatedStoreComponentSPtr_.Put(Ktl::Move(aggregatedStoreComponentSPtr));
         }
 
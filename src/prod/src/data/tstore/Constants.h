@@ -55,6 +55,18 @@ namespace Data
 
             // Default timeout for acquiring metadata table lock
             static const ULONG32 MetadataTableLockTimeoutMilliseconds = 1000;
+
+            // Number of decoded key blocks cached by a store that keeps its keys on disk
+            static const ULONG32 DiskKeyIndexBlockCacheSize = 1024;
+
+            // Bloom filter bits per key of a checkpoint file's key index. 10 bits give about 1% false positives.
+            static const ULONG32 DiskKeyIndexBloomFilterBitsPerKey = 10;
+
+            // Number of keys a key enumerator reads ahead from the checkpoint files of a store that keeps its keys on disk
+            static const ULONG32 DiskKeyReadAheadCount = 1024;
+
+            // Number of blocks decompressed concurrently when restoring a compressed checkpoint file
+            static const ULONG32 RestoreDegreeOfParallelism = 4;
         };
     }
 }
@@ -38,6 +38,8 @@ CopyManager::CopyManager(
     copyCompleted_(true), // Starting at true in case of empty copy
     currentCopyFileNameSPtr_(nullptr),
     currentCopyFileStreamSPtr_(nullptr),
+    pendingWriteBufferSPtr_(nullptr),
+    isWritePending_(false),
     copyProtocolVersion_(InvalidCopyProtocolVersion),
     fileCount_(0),
     metadataTableSPtr_(nullptr),
@@ -73,6 +75,19 @@ ktl::Awaitable<ULONG32> CopyManager::ProcessCopyOperationAsync(__in KStringView
     byte* buffer = static_cast<byte *>(dataSPtr->GetBuffer());
     StoreCopyOperation::Enum operation = static_cast<StoreCopyOperation::Enum>(buffer[dataSPtr->QuerySize() - 1]);
 
+    // File chunks are written straight from the received buffer, without the last byte.
+    if (operation == StoreCopyOperation::WriteKeyFile)
+    {
+        co_await ProcessWriteKeyFileCopyOperationAsync(directory, *dataSPtr, dataSPtr->QuerySize() - 1);
+        co_return dataSPtr->QuerySize();
+    }
+
+    if (operation == StoreCopyOperation::WriteValueFile)
+    {
+        co_await ProcessWriteValueFileCopyOperationAsync(directory, *dataSPtr, dataSPtr->QuerySize() - 1);
+        co_return dataSPtr->QuerySize();
+    }
+
     // Create a buffer with all the data except the last byte
     KBuffer::SPtr operationDataBuffer = nullptr;
     auto status = KBuffer::CreateOrCopyFrom(operationDataBuffer, *dataSPtr, 0, dataSPtr->QuerySize() - 1, GetThisAllocator());
@@ -89,18 +104,12 @@ ktl::Awaitable<ULONG32> CopyManager::ProcessCopyOperationAsync(__in KStringView
     case StoreCopyOperation::StartKeyFile: 
         co_await ProcessStartKeyFileCopyOperationAsync(directory, *operationDataBuffer); 
         break;
-    case StoreCopyOperation::WriteKeyFile: 
-        co_await ProcessWriteKeyFileCopyOperationAsync(directory, *operationDataBuffer); 
-        break;
     case StoreCopyOperation::EndKeyFile: 
         co_await ProcessEndKeyFileCopyOperationAsync(directory, *operationDataBuffer); 
         break;
     case StoreCopyOperation::StartValueFile: 
         co_await ProcessStartValueFileCopyOperationAsync(directory, *operationDataBuffer); 
         break;
-    case StoreCopyOperation::WriteValueFile: 
-        co_await ProcessWriteValueFileCopyOperationAsync(directory, *operationDataBuffer); 
-        break;
     case StoreCopyOperation::EndValueFile: 
         co_await ProcessEndValueFileCopyOperationAsync(directory, *operationDataBuffer); 
         break;
@@ -271,7 +280,7 @@ ktl::Awaitable<void> CopyManager::ProcessStartKeyFileCopyOperationAsync(__in KSt
     }
 }
 
-ktl::Awaitable<void> CopyManager::ProcessWriteKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data)
+ktl::Awaitable<void> CopyManager::ProcessWriteKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data, __in ULONG count)
 {
     SharedException::CSPtr exceptionCSPtr = nullptr;
 
@@ -282,16 +291,17 @@ ktl::Awaitable<void> CopyManager::ProcessWriteKeyFileCopyOperationAsync(__in KSt
             traceComponent_->TraceTag,
             ToStringLiteral(directory), 
             ToStringLiteral(*currentCopyFileNameSPtr_),
-            data.QuerySize());
+            count);
 
         // Consistency checks
         STORE_ASSERT(copyProtocolVersion_ != InvalidCopyProtocolVersion, "unexpected copy operation: WriteKeyFile received before Version operation");
         STORE_ASSERT(metadataTableSPtr_ != nullptr, "unexpected copy operation: WriteKeyFile received before metadata table");
         STORE_ASSERT(currentCopyFileStreamSPtr_ != nullptr, "unexpected copy operation: WriteKeyFile received before StartKeyFile");
 
-        // Append the data to the existing checkpoint file stream
-        auto status = co_await currentCopyFileStreamSPtr_->WriteAsync(data);
-        Diagnostics::Validate(status);
+        // Append the data to the existing checkpoint file stream.
+        // The write is only awaited when the next chunk arrives, so that the disk write overlaps the next network transfer.
+        co_await CompletePendingWriteAsync();
+        StartWrite(data, count);
     }
     catch (ktl::Exception const & e)
     {
@@ -326,6 +336,7 @@ ktl::Awaitable<void> CopyManager::ProcessEndKeyFileCopyOperationAsync(__in KStri
             currentCopyFileStreamSPtr_->Position);
 
         // Flush and close the current copied checkpoint file stream.
+        co_await CompletePendingWriteAsync();
         auto status = co_await currentCopyFileStreamSPtr_->FlushAsync();
         Diagnostics::Validate(status);
 
@@ -424,7 +435,7 @@ ktl::Awaitable<void> CopyManager::ProcessStartValueFileCopyOperationAsync(__in K
     }
 }
 
-ktl::Awaitable<void> CopyManager::ProcessWriteValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data)
+ktl::Awaitable<void> CopyManager::ProcessWriteValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data, __in ULONG count)
 {
     SharedException::CSPtr exceptionCSPtr = nullptr;
 
@@ -435,16 +446,17 @@ ktl::Awaitable<void> CopyManager::ProcessWriteValueFileCopyOperationAsync(__in K
             traceComponent_->TraceTag,
             ToStringLiteral(directory),
             ToStringLiteral(*currentCopyFileNameSPtr_),
-            data.QuerySize());
+            count);
 
         // Consistency checks
         STORE_ASSERT(copyProtocolVersion_ != InvalidCopyProtocolVersion, "unexpected copy operation: WriteValueFile before Version operation");
         STORE_ASSERT(metadataTableSPtr_ != nullptr, "unexpected copy operation: WriteValueFile received before metadata table");
         STORE_ASSERT(currentCopyFileStreamSPtr_ != nullptr, "unexpected copy operation: WriteValueFile received before StartKeyFile");
 
-        // Append the data to the existing checkpoint file stream
-        auto status = co_await currentCopyFileStreamSPtr_->WriteAsync(data);
-        Diagnostics::Validate(status);
+        // Append the data to the existing checkpoint file stream.
+        // The write is only awaited when the next chunk arrives, so that the disk write overlaps the next network transfer.
+        co_await CompletePendingWriteAsync();
+        StartWrite(data, count);
     }
     catch (ktl::Exception const & e)
     {
@@ -479,6 +491,7 @@ ktl::Awaitable<void> CopyManager::ProcessEndValueFileCopyOperationAsync(__in KSt
         STORE_ASSERT(currentCopyFileNameSPtr_ != nullptr, "unexpected copy operation: EndValueFile received when we don't have a valid checkpoint file");
 
         // Flush and close the current copied checkpoint file stream.
+        co_await CompletePendingWriteAsync();
         auto status = co_await currentCopyFileStreamSPtr_->FlushAsync();
         Diagnostics::Validate(status);
 
@@ -562,6 +575,14 @@ ktl::Awaitable<void> CopyManager::ProcessCompleteCopyOperationAsync(__in KString
 
 ktl::Awaitable<void> CopyManager::CloseAsync()
 {
+    // The stream cannot be closed under an outstanding write. The copy is being abandoned so its result does not matter.
+    if (isWritePending_)
+    {
+        co_await pendingWriteAwaitable_;
+        isWritePending_ = false;
+        pendingWriteBufferSPtr_ = nullptr;
+    }
+
     if (currentCopyFileStreamSPtr_ != nullptr)
     {
         NTSTATUS status = co_await currentCopyFileStreamSPtr_->CloseAsync();
@@ -578,6 +599,30 @@ ktl::Awaitable<void> CopyManager::CloseAsync()
     copyProtocolVersion_ = StoreCopyOperation::Enum::Version;
 }
 
+void CopyManager::StartWrite(__in KBuffer & data, __in ULONG count)
+{
+    STORE_ASSERT(isWritePending_ == false, "unexpected copy error: write already pending");
+
+    // Keep the buffer alive until the write completes.
+    pendingWriteBufferSPtr_ = &data;
+    pendingWriteAwaitable_ = currentCopyFileStreamSPtr_->WriteAsync(data, 0, count);
+    isWritePending_ = true;
+}
+
+ktl::Awaitable<void> CopyManager::CompletePendingWriteAsync()
+{
+    if (isWritePending_ == false)
+    {
+        co_return;
+    }
+
+    NTSTATUS status = co_await pendingWriteAwaitable_;
+    isWritePending_ = false;
+    pendingWriteBufferSPtr_ = nullptr;
+
+    Diagnostics::Validate(status);
+}
+
 KString::SPtr CopyManager::CombinePaths(__in KStringView const & directory, __in KStringView const & filename)
 {
     KString::SPtr filePathSPtr;
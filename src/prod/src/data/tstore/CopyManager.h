@@ -49,13 +49,16 @@ namespace Data
             ktl::Awaitable<void> ProcessVersionCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
             ktl::Awaitable<void> ProcessMetadataTableCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
             ktl::Awaitable<void> ProcessStartKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
-            ktl::Awaitable<void> ProcessWriteKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
+            ktl::Awaitable<void> ProcessWriteKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data, __in ULONG count);
             ktl::Awaitable<void> ProcessEndKeyFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
             ktl::Awaitable<void> ProcessStartValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
-            ktl::Awaitable<void> ProcessWriteValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
+            ktl::Awaitable<void> ProcessWriteValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data, __in ULONG count);
             ktl::Awaitable<void> ProcessEndValueFileCopyOperationAsync(__in KStringView const & directory, __in KBuffer & data);
             ktl::Awaitable<void> ProcessCompleteCopyOperationAsync(__in KStringView const & directory);
 
+            void StartWrite(__in KBuffer & data, __in ULONG count);
+            ktl::Awaitable<void> CompletePendingWriteAsync();
+
             KString::SPtr CombinePaths(__in KStringView const & directory, __in KStringView const & file);
             ktl::Awaitable<KBlockFile::SPtr> OpenFileAsync(__in KStringView const & filename);
             static ULONG32 GetULONG32(__in KBuffer & buffer, __in ULONG offsetBytes);
@@ -67,6 +70,11 @@ namespace Data
             KString::SPtr currentCopyFileNameSPtr_;
             KBlockFile::SPtr currentCopyFileSPtr_;
             ktl::io::KFileStream::SPtr currentCopyFileStreamSPtr_;
+
+            // Write of the last received chunk, completed when the next operation for the file arrives.
+            ktl::Awaitable<NTSTATUS> pendingWriteAwaitable_;
+            KBuffer::SPtr pendingWriteBufferSPtr_;
+            bool isWritePending_;
             ULONG32 copyProtocolVersion_;
             ULONG32 fileCount_;
             MetadataTable::SPtr metadataTableSPtr_;
@@ -0,0 +1,397 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define DISKKEYINDEX_TAG 'xiKD'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Consolidated view of the keys that only live in the checkpoint files, used instead of the in-memory
+        // consolidated state when EnableDiskResidentKeys is set. It keeps one KeyCheckpointFileIndex per file of a metadata table.
+        //
+        // Files are not ordered by LSN (a merged file holds older versions than the files written after it was started),
+        // so a read looks the key up in every file whose bloom filter matches and keeps the version with the highest LSN.
+        //
+        // An index is immutable once created. Changes to the set of files create a new index that shares the unchanged file indexes.
+        //
+        template<typename TKey, typename TValue>
+        class DiskKeyIndex : public KObject<DiskKeyIndex<TKey, TValue>>, public KShared<DiskKeyIndex<TKey, TValue>>
+        {
+            K_FORCE_SHARED(DiskKeyIndex)
+
+        public:
+            static NTSTATUS Create(
+                __in IComparer<TKey> & keyComparer,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in KeyBlockCache<TKey, TValue> & blockCache,
+                __in StoreTraceComponent & traceComponent,
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                NTSTATUS status;
+                SPtr output = _new(DISKKEYINDEX_TAG, allocator) DiskKeyIndex(keyComparer, keySerializer, blockCache, traceComponent);
+
+                if (!output)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                status = output->Status();
+                if (!NT_SUCCESS(status))
+                {
+                    return status;
+                }
+
+                result = Ktl::Move(output);
+                return STATUS_SUCCESS;
+            }
+
+            __declspec(property(get = get_FileCount)) ULONG32 FileCount;
+            ULONG32 get_FileCount() const
+            {
+                return fileIndexesSPtr_->Count();
+            }
+
+            __declspec(property(get = get_MemorySize)) LONG64 MemorySize;
+            LONG64 get_MemorySize() const
+            {
+                LONG64 size = 0;
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    size += (*fileIndexesSPtr_)[i]->MemorySize;
+                }
+
+                return size;
+            }
+
+            //
+            // Only called before the index is shared.
+            //
+            void Add(__in KeyCheckpointFileIndex<TKey, TValue> & fileIndex)
+            {
+                STORE_ASSERT(TryGetFileIndex(fileIndex.FileId) == nullptr, "file {1} is already indexed", fileIndex.FileId);
+
+                KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> fileIndexSPtr = &fileIndex;
+                NTSTATUS status = fileIndexesSPtr_->Append(fileIndexSPtr);
+                Diagnostics::Validate(status);
+            }
+
+            KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> TryGetFileIndex(__in ULONG32 fileId) const
+            {
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    if ((*fileIndexesSPtr_)[i]->FileId == fileId)
+                    {
+                        return (*fileIndexesSPtr_)[i];
+                    }
+                }
+
+                return nullptr;
+            }
+
+            //
+            // Returns a new index over exactly the files of the given metadata table.
+            // Files that are already indexed share their index, the others are read once to build theirs.
+            //
+            ktl::Awaitable<KSharedPtr<DiskKeyIndex<TKey, TValue>>> CreateForTableAsync(
+                __in MetadataTable & metadataTable,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
+                MetadataTable::SPtr metadataTableSPtr = &metadataTable;
+
+                SPtr resultSPtr = nullptr;
+                NTSTATUS status = Create(*keyComparerSPtr_, *keySerializerSPtr_, *blockCacheSPtr_, *traceComponent_, this->GetThisAllocator(), resultSPtr);
+                Diagnostics::Validate(status);
+
+                KSharedPtr<IEnumerator<KeyValuePair<ULONG32, FileMetadata::SPtr>>> enumeratorSPtr = metadataTableSPtr->Table->GetEnumerator();
+                while (enumeratorSPtr->MoveNext())
+                {
+                    FileMetadata::SPtr fileMetadataSPtr = enumeratorSPtr->Current().Value;
+
+                    KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> fileIndexSPtr = TryGetFileIndex(fileMetadataSPtr->FileId);
+                    if (fileIndexSPtr == nullptr)
+                    {
+                        status = KeyCheckpointFileIndex<TKey, TValue>::Create(*fileMetadataSPtr, *keyComparerSPtr_, *traceComponent_, this->GetThisAllocator(), fileIndexSPtr);
+                        Diagnostics::Validate(status);
+
+                        co_await fileIndexSPtr->BuildAsync(*keySerializerSPtr_, cancellationToken);
+                    }
+
+                    resultSPtr->Add(*fileIndexSPtr);
+                }
+
+                co_return resultSPtr;
+            }
+
+            //
+            // Returns a new index without the files that were merged, and with the merged file if one was written.
+            //
+            ktl::Awaitable<KSharedPtr<DiskKeyIndex<TKey, TValue>>> CreateAfterMergeAsync(
+                __in KSharedArray<ULONG32> const & deletedFileIds,
+                __in_opt FileMetadata * mergedFileMetadata,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
+                KSharedArray<ULONG32>::CSPtr deletedFileIdsCSPtr = &deletedFileIds;
+                FileMetadata::SPtr mergedFileMetadataSPtr = mergedFileMetadata;
+
+                SPtr resultSPtr = nullptr;
+                NTSTATUS status = Create(*keyComparerSPtr_, *keySerializerSPtr_, *blockCacheSPtr_, *traceComponent_, this->GetThisAllocator(), resultSPtr);
+                Diagnostics::Validate(status);
+
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    bool isDeleted = false;
+                    for (ULONG32 j = 0; j < deletedFileIdsCSPtr->Count(); j++)
+                    {
+                        if ((*deletedFileIdsCSPtr)[j] == (*fileIndexesSPtr_)[i]->FileId)
+                        {
+                            isDeleted = true;
+                            break;
+                        }
+                    }
+
+                    if (!isDeleted)
+                    {
+                        resultSPtr->Add(*(*fileIndexesSPtr_)[i]);
+                    }
+                }
+
+                if (mergedFileMetadataSPtr != nullptr)
+                {
+                    KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> fileIndexSPtr = nullptr;
+                    status = KeyCheckpointFileIndex<TKey, TValue>::Create(*mergedFileMetadataSPtr, *keyComparerSPtr_, *traceComponent_, this->GetThisAllocator(), fileIndexSPtr);
+                    Diagnostics::Validate(status);
+
+                    co_await fileIndexSPtr->BuildAsync(*keySerializerSPtr_, cancellationToken);
+                    resultSPtr->Add(*fileIndexSPtr);
+                }
+
+                co_return resultSPtr;
+            }
+
+            //
+            // Reads the latest version of the key in the checkpoint files that is visible at visibilityLsn (any version if it is
+            // InvalidLsn). result is null if no file contains a visible version. Deleted versions are returned as is.
+            //
+            // Until the files are merged, older versions stay in the files they were written to and are returned to snapshot readers
+            // from there. Versions that are merged away while a snapshot still needs them are moved to the snapshot container by
+            // consolidation, as for the in-memory consolidated state.
+            //
+            // Returns false if one of the files has already been released, in which case the caller must retry with the newer index.
+            //
+            ktl::Awaitable<bool> TryReadAsync(
+                __in TKey const & key,
+                __in LONG64 visibilityLsn,
+                __out KSharedPtr<VersionedItem<TValue>> & result)
+            {
+                result = nullptr;
+
+                if (fileIndexesSPtr_->Count() == 0)
+                {
+                    co_return true;
+                }
+
+                TKey snapKey = key;
+                ULONG64 keyHash = GetKeyHash(snapKey);
+                KSharedPtr<KeyData<TKey, TValue>> latestSPtr = nullptr;
+
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> fileIndexSPtr = (*fileIndexesSPtr_)[i];
+                    if (!fileIndexSPtr->MayContain(keyHash))
+                    {
+                        continue;
+                    }
+
+                    FileMetadata::SPtr fileMetadataSPtr = fileIndexSPtr->FileMetadataSPtr;
+                    if (!fileMetadataSPtr->TryAddReference())
+                    {
+                        co_return false;
+                    }
+
+                    KSharedPtr<KeyData<TKey, TValue>> keyDataSPtr = nullptr;
+                    SharedException::CSPtr exception = nullptr;
+
+                    try
+                    {
+                        keyDataSPtr = co_await fileIndexSPtr->ReadAsync(snapKey, keyHash, *keySerializerSPtr_, *blockCacheSPtr_);
+                    }
+                    catch (ktl::Exception const & e)
+                    {
+                        exception = SharedException::Create(e, this->GetThisAllocator());
+                    }
+
+                    co_await fileMetadataSPtr->ReleaseReferenceAsync();
+
+                    if (exception != nullptr)
+                    {
+                        //clang compiler error, needs to assign before throw.
+                        auto ex = exception->Info;
+                        throw ex;
+                    }
+
+                    if (keyDataSPtr == nullptr)
+                    {
+                        continue;
+                    }
+
+                    LONG64 sequenceNumber = keyDataSPtr->Value->GetVersionSequenceNumber();
+                    if (visibilityLsn != Constants::InvalidLsn && sequenceNumber > visibilityLsn)
+                    {
+                        continue;
+                    }
+
+                    if (latestSPtr == nullptr || sequenceNumber > latestSPtr->Value->GetVersionSequenceNumber())
+                    {
+                        latestSPtr = keyDataSPtr;
+                    }
+                }
+
+                if (latestSPtr == nullptr)
+                {
+                    co_return true;
+                }
+
+                result = CloneVersionedItem(*latestSPtr->Value);
+                co_return true;
+            }
+
+            //
+            // Returns an enumerator over the keys of all the files that exist at the visibility sequence number (InvalidLsn for the
+            // latest versions), false if one of the files has already been released.
+            //
+            ktl::Awaitable<bool> TryCreateKeyEnumeratorAsync(
+                __in bool useFirstKey,
+                __in TKey & firstKey,
+                __in bool useLastKey,
+                __in TKey & lastKey,
+                __in LONG64 visibilitySequenceNumber,
+                __out KSharedPtr<IAsyncEnumerator<TKey>> & result)
+            {
+                result = nullptr;
+
+                TKey snapFirstKey = firstKey;
+                TKey snapLastKey = lastKey;
+
+                KSharedPtr<KSharedArray<KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>>>> referencedFilesSPtr =
+                    _new(DISKKEYINDEX_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>>>();
+                STORE_ASSERT(referencedFilesSPtr != nullptr, "referencedFilesSPtr != nullptr");
+
+                bool allReferenced = true;
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    if (!(*fileIndexesSPtr_)[i]->FileMetadataSPtr->TryAddReference())
+                    {
+                        allReferenced = false;
+                        break;
+                    }
+
+                    NTSTATUS status = referencedFilesSPtr->Append((*fileIndexesSPtr_)[i]);
+                    Diagnostics::Validate(status);
+                }
+
+                if (!allReferenced)
+                {
+                    for (ULONG32 i = 0; i < referencedFilesSPtr->Count(); i++)
+                    {
+                        co_await (*referencedFilesSPtr)[i]->FileMetadataSPtr->ReleaseReferenceAsync();
+                    }
+
+                    co_return false;
+                }
+
+                KSharedPtr<DiskKeyIndexKeyEnumerator<TKey, TValue>> enumeratorSPtr = nullptr;
+                NTSTATUS status = DiskKeyIndexKeyEnumerator<TKey, TValue>::Create(
+                    *referencedFilesSPtr,
+                    *keyComparerSPtr_,
+                    *keySerializerSPtr_,
+                    useFirstKey,
+                    snapFirstKey,
+                    useLastKey,
+                    snapLastKey,
+                    visibilitySequenceNumber,
+                    *traceComponent_,
+                    this->GetThisAllocator(),
+                    enumeratorSPtr);
+                Diagnostics::Validate(status);
+
+                result = enumeratorSPtr.RawPtr();
+                co_return true;
+            }
+
+        private:
+            ULONG64 GetKeyHash(__in TKey & key)
+            {
+                // Same bytes as the key records of the checkpoint files.
+                Utilities::BinaryWriter binaryWriter(this->GetThisAllocator());
+                keySerializerSPtr_->Write(key, binaryWriter);
+
+                KBuffer::SPtr keyBufferSPtr = binaryWriter.GetBuffer(0);
+                return CRC64::ToCRC64(*keyBufferSPtr, 0, binaryWriter.Position);
+            }
+
+            //
+            // Items of the cached key blocks are shared, readers get their own copy.
+            //
+            KSharedPtr<VersionedItem<TValue>> CloneVersionedItem(__in VersionedItem<TValue> & item)
+            {
+                if (item.GetRecordKind() == RecordKind::DeletedVersion)
+                {
+                    KSharedPtr<DeletedVersionedItem<TValue>> deletedVersionSPtr = nullptr;
+                    NTSTATUS status = DeletedVersionedItem<TValue>::Create(this->GetThisAllocator(), deletedVersionSPtr);
+                    Diagnostics::Validate(status);
+                    deletedVersionSPtr->InitializeOnRecovery(item.GetVersionSequenceNumber(), item.GetFileId());
+                    return deletedVersionSPtr.RawPtr();
+                }
+
+                bool isPublished = false;
+                PackedVersionedItem<TValue> packedItem(item);
+                STORE_ASSERT(packedItem.IsPacked(), "item read from file {1} should not have a value in memory", item.GetFileId());
+                return packedItem.GetVersionedItem(this->GetThisAllocator(), isPublished);
+            }
+
+            DiskKeyIndex(
+                __in IComparer<TKey> & keyComparer,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in KeyBlockCache<TKey, TValue> & blockCache,
+                __in StoreTraceComponent & traceComponent);
+
+            KSharedPtr<KSharedArray<KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>>>> fileIndexesSPtr_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
+            KSharedPtr<KeyBlockCache<TKey, TValue>> blockCacheSPtr_;
+
+            StoreTraceComponent::SPtr traceComponent_;
+        };
+
+        template<typename TKey, typename TValue>
+        DiskKeyIndex<TKey, TValue>::DiskKeyIndex(
+            __in IComparer<TKey> & keyComparer,
+            __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+            __in KeyBlockCache<TKey, TValue> & blockCache,
+            __in StoreTraceComponent & traceComponent)
+            : fileIndexesSPtr_(nullptr)
+            , keyComparerSPtr_(&keyComparer)
+            , keySerializerSPtr_(&keySerializer)
+            , blockCacheSPtr_(&blockCache)
+            , traceComponent_(&traceComponent)
+        {
+            fileIndexesSPtr_ = _new(DISKKEYINDEX_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>>>();
+            if (!fileIndexesSPtr_)
+            {
+                this->SetConstructorStatus(STATUS_INSUFFICIENT_RESOURCES);
+            }
+        }
+
+        template<typename TKey, typename TValue>
+        DiskKeyIndex<TKey, TValue>::~DiskKeyIndex()
+        {
+        }
+    }
+}
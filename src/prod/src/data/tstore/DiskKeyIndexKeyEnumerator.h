@@ -0,0 +1,310 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define DISKKEYINDEXKEYENUMERATOR_TAG 'eiKD'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Enumerates, in order, the keys whose latest version in the checkpoint files is not a delete.
+        // With a visibility sequence number, the latest version is the latest one that is visible at it.
+        // Every file is read from the key block that can contain the first key.
+        //
+        // The enumerator owns one reference on each file, released when it is closed or disposed.
+        //
+        template<typename TKey, typename TValue>
+        class DiskKeyIndexKeyEnumerator
+            : public KObject<DiskKeyIndexKeyEnumerator<TKey, TValue>>
+            , public KShared<DiskKeyIndexKeyEnumerator<TKey, TValue>>
+            , public IAsyncEnumerator<TKey>
+        {
+            K_FORCE_SHARED(DiskKeyIndexKeyEnumerator)
+            K_SHARED_INTERFACE_IMP(IDisposable)
+            K_SHARED_INTERFACE_IMP(IAsyncEnumerator)
+
+        public:
+            typedef KSharedArray<KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>>> FileIndexArray;
+
+            //
+            // The caller must have added one reference on each file, ownership of the references is transferred to the enumerator.
+            //
+            static NTSTATUS Create(
+                __in FileIndexArray & fileIndexes,
+                __in IComparer<TKey> & keyComparer,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in bool useFirstKey,
+                __in TKey & firstKey,
+                __in bool useLastKey,
+                __in TKey & lastKey,
+                __in LONG64 visibilitySequenceNumber,
+                __in StoreTraceComponent & traceComponent,
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                NTSTATUS status;
+                SPtr output = _new(DISKKEYINDEXKEYENUMERATOR_TAG, allocator) DiskKeyIndexKeyEnumerator(
+                    fileIndexes,
+                    keyComparer,
+                    keySerializer,
+                    useFirstKey,
+                    firstKey,
+                    useLastKey,
+                    lastKey,
+                    visibilitySequenceNumber,
+                    traceComponent);
+
+                if (!output)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                status = output->Status();
+                if (!NT_SUCCESS(status))
+                {
+                    return status;
+                }
+
+                result = Ktl::Move(output);
+                return STATUS_SUCCESS;
+            }
+
+            TKey GetCurrent() override
+            {
+                return current_;
+            }
+
+            ktl::Awaitable<bool> MoveNextAsync(__in ktl::CancellationToken const & cancellationToken) override
+            {
+                if (isDone_)
+                {
+                    co_return false;
+                }
+
+                if (!isStarted_)
+                {
+                    isStarted_ = true;
+                    co_await StartAsync(cancellationToken);
+                }
+
+                while (!priorityQueue_.IsEmpty())
+                {
+                    KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr;
+                    bool result = priorityQueue_.Pop(enumeratorSPtr);
+                    STORE_ASSERT(result, "priority queue should not be empty");
+
+                    KSharedPtr<KeyData<TKey, TValue>> keyDataSPtr = enumeratorSPtr->GetCurrent();
+
+                    if (co_await enumeratorSPtr->MoveNextAsync(cancellationToken))
+                    {
+                        priorityQueue_.Push(enumeratorSPtr);
+                    }
+                    else
+                    {
+                        co_await enumeratorSPtr->CloseAsync();
+                    }
+
+                    if (useLastKey_ && keyComparerSPtr_->Compare(keyDataSPtr->Key, lastKey_) > 0)
+                    {
+                        break;
+                    }
+
+                    // Versions of the same key come out latest first, the older ones are skipped.
+                    if (isPreviousSet_ && keyComparerSPtr_->Compare(keyDataSPtr->Key, current_) == 0)
+                    {
+                        continue;
+                    }
+
+                    // Versions written after the visibility sequence number are skipped, the next older one is used.
+                    if (visibilitySequenceNumber_ != Constants::InvalidLsn && keyDataSPtr->Value->GetVersionSequenceNumber() > visibilitySequenceNumber_)
+                    {
+                        continue;
+                    }
+
+                    current_ = keyDataSPtr->Key;
+                    isPreviousSet_ = true;
+
+                    if (keyDataSPtr->Value->GetRecordKind() == RecordKind::DeletedVersion)
+                    {
+                        continue;
+                    }
+
+                    co_return true;
+                }
+
+                co_await CloseAsync();
+                co_return false;
+            }
+
+            void Reset() override
+            {
+                throw ktl::Exception(STATUS_NOT_IMPLEMENTED);
+            }
+
+            void Dispose() override
+            {
+                if (isClosed_)
+                {
+                    return;
+                }
+
+                ktl::Task task = CloseTask();
+                STORE_ASSERT(task.IsTaskStarted(), "Expected close task to start");
+            }
+
+            ktl::Awaitable<void> CloseAsync()
+            {
+                if (isClosed_)
+                {
+                    co_return;
+                }
+
+                isClosed_ = true;
+                isDone_ = true;
+
+                for (ULONG32 i = 0; i < enumeratorsSPtr_->Count(); i++)
+                {
+                    co_await (*enumeratorsSPtr_)[i]->CloseAsync();
+                }
+
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    co_await (*fileIndexesSPtr_)[i]->FileMetadataSPtr->ReleaseReferenceAsync();
+                }
+            }
+
+        private:
+            ktl::Awaitable<void> StartAsync(__in ktl::CancellationToken const & cancellationToken)
+            {
+                for (ULONG32 i = 0; i < fileIndexesSPtr_->Count(); i++)
+                {
+                    KeyCheckpointFileIndex<TKey, TValue> & fileIndex = *(*fileIndexesSPtr_)[i];
+                    CheckpointFile::SPtr checkpointFileSPtr = fileIndex.FileMetadataSPtr->CheckpointFileSPtr;
+
+                    ULONG64 startOffset = checkpointFileSPtr->KeyBlockHandleSPtr->Offset;
+                    if (useFirstKey_)
+                    {
+                        LONG32 blockIndex = fileIndex.FindBlock(firstKey_);
+                        if (blockIndex >= 0)
+                        {
+                            startOffset = fileIndex.GetBlockOffset(static_cast<ULONG32>(blockIndex));
+                        }
+                    }
+
+                    KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr =
+                        checkpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(*keySerializerSPtr_, startOffset);
+                    enumeratorSPtr->KeyComparerSPtr = *keyComparerSPtr_;
+
+                    NTSTATUS status = enumeratorsSPtr_->Append(enumeratorSPtr);
+                    Diagnostics::Validate(status);
+
+                    bool hasKey = co_await enumeratorSPtr->MoveNextAsync(cancellationToken);
+                    while (hasKey && useFirstKey_ && keyComparerSPtr_->Compare(enumeratorSPtr->GetCurrent()->Key, firstKey_) < 0)
+                    {
+                        hasKey = co_await enumeratorSPtr->MoveNextAsync(cancellationToken);
+                    }
+
+                    if (hasKey)
+                    {
+                        priorityQueue_.Push(enumeratorSPtr);
+                    }
+                    else
+                    {
+                        co_await enumeratorSPtr->CloseAsync();
+                    }
+                }
+            }
+
+            ktl::Task CloseTask()
+            {
+                KShared$ApiEntry();
+
+                try
+                {
+                    co_await CloseAsync();
+                }
+                catch (ktl::Exception const & e)
+                {
+                    KDynStringA stackString(this->GetThisAllocator());
+                    Diagnostics::GetExceptionStackTrace(e, stackString);
+                    STORE_ASSERT(
+                        false,
+                        "UnexpectedException: Message: CloseTask Code:{2}\nStack: {1}",
+                        ToStringLiteral(stackString),
+                        e.GetStatus());
+                }
+            }
+
+            DiskKeyIndexKeyEnumerator(
+                __in FileIndexArray & fileIndexes,
+                __in IComparer<TKey> & keyComparer,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in bool useFirstKey,
+                __in TKey & firstKey,
+                __in bool useLastKey,
+                __in TKey & lastKey,
+                __in LONG64 visibilitySequenceNumber,
+                __in StoreTraceComponent & traceComponent);
+
+            KSharedPtr<FileIndexArray> fileIndexesSPtr_;
+            KSharedPtr<KSharedArray<KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>>> enumeratorsSPtr_;
+            KPriorityQueue<KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>> priorityQueue_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
+
+            bool useFirstKey_;
+            TKey firstKey_;
+            bool useLastKey_;
+            TKey lastKey_;
+            LONG64 visibilitySequenceNumber_;
+
+            bool isStarted_ = false;
+            bool isDone_ = false;
+            bool isClosed_ = false;
+            bool isPreviousSet_ = false;
+            TKey current_;
+
+            StoreTraceComponent::SPtr traceComponent_;
+        };
+
+        template<typename TKey, typename TValue>
+        DiskKeyIndexKeyEnumerator<TKey, TValue>::DiskKeyIndexKeyEnumerator(
+            __in FileIndexArray & fileIndexes,
+            __in IComparer<TKey> & keyComparer,
+            __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+            __in bool useFirstKey,
+            __in TKey & firstKey,
+            __in bool useLastKey,
+            __in TKey & lastKey,
+            __in LONG64 visibilitySequenceNumber,
+            __in StoreTraceComponent & traceComponent)
+            : fileIndexesSPtr_(&fileIndexes)
+            , enumeratorsSPtr_(nullptr)
+            , priorityQueue_(this->GetThisAllocator(), KeyCheckpointFileAsyncEnumerator<TKey, TValue>::CompareEnumerators)
+            , keyComparerSPtr_(&keyComparer)
+            , keySerializerSPtr_(&keySerializer)
+            , useFirstKey_(useFirstKey)
+            , firstKey_(firstKey)
+            , useLastKey_(useLastKey)
+            , lastKey_(lastKey)
+            , visibilitySequenceNumber_(visibilitySequenceNumber)
+            , traceComponent_(&traceComponent)
+        {
+            enumeratorsSPtr_ = _new(DISKKEYINDEXKEYENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>>();
+            if (!enumeratorsSPtr_)
+            {
+                this->SetConstructorStatus(STATUS_INSUFFICIENT_RESOURCES);
+            }
+        }
+
+        template<typename TKey, typename TValue>
+        DiskKeyIndexKeyEnumerator<TKey, TValue>::~DiskKeyIndexKeyEnumerator()
+        {
+        }
+    }
+}
@@ -0,0 +1,183 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define DISKKEYSREADAHEADENUMERATOR_TAG 'arKD'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Synchronous enumerator over the asynchronous disk key enumerator, used by the key enumerators of a store that keeps
+        // its keys on disk. The keys are read one batch ahead of the reader, so at most two batches are in memory.
+        //
+        // MoveNext only waits when the reader gets to the end of a batch before the next one has been read. The read itself
+        // runs on the KTL threads and never waits for the reader.
+        //
+        template<typename TKey>
+        class DiskKeysReadAheadEnumerator : public IEnumerator<TKey>
+        {
+            K_FORCE_SHARED(DiskKeysReadAheadEnumerator)
+
+        public:
+            //
+            // The first batch is read before the enumerator is returned, so ranges that fit in one batch never wait.
+            //
+            static ktl::Awaitable<KSharedPtr<IEnumerator<TKey>>> CreateAsync(
+                __in IAsyncEnumerator<TKey> & source,
+                __in ULONG32 batchSize,
+                __in KAllocator & allocator)
+            {
+                SPtr output = _new(DISKKEYSREADAHEADENUMERATOR_TAG, allocator) DiskKeysReadAheadEnumerator(source, batchSize);
+                if (!output)
+                {
+                    throw ktl::Exception(STATUS_INSUFFICIENT_RESOURCES);
+                }
+
+                Diagnostics::Validate(output->Status());
+
+                co_await output->ReadBatchAsync(*output->currentBatchSPtr_);
+                output->StartReadAhead();
+
+                KSharedPtr<IEnumerator<TKey>> result = output.RawPtr();
+                co_return result;
+            }
+
+            TKey Current() override
+            {
+                KInvariant(index_ >= 0 && static_cast<ULONG>(index_) < currentBatchSPtr_->Count());
+                return (*currentBatchSPtr_)[index_];
+            }
+
+            bool MoveNext() override
+            {
+                index_++;
+                if (static_cast<ULONG>(index_) < currentBatchSPtr_->Count())
+                {
+                    return true;
+                }
+
+                if (!isReadAheadPending_)
+                {
+                    return false;
+                }
+
+                readAheadCompleted_.WaitUntilSet();
+                isReadAheadPending_ = false;
+
+                if (readAheadExceptionSPtr_ != nullptr)
+                {
+                    //clang compiler error, needs to assign before throw.
+                    auto ex = readAheadExceptionSPtr_->Info;
+                    throw ex;
+                }
+
+                KSharedPtr<KSharedArray<TKey>> readBatchSPtr = Ktl::Move(nextBatchSPtr_);
+                nextBatchSPtr_ = Ktl::Move(currentBatchSPtr_);
+                currentBatchSPtr_ = Ktl::Move(readBatchSPtr);
+                index_ = 0;
+
+                StartReadAhead();
+
+                return currentBatchSPtr_->Count() > 0;
+            }
+
+        private:
+            ktl::Awaitable<void> ReadBatchAsync(__in KSharedArray<TKey> & batch)
+            {
+                batch.Clear();
+
+                while (batch.Count() < batchSize_)
+                {
+                    if (!co_await sourceSPtr_->MoveNextAsync(ktl::CancellationToken::None))
+                    {
+                        isSourceDone_ = true;
+                        break;
+                    }
+
+                    NTSTATUS status = batch.Append(sourceSPtr_->GetCurrent());
+                    Diagnostics::Validate(status);
+                }
+            }
+
+            void StartReadAhead()
+            {
+                if (isSourceDone_)
+                {
+                    return;
+                }
+
+                readAheadCompleted_.ResetEvent();
+                isReadAheadPending_ = true;
+
+                ktl::Task task = ReadAheadTask();
+                KInvariant(task.IsTaskStarted());
+            }
+
+            ktl::Task ReadAheadTask()
+            {
+                // Keeps the enumerator, and so the source, alive until the read completes
+                SPtr thisSPtr = this;
+
+                try
+                {
+                    co_await ReadBatchAsync(*nextBatchSPtr_);
+                }
+                catch (ktl::Exception const & e)
+                {
+                    readAheadExceptionSPtr_ = SharedException::Create(e, this->GetThisAllocator());
+                    isSourceDone_ = true;
+                }
+
+                readAheadCompleted_.SetEvent();
+            }
+
+            DiskKeysReadAheadEnumerator(
+                __in IAsyncEnumerator<TKey> & source,
+                __in ULONG32 batchSize);
+
+            KSharedPtr<IAsyncEnumerator<TKey>> sourceSPtr_;
+            ULONG32 batchSize_;
+
+            KSharedPtr<KSharedArray<TKey>> currentBatchSPtr_;
+            KSharedPtr<KSharedArray<TKey>> nextBatchSPtr_;
+            LONG32 index_ = -1;
+
+            KEvent readAheadCompleted_;
+            bool isReadAheadPending_ = false;
+            bool isSourceDone_ = false;
+            SharedException::CSPtr readAheadExceptionSPtr_;
+        };
+
+        template<typename TKey>
+        DiskKeysReadAheadEnumerator<TKey>::DiskKeysReadAheadEnumerator(
+            __in IAsyncEnumerator<TKey> & source,
+            __in ULONG32 batchSize)
+            : sourceSPtr_(&source)
+            , batchSize_(batchSize)
+            , currentBatchSPtr_(nullptr)
+            , nextBatchSPtr_(nullptr)
+            , readAheadCompleted_(TRUE, TRUE)
+            , readAheadExceptionSPtr_(nullptr)
+        {
+            currentBatchSPtr_ = _new(DISKKEYSREADAHEADENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<TKey>();
+            nextBatchSPtr_ = _new(DISKKEYSREADAHEADENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<TKey>();
+            if (!currentBatchSPtr_ || !nextBatchSPtr_)
+            {
+                this->SetConstructorStatus(STATUS_INSUFFICIENT_RESOURCES);
+            }
+        }
+
+        template<typename TKey>
+        DiskKeysReadAheadEnumerator<TKey>::~DiskKeysReadAheadEnumerator()
+        {
+            // Releases the references on the checkpoint files if the enumeration was not completed. No read is pending
+            // since the read ahead task holds a reference on the enumerator.
+            sourceSPtr_->Dispose();
+        }
+    }
+}
@@ -159,10 +159,11 @@ bool FileMetadata::TryAddReference()
     // Spin instead of locking since contention is low.
     do
     {
-        //todo: implement Volatile.
-        //refCount = Volatile.Read(ref this.referenceCount);
+        refCount = referenceCount_;
         if (refCount == 0)
+        {
             return false;
+        }
     } while (InterlockedCompareExchange64(&referenceCount_, refCount + 1, refCount) != refCount);
 
     return true;
@@ -61,6 +61,9 @@ namespace Data
             __declspec(property(get = get_EnableSweep)) bool EnableSweep;
             virtual bool get_EnableSweep() const = 0;
 
+            __declspec(property(get = get_EnableDiskResidentKeys)) bool EnableDiskResidentKeys;
+            virtual bool get_EnableDiskResidentKeys() const = 0;
+
             __declspec(property(get = get_MergeHelper)) MergeHelper::SPtr MergeHelperSPtr;
             virtual MergeHelper::SPtr get_MergeHelper() const = 0;
 
@@ -0,0 +1,162 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define KEYBLOCKCACHE_TAG 'cbYK'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Direct mapped cache of decoded key blocks, shared by all the checkpoint files of a store.
+        // A block is identified by its file id and its index in the file.
+        //
+        template<typename TKey, typename TValue>
+        class KeyBlockCache : public KObject<KeyBlockCache<TKey, TValue>>, public KShared<KeyBlockCache<TKey, TValue>>
+        {
+            K_FORCE_SHARED(KeyBlockCache)
+
+        public:
+            typedef KSharedArray<KSharedPtr<KeyData<TKey, TValue>>> Block;
+
+            static NTSTATUS Create(
+                __in ULONG32 capacity,
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                NTSTATUS status;
+                SPtr output = _new(KEYBLOCKCACHE_TAG, allocator) KeyBlockCache(capacity);
+
+                if (!output)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                status = output->Status();
+                if (!NT_SUCCESS(status))
+                {
+                    return status;
+                }
+
+                result = Ktl::Move(output);
+                return STATUS_SUCCESS;
+            }
+
+            __declspec(property(get = get_HitCount)) LONG64 HitCount;
+            LONG64 get_HitCount() const
+            {
+                return hitCount_;
+            }
+
+            __declspec(property(get = get_MissCount)) LONG64 MissCount;
+            LONG64 get_MissCount() const
+            {
+                return missCount_;
+            }
+
+            KSharedPtr<Block> TryGet(
+                __in ULONG32 fileId,
+                __in ULONG32 blockIndex)
+            {
+                ULONG slot = GetSlot(fileId, blockIndex);
+                KSharedPtr<Block> result = nullptr;
+
+                K_LOCK_BLOCK(lock_)
+                {
+                    Entry & entry = entries_[slot];
+                    if (entry.BlockSPtr != nullptr && entry.FileId == fileId && entry.BlockIndex == blockIndex)
+                    {
+                        result = entry.BlockSPtr;
+                    }
+                }
+
+                InterlockedIncrement64(result != nullptr ? &hitCount_ : &missCount_);
+                return result;
+            }
+
+            void Put(
+                __in ULONG32 fileId,
+                __in ULONG32 blockIndex,
+                __in Block & block)
+            {
+                ULONG slot = GetSlot(fileId, blockIndex);
+                KSharedPtr<Block> evictedBlockSPtr = nullptr;
+
+                K_LOCK_BLOCK(lock_)
+                {
+                    Entry & entry = entries_[slot];
+
+                    // Released outside of the lock
+                    evictedBlockSPtr = Ktl::Move(entry.BlockSPtr);
+
+                    entry.FileId = fileId;
+                    entry.BlockIndex = blockIndex;
+                    entry.BlockSPtr = &block;
+                }
+            }
+
+        private:
+            struct Entry
+            {
+                Entry()
+                    : FileId(0)
+                    , BlockIndex(0)
+                    , BlockSPtr(nullptr)
+                {
+                }
+
+                ULONG32 FileId;
+                ULONG32 BlockIndex;
+                KSharedPtr<Block> BlockSPtr;
+            };
+
+            ULONG GetSlot(
+                __in ULONG32 fileId,
+                __in ULONG32 blockIndex) const
+            {
+                ULONG64 hash = (static_cast<ULONG64>(fileId) * 0x9E3779B97F4A7C15ULL) ^ blockIndex;
+                return static_cast<ULONG>(hash % entries_.Count());
+            }
+
+            KeyBlockCache(__in ULONG32 capacity);
+
+            KSpinLock lock_;
+            KArray<Entry> entries_;
+            volatile LONG64 hitCount_;
+            volatile LONG64 missCount_;
+        };
+
+        template<typename TKey, typename TValue>
+        KeyBlockCache<TKey, TValue>::KeyBlockCache(__in ULONG32 capacity)
+            : entries_(this->GetThisAllocator(), capacity > 0 ? capacity : 1)
+            , hitCount_(0)
+            , missCount_(0)
+        {
+            NTSTATUS status = entries_.Status();
+            if (!NT_SUCCESS(status))
+            {
+                this->SetConstructorStatus(status);
+                return;
+            }
+
+            for (ULONG32 i = 0; i < (capacity > 0 ? capacity : 1); i++)
+            {
+                status = entries_.Append(Entry());
+                if (!NT_SUCCESS(status))
+                {
+                    this->SetConstructorStatus(status);
+                    return;
+                }
+            }
+        }
+
+        template<typename TKey, typename TValue>
+        KeyBlockCache<TKey, TValue>::~KeyBlockCache()
+        {
+        }
+    }
+}
@@ -176,11 +176,26 @@ namespace Data
             KSharedPtr<KeyData<TKey, TValue>> ReadKey(
                 __in BinaryReader& memoryBuffer,
                 __in Data::StateManager::IStateSerializer<TKey>& keySerializer)
+            {
+                ULONG32 keyPosition = 0;
+                ULONG32 keySize = 0;
+                return ReadKey<TKey, TValue>(memoryBuffer, keySerializer, keyPosition, keySize);
+            }
+
+            //
+            // Same as above, also returns where the serialized key is in the buffer.
+            //
+            template<typename TKey, typename TValue>
+            KSharedPtr<KeyData<TKey, TValue>> ReadKey(
+                __in BinaryReader& memoryBuffer,
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __out ULONG32 & keyPosition,
+                __out ULONG32 & keySize)
             {
                 ByteAlignedReaderWriterHelper::ThrowIfNotAligned(memoryBuffer.Position);
 
                 // This mirrors WriteKey().
-                ULONG32 keySize = 0;
+                keySize = 0;
                 memoryBuffer.Read(keySize);
                 byte kindByte = 0;
                 memoryBuffer.Read(kindByte);
@@ -209,7 +224,7 @@ namespace Data
                 }
 
                 // Protection in case the user's key serializer doesn't leave the stream at the correct end point.
-                ULONG32 keyPosition = memoryBuffer.Position;
+                keyPosition = memoryBuffer.Position;
                 TKey key = keySerializer.Read(memoryBuffer);
                 memoryBuffer.Position = keyPosition + keySize;
 
@@ -256,6 +271,58 @@ namespace Data
                 return keydata;
             }
 
+            //
+            // Reads all the keys of a key block. The reader must be positioned right after the block's KeyChunkMetadata,
+            // and buffer must be the buffer the reader reads from. The checksum of the block is verified first.
+            // If keyHashes is not null, the CRC64 of each serialized key is appended to it.
+            //
+            template<typename TKey, typename TValue>
+            KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> ReadBlock(
+                __in KBuffer const & buffer,
+                __in BinaryReader& reader,
+                __in ULONG32 blockSize,
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __inout_opt KArray<ULONG64> * keyHashes)
+            {
+                ULONG32 blockStartPosition = reader.Position;
+                ULONG32 alignedBlockStartPosition = blockStartPosition - KeyChunkMetadata::Size;
+                ULONG32 keysEndPosition = alignedBlockStartPosition + blockSize - sizeof(ULONG64);
+
+                reader.Position = keysEndPosition;
+                ULONG64 expectedChecksum;
+                reader.Read(expectedChecksum);
+                reader.Position = blockStartPosition;
+
+                // Verify checksum.
+                ULONG64 actualChecksum = CRC64::ToCRC64(buffer, alignedBlockStartPosition, blockSize - sizeof(ULONG64));
+                if (actualChecksum != expectedChecksum)
+                {
+                    //todo: throw invalid data exception.
+                    throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
+                }
+
+                KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysDataSPtr = _new(KEYDATA_TAG, GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
+                STORE_ASSERT(keysDataSPtr != nullptr, "keysDataSPtr should not be null");
+
+                while (reader.Position < keysEndPosition)
+                {
+                    ULONG32 keyPosition = 0;
+                    ULONG32 keySize = 0;
+                    KSharedPtr<KeyData<TKey, TValue>> keyDataSPtr = ReadKey<TKey, TValue>(reader, keySerializer, keyPosition, keySize);
+                    NTSTATUS status = keysDataSPtr->Append(keyDataSPtr);
+                    Diagnostics::Validate(status);
+
+                    if (keyHashes != nullptr)
+                    {
+                        status = keyHashes->Append(CRC64::ToCRC64(buffer, keyPosition, keySize));
+                        Diagnostics::Validate(status);
+                    }
+                }
+
+                STORE_ASSERT(reader.Position == keysEndPosition, "reader.Position={1} != expected position={2}", reader.Position, keysEndPosition);
+                return keysDataSPtr;
+            }
+
             ktl::Awaitable<void> FlushMemoryBufferAsync(
                 __in ktl::io::KFileStream& fileStream,
                 __in SharedBinaryWriter& writer);
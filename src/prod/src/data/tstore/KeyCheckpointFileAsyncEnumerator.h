@@ -11,6 +11,9 @@ namespace Data
 {
     namespace TStore
     {
+        template<typename TKey, typename TValue>
+        class KeyCheckpointFileIndex;
+
         template<typename TKey, typename TValue>
         class KeyCheckpointFileAsyncEnumerator : public KObject<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>,
             public KShared<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>,
@@ -67,6 +70,19 @@ namespace Data
                 keyComparerSPtr_ = &value;
             }
 
+            //
+            // If set, every block read by the enumerator is added to the index.
+            //
+            __declspec(property(get = get_KeyIndex, put = set_KeyIndex)) KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> KeyIndexSPtr;
+            KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> get_KeyIndex() const
+            {
+                return keyIndexSPtr_;
+            }
+            void set_KeyIndex(__in KeyCheckpointFileIndex<TKey, TValue>& value)
+            {
+                keyIndexSPtr_ = &value;
+            }
+
             ktl::Awaitable<void> CloseAsync()
             {
                 if (fileStreamSPtr_ != nullptr && fileStreamSPtr_->IsOpen())
@@ -168,7 +184,7 @@ namespace Data
                     }
                     else
                     {
-                        STORE_ASSERT(keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key Counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
+                        AssertAllKeysRead();
                         co_return false;
                     }
                 }
@@ -193,7 +209,7 @@ namespace Data
                         }
                         else
                         {
-                            STORE_ASSERT(keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
+                            AssertAllKeysRead();
                             co_return false;
                         }
                     }
@@ -202,6 +218,17 @@ namespace Data
 
         private:
 
+            void AssertAllKeysRead()
+            {
+                // Enumerations that start in the middle of the file only see part of the keys.
+                if (startOffset_ != keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->Offset)
+                {
+                    return;
+                }
+
+                STORE_ASSERT(keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
+            }
+
             ktl::Awaitable<bool> ReadChunkAsync()
             {
                 itemsBufferSPtr_->Clear();
@@ -220,7 +247,8 @@ namespace Data
 
                 ULONG startPosition = 0;
                 ULONG bytesRead = 0;
-    
+                ULONG64 chunkFileOffset = static_cast<ULONG64>(fileStreamSPtr_->Position);
+
                 status = co_await fileStreamSPtr_->ReadAsync(*memoryStreamSPtr_, bytesRead, startPosition, chunkSize);
                 STORE_ASSERT(NT_SUCCESS(status), "Failed to read from filestream. status={1}", status);
                 STORE_ASSERT(bytesRead == chunkSize, "bytesRead={1} != chunkSize={2}", bytesRead, chunkSize);
@@ -259,7 +287,17 @@ namespace Data
                         brSPtr->Position = currentPosition;
                     }
 
-                    KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysFromBlockSPtr = ReadBlock(currentBlockSize, *brSPtr);
+                    KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysFromBlockSPtr = nullptr;
+                    if (keyIndexSPtr_ == nullptr)
+                    {
+                        keysFromBlockSPtr = keyCheckpointFileSPtr_->ReadBlock<TKey, TValue>(*memoryStreamSPtr_, *brSPtr, currentBlockSize, *keySerializerSPtr_, nullptr);
+                    }
+                    else
+                    {
+                        KArray<ULONG64> keyHashes(this->GetThisAllocator());
+                        keysFromBlockSPtr = keyCheckpointFileSPtr_->ReadBlock<TKey, TValue>(*memoryStreamSPtr_, *brSPtr, currentBlockSize, *keySerializerSPtr_, &keyHashes);
+                        keyIndexSPtr_->AddBlock(chunkFileOffset + alignedStartBlockOffset, alignedBlockSize, *keysFromBlockSPtr, keyHashes);
+                    }
 
                     for (ULONG i = 0; i < keysFromBlockSPtr->Count(); i++)
                     {
@@ -282,39 +320,6 @@ namespace Data
                 co_return true;
             }
 
-            KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> ReadBlock(
-                __in ULONG32 blockSize,
-                __in BinaryReader& reader)
-            {
-                ULONG32 blockStartPosition = reader.Position;
-                ULONG32 alignedBlockStartPosition = blockStartPosition - KeyChunkMetadata::Size;
-
-                reader.Position = alignedBlockStartPosition + blockSize - sizeof(ULONG64);
-                ULONG64 expectedChecksum;
-                reader.Read(expectedChecksum);
-                reader.Position = blockStartPosition;
-
-                // Verify checksum.
-                ULONG64 actualChecksum = CRC64::ToCRC64(*memoryStreamSPtr_, alignedBlockStartPosition, blockSize - sizeof(ULONG64));
-                if (actualChecksum != expectedChecksum)
-                {
-                    //todo: throw invalid data exception.
-                    throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
-                }
-
-                KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysDataSPtr = _new(KEYCHECKPOINTASYNCENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
-                STORE_ASSERT(keysDataSPtr != nullptr, "keysDataSPtr should not be null");
-
-                while(reader.Position < (alignedBlockStartPosition + blockSize - sizeof(ULONG64)))
-                {
-                    KSharedPtr<KeyData<TKey, TValue>> keyDataSPtr = keyCheckpointFileSPtr_->ReadKey<TKey, TValue>(reader, *keySerializerSPtr_);
-                    keysDataSPtr->Append(keyDataSPtr);
-                }
-
-                STORE_ASSERT(reader.Position == (alignedBlockStartPosition + blockSize - sizeof(ULONG64)), "reader.Position={1} != expected position={2}", reader.Position, alignedBlockStartPosition + blockSize - sizeof(ULONG64));
-                return keysDataSPtr;
-            }
-
             ULONG64 GetChunkSize()
             {
                 // Get chunk size of 64k if available, else remaining size.
@@ -371,6 +376,7 @@ namespace Data
             KSharedPtr<ktl::io::KFileStream> fileStreamSPtr_;
             KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
             KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> keyIndexSPtr_;
 
             StoreTraceComponent::SPtr traceComponent_;
 
@@ -394,6 +400,7 @@ namespace Data
             itemsBufferSPtr_(nullptr),
             fileStreamSPtr_(nullptr),
             keyComparerSPtr_(nullptr),
+            keyIndexSPtr_(nullptr),
             memoryStreamSPtr_(nullptr)
         {
         }
@@ -0,0 +1,349 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define KEYCHECKPOINTFILEINDEX_TAG 'ixFK'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Sparse index over the key blocks of one key checkpoint file: the first key, offset and size of every block,
+        // and a bloom filter over all the keys of the file. Point lookups read at most one block from disk.
+        //
+        // The index is populated once, by a KeyCheckpointFileAsyncEnumerator that has the index set, and is read only afterwards.
+        //
+        template<typename TKey, typename TValue>
+        class KeyCheckpointFileIndex : public KObject<KeyCheckpointFileIndex<TKey, TValue>>, public KShared<KeyCheckpointFileIndex<TKey, TValue>>
+        {
+            K_FORCE_SHARED(KeyCheckpointFileIndex)
+
+        public:
+            typedef KSharedArray<KSharedPtr<KeyData<TKey, TValue>>> Block;
+
+            static NTSTATUS Create(
+                __in FileMetadata & fileMetadata,
+                __in IComparer<TKey> & keyComparer,
+                __in StoreTraceComponent & traceComponent,
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                NTSTATUS status;
+                SPtr output = _new(KEYCHECKPOINTFILEINDEX_TAG, allocator) KeyCheckpointFileIndex(fileMetadata, keyComparer, traceComponent);
+
+                if (!output)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                status = output->Status();
+                if (!NT_SUCCESS(status))
+                {
+                    return status;
+                }
+
+                result = Ktl::Move(output);
+                return STATUS_SUCCESS;
+            }
+
+            __declspec(property(get = get_FileMetadata)) FileMetadata::SPtr FileMetadataSPtr;
+            FileMetadata::SPtr get_FileMetadata() const
+            {
+                return fileMetadataSPtr_;
+            }
+
+            __declspec(property(get = get_FileId)) ULONG32 FileId;
+            ULONG32 get_FileId() const
+            {
+                return fileMetadataSPtr_->FileId;
+            }
+
+            __declspec(property(get = get_BlockCount)) ULONG32 BlockCount;
+            ULONG32 get_BlockCount() const
+            {
+                return blockOffsets_.Count();
+            }
+
+            __declspec(property(get = get_MemorySize)) LONG64 MemorySize;
+            LONG64 get_MemorySize() const
+            {
+                LONG64 perBlockSize = sizeof(TKey) + sizeof(ULONG64) + sizeof(ULONG32);
+                return static_cast<LONG64>(bloomFilterSPtr_->SizeInBytes) + perBlockSize * blockOffsets_.Count();
+            }
+
+            //
+            // Called by the enumerator for every block, in file order.
+            //
+            void AddBlock(
+                __in ULONG64 offset,
+                __in ULONG32 size,
+                __in Block const & keys,
+                __in KArray<ULONG64> const & keyHashes)
+            {
+                STORE_ASSERT(keys.Count() > 0, "key block at offset {1} is empty", offset);
+                STORE_ASSERT(keys.Count() == keyHashes.Count(), "keys count {1} != key hashes count {2}", keys.Count(), keyHashes.Count());
+
+                NTSTATUS status = firstKeys_.Append(keys[0]->Key);
+                Diagnostics::Validate(status);
+
+                status = blockOffsets_.Append(offset);
+                Diagnostics::Validate(status);
+
+                status = blockSizes_.Append(size);
+                Diagnostics::Validate(status);
+
+                for (ULONG32 i = 0; i < keyHashes.Count(); i++)
+                {
+                    bloomFilterSPtr_->Add(keyHashes[i]);
+                }
+            }
+
+            //
+            // Populates the index by reading all the key blocks of the file once.
+            //
+            ktl::Awaitable<void> BuildAsync(
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
+                STORE_ASSERT(blockOffsets_.Count() == 0, "index of file {1} is already built", FileId);
+
+                KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr =
+                    fileMetadataSPtr_->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(keySerializer);
+                enumeratorSPtr->KeyIndexSPtr = *this;
+
+                SharedException::CSPtr exception = nullptr;
+
+                try
+                {
+                    while (co_await enumeratorSPtr->MoveNextAsync(cancellationToken))
+                    {
+                    }
+                }
+                catch (ktl::Exception const & e)
+                {
+                    exception = SharedException::Create(e, this->GetThisAllocator());
+                }
+
+                co_await enumeratorSPtr->CloseAsync();
+
+                if (exception != nullptr)
+                {
+                    //clang compiler error, needs to assign before throw.
+                    auto ex = exception->Info;
+                    throw ex;
+                }
+            }
+
+            bool MayContain(__in ULONG64 keyHash) const
+            {
+                return bloomFilterSPtr_->MayContain(keyHash);
+            }
+
+            //
+            // Returns the index of the only block that can contain the key, -1 if the key is smaller than all the keys of the file.
+            //
+            LONG32 FindBlock(__in TKey const & key) const
+            {
+                LONG32 low = 0;
+                LONG32 high = static_cast<LONG32>(firstKeys_.Count()) - 1;
+                LONG32 result = -1;
+
+                while (low <= high)
+                {
+                    LONG32 mid = low + (high - low) / 2;
+                    if (keyComparerSPtr_->Compare(firstKeys_[mid], key) <= 0)
+                    {
+                        result = mid;
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid - 1;
+                    }
+                }
+
+                return result;
+            }
+
+            ULONG64 GetBlockOffset(__in ULONG32 blockIndex) const
+            {
+                return blockOffsets_[blockIndex];
+            }
+
+            //
+            // Returns the keys of the given block, from the cache if possible.
+            // The caller must hold a reference on the file metadata.
+            //
+            ktl::Awaitable<KSharedPtr<Block>> GetBlockAsync(
+                __in ULONG32 blockIndex,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in KeyBlockCache<TKey, TValue> & blockCache)
+            {
+                KSharedPtr<Block> blockSPtr = blockCache.TryGet(FileId, blockIndex);
+                if (blockSPtr != nullptr)
+                {
+                    co_return blockSPtr;
+                }
+
+                KSharedPtr<KeyCheckpointFile> keyCheckpointFileSPtr = fileMetadataSPtr_->CheckpointFileSPtr->KeyCheckpointFileSPtr;
+                ktl::io::KFileStream::SPtr fileStreamSPtr = nullptr;
+                SharedException::CSPtr exception = nullptr;
+
+                try
+                {
+                    fileStreamSPtr = co_await keyCheckpointFileSPtr->StreamPoolSPtr->AcquireStreamAsync();
+
+                    ULONG size = blockSizes_[blockIndex];
+                    ULONG bytesRead = 0;
+
+                    KBuffer::SPtr bufferSPtr = nullptr;
+                    NTSTATUS status = KBuffer::Create(size, bufferSPtr, this->GetThisAllocator());
+                    Diagnostics::Validate(status);
+
+                    fileStreamSPtr->SetPosition(blockOffsets_[blockIndex]);
+                    status = co_await fileStreamSPtr->ReadAsync(*bufferSPtr, bytesRead, 0, size);
+                    STORE_ASSERT(NT_SUCCESS(status), "Failed to read from file. status={1}", status);
+                    STORE_ASSERT(bytesRead == size, "Did not read correct number of bytes. bytesRead={1} expected={2}", bytesRead, size);
+
+                    co_await keyCheckpointFileSPtr->StreamPoolSPtr->ReleaseStreamAsync(*fileStreamSPtr);
+                    fileStreamSPtr = nullptr;
+
+                    BinaryReader reader(*bufferSPtr, this->GetThisAllocator());
+                    KeyChunkMetadata blockMetadata = KeyChunkMetadata::Read(reader);
+                    blockSPtr = keyCheckpointFileSPtr->ReadBlock<TKey, TValue>(*bufferSPtr, reader, blockMetadata.BlockSize, keySerializer, nullptr);
+                }
+                catch (ktl::Exception const & e)
+                {
+                    exception = SharedException::Create(e, this->GetThisAllocator());
+                }
+
+                if (fileStreamSPtr != nullptr && fileStreamSPtr->IsOpen())
+                {
+                    co_await keyCheckpointFileSPtr->StreamPoolSPtr->ReleaseStreamAsync(*fileStreamSPtr);
+                    fileStreamSPtr = nullptr;
+                }
+
+                if (exception != nullptr)
+                {
+                    //clang compiler error, needs to assign before throw.
+                    auto ex = exception->Info;
+                    throw ex;
+                }
+
+                blockCache.Put(FileId, blockIndex, *blockSPtr);
+                co_return blockSPtr;
+            }
+
+            //
+            // Returns the entry of the key in this file, null if the file does not contain the key.
+            // The caller must hold a reference on the file metadata.
+            //
+            ktl::Awaitable<KSharedPtr<KeyData<TKey, TValue>>> ReadAsync(
+                __in TKey const & key,
+                __in ULONG64 keyHash,
+                __in Data::StateManager::IStateSerializer<TKey> & keySerializer,
+                __in KeyBlockCache<TKey, TValue> & blockCache)
+            {
+                if (!bloomFilterSPtr_->MayContain(keyHash))
+                {
+                    co_return nullptr;
+                }
+
+                LONG32 blockIndex = FindBlock(key);
+                if (blockIndex < 0)
+                {
+                    co_return nullptr;
+                }
+
+                KSharedPtr<Block> blockSPtr = co_await GetBlockAsync(static_cast<ULONG32>(blockIndex), keySerializer, blockCache);
+
+                LONG32 low = 0;
+                LONG32 high = static_cast<LONG32>(blockSPtr->Count()) - 1;
+                while (low <= high)
+                {
+                    LONG32 mid = low + (high - low) / 2;
+                    int compare = keyComparerSPtr_->Compare((*blockSPtr)[mid]->Key, key);
+                    if (compare == 0)
+                    {
+                        co_return (*blockSPtr)[mid];
+                    }
+
+                    if (compare < 0)
+                    {
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid - 1;
+                    }
+                }
+
+                co_return nullptr;
+            }
+
+        private:
+            KeyCheckpointFileIndex(
+                __in FileMetadata & fileMetadata,
+                __in IComparer<TKey> & keyComparer,
+                __in StoreTraceComponent & traceComponent);
+
+            FileMetadata::SPtr fileMetadataSPtr_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            BloomFilter::SPtr bloomFilterSPtr_;
+
+            KArray<TKey> firstKeys_;
+            KArray<ULONG64> blockOffsets_;
+            KArray<ULONG32> blockSizes_;
+
+            StoreTraceComponent::SPtr traceComponent_;
+        };
+
+        template<typename TKey, typename TValue>
+        KeyCheckpointFileIndex<TKey, TValue>::KeyCheckpointFileIndex(
+            __in FileMetadata & fileMetadata,
+            __in IComparer<TKey> & keyComparer,
+            __in StoreTraceComponent & traceComponent)
+            : fileMetadataSPtr_(&fileMetadata)
+            , keyComparerSPtr_(&keyComparer)
+            , bloomFilterSPtr_(nullptr)
+            , firstKeys_(this->GetThisAllocator())
+            , blockOffsets_(this->GetThisAllocator())
+            , blockSizes_(this->GetThisAllocator())
+            , traceComponent_(&traceComponent)
+        {
+            NTSTATUS status = BloomFilter::Create(
+                fileMetadata.CheckpointFileSPtr->KeyCount,
+                Constants::DiskKeyIndexBloomFilterBitsPerKey,
+                this->GetThisAllocator(),
+                bloomFilterSPtr_);
+            if (!NT_SUCCESS(status))
+            {
+                this->SetConstructorStatus(status);
+                return;
+            }
+
+            if (!NT_SUCCESS(firstKeys_.Status()))
+            {
+                this->SetConstructorStatus(firstKeys_.Status());
+                return;
+            }
+
+            if (!NT_SUCCESS(blockOffsets_.Status()))
+            {
+                this->SetConstructorStatus(blockOffsets_.Status());
+                return;
+            }
+
+            this->SetConstructorStatus(blockSizes_.Status());
+        }
+
+        template<typename TKey, typename TValue>
+        KeyCheckpointFileIndex<TKey, TValue>::~KeyCheckpointFileIndex()
+        {
+        }
+    }
+}
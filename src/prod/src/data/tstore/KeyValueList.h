@@ -93,6 +93,12 @@ namespace Data
                 return valueList_[index];
             }
 
+            TValue& GetValueReference(__in int index)
+            {
+                ThrowArgumentOutOfRangeIfNecessary(index);
+                return valueList_[index];
+            }
+
             void UpdateValue(__in int index, __in const TValue& value)
             {
                 ThrowArgumentOutOfRangeIfNecessary(index);
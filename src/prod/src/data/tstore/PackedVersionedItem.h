@@ -0,0 +1,235 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Entry of the consolidated state. Stored by value in the partition arrays of the consolidated state.
+        //
+        // Items whose value is in memory keep a reference to their VersionedItem, since readers and sweep need
+        // to share the value and its flags. Items whose value is only on disk are packed: only the metadata
+        // needed to load the value is kept, and a VersionedItem is created when a reader asks for it.
+        //
+        // Once created, the VersionedItem is published into the entry and never removed for the lifetime of the
+        // consolidated state, so concurrent readers can take a reference without a lock. Entries are only
+        // replaced or destroyed while the consolidated state is not shared (recovery, consolidation and merge).
+        //
+        template<typename TValue>
+        class PackedVersionedItem
+        {
+        public:
+            PackedVersionedItem()
+                : versionedItemPtr_(nullptr)
+                , versionSequenceNumber_(0)
+                , offset_(0)
+                , valueChecksum_(0)
+                , fileId_(0)
+                , valueSize_(-1)
+                , recordKind_(RecordKind::InsertedVersion)
+            {
+            }
+
+            explicit PackedVersionedItem(__in VersionedItem<TValue> & versionedItem)
+                : versionedItemPtr_(nullptr)
+                , versionSequenceNumber_(versionedItem.GetVersionSequenceNumber())
+                , offset_(versionedItem.GetOffset())
+                , valueChecksum_(versionedItem.GetValueChecksum())
+                , fileId_(versionedItem.GetFileId())
+                , valueSize_(versionedItem.GetValueSize())
+                , recordKind_(versionedItem.GetRecordKind())
+            {
+                // Items that have not been checkpointed yet cannot be loaded back from disk
+                if (versionedItem.IsInMemory() || fileId_ == 0)
+                {
+                    versionedItem.AddRef();
+                    versionedItemPtr_ = &versionedItem;
+                }
+            }
+
+            PackedVersionedItem(__in PackedVersionedItem const & other)
+                : versionedItemPtr_(other.AddRefVersionedItem())
+                , versionSequenceNumber_(other.versionSequenceNumber_)
+                , offset_(other.offset_)
+                , valueChecksum_(other.valueChecksum_)
+                , fileId_(other.fileId_)
+                , valueSize_(other.valueSize_)
+                , recordKind_(other.recordKind_)
+            {
+            }
+
+            PackedVersionedItem & operator=(__in PackedVersionedItem const & other)
+            {
+                if (this != &other)
+                {
+                    VersionedItem<TValue> * previousPtr = versionedItemPtr_;
+
+                    versionedItemPtr_ = other.AddRefVersionedItem();
+                    versionSequenceNumber_ = other.versionSequenceNumber_;
+                    offset_ = other.offset_;
+                    valueChecksum_ = other.valueChecksum_;
+                    fileId_ = other.fileId_;
+                    valueSize_ = other.valueSize_;
+                    recordKind_ = other.recordKind_;
+
+                    if (previousPtr != nullptr)
+                    {
+                        previousPtr->Release();
+                    }
+                }
+
+                return *this;
+            }
+
+            ~PackedVersionedItem()
+            {
+                if (versionedItemPtr_ != nullptr)
+                {
+                    versionedItemPtr_->Release();
+                    versionedItemPtr_ = nullptr;
+                }
+            }
+
+            bool IsPacked() const
+            {
+                return versionedItemPtr_ == nullptr;
+            }
+
+            LONG64 GetVersionSequenceNumber() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                return versionedItemPtr != nullptr ? versionedItemPtr->GetVersionSequenceNumber() : versionSequenceNumber_;
+            }
+
+            ULONG32 GetFileId() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                return versionedItemPtr != nullptr ? versionedItemPtr->GetFileId() : fileId_;
+            }
+
+            RecordKind GetRecordKind() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                return versionedItemPtr != nullptr ? versionedItemPtr->GetRecordKind() : recordKind_;
+            }
+
+            bool IsInMemory() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                return versionedItemPtr != nullptr && versionedItemPtr->IsInMemory();
+            }
+
+            LONG32 GetValueSize() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                return versionedItemPtr != nullptr ? versionedItemPtr->GetValueSize() : valueSize_;
+            }
+
+            //
+            // Returns the versioned item if one has been created for this entry, null otherwise.
+            //
+            KSharedPtr<VersionedItem<TValue>> TryGetVersionedItem() const
+            {
+                KSharedPtr<VersionedItem<TValue>> result = versionedItemPtr_;
+                return result;
+            }
+
+            //
+            // Returns the versioned item for this entry, creating and publishing it if the entry is packed.
+            // isPublished is true only for the caller whose item was published.
+            //
+            KSharedPtr<VersionedItem<TValue>> GetVersionedItem(
+                __in KAllocator & allocator,
+                __out bool & isPublished)
+            {
+                isPublished = false;
+
+                KSharedPtr<VersionedItem<TValue>> result = versionedItemPtr_;
+                if (result != nullptr)
+                {
+                    return result;
+                }
+
+                KSharedPtr<VersionedItem<TValue>> newVersionedItemSPtr = CreateVersionedItem(allocator);
+
+                // Reference owned by the entry
+                newVersionedItemSPtr->AddRef();
+
+                PVOID previousPtr = InterlockedCompareExchangePointer(
+                    reinterpret_cast<PVOID volatile *>(&versionedItemPtr_),
+                    newVersionedItemSPtr.RawPtr(),
+                    nullptr);
+
+                if (previousPtr != nullptr)
+                {
+                    // Another reader published first. Published items are never released while the entry is shared.
+                    newVersionedItemSPtr->Release();
+                    result = static_cast<VersionedItem<TValue> *>(previousPtr);
+                    return result;
+                }
+
+                isPublished = true;
+                return newVersionedItemSPtr;
+            }
+
+        private:
+            VersionedItem<TValue> * AddRefVersionedItem() const
+            {
+                VersionedItem<TValue> * versionedItemPtr = versionedItemPtr_;
+                if (versionedItemPtr != nullptr)
+                {
+                    versionedItemPtr->AddRef();
+                }
+
+                return versionedItemPtr;
+            }
+
+            KSharedPtr<VersionedItem<TValue>> CreateVersionedItem(__in KAllocator & allocator) const
+            {
+                KSharedPtr<VersionedItem<TValue>> result = nullptr;
+                NTSTATUS status;
+
+                switch (recordKind_)
+                {
+                case RecordKind::InsertedVersion:
+                {
+                    KSharedPtr<InsertedVersionedItem<TValue>> insertedVersionSPtr = nullptr;
+                    status = InsertedVersionedItem<TValue>::Create(allocator, insertedVersionSPtr);
+                    Diagnostics::Validate(status);
+                    insertedVersionSPtr->InitializeOnRecovery(versionSequenceNumber_, fileId_, offset_, valueSize_, valueChecksum_);
+                    result = insertedVersionSPtr.RawPtr();
+                    break;
+                }
+                case RecordKind::UpdatedVersion:
+                {
+                    KSharedPtr<UpdatedVersionedItem<TValue>> updatedVersionSPtr = nullptr;
+                    status = UpdatedVersionedItem<TValue>::Create(allocator, updatedVersionSPtr);
+                    Diagnostics::Validate(status);
+                    updatedVersionSPtr->InitializeOnRecovery(versionSequenceNumber_, fileId_, offset_, valueSize_, valueChecksum_);
+                    result = updatedVersionSPtr.RawPtr();
+                    break;
+                }
+                default:
+                    // Deleted items are never kept in the consolidated state
+                    throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
+                }
+
+                return result;
+            }
+
+            VersionedItem<TValue> * volatile versionedItemPtr_;
+
+            LONG64 versionSequenceNumber_;
+            LONG64 offset_;
+            ULONG64 valueChecksum_;
+            ULONG32 fileId_;
+            LONG32 valueSize_;
+            RecordKind recordKind_;
+        };
+    }
+}
@@ -91,6 +91,11 @@ namespace Data
                 return keyValueListSPtr_->GetValue(index);
             }
 
+            TValue& GetValueReference(__in int index)
+            {
+                return keyValueListSPtr_->GetValueReference(index);
+            }
+
             void UpdateValue(__in int index, __in const TValue& value)
             {
                 return keyValueListSPtr_->UpdateValue(index, value);
@@ -62,6 +62,15 @@ namespace Data
                 return (*this->partitionListSPtr_)[index.PartitionIndex]->GetValue(index.ItemIndex);
             }
 
+            //
+            // Returns the stored value at an index found by TryGetIndex. Only for values that synchronize their own
+            // updates, since the list itself does not.
+            //
+            TValue& GetValueReference(__in Index index)
+            {
+                return (*this->partitionListSPtr_)[index.PartitionIndex]->GetValueReference(index.ItemIndex);
+            }
+
             void UpdateValue(__in TKey key, __in TValue value)
             {
                 Index index(-1, -1);
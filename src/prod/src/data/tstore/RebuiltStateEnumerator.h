@@ -50,6 +50,43 @@ namespace Data
                 return STATUS_SUCCESS;
             }
 
+            //
+            // Also enumerates, in order, the keys that are only in the checkpoint files.
+            //
+            static NTSTATUS Create(
+                __in bool isValueAReferenceType,
+                __in IEnumerator<TKey> & keyEnumerator,
+                __in IAsyncEnumerator<TKey> & diskKeyEnumerator,
+                __in IComparer<TKey> & keyComparer,
+                __in DifferentialStoreComponent<TKey, TValue> & differentialState,
+                __in ConsolidationManager<TKey, TValue> & consolidatedState,
+                __in MetadataTable & currentMetadataTable,
+                __in Data::StateManager::IStateSerializer<TValue> & valueSerializer,
+                __in StoreTraceComponent & traceComponent,
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                NTSTATUS status = Create(
+                    isValueAReferenceType,
+                    keyEnumerator,
+                    differentialState,
+                    consolidatedState,
+                    currentMetadataTable,
+                    valueSerializer,
+                    traceComponent,
+                    allocator,
+                    result);
+
+                if (!NT_SUCCESS(status))
+                {
+                    return status;
+                }
+
+                result->diskKeyEnumeratorSPtr_ = &diskKeyEnumerator;
+                result->keyComparerSPtr_ = &keyComparer;
+                return STATUS_SUCCESS;
+            }
+
             KeyValuePair<TKey, KeyValuePair<LONG64, TValue>> GetCurrent() override
             {
                 if (isInvalidated_)
@@ -67,15 +104,18 @@ namespace Data
                     throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
                 }
 
-                while (keyEnumeratorSPtr_->MoveNext())
+                TKey currentKey;
+                while (co_await MoveNextKeyAsync(cancellationToken, currentKey))
                 {
-                    TKey currentKey = keyEnumeratorSPtr_->Current();
-
                     KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = differentialStateSPtr_->Read(currentKey);
-                    if (versionedItemSPtr == nullptr)
+                    if (versionedItemSPtr == nullptr && diskKeyEnumeratorSPtr_ == nullptr)
                     {
                         versionedItemSPtr = consolidatedStateSPtr_->Read(currentKey);
                     }
+                    else if (versionedItemSPtr == nullptr)
+                    {
+                        versionedItemSPtr = co_await consolidatedStateSPtr_->ReadAsync(currentKey);
+                    }
 
                     if (versionedItemSPtr->GetRecordKind() == RecordKind::DeletedVersion)
                     {
@@ -101,16 +141,75 @@ namespace Data
 
             void Dispose() override
             {
+                if (diskKeyEnumeratorSPtr_ != nullptr)
+                {
+                    diskKeyEnumeratorSPtr_->Dispose();
+                }
             }
 
             void InvalidateEnumerator()
             {
                 STORE_ASSERT(isInvalidated_ == false, "Must only be invalidated once");
                 isInvalidated_ = true;
+
+                // Releases the checkpoint files referenced by the disk key enumerator
+                Dispose();
             }
 
 
         private:
+            ktl::Awaitable<bool> MoveNextKeyAsync(
+                __in ktl::CancellationToken const & cancellationToken,
+                __out TKey & key)
+            {
+                if (diskKeyEnumeratorSPtr_ == nullptr)
+                {
+                    if (!keyEnumeratorSPtr_->MoveNext())
+                    {
+                        co_return false;
+                    }
+
+                    key = keyEnumeratorSPtr_->Current();
+                    co_return true;
+                }
+
+                if (!isStarted_)
+                {
+                    isStarted_ = true;
+                    hasMemoryKey_ = keyEnumeratorSPtr_->MoveNext();
+                    hasDiskKey_ = co_await diskKeyEnumeratorSPtr_->MoveNextAsync(cancellationToken);
+                }
+
+                if (!hasMemoryKey_ && !hasDiskKey_)
+                {
+                    co_return false;
+                }
+
+                if (!hasDiskKey_ || (hasMemoryKey_ && keyComparerSPtr_->Compare(keyEnumeratorSPtr_->Current(), diskKeyEnumeratorSPtr_->GetCurrent()) <= 0))
+                {
+                    key = keyEnumeratorSPtr_->Current();
+                    hasMemoryKey_ = keyEnumeratorSPtr_->MoveNext();
+                }
+                else
+                {
+                    key = diskKeyEnumeratorSPtr_->GetCurrent();
+                    hasDiskKey_ = co_await diskKeyEnumeratorSPtr_->MoveNextAsync(cancellationToken);
+                }
+
+                // The same key can be both in memory and on disk
+                while (hasDiskKey_ && keyComparerSPtr_->Compare(key, diskKeyEnumeratorSPtr_->GetCurrent()) == 0)
+                {
+                    hasDiskKey_ = co_await diskKeyEnumeratorSPtr_->MoveNextAsync(cancellationToken);
+                }
+
+                while (hasMemoryKey_ && keyComparerSPtr_->Compare(key, keyEnumeratorSPtr_->Current()) == 0)
+                {
+                    hasMemoryKey_ = keyEnumeratorSPtr_->MoveNext();
+                }
+
+                co_return true;
+            }
+
             RebuiltStateAsyncEnumerator(
                 __in bool isValueAReferenceType,
                 __in IEnumerator<TKey> & keyEnumerator,
@@ -130,6 +229,13 @@ namespace Data
             KeyValuePair<TKey, KeyValuePair<LONG64, TValue>> currentItem_;
             bool isInvalidated_;
 
+            // Set when the consolidated keys are kept on disk
+            KSharedPtr<IAsyncEnumerator<TKey>> diskKeyEnumeratorSPtr_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            bool isStarted_ = false;
+            bool hasMemoryKey_ = false;
+            bool hasDiskKey_ = false;
+
             StoreTraceComponent::SPtr traceComponent_;
         };
 
@@ -149,6 +255,8 @@ namespace Data
             currentMetadataTableSPtr_(&currentMetadataTable),
             valueSerializerSPtr_(&valueSerializer),
             isInvalidated_(false),
+            diskKeyEnumeratorSPtr_(nullptr),
+            keyComparerSPtr_(nullptr),
             traceComponent_(&traceComponent)
         {
             currentItem_ = KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>();
@@ -62,6 +62,26 @@ namespace Data
                return logicalCheckpointFileTimeStamp_;
             }
 
+            //
+            // If set, the recovered keys are not kept: the files are added to the index as they are read, and only the count of keys
+            // whose latest version is not a delete is kept.
+            //
+            __declspec(property(get = get_DiskKeyIndex, put = set_DiskKeyIndex)) KSharedPtr<DiskKeyIndex<TKey, TValue>> DiskKeyIndexSPtr;
+            KSharedPtr<DiskKeyIndex<TKey, TValue>> get_DiskKeyIndex() const
+            {
+                return diskKeyIndexSPtr_;
+            }
+            void set_DiskKeyIndex(__in DiskKeyIndex<TKey, TValue> & value)
+            {
+                diskKeyIndexSPtr_ = &value;
+            }
+
+            __declspec(property(get = get_RecoveredKeyCount)) LONG64 RecoveredKeyCount;
+            LONG64 get_RecoveredKeyCount() const
+            {
+                return recoveredKeyCount_;
+            }
+
             KSharedPtr<RecoveryStoreEnumerator<TKey, TValue>> GetEnumerable()
             {
                 KSharedPtr<RecoveryStoreEnumerator<TKey, TValue>> enumeratorSPtr;
@@ -111,7 +131,19 @@ namespace Data
 
                        CheckpointFile::SPtr checkpointFileSPtr = co_await CheckpointFile::OpenAsync(*checkpointFileName, *traceComponent_, this->GetThisAllocator(), isValueReferenceType_);
                        fileMetadataSPtr->CheckpointFileSPtr = *checkpointFileSPtr;
-                       keyCheckpointFileListSPtr->Append(fileMetadataSPtr->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(*keySerializerSPtr_));
+                       KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> keyEnumeratorSPtr = fileMetadataSPtr->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(*keySerializerSPtr_);
+
+                       if (diskKeyIndexSPtr_ != nullptr)
+                       {
+                           KSharedPtr<KeyCheckpointFileIndex<TKey, TValue>> fileIndexSPtr = nullptr;
+                           status = KeyCheckpointFileIndex<TKey, TValue>::Create(*fileMetadataSPtr, *comparerSPtr_, *traceComponent_, this->GetThisAllocator(), fileIndexSPtr);
+                           Diagnostics::Validate(status);
+
+                           keyEnumeratorSPtr->KeyIndexSPtr = *fileIndexSPtr;
+                           diskKeyIndexSPtr_->Add(*fileIndexSPtr);
+                       }
+
+                       keyCheckpointFileListSPtr->Append(keyEnumeratorSPtr);
                    }
 
                    co_await MergeAsync(keyCheckpointFileListSPtr, cancellationToken);
@@ -180,7 +212,14 @@ namespace Data
                     KSharedPtr<KeyData<TKey, TValue>> row = currentEnumeratorSPtr->GetCurrent();
 
                     count++;
-                    AddOrUpdate(row->Key, row->Value);
+                    if (diskKeyIndexSPtr_ != nullptr)
+                    {
+                        CountLatest(row->Key, row->Value);
+                    }
+                    else
+                    {
+                        AddOrUpdate(row->Key, row->Value);
+                    }
 
                     result = co_await currentEnumeratorSPtr->MoveNextAsync(cancellationToken);
                     if (result)
@@ -191,6 +230,11 @@ namespace Data
 
                 STORE_ASSERT(priorityQueue.IsEmpty(), "priority queue must be empty");
 
+                if (isLastKeySet_ && lastVersionSPtr_->GetRecordKind() != RecordKind::DeletedVersion)
+                {
+                    recoveredKeyCount_++;
+                }
+
                 for (ULONG i = 0; i < keyCheckpointFileListSPtr->Count(); i++)
                 {
                     KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> keyCheckpointEnumeratorSPtr = (*keyCheckpointFileListSPtr)[i];
@@ -205,6 +249,35 @@ namespace Data
             }
 
 
+            // Versions of a key come out of the merge latest first, so only the first version of each key is counted.
+            void CountLatest(TKey inputKey, KSharedPtr<VersionedItem<TValue>> const & inputValue)
+            {
+                STORE_ASSERT(inputValue != nullptr, "value should not be null");
+
+                if (isLastKeySet_)
+                {
+                    LONG32 keyComparison = comparerSPtr_->Compare(lastKey_, inputKey);
+                    STORE_ASSERT(keyComparison <= 0, "input key must be greater than or equal to last key processed");
+
+                    if (keyComparison == 0)
+                    {
+                        STORE_ASSERT(
+                            lastVersionSPtr_->GetVersionSequenceNumber() >= inputValue->GetVersionSequenceNumber(),
+                            "versions of a key must be read latest first");
+                        return;
+                    }
+
+                    if (lastVersionSPtr_->GetRecordKind() != RecordKind::DeletedVersion)
+                    {
+                        recoveredKeyCount_++;
+                    }
+                }
+
+                lastKey_ = inputKey;
+                lastVersionSPtr_ = inputValue;
+                isLastKeySet_ = true;
+            }
+
             void AddOrUpdate(TKey inputKey, KSharedPtr<VersionedItem<TValue>> const & inputValue)
             {
                 STORE_ASSERT(inputValue != nullptr, "value should not be null");
@@ -263,6 +336,13 @@ namespace Data
             KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
             KSharedPtr<KSharedArray<KeyValuePair<TKey, KSharedPtr<VersionedItem<TValue>>>>> componentSPtr_;
             KSharedPtr<IComparer<TKey>> comparerSPtr_;
+            KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr_;
+
+            // Used instead of the component when the keys are disk resident
+            LONG64 recoveredKeyCount_;
+            bool isLastKeySet_;
+            TKey lastKey_;
+            KSharedPtr<VersionedItem<TValue>> lastVersionSPtr_;
             
             StoreTraceComponent::SPtr traceComponent_;
         };
@@ -280,6 +360,11 @@ namespace Data
             keySerializerSPtr_(&keySerializer),
             isValueReferenceType_(isValueReferenceType),
             comparerSPtr_(&keyComparer),
+            diskKeyIndexSPtr_(nullptr),
+            recoveredKeyCount_(0),
+            isLastKeySet_(false),
+            lastKey_(),
+            lastVersionSPtr_(nullptr),
             traceComponent_(&traceComponent)
         {
             auto status = KString::Create(workDirectorySPtr_, this->GetThisAllocator(), workDirectory);
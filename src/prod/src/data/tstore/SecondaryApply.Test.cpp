@@ -41,21 +41,22 @@ namespace TStoreTests
             return operationDataSPtr;
         }
 
-        void SecondaryApply(
-            __in StoreModificationType::Enum operationType, 
-            __in int key, 
-            __in OperationData & keyBytes, 
-            __in int value, 
-            __in OperationData::SPtr & valueBytes)
+        struct SecondaryOperation
         {
-            KAllocator& allocator = GetAllocator();
-            auto commitLSN = Replicator->IncrementAndGetCommitSequenceNumber();
-
-            Transaction::SPtr tx = CreateReplicatorTransaction();
-            Transaction::CSPtr txnCSPtr = tx.RawPtr();
-            tx->CommitSequenceNumber = commitLSN;
-
+            StoreModificationType::Enum Type;
+            int Key;
+            int Value;
+        };
 
+        OperationData::CSPtr CreateMetadata(
+            __in StoreModificationType::Enum operationType,
+            __in int key,
+            __in OperationData & keyBytes,
+            __in int value,
+            __in OperationData::SPtr & valueBytes,
+            __in LONG64 transactionId)
+        {
+            KAllocator& allocator = GetAllocator();
             OperationData::CSPtr metadataCSPtr = nullptr;
 
             if (valueBytes != nullptr)
@@ -66,7 +67,7 @@ namespace TStoreTests
                     value,
                     Constants::SerializedVersion,
                     operationType,
-                    txnCSPtr->TransactionId,
+                    transactionId,
                     &keyBytes,
                     allocator,
                     metadataKVCSPtr);
@@ -80,7 +81,7 @@ namespace TStoreTests
                     key,
                     Constants::SerializedVersion,
                     operationType,
-                    txnCSPtr->TransactionId,
+                    transactionId,
                     &keyBytes,
                     allocator,
                     metadataKCSPtr);
@@ -88,6 +89,24 @@ namespace TStoreTests
                 metadataCSPtr = static_cast<const OperationData* const>(metadataKCSPtr.RawPtr());
             }
 
+            return metadataCSPtr;
+        }
+
+        void SecondaryApply(
+            __in StoreModificationType::Enum operationType, 
+            __in int key, 
+            __in OperationData & keyBytes, 
+            __in int value, 
+            __in OperationData::SPtr & valueBytes)
+        {
+            auto commitLSN = Replicator->IncrementAndGetCommitSequenceNumber();
+
+            Transaction::SPtr tx = CreateReplicatorTransaction();
+            Transaction::CSPtr txnCSPtr = tx.RawPtr();
+            tx->CommitSequenceNumber = commitLSN;
+
+            OperationData::CSPtr metadataCSPtr = CreateMetadata(operationType, key, keyBytes, value, valueBytes, txnCSPtr->TransactionId);
+
           RedoUndoOperationData::SPtr redoDataSPtr = nullptr;
           RedoUndoOperationData::Create(GetAllocator(), valueBytes, nullptr, redoDataSPtr);
 
@@ -104,6 +123,99 @@ namespace TStoreTests
           }
         }
 
+        //
+        // Applies the operations as one replicator transaction, either with ApplyBatchAsync
+        // or with one ApplyAsync per operation as the replicator did before batching.
+        //
+        void SecondaryApplyTransaction(
+            __in std::vector<SecondaryOperation> const & operations,
+            __in bool useBatch)
+        {
+            KAllocator& allocator = GetAllocator();
+            auto commitLSN = Replicator->IncrementAndGetCommitSequenceNumber();
+
+            Transaction::SPtr tx = CreateReplicatorTransaction();
+            Transaction::CSPtr txnCSPtr = tx.RawPtr();
+            tx->CommitSequenceNumber = commitLSN;
+
+            KArray<LONG64> lsns(allocator);
+            KArray<OperationData::CSPtr> metadataArray(allocator);
+            KArray<OperationData::CSPtr> dataArray(allocator);
+            KArray<TxnReplicator::OperationContext::CSPtr> operationContexts(allocator);
+
+            for (auto operation : operations)
+            {
+                auto keyBytesSPtr = GetBytes(operation.Key);
+                OperationData::SPtr valueBytesSPtr = nullptr;
+                if (operation.Type != StoreModificationType::Enum::Remove)
+                {
+                    valueBytesSPtr = GetBytes(operation.Value);
+                }
+
+                RedoUndoOperationData::SPtr redoDataSPtr = nullptr;
+                RedoUndoOperationData::Create(allocator, valueBytesSPtr, nullptr, redoDataSPtr);
+
+                lsns.Append(commitLSN);
+                metadataArray.Append(CreateMetadata(operation.Type, operation.Key, *keyBytesSPtr, operation.Value, valueBytesSPtr, txnCSPtr->TransactionId));
+                dataArray.Append(OperationData::CSPtr(redoDataSPtr.RawPtr()));
+            }
+
+            if (useBatch)
+            {
+                SyncAwait(Store->ApplyBatchAsync(*txnCSPtr, ApplyContext::SecondaryRedo, lsns, metadataArray, dataArray, operationContexts));
+            }
+            else
+            {
+                for (ULONG32 i = 0; i < metadataArray.Count(); i++)
+                {
+                    auto operationContext = SyncAwait(Store->ApplyAsync(
+                        lsns[i],
+                        *txnCSPtr,
+                        ApplyContext::SecondaryRedo,
+                        metadataArray[i].RawPtr(),
+                        dataArray[i].RawPtr()));
+
+                    operationContexts.Append(operationContext);
+                }
+            }
+
+            CODING_ERROR_ASSERT(operationContexts.Count() == operations.size());
+
+            for (ULONG32 i = 0; i < operationContexts.Count(); i++)
+            {
+                if (operationContexts[i] != nullptr)
+                {
+                    Store->Unlock(*operationContexts[i]);
+                }
+            }
+        }
+
+        // Applies numberOfKeys adds in transactions of transactionSize operations and returns the time taken
+        LONG64 SecondaryAddKeys(
+            __in int startKey,
+            __in int numberOfKeys,
+            __in int transactionSize,
+            __in bool useBatch)
+        {
+            Common::Stopwatch stopwatch;
+            std::vector<SecondaryOperation> operations;
+
+            for (int key = startKey; key < startKey + numberOfKeys; key += transactionSize)
+            {
+                operations.clear();
+                for (int i = key; i < key + transactionSize && i < startKey + numberOfKeys; i++)
+                {
+                    operations.push_back({ StoreModificationType::Enum::Add, i, i + 1 });
+                }
+
+                stopwatch.Start();
+                SecondaryApplyTransaction(operations, useBatch);
+                stopwatch.Stop();
+            }
+
+            return stopwatch.ElapsedMilliseconds;
+        }
+
         void SecondaryAdd(int key, int value)
         {
 	    auto keyBytesSPtr = GetBytes(key);
@@ -167,5 +279,73 @@ namespace TStoreTests
         SyncAwait(VerifyKeyDoesNotExistAsync(*Store, key));
     }
 
+    BOOST_AUTO_TEST_CASE(Secondary_ApplyBatch_MultipleAdds_ShouldSucceed)
+    {
+        std::vector<SecondaryOperation> operations;
+        for (int key = 0; key < 16; key++)
+        {
+            operations.push_back({ StoreModificationType::Enum::Add, key, key * 10 });
+        }
+
+        SecondaryApplyTransaction(operations, true);
+
+        for (int key = 0; key < 16; key++)
+        {
+            SyncAwait(VerifyKeyExistsAsync(*Store, key, -1, key * 10));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(Secondary_ApplyBatch_AddUpdateRemoveSameKey_ShouldApplyInOrder)
+    {
+        std::vector<SecondaryOperation> operations;
+        operations.push_back({ StoreModificationType::Enum::Add, 1, 10 });
+        operations.push_back({ StoreModificationType::Enum::Add, 2, 20 });
+        operations.push_back({ StoreModificationType::Enum::Update, 1, 11 });
+        operations.push_back({ StoreModificationType::Enum::Remove, 2, -1 });
+
+        SecondaryApplyTransaction(operations, true);
+
+        SyncAwait(VerifyKeyExistsAsync(*Store, 1, -1, 11));
+        SyncAwait(VerifyKeyDoesNotExistAsync(*Store, 2));
+
+        operations.clear();
+        operations.push_back({ StoreModificationType::Enum::Add, 2, 21 });
+        operations.push_back({ StoreModificationType::Enum::Remove, 1, -1 });
+
+        SecondaryApplyTransaction(operations, true);
+
+        SyncAwait(VerifyKeyDoesNotExistAsync(*Store, 1));
+        SyncAwait(VerifyKeyExistsAsync(*Store, 2, -1, 21));
+    }
+
+    BOOST_AUTO_TEST_CASE(Secondary_ApplyThroughput_BatchVsSingle)
+    {
+        int numberOfKeys = 5000;
+        int transactionSizes[] = { 1, 4, 16, 64 };
+        int startKey = 0;
+
+        for (int transactionSize : transactionSizes)
+        {
+            LONG64 singleTime = SecondaryAddKeys(startKey, numberOfKeys, transactionSize, false);
+            startKey += numberOfKeys;
+
+            LONG64 batchTime = SecondaryAddKeys(startKey, numberOfKeys, transactionSize, true);
+            startKey += numberOfKeys;
+
+            Trace.WriteInfo(
+                "Perf",
+                "SecondaryApply {0} adds in transactions of {1}: ApplyAsync {2} ms, ApplyBatchAsync {3} ms",
+                numberOfKeys,
+                transactionSize,
+                singleTime,
+                batchTime);
+        }
+
+        for (int key = 0; key < startKey; key += 997)
+        {
+            SyncAwait(VerifyKeyExistsAsync(*Store, key, -1, key + 1));
+        }
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
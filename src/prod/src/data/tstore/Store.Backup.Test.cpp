@@ -73,7 +73,7 @@ namespace TStoreTests
             return backupDirectory.RawPtr();
         }
 
-        void PerformBackup(__in KString & backupDirectory)
+        void PerformBackup(__in KString & backupDirectory, __in CompressionCodec::Enum codec = CompressionCodec::None)
         {
             // Ensure the Backup directory exists.
             if (!Common::Directory::Exists(backupDirectory.operator LPCWSTR()))
@@ -89,7 +89,14 @@ namespace TStoreTests
             Checkpoint(*Store);
 
             // Perform the actual backup.
-            SyncAwait(Store->BackupCheckpointAsync(backupDirectory, CancellationToken::None));
+            if (codec == CompressionCodec::None)
+            {
+                SyncAwait(Store->BackupCheckpointAsync(backupDirectory, CancellationToken::None));
+            }
+            else
+            {
+                SyncAwait(Store->BackupCompressedCheckpointAsync(backupDirectory, codec, 4, CancellationToken::None));
+            }
         }
 
         void RestoreFromBackup(__in KString & backupDirectory)
@@ -275,5 +282,56 @@ namespace TStoreTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(Backup_Compressed_MultipleCheckpoints)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            {
+                WriteTransaction<int, int>::SPtr tx = CreateWriteTransaction();
+                SyncAwait(Store->AddAsync(*tx->StoreTransactionSPtr, i, i, Common::TimeSpan::MaxValue, CancellationToken::None));
+                SyncAwait(tx->CommitAsync());
+            }
+
+            if (i % 100 == 0)
+            {
+                Checkpoint(*Store);
+            }
+        }
+
+        PerformBackup(*backupDirectorySPtr, CompressionCodec::Lz);
+
+        // Only the compressed form of the checkpoint files is in the backup.
+        KString::SPtr extensionSPtr;
+        NTSTATUS status = KString::Create(extensionSPtr, GetAllocator(), CompressedFile::FileExtension);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+        wstring extension(extensionSPtr->operator LPCWSTR());
+
+        auto backupFiles = Common::Directory::GetFiles(backupDirectorySPtr->operator LPCWSTR(), L"*", false, true);
+        ULONG32 compressedFileCount = 0;
+        for (auto const & backupFile : backupFiles)
+        {
+            if (Common::StringUtility::EndsWith(backupFile, extension))
+            {
+                compressedFileCount++;
+            }
+        }
+
+        CODING_ERROR_ASSERT(compressedFileCount > 0);
+        CODING_ERROR_ASSERT(compressedFileCount == backupFiles.size() - 1);
+
+        RestoreFromBackup(*backupDirectorySPtr);
+        VerifyCount(1000);
+
+        {
+            WriteTransaction<int, int>::SPtr tx = CreateWriteTransaction();
+            for (int i = 0; i < 1000; i++)
+            {
+                SyncAwait(VerifyKeyExistsAsync(*Store, i, -1, i));
+            }
+
+            SyncAwait(tx->AbortAsync());
+        }
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
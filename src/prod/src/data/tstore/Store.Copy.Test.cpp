@@ -44,6 +44,9 @@ namespace TStoreTests
         ~StoreCopyTest()
         {
             Cleanup();
+
+            StoreCopyStream::CopyChunkSize = 500 * 1024;
+            StoreCopyStream::MaxCopyChunkSize = 4 * 1024 * 1024;
         }
 
         KString::SPtr GetStringValue(__in LPCWSTR value)
@@ -261,6 +264,49 @@ namespace TStoreTests
             FullCopyTest(numItems);
         }
 
+        // Copies a checkpoint file of the given size to a new secondary and returns the size of the largest copy operation.
+        ULONG32 FullCopyTestWithFileSizeAndMaxOperationSize(__in ULONG32 checkpointFileSize)
+        {
+            // Each key takes 56 bytes in the key checkpoint file
+            const ULONG32 keyCheckpointFileItemSize = 56;
+            ULONG32 numItems = checkpointFileSize / keyCheckpointFileItemSize;
+            PopulateStore(numItems);
+            Checkpoint(*Store);
+
+            auto secondaryStore = CreateSecondary();
+            auto copyState = Store->GetCurrentState();
+            secondaryStore->BeginSettingCurrentState();
+
+            LONG64 stateRecordNumber = 0;
+            ULONG32 maxOperationSize = 0;
+            while (true)
+            {
+                OperationData::CSPtr operationData;
+                SyncAwait(copyState->GetNextAsync(CancellationToken::None, operationData));
+                if (operationData == nullptr)
+                {
+                    copyState->Dispose();
+                    break;
+                }
+
+                ULONG32 operationSize = 0;
+                for (ULONG32 i = 0; i < operationData->BufferCount; i++)
+                {
+                    operationSize += (*operationData)[i]->QuerySize();
+                }
+
+                maxOperationSize = __max(maxOperationSize, operationSize);
+
+                SyncAwait(secondaryStore->SetCurrentStateAsync(stateRecordNumber, *operationData, CancellationToken::None));
+                stateRecordNumber++;
+            }
+
+            SyncAwait(secondaryStore->EndSettingCurrentStateAsync(CancellationToken::None));
+
+            VerifyState(*Stores, numItems);
+            return maxOperationSize;
+        }
+
         void FullCopyTest(__in ULONG32 numItems)
         {
             PopulateStore(numItems);
@@ -273,6 +319,54 @@ namespace TStoreTests
             VerifyState(*Stores, numItems);
         }
 
+        // Copies the checkpointed state of the primary to a new secondary and traces the copy throughput.
+        void TimedFullCopyTest(__in ULONG32 numItems, __in LPCSTR name)
+        {
+            PopulateStore(numItems);
+            Checkpoint(*Store);
+
+            auto secondaryStore = CreateSecondary();
+            auto copyState = Store->GetCurrentState();
+            secondaryStore->BeginSettingCurrentState();
+
+            Common::Stopwatch stopwatch;
+            stopwatch.Start();
+
+            LONG64 stateRecordNumber = 0;
+            ULONG64 copiedBytes = 0;
+            while (true)
+            {
+                OperationData::CSPtr operationData;
+                SyncAwait(copyState->GetNextAsync(CancellationToken::None, operationData));
+                if (operationData == nullptr)
+                {
+                    copyState->Dispose();
+                    break;
+                }
+
+                for (ULONG32 i = 0; i < operationData->BufferCount; i++)
+                {
+                    copiedBytes += (*operationData)[i]->QuerySize();
+                }
+
+                SyncAwait(secondaryStore->SetCurrentStateAsync(stateRecordNumber, *operationData, CancellationToken::None));
+                stateRecordNumber++;
+            }
+
+            SyncAwait(secondaryStore->EndSettingCurrentStateAsync(CancellationToken::None));
+            stopwatch.Stop();
+
+            Trace.WriteInfo(
+                "Perf",
+                "{0}: copied {1} bytes in {2} operations in {3} ms",
+                name,
+                copiedBytes,
+                stateRecordNumber,
+                stopwatch.ElapsedMilliseconds);
+
+            VerifyState(*Stores, numItems);
+        }
+
         KSharedArray<ULONG32>::SPtr SnapCheckpointIds(__in MetadataTable & table)
         {
             KSharedArray<ULONG32>::SPtr checkpointFileIdsToCopy = _new(ALLOC_TAG, GetAllocator()) KSharedArray<ULONG32>();
@@ -681,6 +775,7 @@ namespace TStoreTests
     BOOST_AUTO_TEST_CASE(Copy_ExactlyOneChunk_4KBChunks_ShouldSucceed)
     {
         StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
         ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize;
         FullCopyTestWithFileSize(checkpointFileSize);
     }
@@ -688,6 +783,7 @@ namespace TStoreTests
     BOOST_AUTO_TEST_CASE(Copy_MoreThanOneChunk_4KBChunks_ShouldSucceed)
     {
         StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
         ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize + 1024;
         FullCopyTestWithFileSize(checkpointFileSize);
     }
@@ -695,6 +791,7 @@ namespace TStoreTests
     BOOST_AUTO_TEST_CASE(Copy_TwoChunks_4KBChunks_ShouldSucceed)
     {
         StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
         ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize * 2;
         FullCopyTestWithFileSize(checkpointFileSize);
     }
@@ -702,6 +799,7 @@ namespace TStoreTests
     BOOST_AUTO_TEST_CASE(Copy_MoreThanTwoChunks_4KBChunks_ShouldSucceed)
     {
         StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
         ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize * 2 + 1024;
         FullCopyTestWithFileSize(checkpointFileSize);
     }
@@ -709,10 +807,40 @@ namespace TStoreTests
     BOOST_AUTO_TEST_CASE(Copy_ManyChunks_4KBChunks_ShouldSucceed)
     {
         StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
         ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize * 5 + 1024;
         FullCopyTestWithFileSize(checkpointFileSize);
     }
 
+    BOOST_AUTO_TEST_CASE(Copy_ManyChunks_AdaptiveChunks_ShouldSucceed)
+    {
+        // The start of a file carries its id and a marker, the other chunks only a marker
+        ULONG32 const chunkOverhead = sizeof(ULONG32) + 1;
+
+        StoreCopyStream::CopyChunkSize = 4096;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize * 8;
+        ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize * 40 + 1024;
+
+        ULONG32 maxOperationSize = FullCopyTestWithFileSizeAndMaxOperationSize(checkpointFileSize);
+
+        // Chunks are consumed faster than the target latency, so full chunks are sent as is and the chunk size grows,
+        // without going over the maximum
+        VERIFY_IS_TRUE(maxOperationSize > StoreCopyStream::CopyChunkSize + chunkOverhead);
+        VERIFY_IS_TRUE(maxOperationSize <= StoreCopyStream::MaxCopyChunkSize + chunkOverhead);
+    }
+
+    BOOST_AUTO_TEST_CASE(Copy_MoreThanTwoChunks_AdaptiveChunks_UnalignedTail_ShouldSucceed)
+    {
+        ULONG32 const chunkOverhead = sizeof(ULONG32) + 1;
+
+        StoreCopyStream::CopyChunkSize = 4192;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize * 2;
+        ULONG32 checkpointFileSize = StoreCopyStream::CopyChunkSize * 3 + 1024;
+
+        ULONG32 maxOperationSize = FullCopyTestWithFileSizeAndMaxOperationSize(checkpointFileSize);
+        VERIFY_IS_TRUE(maxOperationSize <= StoreCopyStream::MaxCopyChunkSize + chunkOverhead);
+    }
+
     BOOST_AUTO_TEST_CASE(Copy_100AddUpdate_ShouldSucceed)
     {
         ULONG32 numItems = 100;
@@ -1253,6 +1381,46 @@ namespace TStoreTests
         FullCopyTest(numItems);
     }
 
+    BOOST_AUTO_TEST_CASE(Copy_ChunkSize_AdaptsToThroughput)
+    {
+        StoreCopyStream::CopyChunkSize = 4096;
+        StoreCopyStream::MaxCopyChunkSize = 64 * 1024;
+        LONG64 const targetLatency = StoreCopyStream::TargetChunkLatencyInMicroseconds;
+
+        // Fast consumer: grows, at most doubling, up to the maximum.
+        VERIFY_ARE_EQUAL(8192u, StoreCopyStream::GetNextChunkSize(4096, 4096, 0));
+        VERIFY_ARE_EQUAL(8192u, StoreCopyStream::GetNextChunkSize(4096, 4096, targetLatency / 100));
+        VERIFY_ARE_EQUAL(64u * 1024, StoreCopyStream::GetNextChunkSize(64 * 1024, 64 * 1024, 1));
+
+        // Consumer at the target latency: unchanged.
+        VERIFY_ARE_EQUAL(16384u, StoreCopyStream::GetNextChunkSize(16384, 16384, targetLatency));
+
+        // Slow consumer: shrinks, at most halving, down to the minimum.
+        VERIFY_ARE_EQUAL(8192u, StoreCopyStream::GetNextChunkSize(16384, 16384, targetLatency * 100));
+        VERIFY_ARE_EQUAL(4096u, StoreCopyStream::GetNextChunkSize(4096, 4096, targetLatency * 100));
+
+        // Minimum above the maximum: the minimum wins.
+        StoreCopyStream::MaxCopyChunkSize = 1024;
+        VERIFY_ARE_EQUAL(4096u, StoreCopyStream::GetNextChunkSize(4096, 4096, 0));
+
+        StoreCopyStream::CopyChunkSize = 500 * 1024;
+        StoreCopyStream::MaxCopyChunkSize = 4 * 1024 * 1024;
+    }
+
+    BOOST_AUTO_TEST_CASE(Copy_Perf_FixedChunks, * boost::unit_test_framework::disabled(/* Perf test */))
+    {
+        StoreCopyStream::CopyChunkSize = 500 * 1024;
+        StoreCopyStream::MaxCopyChunkSize = StoreCopyStream::CopyChunkSize;
+        TimedFullCopyTest(200000, "Copy_Perf_FixedChunks");
+    }
+
+    BOOST_AUTO_TEST_CASE(Copy_Perf_AdaptiveChunks, * boost::unit_test_framework::disabled(/* Perf test */))
+    {
+        StoreCopyStream::CopyChunkSize = 500 * 1024;
+        StoreCopyStream::MaxCopyChunkSize = 4 * 1024 * 1024;
+        TimedFullCopyTest(200000, "Copy_Perf_AdaptiveChunks");
+    }
+
     BOOST_AUTO_TEST_CASE(Copy_VerifyIdempotencyOnOverlapBetweenCopyCheckpointAndLog_ShouldSucceed)
     {
         LONG64 key = 17;
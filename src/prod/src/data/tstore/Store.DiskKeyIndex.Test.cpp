@@ -0,0 +1,391 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+#include "TStoreTestBase.h"
+
+#define ALLOC_TAG 'kdTP'
+
+namespace TStoreTests
+{
+    class DiskKeyIndexTest : public TStoreTestBase<LONG64, KString::SPtr, LongComparer, TestStateSerializer<LONG64>, StringStateSerializer>
+    {
+    public:
+        DiskKeyIndexTest()
+        {
+            Setup(1);
+            Store->EnableDiskResidentKeys = true;
+            SyncAwait(Store->RecoverCheckpointAsync(CancellationToken::None));
+        }
+
+        ~DiskKeyIndexTest()
+        {
+            Cleanup();
+        }
+
+        static bool StringEquals(__in KString::SPtr & one, __in KString::SPtr & two)
+        {
+            if (one == nullptr || two == nullptr)
+            {
+                return one == two;
+            }
+
+            return one->Compare(*two) == 0;
+        }
+
+        KString::SPtr GenerateString(__in LONG64 seed)
+        {
+            KString::SPtr result;
+            wstring str = wstring(L"value") + to_wstring(seed);
+            auto status = KString::Create(result, GetAllocator(), str.c_str());
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+            return result;
+        }
+
+        void AddKeys(__in LONG64 startKey, __in LONG64 count, __in LONG64 step = 1)
+        {
+            for (LONG64 key = startKey; key < startKey + count * step; key += step)
+            {
+                auto txn = CreateWriteTransaction();
+                SyncAwait(Store->AddAsync(*txn->StoreTransactionSPtr, key, GenerateString(key), DefaultTimeout, CancellationToken::None));
+                SyncAwait(txn->CommitAsync());
+            }
+        }
+
+        void UpdateKey(__in LONG64 key, __in LONG64 seed)
+        {
+            auto txn = CreateWriteTransaction();
+            bool result = SyncAwait(Store->ConditionalUpdateAsync(*txn->StoreTransactionSPtr, key, GenerateString(seed), DefaultTimeout, CancellationToken::None));
+            CODING_ERROR_ASSERT(result);
+            SyncAwait(txn->CommitAsync());
+        }
+
+        void RemoveKey(__in LONG64 key)
+        {
+            auto txn = CreateWriteTransaction();
+            bool result = SyncAwait(Store->ConditionalRemoveAsync(*txn->StoreTransactionSPtr, key, DefaultTimeout, CancellationToken::None));
+            CODING_ERROR_ASSERT(result);
+            SyncAwait(txn->CommitAsync());
+        }
+
+        void VerifyKeyExists(__in LONG64 key, __in LONG64 seed)
+        {
+            SyncAwait(VerifyKeyExistsInStoresAsync(key, nullptr, GenerateString(seed), StringEquals));
+        }
+
+        void VerifyKeyDoesNotExist(__in LONG64 key)
+        {
+            SyncAwait(VerifyKeyDoesNotExistInStoresAsync(key));
+        }
+
+        void VerifyConsolidatedStateIsEmpty()
+        {
+            CODING_ERROR_ASSERT(Store->ConsolidationManagerSPtr->Count() == 0);
+        }
+
+        void VerifyEnumeration(
+            __in KArray<LONG64> const & expectedKeys,
+            __in bool useFirstKey = false,
+            __in LONG64 firstKey = 0,
+            __in bool useLastKey = false,
+            __in LONG64 lastKey = 0)
+        {
+            auto txn = CreateWriteTransaction();
+            txn->StoreTransactionSPtr->ReadIsolationLevel = StoreTransactionReadIsolationLevel::Snapshot;
+
+            auto enumeratorSPtr = SyncAwait(Store->CreateEnumeratorAsync(*txn->StoreTransactionSPtr, firstKey, useFirstKey, lastKey, useLastKey));
+
+            ULONG32 index = 0;
+            while (SyncAwait(enumeratorSPtr->MoveNextAsync(CancellationToken::None)))
+            {
+                auto current = enumeratorSPtr->GetCurrent();
+                CODING_ERROR_ASSERT(index < expectedKeys.Count());
+                CODING_ERROR_ASSERT(current.Key == expectedKeys[index]);
+
+                KString::SPtr expectedValue = GenerateString(current.Key);
+                KString::SPtr actualValue = current.Value.Value;
+                CODING_ERROR_ASSERT(StringEquals(expectedValue, actualValue));
+                index++;
+            }
+
+            CODING_ERROR_ASSERT(index == expectedKeys.Count());
+            SyncAwait(txn->AbortAsync());
+        }
+
+        Common::CommonConfig config; // load the config object as its needed for the tracing to work
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(DiskKeyIndexTestSuite, DiskKeyIndexTest)
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_AddCheckpoint_ReadFromDisk_ShouldSucceed)
+    {
+        AddKeys(0, 1000);
+        Checkpoint();
+
+        VerifyConsolidatedStateIsEmpty();
+        VerifyCount(1000);
+
+        for (LONG64 key = 0; key < 1000; key++)
+        {
+            VerifyKeyExists(key, key);
+        }
+
+        VerifyKeyDoesNotExist(1000);
+        VerifyKeyDoesNotExist(-1);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_UpdateAndRemoveAcrossCheckpoints_ShouldSucceed)
+    {
+        AddKeys(0, 100);
+        Checkpoint();
+
+        UpdateKey(10, 1010);
+        RemoveKey(20);
+        Checkpoint();
+
+        VerifyConsolidatedStateIsEmpty();
+        VerifyCount(99);
+        VerifyKeyExists(10, 1010);
+        VerifyKeyDoesNotExist(20);
+        VerifyKeyExists(30, 30);
+
+        // Adding back a removed key
+        AddKeys(20, 1);
+        Checkpoint();
+
+        VerifyCount(100);
+        VerifyKeyExists(20, 20);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_CheckpointAndRecover_ShouldSucceed)
+    {
+        AddKeys(0, 100);
+        Checkpoint();
+
+        RemoveKey(50);
+        UpdateKey(60, 1060);
+        Checkpoint();
+
+        CloseAndReOpenStore();
+
+        VerifyConsolidatedStateIsEmpty();
+        VerifyCount(99);
+        VerifyKeyDoesNotExist(50);
+        VerifyKeyExists(60, 1060);
+        VerifyKeyExists(70, 70);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_MergeFiles_ShouldSucceed)
+    {
+        Store->MergeHelperSPtr->CurrentMergePolicy = MergePolicy::InvalidEntries;
+        Store->MergeHelperSPtr->MergeFilesCountThreshold = 2;
+        Store->MergeHelperSPtr->NumberOfInvalidEntries = 1;
+
+        AddKeys(0, 50);
+        Checkpoint();
+
+        RemoveKey(0);
+        UpdateKey(1, 1001);
+        Checkpoint();
+
+        UpdateKey(2, 1002);
+        Checkpoint();
+
+        VerifyCount(49);
+        VerifyKeyDoesNotExist(0);
+        VerifyKeyExists(1, 1001);
+        VerifyKeyExists(2, 1002);
+        VerifyKeyExists(3, 3);
+
+        CloseAndReOpenStore();
+
+        VerifyCount(49);
+        VerifyKeyDoesNotExist(0);
+        VerifyKeyExists(1, 1001);
+        VerifyKeyExists(2, 1002);
+        VerifyKeyExists(49, 49);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_Enumerate_MergesDiskAndMemoryKeys_ShouldSucceed)
+    {
+        // Even keys are on disk, odd keys are in the differential state
+        AddKeys(0, 50, 2);
+        Checkpoint();
+
+        AddKeys(1, 50, 2);
+        RemoveKey(10);
+
+        KArray<LONG64> expectedKeys(GetAllocator());
+        for (LONG64 key = 0; key < 100; key++)
+        {
+            if (key != 10)
+            {
+                expectedKeys.Append(key);
+            }
+        }
+
+        VerifyEnumeration(expectedKeys);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_EnumerateRange_AfterRecovery_ShouldSucceed)
+    {
+        AddKeys(0, 500);
+        Checkpoint();
+        CloseAndReOpenStore();
+
+        KArray<LONG64> expectedKeys(GetAllocator());
+        for (LONG64 key = 200; key <= 300; key++)
+        {
+            expectedKeys.Append(key);
+        }
+
+        VerifyEnumeration(expectedKeys, true, 200, true, 300);
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_SnapshotRead_AfterUpdateAndCheckpoint_ShouldSeeSnapshotVersion)
+    {
+        Store->ConsolidationManagerSPtr->NumberOfDeltasToBeConsolidated = 1;
+
+        AddKeys(0, 100);
+        Checkpoint();
+
+        // Start the snapshot transaction here
+        auto snapshotTxn = CreateWriteTransaction();
+        snapshotTxn->StoreTransactionSPtr->ReadIsolationLevel = StoreTransactionReadIsolationLevel::Snapshot;
+        SyncAwait(VerifyKeyExistsAsync(*Store, *snapshotTxn->StoreTransactionSPtr, 10, nullptr, GenerateString(10), StringEquals));
+
+        UpdateKey(10, 1010);
+        RemoveKey(20);
+        Checkpoint();
+
+        UpdateKey(10, 2010);
+        Checkpoint();
+
+        VerifyConsolidatedStateIsEmpty();
+        VerifyKeyExists(10, 2010);
+        VerifyKeyDoesNotExist(20);
+
+        SyncAwait(VerifyKeyExistsAsync(*Store, *snapshotTxn->StoreTransactionSPtr, 10, nullptr, GenerateString(10), StringEquals));
+        SyncAwait(VerifyKeyExistsAsync(*Store, *snapshotTxn->StoreTransactionSPtr, 20, nullptr, GenerateString(20), StringEquals));
+        SyncAwait(VerifyKeyExistsAsync(*Store, *snapshotTxn->StoreTransactionSPtr, 30, nullptr, GenerateString(30), StringEquals));
+
+        SyncAwait(snapshotTxn->AbortAsync());
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_KeyEnumerator_MergesDiskAndMemoryKeysAtSnapshot_ShouldSucceed)
+    {
+        Store->ConsolidationManagerSPtr->NumberOfDeltasToBeConsolidated = 1;
+
+        // Even keys are on disk, odd keys are in the differential state
+        AddKeys(0, 50, 2);
+        Checkpoint();
+
+        AddKeys(1, 50, 2);
+        RemoveKey(10);
+
+        auto snapshotTxn = CreateWriteTransaction();
+        snapshotTxn->StoreTransactionSPtr->ReadIsolationLevel = StoreTransactionReadIsolationLevel::Snapshot;
+        SyncAwait(VerifyKeyExistsAsync(*Store, *snapshotTxn->StoreTransactionSPtr, 0, nullptr, GenerateString(0), StringEquals));
+
+        // Not visible to the snapshot
+        RemoveKey(12);
+        AddKeys(100, 10);
+        Checkpoint();
+
+        LONG64 firstKey = 5;
+        LONG64 lastKey = 200;
+        auto enumeratorSPtr = SyncAwait(Store->CreateKeyEnumeratorAsync(*snapshotTxn->StoreTransactionSPtr, firstKey, lastKey));
+
+        LONG64 expectedKey = firstKey;
+        while (enumeratorSPtr->MoveNext())
+        {
+            if (expectedKey == 10)
+            {
+                expectedKey++;
+            }
+
+            CODING_ERROR_ASSERT(enumeratorSPtr->Current() == expectedKey);
+            expectedKey++;
+        }
+
+        CODING_ERROR_ASSERT(expectedKey == 100);
+        SyncAwait(snapshotTxn->AbortAsync());
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_KeyEnumerator_MoreKeysThanReadAhead_ShouldSucceed)
+    {
+        // Even keys are on disk and span more than two read ahead batches, a few odd keys are in the differential state
+        LONG64 diskKeyCount = 2 * Constants::DiskKeyReadAheadCount + 10;
+        AddKeys(0, diskKeyCount, 2);
+        Checkpoint();
+
+        AddKeys(1, 10, 2);
+
+        // Removed in memory after the checkpoint, so it is still on disk
+        LONG64 removedKey = 2 * (Constants::DiskKeyReadAheadCount + 500);
+        RemoveKey(removedKey);
+
+        auto txn = CreateWriteTransaction();
+        auto enumeratorSPtr = SyncAwait(Store->CreateKeyEnumeratorAsync(*txn->StoreTransactionSPtr));
+
+        LONG64 expectedKey = 0;
+        while (enumeratorSPtr->MoveNext())
+        {
+            if (expectedKey == removedKey)
+            {
+                expectedKey += 2;
+            }
+
+            CODING_ERROR_ASSERT(enumeratorSPtr->Current() == expectedKey);
+            expectedKey += expectedKey < 20 ? 1 : 2;
+        }
+
+        CODING_ERROR_ASSERT(expectedKey == 2 * diskKeyCount);
+        SyncAwait(txn->AbortAsync());
+    }
+
+    BOOST_AUTO_TEST_CASE(DiskKeys_Recover_RebuildNotification_ShouldSucceed)
+    {
+        LongComparer::SPtr longComparerSPtr = nullptr;
+        NTSTATUS status = LongComparer::Create(GetAllocator(), longComparerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        KStringComparer::SPtr stringComparerSPtr = nullptr;
+        status = KStringComparer::Create(GetAllocator(), stringComparerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        TestDictionaryChangeHandler<LONG64, KString::SPtr>::SPtr handlerSPtr = nullptr;
+        status = TestDictionaryChangeHandler<LONG64, KString::SPtr>::Create(*longComparerSPtr, *stringComparerSPtr, GetAllocator(), handlerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        for (LONG64 key = 0; key < 100; key++)
+        {
+            auto txn = CreateWriteTransaction();
+            SyncAwait(Store->AddAsync(*txn->StoreTransactionSPtr, key, GenerateString(key), DefaultTimeout, CancellationToken::None));
+            SyncAwait(txn->CommitAsync());
+
+            if (key != 50)
+            {
+                handlerSPtr->AddToExpectedRebuild(key, GenerateString(key), txn->TransactionSPtr->CommitSequenceNumber);
+            }
+        }
+
+        Checkpoint();
+
+        RemoveKey(50);
+        Checkpoint();
+
+        IDictionaryChangeHandler<LONG64, KString::SPtr>::SPtr changeHandlerSPtr = static_cast<IDictionaryChangeHandler<LONG64, KString::SPtr> *>(handlerSPtr.RawPtr());
+        CloseAndReOpenStore(changeHandlerSPtr);
+
+        VerifyConsolidatedStateIsEmpty();
+        CODING_ERROR_ASSERT(handlerSPtr->RebuildCallCount() == 1);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -9,6 +9,10 @@
 #include "Common/boost-taef.h"
 #include "TStoreTestBase.h"
 
+#if defined(PLATFORM_UNIX)
+#include <malloc.h>
+#endif
+
 #define ALLOC_TAG 'ssTP'
 
 inline bool SingleElementBufferEquals(KBuffer::SPtr & one, KBuffer::SPtr & two)
@@ -57,6 +61,34 @@ namespace TStoreTests
             return writer.GetBuffer(0)->QuerySize();
         }
 
+        // Bytes currently allocated from the process heap
+        LONG64 GetAllocatedHeapBytes()
+        {
+#if !defined(PLATFORM_UNIX)
+            PROCESS_MEMORY_COUNTERS_EX counters;
+            BOOL succeeded = GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS *>(&counters), sizeof(counters));
+            CODING_ERROR_ASSERT(succeeded);
+            return static_cast<LONG64>(counters.PrivateUsage);
+#else
+            struct mallinfo info = mallinfo();
+            return static_cast<LONG64>(static_cast<ULONG>(info.uordblks)) + static_cast<LONG64>(static_cast<ULONG>(info.hblkhd));
+#endif
+        }
+
+        // Versioned item whose value is only in the checkpoint files, as after recovery
+        KSharedPtr<VersionedItem<KBuffer::SPtr>> CreateCheckpointedItem(__in LONG64 key)
+        {
+            InsertedVersionedItem<KBuffer::SPtr>::SPtr itemSPtr = nullptr;
+            NTSTATUS status = InsertedVersionedItem<KBuffer::SPtr>::Create(GetAllocator(), itemSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            itemSPtr->SetVersionSequenceNumber(key + 1);
+            itemSPtr->SetFileId(1);
+            itemSPtr->SetValueSize(128);
+
+            return itemSPtr.RawPtr();
+        }
+
         Common::CommonConfig config; // load the config object as its needed for the tracing to work
     };
     
@@ -618,6 +650,98 @@ namespace TStoreTests
 
         SyncAwait(snapshotTxn->AbortAsync());
     }
-    
+
+    BOOST_AUTO_TEST_CASE(Consolidated_Recovery_PackedEntries_IndexSizePerKey)
+    {
+        Store->EnableSweep = false;
+        Store->ConsolidationManagerSPtr->NumberOfDeltasToBeConsolidated = 1;
+
+        LONG64 count = 100000;
+        KBuffer::SPtr value = CreateBuffer(128);
+
+        {
+            auto txn = CreateWriteTransaction();
+            for (LONG64 key = 0; key < count; key++)
+            {
+                SyncAwait(Store->AddAsync(*txn->StoreTransactionSPtr, key, value, DefaultTimeout, CancellationToken::None));
+            }
+
+            SyncAwait(txn->CommitAsync());
+        }
+
+        Checkpoint();
+        CloseAndReOpenStore();
+
+        CODING_ERROR_ASSERT(Store->Size == 0);
+
+        // Recovery must not have allocated a versioned item per key: reading every entry back from the
+        // consolidated state (without loading the values) allocates them now
+        auto consolidatedState = Store->ConsolidationManagerSPtr->GetConsolidatedState();
+        LONG64 heapBytesAfterRecovery = GetAllocatedHeapBytes();
+
+        for (LONG64 key = 0; key < count; key++)
+        {
+            CODING_ERROR_ASSERT(consolidatedState->Read(key) != nullptr);
+        }
+
+        LONG64 materializedBytesPerKey = (GetAllocatedHeapBytes() - heapBytesAfterRecovery) / count;
+        CODING_ERROR_ASSERT(materializedBytesPerKey >= static_cast<LONG64>(sizeof(InsertedVersionedItem<KBuffer::SPtr>)));
+        CODING_ERROR_ASSERT(Store->Size == 0);
+        consolidatedState = nullptr;
+
+        // Compare the heap used by the previous layout (a reference to a versioned item for every key) with the packed layout
+        LONG64 unpackedBytesPerKey = 0;
+        LONG64 packedBytesPerKey = 0;
+
+        LongComparer::SPtr keyComparerSPtr = nullptr;
+        NTSTATUS status = LongComparer::Create(GetAllocator(), keyComparerSPtr);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+        {
+            LONG64 heapBytesBefore = GetAllocatedHeapBytes();
+
+            KSharedPtr<PartitionedSortedList<LONG64, KSharedPtr<VersionedItem<KBuffer::SPtr>>>> unpackedSPtr = nullptr;
+            status = PartitionedSortedList<LONG64, KSharedPtr<VersionedItem<KBuffer::SPtr>>>::Create(*keyComparerSPtr, GetAllocator(), unpackedSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            for (LONG64 key = 0; key < count; key++)
+            {
+                KSharedPtr<VersionedItem<KBuffer::SPtr>> itemSPtr = CreateCheckpointedItem(key);
+                unpackedSPtr->Add(key, itemSPtr);
+            }
+
+            unpackedBytesPerKey = (GetAllocatedHeapBytes() - heapBytesBefore) / count;
+        }
+
+        {
+            LONG64 heapBytesBefore = GetAllocatedHeapBytes();
+
+            ConsolidatedStoreComponent<LONG64, KBuffer::SPtr>::SPtr packedSPtr = nullptr;
+            status = ConsolidatedStoreComponent<LONG64, KBuffer::SPtr>::Create(*keyComparerSPtr, GetAllocator(), packedSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            for (LONG64 key = 0; key < count; key++)
+            {
+                packedSPtr->Add(key, *CreateCheckpointedItem(key));
+            }
+
+            packedBytesPerKey = (GetAllocatedHeapBytes() - heapBytesBefore) / count;
+        }
+
+        Trace.WriteInfo(
+            "Perf",
+            "Consolidated index of {0} keys: {1} heap bytes per key packed, {2} heap bytes per key unpacked, {3} heap bytes per key materialized after recovery",
+            count,
+            packedBytesPerKey,
+            unpackedBytesPerKey,
+            materializedBytesPerKey);
+
+        CODING_ERROR_ASSERT(packedBytesPerKey < unpackedBytesPerKey);
+
+        // Reading a key through the store materializes the entry and loads the value
+        SyncAwait(VerifyKeyExistsAsync(*Store, 7, nullptr, value, SingleElementBufferEquals));
+        CODING_ERROR_ASSERT(Store->Size == GetSerializedSize(*value));
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
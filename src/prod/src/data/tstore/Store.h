@@ -32,9 +32,11 @@ namespace Data
             , public IStoreCopyProvider
             , public IStore<TKey, TValue>
             , public IStateProviderInfo
+            , public TxnReplicator::IBatchedApplyStateProvider
         {
             K_FORCE_SHARED_WITH_INHERITANCE(Store)
                 K_SHARED_INTERFACE_IMP(IStateProvider2)
+                K_SHARED_INTERFACE_IMP(IBatchedApplyStateProvider)
                 K_SHARED_INTERFACE_IMP(IConsolidationProvider)
                 K_SHARED_INTERFACE_IMP(IStoreCopyProvider)
                 K_SHARED_INTERFACE_IMP(IStore)
@@ -277,6 +279,20 @@ namespace Data
                 enableSweep_ = enable;
             }
 
+            //
+            // When set, the consolidated keys are not kept in memory: point reads use a sparse index and bloom filters
+            // over the key checkpoint files instead. Must be set before the store is recovered.
+            //
+            __declspec(property(get = get_EnableDiskResidentKeys, put = set_EnableDiskResidentKeys)) bool EnableDiskResidentKeys;
+            bool get_EnableDiskResidentKeys() const override
+            {
+                return enableDiskResidentKeys_;
+            }
+            void set_EnableDiskResidentKeys(__in bool enable)
+            {
+                enableDiskResidentKeys_ = enable;
+            }
+
             __declspec(property(get = get_SweepTask, put = set_SweepTask)) ktl::AwaitableCompletionSource<bool>::SPtr SweepTaskSourceSPtr;
             ktl::AwaitableCompletionSource<bool>::SPtr get_SweepTask()
             {
@@ -453,7 +469,7 @@ namespace Data
                         timeout);
 
                     // CanKeyBeAdded check.
-                    if (!CanKeyBeAdded(*storeTransactionSPtr, func_, key))
+                    if (!(co_await CanKeyBeAddedAsync(*storeTransactionSPtr, func_, key)))
                     {
                         StoreEventSource::Events->StoreAddAsyncError(
                             traceComponent_->PartitionId, traceComponent_->TraceTag,
@@ -554,7 +570,7 @@ namespace Data
                         timeout);
 
                     LONG64 currentVersion = Constants::InvalidLsn;
-                    if (!CanKeyBeUpdatedOrDeleted(*storeTransactionSPtr, conditionalVersion, key, currentVersion))
+                    if (!(co_await CanKeyBeUpdatedOrDeletedAsync(*storeTransactionSPtr, conditionalVersion, key, currentVersion)))
                     {
                         bool isVersionMismatch = conditionalVersion > -1 && currentVersion != conditionalVersion;
                         if (isVersionMismatch)
@@ -662,7 +678,7 @@ namespace Data
                         timeout);
 
                     LONG64 currentVersion = Constants::InvalidLsn;
-                    if (!CanKeyBeUpdatedOrDeleted(*storeTransactionSPtr, conditionalVersion, key, currentVersion))
+                    if (!(co_await CanKeyBeUpdatedOrDeletedAsync(*storeTransactionSPtr, conditionalVersion, key, currentVersion)))
                     {
                         bool isVersionMismatch = conditionalVersion > -1 && conditionalVersion != currentVersion;
                         if (isVersionMismatch)
@@ -739,7 +755,30 @@ namespace Data
                 __in ktl::CancellationToken const & cancellationToken) override
             {
                 ApiEntry();
+                co_await BackupCheckpointInternalAsync(backupDirectory, CompressionCodec::None, 1, cancellationToken);
+            }
 
+            ktl::Awaitable<void> BackupCompressedCheckpointAsync(
+                __in KString const & backupDirectory,
+                __in CompressionCodec::Enum codec,
+                __in ULONG32 maxDegreeOfParallelism,
+                __in ktl::CancellationToken const & cancellationToken) override
+            {
+                ApiEntry();
+                co_await BackupCheckpointInternalAsync(backupDirectory, codec, maxDegreeOfParallelism, cancellationToken);
+            }
+
+            //
+            // Copies the metadata table and every referenced checkpoint file to the backup directory.
+            // With a compression codec the key and value files of a table are compressed concurrently,
+            // and each of them is compressed maxDegreeOfParallelism blocks at a time.
+            //
+            ktl::Awaitable<void> BackupCheckpointInternalAsync(
+                __in KString const & backupDirectory,
+                __in CompressionCodec::Enum codec,
+                __in ULONG32 maxDegreeOfParallelism,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
                 KString & backupDirectoryCast = const_cast<KString&>(backupDirectory);
                 KString::SPtr backupDirectorySPtr = &backupDirectoryCast;
                 SharedException::CSPtr exceptionSPtr = nullptr;
@@ -801,12 +840,6 @@ namespace Data
                             Data::Utilities::ToStringLiteral(KStringView(fullKeyCheckpointFileName.c_str())),
                             Data::Utilities::ToStringLiteral(KStringView(backupKeyFileName.c_str())));
 
-                        fileCopy = Common::File::Copy(fullKeyCheckpointFileName, backupKeyFileName, false);
-                        if (fileCopy.IsSuccess() == false)
-                        {
-                            throw ktl::Exception(fileCopy.ToHResult());
-                        }
-
                         // Copy value file.
                         KString::SPtr valueFileNameSPtr = nullptr;
                         status = KString::Create(valueFileNameSPtr, this->GetThisAllocator(), *fileMetadataSPtr->FileName);
@@ -824,12 +857,16 @@ namespace Data
                             Data::Utilities::ToStringLiteral(KStringView(fullValueCheckpointFileName.c_str())),
                             Data::Utilities::ToStringLiteral(KStringView(backupValueFileName.c_str())));
 
+                        KArray<ktl::Awaitable<void>> tasks(this->GetThisAllocator());
+                        Diagnostics::Validate(tasks.Status());
 
-                        fileCopy = Common::File::Copy(fullValueCheckpointFileName, backupValueFileName, false);
-                        if (fileCopy.IsSuccess() == false)
-                        {
-                            throw ktl::Exception(fileCopy.ToHResult());
-                        }
+                        status = tasks.Append(BackupFileAsync(fullKeyCheckpointFileName, backupKeyFileName, codec, maxDegreeOfParallelism, cancellationToken));
+                        Diagnostics::Validate(status);
+
+                        status = tasks.Append(BackupFileAsync(fullValueCheckpointFileName, backupValueFileName, codec, maxDegreeOfParallelism, cancellationToken));
+                        Diagnostics::Validate(status);
+
+                        co_await TaskUtilities<void>::WhenAll(tasks);
                     }
                 }
                 catch (ktl::Exception const & e)
@@ -914,12 +951,12 @@ namespace Data
                         auto keyFile = Common::Path::Combine(backupDirectorySPtr->operator LPCWSTR(), keyFileNameSPtr->operator LPCWSTR());
                         auto valueFile = Common::Path::Combine(backupDirectorySPtr->operator LPCWSTR(), valueFileNameSPtr->operator LPCWSTR());
 
-                        if (!Common::File::Exists(keyFile))
+                        if (!BackupFileExists(keyFile))
                         {
                             throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
                         }
 
-                        if (!Common::File::Exists(valueFile))
+                        if (!BackupFileExists(valueFile))
                         {
                             throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
                         }
@@ -973,11 +1010,7 @@ namespace Data
                             Data::Utilities::ToStringLiteral(KStringView(backupKeyFileName.c_str())),
                             Data::Utilities::ToStringLiteral(KStringView(keyFileName.c_str())));
 
-                        fileCopy = Common::File::Copy(backupKeyFileName, keyFileName, true);
-                        if (fileCopy.IsSuccess() == false)
-                        {
-                            throw ktl::Exception(fileCopy.ToHResult());
-                        }
+                        co_await RestoreFileAsync(backupKeyFileName, keyFileName, cancellationToken);
 
                         StoreEventSource::Events->StoreRestoreCheckpointAsyncFile(
                             traceComponent_->PartitionId, traceComponent_->TraceTag,
@@ -985,11 +1018,7 @@ namespace Data
                             Data::Utilities::ToStringLiteral(KStringView(backupValueFileName.c_str())),
                             Data::Utilities::ToStringLiteral(KStringView(valueFileName.c_str())));
 
-                        fileCopy = Common::File::Copy(backupValueFileName, valueFileName, true);
-                        if (fileCopy.IsSuccess() == false)
-                        {
-                            throw ktl::Exception(fileCopy.ToHResult());
-                        }
+                        co_await RestoreFileAsync(backupValueFileName, valueFileName, cancellationToken);
                     }
                 }
                 catch (ktl::Exception const & e)
@@ -1015,6 +1044,81 @@ namespace Data
                     L"completed");
             }
 
+            ktl::Awaitable<void> BackupFileAsync(
+                __in std::wstring const & sourceFileName,
+                __in std::wstring const & backupFileName,
+                __in CompressionCodec::Enum codec,
+                __in ULONG32 maxDegreeOfParallelism,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
+                if (codec == CompressionCodec::None)
+                {
+                    auto fileCopy = Common::File::Copy(sourceFileName, backupFileName, false);
+                    if (fileCopy.IsSuccess() == false)
+                    {
+                        throw ktl::Exception(fileCopy.ToHResult());
+                    }
+
+                    co_return;
+                }
+
+                KString::SPtr sourcePathSPtr = KPath::CreatePath(KStringView(sourceFileName.c_str()), this->GetThisAllocator());
+                KString::SPtr backupPathSPtr = GetCompressedBackupFileName(backupFileName);
+
+                co_await CompressedFile::CompressAsync(
+                    *sourcePathSPtr,
+                    *backupPathSPtr,
+                    codec,
+                    maxDegreeOfParallelism,
+                    this->GetThisAllocator(),
+                    cancellationToken);
+            }
+
+            //
+            // A checkpoint file is backed up either as is or compressed, in which case it has the compressed file extension.
+            //
+            KString::SPtr GetCompressedBackupFileName(__in std::wstring const & backupFileName)
+            {
+                KString::SPtr resultSPtr = KPath::CreatePath(KStringView(backupFileName.c_str()), this->GetThisAllocator());
+                BOOLEAN concatSuccess = resultSPtr->Concat(CompressedFile::FileExtension);
+                STORE_ASSERT(concatSuccess == TRUE, "Should have concatenated");
+
+                return resultSPtr;
+            }
+
+            bool BackupFileExists(__in std::wstring const & backupFileName)
+            {
+                return Common::File::Exists(backupFileName) ||
+                    Common::File::Exists(GetCompressedBackupFileName(backupFileName)->operator LPCWSTR());
+            }
+
+            ktl::Awaitable<void> RestoreFileAsync(
+                __in std::wstring const & backupFileName,
+                __in std::wstring const & fileName,
+                __in ktl::CancellationToken const & cancellationToken)
+            {
+                KString::SPtr backupPathSPtr = GetCompressedBackupFileName(backupFileName);
+                if (!Common::File::Exists(backupPathSPtr->operator LPCWSTR()))
+                {
+                    auto fileCopy = Common::File::Copy(backupFileName, fileName, true);
+                    if (fileCopy.IsSuccess() == false)
+                    {
+                        throw ktl::Exception(fileCopy.ToHResult());
+                    }
+
+                    co_return;
+                }
+
+                KString::SPtr pathSPtr = KPath::CreatePath(KStringView(fileName.c_str()), this->GetThisAllocator());
+
+                co_await CompressedFile::DecompressAsync(
+                    *backupPathSPtr,
+                    *pathSPtr,
+                    Constants::RestoreDegreeOfParallelism,
+                    this->GetThisAllocator(),
+                    cancellationToken);
+            }
+
             ktl::Awaitable<KSharedPtr<IEnumerator<TKey>>> CreateKeyEnumeratorAsync(__in IStoreTransaction<TKey, TValue> & storeTransaction) override
             {
                 ApiEntry();
@@ -1025,7 +1129,7 @@ namespace Data
                 }
 
                 TKey defaultKey;
-                return CreateKeyEnumeratorAsync(storeTransaction, defaultKey, false, defaultKey, false);
+                return CreateKeyEnumeratorAsync(storeTransaction, defaultKey, false, defaultKey, false, enableDiskResidentKeys_);
             }
 
             ktl::Awaitable<KSharedPtr<IEnumerator<TKey>>> CreateKeyEnumeratorAsync(__in IStoreTransaction<TKey, TValue> & storeTransaction, TKey firstKey) override
@@ -1038,7 +1142,7 @@ namespace Data
                 }
 
                 TKey defaultKey;
-                return CreateKeyEnumeratorAsync(storeTransaction, firstKey, true, defaultKey, false);
+                return CreateKeyEnumeratorAsync(storeTransaction, firstKey, true, defaultKey, false, enableDiskResidentKeys_);
             }
 
             ktl::Awaitable<KSharedPtr<IEnumerator<TKey>>> CreateKeyEnumeratorAsync(__in IStoreTransaction<TKey, TValue> & storeTransaction, TKey firstKey, TKey lastKey) override
@@ -1057,7 +1161,7 @@ namespace Data
 
                 try
                 {
-                    return CreateKeyEnumeratorAsync(storeTransaction, firstKey, true, lastKey, true);
+                    return CreateKeyEnumeratorAsync(storeTransaction, firstKey, true, lastKey, true, enableDiskResidentKeys_);
                 }
                 catch (ktl::Exception const & e)
                 {
@@ -1993,6 +2097,211 @@ namespace Data
                 }
             }
 
+            //
+            // Applies the operations of one transaction on a secondary with a single lookup of the store transaction,
+            // differential state and replicator state. All operations are added to the differential state first and
+            // the notifications are fired afterwards, in operation order. Other apply contexts go through ApplyAsync.
+            //
+            ktl::Awaitable<void> ApplyBatchAsync(
+                __in TxnReplicator::TransactionBase const & replicatorTransaction,
+                __in TxnReplicator::ApplyContext::Enum applyContext,
+                __in KArray<LONG64> const & logicalSequenceNumbers,
+                __in KArray<OperationData::CSPtr> const & metadataArray,
+                __in KArray<OperationData::CSPtr> const & dataArray,
+                __inout KArray<TxnReplicator::OperationContext::CSPtr> & results) override
+            {
+                ApiEntry();
+
+                try
+                {
+                    STORE_ASSERT(wasCopyAborted_ == false, "Copy was aborted. Cannot Apply");
+
+                    ULONG32 count = metadataArray.Count();
+                    STORE_ASSERT(
+                        logicalSequenceNumbers.Count() == count && dataArray.Count() == count,
+                        "Batch size mismatch. lsns={1} metadata={2} data={3}",
+                        logicalSequenceNumbers.Count(),
+                        count,
+                        dataArray.Count());
+
+                    NTSTATUS status = STATUS_SUCCESS;
+
+                    TxnReplicator::ApplyContext::Enum roleType = static_cast<TxnReplicator::ApplyContext::Enum>(applyContext & TxnReplicator::ApplyContext::ROLE_MASK);
+                    TxnReplicator::ApplyContext::Enum operationType =
+                        static_cast<TxnReplicator::ApplyContext::Enum>(applyContext & TxnReplicator::ApplyContext::OPERATION_MASK);
+
+                    if (roleType != TxnReplicator::ApplyContext::SECONDARY || operationType != TxnReplicator::ApplyContext::REDO)
+                    {
+                        for (ULONG32 i = 0; i < count; i++)
+                        {
+                            auto operationContextCSPtr = co_await ApplyAsync(
+                                logicalSequenceNumbers[i],
+                                replicatorTransaction,
+                                applyContext,
+                                metadataArray[i].RawPtr(),
+                                dataArray[i].RawPtr());
+
+                            status = results.Append(operationContextCSPtr);
+                            Diagnostics::Validate(status);
+                        }
+
+                        co_return;
+                    }
+
+                    LONG64 commitSequenceNumber = replicatorTransaction.CommitSequenceNumber;
+
+                    // Idempotency check. All operations of the batch share the commit sequence number.
+                    auto cachedMetadataTable = currentMetadataTableSPtr_.Get();
+                    STORE_ASSERT(cachedMetadataTable != nullptr, "cachedMetadataTable != nullptr");
+
+                    if (IsDuplicateApply(commitSequenceNumber, *cachedMetadataTable, roleType, operationType))
+                    {
+                        for (ULONG32 i = 0; i < count; i++)
+                        {
+                            status = results.Append(nullptr);
+                            Diagnostics::Validate(status);
+                        }
+
+                        co_return;
+                    }
+
+                    // Last performed checkpoint lsn is guaranteed to be stable
+                    STORE_ASSERT(lastPerformCheckpointLSN_ < commitSequenceNumber, "Last performed checkpoint LSN must be stable: lastPerformCheckpointLSN {1} < sequenceNumber {2}", lastPerformCheckpointLSN_, commitSequenceNumber);
+
+                    KSharedPtr<TxnReplicator::ITransactionalReplicator> replicatorSPtr = GetReplicator();
+                    bool isIdempotent = !replicatorSPtr->IsReadable || cachedMetadataTable->CheckpointLSN == -1;
+
+                    TxnReplicator::TransactionBase& transaction = const_cast<TxnReplicator::TransactionBase&>(replicatorTransaction);
+                    KSharedPtr<IStoreTransaction<TKey, TValue>> istoreTransactionSPtr = nullptr;
+                    bool firstCreated = !CreateOrFindTransaction(transaction, istoreTransactionSPtr);
+                    KSharedPtr<StoreTransaction<TKey, TValue>> storeTransactionSPtr = static_cast<StoreTransaction<TKey, TValue>*>(istoreTransactionSPtr.RawPtr());
+                    STORE_ASSERT(storeTransactionSPtr != nullptr, "storeTransactionSPtr != nullptr");
+
+                    auto cachedDifferentialStoreComponentSPtr = differentialStoreComponentSPtr_.Get();
+                    STORE_ASSERT(cachedDifferentialStoreComponentSPtr != nullptr, "cachedDifferentialStoreComponentSPtr != nullptr");
+
+                    bool hasChangeHandler = dictionaryChangeHandlerSPtr_.Get() != nullptr;
+
+                    KArray<SecondaryApplyNotification> notifications(this->GetThisAllocator(), hasChangeHandler ? count : 0);
+                    Diagnostics::Validate(notifications.Status());
+
+                    for (ULONG32 i = 0; i < count; i++)
+                    {
+                        MetadataOperationData::CSPtr metadataOperationDataCSPtr = MetadataOperationData::Deserialize(Constants::SerializedVersion, this->GetThisAllocator(), metadataArray[i]);
+                        auto operationRedoUndo = RedoUndoOperationData::Deserialize(*dataArray[i], this->GetThisAllocator());
+
+                        auto modificationType = metadataOperationDataCSPtr->ModificationType;
+                        STORE_ASSERT(
+                            modificationType == StoreModificationType::Enum::Add ||
+                            modificationType == StoreModificationType::Enum::Remove ||
+                            modificationType == StoreModificationType::Enum::Update,
+                            "unexpected store operation type {1}", static_cast<ULONG32>(modificationType));
+                        STORE_ASSERT(metadataOperationDataCSPtr->KeyBytes != nullptr, "unexpected key bytes");
+
+                        auto keyLockResourceNameHash = GetHash(*metadataOperationDataCSPtr->KeyBytes);
+
+                        StoreEventSource::Events->StoreApplyOnSecondaryAsync(
+                            traceComponent_->PartitionId, traceComponent_->TraceTag,
+                            firstCreated && i == 0 ? L"starting" : L"completed",
+                            commitSequenceNumber,
+                            storeTransactionSPtr->Id,
+                            keyLockResourceNameHash,
+                            static_cast<ULONG32>(modificationType));
+
+                        TKey key;
+                        TValue value = TValue();
+                        try
+                        {
+                            key = GetKeyFromBytes(*metadataOperationDataCSPtr->KeyBytes);
+                            if (modificationType != StoreModificationType::Enum::Remove)
+                            {
+                                value = GetValueFromBytes(*operationRedoUndo->ValueOperationData);
+                            }
+                        }
+                        catch (ktl::Exception&)
+                        {
+                            switch (modificationType)
+                            {
+                            case StoreModificationType::Enum::Add:
+                                StoreEventSource::Events->StoreOnApplyAddError(
+                                    traceComponent_->PartitionId, traceComponent_->TraceTag,
+                                    storeTransactionSPtr->Id,
+                                    L"deserialization");
+                                break;
+                            case StoreModificationType::Enum::Update:
+                                StoreEventSource::Events->StoreOnApplyUpdateError(
+                                    traceComponent_->PartitionId, traceComponent_->TraceTag,
+                                    storeTransactionSPtr->Id,
+                                    L"deserialization");
+                                break;
+                            default:
+                                StoreEventSource::Events->StoreOnApplyRemoveError(
+                                    traceComponent_->PartitionId, traceComponent_->TraceTag,
+                                    storeTransactionSPtr->Id,
+                                    L"deserialization");
+                                break;
+                            }
+
+                            throw;
+                        }
+
+                        bool isApplied = co_await ApplyToDifferentialStateAsync(
+                            commitSequenceNumber,
+                            *storeTransactionSPtr,
+                            *cachedDifferentialStoreComponentSPtr,
+                            modificationType,
+                            key,
+                            value,
+                            operationRedoUndo->ValueOperationData,
+                            keyLockResourceNameHash,
+                            isIdempotent);
+
+                        if (isApplied && hasChangeHandler)
+                        {
+                            SecondaryApplyNotification notification;
+                            notification.ModificationType = modificationType;
+                            notification.Key = key;
+                            notification.Value = value;
+
+                            status = notifications.Append(notification);
+                            Diagnostics::Validate(status);
+                        }
+
+                        TxnReplicator::OperationContext::CSPtr operationContextCSPtr = nullptr;
+                        if (firstCreated && i == 0)
+                        {
+                            operationContextCSPtr = storeTransactionSPtr.RawPtr();
+                        }
+
+                        status = results.Append(operationContextCSPtr);
+                        Diagnostics::Validate(status);
+                    }
+
+                    for (ULONG32 i = 0; i < notifications.Count(); i++)
+                    {
+                        SecondaryApplyNotification const & notification = notifications[i];
+
+                        switch (notification.ModificationType)
+                        {
+                        case StoreModificationType::Enum::Add:
+                            co_await FireItemAddedNotificationOnSecondaryAsync(*storeTransactionSPtr->ReplicatorTransaction, notification.Key, notification.Value, commitSequenceNumber);
+                            break;
+                        case StoreModificationType::Enum::Update:
+                            co_await FireItemUpdatedNotificationOnSecondaryAsync(*storeTransactionSPtr->ReplicatorTransaction, notification.Key, notification.Value, commitSequenceNumber);
+                            break;
+                        case StoreModificationType::Enum::Remove:
+                            co_await FireItemRemovedNotificationOnSecondaryAsync(*storeTransactionSPtr->ReplicatorTransaction, notification.Key, commitSequenceNumber);
+                            break;
+                        }
+                    }
+                }
+                catch (ktl::Exception const & e)
+                {
+                    TraceException(L"ApplyBatchAsync", e);
+                    throw;
+                }
+            }
+
             void Unlock(__in TxnReplicator::OperationContext const & operationContext) override
             {
                 ApiEntry();
@@ -2629,14 +2938,7 @@ namespace Data
                 // Note: Retry needs to be done at this layer since every time a load fails due to AddRef failure, the versioned item needs to be re-read
                 while (true)
                 {
-                    if (visibilitySequenceNumber == Constants::InvalidLsn)
-                    {
-                        versionedItem = consolidationManagerSPtr_->Read(key);
-                    }
-                    else
-                    {
-                        versionedItem = consolidationManagerSPtr_->Read(key, visibilitySequenceNumber);
-                    }
+                    versionedItem = co_await consolidationManagerSPtr_->ReadAsync(key, visibilitySequenceNumber);
 
                     if (versionedItem == nullptr || readMode == ReadMode::Off || versionedItem->GetRecordKind() == RecordKind::DeletedVersion)
                     {
@@ -2667,8 +2969,14 @@ namespace Data
                         if (hasValue)
                         {
                             versionedItem->SetInUse(true);
-                            // If there are multiple loads in progress there could be some overcounting here - not worth locking for it.
-                            consolidationManagerSPtr_->AddToMemorySize(versionedItem->GetValueSize());
+
+                            // Items read from disk are not kept by the consolidated state when the keys are disk resident.
+                            if (!enableDiskResidentKeys_)
+                            {
+                                // If there are multiple loads in progress there could be some overcounting here - not worth locking for it.
+                                consolidationManagerSPtr_->AddToMemorySize(versionedItem->GetValueSize());
+                            }
+
                             break;
                         }
                     }
@@ -3471,7 +3779,7 @@ namespace Data
                     KSharedPtr<VersionedItem<TValue>> currentVersionedItem = cachedDifferentialState->Read(key);
                     if (currentVersionedItem == nullptr)
                     {
-                        currentVersionedItem = consolidationManagerSPtr_->Read(key);
+                        currentVersionedItem = co_await consolidationManagerSPtr_->ReadAsync(key);
                     }
 
                     KSharedPtr<StoreTransaction<TKey, TValue>> rwtxSPtr = &rwtx;
@@ -3551,41 +3859,20 @@ namespace Data
                   auto cachedDifferentialStoreComponentSPtr = differentialStoreComponentSPtr_.Get();
                   STORE_ASSERT(cachedDifferentialStoreComponentSPtr != nullptr, "cachedDifferentialStoreComponentSPtr != nullptr");
 
-                  if (!isIdempotent)
-                  {
-                     KSharedPtr<VersionedItem<TValue>> currentVersionedItemSPtr = cachedDifferentialStoreComponentSPtr->Read(key);
-                     if (currentVersionedItemSPtr == nullptr)
-                     {
-                        currentVersionedItemSPtr = consolidationManagerSPtr_->Read(key);
-                     }
-
-                     STORE_ASSERT(currentVersionedItemSPtr == nullptr || currentVersionedItemSPtr->GetRecordKind() == RecordKind::DeletedVersion,
-                        "Cannot add an item that already exists. lsn={1} txn={2} key={3}", sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
-                  }
-
-                  if (!isIdempotent || (isIdempotent && ShouldValueBeAddedToDifferentialState(key, sequenceNumber)))
+                  bool isApplied = co_await ApplyToDifferentialStateAsync(
+                     sequenceNumber,
+                     storeTransaction,
+                     *cachedDifferentialStoreComponentSPtr,
+                     StoreModificationType::Enum::Add,
+                     key,
+                     value,
+                     data.ValueOperationData,
+                     keyLockResourceNameHash,
+                     isIdempotent);
+
+                  if (isApplied)
                   {
-                     // Add the change to the store transaction write-set.
-                     KSharedPtr<InsertedVersionedItem<TValue>> insertedVersionedItemSPtr = nullptr;
-                     NTSTATUS status = InsertedVersionedItem<TValue>::Create(this->GetThisAllocator(), insertedVersionedItemSPtr);
-                     Diagnostics::Validate(status);
-
-                     insertedVersionedItemSPtr->InitializeOnApply(sequenceNumber, value);
-                     insertedVersionedItemSPtr->SetValueSize(GetValueSize(data.ValueOperationData));
-                     cachedDifferentialStoreComponentSPtr->Add(key, *insertedVersionedItemSPtr, *consolidationManagerSPtr_);
-
-                     // Update count, notifications and trace
-                     LONG64 newCount = IncrementCount(storeTransaction.ReplicatorTransaction->TransactionId, storeTransaction.ReplicatorTransaction->CommitSequenceNumber);
-                     UNREFERENCED_PARAMETER(newCount);
-
                      co_await FireItemAddedNotificationOnSecondaryAsync(*storeTransaction.ReplicatorTransaction, key, value, sequenceNumber);
-
-                     //StoreEventSource::Events->StoreOnApplyAdd(
-                     //    traceComponent_->PartitionId, traceComponent_->TraceTag,
-                     //    sequenceNumber,
-                     //    storeTransaction.Id,
-                     //    keyLockResourceNameHash,
-                     //    newCount);
                   }
                }
                catch (ktl::Exception& e)
@@ -3632,41 +3919,20 @@ namespace Data
                     auto cachedDifferentialStoreComponentSPtr = differentialStoreComponentSPtr_.Get();
                     STORE_ASSERT(cachedDifferentialStoreComponentSPtr != nullptr, "cachedDifferentialStoreComponentSPtr != nullptr");
 
-                    if (!isIdempotent)
-                    {
-                        KSharedPtr<VersionedItem<TValue>> currentVersionedItemSPtr = cachedDifferentialStoreComponentSPtr->Read(key);
-                        if (currentVersionedItemSPtr == nullptr)
-                        {
-                            currentVersionedItemSPtr = consolidationManagerSPtr_->Read(key);
-                        }
-
-                        STORE_ASSERT(
-                            currentVersionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion, 
-                            "Cannot update an item that does not exist (deleteVersion). lsn={1} txn={2} key={3}", 
-                            sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
-                    }
+                    bool isApplied = co_await ApplyToDifferentialStateAsync(
+                        sequenceNumber,
+                        storeTransaction,
+                        *cachedDifferentialStoreComponentSPtr,
+                        StoreModificationType::Enum::Update,
+                        key,
+                        value,
+                        data.ValueOperationData,
+                        keyLockResourceNameHash,
+                        isIdempotent);
 
-                    if (!isIdempotent || (isIdempotent && ShouldValueBeAddedToDifferentialState(key, sequenceNumber)))
+                    if (isApplied)
                     {
-                        // Add the change to the store transaction write-set.
-                        KSharedPtr<UpdatedVersionedItem<TValue>> updatedVersionedItemSPtr = nullptr;
-                        NTSTATUS status = UpdatedVersionedItem<TValue>::Create(this->GetThisAllocator(), updatedVersionedItemSPtr);
-                        Diagnostics::Validate(status);
-
-                        updatedVersionedItemSPtr->InitializeOnApply(sequenceNumber, value);
-                        updatedVersionedItemSPtr->SetValueSize(GetValueSize(data.ValueOperationData));
-                        cachedDifferentialStoreComponentSPtr->Add(key, *updatedVersionedItemSPtr, *consolidationManagerSPtr_);
-
-                        // Update count, notifications and trace
-
-                        KSharedPtr< const StoreTransaction<TKey, TValue>> storeTransactionSPtr = &storeTransaction;
                         co_await FireItemUpdatedNotificationOnSecondaryAsync(*storeTransaction.ReplicatorTransaction, key, value, sequenceNumber);
-
-                        //StoreEventSource::Events->StoreOnApplyUpdate(
-                        //    traceComponent_->PartitionId, traceComponent_->TraceTag,
-                        //    sequenceNumber,
-                        //    storeTransactionSPtr->Id,
-                        //    keyLockResourceNameHash);
                     }
                 }
                 catch (ktl::Exception& e)
@@ -3712,54 +3978,132 @@ namespace Data
                     auto cachedDifferentialStoreComponentSPtr = differentialStoreComponentSPtr_.Get();
                     STORE_ASSERT(cachedDifferentialStoreComponentSPtr != nullptr, "cachedDifferentialStoreComponentSPtr != nullptr");
 
-                    if (!isIdempotent)
+                    bool isApplied = co_await ApplyToDifferentialStateAsync(
+                        sequenceNumber,
+                        storeTransaction,
+                        *cachedDifferentialStoreComponentSPtr,
+                        StoreModificationType::Enum::Remove,
+                        key,
+                        TValue(),
+                        nullptr,
+                        keyLockResourceNameHash,
+                        isIdempotent);
+
+                    if (isApplied)
                     {
-                        KSharedPtr<VersionedItem<TValue>> currentVersionedItemSPtr = cachedDifferentialStoreComponentSPtr->Read(key);
-                        if (currentVersionedItemSPtr == nullptr)
-                        {
-                            currentVersionedItemSPtr = consolidationManagerSPtr_->Read(key);
-                        }
+                        co_await FireItemRemovedNotificationOnSecondaryAsync(*storeTransaction.ReplicatorTransaction, key, sequenceNumber);
+                    }
+                }
+                catch (ktl::Exception& e)
+                {
+                    TraceException(L"OnApplyRemove", e);
+                    STORE_ASSERT(
+                        e.GetStatus() == SF_STATUS_OBJECT_CLOSED ||
+                        e.GetStatus() == SF_STATUS_TIMEOUT,
+                        "Unexpected exception in OnApplyRemove");
+
+                    throw;
+                }
+            }
+
+            //
+            // Adds the versioned item of an add, update or remove that is applied on a secondary or during recovery to the
+            // differential state. Returns false if the operation was skipped because it is a duplicate, in which case no
+            // notification should be fired for it.
+            //
+            ktl::Awaitable<bool> ApplyToDifferentialStateAsync(
+                __in LONG64 sequenceNumber,
+                __in StoreTransaction<TKey, TValue> const & storeTransaction,
+                __in DifferentialStoreComponent<TKey, TValue> & differentialStoreComponent,
+                __in StoreModificationType::Enum modificationType,
+                __in TKey const & key,
+                __in TValue const & value,
+                __in_opt OperationData::SPtr const & valueOperationData,
+                __in ULONG64 keyLockResourceNameHash,
+                __in bool isIdempotent)
+            {
+                TKey snapKey = key;
+
+                if (!isIdempotent)
+                {
+                    KSharedPtr<VersionedItem<TValue>> currentVersionedItemSPtr = differentialStoreComponent.Read(key);
+                    if (currentVersionedItemSPtr == nullptr)
+                    {
+                        currentVersionedItemSPtr = co_await consolidationManagerSPtr_->ReadAsync(snapKey);
+                    }
 
+                    switch (modificationType)
+                    {
+                    case StoreModificationType::Enum::Add:
+                        STORE_ASSERT(currentVersionedItemSPtr == nullptr || currentVersionedItemSPtr->GetRecordKind() == RecordKind::DeletedVersion,
+                            "Cannot add an item that already exists. lsn={1} txn={2} key={3}", sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
+                        break;
+                    case StoreModificationType::Enum::Update:
+                        STORE_ASSERT(
+                            currentVersionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion,
+                            "Cannot update an item that does not exist (deleteVersion). lsn={1} txn={2} key={3}",
+                            sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
+                        break;
+                    case StoreModificationType::Enum::Remove:
                         STORE_ASSERT(currentVersionedItemSPtr != nullptr, "Cannot remove an item that does not exist (null). lsn={1} txn={2} key={3}", sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
                         STORE_ASSERT(currentVersionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion,
                             "Cannot remove an item that already exist (deleted version). lsn={1} txn={2} key={3}",
                             sequenceNumber, storeTransaction.Id, keyLockResourceNameHash);
+                        break;
                     }
+                }
 
-                    if (!isIdempotent || (isIdempotent && ShouldValueBeAddedToDifferentialState(key, sequenceNumber)))
-                    {
-                        // Add the change to the store transaction write-set.
-                        KSharedPtr<DeletedVersionedItem<TValue>> deletedVersionedItemSPtr = nullptr;
-                        NTSTATUS status = DeletedVersionedItem<TValue>::Create(this->GetThisAllocator(), deletedVersionedItemSPtr);
-                        Diagnostics::Validate(status);
+                if (isIdempotent && !(co_await ShouldValueBeAddedToDifferentialStateAsync(snapKey, sequenceNumber)))
+                {
+                    co_return false;
+                }
 
-                        deletedVersionedItemSPtr->InitializeOnApply(sequenceNumber);
-                        cachedDifferentialStoreComponentSPtr->Add(key, *deletedVersionedItemSPtr, *consolidationManagerSPtr_);
+                NTSTATUS status = STATUS_SUCCESS;
 
-                        // Update count, notifications and trace
-                        auto newCount = DecrementCount(storeTransaction.Id, sequenceNumber);
-                        UNREFERENCED_PARAMETER(newCount);
+                // Add the change to the store transaction write-set and update the count.
+                switch (modificationType)
+                {
+                case StoreModificationType::Enum::Add:
+                {
+                    KSharedPtr<InsertedVersionedItem<TValue>> insertedVersionedItemSPtr = nullptr;
+                    status = InsertedVersionedItem<TValue>::Create(this->GetThisAllocator(), insertedVersionedItemSPtr);
+                    Diagnostics::Validate(status);
 
-                        co_await FireItemRemovedNotificationOnSecondaryAsync(*storeTransaction.ReplicatorTransaction, key, sequenceNumber);
+                    insertedVersionedItemSPtr->InitializeOnApply(sequenceNumber, value);
+                    insertedVersionedItemSPtr->SetValueSize(GetValueSize(valueOperationData));
+                    differentialStoreComponent.Add(key, *insertedVersionedItemSPtr, *consolidationManagerSPtr_);
 
-                        //StoreEventSource::Events->StoreOnApplyRemove(
-                        //    traceComponent_->PartitionId, traceComponent_->TraceTag,
-                        //    sequenceNumber,
-                        //    storeTransaction.Id,
-                        //    keyLockResourceNameHash,
-                        //    newCount);
-                    }
+                    LONG64 newCount = IncrementCount(storeTransaction.ReplicatorTransaction->TransactionId, storeTransaction.ReplicatorTransaction->CommitSequenceNumber);
+                    UNREFERENCED_PARAMETER(newCount);
+                    break;
                 }
-                catch (ktl::Exception& e)
+                case StoreModificationType::Enum::Update:
                 {
-                    TraceException(L"OnApplyRemove", e);
-                    STORE_ASSERT(
-                        e.GetStatus() == SF_STATUS_OBJECT_CLOSED ||
-                        e.GetStatus() == SF_STATUS_TIMEOUT,
-                        "Unexpected exception in OnApplyRemove");
+                    KSharedPtr<UpdatedVersionedItem<TValue>> updatedVersionedItemSPtr = nullptr;
+                    status = UpdatedVersionedItem<TValue>::Create(this->GetThisAllocator(), updatedVersionedItemSPtr);
+                    Diagnostics::Validate(status);
 
-                    throw;
+                    updatedVersionedItemSPtr->InitializeOnApply(sequenceNumber, value);
+                    updatedVersionedItemSPtr->SetValueSize(GetValueSize(valueOperationData));
+                    differentialStoreComponent.Add(key, *updatedVersionedItemSPtr, *consolidationManagerSPtr_);
+                    break;
+                }
+                case StoreModificationType::Enum::Remove:
+                {
+                    KSharedPtr<DeletedVersionedItem<TValue>> deletedVersionedItemSPtr = nullptr;
+                    status = DeletedVersionedItem<TValue>::Create(this->GetThisAllocator(), deletedVersionedItemSPtr);
+                    Diagnostics::Validate(status);
+
+                    deletedVersionedItemSPtr->InitializeOnApply(sequenceNumber);
+                    differentialStoreComponent.Add(key, *deletedVersionedItemSPtr, *consolidationManagerSPtr_);
+
+                    auto newCount = DecrementCount(storeTransaction.Id, sequenceNumber);
+                    UNREFERENCED_PARAMETER(newCount);
+                    break;
+                }
                 }
+
+                co_return true;
             }
 
             bool IsDuplicateApply(
@@ -3781,10 +4125,10 @@ namespace Data
                 return false;
             }
 
-            bool CanKeyBeAdded(
+            ktl::Awaitable<bool> CanKeyBeAddedAsync(
                 __in StoreTransaction<TKey, TValue>& storeTransaction,
                 __in HashFunctionType hashFunc_,
-                __in TKey& key) const
+                __in TKey& key)
             {
                 // Check to see if this key was already added as part of this store transaction.
                 auto component = storeTransaction.GetComponent(hashFunc_);
@@ -3801,22 +4145,22 @@ namespace Data
 
                 if (versionedItem == nullptr)
                 {
-                    versionedItem = consolidationManagerSPtr_->Read(key);
+                    versionedItem = co_await consolidationManagerSPtr_->ReadAsync(key);
                 }
 
                 if (versionedItem == nullptr || versionedItem->GetRecordKind() == RecordKind::DeletedVersion)
                 {
-                    return true;
+                    co_return true;
                 }
 
-                return false;
+                co_return false;
             }
 
-            bool CanKeyBeUpdatedOrDeleted(
+            ktl::Awaitable<bool> CanKeyBeUpdatedOrDeletedAsync(
                 __in StoreTransaction<TKey, TValue>& storeTransaction,
                 __in LONG64 conditionalVersion,
                 __in TKey& key,
-                __out LONG64 & currentVersion) const // currentVersion is only set if conditionalVersion > -1
+                __out LONG64 & currentVersion) // currentVersion is only set if conditionalVersion > -1
             {
                 KSharedPtr<DifferentialStoreComponent<TKey, TValue>> componentSPtr = differentialStoreComponentSPtr_.Get();
 
@@ -3833,7 +4177,7 @@ namespace Data
 
                 if (versionedItem == nullptr)
                 {
-                    versionedItem = consolidationManagerSPtr_->Read(key);
+                    versionedItem = co_await consolidationManagerSPtr_->ReadAsync(key);
                 }
 
                 if (versionedItem != nullptr && versionedItem->GetRecordKind() != RecordKind::DeletedVersion)
@@ -3844,16 +4188,16 @@ namespace Data
                         currentVersion = versionSequenceNumber;
                         if (versionSequenceNumber == conditionalVersion)
                         {
-                            return true;
+                            co_return true;
                         }
                     }
                     else
                     {
-                        return true;
+                        co_return true;
                     }
                 }
 
-                return false;
+                co_return false;
             }
 
             ktl::Awaitable<void> AcquireKeyModificationLockAsync(
@@ -4021,19 +4365,19 @@ namespace Data
                 }
             }
 
-            bool ShouldValueBeAddedToDifferentialState(__in TKey key, __in LONG64 versionSequenceNumber)
+            ktl::Awaitable<bool> ShouldValueBeAddedToDifferentialStateAsync(__in TKey key, __in LONG64 versionSequenceNumber)
             {
                 // Check if a higher version sequence number is present in the consolidated state.
-                auto versionedItemSPtr = consolidationManagerSPtr_->Read(key);
+                auto versionedItemSPtr = co_await consolidationManagerSPtr_->ReadAsync(key);
                 if (versionedItemSPtr != nullptr)
                 {
                     if (versionedItemSPtr->GetVersionSequenceNumber() >= versionSequenceNumber)
                     {
-                        return false;
+                        co_return false;
                     }
                 }
 
-                return true;
+                co_return true;
             }
 
             ktl::Awaitable<void> CleanupAsync()
@@ -4275,6 +4619,13 @@ namespace Data
                     recoveryComponentSPtr);
                 Diagnostics::Validate(NT_SUCCESS(status));
 
+                KSharedPtr<DiskKeyIndex<TKey, TValue>> diskKeyIndexSPtr = nullptr;
+                if (enableDiskResidentKeys_)
+                {
+                    diskKeyIndexSPtr = consolidationManagerSPtr_->CreateDiskKeyIndex();
+                    recoveryComponentSPtr->DiskKeyIndexSPtr = *diskKeyIndexSPtr;
+                }
+
                 STORE_ASSERT(isClosing_ == false, "Store should not be closing during recovery");
                 co_await recoveryComponentSPtr->RecoverAsync(cancellationToken);
 
@@ -4287,6 +4638,14 @@ namespace Data
                 LONG64 oldCount = InterlockedExchange64(&count_, 0);
                 STORE_ASSERT(oldCount >= 0, "Old count {1} must not be negative", oldCount);
 
+                if (diskKeyIndexSPtr != nullptr)
+                {
+                    // Keys stay on disk, values are loaded on first read.
+                    consolidationManagerSPtr_->SetDiskKeyIndex(*diskKeyIndexSPtr);
+                    InterlockedExchange64(&count_, recoveryComponentSPtr->RecoveredKeyCount);
+                    co_return;
+                }
+
                 bool snapEnableSweep = enableSweep_;
                 KSharedPtr<KSharedArray<ktl::Awaitable<TValue>>> loadTasks = _new(STORE_TAG, this->GetThisAllocator()) KSharedArray<ktl::Awaitable<TValue>>();
                 Common::Stopwatch stopwatch;
@@ -4315,7 +4674,12 @@ namespace Data
 
                     if (shouldLoadValuesInRecovery_)
                     {
-                        ktl::Awaitable<TValue> task = row.Value->GetValueAsync(
+                        // The consolidated state packs items whose value is not in memory,
+                        // so load the value into the versioned item it hands out for the key.
+                        auto versionedItemSPtr = consolidationManagerSPtr_->Read(row.Key);
+                        STORE_ASSERT(versionedItemSPtr != nullptr, "Recovered key should be in the consolidated state");
+
+                        ktl::Awaitable<TValue> task = versionedItemSPtr->GetValueAsync(
                             *cachedCurrentMetadataTableSPtr,
                             *valueConverterSPtr_,
                             *traceComponent_,
@@ -4436,7 +4800,8 @@ namespace Data
                 __in TKey & firstKey,
                 __in bool useFirstKey,
                 __in TKey & lastKey,
-                __in bool useLastKey)
+                __in bool useLastKey,
+                __in bool includeDiskKeys)
             {
                 // Key Enumerables
                 KSharedPtr<IFilterableEnumerator<TKey>> differentialStateFilterableEnumeratorSPtr = nullptr;
@@ -4497,6 +4862,26 @@ namespace Data
                     rwtxStateEnumeratorSPtr = rwtxSPtr->GetComponent(func_)->GetSortedKeyEnumerable(useFirstKey, snapshotFirstKey, useLastKey, snapshotLastKey);
                 }
 
+                // The keys in the checkpoint files that exist at the visibility sequence number, read ahead of the enumeration
+                KSharedPtr<IEnumerator<TKey>> diskKeysEnumeratorSPtr = nullptr;
+                if (includeDiskKeys)
+                {
+                    KSharedPtr<IAsyncEnumerator<TKey>> diskKeysSPtr = co_await consolidationManagerSPtr_->CreateDiskKeyEnumeratorAsync(
+                        useFirstKey,
+                        snapshotFirstKey,
+                        useLastKey,
+                        snapshotLastKey,
+                        visibilitySequenceNumber);
+
+                    if (diskKeysSPtr != nullptr)
+                    {
+                        diskKeysEnumeratorSPtr = co_await DiskKeysReadAheadEnumerator<TKey>::CreateAsync(
+                            *diskKeysSPtr,
+                            Constants::DiskKeyReadAheadCount,
+                            this->GetThisAllocator());
+                    }
+                }
+
                 StoreEventSource::Events->StoreCreateKeyEnumeratorAsync(
                     traceComponent_->PartitionId, traceComponent_->TraceTag,
                     rwtxSPtr->Id,
@@ -4547,6 +4932,7 @@ namespace Data
                     visibilitySequenceNumber,
                     snapshotStateSPtr,
                     *orderedKeyEnumerableSPtr,
+                    diskKeysEnumeratorSPtr.RawPtr(),
                     this->GetThisAllocator(),
                     keyEnumeratorSPtr);
                 Diagnostics::Validate(status);
@@ -4565,17 +4951,40 @@ namespace Data
                 TKey snapFirstKey = firstKey;
                 TKey snapLastKey = lastKey;
 
-                KSharedPtr<IEnumerator<TKey>> keyEnumerator = co_await CreateKeyEnumeratorAsync(*storeTransactionSPtr, snapFirstKey, useFirstKey, snapLastKey, useLastKey);
+                KSharedPtr<IEnumerator<TKey>> keyEnumerator = co_await CreateKeyEnumeratorAsync(*storeTransactionSPtr, snapFirstKey, useFirstKey, snapLastKey, useLastKey, false);
+
+                // The keys that are only on disk are merged in while enumerating
+                KSharedPtr<IAsyncEnumerator<TKey>> diskKeyEnumerator = nullptr;
+                if (enableDiskResidentKeys_)
+                {
+                    diskKeyEnumerator = co_await consolidationManagerSPtr_->CreateDiskKeyEnumeratorAsync(useFirstKey, snapFirstKey, useLastKey, snapLastKey, Constants::InvalidLsn);
+                }
 
                 // Get values for each key asynchronously, while enumerating
                 KSharedPtr<IAsyncEnumerator<KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>>> enumeratorSPtr = nullptr;
-                NTSTATUS status = StoreKeyValueEnumerator<TKey, TValue>::Create(
-                    *this,
-                    *keyComparerSPtr_,
-                    *keyEnumerator,
-                    *storeTransactionSPtr,
-                    this->GetThisAllocator(),
-                    enumeratorSPtr);
+                NTSTATUS status = STATUS_SUCCESS;
+                if (diskKeyEnumerator == nullptr)
+                {
+                    status = StoreKeyValueEnumerator<TKey, TValue>::Create(
+                        *this,
+                        *keyComparerSPtr_,
+                        *keyEnumerator,
+                        *storeTransactionSPtr,
+                        this->GetThisAllocator(),
+                        enumeratorSPtr);
+                }
+                else
+                {
+                    status = StoreKeyValueEnumerator<TKey, TValue>::Create(
+                        *this,
+                        *keyComparerSPtr_,
+                        *keyEnumerator,
+                        *diskKeyEnumerator,
+                        *storeTransactionSPtr,
+                        this->GetThisAllocator(),
+                        enumeratorSPtr);
+                }
+
                 Diagnostics::Validate(status);
                 co_return enumeratorSPtr;
             }
@@ -4713,9 +5122,10 @@ namespace Data
                 stopwatch.Start();
                 StoreEventSource::Events->StoreRebuildNotificationStarting(traceComponent_->PartitionId, traceComponent_->TraceTag);
 
+                auto stateSPtr = co_await CreateRebuiltStateEnumeratorAsync();
+
                 try
                 {
-                    auto stateSPtr = CreateRebuiltStateEnumerator();
                     KSharedPtr<IAsyncEnumerator<KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>>> enumeratorSPtr =
                         static_cast<IAsyncEnumerator<KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>> *>(stateSPtr.RawPtr());
                     STORE_ASSERT(enumeratorSPtr != nullptr, "rebuilt state enumerator should not be null");
@@ -4727,6 +5137,7 @@ namespace Data
                 catch (const ktl::Exception & ex)
                 {
                     TraceException(L"FireRebuildNotificationCallerHoldsLockAsync", ex);
+                    stateSPtr->Dispose();
                     throw;
                 }
 
@@ -4737,7 +5148,7 @@ namespace Data
                 co_return;
             }
 
-            KSharedPtr<RebuiltStateAsyncEnumerator<TKey, TValue>> CreateRebuiltStateEnumerator()
+            ktl::Awaitable<KSharedPtr<RebuiltStateAsyncEnumerator<TKey, TValue>>> CreateRebuiltStateEnumeratorAsync()
             {
                 TKey defaultKey;
                 auto consolidatedStateKeys = consolidationManagerSPtr_->GetSortedKeyEnumerable(false, defaultKey, false, defaultKey);
@@ -4747,20 +5158,47 @@ namespace Data
                 auto cachedCurrentMetadataTable = currentMetadataTableSPtr_.Get();
                 STORE_ASSERT(cachedCurrentMetadataTable != nullptr, "current metadata table should not be null");
 
+                // The keys that are only on disk are read from the checkpoint files while enumerating
+                KSharedPtr<IAsyncEnumerator<TKey>> diskKeysSPtr = nullptr;
+                if (enableDiskResidentKeys_)
+                {
+                    diskKeysSPtr = co_await consolidationManagerSPtr_->CreateDiskKeyEnumeratorAsync(false, defaultKey, false, defaultKey, Constants::InvalidLsn);
+                }
+
                 KSharedPtr<RebuiltStateAsyncEnumerator<TKey, TValue>> enumeratorSPtr = nullptr;
-                auto status = RebuiltStateAsyncEnumerator<TKey, TValue>::Create(
-                    false, 
-                    *consolidatedStateKeys, 
-                    *cachedDiffState, 
-                    *consolidationManagerSPtr_, 
-                    *cachedCurrentMetadataTable, 
-                    *valueConverterSPtr_, 
-                    *traceComponent_,
-                    GetThisAllocator(), 
-                    enumeratorSPtr);
+                NTSTATUS status = STATUS_SUCCESS;
+                if (diskKeysSPtr == nullptr)
+                {
+                    status = RebuiltStateAsyncEnumerator<TKey, TValue>::Create(
+                        false, 
+                        *consolidatedStateKeys, 
+                        *cachedDiffState, 
+                        *consolidationManagerSPtr_, 
+                        *cachedCurrentMetadataTable, 
+                        *valueConverterSPtr_, 
+                        *traceComponent_,
+                        GetThisAllocator(), 
+                        enumeratorSPtr);
+                }
+                else
+                {
+                    status = RebuiltStateAsyncEnumerator<TKey, TValue>::Create(
+                        false, 
+                        *consolidatedStateKeys, 
+                        *diskKeysSPtr,
+                        *keyComparerSPtr_,
+                        *cachedDiffState, 
+                        *consolidationManagerSPtr_, 
+                        *cachedCurrentMetadataTable, 
+                        *valueConverterSPtr_, 
+                        *traceComponent_,
+                        GetThisAllocator(), 
+                        enumeratorSPtr);
+                }
+
                 Diagnostics::Validate(status);
 
-                return enumeratorSPtr;
+                co_return enumeratorSPtr;
             }
 
             // Invariant: For a given key at max one committed transaction can be undone. 
@@ -5009,6 +5447,14 @@ namespace Data
                 __in Data::StateManager::IStateSerializer<TValue>& valueStateSerializer);
 
         private:
+            // Change notification of an operation applied as part of ApplyBatchAsync
+            struct SecondaryApplyNotification
+            {
+                StoreModificationType::Enum ModificationType;
+                TKey Key;
+                TValue Value;
+            };
+
             // Constants
             KStringView const CurrentDiskMetadataFileName = L"current_metadata.sfm";
             KStringView const TempDiskMetadataFileName = L"temp_metadata.sfm";
@@ -5061,6 +5507,7 @@ namespace Data
             LONG64 sweepInProgress_;
             bool enableEnumerationWithRepeatableRead_;
             bool shouldLoadValuesInRecovery_;
+            bool enableDiskResidentKeys_;
             ULONG32 numberOfInflightRecoveryTasks_;
             bool wasCopyAborted_;
             KString::SPtr langTypeInfo_;
@@ -5097,6 +5544,7 @@ namespace Data
            sweepInProgress_(0),
            enableEnumerationWithRepeatableRead_(false),
            shouldLoadValuesInRecovery_(false),
+           enableDiskResidentKeys_(false),
            numberOfInflightRecoveryTasks_(1),
            wasCopyAborted_(false),
            dictionaryChangeHandlerMask_(DictionaryChangeEventMask::Enum::All)
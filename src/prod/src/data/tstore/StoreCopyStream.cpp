@@ -10,6 +10,7 @@ using namespace Data::TStore;
 using namespace Common;
 
 ULONG32 StoreCopyStream::CopyChunkSize = 500 * 1024;
+ULONG32 StoreCopyStream::MaxCopyChunkSize = 4 * 1024 * 1024;
 
 NTSTATUS StoreCopyStream::Create(
     __in IStoreCopyProvider & copyProvider,
@@ -46,6 +47,10 @@ StoreCopyStream::StoreCopyStream(
     currentFileStreamSPtr_(nullptr),
     copyDataBufferSPtr_(nullptr),
     isClosed_(false),
+    readAheadBufferSPtr_(nullptr),
+    readAheadBytesRead_(0),
+    isReadAheadPending_(false),
+    currentChunkSize_(CopyChunkSize),
     traceComponent_(&traceComponent)
 {
     ULONG bufferSize = CopyChunkSize + sizeof(ULONG32) + 1;
@@ -130,17 +135,7 @@ ktl::Awaitable<void> StoreCopyStream::CloseAsync()
         }
 
         copyProviderSPtr_ = nullptr;
-        if (currentFileStreamSPtr_ != nullptr)
-        {
-            NTSTATUS status = co_await currentFileStreamSPtr_->CloseAsync();
-            Diagnostics::Validate(status);
-            currentFileStreamSPtr_ = nullptr;
-        }
-
-        if (currentFileSPtr_ != nullptr)
-        {
-            currentFileSPtr_->Close();
-        }
+        co_await CloseCurrentFileAsync();
 
         snapshotOfMetadataTableEnumeratorSPtr_ = nullptr;
 
@@ -532,6 +527,10 @@ ktl::Awaitable<OperationData::CSPtr> StoreCopyStream::CreateCheckpointFileChunkO
         status = KBuffer::CreateOrCopyFrom(operationDataBufferSPtr, *copyDataBufferSPtr_, 0, bytesRead + sizeof(ULONG32) + 1, GetThisAllocator());
         Diagnostics::Validate(status);
 
+        // Read the next chunk while this one is being replicated.
+        chunkStopwatch_.Restart();
+        StartReadAhead();
+
         OperationData::SPtr resultSPtr = OperationData::Create(GetThisAllocator());
         resultSPtr->Append(*operationDataBufferSPtr);
 
@@ -539,14 +538,16 @@ ktl::Awaitable<OperationData::CSPtr> StoreCopyStream::CreateCheckpointFileChunkO
         co_return resultCSPtr;
     }
 
-    // The start of the current file has been sent. Check if there are more chunks to be sent (if the stream is at the end, this will return zero).
-    auto status = co_await currentFileStreamSPtr_->ReadAsync(*copyDataBufferSPtr_, bytesRead, 0, CopyChunkSize);
+    // The start of the current file has been sent. The next chunk was requested when the previous one was handed out (if the stream is at the end, this will return zero).
+    auto status = co_await CompleteReadAheadAsync();
     STORE_ASSERT(NT_SUCCESS(status), "Unable to read chunk of file stream for file {1}", filenameSPtr->operator LPCWSTR());
+    bytesRead = readAheadBytesRead_;
 
     if (bytesRead > 0)
     {
         // Send the partial table file operation data
-        byte* data = static_cast<byte *>(copyDataBufferSPtr_->GetBuffer());
+        KBuffer::SPtr chunkBufferSPtr = Ktl::Move(readAheadBufferSPtr_);
+        byte* data = static_cast<byte *>(chunkBufferSPtr->GetBuffer());
         data[bytesRead] = writeMarker;
 
         StoreEventSource::Events->StoreCopyStreamCopyStageCheckpointChunkWrite(
@@ -556,9 +557,23 @@ ktl::Awaitable<OperationData::CSPtr> StoreCopyStream::CreateCheckpointFileChunkO
             writeMarker,
             bytesRead + 1);
 
+        // A full chunk fills the read buffer exactly, so it can be sent without copying.
         KBuffer::SPtr operationDataBufferSPtr;
-        auto lStatus = KBuffer::CreateOrCopyFrom(operationDataBufferSPtr, *copyDataBufferSPtr_, 0, bytesRead + 1, GetThisAllocator());
-        Diagnostics::Validate(lStatus);
+        if (bytesRead + 1 == chunkBufferSPtr->QuerySize())
+        {
+            operationDataBufferSPtr = chunkBufferSPtr;
+
+            currentChunkSize_ = GetNextChunkSize(currentChunkSize_, bytesRead, chunkStopwatch_.ElapsedMicroseconds);
+        }
+        else
+        {
+            auto lStatus = KBuffer::CreateOrCopyFrom(operationDataBufferSPtr, *chunkBufferSPtr, 0, bytesRead + 1, GetThisAllocator());
+            Diagnostics::Validate(lStatus);
+        }
+
+        // Read the next chunk while this one is being replicated.
+        chunkStopwatch_.Restart();
+        StartReadAhead();
 
         OperationData::SPtr resultSPtr = OperationData::Create(GetThisAllocator());
         resultSPtr->Append(*operationDataBufferSPtr);
@@ -568,11 +583,8 @@ ktl::Awaitable<OperationData::CSPtr> StoreCopyStream::CreateCheckpointFileChunkO
     }
 
     // There is no more data in the current file. Send the end of file marker
-    status = co_await currentFileStreamSPtr_->CloseAsync();
-    Diagnostics::Validate(status);
-    currentFileStreamSPtr_ = nullptr;
-    currentFileSPtr_->Close();
-    currentFileSPtr_ = nullptr;
+    co_await CloseCurrentFileAsync();
+    chunkStopwatch_.Reset();
     completed = true;
 
     KBuffer::SPtr operationDataBufferSPtr;
@@ -596,6 +608,78 @@ ktl::Awaitable<OperationData::CSPtr> StoreCopyStream::CreateCheckpointFileChunkO
     co_return resultCSPtr;
 }
 
+ULONG32 StoreCopyStream::GetNextChunkSize(
+    __in ULONG32 currentChunkSize,
+    __in ULONG32 bytesCopied,
+    __in LONG64 elapsedMicroseconds)
+{
+    ULONG64 minChunkSize = CopyChunkSize;
+    ULONG64 maxChunkSize = MaxCopyChunkSize > CopyChunkSize ? MaxCopyChunkSize : CopyChunkSize;
+
+    // Size the chunk so that it carries TargetChunkLatency worth of the measured throughput.
+    // A chunk consumed too fast to be measured means the per chunk overhead dominates.
+    ULONG64 nextChunkSize = elapsedMicroseconds > 0 ?
+        (static_cast<ULONG64>(bytesCopied) * TargetChunkLatencyInMicroseconds) / static_cast<ULONG64>(elapsedMicroseconds) :
+        maxChunkSize;
+
+    // Move at most by a factor of two so that a single outlier does not swing the chunk size.
+    nextChunkSize = __min(nextChunkSize, static_cast<ULONG64>(currentChunkSize) * 2);
+    nextChunkSize = __max(nextChunkSize, static_cast<ULONG64>(currentChunkSize) / 2);
+
+    nextChunkSize = __min(nextChunkSize, maxChunkSize);
+    nextChunkSize = __max(nextChunkSize, minChunkSize);
+
+    return static_cast<ULONG32>(nextChunkSize);
+}
+
+void StoreCopyStream::StartReadAhead()
+{
+    STORE_ASSERT(isReadAheadPending_ == false, "Unexpected copy error. Read ahead already pending");
+    STORE_ASSERT(currentFileStreamSPtr_ != nullptr, "Unexpected copy error. Read ahead without an open file");
+
+    // One extra byte for the operation marker.
+    auto status = KBuffer::Create(currentChunkSize_ + 1, readAheadBufferSPtr_, GetThisAllocator());
+    Diagnostics::Validate(status);
+
+    readAheadBytesRead_ = 0;
+    readAheadAwaitable_ = currentFileStreamSPtr_->ReadAsync(*readAheadBufferSPtr_, readAheadBytesRead_, 0, currentChunkSize_);
+    isReadAheadPending_ = true;
+}
+
+ktl::Awaitable<NTSTATUS> StoreCopyStream::CompleteReadAheadAsync()
+{
+    STORE_ASSERT(isReadAheadPending_, "Unexpected copy error. No read ahead pending");
+
+    NTSTATUS status = co_await readAheadAwaitable_;
+    isReadAheadPending_ = false;
+
+    co_return status;
+}
+
+ktl::Awaitable<void> StoreCopyStream::CloseCurrentFileAsync()
+{
+    // The stream cannot be closed under an outstanding read. The result is not needed anymore.
+    if (isReadAheadPending_)
+    {
+        co_await CompleteReadAheadAsync();
+    }
+
+    readAheadBufferSPtr_ = nullptr;
+
+    if (currentFileStreamSPtr_ != nullptr)
+    {
+        NTSTATUS status = co_await currentFileStreamSPtr_->CloseAsync();
+        Diagnostics::Validate(status);
+        currentFileStreamSPtr_ = nullptr;
+    }
+
+    if (currentFileSPtr_ != nullptr)
+    {
+        currentFileSPtr_->Close();
+        currentFileSPtr_ = nullptr;
+    }
+}
+
 void StoreCopyStream::TraceException(__in KStringView const & methodName, __in ktl::Exception const & exception)
 {
     KDynStringA stackString(this->GetThisAllocator());
@@ -18,6 +18,20 @@ namespace Data
 
         public:
             static ULONG32 CopyChunkSize; // Exposed for testing, normally 500KB
+            static ULONG32 MaxCopyChunkSize; // Exposed for testing, normally 4MB
+
+            // Time a chunk is expected to take from being read to being requested again.
+            // The chunk size is adapted so that a chunk carries about this much of the measured throughput.
+            static const LONG64 TargetChunkLatencyInMicroseconds = 100 * 1000;
+
+            //
+            // Returns the size of the next chunk given the size of the last one and the time it took to be consumed.
+            // The result is between CopyChunkSize and MaxCopyChunkSize and at most doubles or halves the current size.
+            //
+            static ULONG32 GetNextChunkSize(
+                __in ULONG32 currentChunkSize,
+                __in ULONG32 bytesCopied,
+                __in LONG64 elapsedMicroseconds);
 
             static NTSTATUS Create(
                 __in IStoreCopyProvider & copyProvider,
@@ -70,6 +84,9 @@ namespace Data
             KString::SPtr GetValueCheckpointFilePath(__in KStringView & filename);
 
             ktl::Awaitable<KBlockFile::SPtr> OpenFileAsync(__in KStringView & filename);
+            void StartReadAhead();
+            ktl::Awaitable<NTSTATUS> CompleteReadAheadAsync();
+            ktl::Awaitable<void> CloseCurrentFileAsync();
             ktl::Awaitable<OperationData::CSPtr> CreateCheckpointFileChunkOperationData(
                 __in KStringView & filename, 
                 __in byte startMarker, 
@@ -92,6 +109,15 @@ namespace Data
             KBuffer::SPtr copyDataBufferSPtr_;
             bool isClosed_;
 
+            // Read of the next chunk of the current file, issued when the previous chunk is handed out.
+            ktl::Awaitable<NTSTATUS> readAheadAwaitable_;
+            KBuffer::SPtr readAheadBufferSPtr_;
+            ULONG readAheadBytesRead_;
+            bool isReadAheadPending_;
+
+            ULONG32 currentChunkSize_;
+            Common::Stopwatch chunkStopwatch_;
+
             StoreTraceComponent::SPtr traceComponent_;
         };
     }
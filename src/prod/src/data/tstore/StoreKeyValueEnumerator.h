@@ -39,6 +39,29 @@ namespace Data
                 return STATUS_SUCCESS;
             }
 
+            //
+            // Merges, in order, the in-memory keys with the keys that are only in the checkpoint files.
+            //
+            static NTSTATUS Create(
+                __in IStore<TKey, TValue> & store,
+                __in IComparer<TKey> & keyComparer,
+                __in IEnumerator<TKey> & keys,
+                __in IAsyncEnumerator<TKey> & diskKeys,
+                __in IStoreTransaction<TKey, TValue> & storeTransaction,
+                __in KAllocator & allocator,
+                __out KSharedPtr<IAsyncEnumerator<KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>>> & result)
+            {
+                KSharedPtr<StoreKeyValueEnumerator<TKey, TValue>> output = _new(COMPONENTKEYENUMERATOR_TAG, allocator) StoreKeyValueEnumerator(store, keyComparer, keys, storeTransaction);
+                if (!output)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                output->diskKeysEnumeratorSPtr_ = &diskKeys;
+                result = output.RawPtr();
+                return STATUS_SUCCESS;
+            }
+
             KeyValuePair<TKey, KeyValuePair<LONG64, TValue>> GetCurrent() override
             {
                 if (isDone_)
@@ -56,10 +79,9 @@ namespace Data
                     co_return false;
                 }
                 
-                while (keysEnumeratorSPtr_->MoveNext())
+                TKey key;
+                while (co_await MoveNextKeyAsync(cancellationToken, key))
                 {
-                    TKey key = keysEnumeratorSPtr_->Current();
-                    
                     // TODO:
                     // Since the output sequence should not have duplicate keys, we check for them here
                     // Ideally, there should be no duplicates in the input
@@ -68,6 +90,9 @@ namespace Data
                         continue;
                     }
 
+                    previousKey_ = key;
+                    isPreviousSet_ = true;
+
                     KeyValuePair<LONG64, TValue> kvpair;
                     bool exists = co_await storeSPtr_->ConditionalGetAsync(*storeTransactionSPtr_, key, Common::TimeSpan::FromSeconds(Constants::EnumerationGetValueTimeoutSeconds), kvpair, ktl::CancellationToken::None);
                     if (exists)
@@ -96,12 +121,59 @@ namespace Data
 
             void Close()
             {
+                if (diskKeysEnumeratorSPtr_ != nullptr)
+                {
+                    diskKeysEnumeratorSPtr_->Dispose();
+                    diskKeysEnumeratorSPtr_ = nullptr;
+                }
+
                 keysEnumeratorSPtr_ = nullptr;
                 storeTransactionSPtr_ = nullptr;
                 storeSPtr_ = nullptr;
             }
 
         private:
+            ktl::Awaitable<bool> MoveNextKeyAsync(
+                __in ktl::CancellationToken const & cancellationToken,
+                __out TKey & key)
+            {
+                if (diskKeysEnumeratorSPtr_ == nullptr)
+                {
+                    if (!keysEnumeratorSPtr_->MoveNext())
+                    {
+                        co_return false;
+                    }
+
+                    key = keysEnumeratorSPtr_->Current();
+                    co_return true;
+                }
+
+                if (!isStarted_)
+                {
+                    isStarted_ = true;
+                    hasMemoryKey_ = keysEnumeratorSPtr_->MoveNext();
+                    hasDiskKey_ = co_await diskKeysEnumeratorSPtr_->MoveNextAsync(cancellationToken);
+                }
+
+                if (!hasMemoryKey_ && !hasDiskKey_)
+                {
+                    co_return false;
+                }
+
+                if (!hasDiskKey_ || (hasMemoryKey_ && keyComparerSPtr_->Compare(keysEnumeratorSPtr_->Current(), diskKeysEnumeratorSPtr_->GetCurrent()) <= 0))
+                {
+                    key = keysEnumeratorSPtr_->Current();
+                    hasMemoryKey_ = keysEnumeratorSPtr_->MoveNext();
+                }
+                else
+                {
+                    key = diskKeysEnumeratorSPtr_->GetCurrent();
+                    hasDiskKey_ = co_await diskKeysEnumeratorSPtr_->MoveNextAsync(cancellationToken);
+                }
+
+                co_return true;
+            }
+
             StoreKeyValueEnumerator(
                 __in IStore<TKey, TValue> & store,
                 __in IComparer<TKey> & keyComparer,
@@ -118,7 +190,11 @@ namespace Data
             KSharedPtr<IStoreTransaction<TKey, TValue>> storeTransactionSPtr_;
             KSharedPtr<IStore<TKey, TValue>> storeSPtr_;
             KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            KSharedPtr<IAsyncEnumerator<TKey>> diskKeysEnumeratorSPtr_;
 
+            bool isStarted_ = false;
+            bool hasMemoryKey_ = false;
+            bool hasDiskKey_ = false;
             bool isDone_ = false;
             KeyValuePair<TKey, KeyValuePair<LONG64, TValue>> current_;
             
@@ -26,6 +26,7 @@ namespace Data
                 __in LONG64 visibilitySequenceNumber,
                 __in KSharedPtr<SnapshotComponent<TKey, TValue>> & snapshotComponentSPtr,
                 __in IEnumerator<TKey> & enumerator,
+                __in_opt IEnumerator<TKey> * diskKeysEnumerator,
                 __in KAllocator & allocator,
                 __out KSharedPtr<IEnumerator<TKey>> & result)
             {
@@ -37,7 +38,8 @@ namespace Data
                     consolidationManager, 
                     visibilitySequenceNumber,
                     snapshotComponentSPtr, 
-                    enumerator);
+                    enumerator,
+                    diskKeysEnumerator);
 
                 if (!result)
                 {
@@ -54,7 +56,7 @@ namespace Data
 
             TKey Current() override
             {
-                return enumeratorSPtr_->Current();
+                return current_;
             }
 
             bool MoveNext() override
@@ -63,11 +65,18 @@ namespace Data
                 {
                     return false;
                 }
-                
-                while (enumeratorSPtr_->MoveNext())
+
+                if (!isStarted_)
+                {
+                    isStarted_ = true;
+                    hasKey_ = enumeratorSPtr_->MoveNext();
+                    hasDiskKey_ = diskKeysSPtr_ != nullptr && diskKeysSPtr_->MoveNext();
+                }
+
+                TKey key;
+                bool isDiskKey = false;
+                while (TryGetNextKey(key, isDiskKey))
                 {
-                    TKey key = enumeratorSPtr_->Current();
-                    
                     // TODO:
                     // Since the output sequence should not have duplicate keys, we check for them here
                     // Ideally, there should be no duplicates in the input generated by SortedSequenceMergeEnumerator
@@ -78,8 +87,11 @@ namespace Data
                         continue;
                     }
 
-                    if (IsKeyValid(key))
+                    if (IsKeyValid(key, isDiskKey))
                     {
+                        current_ = key;
+                        previousKey_ = key;
+                        isPreviousSet_ = true;
                         return true;
                     }
                 }
@@ -89,7 +101,40 @@ namespace Data
             }
 
         private:
-            bool IsKeyValid(TKey & key)
+            //
+            // Merges, in order, the keys of the in-memory components with the keys in the checkpoint files that exist at the
+            // visibility sequence number. isDiskKey is set when the key is in the checkpoint files.
+            //
+            bool TryGetNextKey(
+                __out TKey & key,
+                __out bool & isDiskKey)
+            {
+                if (!hasKey_ && !hasDiskKey_)
+                {
+                    return false;
+                }
+
+                int comparison = !hasDiskKey_ ? -1 : !hasKey_ ? 1 : keyComparerSPtr_->Compare(enumeratorSPtr_->Current(), diskKeysSPtr_->Current());
+
+                key = comparison > 0 ? diskKeysSPtr_->Current() : enumeratorSPtr_->Current();
+                isDiskKey = comparison >= 0;
+
+                if (comparison <= 0)
+                {
+                    hasKey_ = enumeratorSPtr_->MoveNext();
+                }
+
+                if (comparison >= 0)
+                {
+                    hasDiskKey_ = diskKeysSPtr_->MoveNext();
+                }
+
+                return true;
+            }
+
+            bool IsKeyValid(
+                __in TKey & key,
+                __in bool isDiskKey)
             {
                 // Check to see if this key was already added as part of this store transaction.
                 auto writeset = transactionSPtr_->GetComponent(func_);
@@ -147,8 +192,14 @@ namespace Data
                 }
                 
                 
-                // Not found or key has been deleted
-                if (versionedItem == nullptr || versionedItem->GetRecordKind() == RecordKind::DeletedVersion)
+                // Versions in memory are newer than the checkpoint files, so the key is only taken from disk if it is not in memory
+                if (versionedItem == nullptr)
+                {
+                    return isDiskKey;
+                }
+
+                // Key has been deleted
+                if (versionedItem->GetRecordKind() == RecordKind::DeletedVersion)
                 {
                     return false;
                 }
@@ -164,7 +215,8 @@ namespace Data
                 __in ConsolidationManager<TKey, TValue> & consolidationManager,
                 __in LONG64 visibilitySequenceNumber,
                 __in KSharedPtr<SnapshotComponent<TKey, TValue>> & snapshotComponentSPtr,
-                __in IEnumerator<TKey> & enumerator);
+                __in IEnumerator<TKey> & enumerator,
+                __in_opt IEnumerator<TKey> * diskKeysEnumerator);
         
             KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
             KSharedPtr<StoreTransaction<TKey, TValue>> transactionSPtr_;
@@ -174,10 +226,15 @@ namespace Data
             KSharedPtr<SnapshotComponent<TKey, TValue>> snapshotSPtr_;
             KSharedPtr<IEnumerator<TKey>> enumeratorSPtr_;
             HashFunctionType func_;
+            KSharedPtr<IEnumerator<TKey>> diskKeysSPtr_;
 
+            bool isStarted_ = false;
+            bool hasKey_ = false;
+            bool hasDiskKey_ = false;
             bool isDone_ = false;
             bool isPreviousSet_ = false;
             TKey previousKey_;
+            TKey current_;
         };
         
         template<typename TKey, typename TValue>
@@ -189,7 +246,8 @@ namespace Data
             __in ConsolidationManager<TKey, TValue> & consolidationManager,
             __in LONG64 visibilitySequenceNumber,
             __in KSharedPtr<SnapshotComponent<TKey, TValue>> & snapshotComponentSPtr,
-            __in IEnumerator<TKey> & enumerator) :
+            __in IEnumerator<TKey> & enumerator,
+            __in_opt IEnumerator<TKey> * diskKeysEnumerator) :
             keyComparerSPtr_(&keyComparer),
             transactionSPtr_(&storeTransaction),
             differentialSPtr_(&differentialStoreComponent),
@@ -197,6 +255,7 @@ namespace Data
             snapshotSPtr_(snapshotComponentSPtr),
             enumeratorSPtr_(&enumerator),
             func_(hashFunc),
+            diskKeysSPtr_(diskKeysEnumerator),
             visibilitySequenceNumber_(visibilitySequenceNumber)
         {
         }
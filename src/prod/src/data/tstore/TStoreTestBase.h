@@ -409,6 +409,7 @@ namespace TStoreTests
             KArray<KString::CSPtr> workingFolders(this->GetAllocator());
 
             bool snappedShouldLoadValuesOnRecovery = storeSPtr_->ShouldLoadValuesOnRecovery;
+            bool snappedEnableDiskResidentKeys = storeSPtr_->EnableDiskResidentKeys;
 
             auto snappedReplicaCount = storesSPtr_->Count();
             // Close
@@ -436,6 +437,7 @@ namespace TStoreTests
             storeSPtr_->DictionaryChangeHandlerSPtr = changeHandlerSPtr;
             storeSPtr_->DictionaryChangeHandlerMask = mask;
             storeSPtr_->ShouldLoadValuesOnRecovery = snappedShouldLoadValuesOnRecovery;
+            storeSPtr_->EnableDiskResidentKeys = snappedEnableDiskResidentKeys;
 
             IStateProvider2::SPtr stateProviderSPtr(storeSPtr_.RawPtr());
             mockReplicatorSPtr_->RegisterStateProvider(storeSPtr_->Name, *stateProviderSPtr);
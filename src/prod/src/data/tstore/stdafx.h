@@ -145,6 +145,13 @@ namespace Data
 #include "SweepEnumerator.h"
 #include "DifferentialData.h"
 #include "DifferentialDataEnumerator.h"
+#include "PackedVersionedItem.h"
+#include "BloomFilter.h"
+#include "KeyBlockCache.h"
+#include "KeyCheckpointFileIndex.h"
+#include "DiskKeyIndexKeyEnumerator.h"
+#include "DiskKeysReadAheadEnumerator.h"
+#include "DiskKeyIndex.h"
 #include "ConsolidatedStoreComponent.h"
 #include "AggregatedStoreComponent.h"
 #include "PostMergeMetadataTableInformation.h"
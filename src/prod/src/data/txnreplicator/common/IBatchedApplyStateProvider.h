@@ -0,0 +1,40 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace TxnReplicator
+{
+    // Interface: StateManager -> State Provider (optional).
+    //
+    // State providers that implement this interface in addition to IStateProvider2 receive consecutive
+    // operations of the same transaction that target them in a single call instead of one ApplyAsync per operation.
+    interface IBatchedApplyStateProvider
+    {
+        K_SHARED_INTERFACE(IBatchedApplyStateProvider)
+
+    public:
+        /// <summary>
+        /// Applies a batch of operations that belong to the same transaction, in order.
+        /// </summary>
+        /// <param name="transactionBase">Transaction all the operations belong to.</param>
+        /// <param name="applyContext">Apply context, same as for IStateProvider2::ApplyAsync.</param>
+        /// <param name="logicalSequenceNumbers">LSN of each operation.</param>
+        /// <param name="metadataArray">Metadata of each operation.</param>
+        /// <param name="dataArray">Data of each operation. Entries may be null.</param>
+        /// <param name="results">
+        /// One entry is appended per operation, equal to the operation context IStateProvider2::ApplyAsync
+        /// would have returned for it.
+        /// </param>
+        /// <returns>Task that represents the asynchronous operation.</returns>
+        virtual ktl::Awaitable<void> ApplyBatchAsync(
+            __in TransactionBase const & transactionBase,
+            __in ApplyContext::Enum applyContext,
+            __in KArray<LONG64> const & logicalSequenceNumbers,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & metadataArray,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & dataArray,
+            __inout KArray<OperationContext::CSPtr> & results) = 0;
+    };
+}
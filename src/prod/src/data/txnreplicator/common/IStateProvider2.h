@@ -85,6 +85,31 @@ namespace TxnReplicator
             __in KString const & backupDirectory,
             __in ktl::CancellationToken const & cancellationToken) = 0;
 
+        /// <summary>
+        /// Backup the existing checkpoint state on local disk (if any) to the given directory, compressing the files with the given codec.
+        /// </summary>
+        /// <param name="backupDirectory">The directory where the checkpoint backup is to be stored.</param>
+        /// <param name="codec">The compression codec to use for the checkpoint files.</param>
+        /// <param name="maxDegreeOfParallelism">The maximum number of blocks compressed concurrently.</param>
+        /// <param name="cancellationToken">Request cancellation of the checkpoint backup.</param>
+        /// <returns>Task that represents the asynchronous operation.</returns>
+        /// <remarks>
+        /// State providers that do not support compression take an uncompressed backup.
+        /// RestoreCheckpointAsync must accept both forms.
+        /// </remarks>
+        virtual ktl::Awaitable<void> BackupCompressedCheckpointAsync(
+            __in KString const & backupDirectory,
+            __in Data::Utilities::CompressionCodec::Enum codec,
+            __in ULONG32 maxDegreeOfParallelism,
+            __in ktl::CancellationToken const & cancellationToken)
+        {
+            UNREFERENCED_PARAMETER(codec);
+            UNREFERENCED_PARAMETER(maxDegreeOfParallelism);
+
+            co_await BackupCheckpointAsync(backupDirectory, cancellationToken);
+            co_return;
+        }
+
         /// <summary>
         /// Restore the checkpoint state from the given directory.
         /// </summary>
@@ -24,6 +24,17 @@ namespace TxnReplicator
             __in_opt Data::Utilities::OperationData const * const dataPtr,
             __out OperationContext::CSPtr & result) noexcept = 0;
 
+        // Applies the operations of a transaction in order. One entry is appended to results per operation.
+        // Consecutive operations that target the same state provider are applied as one batch if the state
+        // provider implements IBatchedApplyStateProvider.
+        virtual ktl::Awaitable<NTSTATUS> ApplyBatchAsync(
+            __in TransactionBase const & transactionBase,
+            __in ApplyContext::Enum applyContext,
+            __in KArray<LONG64> const & logicalSequenceNumbers,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & metadataArray,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & dataArray,
+            __inout KArray<OperationContext::CSPtr> & results) noexcept = 0;
+
         virtual NTSTATUS Unlock(__in OperationContext const & operationContext) noexcept = 0;
 
         virtual NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept = 0;
@@ -290,6 +290,17 @@ int TRInternalSettings::LoadGlobalSettingsCallerHoldsLock()
     this->flushedRecordsTraceVectorSize_ = globalConfig_->FlushedRecordsTraceVectorSize;
     i += 1;
 
+    // Unknown codecs fall back to uncompressed backups rather than failing every backup
+    this->backupCompressionCodec_ =
+        globalConfig_->BackupCompressionCodec <= Data::Utilities::CompressionCodec::LastValidEnum &&
+        Data::Utilities::BlockCompressor::IsCodecSupported(static_cast<Data::Utilities::CompressionCodec::Enum>(globalConfig_->BackupCompressionCodec))
+        ? globalConfig_->BackupCompressionCodec
+        : Data::Utilities::CompressionCodec::None;
+    i += 1;
+
+    this->backupDegreeOfParallelism_ = globalConfig_->BackupDegreeOfParallelism;
+    i += 1;
+
     return i;
 }
 
@@ -730,6 +741,18 @@ int64 TRInternalSettings::get_FlushedRecordsTraceVectorSize() const
     return flushedRecordsTraceVectorSize_;
 }
 
+int64 TRInternalSettings::get_BackupCompressionCodec() const
+{
+    AcquireReadLock grab(lock_);
+    return backupCompressionCodec_;
+}
+
+int64 TRInternalSettings::get_BackupDegreeOfParallelism() const
+{
+    AcquireReadLock grab(lock_);
+    return backupDegreeOfParallelism_;
+}
+
 std::wstring TRInternalSettings::ToString() const
 {
     std::wstring content;
@@ -828,5 +851,11 @@ int TRInternalSettings::WriteTo(__in Common::TextWriter & w, Common::FormatOptio
     w.WriteLine("FlushedRecordsTraceVectorSize = {0}, ", this->FlushedRecordsTraceVectorSize);
     i += 1;
 
+    w.WriteLine("BackupCompressionCodec = {0}, ", this->BackupCompressionCodec);
+    i += 1;
+
+    w.WriteLine("BackupDegreeOfParallelism = {0}, ", this->BackupDegreeOfParallelism);
+    i += 1;
+
     return i;
 }
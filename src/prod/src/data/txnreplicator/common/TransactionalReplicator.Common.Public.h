@@ -63,6 +63,7 @@ namespace LoggingReplicatorTests
 // State Provider & notification related classes and interfaces.
 #include "StateProviderInfo.h"
 #include "IStateProvider2.h"
+#include "IBatchedApplyStateProvider.h"
 #include "ITransactionChangeHandler.h"
 #include "IStateManagerChangeHandler.h"
 #include "IStateProviderMap.h"
@@ -256,6 +256,20 @@ void BackupFolderInfo::VerifyMetadataList()
     BackupMetadataFile::CSPtr lastBackupMetadataFile = nullptr;
     for (BackupMetadataFile::CSPtr metadataFile : metadataArray_)
     {
+        // Backup taken by a newer version with a codec this version cannot decompress.
+        if (BlockCompressor::IsCodecSupported(metadataFile->CompressionCodec) == false)
+        {
+            LR_TRACE_UNEXPECTEDEXCEPTION_STATUS(
+                ToStringLiteral(
+                    wformatString(
+                        L"Backup {0} uses unsupported compression codec {1}",
+                        Common::Guid(metadataFile->BackupId),
+                        static_cast<LONG32>(metadataFile->CompressionCodec))),
+                STATUS_NOT_SUPPORTED);
+
+            throw Exception(STATUS_NOT_SUPPORTED);
+        }
+
         // lastBackupMetadataFile != nullptr only for the full backup metadata.
         if (lastBackupMetadataFile == nullptr)
         {
@@ -479,17 +479,20 @@ ktl::Awaitable<void> BackupLogFile::WriteLogRecordBlockAsync(
     status = operationDataArray.InsertAt(0, operationData);
     THROW_ON_FAILURE(status);
 
+    // Checksum this block of data (with the block size included) while it is written.
+    CRC64::Builder checksumBuilder;
+
     for (OperationData::CSPtr opData : operationDataArray)
     {
         for (ULONG32 bufferIndex = 0; bufferIndex < opData->BufferCount; bufferIndex++)
         {
             KBuffer::CSPtr buffer((*opData)[bufferIndex]);
+            checksumBuilder.Append(*buffer, 0, buffer->QuerySize());
             co_await outputStream.WriteAsync(*buffer);
         }
     }
 
-    // Checksum this block of data (with the block size included).
-    ULONG64 blockChecksum = CRC64::ToCRC64(operationDataArray, 0, operationDataArray.Count());
+    ULONG64 blockChecksum = checksumBuilder.Value;
 
     // Add the checksum at the end of the memory stream.
     binaryWriter.Position = 0;
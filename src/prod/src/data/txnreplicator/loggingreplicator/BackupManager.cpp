@@ -1057,6 +1057,11 @@ Awaitable<NTSTATUS> BackupManager::WriteBackupMetadataFileAsync(
         KGuid(backupId.AsGUID()) :
         KGuid(previousBackupLogRecord->BackupId);
 
+    // Only full backups contain state provider checkpoints, incremental backups are log only.
+    Utilities::CompressionCodec::Enum compressionCodec = backupOption == FABRIC_BACKUP_OPTION_FULL ?
+        static_cast<Utilities::CompressionCodec::Enum>(transactionalReplicatorConfig_->BackupCompressionCodec) :
+        Utilities::CompressionCodec::None;
+
     status = co_await backupMetadataSPtr->WriteAsync(
         backupOption,
         parentBackupId,
@@ -1067,6 +1072,7 @@ Awaitable<NTSTATUS> BackupManager::WriteBackupMetadataFileAsync(
         replicatorBackup.LsnOfFirstLogicalLogRecord,
         replicatorBackup.EpochOfHighestBackedUpLogRecord,
         replicatorBackup.LsnOfHighestBackedUpLogRecord,
+        compressionCodec,
         cancellationToken);
     CO_RETURN_ON_FAILURE(status);
 
@@ -26,7 +26,8 @@ namespace LoggingReplicatorTests
     {
     public:
         Awaitable<void> Test_BackupMetadataFile_WriteAndRead(
-            __in KString const & fileName);
+            __in KString const & fileName,
+            __in CompressionCodec::Enum expectedCompressionCodec);
 
         Awaitable<void> Test_BackupMetadataFile_Equal(
             __in KString const & fileName);
@@ -57,7 +58,8 @@ namespace LoggingReplicatorTests
     // 3. Read the backup metadata file.
     // 4. Verify all the properties are as expected.
     Awaitable<void> BackupMetadataFileTests::Test_BackupMetadataFile_WriteAndRead(
-        __in KString const & fileName)
+        __in KString const & fileName,
+        __in CompressionCodec::Enum expectedCompressionCodec)
     {
         NTSTATUS status = STATUS_UNSUCCESSFUL;
 
@@ -98,6 +100,7 @@ namespace LoggingReplicatorTests
             expectedStartingLSN,
             expectedBackupEpoch,
             expectedBackupLSN,
+            expectedCompressionCodec,
             CancellationToken::None);
         VERIFY_IS_TRUE(NT_SUCCESS(status));
 
@@ -117,6 +120,7 @@ namespace LoggingReplicatorTests
         CODING_ERROR_ASSERT(backupMetadataFileSPtr->BackupEpoch.DataLossVersion == expectedDataLossNumber);
         CODING_ERROR_ASSERT(backupMetadataFileSPtr->BackupEpoch.ConfigurationVersion == expectedConfigurationNumber);
         CODING_ERROR_ASSERT(backupMetadataFileSPtr->BackupLSN == expectedBackupLSN);
+        CODING_ERROR_ASSERT(backupMetadataFileSPtr->CompressionCodec == expectedCompressionCodec);
         CODING_ERROR_ASSERT(backupMetadataFileSPtr->FileName == filePath);
 
         Common::File::Delete(static_cast<LPCWSTR>(fileName), true);
@@ -168,6 +172,7 @@ namespace LoggingReplicatorTests
             expectedStartingLSN,
             expectedBackupEpoch,
             expectedBackupLSN,
+            CompressionCodec::None,
             CancellationToken::None);
         VERIFY_IS_TRUE(NT_SUCCESS(status));
 
@@ -198,6 +203,7 @@ namespace LoggingReplicatorTests
             expectedStartingLSN,
             expectedBackupEpoch,
             expectedBackupLSN,
+            CompressionCodec::None,
             CancellationToken::None);
         VERIFY_IS_TRUE(NT_SUCCESS(status));
 
@@ -261,6 +267,7 @@ namespace LoggingReplicatorTests
             expectedStartingLSN,
             expectedBackupEpoch,
             expectedBackupLSN,
+            CompressionCodec::None,
             cts->Token);
         VERIFY_ARE_EQUAL(STATUS_CANCELLED, status);
 
@@ -313,6 +320,7 @@ namespace LoggingReplicatorTests
             expectedStartingLSN,
             expectedBackupEpoch,
             expectedBackupLSN,
+            CompressionCodec::None,
             CancellationToken::None);
         CODING_ERROR_ASSERT(NT_SUCCESS(status));
 
@@ -365,7 +373,21 @@ namespace LoggingReplicatorTests
         {
             KString::CSPtr fileName = CreateFileName(L"BackupMetadataFile_WriteAndRead.txt", allocator);
 
-            SyncAwait(Test_BackupMetadataFile_WriteAndRead(*fileName));
+            SyncAwait(Test_BackupMetadataFile_WriteAndRead(*fileName, CompressionCodec::None));
+        }
+    }
+
+    //
+    // Scenario:        Write the backup metadata file of a compressed backup and read the file
+    // Expected Result: The compression codec read from file should be as expected
+    // 
+    BOOST_AUTO_TEST_CASE(BackupMetadataFile_WriteAndRead_Compressed)
+    {
+        TEST_TRACE_BEGIN("BackupMetadataFile_WriteAndRead_Compressed")
+        {
+            KString::CSPtr fileName = CreateFileName(L"BackupMetadataFile_WriteAndRead_Compressed.txt", allocator);
+
+            SyncAwait(Test_BackupMetadataFile_WriteAndRead(*fileName, CompressionCodec::Lz));
         }
     }
 
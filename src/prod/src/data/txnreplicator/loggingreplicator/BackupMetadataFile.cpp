@@ -57,6 +57,7 @@ ktl::Awaitable<NTSTATUS> BackupMetadataFile::WriteAsync(
     __in FABRIC_SEQUENCE_NUMBER startingLSN,
     __in TxnReplicator::Epoch const & backupEpoch,
     __in FABRIC_SEQUENCE_NUMBER backupLSN,
+    __in Utilities::CompressionCodec::Enum compressionCodec,
     __in ktl::CancellationToken const & cancellationToken) noexcept
 {
     KShared$ApiEntry();
@@ -83,6 +84,7 @@ ktl::Awaitable<NTSTATUS> BackupMetadataFile::WriteAsync(
     backupMetadataFilePropertiesSPtr->StartingLSN = startingLSN;
     backupMetadataFilePropertiesSPtr->BackupEpoch = backupEpoch;
     backupMetadataFilePropertiesSPtr->BackupLSN = backupLSN;
+    backupMetadataFilePropertiesSPtr->CompressionCodec = compressionCodec;
 
     KBlockFile::SPtr fileSPtr = nullptr;
     status = co_await KBlockFile::CreateSparseFileAsync(
@@ -316,7 +318,8 @@ bool BackupMetadataFile::Equals(__in BackupMetadataFile const & other) const noe
         && PropertiesReplicaId == other.PropertiesReplicaId
         && BackupEpoch.DataLossVersion == other.BackupEpoch.DataLossVersion
         && BackupEpoch.ConfigurationVersion == other.BackupEpoch.ConfigurationVersion
-        && BackupLSN == other.BackupLSN;
+        && BackupLSN == other.BackupLSN
+        && CompressionCodec == other.CompressionCodec;
 }
 
 KWString const BackupMetadataFile::get_FileName() const { return filePath_; }
@@ -339,6 +342,8 @@ TxnReplicator::Epoch BackupMetadataFile::get_StartingEpoch() const { return prop
 
 FABRIC_SEQUENCE_NUMBER BackupMetadataFile::get_StartingLSN() const { return propertiesSPtr_->StartingLSN; }
 
+Utilities::CompressionCodec::Enum BackupMetadataFile::get_CompressionCodec() const { return propertiesSPtr_->CompressionCodec; }
+
 BackupMetadataFile::BackupMetadataFile(
     __in PartitionedReplicaId const& traceId,
     __in KWString const & filePath,
@@ -63,6 +63,9 @@ namespace Data
             __declspec(property(get = get_StartingLSN)) FABRIC_SEQUENCE_NUMBER StartingLSN;
             FABRIC_SEQUENCE_NUMBER get_StartingLSN() const;
 
+            __declspec(property(get = get_CompressionCodec)) Utilities::CompressionCodec::Enum CompressionCodec;
+            Utilities::CompressionCodec::Enum get_CompressionCodec() const;
+
         public:
             // Create a new BackupMetadataFile and write it to the given file.    
             ktl::Awaitable<NTSTATUS> WriteAsync(
@@ -75,6 +78,7 @@ namespace Data
                 __in FABRIC_SEQUENCE_NUMBER startingLSN,
                 __in TxnReplicator::Epoch const & backupEpoch,
                 __in FABRIC_SEQUENCE_NUMBER backupLSN,
+                __in Utilities::CompressionCodec::Enum compressionCodec,
                 __in ktl::CancellationToken const & cancellationToken) noexcept;
 
             // Open a existing BackupMetadataFile
@@ -129,6 +129,14 @@ void BackupMetadataFileProperties::Write(__in BinaryWriter& writer)
     writer.Write(BackupLSNPropertyName);
     VarInt::Write(writer, static_cast<ULONG32>(sizeof(FABRIC_SEQUENCE_NUMBER)));
     writer.Write(backupLSN_);
+
+    // 'compressionCodec' - LONG32
+    if (compressionCodec_ != Utilities::CompressionCodec::None)
+    {
+        writer.Write(CompressionCodecPropertyName);
+        VarInt::Write(writer, static_cast<ULONG32>(sizeof(LONG32)));
+        writer.Write(static_cast<LONG32>(compressionCodec_));
+    }
 }
 
 // Read the properties from the buffer
@@ -185,6 +193,13 @@ void BackupMetadataFileProperties::ReadProperty(
     {
         reader.Read(backupLSN_);
     }
+    else if (propertyName.Compare(CompressionCodecPropertyName) == 0)
+    {
+        LONG32 compressionCodec;
+        reader.Read(compressionCodec);
+
+        compressionCodec_ = static_cast<Utilities::CompressionCodec::Enum>(compressionCodec);
+    }
     else
     {
         // If the properties is unknown, just skip it.
@@ -201,6 +216,9 @@ void BackupMetadataFileProperties::put_BackupId(__in KGuid const & backupId) { b
 FABRIC_SEQUENCE_NUMBER BackupMetadataFileProperties::get_BackupLSN() const { return backupLSN_; }
 void BackupMetadataFileProperties::put_BackupLSN(__in FABRIC_SEQUENCE_NUMBER backupLSN) { backupLSN_ = backupLSN; }
 
+Utilities::CompressionCodec::Enum BackupMetadataFileProperties::get_CompressionCodec() const { return compressionCodec_; }
+void BackupMetadataFileProperties::put_CompressionCodec(__in Utilities::CompressionCodec::Enum codec) { compressionCodec_ = codec; }
+
 FABRIC_BACKUP_OPTION BackupMetadataFileProperties::get_BackupOption() const { return backupOption_; }
 void BackupMetadataFileProperties::put_BackupOption(__in FABRIC_BACKUP_OPTION backupOption) { backupOption_ = backupOption; }
 
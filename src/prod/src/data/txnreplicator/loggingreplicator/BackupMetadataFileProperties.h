@@ -56,6 +56,10 @@ namespace Data
             FABRIC_SEQUENCE_NUMBER get_BackupLSN() const;
             void put_BackupLSN(__in FABRIC_SEQUENCE_NUMBER backupLSN);
 
+            __declspec(property(get = get_CompressionCodec, put = put_CompressionCodec)) Utilities::CompressionCodec::Enum CompressionCodec;
+            Utilities::CompressionCodec::Enum get_CompressionCodec() const;
+            void put_CompressionCodec(__in Utilities::CompressionCodec::Enum codec);
+
             __declspec(property(get = get_BackupOption, put = put_BackupOption)) FABRIC_BACKUP_OPTION BackupOption;
             FABRIC_BACKUP_OPTION get_BackupOption() const;
             void put_BackupOption(__in FABRIC_BACKUP_OPTION backupOption);
@@ -107,6 +111,7 @@ namespace Data
             const KStringView BackupIdPropertyName = L"backupid";
             const KStringView BackupLSNPropertyName = L"lsn";
             const KStringView BackupOptionPropertyName = L"option";
+            const KStringView CompressionCodecPropertyName = L"compressionCodec";
             const KStringView ParentBackupIdPropertyName = L"parentBackupId";
             const KStringView PartitionIdPropertyName = L"partitionid";
             const KStringView ReplicaIdPropertyName = L"replicaid";
@@ -132,6 +137,10 @@ namespace Data
             // The backup option.
             FABRIC_BACKUP_OPTION backupOption_ = FABRIC_BACKUP_OPTION_INVALID;
 
+            // The codec the state provider checkpoints are compressed with.
+            // Only written when the backup is compressed, so uncompressed backups keep the original format.
+            Utilities::CompressionCodec::Enum compressionCodec_ = Utilities::CompressionCodec::None;
+
             // Parent backup id.
             KGuid parentBackupId_;
 
@@ -443,5 +443,139 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(VerifyCompletionTasksNotAllocatedUnlessAwaited)
+    {
+        TEST_TRACE_BEGIN("VerifyCompletionTasksNotAllocatedUnlessAwaited")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            OperationLogRecord::SPtr record = TestLogRecordUtility::CreateOperationLogRecord(seed, *util->InvalidRecords, allocator);
+
+            VERIFY_IS_FALSE(record->IsFlushed);
+            VERIFY_IS_FALSE(record->IsApplied);
+            VERIFY_IS_FALSE(record->IsProcessed);
+
+            record->CompletedFlush(STATUS_SUCCESS);
+            record->CompletedApply(STATUS_SUCCESS);
+            record->CompletedProcessing();
+
+            VERIFY_IS_TRUE(record->IsFlushed);
+            VERIFY_IS_TRUE(record->IsApplied);
+            VERIFY_IS_TRUE(record->IsProcessed);
+            VERIFY_ARE_EQUAL(record->FlushError, STATUS_SUCCESS);
+
+            // Awaiting a stage that has already completed must not allocate
+            VERIFY_ARE_EQUAL(SyncAwait(record->AwaitFlush()), STATUS_SUCCESS);
+            VERIFY_ARE_EQUAL(SyncAwait(record->AwaitApply()), STATUS_SUCCESS);
+            VERIFY_ARE_EQUAL(SyncAwait(record->AwaitProcessing()), STATUS_SUCCESS);
+
+            VERIFY_IS_FALSE(record->Test_IsCompletionTaskAllocated());
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(VerifyCompletionTasksCompleteLateAwaiters)
+    {
+        TEST_TRACE_BEGIN("VerifyCompletionTasksCompleteLateAwaiters")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            OperationLogRecord::SPtr record = TestLogRecordUtility::CreateOperationLogRecord(seed, *util->InvalidRecords, allocator);
+
+            Awaitable<NTSTATUS> flushAwaitable = record->AwaitFlush();
+            VERIFY_IS_TRUE(record->Test_IsCompletionTaskAllocated());
+            VERIFY_IS_FALSE(flushAwaitable.IsComplete());
+
+            record->CompletedFlush(STATUS_CANCELLED);
+
+            VERIFY_ARE_EQUAL(SyncAwait(Ktl::Move(flushAwaitable)), STATUS_CANCELLED);
+            VERIFY_ARE_EQUAL(record->FlushError, STATUS_CANCELLED);
+
+            // A task requested after completion is handed out already completed
+            record->CompletedApply(STATUS_SUCCESS);
+            CompletionTask::SPtr appliedTask = record->GetAppliedTask();
+            VERIFY_IS_TRUE(appliedTask->IsCompleted);
+            VERIFY_ARE_EQUAL(appliedTask->CompletionCode, STATUS_SUCCESS);
+        }
+    }
+
+    //
+    // Compares records that are never awaited (no CompletionTask allocated) with records that await every stage
+    // before it completes (three CompletionTask allocations, as every record used to do).
+    // Reports the CompletionTask allocations per record and the average and p99 latency of creating a record and
+    // completing its flush, apply and processing stages.
+    //
+    BOOST_AUTO_TEST_CASE(CompletionTaskAllocation_Perf, * boost::unit_test::disabled())
+    {
+        TEST_TRACE_BEGIN("CompletionTaskAllocation_Perf")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            int const recordCount = 100000;
+
+            for (int awaitStages = 0; awaitStages <= 1; awaitStages++)
+            {
+                vector<int64> latencies;
+                latencies.reserve(recordCount);
+
+                int allocatedCount = 0;
+
+                for (int i = 0; i < recordCount; i++)
+                {
+                    int64 start = Stopwatch::GetTimestamp();
+
+                    OperationLogRecord::SPtr record = TestLogRecordUtility::CreateOperationLogRecord(seed, *util->InvalidRecords, allocator);
+
+                    if (awaitStages == 1)
+                    {
+                        Awaitable<NTSTATUS> flushAwaitable = record->AwaitFlush();
+                        Awaitable<NTSTATUS> applyAwaitable = record->AwaitApply();
+                        Awaitable<NTSTATUS> processAwaitable = record->AwaitProcessing();
+
+                        record->CompletedFlush(STATUS_SUCCESS);
+                        record->CompletedApply(STATUS_SUCCESS);
+                        record->CompletedProcessing();
+
+                        SyncAwait(Ktl::Move(flushAwaitable));
+                        SyncAwait(Ktl::Move(applyAwaitable));
+                        SyncAwait(Ktl::Move(processAwaitable));
+                    }
+                    else
+                    {
+                        record->CompletedFlush(STATUS_SUCCESS);
+                        record->CompletedApply(STATUS_SUCCESS);
+                        record->CompletedProcessing();
+                    }
+
+                    latencies.push_back(Stopwatch::GetTimestamp() - start);
+
+                    if (record->Test_IsCompletionTaskAllocated())
+                    {
+                        allocatedCount++;
+                    }
+                }
+
+                int64 total = 0;
+                for (int64 latency : latencies)
+                {
+                    total += latency;
+                }
+
+                sort(latencies.begin(), latencies.end());
+
+                Trace.WriteInfo(
+                    TraceComponent,
+                    "{0} AwaitStages={1}: Records={2}, RecordsWithCompletionTasks={3}, AverageTicks={4}, P99Ticks={5}",
+                    prId_->TraceId,
+                    awaitStages == 1,
+                    recordCount,
+                    allocatedCount,
+                    Stopwatch::ConvertTimestampToTicks(total) / recordCount,
+                    Stopwatch::ConvertTimestampToTicks(latencies[(recordCount * 99) / 100]));
+
+                VERIFY_ARE_EQUAL(allocatedCount, awaitStages == 1 ? recordCount : 0);
+            }
+        }
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
@@ -358,6 +358,27 @@ Awaitable<void> OperationProcessor::ProcessLoggedRecordAsync(__in LogRecord & lo
     co_return;
 }
         
+NTSTATUS OperationProcessor::AppendApplyBatchEntry(
+    __in TransactionLogRecord & record,
+    __in_opt OperationData const * const metadataPtr,
+    __in_opt OperationData const * const dataPtr,
+    __inout KArray<TransactionLogRecord::SPtr> & records,
+    __inout KArray<LONG64> & logicalSequenceNumbers,
+    __inout KArray<OperationData::CSPtr> & metadataArray,
+    __inout KArray<OperationData::CSPtr> & dataArray) noexcept
+{
+    NTSTATUS status = records.Append(&record);
+    RETURN_ON_FAILURE(status);
+
+    status = logicalSequenceNumbers.Append(record.Lsn);
+    RETURN_ON_FAILURE(status);
+
+    status = metadataArray.Append(OperationData::CSPtr(metadataPtr));
+    RETURN_ON_FAILURE(status);
+
+    return dataArray.Append(OperationData::CSPtr(dataPtr));
+}
+
 void OperationProcessor::UpdateDispatchingBarrierTask(__in CompletionTask & barrierTask)
 {
     versionManager_->UpdateDispatchingBarrierTask(barrierTask);
@@ -836,27 +857,35 @@ Awaitable<void> OperationProcessor::ApplyCallback(__in LogRecord & record) noexc
                     endTransactionRecord->Lsn);
             }
 
-            OperationContext::CSPtr operationContext = nullptr;
-            
-            status = co_await stateManager->ApplyAsync(
-                beginTransactionRecord->Lsn,
-                beginTransactionRecord->BaseTransaction,
-                applyRedoContext,
-                beginTransactionRecord->Metadata.RawPtr(),
-                beginTransactionRecord->Redo.RawPtr(),
-                operationContext);
-
-            if (!NT_SUCCESS(status))
+            // The begin record and every operation record of the transaction are applied with one call so that
+            // the state manager can hand consecutive operations on the same state provider over as a batch.
+            KArray<TransactionLogRecord::SPtr> transactionRecords(GetThisAllocator());
+            KArray<LONG64> logicalSequenceNumbers(GetThisAllocator());
+            KArray<OperationData::CSPtr> metadataArray(GetThisAllocator());
+            KArray<OperationData::CSPtr> dataArray(GetThisAllocator());
+            KArray<OperationContext::CSPtr> operationContexts(GetThisAllocator());
+
+            if (!NT_SUCCESS(transactionRecords.Status()) ||
+                !NT_SUCCESS(logicalSequenceNumbers.Status()) ||
+                !NT_SUCCESS(metadataArray.Status()) ||
+                !NT_SUCCESS(dataArray.Status()) ||
+                !NT_SUCCESS(operationContexts.Status()))
             {
-                break;
+                status = STATUS_INSUFFICIENT_RESOURCES;
             }
-
-            if (operationContext != nullptr)
+            else
             {
-                beginTransactionRecord->OperationContextValue = *operationContext;
+                status = AppendApplyBatchEntry(
+                    *beginTransactionRecord,
+                    beginTransactionRecord->Metadata.RawPtr(),
+                    beginTransactionRecord->Redo.RawPtr(),
+                    transactionRecords,
+                    logicalSequenceNumbers,
+                    metadataArray,
+                    dataArray);
             }
 
-            do
+            while (NT_SUCCESS(status))
             {
                 transactionRecord = transactionRecord->ChildTransactionRecord;
 
@@ -892,27 +921,54 @@ Awaitable<void> OperationProcessor::ApplyCallback(__in LogRecord & record) noexc
                         endTransactionRecord->Lsn);
                 }
 
-                OperationContext::CSPtr opContext = nullptr;
-                
-                status = co_await stateManager->ApplyAsync(
-                    operationRecord->Lsn,
-                    operationRecord->BaseTransaction,
-                    applyRedoContext,
+                status = AppendApplyBatchEntry(
+                    *operationRecord,
                     operationRecord->Metadata.RawPtr(),
                     operationRecord->Redo.RawPtr(),
-                    opContext);
+                    transactionRecords,
+                    logicalSequenceNumbers,
+                    metadataArray,
+                    dataArray);
+            }
 
-                if (!NT_SUCCESS(status))
+            if (!NT_SUCCESS(status))
+            {
+                break;
+            }
+
+            status = co_await stateManager->ApplyBatchAsync(
+                beginTransactionRecord->BaseTransaction,
+                applyRedoContext,
+                logicalSequenceNumbers,
+                metadataArray,
+                dataArray,
+                operationContexts);
+
+            ASSERT_IFNOT(
+                !NT_SUCCESS(status) || operationContexts.Count() == transactionRecords.Count(),
+                "{0}: ApplyCallback | Expected {1} operation contexts from batch apply, actual: {2}",
+                TraceId,
+                transactionRecords.Count(),
+                operationContexts.Count());
+
+            // On failure, the contexts of the operations that were applied are still kept so that they get unlocked
+            for (ULONG i = 0; i < operationContexts.Count(); i++)
+            {
+                if (operationContexts[i] == nullptr)
                 {
-                    break;
+                    continue;
                 }
 
-                if (opContext != nullptr)
+                if (transactionRecords[i]->RecordType == LogRecordType::Enum::BeginTransaction)
+                {
+                    beginTransactionRecord->OperationContextValue = *operationContexts[i];
+                }
+                else
                 {
-                    operationRecord->OperationContextValue = *opContext;
+                    operationRecord = dynamic_cast<OperationLogRecord *>(transactionRecords[i].RawPtr());
+                    operationRecord->OperationContextValue = *operationContexts[i];
                 }
             }
-            while (true);
 
             if (!NT_SUCCESS(status))
             {
@@ -142,6 +142,15 @@ namespace Data
 
             ktl::Awaitable<void> ApplyCallback(__in LogRecordLib::LogRecord & record) noexcept;
 
+            static NTSTATUS AppendApplyBatchEntry(
+                __in LogRecordLib::TransactionLogRecord & record,
+                __in_opt Utilities::OperationData const * const metadataPtr,
+                __in_opt Utilities::OperationData const * const dataPtr,
+                __inout KArray<LogRecordLib::TransactionLogRecord::SPtr> & records,
+                __inout KArray<LONG64> & logicalSequenceNumbers,
+                __inout KArray<Utilities::OperationData::CSPtr> & metadataArray,
+                __inout KArray<Utilities::OperationData::CSPtr> & dataArray) noexcept;
+
             void FireCommitNotification(__in TxnReplicator::TransactionBase const & transaction);
 
             bool ProcessError(
@@ -22,6 +22,7 @@ TestStateProviderManager::TestStateProviderManager(__in ApiFaultUtility & apiFau
     , expectedData_(GetThisAllocator())
     , applyCount_(0)
     , unlockCount_(0)
+    , applyBatchCount_(0)
     , stateStreamSuccessfulOperationCount_(0)
     , beginSettingCurrentStateApiCount_(0)
     , setCurrentStateApiCount_(0)
@@ -112,6 +113,43 @@ Awaitable<NTSTATUS> TestStateProviderManager::ApplyAsync(
     co_return STATUS_SUCCESS;
 }
 
+Awaitable<NTSTATUS> TestStateProviderManager::ApplyBatchAsync(
+    __in TransactionBase const & transactionBase,
+    __in TxnReplicator::ApplyContext::Enum applyContext,
+    __in KArray<LONG64> const & logicalSequenceNumbers,
+    __in KArray<OperationData::CSPtr> const & metadataArray,
+    __in KArray<OperationData::CSPtr> const & dataArray,
+    __inout KArray<OperationContext::CSPtr> & results) noexcept
+{
+    CODING_ERROR_ASSERT(logicalSequenceNumbers.Count() == metadataArray.Count());
+    CODING_ERROR_ASSERT(dataArray.Count() == metadataArray.Count());
+
+    applyBatchCount_++;
+
+    for (ULONG i = 0; i < metadataArray.Count(); i++)
+    {
+        OperationContext::CSPtr result = nullptr;
+
+        NTSTATUS status = co_await ApplyAsync(
+            logicalSequenceNumbers[i],
+            transactionBase,
+            applyContext,
+            metadataArray[i].RawPtr(),
+            dataArray[i].RawPtr(),
+            result);
+
+        if (!NT_SUCCESS(status))
+        {
+            co_return status;
+        }
+
+        status = results.Append(result);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+    }
+
+    co_return STATUS_SUCCESS;
+}
+
 NTSTATUS TestStateProviderManager::Unlock(__in OperationContext const & operationContext) noexcept
 {
     UNREFERENCED_PARAMETER(operationContext);
@@ -127,6 +165,7 @@ void TestStateProviderManager::Reuse()
         expectedData_.Reset();
         applyCount_.store(0);
         unlockCount_.store(0);
+        applyBatchCount_.store(0);
 
         LONG64* txId;
         ExpectedDataValue* val;
@@ -33,6 +33,12 @@ namespace LoggingReplicatorTests
             stateStreamSuccessfulOperationCount_ = val;
         }
 
+        __declspec(property(get = get_ApplyBatchApiCount)) LONG ApplyBatchApiCount;
+        LONG get_ApplyBatchApiCount() const
+        {
+            return applyBatchCount_.load();
+        }
+
         __declspec(property(get = get_BeginSettingCurrentStateApiCount)) ULONG32 BeginSettingCurrentStateApiCount;
         ULONG32 get_BeginSettingCurrentStateApiCount() const
         {
@@ -59,6 +65,14 @@ namespace LoggingReplicatorTests
             __in_opt Data::Utilities::OperationData const * const dataPtr,
             __out TxnReplicator::OperationContext::CSPtr & result) noexcept override;
 
+        ktl::Awaitable<NTSTATUS> ApplyBatchAsync(
+            __in TxnReplicator::TransactionBase const & transactionBase,
+            __in TxnReplicator::ApplyContext::Enum applyContext,
+            __in KArray<LONG64> const & logicalSequenceNumbers,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & metadataArray,
+            __in KArray<Data::Utilities::OperationData::CSPtr> const & dataArray,
+            __inout KArray<TxnReplicator::OperationContext::CSPtr> & results) noexcept override;
+
         NTSTATUS Unlock(__in TxnReplicator::OperationContext const & operationContext) noexcept override;
 
         NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept override;
@@ -138,6 +152,7 @@ namespace LoggingReplicatorTests
         KHashTable<LONG64, ExpectedDataValue> expectedData_;
         Common::atomic_long applyCount_;
         Common::atomic_long unlockCount_;
+        Common::atomic_long applyBatchCount_;
         ApiFaultUtility::SPtr apiFaultUtility_;
         ULONG32 stateStreamSuccessfulOperationCount_;
         ULONG32 beginSettingCurrentStateApiCount_;
@@ -26,9 +26,10 @@ LogRecord::LogRecord(
     , recordPosition_(Constants::InvalidRecordPosition)
     , previousPhysicalRecordOffset_(Constants::InvalidPhysicalRecordOffset)
     , previousPhysicalRecord_(&invalidPhysicalLogRecord)
-    , appliedTask_(CompletionTask::Create(GetThisAllocator()))
-    , flushedTask_(CompletionTask::Create(GetThisAllocator()))
-    , processedTask_(CompletionTask::Create(GetThisAllocator()))
+    , completionTasksLock_()
+    , appliedTask_()
+    , flushedTask_()
+    , processedTask_()
     , approximateDiskSize_(0)
 {
     ASSERT_IFNOT(
@@ -52,9 +53,10 @@ LogRecord::LogRecord(
     , recordPosition_(recordPosition)
     , previousPhysicalRecordOffset_(Constants::InvalidPhysicalRecordOffset)
     , previousPhysicalRecord_(&invalidPhysicalLogRecord)
-    , appliedTask_(CompletionTask::Create(GetThisAllocator()))
-    , flushedTask_(CompletionTask::Create(GetThisAllocator()))
-    , processedTask_(CompletionTask::Create(GetThisAllocator()))
+    , completionTasksLock_()
+    , appliedTask_()
+    , flushedTask_()
+    , processedTask_()
     , approximateDiskSize_(0)
 {
     ASSERT_IFNOT(
@@ -72,9 +74,10 @@ LogRecord::LogRecord()
     , recordPosition_(Constants::InvalidRecordPosition)
     , previousPhysicalRecordOffset_(Constants::InvalidPhysicalRecordOffset)
     , previousPhysicalRecord_(nullptr)
-    , appliedTask_(CompletionTask::Create(GetThisAllocator()))
-    , flushedTask_(CompletionTask::Create(GetThisAllocator()))
-    , processedTask_(CompletionTask::Create(GetThisAllocator()))
+    , completionTasksLock_()
+    , appliedTask_()
+    , flushedTask_()
+    , processedTask_()
     , approximateDiskSize_(0)
 {
     ASSERT_IFNOT(
@@ -86,6 +89,83 @@ LogRecord::~LogRecord()
 {
 }
 
+CompletionTask::SPtr LogRecord::GetOrCreateCompletionTask(__in LazyCompletionTask & lazyTask) const
+{
+    CompletionTask::SPtr task;
+    bool completeNow = false;
+
+    K_LOCK_BLOCK(completionTasksLock_)
+    {
+        if (lazyTask.Task == nullptr)
+        {
+            lazyTask.Task = CompletionTask::Create(GetThisAllocator());
+
+            // The stage may have completed before anyone asked for the task
+            completeNow = lazyTask.IsCompleted.load();
+        }
+
+        task = lazyTask.Task;
+    }
+
+    if (completeNow)
+    {
+        task->CompleteAwaiters(lazyTask.ErrorCode.load());
+    }
+
+    return task;
+}
+
+Awaitable<NTSTATUS> LogRecord::AwaitCompletionTaskAsync(__in LazyCompletionTask & lazyTask)
+{
+    if (lazyTask.IsCompleted.load())
+    {
+        co_return lazyTask.ErrorCode.load();
+    }
+
+    CompletionTask::SPtr task = GetOrCreateCompletionTask(lazyTask);
+
+    NTSTATUS status = co_await task->AwaitCompletion();
+    co_return status;
+}
+
+void LogRecord::CompleteCompletionTask(
+    __in LazyCompletionTask & lazyTask,
+    __in NTSTATUS errorCode)
+{
+    CompletionTask::SPtr task;
+
+    K_LOCK_BLOCK(completionTasksLock_)
+    {
+        ASSERT_IF(
+            lazyTask.IsCompleted.load(),
+            "Awaitable already completed. Cannot complete again");
+
+        lazyTask.ErrorCode.store(errorCode);
+        lazyTask.IsCompleted.store(true);
+        task = lazyTask.Task;
+    }
+
+    if (task != nullptr)
+    {
+        task->CompleteAwaiters(errorCode);
+    }
+}
+
+bool LogRecord::Test_IsCompletionTaskAllocated() const
+{
+    bool isAllocated = false;
+
+    K_LOCK_BLOCK(completionTasksLock_)
+    {
+        isAllocated =
+            appliedTask_.Task != nullptr ||
+            flushedTask_.Task != nullptr ||
+            processedTask_.Task != nullptr;
+    }
+
+    return isAllocated;
+}
+
 bool LogRecord::IsInvalid(__in_opt LogRecord const * const record)
 {
     return (record != nullptr) && (record->RecordType == LogRecordType::Enum::Invalid);
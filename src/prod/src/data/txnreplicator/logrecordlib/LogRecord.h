@@ -105,7 +105,7 @@ namespace Data
             __declspec(property(get = get_IsApplied)) bool IsApplied;
             bool get_IsApplied() const
             {
-                return appliedTask_->IsCompleted;
+                return appliedTask_.IsCompleted.load();
             }
 
             //
@@ -114,7 +114,7 @@ namespace Data
             __declspec(property(get = get_IsFlushed)) bool IsFlushed;
             bool get_IsFlushed() const
             {
-                return flushedTask_->IsCompleted;
+                return flushedTask_.IsCompleted.load();
             }
 
             //
@@ -124,13 +124,22 @@ namespace Data
             __declspec(property(get = get_IsProcessed)) bool IsProcessed;
             bool get_IsProcessed() const
             {
-                return processedTask_->IsCompleted;
+                return processedTask_.IsCompleted.load();
             }
 
+            //
+            // Same contract as CompletionTask::CompletionCode, which this used to return: the flush must have completed.
+            // The callers in OperationProcessor (Unlock, ProcessedLogicalRecord, ProcessedPhysicalRecord) run from the
+            // flushed records callbacks or after the record is applied, which only happens once it is flushed.
+            //
             __declspec(property(get = get_FlushError)) NTSTATUS FlushError;
             NTSTATUS get_FlushError() const
             {
-                return flushedTask_->CompletionCode;
+                ASSERT_IFNOT(
+                    flushedTask_.IsCompleted.load(),
+                    "Log record must be flushed before checking the flush error");
+
+                return flushedTask_.ErrorCode.load();
             }
 
             //
@@ -252,44 +261,50 @@ namespace Data
                 __in LONG64 newHeadPsn,
                 __in InvalidLogRecords & invalidLogRecords);
 
-            TxnReplicator::CompletionTask::SPtr const & GetAppliedTask() const
+            TxnReplicator::CompletionTask::SPtr GetAppliedTask() const
             {
-                return appliedTask_;
+                return GetOrCreateCompletionTask(appliedTask_);
             }
 
             ktl::Awaitable<NTSTATUS> AwaitApply()
             {
-                NTSTATUS status = co_await appliedTask_->AwaitCompletion();
+                NTSTATUS status = co_await AwaitCompletionTaskAsync(appliedTask_);
                 co_return status;
             }
 
             ktl::Awaitable<NTSTATUS> AwaitFlush()
             {
-                NTSTATUS status = co_await flushedTask_->AwaitCompletion();
+                NTSTATUS status = co_await AwaitCompletionTaskAsync(flushedTask_);
                 co_return status;
             }
 
             ktl::Awaitable<NTSTATUS> AwaitProcessing()
             {
-                NTSTATUS status = co_await processedTask_->AwaitCompletion();
+                NTSTATUS status = co_await AwaitCompletionTaskAsync(processedTask_);
                 co_return status;
             }
 
             void CompletedApply(__in NTSTATUS errorCode)
             {
-                appliedTask_->CompleteAwaiters(errorCode);
+                CompleteCompletionTask(appliedTask_, errorCode);
             }
 
             void CompletedFlush(__in NTSTATUS errorCode)
             {
-                flushedTask_->CompleteAwaiters(errorCode);
+                CompleteCompletionTask(flushedTask_, errorCode);
             }
 
             void CompletedProcessing()
             {
-                processedTask_->CompleteAwaiters(STATUS_SUCCESS);
+                CompleteCompletionTask(processedTask_, STATUS_SUCCESS);
             }
 
+            //
+            // Returns TRUE if the CompletionTask backing the apply, flush or processing awaitable has been allocated.
+            // Exposed for tests to verify that records which are never awaited do not allocate them.
+            //
+            bool Test_IsCompletionTaskAllocated() const;
+
             virtual bool Test_Equals(LogRecord const & other) const;
 
         protected:
@@ -352,6 +367,33 @@ namespace Data
 
         private:
 
+            //
+            // Completion state of the apply, flush and processing stages of the record.
+            // Most records are never awaited, so the CompletionTask is only allocated when a caller
+            // awaits the stage (or needs the task object) before it completes.
+            //
+            struct LazyCompletionTask
+            {
+                LazyCompletionTask()
+                    : IsCompleted(false)
+                    , ErrorCode(STATUS_SUCCESS)
+                    , Task()
+                {
+                }
+
+                Common::atomic_bool IsCompleted;
+                Common::atomic_long ErrorCode;
+                TxnReplicator::CompletionTask::SPtr Task;
+            };
+
+            TxnReplicator::CompletionTask::SPtr GetOrCreateCompletionTask(__in LazyCompletionTask & lazyTask) const;
+
+            ktl::Awaitable<NTSTATUS> AwaitCompletionTaskAsync(__in LazyCompletionTask & lazyTask);
+
+            void CompleteCompletionTask(
+                __in LazyCompletionTask & lazyTask,
+                __in NTSTATUS errorCode);
+
             static LogRecord::SPtr ReadRecordWithHeaders(
                 __in Utilities::BinaryReader & binaryReader,
                 __in ULONG64 recordPosition,
@@ -376,9 +418,10 @@ namespace Data
             ULONG recordLength_;
             ULONG64 previousPhysicalRecordOffset_;
 
-            TxnReplicator::CompletionTask::SPtr appliedTask_;
-            TxnReplicator::CompletionTask::SPtr flushedTask_;
-            TxnReplicator::CompletionTask::SPtr processedTask_;
+            mutable KSpinLock completionTasksLock_;
+            mutable LazyCompletionTask appliedTask_;
+            mutable LazyCompletionTask flushedTask_;
+            mutable LazyCompletionTask processedTask_;
 
             // The following fields are not persisted
             ULONG64 recordPosition_;
@@ -818,6 +818,8 @@ ktl::Awaitable<void> CheckpointManager::RestoreCheckpointAsync(
 
 ktl::Awaitable<void> CheckpointManager::BackupActiveStateProviders(
     __in KString const & backupDirectory,
+    __in CompressionCodec::Enum codec,
+    __in ULONG32 maxDegreeOfParallelism,
     __in CancellationToken const & cancellationToken)
 {
     KShared$ApiEntry();
@@ -860,7 +862,10 @@ ktl::Awaitable<void> CheckpointManager::BackupActiveStateProviders(
                     L"BackupActiveStateProviders: CreateFolder.",
                     Helper::CheckpointManager);
 
-                status = tasks.Append(metadataCSPtr->StateProvider->BackupCheckpointAsync(*folderName, cancellationToken));
+                // Uncompressed backups go through the original API so that they stay readable by any restore.
+                status = codec == CompressionCodec::None
+                    ? tasks.Append(metadataCSPtr->StateProvider->BackupCheckpointAsync(*folderName, cancellationToken))
+                    : tasks.Append(metadataCSPtr->StateProvider->BackupCompressedCheckpointAsync(*folderName, codec, maxDegreeOfParallelism, cancellationToken));
                 Helper::ThrowIfNecessary(
                     status,
                     TracePartitionId,
@@ -66,6 +66,8 @@ namespace Data
 
             ktl::Awaitable<void> BackupActiveStateProviders(
                 __in KString const & backupDirectory,
+                __in Utilities::CompressionCodec::Enum codec,
+                __in ULONG32 maxDegreeOfParallelism,
                 __in ktl::CancellationToken const & cancellationToken);
 
         public: // Read APIs.
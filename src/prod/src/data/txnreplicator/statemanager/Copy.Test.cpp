@@ -1768,6 +1768,34 @@ namespace StateManagerTests
         SyncAwait(this->Test_Copy_MultipleStateProvider_AllActiveCopied(16, 0, true, false));
     }
 
+    //
+    // Scenario:        Copy an SM with multiple active state providers that are checkpointed, reading more than one
+    //                  state provider stream at a time. The number of streams does not divide the number of state providers.
+    // Expected Result: All state providers are copied.
+    //
+    BOOST_AUTO_TEST_CASE(Copy_Checkpoint_MultipleActiveStateProviders_InterleavedStreams_AllActiveIsCopied)
+    {
+        ULONG32 maxInterleavedStreams = NamedOperationDataStream::MaxInterleavedStreams;
+        KFinally([&] { NamedOperationDataStream::MaxInterleavedStreams = maxInterleavedStreams; });
+
+        NamedOperationDataStream::MaxInterleavedStreams = 5;
+        SyncAwait(this->Test_Copy_MultipleStateProvider_AllActiveCopied(16, 0, true, false));
+    }
+
+    //
+    // Scenario:        Copy an SM with multiple active state providers that are checkpointed, reading one state provider
+    //                  stream at a time.
+    // Expected Result: All state providers are copied.
+    //
+    BOOST_AUTO_TEST_CASE(Copy_Checkpoint_MultipleActiveStateProviders_SingleStream_AllActiveIsCopied)
+    {
+        ULONG32 maxInterleavedStreams = NamedOperationDataStream::MaxInterleavedStreams;
+        KFinally([&] { NamedOperationDataStream::MaxInterleavedStreams = maxInterleavedStreams; });
+
+        NamedOperationDataStream::MaxInterleavedStreams = 1;
+        SyncAwait(this->Test_Copy_MultipleStateProvider_AllActiveCopied(16, 0, true, false));
+    }
+
     //
     // Scenario:        Copy an SM with multiple active state providers that are checkpointed.
     //                  Idle secondary getting the copy has all the state providers already.
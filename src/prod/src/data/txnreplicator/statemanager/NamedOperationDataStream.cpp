@@ -8,6 +8,8 @@
 using namespace Data::StateManager;
 using namespace ktl;
 
+ULONG32 NamedOperationDataStream::MaxInterleavedStreams = 4;
+
 NTSTATUS NamedOperationDataStream::Create(
     __in Data::Utilities::PartitionedReplicaId const & traceType, 
     __in SerializationMode::Enum serializationMode,
@@ -54,9 +56,15 @@ ktl::Awaitable<NTSTATUS> NamedOperationDataStream::GetNextAsync(
 
     NTSTATUS status = STATUS_UNSUCCESSFUL;
 
-    while (currentIndex_ < operationDataStreamCollection_.Count())
+    while (true)
     {
-        StateProviderDataStream namedOperationDataStream = operationDataStreamCollection_[currentIndex_];
+        ULONG index = GetNextStreamIndex();
+        if (index == MAXULONG)
+        {
+            break;
+        }
+
+        StateProviderDataStream namedOperationDataStream = operationDataStreamCollection_[index];
         ASSERT_IFNOT(
             namedOperationDataStream.OperationDataStream != nullptr,
             "{0}: GetNextAsync: OperationDataStream is null pointer.",
@@ -72,10 +80,24 @@ ktl::Awaitable<NTSTATUS> NamedOperationDataStream::GetNextAsync(
 
         if (operationData == nullptr)
         {
-            currentIndex_++;
+            // Stream is drained, stop reading from it.
+            if (index == 0)
+            {
+                currentIndex_++;
+            }
+            else
+            {
+                interleavedIndexes_.Remove(interleavedCursor_);
+            }
+
             continue;
         }
 
+        if (index != 0)
+        {
+            interleavedCursor_++;
+        }
+
         CopyNamedOperationData::CSPtr namedOperationData = nullptr;
         status = CopyNamedOperationData::Create(
             namedOperationDataStream.Info.StateProviderId,
@@ -104,6 +126,46 @@ ktl::Awaitable<NTSTATUS> NamedOperationDataStream::GetNextAsync(
     co_return status;
 }
 
+// Returns the index of the stream to read the next operation from, MAXULONG when all streams are drained.
+ULONG NamedOperationDataStream::GetNextStreamIndex()
+{
+    // State manager stream first.
+    if (currentIndex_ == 0)
+    {
+        return operationDataStreamCollection_.Count() > 0 ? 0 : MAXULONG;
+    }
+
+    // Admit new streams into the round robin as drained ones leave it.
+    ULONG32 maxInterleavedStreams = MaxInterleavedStreams == 0 ? 1 : MaxInterleavedStreams;
+    while (interleavedIndexes_.Count() < maxInterleavedStreams && currentIndex_ < operationDataStreamCollection_.Count())
+    {
+        NTSTATUS status = interleavedIndexes_.Append(currentIndex_);
+        if (NT_SUCCESS(status) == false)
+        {
+            Helper::ThrowIfNecessary(
+                status,
+                TracePartitionId,
+                ReplicaId,
+                L"GetNextStreamIndex: Append stream index to interleavedIndexes.",
+                Helper::NamedOperationDataStream);
+        }
+
+        currentIndex_++;
+    }
+
+    if (interleavedIndexes_.Count() == 0)
+    {
+        return MAXULONG;
+    }
+
+    if (interleavedCursor_ >= interleavedIndexes_.Count())
+    {
+        interleavedCursor_ = 0;
+    }
+
+    return interleavedIndexes_[interleavedCursor_];
+}
+
 void NamedOperationDataStream::Dispose()
 {
     if (isDisposed_ == true || operationDataStreamCollection_.Count() == 0)
@@ -131,6 +193,7 @@ NamedOperationDataStream::NamedOperationDataStream(
     , PartitionedReplicaTraceComponent(traceType)
     , serializationMode_(serializationMode)
     , operationDataStreamCollection_(GetThisAllocator())
+    , interleavedIndexes_(GetThisAllocator())
 {
 }
 
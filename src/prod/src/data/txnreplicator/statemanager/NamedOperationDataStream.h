@@ -20,6 +20,11 @@ namespace Data
 
             K_SHARED_INTERFACE_IMP(IDisposable)
 
+        public:
+            // Number of state provider streams read round robin, so that the chunks of one state provider are
+            // replicated while the next chunks of the others are being read. Exposed for testing, normally 4.
+            static ULONG32 MaxInterleavedStreams;
+
         public:
             static NTSTATUS Create(
                 __in Utilities::PartitionedReplicaId const & traceType,
@@ -79,6 +84,8 @@ namespace Data
                 __in Utilities::PartitionedReplicaId const & traceType,
                 __in SerializationMode::Enum serializationMode);
 
+            ULONG GetNextStreamIndex();
+
         private:
             SerializationMode::Enum const serializationMode_;
 
@@ -95,6 +102,14 @@ namespace Data
 
             ULONG currentIndex_ = 0;
 
+            /// <summary>
+            /// Indexes of the state provider streams currently being interleaved and the next one to read from.
+            /// The first stream belongs to the state manager and is always drained before the others start,
+            /// since the state providers have to exist on the secondary before their state is copied.
+            /// </summary>
+            KArray<ULONG> interleavedIndexes_;
+            ULONG interleavedCursor_ = 0;
+
         private:
             /// <summary>
             /// Collection of operation data.
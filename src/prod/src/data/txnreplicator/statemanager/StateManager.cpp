@@ -1339,6 +1339,99 @@ Awaitable<NTSTATUS> StateManager::ApplyAsync(
     co_return STATUS_SUCCESS;
 }
 
+Awaitable<NTSTATUS> StateManager::ApplyBatchAsync(
+    __in TransactionBase const & transactionBase,
+    __in ApplyContext::Enum applyContext,
+    __in KArray<LONG64> const & logicalSequenceNumbers,
+    __in KArray<OperationData::CSPtr> const & metadataArray,
+    __in KArray<OperationData::CSPtr> const & dataArray,
+    __inout KArray<TxnReplicator::OperationContext::CSPtr> & results) noexcept
+{
+    ApiEntryAsync();
+
+    ULONG32 count = metadataArray.Count();
+    ASSERT_IFNOT(
+        logicalSequenceNumbers.Count() == count && dataArray.Count() == count,
+        "{0}: Batch apply array size mismatch. LSNs: {1} Metadata: {2} Data: {3}",
+        TraceId,
+        logicalSequenceNumbers.Count(),
+        count,
+        dataArray.Count());
+
+    try
+    {
+        ApplyContext::Enum roleType = static_cast<ApplyContext::Enum>(applyContext & ApplyContext::ROLE_MASK);
+
+        FABRIC_REPLICA_ROLE role = GetCurrentRole();
+
+        KArray<NamedOperationData::CSPtr> namedOperations(GetThisAllocator(), count);
+        THROW_ON_CONSTRUCTOR_FAILURE(namedOperations);
+
+        for (ULONG32 i = 0; i < count; i++)
+        {
+            ASSERT_IFNOT(metadataArray[i] != nullptr, "{0}: Null metadata object", TraceId);
+
+            NamedOperationData::CSPtr namedOperationDataSPtr = nullptr;
+            if (role == FABRIC_REPLICA_ROLE_PRIMARY)
+            {
+                ASSERT_IFNOT(transactionBase.IsPrimaryTransaction, "{0}: Non-Primary xact during apply", TraceId);
+                ASSERT_IFNOT(roleType == ApplyContext::PRIMARY, "{0}: Role type is not Primary during apply", TraceId);
+
+                NamedOperationData const * const namedOperationDataPtr = dynamic_cast<NamedOperationData const * const>(metadataArray[i].RawPtr());
+                namedOperationDataSPtr = namedOperationDataPtr;
+            }
+            else
+            {
+                ASSERT_IF(transactionBase.IsPrimaryTransaction, "{0}: Primary xact during apply on non primary role", TraceId);
+                ASSERT_IFNOT(roleType != ApplyContext::PRIMARY, "{0}: Unexpected Primary role type encountered during apply", TraceId);
+
+                NTSTATUS status = NamedOperationData::Create(GetThisAllocator(), metadataArray[i].RawPtr(), namedOperationDataSPtr);
+                if (NT_SUCCESS(status) == false)
+                {
+                    TraceError(L"ApplyBatchAsync: NamedOperationData::Create", status);
+                    co_return status;
+                }
+            }
+
+            NTSTATUS status = namedOperations.Append(namedOperationDataSPtr);
+            THROW_ON_FAILURE(status);
+        }
+
+        // Operations are only grouped while they are consecutive so that the apply order across state
+        // providers within the transaction is the same as with ApplyAsync.
+        ULONG32 startIndex = 0;
+        while (startIndex < count)
+        {
+            FABRIC_STATE_PROVIDER_ID stateProviderId = namedOperations[startIndex]->StateProviderId;
+
+            ULONG32 endIndex = startIndex + 1;
+            while (endIndex < count && namedOperations[endIndex]->StateProviderId == stateProviderId)
+            {
+                endIndex++;
+            }
+
+            co_await this->ApplyBatchAsync(
+                transactionBase,
+                applyContext,
+                stateProviderId,
+                logicalSequenceNumbers,
+                namedOperations,
+                dataArray,
+                startIndex,
+                endIndex - startIndex,
+                results);
+
+            startIndex = endIndex;
+        }
+    }
+    catch (Exception & e)
+    {
+        co_return e.GetStatus();
+    }
+
+    co_return STATUS_SUCCESS;
+}
+
 NTSTATUS StateManager::Unlock(
     __in OperationContext const& operationContext) noexcept
 {
@@ -1529,7 +1622,11 @@ ktl::Awaitable<NTSTATUS> StateManager::BackupCheckpointAsync(
             cancellationToken);
 
         // Backup all active state providers in the CopyOrCheckpointMetadataSnapshot
-        co_await checkpointManagerSPtr_->BackupActiveStateProviders(backupDirectory, cancellationToken);
+        co_await checkpointManagerSPtr_->BackupActiveStateProviders(
+            backupDirectory,
+            static_cast<CompressionCodec::Enum>(transactionalReplicatorConfig_->BackupCompressionCodec),
+            static_cast<ULONG32>(transactionalReplicatorConfig_->BackupDegreeOfParallelism),
+            cancellationToken);
     }
     catch (Exception & exception)
     {
@@ -2859,6 +2956,121 @@ Awaitable<OperationContext::CSPtr> StateManager::ApplyAsync(
     co_return operationContextSPtr.RawPtr();
 }
 
+Awaitable<void> StateManager::ApplyBatchAsync(
+    __in TransactionBase const & transactionBase,
+    __in ApplyContext::Enum applyContext,
+    __in FABRIC_STATE_PROVIDER_ID stateProviderId,
+    __in KArray<LONG64> const & logicalSequenceNumbers,
+    __in KArray<NamedOperationData::CSPtr> const & namedOperations,
+    __in KArray<OperationData::CSPtr> const & dataArray,
+    __in ULONG32 startIndex,
+    __in ULONG32 count,
+    __inout KArray<OperationContext::CSPtr> & results)
+{
+    ApiEntry();
+
+    ASSERT_IFNOT(stateProviderId != EmptyStateProviderId, "{0}: Empty state provider during apply, StateProviderId: {1}.", TraceId, stateProviderId);
+
+    NTSTATUS status = STATUS_SUCCESS;
+
+    IBatchedApplyStateProvider::SPtr batchedApplyStateProvider = nullptr;
+    if (count > 1 &&
+        stateProviderId != StateManagerId &&
+        !metadataManagerSPtr_->IsStateProviderDeletedOrStale(stateProviderId, MetadataMode::DelayDelete))
+    {
+        Metadata::SPtr metadataSPtr = nullptr;
+        bool isExist = metadataManagerSPtr_->TryGetMetadata(stateProviderId, metadataSPtr);
+        ASSERT_IFNOT(
+            isExist,
+            "{0}: MetadataSPtr cannot be nullptr. SPID {1}",
+            TraceId,
+            stateProviderId);
+
+        batchedApplyStateProvider = dynamic_cast<IBatchedApplyStateProvider *>(metadataSPtr->StateProvider.RawPtr());
+    }
+
+    if (batchedApplyStateProvider == nullptr)
+    {
+        for (ULONG32 i = startIndex; i < startIndex + count; i++)
+        {
+            OperationContext::CSPtr result = co_await this->ApplyAsync(
+                logicalSequenceNumbers[i],
+                transactionBase,
+                applyContext,
+                stateProviderId,
+                namedOperations[i]->UserOperationDataCSPtr.RawPtr(),
+                dataArray[i].RawPtr());
+
+            status = results.Append(result);
+            THROW_ON_FAILURE(status);
+        }
+
+        co_return;
+    }
+
+    KArray<LONG64> batchSequenceNumbers(GetThisAllocator(), count);
+    THROW_ON_CONSTRUCTOR_FAILURE(batchSequenceNumbers);
+
+    KArray<OperationData::CSPtr> batchMetadata(GetThisAllocator(), count);
+    THROW_ON_CONSTRUCTOR_FAILURE(batchMetadata);
+
+    KArray<OperationData::CSPtr> batchData(GetThisAllocator(), count);
+    THROW_ON_CONSTRUCTOR_FAILURE(batchData);
+
+    KArray<OperationContext::CSPtr> batchResults(GetThisAllocator(), count);
+    THROW_ON_CONSTRUCTOR_FAILURE(batchResults);
+
+    for (ULONG32 i = startIndex; i < startIndex + count; i++)
+    {
+        status = batchSequenceNumbers.Append(logicalSequenceNumbers[i]);
+        THROW_ON_FAILURE(status);
+
+        status = batchMetadata.Append(namedOperations[i]->UserOperationDataCSPtr);
+        THROW_ON_FAILURE(status);
+
+        status = batchData.Append(dataArray[i]);
+        THROW_ON_FAILURE(status);
+    }
+
+    co_await batchedApplyStateProvider->ApplyBatchAsync(
+        transactionBase,
+        applyContext,
+        batchSequenceNumbers,
+        batchMetadata,
+        batchData,
+        batchResults);
+
+    ASSERT_IFNOT(
+        batchResults.Count() == count,
+        "{0}: State provider returned {1} operation contexts for a batch of {2}. SPID {3}",
+        TraceId,
+        batchResults.Count(),
+        count,
+        stateProviderId);
+
+    for (ULONG32 i = 0; i < count; i++)
+    {
+        OperationContext::CSPtr result = nullptr;
+
+        if (batchResults[i] != nullptr)
+        {
+            NamedOperationContext::SPtr operationContextSPtr;
+            status = NamedOperationContext::Create(batchResults[i].RawPtr(), stateProviderId, GetThisAllocator(), operationContextSPtr);
+            Helper::ThrowIfNecessary(
+                status,
+                TracePartitionId,
+                ReplicaId,
+                L"ApplyBatchAsync: Create NamedOperationContext.",
+                Helper::StateManager);
+
+            result = operationContextSPtr.RawPtr();
+        }
+
+        status = results.Append(result);
+        THROW_ON_FAILURE(status);
+    }
+}
+
 VOID StateManager::OnServiceOpen()
 {
     OnServiceOpenAsync();
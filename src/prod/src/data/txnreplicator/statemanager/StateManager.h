@@ -179,6 +179,14 @@ namespace Data
                 __in_opt Data::Utilities::OperationData const * const dataPtr,
                 __out TxnReplicator::OperationContext::CSPtr & result) noexcept override;
 
+            ktl::Awaitable<NTSTATUS> ApplyBatchAsync(
+                __in TxnReplicator::TransactionBase const & transactionBase,
+                __in TxnReplicator::ApplyContext::Enum applyContext,
+                __in KArray<LONG64> const & logicalSequenceNumbers,
+                __in KArray<Data::Utilities::OperationData::CSPtr> const & metadataArray,
+                __in KArray<Data::Utilities::OperationData::CSPtr> const & dataArray,
+                __inout KArray<TxnReplicator::OperationContext::CSPtr> & results) noexcept override;
+
             NTSTATUS Unlock(__in TxnReplicator::OperationContext const & operationContext) noexcept override;
 
             NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept override;
@@ -278,6 +286,18 @@ namespace Data
                 __in_opt Utilities::OperationData const * const metadataPtr,
                 __in_opt Utilities::OperationData const * const dataPtr);
 
+            // Applies namedOperations[startIndex, startIndex + count), which all target stateProviderId.
+            ktl::Awaitable<void> ApplyBatchAsync(
+                __in TxnReplicator::TransactionBase const & transactionBase,
+                __in TxnReplicator::ApplyContext::Enum applyContext,
+                __in FABRIC_STATE_PROVIDER_ID stateProviderId,
+                __in KArray<LONG64> const & logicalSequenceNumbers,
+                __in KArray<NamedOperationData::CSPtr> const & namedOperations,
+                __in KArray<Utilities::OperationData::CSPtr> const & dataArray,
+                __in ULONG32 startIndex,
+                __in ULONG32 count,
+                __inout KArray<TxnReplicator::OperationContext::CSPtr> & results);
+
             void AddChildrenToList(
                 __in Metadata & metadata, 
                 __inout KSharedArray<Metadata::SPtr>::SPtr & children);
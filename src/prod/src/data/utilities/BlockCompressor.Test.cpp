@@ -0,0 +1,282 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace UtilitiesTests
+{
+    using namespace ktl;
+    using namespace Data::Utilities;
+
+    class BlockCompressorTests
+    {
+    public:
+        Common::CommonConfig config; // load the config object as its needed for the tracing to work
+
+        BlockCompressorTests()
+        {
+            NTSTATUS status;
+            status = KtlSystem::Initialize(FALSE, &ktlSystem_);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+            ktlSystem_->SetStrictAllocationChecks(TRUE);
+        }
+
+        ~BlockCompressorTests()
+        {
+            ktlSystem_->Shutdown();
+        }
+
+        KAllocator& GetAllocator()
+        {
+            return ktlSystem_->PagedAllocator();
+        }
+
+        static std::vector<byte> CreateRandomBuffer(__in ULONG32 size, __in int seed)
+        {
+            Common::Random random(seed);
+            std::vector<byte> buffer(size);
+            random.NextBytes(buffer);
+
+            return buffer;
+        }
+
+        // Repeated records with a few random bytes, similar to serialized keys and values.
+        static std::vector<byte> CreateCompressibleBuffer(__in ULONG32 size, __in int seed)
+        {
+            Common::Random random(seed);
+            std::vector<byte> buffer(size);
+            for (ULONG32 i = 0; i < size; i++)
+            {
+                buffer[i] = (i % 64 < 8) ? static_cast<byte>(random.Next(256)) : static_cast<byte>(i % 64);
+            }
+
+            return buffer;
+        }
+
+        static std::vector<byte> RoundTrip(__in std::vector<byte> const & input, __out ULONG32 & compressedSize)
+        {
+            std::vector<byte> compressed(BlockCompressor::GetMaxCompressedSize(static_cast<ULONG32>(input.size())));
+            compressedSize = BlockCompressor::Compress(input.data(), static_cast<ULONG32>(input.size()), compressed.data(), static_cast<ULONG32>(compressed.size()));
+            CODING_ERROR_ASSERT(compressedSize > 0);
+
+            std::vector<byte> output(input.size());
+            bool result = BlockCompressor::Decompress(compressed.data(), compressedSize, output.data(), static_cast<ULONG32>(output.size()));
+            CODING_ERROR_ASSERT(result);
+
+            return output;
+        }
+
+        KString::SPtr CreateFilePath(__in LPCWSTR name)
+        {
+            WCHAR currentDirectoryPathCharArray[MAX_PATH];
+            GetCurrentDirectory(MAX_PATH, currentDirectoryPathCharArray);
+            PathAppendW(currentDirectoryPathCharArray, name);
+
+#if !defined(PLATFORM_UNIX)
+            KStringView prefix(L"\\??\\");
+#else
+            KStringView prefix(L"");
+#endif
+            KString::SPtr result;
+            NTSTATUS status = KString::Create(result, GetAllocator(), prefix);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            BOOLEAN concatResult = result->Concat(currentDirectoryPathCharArray);
+            CODING_ERROR_ASSERT(concatResult == TRUE);
+
+            return result;
+        }
+
+        static std::wstring ToPath(__in KString const & path)
+        {
+#if !defined(PLATFORM_UNIX)
+            return std::wstring(static_cast<LPCWSTR>(path) + 4);
+#else
+            return std::wstring(static_cast<LPCWSTR>(path));
+#endif
+        }
+
+        static void WriteFile(__in KString const & path, __in std::vector<byte> const & content)
+        {
+            Common::File file;
+            auto error = file.TryOpen(ToPath(path), Common::FileMode::Create, Common::FileAccess::Write, Common::FileShare::ReadWrite);
+            CODING_ERROR_ASSERT(error.IsSuccess());
+
+            if (!content.empty())
+            {
+                file.Write(content.data(), static_cast<int>(content.size()));
+            }
+
+            file.Close();
+        }
+
+        static std::vector<byte> ReadFile(__in KString const & path)
+        {
+            Common::File file;
+            auto error = file.TryOpen(ToPath(path), Common::FileMode::Open, Common::FileAccess::Read, Common::FileShare::ReadWrite);
+            CODING_ERROR_ASSERT(error.IsSuccess());
+
+            std::vector<byte> content(static_cast<size_t>(file.size()));
+            if (!content.empty())
+            {
+                file.Read(content.data(), static_cast<int>(content.size()));
+            }
+
+            file.Close();
+            return content;
+        }
+
+        void VerifyFileRoundTrip(__in std::vector<byte> const & content, __in CompressionCodec::Enum codec, __in ULONG32 maxDegreeOfParallelism)
+        {
+            KString::SPtr sourcePath = CreateFilePath(L"CompressedFileTest.src");
+            KString::SPtr compressedPath = CreateFilePath(L"CompressedFileTest.cmp");
+            KString::SPtr restoredPath = CreateFilePath(L"CompressedFileTest.dst");
+
+            WriteFile(*sourcePath, content);
+
+            ULONG64 compressedSize = SyncAwait(CompressedFile::CompressAsync(*sourcePath, *compressedPath, codec, maxDegreeOfParallelism, GetAllocator(), CancellationToken::None));
+            CODING_ERROR_ASSERT(compressedSize == ReadFile(*compressedPath).size());
+
+            ULONG64 restoredSize = SyncAwait(CompressedFile::DecompressAsync(*compressedPath, *restoredPath, maxDegreeOfParallelism, GetAllocator(), CancellationToken::None));
+            CODING_ERROR_ASSERT(restoredSize == content.size());
+            CODING_ERROR_ASSERT(ReadFile(*restoredPath) == content);
+
+            Common::File::Delete(ToPath(*sourcePath), Common::NOTHROW());
+            Common::File::Delete(ToPath(*compressedPath), Common::NOTHROW());
+            Common::File::Delete(ToPath(*restoredPath), Common::NOTHROW());
+        }
+
+    private:
+        KtlSystem* ktlSystem_;
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(BlockCompressorTestSuite, BlockCompressorTests);
+
+    BOOST_AUTO_TEST_CASE(Compress_Empty_RoundTrips)
+    {
+        std::vector<byte> input;
+        ULONG32 compressedSize = 0;
+
+        std::vector<byte> output = RoundTrip(input, compressedSize);
+        CODING_ERROR_ASSERT(output.empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(Compress_SmallInputs_RoundTrip)
+    {
+        for (ULONG32 size = 1; size < 300; size++)
+        {
+            std::vector<byte> input = (size % 2 == 0) ? CreateRandomBuffer(size, size) : CreateCompressibleBuffer(size, size);
+            ULONG32 compressedSize = 0;
+
+            CODING_ERROR_ASSERT(RoundTrip(input, compressedSize) == input);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(Compress_RandomData_FitsInMaxCompressedSize)
+    {
+        std::vector<byte> input = CreateRandomBuffer(1024 * 1024, 3);
+        ULONG32 compressedSize = 0;
+
+        CODING_ERROR_ASSERT(RoundTrip(input, compressedSize) == input);
+        CODING_ERROR_ASSERT(compressedSize <= BlockCompressor::GetMaxCompressedSize(static_cast<ULONG32>(input.size())));
+    }
+
+    BOOST_AUTO_TEST_CASE(Compress_CompressibleData_IsSmaller)
+    {
+        std::vector<byte> input = CreateCompressibleBuffer(1024 * 1024, 5);
+        ULONG32 compressedSize = 0;
+
+        CODING_ERROR_ASSERT(RoundTrip(input, compressedSize) == input);
+        CODING_ERROR_ASSERT(compressedSize < input.size() / 2);
+    }
+
+    BOOST_AUTO_TEST_CASE(Compress_DestinationTooSmall_ReturnsZero)
+    {
+        std::vector<byte> input = CreateRandomBuffer(4096, 7);
+        std::vector<byte> compressed(input.size() - 1);
+
+        ULONG32 compressedSize = BlockCompressor::Compress(input.data(), static_cast<ULONG32>(input.size()), compressed.data(), static_cast<ULONG32>(compressed.size()));
+        CODING_ERROR_ASSERT(compressedSize == 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(Decompress_CorruptInput_ReturnsFalseOrDifferentData)
+    {
+        std::vector<byte> input = CreateCompressibleBuffer(64 * 1024, 11);
+        std::vector<byte> compressed(BlockCompressor::GetMaxCompressedSize(static_cast<ULONG32>(input.size())));
+        ULONG32 compressedSize = BlockCompressor::Compress(input.data(), static_cast<ULONG32>(input.size()), compressed.data(), static_cast<ULONG32>(compressed.size()));
+        CODING_ERROR_ASSERT(compressedSize > 0);
+
+        // Wrong original size
+        std::vector<byte> output(input.size() + 1);
+        CODING_ERROR_ASSERT(!BlockCompressor::Decompress(compressed.data(), compressedSize, output.data(), static_cast<ULONG32>(input.size() - 1)));
+        CODING_ERROR_ASSERT(!BlockCompressor::Decompress(compressed.data(), compressedSize, output.data(), static_cast<ULONG32>(input.size() + 1)));
+
+        // Truncated input
+        CODING_ERROR_ASSERT(!BlockCompressor::Decompress(compressed.data(), compressedSize - 1, output.data(), static_cast<ULONG32>(input.size())));
+
+        // Flipped bytes must never read or write out of bounds
+        Common::Random random(13);
+        for (int i = 0; i < 1000; i++)
+        {
+            std::vector<byte> corrupt(compressed.begin(), compressed.begin() + compressedSize);
+            corrupt[random.Next(static_cast<int>(compressedSize))] ^= static_cast<byte>(random.Next(1, 256));
+            BlockCompressor::Decompress(corrupt.data(), compressedSize, output.data(), static_cast<ULONG32>(input.size()));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(CompressedFile_RoundTrip_Success)
+    {
+        VerifyFileRoundTrip(std::vector<byte>(), CompressionCodec::Lz, 4);
+        VerifyFileRoundTrip(CreateRandomBuffer(1000, 17), CompressionCodec::Lz, 4);
+        VerifyFileRoundTrip(CreateRandomBuffer(CompressedFile::DefaultBlockSize * 3 + 5, 19), CompressionCodec::Lz, 2);
+        VerifyFileRoundTrip(CreateCompressibleBuffer(CompressedFile::DefaultBlockSize * 5, 23), CompressionCodec::Lz, 4);
+        VerifyFileRoundTrip(CreateCompressibleBuffer(CompressedFile::DefaultBlockSize * 2 + 1, 29), CompressionCodec::Lz, 1);
+        VerifyFileRoundTrip(CreateCompressibleBuffer(CompressedFile::DefaultBlockSize + 7, 31), CompressionCodec::None, 4);
+    }
+
+    BOOST_AUTO_TEST_CASE(CompressedFile_Corruption_Throws)
+    {
+        KString::SPtr sourcePath = CreateFilePath(L"CompressedFileCorruptionTest.src");
+        KString::SPtr compressedPath = CreateFilePath(L"CompressedFileCorruptionTest.cmp");
+        KString::SPtr restoredPath = CreateFilePath(L"CompressedFileCorruptionTest.dst");
+
+        WriteFile(*sourcePath, CreateCompressibleBuffer(CompressedFile::DefaultBlockSize * 2, 37));
+        SyncAwait(CompressedFile::CompressAsync(*sourcePath, *compressedPath, CompressionCodec::Lz, 4, GetAllocator(), CancellationToken::None));
+
+        std::vector<byte> compressed = ReadFile(*compressedPath);
+
+        // Flipped byte in the data, truncated file and trailing bytes
+        std::vector<std::vector<byte>> corruptFiles(3, compressed);
+        corruptFiles[0][compressed.size() / 2] ^= 0xFF;
+        corruptFiles[1].resize(compressed.size() - 1);
+        corruptFiles[2].push_back(0);
+
+        for (std::vector<byte> const & corruptFile : corruptFiles)
+        {
+            WriteFile(*compressedPath, corruptFile);
+
+            NTSTATUS status = STATUS_SUCCESS;
+            try
+            {
+                SyncAwait(CompressedFile::DecompressAsync(*compressedPath, *restoredPath, 4, GetAllocator(), CancellationToken::None));
+            }
+            catch (Exception const & e)
+            {
+                status = e.GetStatus();
+            }
+
+            CODING_ERROR_ASSERT(status == STATUS_INTERNAL_DB_CORRUPTION);
+        }
+
+        Common::File::Delete(ToPath(*sourcePath), Common::NOTHROW());
+        Common::File::Delete(ToPath(*compressedPath), Common::NOTHROW());
+        Common::File::Delete(ToPath(*restoredPath), Common::NOTHROW());
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
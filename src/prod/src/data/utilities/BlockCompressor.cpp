@@ -0,0 +1,327 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Data::Utilities;
+
+namespace
+{
+    // Shortest back reference worth encoding: token + 2 offset bytes are smaller than the match.
+    ULONG32 const MinMatch = 4;
+
+    // The last bytes of a block are always literals so that the matcher never reads past the end.
+    ULONG32 const LastLiterals = 5;
+    ULONG32 const MatchSearchLimit = MinMatch + LastLiterals + 3;
+
+    ULONG32 const MaxOffset = 65535;
+    ULONG32 const HashLog = 12;
+    ULONG32 const HashTableSize = 1 << HashLog;
+
+    // Every 2^SkipTrigger misses the search step grows by one, so incompressible data is scanned quickly.
+    ULONG32 const SkipTrigger = 6;
+
+    ULONG32 const NibbleMask = 15;
+
+    ULONG32 Read32(__in byte const * p)
+    {
+        ULONG32 value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    ULONG32 Hash(__in ULONG32 sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - HashLog);
+    }
+
+    // Writes the extension bytes of a length that did not fit in its nibble.
+    bool WriteLength(__in ULONG32 length, __inout byte * & output, __in byte const * outputEnd)
+    {
+        while (length >= 255)
+        {
+            if (output >= outputEnd)
+            {
+                return false;
+            }
+
+            *output++ = 255;
+            length -= 255;
+        }
+
+        if (output >= outputEnd)
+        {
+            return false;
+        }
+
+        *output++ = static_cast<byte>(length);
+        return true;
+    }
+
+    bool ReadLength(__inout byte const * & input, __in byte const * inputEnd, __inout ULONG32 & length)
+    {
+        byte value;
+        do
+        {
+            if (input >= inputEnd)
+            {
+                return false;
+            }
+
+            value = *input++;
+            length += value;
+
+            // Larger than any block, the input is corrupt.
+            if (length > MAXLONG)
+            {
+                return false;
+            }
+        } while (value == 255);
+
+        return true;
+    }
+
+    bool WriteSequence(
+        __in byte const * literals,
+        __in ULONG32 literalLength,
+        __in ULONG32 offset,
+        __in ULONG32 matchLength,
+        __inout byte * & output,
+        __in byte const * outputEnd)
+    {
+        if (output >= outputEnd)
+        {
+            return false;
+        }
+
+        byte * token = output++;
+        *token = static_cast<byte>((literalLength < NibbleMask ? literalLength : NibbleMask) << 4);
+        if (literalLength >= NibbleMask && !WriteLength(literalLength - NibbleMask, output, outputEnd))
+        {
+            return false;
+        }
+
+        if (static_cast<ULONG32>(outputEnd - output) < literalLength)
+        {
+            return false;
+        }
+
+        if (literalLength > 0)
+        {
+            memcpy(output, literals, literalLength);
+            output += literalLength;
+        }
+
+        // Last sequence
+        if (matchLength == 0)
+        {
+            return true;
+        }
+
+        if (outputEnd - output < 2)
+        {
+            return false;
+        }
+
+        *output++ = static_cast<byte>(offset & 0xFF);
+        *output++ = static_cast<byte>(offset >> 8);
+
+        ULONG32 encodedMatchLength = matchLength - MinMatch;
+        *token |= static_cast<byte>(encodedMatchLength < NibbleMask ? encodedMatchLength : NibbleMask);
+        if (encodedMatchLength >= NibbleMask && !WriteLength(encodedMatchLength - NibbleMask, output, outputEnd))
+        {
+            return false;
+        }
+
+        return true;
+    }
+}
+
+bool BlockCompressor::IsCodecSupported(__in CompressionCodec::Enum codec)
+{
+    return codec == CompressionCodec::None || codec == CompressionCodec::Lz;
+}
+
+ULONG32 BlockCompressor::GetMaxCompressedSize(__in ULONG32 sourceCount)
+{
+    // Incompressible data is one literal run: a token, one length byte for every 255 literals and the literals.
+    return sourceCount + (sourceCount / 255) + 16;
+}
+
+ULONG32 BlockCompressor::Compress(
+    __in_bcount(sourceCount) byte const * source,
+    __in ULONG32 sourceCount,
+    __out_bcount(destinationCapacity) byte * destination,
+    __in ULONG32 destinationCapacity)
+{
+    byte * output = destination;
+    byte const * outputEnd = destination + destinationCapacity;
+
+    byte const * input = source;
+    byte const * anchor = source;
+    byte const * inputEnd = source + sourceCount;
+
+    if (sourceCount >= MatchSearchLimit)
+    {
+        // Positions relative to the source, so 0 is a valid candidate only for the first sequence.
+        ULONG32 hashTable[HashTableSize];
+        memset(hashTable, 0, sizeof(hashTable));
+
+        byte const * matchLimit = inputEnd - LastLiterals;
+        byte const * searchLimit = inputEnd - MatchSearchLimit;
+
+        input++;
+        while (input <= searchLimit)
+        {
+            byte const * match = nullptr;
+            ULONG32 attempts = 1 << SkipTrigger;
+
+            // Find a 4 byte match within the window
+            while (true)
+            {
+                ULONG32 sequence = Read32(input);
+                ULONG32 hash = Hash(sequence);
+                match = source + hashTable[hash];
+                hashTable[hash] = static_cast<ULONG32>(input - source);
+
+                if (input - match <= MaxOffset && match < input && Read32(match) == sequence)
+                {
+                    break;
+                }
+
+                input += attempts++ >> SkipTrigger;
+                if (input > searchLimit)
+                {
+                    match = nullptr;
+                    break;
+                }
+            }
+
+            if (match == nullptr)
+            {
+                break;
+            }
+
+            // Extend the match backwards over pending literals
+            while (input > anchor && match > source && input[-1] == match[-1])
+            {
+                input--;
+                match--;
+            }
+
+            // Extend the match forwards
+            ULONG32 matchLength = MinMatch;
+            while (input + matchLength < matchLimit && input[matchLength] == match[matchLength])
+            {
+                matchLength++;
+            }
+
+            if (!WriteSequence(
+                anchor,
+                static_cast<ULONG32>(input - anchor),
+                static_cast<ULONG32>(input - match),
+                matchLength,
+                output,
+                outputEnd))
+            {
+                return 0;
+            }
+
+            input += matchLength;
+            anchor = input;
+
+            // Index a position inside the match to improve the next search
+            if (input - 2 > source)
+            {
+                hashTable[Hash(Read32(input - 2))] = static_cast<ULONG32>(input - 2 - source);
+            }
+        }
+    }
+
+    if (!WriteSequence(anchor, static_cast<ULONG32>(inputEnd - anchor), 0, 0, output, outputEnd))
+    {
+        return 0;
+    }
+
+    return static_cast<ULONG32>(output - destination);
+}
+
+bool BlockCompressor::Decompress(
+    __in_bcount(sourceCount) byte const * source,
+    __in ULONG32 sourceCount,
+    __out_bcount(destinationCount) byte * destination,
+    __in ULONG32 destinationCount)
+{
+    byte const * input = source;
+    byte const * inputEnd = source + sourceCount;
+
+    byte * output = destination;
+    byte * outputEnd = destination + destinationCount;
+
+    while (input < inputEnd)
+    {
+        byte token = *input++;
+
+        ULONG32 literalLength = token >> 4;
+        if (literalLength == NibbleMask && !ReadLength(input, inputEnd, literalLength))
+        {
+            return false;
+        }
+
+        if (static_cast<ULONG32>(inputEnd - input) < literalLength || static_cast<ULONG32>(outputEnd - output) < literalLength)
+        {
+            return false;
+        }
+
+        if (literalLength > 0)
+        {
+            memcpy(output, input, literalLength);
+            input += literalLength;
+            output += literalLength;
+        }
+
+        // Last sequence has no match
+        if (input == inputEnd)
+        {
+            break;
+        }
+
+        if (inputEnd - input < 2)
+        {
+            return false;
+        }
+
+        ULONG32 offset = static_cast<ULONG32>(input[0]) | (static_cast<ULONG32>(input[1]) << 8);
+        input += 2;
+
+        if (offset == 0 || offset > static_cast<ULONG32>(output - destination))
+        {
+            return false;
+        }
+
+        ULONG32 matchLength = token & NibbleMask;
+        if (matchLength == NibbleMask && !ReadLength(input, inputEnd, matchLength))
+        {
+            return false;
+        }
+
+        matchLength += MinMatch;
+        if (static_cast<ULONG32>(outputEnd - output) < matchLength)
+        {
+            return false;
+        }
+
+        // The match can overlap the output when the offset is smaller than the length, so copy byte by byte.
+        byte const * match = output - offset;
+        for (ULONG32 i = 0; i < matchLength; i++)
+        {
+            output[i] = match[i];
+        }
+
+        output += matchLength;
+    }
+
+    return output == outputEnd;
+}
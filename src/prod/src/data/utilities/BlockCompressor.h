@@ -0,0 +1,70 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace Utilities
+    {
+        namespace CompressionCodec
+        {
+            // Persisted in backup metadata, values must not change.
+            enum Enum
+            {
+                // Data is stored as is
+                None = 0,
+
+                // Byte oriented LZ77 with a 64KB window, favors speed over ratio
+                Lz = 1,
+
+                LastValidEnum = Lz
+            };
+        }
+
+        //
+        // Compresses independent blocks of data.
+        //
+        // A compressed block is a sequence of (token, literals, offset, match) tuples:
+        //
+        //      |--Token--|--Literal Length*--|--Literals--|--Offset--|--Match Length*--|
+        //
+        // The high nibble of the token is the number of literals and the low nibble is the match length minus 4.
+        // A nibble of 15 is followed by extension bytes that are added to it until one is smaller than 255.
+        // The offset is 2 bytes, little endian, back from the current output position.
+        // The last tuple only has literals.
+        //
+        class BlockCompressor
+        {
+        public:
+            static bool IsCodecSupported(__in CompressionCodec::Enum codec);
+
+            //
+            // Compresses the source into the destination.
+            // Returns the number of bytes written, 0 if the compressed data does not fit in the destination.
+            //
+            static ULONG32 Compress(
+                __in_bcount(sourceCount) byte const * source,
+                __in ULONG32 sourceCount,
+                __out_bcount(destinationCapacity) byte * destination,
+                __in ULONG32 destinationCapacity);
+
+            //
+            // Decompresses the source into the destination, which must be exactly the size of the original data.
+            // Returns false if the source is not a valid compressed block of that size.
+            //
+            static bool Decompress(
+                __in_bcount(sourceCount) byte const * source,
+                __in ULONG32 sourceCount,
+                __out_bcount(destinationCount) byte * destination,
+                __in ULONG32 destinationCount);
+
+            //
+            // Size of the destination that is always large enough for Compress to succeed.
+            //
+            static ULONG32 GetMaxCompressedSize(__in ULONG32 sourceCount);
+        };
+    }
+}
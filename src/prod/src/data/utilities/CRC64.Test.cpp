@@ -34,4 +34,136 @@ namespace UtilitiesTests
         result = CRC64::ToCRC64(buffer, 2, 5);
         CODING_ERROR_ASSERT(result == 14226437255121905647);
     }
+
+    static std::vector<byte> CreateRandomBuffer(__in ULONG32 size, __in int seed)
+    {
+        Common::Random random(seed);
+        std::vector<byte> buffer(size);
+        random.NextBytes(buffer);
+
+        return buffer;
+    }
+
+    static CRC64Engine::Enum const AllEngines[] =
+    {
+        CRC64Engine::Default,
+        CRC64Engine::Scalar,
+        CRC64Engine::SliceBy8,
+        CRC64Engine::Clmul,
+    };
+
+    BOOST_AUTO_TEST_CASE(ToCRC64_Engines_MatchScalar)
+    {
+        std::vector<byte> buffer = CreateRandomBuffer(64 * 1024, 5);
+        Common::Random random(7);
+
+        for (int i = 0; i < 2000; i++)
+        {
+            // Mostly short and unaligned inputs to cover the tails of the block loops
+            ULONG32 offset = static_cast<ULONG32>(random.Next(64));
+            ULONG32 maxCount = (i % 10 == 0) ? static_cast<ULONG32>(buffer.size()) - offset : 600;
+            ULONG32 count = static_cast<ULONG32>(random.Next(maxCount));
+
+            ULONG64 expected = CRC64::ToCRC64(buffer.data(), offset, count, CRC64Engine::Scalar);
+
+            for (CRC64Engine::Enum engine : AllEngines)
+            {
+                if (!CRC64::IsEngineSupported(engine))
+                {
+                    continue;
+                }
+
+                CODING_ERROR_ASSERT(CRC64::ToCRC64(buffer.data(), offset, count, engine) == expected);
+            }
+
+            CODING_ERROR_ASSERT(CRC64::ToCRC64(buffer.data(), offset, count) == expected);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(Builder_MatchesToCRC64)
+    {
+        std::vector<byte> buffer = CreateRandomBuffer(256 * 1024, 11);
+        Common::Random random(13);
+
+        CRC64::Builder builder;
+        ULONG32 position = 0;
+
+        while (position < buffer.size())
+        {
+            ULONG32 count = __min(static_cast<ULONG32>(random.Next(8192)), static_cast<ULONG32>(buffer.size()) - position);
+            builder.Append(buffer.data(), position, count);
+            position += count;
+        }
+
+        CODING_ERROR_ASSERT(builder.Count == buffer.size());
+        CODING_ERROR_ASSERT(builder.Value == CRC64::ToCRC64(buffer.data(), 0, static_cast<ULONG32>(buffer.size()), CRC64Engine::Scalar));
+
+        builder.Reset();
+        CODING_ERROR_ASSERT(builder.Value == CRC64::ToCRC64(buffer.data(), 0, 0));
+    }
+
+    BOOST_AUTO_TEST_CASE(Combine_MatchesToCRC64)
+    {
+        std::vector<byte> buffer = CreateRandomBuffer(4096, 17);
+        Common::Random random(19);
+
+        for (int i = 0; i < 200; i++)
+        {
+            ULONG32 count = static_cast<ULONG32>(random.Next(static_cast<int>(buffer.size())));
+            ULONG32 split = static_cast<ULONG32>(random.Next(static_cast<int>(count + 1)));
+
+            ULONG64 crc1 = CRC64::ToCRC64(buffer.data(), 0, split);
+            ULONG64 crc2 = CRC64::ToCRC64(buffer.data(), split, count - split);
+
+            CODING_ERROR_ASSERT(CRC64::Combine(crc1, crc2, count - split) == CRC64::ToCRC64(buffer.data(), 0, count));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(ToCRC64Parallel_MatchesToCRC64)
+    {
+        // Not a multiple of the chunk count so the last chunk absorbs a remainder
+        std::vector<byte> buffer = CreateRandomBuffer(9 * 1024 * 1024 + 13, 23);
+
+        ULONG64 expected = CRC64::ToCRC64(buffer.data(), 0, static_cast<ULONG32>(buffer.size()), CRC64Engine::SliceBy8);
+
+        CODING_ERROR_ASSERT(CRC64::ToCRC64Parallel(buffer.data(), buffer.size(), 1) == expected);
+        CODING_ERROR_ASSERT(CRC64::ToCRC64Parallel(buffer.data(), buffer.size(), 4) == expected);
+        CODING_ERROR_ASSERT(CRC64::ToCRC64Parallel(buffer.data(), buffer.size(), 64) == expected);
+    }
+
+    BOOST_AUTO_TEST_CASE(ToCRC64_Throughput, * boost::unit_test::disabled())
+    {
+        ULONG32 const bufferSize = 16 * 1024 * 1024;
+        int const iterations = 8;
+
+        std::vector<byte> buffer = CreateRandomBuffer(bufferSize, 29);
+
+        for (CRC64Engine::Enum engine : AllEngines)
+        {
+            if (engine == CRC64Engine::Default || !CRC64::IsEngineSupported(engine))
+            {
+                continue;
+            }
+
+            ULONG64 checksum = 0;
+            Common::Stopwatch stopwatch;
+            stopwatch.Start();
+
+            for (int i = 0; i < iterations; i++)
+            {
+                checksum ^= CRC64::ToCRC64(buffer.data(), 0, bufferSize, engine);
+            }
+
+            stopwatch.Stop();
+
+            double megabytesPerSecond = (static_cast<double>(bufferSize) * iterations / (1024 * 1024)) / __max(stopwatch.Elapsed.TotalMillisecondsAsDouble() / 1000, 0.001);
+
+            Common::Trace.WriteInfo(
+                "CRC64Test",
+                "Engine {0}: {1} MB/s (checksum {2})",
+                static_cast<int>(engine),
+                megabytesPerSecond,
+                checksum);
+        }
+    }
 }
@@ -5,6 +5,19 @@
 
 #include "stdafx.h"
 
+#if defined(_M_X64) || defined(__x86_64__)
+#define CRC64_CLMUL_SUPPORTED
+#include <immintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CRC64_CLMUL_TARGET
+#else
+#include <cpuid.h>
+#define CRC64_CLMUL_TARGET __attribute__((target("pclmul,ssse3,sse4.1")))
+#endif
+#endif
+
 using namespace Data::Utilities;
 
 static const ULONG64 Crc64Table[] = {
@@ -266,11 +279,374 @@ static const ULONG64 Crc64Table[] = {
     0x9AFCE626CE85B507
 };
 
+namespace
+{
+    // Polynomial without the x^64 term (ECMA-182), matching Crc64Table
+    const ULONG64 Crc64Polynomial = 0x42F0E1EBA9EA3693;
+    const ULONG64 Crc64Init = 0xffffffffffffffff;
+    const ULONG64 Crc64XorOut = 0xffffffffffffffff;
+
+    //
+    // Multiplies two polynomials modulo the CRC polynomial. Used to compute the folding
+    // constants and to combine CRCs of adjacent ranges.
+    //
+    ULONG64 MultiplyModPolynomial(ULONG64 a, ULONG64 b)
+    {
+        ULONG64 result = 0;
+
+        for (int i = 63; i >= 0; i--)
+        {
+            result = (result << 1) ^ ((result >> 63) ? Crc64Polynomial : 0);
+
+            if ((b >> i) & 1)
+            {
+                result ^= a;
+            }
+        }
+
+        return result;
+    }
+
+    // x^(8 * byteCount) mod P
+    ULONG64 ShiftByBytesModPolynomial(ULONG64 byteCount)
+    {
+        ULONG64 result = 1;
+        ULONG64 power = 0x100;
+
+        while (byteCount > 0)
+        {
+            if (byteCount & 1)
+            {
+                result = MultiplyModPolynomial(result, power);
+            }
+
+            power = MultiplyModPolynomial(power, power);
+            byteCount >>= 1;
+        }
+
+        return result;
+    }
+
+    // x^bitCount mod P
+    ULONG64 ShiftByBitsModPolynomial(ULONG32 bitCount)
+    {
+        ULONG64 result = 1;
+
+        for (ULONG32 i = 0; i < bitCount; i++)
+        {
+            result = (result << 1) ^ ((result >> 63) ? Crc64Polynomial : 0);
+        }
+
+        return result;
+    }
+
+    //
+    // Slice-by-8 tables. SliceTables[k][b] is the CRC register contribution of byte b
+    // followed by k zero bytes, so 8 input bytes can be folded in with 8 independent lookups.
+    //
+    struct SliceTables
+    {
+        SliceTables()
+        {
+            for (int b = 0; b < 256; b++)
+            {
+                Table[0][b] = Crc64Table[b];
+            }
+
+            for (int k = 1; k < 8; k++)
+            {
+                for (int b = 0; b < 256; b++)
+                {
+                    ULONG64 previous = Table[k - 1][b];
+                    Table[k][b] = (previous << 8) ^ Crc64Table[previous >> 56];
+                }
+            }
+        }
+
+        ULONG64 Table[8][256];
+    };
+
+    SliceTables const & GetSliceTables()
+    {
+        static SliceTables tables;
+        return tables;
+    }
+
+    //
+    // Byte-at-a-time reference implementation operating on the raw CRC register
+    //
+    ULONG64 UpdateScalar(ULONG64 crc, byte const * value, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            crc = Crc64Table[((crc >> 56) ^ value[i]) & 0xff] ^ (crc << 8);
+        }
+
+        return crc;
+    }
+
+    ULONG64 UpdateSliceBy8(ULONG64 crc, byte const * value, size_t count)
+    {
+        auto const & t = GetSliceTables().Table;
+
+        while (count >= 8)
+        {
+            ULONG64 x = crc ^ (
+                (static_cast<ULONG64>(value[0]) << 56) |
+                (static_cast<ULONG64>(value[1]) << 48) |
+                (static_cast<ULONG64>(value[2]) << 40) |
+                (static_cast<ULONG64>(value[3]) << 32) |
+                (static_cast<ULONG64>(value[4]) << 24) |
+                (static_cast<ULONG64>(value[5]) << 16) |
+                (static_cast<ULONG64>(value[6]) << 8) |
+                static_cast<ULONG64>(value[7]));
+
+            crc =
+                t[7][x >> 56] ^
+                t[6][(x >> 48) & 0xff] ^
+                t[5][(x >> 40) & 0xff] ^
+                t[4][(x >> 32) & 0xff] ^
+                t[3][(x >> 24) & 0xff] ^
+                t[2][(x >> 16) & 0xff] ^
+                t[1][(x >> 8) & 0xff] ^
+                t[0][x & 0xff];
+
+            value += 8;
+            count -= 8;
+        }
+
+        return UpdateScalar(crc, value, count);
+    }
+
+#if defined(CRC64_CLMUL_SUPPORTED)
+
+    //
+    // Carry-less multiplication folding (Intel "Fast CRC Computation Using PCLMULQDQ").
+    // The CRC is not reflected, so each 16 byte block is byte swapped into a 128 bit
+    // polynomial with the first message byte in the most significant position.
+    //
+    // Four 128 bit accumulators are folded forward by 512 bits per iteration, then folded
+    // into one accumulator. The final 128 bits are reduced with the slice-by-8 tables
+    // since feeding them through the register with a zero seed yields (A * x^64) mod P.
+    //
+    struct ClmulConstants
+    {
+        ClmulConstants()
+        {
+            Fold128 = _mm_set_epi64x(
+                static_cast<LONG64>(ShiftByBitsModPolynomial(128 + 64)),
+                static_cast<LONG64>(ShiftByBitsModPolynomial(128)));
+            Fold256 = _mm_set_epi64x(
+                static_cast<LONG64>(ShiftByBitsModPolynomial(256 + 64)),
+                static_cast<LONG64>(ShiftByBitsModPolynomial(256)));
+            Fold384 = _mm_set_epi64x(
+                static_cast<LONG64>(ShiftByBitsModPolynomial(384 + 64)),
+                static_cast<LONG64>(ShiftByBitsModPolynomial(384)));
+            Fold512 = _mm_set_epi64x(
+                static_cast<LONG64>(ShiftByBitsModPolynomial(512 + 64)),
+                static_cast<LONG64>(ShiftByBitsModPolynomial(512)));
+            ByteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        }
+
+        __m128i Fold128;
+        __m128i Fold256;
+        __m128i Fold384;
+        __m128i Fold512;
+        __m128i ByteSwap;
+    };
+
+    ClmulConstants const & GetClmulConstants()
+    {
+        static ClmulConstants constants;
+        return constants;
+    }
+
+    CRC64_CLMUL_TARGET
+    inline __m128i Fold(__m128i accumulator, __m128i constants)
+    {
+        return _mm_xor_si128(
+            _mm_clmulepi64_si128(accumulator, constants, 0x11),
+            _mm_clmulepi64_si128(accumulator, constants, 0x00));
+    }
+
+    CRC64_CLMUL_TARGET
+    inline __m128i LoadBlock(byte const * value, __m128i const & byteSwap)
+    {
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(value)), byteSwap);
+    }
+
+    //
+    // Consumes whole 16 byte blocks of the input (count must be at least 16) and returns
+    // the CRC register after those bytes. The remaining (count % 16) bytes are left to the caller.
+    //
+    CRC64_CLMUL_TARGET
+    ULONG64 UpdateClmulBlocks(ULONG64 crc, byte const * value, size_t count)
+    {
+        auto const & k = GetClmulConstants();
+
+        // Folding the register into the first 8 message bytes is equivalent to
+        // starting the division with it.
+        //
+        __m128i a0 = _mm_xor_si128(LoadBlock(value, k.ByteSwap), _mm_set_epi64x(static_cast<LONG64>(crc), 0));
+        value += 16;
+        count -= 16;
+
+        if (count >= 48)
+        {
+            __m128i a1 = LoadBlock(value, k.ByteSwap);
+            __m128i a2 = LoadBlock(value + 16, k.ByteSwap);
+            __m128i a3 = LoadBlock(value + 32, k.ByteSwap);
+            value += 48;
+            count -= 48;
+
+            while (count >= 64)
+            {
+                a0 = _mm_xor_si128(Fold(a0, k.Fold512), LoadBlock(value, k.ByteSwap));
+                a1 = _mm_xor_si128(Fold(a1, k.Fold512), LoadBlock(value + 16, k.ByteSwap));
+                a2 = _mm_xor_si128(Fold(a2, k.Fold512), LoadBlock(value + 32, k.ByteSwap));
+                a3 = _mm_xor_si128(Fold(a3, k.Fold512), LoadBlock(value + 48, k.ByteSwap));
+                value += 64;
+                count -= 64;
+            }
+
+            a0 = _mm_xor_si128(
+                _mm_xor_si128(Fold(a0, k.Fold384), Fold(a1, k.Fold256)),
+                _mm_xor_si128(Fold(a2, k.Fold128), a3));
+        }
+
+        while (count >= 16)
+        {
+            a0 = _mm_xor_si128(Fold(a0, k.Fold128), LoadBlock(value, k.ByteSwap));
+            value += 16;
+            count -= 16;
+        }
+
+        byte reduced[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(reduced), _mm_shuffle_epi8(a0, k.ByteSwap));
+
+        return UpdateSliceBy8(0, reduced, sizeof(reduced));
+    }
+
+    bool IsClmulSupported()
+    {
+        static bool const isSupported = []()
+        {
+            int info[4] = { 0 };
+#if defined(_MSC_VER)
+            __cpuid(info, 1);
+#else
+            unsigned int eax, ebx, ecx, edx;
+            if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+            {
+                return false;
+            }
+
+            info[2] = static_cast<int>(ecx);
+#endif
+            bool hasPclmulqdq = (info[2] & (1 << 1)) != 0;
+            bool hasSsse3 = (info[2] & (1 << 9)) != 0;
+            bool hasSse41 = (info[2] & (1 << 19)) != 0;
+
+            return hasPclmulqdq && hasSsse3 && hasSse41;
+        }();
+
+        return isSupported;
+    }
+
+#endif
+
+    // Inputs shorter than this are not worth the setup cost of the folding loop
+    const size_t ClmulMinimumCount = 64;
+
+    ULONG64 Update(CRC64Engine::Enum engine, ULONG64 crc, byte const * value, size_t count)
+    {
+        switch (engine)
+        {
+        case CRC64Engine::Scalar:
+            return UpdateScalar(crc, value, count);
+
+#if defined(CRC64_CLMUL_SUPPORTED)
+        case CRC64Engine::Clmul:
+            if (count >= 16)
+            {
+                size_t blockBytes = count & ~static_cast<size_t>(15);
+                crc = UpdateClmulBlocks(crc, value, blockBytes);
+                value += blockBytes;
+                count -= blockBytes;
+            }
+
+            return UpdateSliceBy8(crc, value, count);
+#endif
+
+        default:
+            return UpdateSliceBy8(crc, value, count);
+        }
+    }
+
+    CRC64Engine::Enum SelectEngine(size_t count)
+    {
+#if defined(CRC64_CLMUL_SUPPORTED)
+        if (count >= ClmulMinimumCount && IsClmulSupported())
+        {
+            return CRC64Engine::Clmul;
+        }
+#endif
+
+        return count >= 8 ? CRC64Engine::SliceBy8 : CRC64Engine::Scalar;
+    }
+
+    ULONG64 Update(ULONG64 crc, byte const * value, size_t count)
+    {
+        return Update(SelectEngine(count), crc, value, count);
+    }
+}
+
+// Smallest chunk worth handing to another thread in ToCRC64Parallel
+static const ULONG64 ParallelChunkMinimumCount = 1024 * 1024;
+
+CRC64::Builder::Builder()
+    : crc_(Crc64Init)
+    , count_(0)
+{
+}
+
+ULONG64 CRC64::Builder::get_Value() const
+{
+    return crc_ ^ Crc64XorOut;
+}
+
+void CRC64::Builder::Append(
+    __in byte const value[],
+    __in ULONG32 offset,
+    __in ULONG32 count)
+{
+    crc_ = Update(crc_, value + offset, count);
+    count_ += count;
+}
+
+void CRC64::Builder::Append(
+    __in KBuffer const & buffer,
+    __in ULONG32 offset,
+    __in ULONG32 count)
+{
+    ASSERT_IF(offset + count > buffer.QuerySize(), "Offset + Count cannot be larger than the buffer size");
+
+    Append(static_cast<byte const *>(buffer.GetBuffer()), offset, count);
+}
+
+void CRC64::Builder::Reset()
+{
+    crc_ = Crc64Init;
+    count_ = 0;
+}
+
 ULONG64 CRC64::ToCRC64(
    __in KBuffer const & buffer,
    __in ULONG32 offset,
    __in ULONG32 count)
 {
+   ASSERT_IF(static_cast<ULONG64>(offset) + count > buffer.QuerySize(), "Offset + Count cannot be larger than the buffer size");
+
    return CRC64::ToCRC64(static_cast<byte const *>(buffer.GetBuffer()), offset, count);
 }
 
@@ -279,15 +655,23 @@ ULONG64 CRC64::ToCRC64(
     __in ULONG32 offset,
     __in ULONG32 count)
 {
-    ULONG64 crc = 0xffffffffffffffff;
+    return Update(Crc64Init, value + offset, count) ^ Crc64XorOut;
+}
 
-    for (ULONG32 i = offset; i < offset + count; i++)
+ULONG64 CRC64::ToCRC64(
+    __in byte const value[],
+    __in ULONG32 offset,
+    __in ULONG32 count,
+    __in CRC64Engine::Enum engine)
+{
+    ASSERT_IFNOT(IsEngineSupported(engine), "CRC64 engine {0} is not supported on this processor", static_cast<int>(engine));
+
+    if (engine == CRC64Engine::Default)
     {
-        ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ value[i]) & 0xff;
-        crc = Crc64Table[tableIndex] ^ (crc << 8);
+        engine = SelectEngine(count);
     }
 
-    return crc ^ 0xffffffffffffffff;
+    return Update(engine, Crc64Init, value + offset, count) ^ Crc64XorOut;
 }
 
 ULONG64 CRC64::ToCRC64(
@@ -295,23 +679,17 @@ ULONG64 CRC64::ToCRC64(
     __in ULONG32 offset,
     __in ULONG32 count)
 {
-    ULONG64 crc = 0xffffffffffffffff;
-
     ASSERT_IF(offset + count > operationData.BufferCount, "Offset + Count cannot be larger than BufferCount");
 
+    Builder builder;
+
     for (ULONG32 bufferIndex = offset; bufferIndex < count + offset; bufferIndex++)
     {
         KBuffer::CSPtr bufferCSPtr = operationData[bufferIndex];
-        for (ULONG32 byteIndex = 0; byteIndex < bufferCSPtr->QuerySize(); byteIndex++)
-        {
-            void const * rawBuffer = bufferCSPtr->GetBuffer();
-            byte const * byteBuffer = static_cast<byte const *>(rawBuffer);
-            ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ byteBuffer[byteIndex]) & 0xff;
-            crc = Crc64Table[tableIndex] ^ (crc << 8);
-        }
+        builder.Append(*bufferCSPtr, 0, bufferCSPtr->QuerySize());
     }
 
-    return crc ^ 0xffffffffffffffff;
+    return builder.Value;
 }
 
 ULONG64 CRC64::ToCRC64(
@@ -319,10 +697,10 @@ ULONG64 CRC64::ToCRC64(
     __in ULONG32 offset,
     __in ULONG32 count)
 {
-    ULONG64 crc = 0xffffffffffffffff;
-
     ASSERT_IF(offset + count > operationDataArray.Count(), "Offset + Count cannot be larger than Count");
 
+    Builder builder;
+
     for (ULONG32 operationDataIndex = offset; operationDataIndex < count + offset; operationDataIndex++)
     {
         OperationData::CSPtr operationDataCSPtr = operationDataArray[operationDataIndex];
@@ -330,14 +708,104 @@ ULONG64 CRC64::ToCRC64(
         for (ULONG32 bufferIndex = 0; bufferIndex < operationDataCSPtr->BufferCount; bufferIndex++)
         {
             KBuffer::CSPtr bufferCSPtr = (*operationDataCSPtr)[bufferIndex];
-            for (ULONG32 byteIndex = 0; byteIndex < bufferCSPtr->QuerySize(); byteIndex++)
+            builder.Append(*bufferCSPtr, 0, bufferCSPtr->QuerySize());
+        }
+    }
+
+    return builder.Value;
+}
+
+ULONG64 CRC64::ToCRC64Parallel(
+    __in byte const value[],
+    __in ULONG64 count,
+    __in ULONG32 maxDegreeOfParallelism)
+{
+    ULONG64 chunkCount = __min(static_cast<ULONG64>(maxDegreeOfParallelism), count / ParallelChunkMinimumCount);
+    chunkCount = __max(chunkCount, 1);
+
+    if (chunkCount == 1)
+    {
+        return Update(Crc64Init, value, static_cast<size_t>(count)) ^ Crc64XorOut;
+    }
+
+    ULONG64 chunkSize = count / chunkCount;
+
+    std::vector<ULONG64> chunkCrcs(static_cast<size_t>(chunkCount));
+    Common::atomic_long pendingChunks(static_cast<LONG>(chunkCount - 1));
+    Common::ManualResetEvent allChunksDone(false);
+
+    // The first chunk is computed on the calling thread, the last chunk absorbs the remainder
+    //
+    for (ULONG64 i = 1; i < chunkCount; i++)
+    {
+        byte const * chunk = value + (i * chunkSize);
+        size_t chunkLength = static_cast<size_t>((i == chunkCount - 1) ? (count - (i * chunkSize)) : chunkSize);
+        ULONG64 & chunkCrc = chunkCrcs[static_cast<size_t>(i)];
+
+        Common::Threadpool::Post([chunk, chunkLength, &chunkCrc, &pendingChunks, &allChunksDone]()
+        {
+            chunkCrc = Update(Crc64Init, chunk, chunkLength) ^ Crc64XorOut;
+
+            if (--pendingChunks == 0)
             {
-                byte const * byteBuffer = static_cast<byte const *>(bufferCSPtr->GetBuffer());
-                ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ byteBuffer[byteIndex]) & 0xff;
-                crc = Crc64Table[tableIndex] ^ (crc << 8);
+                allChunksDone.Set();
             }
-        }
+        });
+    }
+
+    chunkCrcs[0] = Update(Crc64Init, value, static_cast<size_t>(chunkSize)) ^ Crc64XorOut;
+
+    allChunksDone.WaitOne();
+
+    ULONG64 crc = chunkCrcs[0];
+
+    for (ULONG64 i = 1; i < chunkCount; i++)
+    {
+        ULONG64 chunkLength = (i == chunkCount - 1) ? (count - (i * chunkSize)) : chunkSize;
+        crc = Combine(crc, chunkCrcs[static_cast<size_t>(i)], chunkLength);
     }
 
-    return crc ^ 0xffffffffffffffff;
+    return crc;
+}
+
+ULONG64 CRC64::ToCRC64Parallel(
+    __in KBuffer const & buffer,
+    __in ULONG32 offset,
+    __in ULONG32 count)
+{
+    ASSERT_IF(static_cast<ULONG64>(offset) + count > buffer.QuerySize(), "Offset + Count cannot be larger than the buffer size");
+
+    return ToCRC64Parallel(
+        static_cast<byte const *>(buffer.GetBuffer()) + offset,
+        count,
+        static_cast<ULONG32>(Common::Environment::GetNumberOfProcessors()));
+}
+
+ULONG64 CRC64::Combine(
+    __in ULONG64 crc1,
+    __in ULONG64 crc2,
+    __in ULONG64 count2)
+{
+    // crc(A + B) = ((crc(A) ^ xorOut ^ init) * x^(8 * |B|)) ^ crc(B) mod P, and init == xorOut
+    //
+    return MultiplyModPolynomial(crc1 ^ Crc64XorOut ^ Crc64Init, ShiftByBytesModPolynomial(count2)) ^ crc2;
+}
+
+bool CRC64::IsEngineSupported(__in CRC64Engine::Enum engine)
+{
+    switch (engine)
+    {
+    case CRC64Engine::Default:
+    case CRC64Engine::Scalar:
+    case CRC64Engine::SliceBy8:
+        return true;
+
+#if defined(CRC64_CLMUL_SUPPORTED)
+    case CRC64Engine::Clmul:
+        return IsClmulSupported();
+#endif
+
+    default:
+        return false;
+    }
 }
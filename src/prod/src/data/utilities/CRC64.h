@@ -11,9 +11,59 @@ namespace Data
     {
         class OperationData;
 
+        namespace CRC64Engine
+        {
+            enum Enum
+            {
+                // Fastest engine supported by the processor for the input size
+                Default = 0,
+
+                // Byte-at-a-time table lookup
+                Scalar = 1,
+
+                // Eight table lookups per 8 bytes of input
+                SliceBy8 = 2,
+
+                // Carry-less multiplication folding (PCLMULQDQ), x64 only
+                Clmul = 3,
+            };
+        }
+
         class CRC64
         {
         public:
+            //
+            // Computes the CRC64 of data supplied in pieces, so that a checksum can be computed while the
+            // data is being written. The result is identical to ToCRC64 over the concatenated data.
+            //
+            class Builder
+            {
+            public:
+                Builder();
+
+                __declspec(property(get = get_Value)) ULONG64 Value;
+                ULONG64 get_Value() const;
+
+                __declspec(property(get = get_Count)) ULONG64 Count;
+                ULONG64 get_Count() const { return count_; }
+
+                void Append(
+                    __in byte const value[],
+                    __in ULONG32 offset,
+                    __in ULONG32 count);
+
+                void Append(
+                    __in KBuffer const & buffer,
+                    __in ULONG32 offset,
+                    __in ULONG32 count);
+
+                void Reset();
+
+            private:
+                ULONG64 crc_;
+                ULONG64 count_;
+            };
+
             static ULONG64 ToCRC64(
                 __in KBuffer const & buffer,
                 __in ULONG32 offset,
@@ -33,6 +83,48 @@ namespace Data
                 __in KArray<KSharedPtr<const OperationData>> const & operationDataArray,
                 __in ULONG32 offset,
                 __in ULONG32 count);
+
+            //
+            // Computes the CRC64 with a specific engine. Used to cross-check the engines against each other.
+            //
+            static ULONG64 ToCRC64(
+                __in byte const value[],
+                __in ULONG32 offset,
+                __in ULONG32 count,
+                __in CRC64Engine::Enum engine);
+
+            //
+            // Splits large inputs into chunks that are checksummed on the threadpool and combined.
+            // Inputs smaller than two chunks are checksummed on the calling thread.
+            //
+            // The calling thread blocks until all chunks are done, so this must not be called from
+            // a KTL thread (e.g. inside a ktl::Awaitable), where it stalls the thread and can deadlock
+            // when the threadpool is saturated.
+            //
+            static ULONG64 ToCRC64Parallel(
+                __in byte const value[],
+                __in ULONG64 count,
+                __in ULONG32 maxDegreeOfParallelism);
+
+            //
+            // Same as ToCRC64, with inputs large enough to split checksummed in parallel on all processors.
+            // Blocks the calling thread like the overload above.
+            //
+            static ULONG64 ToCRC64Parallel(
+                __in KBuffer const & buffer,
+                __in ULONG32 offset,
+                __in ULONG32 count);
+
+            //
+            // Returns the CRC64 of the concatenation of two ranges given the CRC64 of each range
+            // and the length of the second range.
+            //
+            static ULONG64 Combine(
+                __in ULONG64 crc1,
+                __in ULONG64 crc2,
+                __in ULONG64 count2);
+
+            static bool IsEngineSupported(__in CRC64Engine::Enum engine);
         };
     }
 }
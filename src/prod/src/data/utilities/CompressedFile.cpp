@@ -0,0 +1,454 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace ktl;
+using namespace Data::Utilities;
+
+const KStringView CompressedFile::FileExtension = L".cmp";
+
+// Compress algorithm:
+// 1. Read up to maxDegreeOfParallelism blocks of the source file.
+// 2. Compress the blocks in parallel on the thread pool.
+// 3. Write the blocks in order, then repeat until the source file is drained.
+// 4. Write the trailer with the checksum of the whole source file and flush.
+ktl::Awaitable<ULONG64> CompressedFile::CompressAsync(
+    __in KString const & sourcePath,
+    __in KString const & destinationPath,
+    __in CompressionCodec::Enum codec,
+    __in ULONG32 maxDegreeOfParallelism,
+    __in KAllocator & allocator,
+    __in CancellationToken const & cancellationToken)
+{
+    ASSERT_IFNOT(BlockCompressor::IsCodecSupported(codec), "Unsupported compression codec {0}", static_cast<ULONG32>(codec));
+
+    ULONG32 batchSize = __max(maxDegreeOfParallelism, 1);
+    ULONG64 result = 0;
+
+    KBlockFile::SPtr sourceFileSPtr = nullptr;
+    KBlockFile::SPtr destinationFileSPtr = nullptr;
+    io::KFileStream::SPtr sourceStreamSPtr = co_await OpenAsync(sourcePath, false, allocator, sourceFileSPtr);
+    KFinally([&] { sourceFileSPtr->Close(); });
+
+    io::KFileStream::SPtr destinationStreamSPtr = nullptr;
+    SharedException::CSPtr exceptionSPtr = nullptr;
+
+    try
+    {
+        destinationStreamSPtr = co_await OpenAsync(destinationPath, true, allocator, destinationFileSPtr);
+
+        std::vector<Block> blocks(batchSize);
+        for (Block & block : blocks)
+        {
+            NTSTATUS status = KBuffer::Create(DefaultBlockSize, block.InputSPtr, allocator, COMPRESSEDFILE_TAG);
+            THROW_ON_FAILURE(status);
+
+            status = KBuffer::Create(BlockCompressor::GetMaxCompressedSize(DefaultBlockSize), block.OutputSPtr, allocator, COMPRESSEDFILE_TAG);
+            THROW_ON_FAILURE(status);
+        }
+
+        FileHeader header = { Magic, Version, static_cast<ULONG32>(codec), DefaultBlockSize, 0 };
+        co_await WriteAsync(*destinationStreamSPtr, &header, sizeof(header), allocator);
+
+        ULONG64 remaining = static_cast<ULONG64>(sourceStreamSPtr->GetLength());
+
+        // CRC64 of no data is 0, and combining with 0 yields the other checksum.
+        ULONG64 fileChecksum = 0;
+
+        while (remaining > 0)
+        {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            // Step 1: Read the batch.
+            ULONG32 count = 0;
+            for (; count < batchSize && remaining > 0; count++)
+            {
+                ULONG32 blockSize = static_cast<ULONG32>(__min(remaining, static_cast<ULONG64>(DefaultBlockSize)));
+                co_await ReadExactlyAsync(*sourceStreamSPtr, *blocks[count].InputSPtr, blockSize);
+                blocks[count].Header.UncompressedSize = blockSize;
+                remaining -= blockSize;
+            }
+
+            // Step 2: Compress the batch.
+            co_await RunInParallelAsync(blocks, count, true, codec, allocator);
+
+            // Step 3: Write the batch.
+            for (ULONG32 i = 0; i < count; i++)
+            {
+                Block & block = blocks[i];
+                co_await WriteAsync(*destinationStreamSPtr, &block.Header, sizeof(block.Header), allocator);
+
+                KBuffer & data = block.Header.StoredSize == block.Header.UncompressedSize ? *block.InputSPtr : *block.OutputSPtr;
+                NTSTATUS status = co_await destinationStreamSPtr->WriteAsync(data, 0, block.Header.StoredSize);
+                THROW_ON_FAILURE(status);
+
+                fileChecksum = CRC64::Combine(fileChecksum, block.Header.Checksum, block.Header.UncompressedSize);
+            }
+        }
+
+        // Step 4: Write the trailer.
+        BlockHeader trailer = { 0, 0, fileChecksum };
+        co_await WriteAsync(*destinationStreamSPtr, &trailer, sizeof(trailer), allocator);
+
+        NTSTATUS status = co_await destinationStreamSPtr->FlushAsync();
+        THROW_ON_FAILURE(status);
+
+        result = static_cast<ULONG64>(destinationStreamSPtr->GetPosition());
+    }
+    catch (ktl::Exception const & e)
+    {
+        exceptionSPtr = SharedException::Create(e, allocator);
+    }
+
+    NTSTATUS status = co_await sourceStreamSPtr->CloseAsync();
+    ASSERT_IFNOT(NT_SUCCESS(status), "CompressedFile::CompressAsync: source stream CloseAsync failed. Status: {0}", status);
+
+    if (destinationStreamSPtr != nullptr)
+    {
+        status = co_await destinationStreamSPtr->CloseAsync();
+        ASSERT_IFNOT(NT_SUCCESS(status), "CompressedFile::CompressAsync: destination stream CloseAsync failed. Status: {0}", status);
+    }
+
+    if (destinationFileSPtr != nullptr)
+    {
+        destinationFileSPtr->Close();
+    }
+
+    if (exceptionSPtr != nullptr)
+    {
+        //clang compiler error, needs to assign before throw.
+        auto ex = exceptionSPtr->Info;
+        throw ex;
+    }
+
+    co_return result;
+}
+
+// Decompress algorithm:
+// 1. Read and validate the header.
+// 2. Read up to maxDegreeOfParallelism blocks, stopping at the trailer.
+// 3. Decompress and verify the blocks in parallel on the thread pool.
+// 4. Write the blocks in order, then repeat until the trailer is reached.
+// 5. Verify the checksum of the whole file and that nothing follows the trailer.
+ktl::Awaitable<ULONG64> CompressedFile::DecompressAsync(
+    __in KString const & sourcePath,
+    __in KString const & destinationPath,
+    __in ULONG32 maxDegreeOfParallelism,
+    __in KAllocator & allocator,
+    __in CancellationToken const & cancellationToken)
+{
+    ULONG32 batchSize = __max(maxDegreeOfParallelism, 1);
+    ULONG64 result = 0;
+
+    KBlockFile::SPtr sourceFileSPtr = nullptr;
+    KBlockFile::SPtr destinationFileSPtr = nullptr;
+    io::KFileStream::SPtr sourceStreamSPtr = co_await OpenAsync(sourcePath, false, allocator, sourceFileSPtr);
+    KFinally([&] { sourceFileSPtr->Close(); });
+
+    io::KFileStream::SPtr destinationStreamSPtr = nullptr;
+    SharedException::CSPtr exceptionSPtr = nullptr;
+
+    try
+    {
+        ULONG64 sourceLength = static_cast<ULONG64>(sourceStreamSPtr->GetLength());
+        if (sourceLength < sizeof(FileHeader) + sizeof(BlockHeader))
+        {
+            throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+        }
+
+        // Step 1: Read the header.
+        KBuffer::SPtr headerBufferSPtr = nullptr;
+        NTSTATUS status = KBuffer::Create(sizeof(FileHeader), headerBufferSPtr, allocator, COMPRESSEDFILE_TAG);
+        THROW_ON_FAILURE(status);
+
+        co_await ReadExactlyAsync(*sourceStreamSPtr, *headerBufferSPtr, sizeof(FileHeader));
+
+        FileHeader header;
+        memcpy(&header, headerBufferSPtr->GetBuffer(), sizeof(header));
+
+        CompressionCodec::Enum codec = static_cast<CompressionCodec::Enum>(header.Codec);
+        if (header.Magic != Magic ||
+            header.Version != Version ||
+            header.Codec > CompressionCodec::LastValidEnum ||
+            !BlockCompressor::IsCodecSupported(codec) ||
+            header.BlockSize == 0 ||
+            header.BlockSize > DefaultBlockSize)
+        {
+            throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+        }
+
+        destinationStreamSPtr = co_await OpenAsync(destinationPath, true, allocator, destinationFileSPtr);
+
+        std::vector<Block> blocks(batchSize);
+        for (Block & block : blocks)
+        {
+            status = KBuffer::Create(BlockCompressor::GetMaxCompressedSize(header.BlockSize), block.InputSPtr, allocator, COMPRESSEDFILE_TAG);
+            THROW_ON_FAILURE(status);
+
+            status = KBuffer::Create(header.BlockSize, block.OutputSPtr, allocator, COMPRESSEDFILE_TAG);
+            THROW_ON_FAILURE(status);
+        }
+
+        KBuffer::SPtr blockHeaderBufferSPtr = nullptr;
+        status = KBuffer::Create(sizeof(BlockHeader), blockHeaderBufferSPtr, allocator, COMPRESSEDFILE_TAG);
+        THROW_ON_FAILURE(status);
+
+        ULONG64 fileChecksum = 0;
+        bool isTrailerRead = false;
+
+        while (!isTrailerRead)
+        {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            // Step 2: Read the batch.
+            ULONG32 count = 0;
+            while (count < batchSize)
+            {
+                BlockHeader blockHeader;
+                co_await ReadExactlyAsync(*sourceStreamSPtr, *blockHeaderBufferSPtr, sizeof(BlockHeader));
+                memcpy(&blockHeader, blockHeaderBufferSPtr->GetBuffer(), sizeof(blockHeader));
+
+                if (blockHeader.UncompressedSize == 0)
+                {
+                    if (blockHeader.StoredSize != 0 || blockHeader.Checksum != fileChecksum)
+                    {
+                        throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+                    }
+
+                    isTrailerRead = true;
+                    break;
+                }
+
+                if (blockHeader.UncompressedSize > header.BlockSize ||
+                    blockHeader.StoredSize == 0 ||
+                    blockHeader.StoredSize > BlockCompressor::GetMaxCompressedSize(header.BlockSize))
+                {
+                    throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+                }
+
+                Block & block = blocks[count];
+                block.Header = blockHeader;
+                co_await ReadExactlyAsync(*sourceStreamSPtr, *block.InputSPtr, blockHeader.StoredSize);
+
+                // The checksums of the batch are combined before the blocks are verified, a mismatch fails the restore either way.
+                fileChecksum = CRC64::Combine(fileChecksum, blockHeader.Checksum, blockHeader.UncompressedSize);
+                count++;
+            }
+
+            // Step 3: Decompress the batch.
+            co_await RunInParallelAsync(blocks, count, false, codec, allocator);
+
+            // Step 4: Write the batch.
+            for (ULONG32 i = 0; i < count; i++)
+            {
+                Block & block = blocks[i];
+                if (!block.IsValid)
+                {
+                    throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+                }
+
+                KBuffer & data = block.Header.StoredSize == block.Header.UncompressedSize ? *block.InputSPtr : *block.OutputSPtr;
+                status = co_await destinationStreamSPtr->WriteAsync(data, 0, block.Header.UncompressedSize);
+                THROW_ON_FAILURE(status);
+            }
+        }
+
+        // Step 5: Nothing is expected after the trailer.
+        if (static_cast<ULONG64>(sourceStreamSPtr->GetPosition()) != sourceLength)
+        {
+            throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+        }
+
+        status = co_await destinationStreamSPtr->FlushAsync();
+        THROW_ON_FAILURE(status);
+
+        result = static_cast<ULONG64>(destinationStreamSPtr->GetPosition());
+    }
+    catch (ktl::Exception const & e)
+    {
+        exceptionSPtr = SharedException::Create(e, allocator);
+    }
+
+    NTSTATUS status = co_await sourceStreamSPtr->CloseAsync();
+    ASSERT_IFNOT(NT_SUCCESS(status), "CompressedFile::DecompressAsync: source stream CloseAsync failed. Status: {0}", status);
+
+    if (destinationStreamSPtr != nullptr)
+    {
+        status = co_await destinationStreamSPtr->CloseAsync();
+        ASSERT_IFNOT(NT_SUCCESS(status), "CompressedFile::DecompressAsync: destination stream CloseAsync failed. Status: {0}", status);
+    }
+
+    if (destinationFileSPtr != nullptr)
+    {
+        destinationFileSPtr->Close();
+    }
+
+    if (exceptionSPtr != nullptr)
+    {
+        //clang compiler error, needs to assign before throw.
+        auto ex = exceptionSPtr->Info;
+        throw ex;
+    }
+
+    co_return result;
+}
+
+ktl::Awaitable<void> CompressedFile::CompressBlockAsync(
+    __in Block & block,
+    __in CompressionCodec::Enum codec,
+    __in KAllocator & allocator)
+{
+    co_await ktl::CorHelper::ThreadPoolThread(allocator.GetKtlSystem().DefaultThreadPool());
+
+    byte const * input = static_cast<byte const *>(block.InputSPtr->GetBuffer());
+    block.Header.Checksum = CRC64::ToCRC64(input, 0, block.Header.UncompressedSize);
+
+    ULONG32 compressedSize = 0;
+    if (codec != CompressionCodec::None)
+    {
+        // Only keep the compressed form if it is smaller, so that the stored size identifies raw blocks.
+        compressedSize = BlockCompressor::Compress(
+            input,
+            block.Header.UncompressedSize,
+            static_cast<byte *>(block.OutputSPtr->GetBuffer()),
+            block.Header.UncompressedSize - 1);
+    }
+
+    block.Header.StoredSize = compressedSize == 0 ? block.Header.UncompressedSize : compressedSize;
+    block.IsValid = true;
+    co_return;
+}
+
+ktl::Awaitable<void> CompressedFile::DecompressBlockAsync(
+    __in Block & block,
+    __in CompressionCodec::Enum codec,
+    __in KAllocator & allocator)
+{
+    co_await ktl::CorHelper::ThreadPoolThread(allocator.GetKtlSystem().DefaultThreadPool());
+
+    byte const * data = static_cast<byte const *>(block.InputSPtr->GetBuffer());
+    if (block.Header.StoredSize != block.Header.UncompressedSize)
+    {
+        if (codec == CompressionCodec::None ||
+            block.Header.StoredSize > block.Header.UncompressedSize ||
+            !BlockCompressor::Decompress(
+                data,
+                block.Header.StoredSize,
+                static_cast<byte *>(block.OutputSPtr->GetBuffer()),
+                block.Header.UncompressedSize))
+        {
+            block.IsValid = false;
+            co_return;
+        }
+
+        data = static_cast<byte const *>(block.OutputSPtr->GetBuffer());
+    }
+
+    block.IsValid = CRC64::ToCRC64(data, 0, block.Header.UncompressedSize) == block.Header.Checksum;
+    co_return;
+}
+
+ktl::Awaitable<void> CompressedFile::RunInParallelAsync(
+    __in std::vector<Block> & blocks,
+    __in ULONG32 count,
+    __in bool compress,
+    __in CompressionCodec::Enum codec,
+    __in KAllocator & allocator)
+{
+    KArray<Awaitable<void>> tasks(allocator);
+    THROW_ON_FAILURE(tasks.Status());
+
+    for (ULONG32 i = 0; i < count; i++)
+    {
+        Awaitable<void> task = compress
+            ? CompressBlockAsync(blocks[i], codec, allocator)
+            : DecompressBlockAsync(blocks[i], codec, allocator);
+
+        NTSTATUS status = tasks.Append(Ktl::Move(task));
+        THROW_ON_FAILURE(status);
+    }
+
+    co_await TaskUtilities<void>::WhenAll(tasks);
+    co_return;
+}
+
+ktl::Awaitable<io::KFileStream::SPtr> CompressedFile::OpenAsync(
+    __in KString const & path,
+    __in bool create,
+    __in KAllocator & allocator,
+    __out KBlockFile::SPtr & file)
+{
+    KWString filePath(allocator, path);
+    THROW_ON_FAILURE(filePath.Status());
+
+    NTSTATUS status = co_await KBlockFile::CreateSparseFileAsync(
+        filePath,
+        FALSE,                      // Is Write Through
+        create ? KBlockFile::eCreateAlways : KBlockFile::eOpenExisting,
+        static_cast<KBlockFile::CreateOptions>(KBlockFile::eSequentialAccess + KBlockFile::eInheritFileSecurity),
+        file,
+        nullptr,
+        allocator,
+        COMPRESSEDFILE_TAG);
+    THROW_ON_FAILURE(status);
+
+    io::KFileStream::SPtr streamSPtr = nullptr;
+    status = io::KFileStream::Create(streamSPtr, allocator, COMPRESSEDFILE_TAG);
+    if (NT_SUCCESS(status))
+    {
+        status = co_await streamSPtr->OpenAsync(*file);
+    }
+
+    if (!NT_SUCCESS(status))
+    {
+        file->Close();
+        file = nullptr;
+        throw ktl::Exception(status);
+    }
+
+    co_return streamSPtr;
+}
+
+ktl::Awaitable<void> CompressedFile::ReadExactlyAsync(
+    __in io::KFileStream & stream,
+    __in KBuffer & buffer,
+    __in ULONG32 count)
+{
+    ULONG32 offset = 0;
+    while (offset < count)
+    {
+        ULONG bytesRead = 0;
+        NTSTATUS status = co_await stream.ReadAsync(buffer, bytesRead, offset, count - offset);
+        THROW_ON_FAILURE(status);
+
+        // The file is shorter than its headers claim.
+        if (bytesRead == 0)
+        {
+            throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+        }
+
+        offset += bytesRead;
+    }
+
+    co_return;
+}
+
+ktl::Awaitable<void> CompressedFile::WriteAsync(
+    __in io::KFileStream & stream,
+    __in void const * data,
+    __in ULONG32 count,
+    __in KAllocator & allocator)
+{
+    KBuffer::SPtr bufferSPtr = nullptr;
+    NTSTATUS status = KBuffer::Create(count, bufferSPtr, allocator, COMPRESSEDFILE_TAG);
+    THROW_ON_FAILURE(status);
+
+    memcpy(bufferSPtr->GetBuffer(), data, count);
+
+    status = co_await stream.WriteAsync(*bufferSPtr, 0, count);
+    THROW_ON_FAILURE(status);
+    co_return;
+}
@@ -0,0 +1,119 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define COMPRESSEDFILE_TAG 'fpmC'
+
+namespace Data
+{
+    namespace Utilities
+    {
+        //
+        // Compressed copy of a file, produced and restored block by block so that blocks can be (de)compressed in parallel.
+        //
+        // File format:
+        //
+        //      |--Header--|--Block Header--|--Block--| ... |--Block Header--|--Block--|--Trailer--|
+        //
+        // Every block is compressed independently and carries the checksum of its uncompressed data.
+        // A block that does not compress is stored as is, its stored size is equal to its uncompressed size.
+        // The trailer is a block header with no data whose checksum covers the whole uncompressed file.
+        //
+        class CompressedFile
+        {
+        public:
+            static const KStringView FileExtension;
+
+            static const ULONG32 DefaultBlockSize = 1024 * 1024;
+
+            //
+            // Compresses the source file into the destination file, overwriting it.
+            // Returns the size of the destination file.
+            //
+            static ktl::Awaitable<ULONG64> CompressAsync(
+                __in KString const & sourcePath,
+                __in KString const & destinationPath,
+                __in CompressionCodec::Enum codec,
+                __in ULONG32 maxDegreeOfParallelism,
+                __in KAllocator & allocator,
+                __in ktl::CancellationToken const & cancellationToken);
+
+            //
+            // Restores the original file from a compressed file, overwriting the destination.
+            // Throws STATUS_INTERNAL_DB_CORRUPTION if the compressed file is not valid.
+            // Returns the size of the destination file.
+            //
+            static ktl::Awaitable<ULONG64> DecompressAsync(
+                __in KString const & sourcePath,
+                __in KString const & destinationPath,
+                __in ULONG32 maxDegreeOfParallelism,
+                __in KAllocator & allocator,
+                __in ktl::CancellationToken const & cancellationToken);
+
+        private:
+            static const ULONG64 Magic = 0x31534B4C42434653; // "SFCBLKS1"
+            static const ULONG32 Version = 1;
+
+            struct FileHeader
+            {
+                ULONG64 Magic;
+                ULONG32 Version;
+                ULONG32 Codec;
+                ULONG32 BlockSize;
+                ULONG32 Reserved;
+            };
+
+            struct BlockHeader
+            {
+                ULONG32 UncompressedSize;
+                ULONG32 StoredSize;
+                ULONG64 Checksum;
+            };
+
+            struct Block
+            {
+                BlockHeader Header;
+                KBuffer::SPtr InputSPtr;
+                KBuffer::SPtr OutputSPtr;
+                bool IsValid;
+            };
+
+            static ktl::Awaitable<void> CompressBlockAsync(
+                __in Block & block,
+                __in CompressionCodec::Enum codec,
+                __in KAllocator & allocator);
+
+            static ktl::Awaitable<void> DecompressBlockAsync(
+                __in Block & block,
+                __in CompressionCodec::Enum codec,
+                __in KAllocator & allocator);
+
+            static ktl::Awaitable<void> RunInParallelAsync(
+                __in std::vector<Block> & blocks,
+                __in ULONG32 count,
+                __in bool compress,
+                __in CompressionCodec::Enum codec,
+                __in KAllocator & allocator);
+
+            static ktl::Awaitable<ktl::io::KFileStream::SPtr> OpenAsync(
+                __in KString const & path,
+                __in bool create,
+                __in KAllocator & allocator,
+                __out KBlockFile::SPtr & file);
+
+            static ktl::Awaitable<void> ReadExactlyAsync(
+                __in ktl::io::KFileStream & stream,
+                __in KBuffer & buffer,
+                __in ULONG32 count);
+
+            static ktl::Awaitable<void> WriteAsync(
+                __in ktl::io::KFileStream & stream,
+                __in void const * data,
+                __in ULONG32 count,
+                __in KAllocator & allocator);
+        };
+    }
+}
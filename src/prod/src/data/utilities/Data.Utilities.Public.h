@@ -111,4 +111,6 @@ namespace Data
 #include "StatusConverter.h"
 #include "MemoryStream.h"
 #include "KPath.h"
+#include "BlockCompressor.h"
+#include "CompressedFile.h"
 #include "AsyncLock.h"
@@ -715,6 +715,29 @@ void ApplicationsHandler::OnGetAllApplicationsComplete(
         applicationResultWrapper.push_back(move(wrapper));
     }
 
+#if defined(PLATFORM_UNIX)
+    if (handlerOperation->IsChunkedResponseEnabled(applicationResultWrapper.size()))
+    {
+        auto chunkWriter = make_unique<QueryResultChunkWriter<ApplicationQueryResultWrapper>>(
+            move(applicationResultWrapper),
+            handlerOperation->GetSerializerFlags(),
+            HttpGatewayConfig::GetConfig().ResponseChunkSize);
+
+        if (handlerOperation->Uri.ApiVersion != Constants::V1ApiVersion)
+        {
+            error = chunkWriter->InitializePagedList<ApplicationList>(pagingStatus ? pagingStatus->TakeContinuationToken() : wstring());
+            if (!error.IsSuccess())
+            {
+                handlerOperation->OnError(operation->Parent, error);
+                return;
+            }
+        }
+
+        handlerOperation->OnSuccess(operation->Parent, move(chunkWriter));
+        return;
+    }
+#endif
+
     ByteBufferUPtr bufferUPtr;
     if (handlerOperation->Uri.ApiVersion == Constants::V1ApiVersion)
     {
@@ -40,6 +40,7 @@
 #include "httpgateway/GatewayUri.h"
 #include "httpgateway/Utility.h"
 #include "httpgateway/FabricClientWrapper.h"
+#include "httpgateway/QueryResultChunkWriter.h"
 #include "httpgateway/RequestHandlerBase.h"
 #include "httpgateway/RequestHandlerBase.HandlerAsyncOperation.h"
 #include "httpgateway/ApplicationUpgradeProgress.h"
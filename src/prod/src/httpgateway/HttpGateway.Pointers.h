@@ -40,6 +40,9 @@ namespace HttpGateway
     class FabricClientWrapper;
     typedef std::shared_ptr<FabricClientWrapper> FabricClientWrapperSPtr;
 
+    class ResponseChunkWriter;
+    typedef std::unique_ptr<ResponseChunkWriter> ResponseChunkWriterUPtr;
+
     class ImageStoreHandler;
     typedef std::shared_ptr<ImageStoreHandler> ImageStoreHandlerSPtr;
     class ToolsHandler;
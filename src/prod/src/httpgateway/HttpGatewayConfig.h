@@ -59,6 +59,15 @@ namespace HttpGateway
         //
         PUBLIC_CONFIG_ENTRY(uint, L"HttpGateway", BodyChunkSize, 16384, Common::ConfigEntryUpgradePolicy::Dynamic);
         //
+        // Query results with at least this many items are serialized incrementally and sent with chunked transfer
+        // encoding instead of being serialized into a single response body. Zero disables chunked query responses.
+        //
+        INTERNAL_CONFIG_ENTRY(uint, L"HttpGateway", ChunkedResponseItemThreshold, 1000, Common::ConfigEntryUpgradePolicy::Dynamic);
+        //
+        // The approximate size in bytes of each chunk of a chunked query response.
+        //
+        INTERNAL_CONFIG_ENTRY(uint, L"HttpGateway", ResponseChunkSize, 65536, Common::ConfigEntryUpgradePolicy::Dynamic);
+        //
         // Semi colon/ comma separated list of response headers that will be removed from the service response, before forwarding it to the client.
         // If this is set to empty string, pass all the headers returned by the service as-is. i.e do not overwrite the Date and Server headers.
         // 
@@ -271,6 +271,29 @@ void NodesHandler::OnGetAllNodesComplete(
         return;
     }
 
+#if defined(PLATFORM_UNIX)
+    if (handlerOperation->IsChunkedResponseEnabled(nodesResult.size()))
+    {
+        auto chunkWriter = make_unique<QueryResultChunkWriter<NodeQueryResult>>(
+            move(nodesResult),
+            handlerOperation->GetSerializerFlags(),
+            HttpGatewayConfig::GetConfig().ResponseChunkSize);
+
+        if (handlerOperation->Uri.ApiVersion != Constants::V1ApiVersion)
+        {
+            error = chunkWriter->InitializePagedList<NodeList>(pagingStatus ? pagingStatus->TakeContinuationToken() : wstring());
+            if (!error.IsSuccess())
+            {
+                handlerOperation->OnError(operation->Parent, error);
+                return;
+            }
+        }
+
+        handlerOperation->OnSuccess(operation->Parent, move(chunkWriter));
+        return;
+    }
+#endif
+
     ByteBufferUPtr bufferUPtr = make_unique<ByteBuffer>();
     if (handlerOperation->Uri.ApiVersion == Constants::V1ApiVersion)
     {
@@ -0,0 +1,214 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+#include <fstream>
+
+using namespace HttpGateway;
+
+namespace HttpGateway
+{
+    using namespace std;
+    using namespace Common;
+    using namespace ServiceModel;
+
+    class QueryResultChunkWriterTest
+    {
+    protected:
+        static vector<NodeQueryResult> CreateNodes(size_t count);
+        static ErrorCode ReadAllChunks(ResponseChunkWriter & writer, __out string & body, __out size_t & chunkCount);
+        static void RunStreamingBenchmark(size_t nodeCount);
+
+        // Reads a "<name>: <value> kB" entry from /proc/self/status
+        static int64 GetProcessStatusKb(string const & name);
+        static void ResetPeakResidentSetSize();
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(QueryResultChunkWriterTestSuite, QueryResultChunkWriterTest)
+
+    BOOST_AUTO_TEST_CASE(ArrayMatchesSerializedList)
+    {
+        auto nodes = CreateNodes(100);
+
+        ByteBufferUPtr expected;
+        VERIFY_IS_TRUE(JsonHelper::Serialize(nodes, expected).IsSuccess());
+
+        QueryResultChunkWriter<NodeQueryResult> writer(move(nodes), JsonSerializerFlags::Default, 1024);
+
+        string body;
+        size_t chunkCount;
+        VERIFY_IS_TRUE(ReadAllChunks(writer, body, chunkCount).IsSuccess());
+
+        VERIFY_IS_TRUE(chunkCount > 1);
+        VERIFY_IS_TRUE(body == string(expected->begin(), expected->end()));
+    }
+
+    BOOST_AUTO_TEST_CASE(PagedListMatchesSerializedList)
+    {
+        NodeList list;
+        list.ContinuationToken = L"Node99";
+        list.Items = CreateNodes(100);
+
+        ByteBufferUPtr expected;
+        VERIFY_IS_TRUE(JsonHelper::Serialize(list, expected).IsSuccess());
+
+        QueryResultChunkWriter<NodeQueryResult> writer(CreateNodes(100), JsonSerializerFlags::Default, 1024);
+        VERIFY_IS_TRUE(writer.InitializePagedList<NodeList>(wstring(L"Node99")).IsSuccess());
+
+        string body;
+        size_t chunkCount;
+        VERIFY_IS_TRUE(ReadAllChunks(writer, body, chunkCount).IsSuccess());
+
+        VERIFY_IS_TRUE(chunkCount > 1);
+        VERIFY_IS_TRUE(body == string(expected->begin(), expected->end()));
+    }
+
+    BOOST_AUTO_TEST_CASE(EmptyList)
+    {
+        QueryResultChunkWriter<NodeQueryResult> writer(vector<NodeQueryResult>(), JsonSerializerFlags::Default, 1024);
+
+        string body;
+        size_t chunkCount;
+        VERIFY_IS_TRUE(ReadAllChunks(writer, body, chunkCount).IsSuccess());
+
+        VERIFY_ARE_EQUAL(1u, chunkCount);
+        VERIFY_IS_TRUE(body == "[]");
+    }
+
+    BOOST_AUTO_TEST_CASE(StreamingPerf_100K, * boost::unit_test::disabled())
+    {
+        RunStreamingBenchmark(100000);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    vector<NodeQueryResult> QueryResultChunkWriterTest::CreateNodes(size_t count)
+    {
+        vector<NodeQueryResult> nodes;
+        for (size_t i = 0; i < count; ++i)
+        {
+            nodes.push_back(NodeQueryResult());
+        }
+
+        return nodes;
+    }
+
+    ErrorCode QueryResultChunkWriterTest::ReadAllChunks(ResponseChunkWriter & writer, __out string & body, __out size_t & chunkCount)
+    {
+        body.clear();
+        chunkCount = 0;
+
+        while (!writer.IsCompleted)
+        {
+            ByteBufferUPtr chunk;
+            auto error = writer.GetNextChunk(chunk);
+            if (!error.IsSuccess())
+            {
+                return error;
+            }
+
+            body.append(chunk->begin(), chunk->end());
+            ++chunkCount;
+        }
+
+        return ErrorCode::Success();
+    }
+
+    void QueryResultChunkWriterTest::RunStreamingBenchmark(size_t nodeCount)
+    {
+        // Buffered: the whole body is serialized before the first byte can be sent.
+        {
+            auto nodes = CreateNodes(nodeCount);
+            ResetPeakResidentSetSize();
+            int64 startRss = GetProcessStatusKb("VmRSS:");
+
+            Stopwatch stopwatch;
+            stopwatch.Start();
+
+            NodeList list;
+            list.Items = move(nodes);
+
+            ByteBufferUPtr body;
+            VERIFY_IS_TRUE(JsonHelper::Serialize(list, body).IsSuccess());
+
+            stopwatch.Stop();
+
+            Trace.WriteInfo(
+                "QueryResultChunkWriterTestSource",
+                "Buffered: Items={0}, Bytes={1}, FirstByte={2} ms, Total={2} ms, PeakRssGrowth={3} kB",
+                nodeCount,
+                body->size(),
+                stopwatch.ElapsedMilliseconds,
+                GetProcessStatusKb("VmHWM:") - startRss);
+        }
+
+        // Chunked: only the current chunk is held in addition to the query result.
+        {
+            auto nodes = CreateNodes(nodeCount);
+            ResetPeakResidentSetSize();
+            int64 startRss = GetProcessStatusKb("VmRSS:");
+
+            Stopwatch stopwatch;
+            stopwatch.Start();
+
+            QueryResultChunkWriter<NodeQueryResult> writer(move(nodes), JsonSerializerFlags::Default, HttpGatewayConfig::GetConfig().ResponseChunkSize);
+            VERIFY_IS_TRUE(writer.InitializePagedList<NodeList>(wstring()).IsSuccess());
+
+            int64 firstByteMilliseconds = -1;
+            size_t byteCount = 0;
+            size_t chunkCount = 0;
+            while (!writer.IsCompleted)
+            {
+                ByteBufferUPtr chunk;
+                VERIFY_IS_TRUE(writer.GetNextChunk(chunk).IsSuccess());
+
+                if (firstByteMilliseconds < 0)
+                {
+                    firstByteMilliseconds = stopwatch.ElapsedMilliseconds;
+                }
+
+                byteCount += chunk->size();
+                ++chunkCount;
+            }
+
+            stopwatch.Stop();
+
+            Trace.WriteInfo(
+                "QueryResultChunkWriterTestSource",
+                "Chunked: Items={0}, Bytes={1}, Chunks={2}, FirstByte={3} ms, Total={4} ms, PeakRssGrowth={5} kB",
+                nodeCount,
+                byteCount,
+                chunkCount,
+                firstByteMilliseconds,
+                stopwatch.ElapsedMilliseconds,
+                GetProcessStatusKb("VmHWM:") - startRss);
+        }
+    }
+
+    int64 QueryResultChunkWriterTest::GetProcessStatusKb(string const & name)
+    {
+        ifstream status("/proc/self/status");
+        string line;
+        while (getline(status, line))
+        {
+            if (line.compare(0, name.size(), name) == 0)
+            {
+                return atoll(line.c_str() + name.size());
+            }
+        }
+
+        return 0;
+    }
+
+    void QueryResultChunkWriterTest::ResetPeakResidentSetSize()
+    {
+        // Writing 5 to clear_refs resets VmHWM to the current resident set size
+        ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+    }
+}
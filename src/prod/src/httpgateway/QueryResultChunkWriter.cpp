@@ -0,0 +1,65 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace std;
+using namespace Common;
+using namespace HttpGateway;
+
+ResponseChunkWriter::ResponseChunkWriter(size_t chunkSize)
+    : listStart_()
+    , listEnd_()
+    , chunkSize_(chunkSize)
+    , nextItem_(0)
+    , isStarted_(false)
+    , isCompleted_(false)
+{
+}
+
+ErrorCode ResponseChunkWriter::GetNextChunk(__out ByteBufferUPtr & chunk)
+{
+    if (isCompleted_)
+    {
+        return ErrorCodeValue::InvalidState;
+    }
+
+    auto chunkUPtr = make_unique<ByteBuffer>();
+    chunkUPtr->reserve(chunkSize_);
+
+    if (!isStarted_)
+    {
+        chunkUPtr->insert(chunkUPtr->end(), listStart_.begin(), listStart_.end());
+        isStarted_ = true;
+    }
+
+    size_t itemCount = GetItemCount();
+    while (nextItem_ < itemCount && chunkUPtr->size() < chunkSize_)
+    {
+        ByteBufferUPtr itemBytes;
+        auto error = SerializeItem(nextItem_, itemBytes);
+        if (!error.IsSuccess())
+        {
+            return error;
+        }
+
+        if (nextItem_ > 0)
+        {
+            chunkUPtr->push_back(',');
+        }
+
+        chunkUPtr->insert(chunkUPtr->end(), itemBytes->begin(), itemBytes->end());
+        ++nextItem_;
+    }
+
+    if (nextItem_ == itemCount)
+    {
+        chunkUPtr->insert(chunkUPtr->end(), listEnd_.begin(), listEnd_.end());
+        isCompleted_ = true;
+    }
+
+    chunk = move(chunkUPtr);
+    return ErrorCode::Success();
+}
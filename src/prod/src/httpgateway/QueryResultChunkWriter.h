@@ -0,0 +1,112 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace HttpGateway
+{
+    //
+    // Serializes a list response a few items at a time, so that a large query result can be sent as a
+    // chunked response without first building the whole json body. The concatenated chunks are identical
+    // to the output of JsonHelper::Serialize for the same list.
+    //
+    class ResponseChunkWriter
+    {
+        DENY_COPY(ResponseChunkWriter)
+
+    public:
+        virtual ~ResponseChunkWriter() {}
+
+        __declspec(property(get=get_IsCompleted)) bool IsCompleted;
+        bool get_IsCompleted() const { return isCompleted_; }
+
+        //
+        // Serializes items until the chunk reaches the chunk size. The first chunk starts with the beginning
+        // of the list and the last chunk ends with the end of the list.
+        //
+        Common::ErrorCode GetNextChunk(__out Common::ByteBufferUPtr & chunk);
+
+    protected:
+        explicit ResponseChunkWriter(size_t chunkSize);
+
+        virtual size_t GetItemCount() const = 0;
+        virtual Common::ErrorCode SerializeItem(size_t index, __out Common::ByteBufferUPtr & itemBytes) = 0;
+
+        // The json that comes before the first item and after the last item
+        std::string listStart_;
+        std::string listEnd_;
+
+    private:
+        size_t chunkSize_;
+        size_t nextItem_;
+        bool isStarted_;
+        bool isCompleted_;
+    };
+
+    template <typename TItem>
+    class QueryResultChunkWriter : public ResponseChunkWriter
+    {
+        DENY_COPY(QueryResultChunkWriter)
+
+    public:
+        //
+        // By default the items are written as a bare json array, which is the format of the V1 api.
+        //
+        QueryResultChunkWriter(std::vector<TItem> && items, Common::JsonSerializerFlags serializerFlags, size_t chunkSize)
+            : ResponseChunkWriter(chunkSize)
+            , items_(std::move(items))
+            , serializerFlags_(serializerFlags)
+        {
+            listStart_ = "[";
+            listEnd_ = "]";
+        }
+
+        //
+        // Writes the items as a paged list object (QUERY_JSON_LIST), i.e. {"ContinuationToken":...,"Items":[...]}.
+        //
+        template <typename TList>
+        Common::ErrorCode InitializePagedList(std::wstring && continuationToken)
+        {
+            TList list;
+            list.ContinuationToken = std::move(continuationToken);
+
+            Common::ByteBufferUPtr bytes;
+            auto error = Common::JsonHelper::Serialize(list, bytes, serializerFlags_);
+            if (!error.IsSuccess())
+            {
+                return error;
+            }
+
+            // The items are the last property, so the list without items ends with an empty array.
+            static char const EmptyItemsEnd[] = "[]}";
+            size_t const emptyItemsEndLength = sizeof(EmptyItemsEnd) - 1;
+            if (bytes->size() < emptyItemsEndLength ||
+                memcmp(bytes->data() + bytes->size() - emptyItemsEndLength, EmptyItemsEnd, emptyItemsEndLength) != 0)
+            {
+                return Common::ErrorCodeValue::SerializationError;
+            }
+
+            listStart_.assign(bytes->begin(), bytes->end() - (emptyItemsEndLength - 1));
+            listEnd_ = "]}";
+
+            return Common::ErrorCode::Success();
+        }
+
+    protected:
+        size_t GetItemCount() const override
+        {
+            return items_.size();
+        }
+
+        Common::ErrorCode SerializeItem(size_t index, __out Common::ByteBufferUPtr & itemBytes) override
+        {
+            return Common::JsonHelper::Serialize(items_[index], itemBytes, serializerFlags_);
+        }
+
+    private:
+        std::vector<TItem> items_;
+        Common::JsonSerializerFlags serializerFlags_;
+    };
+}
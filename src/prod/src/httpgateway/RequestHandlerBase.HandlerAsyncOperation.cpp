@@ -276,6 +276,112 @@ void RequestHandlerBase::HandlerAsyncOperation::OnSuccess(AsyncOperationSPtr con
         thisSPtr);
 }
 
+bool RequestHandlerBase::HandlerAsyncOperation::IsChunkedResponseEnabled(size_t itemCount) const
+{
+#if defined(PLATFORM_UNIX)
+    uint threshold = HttpGatewayConfig::GetConfig().ChunkedResponseItemThreshold;
+    return (threshold > 0 && itemCount >= threshold);
+#else
+    // The KTL transport leaves the chunk encoding to the caller, so query results are always sent as a single body.
+    UNREFERENCED_PARAMETER(itemCount);
+    return false;
+#endif
+}
+
+#if defined(PLATFORM_UNIX)
+void RequestHandlerBase::HandlerAsyncOperation::OnSuccess(AsyncOperationSPtr const& thisSPtr, __in ResponseChunkWriterUPtr chunkWriter)
+{
+    auto error = SetContentTypeResponseHeaders(Constants::JsonContentType);
+
+    if (!error.IsSuccess())
+    {
+        TryComplete(thisSPtr, error);
+        return;
+    }
+
+    chunkWriter_ = move(chunkWriter);
+
+    // Bounds the whole body, so a client that stops reading cannot hold the request open
+    chunkedResponseTimeoutHelper_ = make_unique<TimeoutHelper>(timeout_);
+
+    AsyncOperationSPtr operation = messageContext_->BeginSendResponseHeaders(
+        ErrorCode::Success(),
+        [this](AsyncOperationSPtr const& operation)
+    {
+        this->OnSendResponseHeadersComplete(operation, false);
+    },
+        thisSPtr);
+
+    OnSendResponseHeadersComplete(operation, true);
+}
+
+void RequestHandlerBase::HandlerAsyncOperation::OnSendResponseHeadersComplete(AsyncOperationSPtr const& operation, __in bool expectedCompletedSynchronously)
+{
+    if (operation->CompletedSynchronously != expectedCompletedSynchronously) { return; }
+
+    auto error = messageContext_->EndSendResponseHeaders(operation);
+    if (!error.IsSuccess())
+    {
+        TryComplete(operation->Parent, error);
+        return;
+    }
+
+    SendNextResponseChunk(operation->Parent);
+}
+
+void RequestHandlerBase::HandlerAsyncOperation::SendNextResponseChunk(AsyncOperationSPtr const& thisSPtr)
+{
+    ByteBufferUPtr chunk;
+    auto error = chunkWriter_->GetNextChunk(chunk);
+    if (!error.IsSuccess())
+    {
+        // The status line has already been sent, so the response is aborted. Ending the body here
+        // would give the client a truncated body with a success status.
+        WriteWarning(
+            TraceType,
+            "Serializing response chunk failed with {0} for ClientRequestId {1}.",
+            error,
+            MessageContext.GetClientRequestId());
+
+        messageContext_->AbortResponse(error);
+        TryComplete(thisSPtr, error);
+        return;
+    }
+
+    AsyncOperationSPtr operation = messageContext_->BeginSendResponseChunk(
+        move(chunk),
+        chunkWriter_->IsCompleted,
+        chunkedResponseTimeoutHelper_->GetRemainingTime(),
+        [this](AsyncOperationSPtr const& operation)
+    {
+        this->OnSendResponseChunkComplete(operation, false);
+    },
+        thisSPtr);
+
+    OnSendResponseChunkComplete(operation, true);
+}
+
+void RequestHandlerBase::HandlerAsyncOperation::OnSendResponseChunkComplete(AsyncOperationSPtr const& operation, __in bool expectedCompletedSynchronously)
+{
+    if (operation->CompletedSynchronously != expectedCompletedSynchronously) { return; }
+
+    auto error = messageContext_->EndSendResponseChunk(operation);
+    if (!error.IsSuccess())
+    {
+        TryComplete(operation->Parent, error);
+        return;
+    }
+
+    if (chunkWriter_->IsCompleted)
+    {
+        TryComplete(operation->Parent, ErrorCode::Success());
+        return;
+    }
+
+    SendNextResponseChunk(operation->Parent);
+}
+#endif
+
 ErrorCode RequestHandlerBase::HandlerAsyncOperation::End(__in AsyncOperationSPtr const& operation)
 {
     auto thisPtr = AsyncOperation::End<HandlerAsyncOperation>(operation);
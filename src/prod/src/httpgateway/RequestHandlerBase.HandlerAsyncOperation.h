@@ -27,6 +27,10 @@ namespace HttpGateway
             , messageContext_(std::move(messageContext))
             , owner_(owner)
             , timeout_(Common::TimeSpan::FromMinutes(Constants::DefaultFabricTimeoutMin))
+#if defined(PLATFORM_UNIX)
+            , chunkWriter_()
+            , chunkedResponseTimeoutHelper_()
+#endif
         {
         }
 
@@ -37,6 +41,15 @@ namespace HttpGateway
         void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferUPtr body);
         void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferUPtr body, __in std::wstring const& contentType);
         void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in Common::ByteBufferUPtr body, __in USHORT statusCode, __in std::wstring const& statusDesc);
+#if defined(PLATFORM_UNIX)
+        void OnSuccess(Common::AsyncOperationSPtr const& thisSPtr, __in ResponseChunkWriterUPtr chunkWriter);
+#endif
+
+        //
+        // Whether a query result with the given number of items is sent as a chunked response by
+        // passing a ResponseChunkWriter to OnSuccess.
+        //
+        bool IsChunkedResponseEnabled(size_t itemCount) const;
 
         __declspec(property(get = get_MessageContext)) HttpServer::IRequestMessageContext &MessageContext;
         __declspec(property(get = get_MessageContextUPtr)) HttpServer::IRequestMessageContextUPtr &MessageContextUPtr;
@@ -110,6 +123,12 @@ namespace HttpGateway
 
         void UpdateRequestTimeout();
 
+#if defined(PLATFORM_UNIX)
+        void OnSendResponseHeadersComplete(Common::AsyncOperationSPtr const& operation, __in bool expectedCompletedSynchronously);
+        void SendNextResponseChunk(Common::AsyncOperationSPtr const& thisSPtr);
+        void OnSendResponseChunkComplete(Common::AsyncOperationSPtr const& operation, __in bool expectedCompletedSynchronously);
+#endif
+
         // Set Content-Type and X-Content-Type-Options headers on the response
         Common::ErrorCode SetContentTypeResponseHeaders(__in std::wstring const& contentType);
 
@@ -125,6 +144,11 @@ namespace HttpGateway
         RequestHandlerBase & owner_;
         FabricClientWrapperSPtr client_;
 
+#if defined(PLATFORM_UNIX)
+        ResponseChunkWriterUPtr chunkWriter_;
+        std::unique_ptr<Common::TimeoutHelper> chunkedResponseTimeoutHelper_;
+#endif
+
 #if !defined (PLATFORM_UNIX)
         std::unordered_map<std::wstring, std::wstring> additionalHeaders_;
         std::wstring serviceName_;
@@ -489,6 +489,101 @@ class OverlayLog;
 class OverlayManager;
 class LogStreamOpenGateContext;
 
+//
+// KIoBufferElementPool keeps free lists of page aligned buffers for
+// the element sizes used by the ThrottledKIoBufferAllocator; each
+// multiple of 4K up to the 64K allocation extent is its own size
+// class. The free lists are kept per processor so that the write
+// path of many streams does not contend on a single lock and buffers
+// are reused on the processor (and NUMA node) that last touched them.
+//
+// Elements handed out by the pool reference a cached buffer and give
+// it back to the free list of the current processor when the last
+// reference to the element goes away. The pool does not take part in
+// the throttle accounting; the memory it caches is bounded by
+// _MaxCachedBytesPerShard for each processor.
+//
+class KIoBufferElementPool : public KObject<KIoBufferElementPool>, public KShared<KIoBufferElementPool>
+{
+    K_FORCE_SHARED(KIoBufferElementPool);
+
+    friend class PooledKIoBufferElement;
+
+    public:
+        static NTSTATUS Create(
+            __in KAllocator& Allocator,
+            __in ULONG AllocationTag,
+            __out KIoBufferElementPool::SPtr& Pool
+        );
+
+        //
+        // Returns an element of exactly Size bytes. Sizes that are not
+        // a multiple of 4K or are larger than the allocation extent are
+        // not pooled and are allocated directly.
+        //
+        NTSTATUS AllocateElement(
+            __in ULONG Size,
+            __out KIoBufferElement::SPtr& IoBufferElement
+        );
+
+        //
+        // Frees all cached buffers and stops caching buffers that are
+        // returned afterwards.
+        //
+        VOID Shutdown();
+
+        inline LONGLONG GetHitCount()
+        {
+            return(_HitCount);
+        }
+
+        inline LONGLONG GetMissCount()
+        {
+            return(_MissCount);
+        }
+
+        static const ULONG _BlockSize = 0x1000;
+        static const ULONG _MaxPooledSize = 64 * 1024;
+        static const ULONG _NumberOfSizeClasses = _MaxPooledSize / _BlockSize;
+        static const ULONG _MaxCachedElementsPerSizeClass = 8;
+        static const ULONG _MaxCachedBytesPerShard = 1024 * 1024;
+        static const ULONG _NumberOfShards = 64;
+
+    private:
+        struct Shard
+        {
+            KSpinLock Lock;
+            ULONG CachedBytes;
+            ULONG Count[_NumberOfSizeClasses];
+            KIoBufferElement* Elements[_NumberOfSizeClasses][_MaxCachedElementsPerSizeClass];
+        };
+
+        static ULONG GetCurrentShardIndex();
+
+        VOID ReturnElement(
+            __in KIoBufferElement::SPtr& CachedElement
+        );
+
+        VOID FreeCachedElements();
+
+    private:
+        BOOLEAN _ShuttingDown;
+        LONGLONG _HitCount;
+        LONGLONG _MissCount;
+        Shard _Shards[_NumberOfShards];
+};
+
+class PooledKIoBufferElement : public KIoBufferElement
+{
+    K_FORCE_SHARED(PooledKIoBufferElement);
+
+    friend KIoBufferElementPool;
+
+    private:
+        KIoBufferElementPool::SPtr _Pool;
+        KIoBufferElement::SPtr _CachedElement;
+};
+
 class ThrottledKIoBufferAllocator : public KObject<ThrottledKIoBufferAllocator>, public KShared<ThrottledKIoBufferAllocator>
 {
     K_FORCE_SHARED(ThrottledKIoBufferAllocator);
@@ -675,6 +770,11 @@ class ThrottledKIoBufferAllocator : public KObject<ThrottledKIoBufferAllocator>,
         return(&_TotalAllocationLimit);
     }
 
+    inline KIoBufferElementPool& GetElementPool()
+    {
+        return(*_ElementPool);
+    }
+
     VOID SetAllocationTimeoutInMs(ULONG AllocationTimeoutInMs)
     {
         _AllocationTimeoutInMs = AllocationTimeoutInMs;
@@ -728,6 +828,7 @@ class ThrottledKIoBufferAllocator : public KObject<ThrottledKIoBufferAllocator>,
         static const ULONG _ThrottleLinkageOffset;
         KNodeList<AsyncAllocateKIoBufferContext> _WaitingAllocsList;
         LONGLONG _CurrentAllocations;
+        KIoBufferElementPool::SPtr _ElementPool;
 };
 
 class OverlayStreamBase : public WrappedServiceBase
@@ -2545,6 +2545,215 @@ OverlayManager::CreateAsyncCloseLogContext(
 }
 
 
+//
+// KIoBufferElementPool
+//
+KIoBufferElementPool::KIoBufferElementPool() :
+    _ShuttingDown(FALSE),
+    _HitCount(0),
+    _MissCount(0)
+{
+    for (ULONG i = 0; i < _NumberOfShards; i++)
+    {
+        _Shards[i].CachedBytes = 0;
+        for (ULONG j = 0; j < _NumberOfSizeClasses; j++)
+        {
+            _Shards[i].Count[j] = 0;
+        }
+    }
+}
+
+KIoBufferElementPool::~KIoBufferElementPool()
+{
+    FreeCachedElements();
+}
+
+NTSTATUS
+KIoBufferElementPool::Create(
+    __in KAllocator& Allocator,
+    __in ULONG AllocationTag,
+    __out KIoBufferElementPool::SPtr& Pool
+    )
+{
+    NTSTATUS status;
+    KIoBufferElementPool::SPtr pool;
+
+    pool = _new(AllocationTag, Allocator) KIoBufferElementPool();
+    if (pool == nullptr)
+    {
+        status = STATUS_INSUFFICIENT_RESOURCES;
+        KTraceOutOfMemory( 0, status, NULL, 0, 0);
+        return(status);
+    }
+
+    status = pool->Status();
+    if (! NT_SUCCESS(status))
+    {
+        return(status);
+    }
+
+    Pool = Ktl::Move(pool);
+
+    return(STATUS_SUCCESS);
+}
+
+ULONG
+KIoBufferElementPool::GetCurrentShardIndex()
+{
+#if KTL_USER_MODE
+    return(GetCurrentProcessorNumber() % _NumberOfShards);
+#else
+    return(KeGetCurrentProcessorNumberEx(NULL) % _NumberOfShards);
+#endif
+}
+
+NTSTATUS
+KIoBufferElementPool::AllocateElement(
+    __in ULONG Size,
+    __out KIoBufferElement::SPtr& IoBufferElement
+    )
+{
+    NTSTATUS status;
+    KIoBufferElement::SPtr cachedElement;
+    PVOID p;
+
+    if ((Size == 0) || ((Size % _BlockSize) != 0) || (Size > _MaxPooledSize))
+    {
+        return(KIoBufferElement::CreateNew(Size, IoBufferElement, p, GetThisAllocator(), GetThisAllocationTag()));
+    }
+
+    ULONG sizeClass = (Size / _BlockSize) - 1;
+    Shard& shard = _Shards[GetCurrentShardIndex()];
+
+    K_LOCK_BLOCK(shard.Lock)
+    {
+        if (shard.Count[sizeClass] > 0)
+        {
+            shard.Count[sizeClass]--;
+            cachedElement.Attach(shard.Elements[sizeClass][shard.Count[sizeClass]]);
+            shard.Elements[sizeClass][shard.Count[sizeClass]] = nullptr;
+            shard.CachedBytes -= Size;
+        }
+    }
+
+    if (cachedElement)
+    {
+        InterlockedIncrement64(&_HitCount);
+    } else {
+        InterlockedIncrement64(&_MissCount);
+        status = KIoBufferElement::CreateNew(Size, cachedElement, p, GetThisAllocator(), GetThisAllocationTag());
+        if (! NT_SUCCESS(status))
+        {
+            return(status);
+        }
+    }
+
+    PooledKIoBufferElement::SPtr element = _new(GetThisAllocationTag(), GetThisAllocator()) PooledKIoBufferElement();
+    if (element == nullptr)
+    {
+        status = STATUS_INSUFFICIENT_RESOURCES;
+        KTraceOutOfMemory( 0, status, NULL, 0, 0);
+        ReturnElement(cachedElement);
+        return(status);
+    }
+
+    status = element->Status();
+    if (! NT_SUCCESS(status))
+    {
+        ReturnElement(cachedElement);
+        return(status);
+    }
+
+    //
+    // The pooled element only references the cached buffer, the cached
+    // element remains responsible for freeing it
+    //
+    element->_Buffer = (PVOID)cachedElement->GetBuffer();
+    element->_Size = Size;
+    element->_FreeBuffer = FALSE;
+    element->_Pool = this;
+    element->_CachedElement = Ktl::Move(cachedElement);
+
+    IoBufferElement = element.RawPtr();
+
+    return(STATUS_SUCCESS);
+}
+
+VOID
+KIoBufferElementPool::ReturnElement(
+    __in KIoBufferElement::SPtr& CachedElement
+    )
+{
+    ULONG size = CachedElement->QuerySize();
+    ULONG sizeClass = (size / _BlockSize) - 1;
+    Shard& shard = _Shards[GetCurrentShardIndex()];
+
+    if (_ShuttingDown)
+    {
+        //
+        // CachedElement is freed by the caller
+        //
+        return;
+    }
+
+    K_LOCK_BLOCK(shard.Lock)
+    {
+        if ((shard.Count[sizeClass] < _MaxCachedElementsPerSizeClass) &&
+            ((shard.CachedBytes + size) <= _MaxCachedBytesPerShard))
+        {
+            shard.Elements[sizeClass][shard.Count[sizeClass]] = CachedElement.Detach();
+            shard.Count[sizeClass]++;
+            shard.CachedBytes += size;
+        }
+    }
+}
+
+VOID
+KIoBufferElementPool::FreeCachedElements()
+{
+    for (ULONG i = 0; i < _NumberOfShards; i++)
+    {
+        Shard& shard = _Shards[i];
+
+        K_LOCK_BLOCK(shard.Lock)
+        {
+            for (ULONG j = 0; j < _NumberOfSizeClasses; j++)
+            {
+                while (shard.Count[j] > 0)
+                {
+                    shard.Count[j]--;
+                    shard.Elements[j][shard.Count[j]]->Release();
+                    shard.Elements[j][shard.Count[j]] = nullptr;
+                }
+            }
+
+            shard.CachedBytes = 0;
+        }
+    }
+}
+
+VOID
+KIoBufferElementPool::Shutdown()
+{
+    _ShuttingDown = TRUE;
+    FreeCachedElements();
+}
+
+PooledKIoBufferElement::PooledKIoBufferElement()
+{
+}
+
+PooledKIoBufferElement::~PooledKIoBufferElement()
+{
+    //
+    // _FreeBuffer is FALSE so the base destructor leaves the buffer
+    // alone. If the pool does not take the cached element back it is
+    // freed along with this element.
+    //
+    _Pool->ReturnElement(_CachedElement);
+}
+
+
 //
 // AllocateKIoBuffer
 //
@@ -2574,6 +2783,13 @@ ThrottledKIoBufferAllocator::ThrottledKIoBufferAllocator(
 
     status = KTimer::Create(_Timer, GetThisAllocator(), GetThisAllocationTag());
     if (! NT_SUCCESS(status))
+    {
+        SetConstructorStatus(status);
+        return;
+    }
+
+    status = KIoBufferElementPool::Create(GetThisAllocator(), GetThisAllocationTag(), _ElementPool);
+    if (! NT_SUCCESS(status))
     {
         SetConstructorStatus(status);
     }
@@ -2962,13 +3178,17 @@ ThrottledKIoBufferAllocator::AllocateIfPossible(
 
     KIoBuffer::SPtr ioBuffer;
     KIoBufferElement::SPtr ioBufferElement;
-    PVOID p;
 
     status = KIoBuffer::CreateEmpty(ioBuffer, GetThisAllocator(), GetThisAllocationTag());
 
+    //
+    // The elements come from the per processor free lists when
+    // possible. This does not change the accounting above as a pooled
+    // buffer is only counted while it is part of an allocation.
+    //
     for (ULONG i = 0; i < elementCount; i++)
     {
-        status = KIoBufferElement::CreateNew(alloc->GetAllocationExtentSize(), ioBufferElement, p, GetThisAllocator(), GetThisAllocationTag());
+        status = _ElementPool->AllocateElement(alloc->GetAllocationExtentSize(), ioBufferElement);
         if (!NT_SUCCESS(status))
         {
             break;
@@ -2981,7 +3201,7 @@ ThrottledKIoBufferAllocator::AllocateIfPossible(
     {
         if (lastElementSize != 0)
         {
-            status = KIoBufferElement::CreateNew(lastElementSize, ioBufferElement, p, GetThisAllocator(), GetThisAllocationTag());
+            status = _ElementPool->AllocateElement(lastElementSize, ioBufferElement);
             if (NT_SUCCESS(status))
             {
                 ioBuffer->AddIoBufferElement(*ioBufferElement);
@@ -3111,7 +3331,14 @@ VOID ThrottledKIoBufferAllocator::Shutdown()
             AddRef();
             _Timer->Cancel();
         }
-    }   
+    }
+
+    KDbgCheckpointWDataInformational(0, "ThrottledKIoBufferAllocator element pool", STATUS_SUCCESS,
+        (ULONGLONG)this,
+        (ULONGLONG)_ElementPool->GetHitCount(),
+        (ULONGLONG)_ElementPool->GetMissCount(),
+        (ULONGLONG)_CurrentAllocations);
+    _ElementPool->Shutdown();
 }
 
 VOID
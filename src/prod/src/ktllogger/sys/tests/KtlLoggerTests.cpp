@@ -22148,6 +22148,72 @@ VOID ThrottledAllocatorTest(
         throttledAllocator.Reset();
     }
 
+    //
+    // Test 7: Alloc and free repeatedly and verify that the buffer
+    //         elements go through the element pool while the
+    //         throttle accounting is unchanged
+    //
+    {
+#ifdef FEATURE_TEST
+        const ULONG iterations = 100000;
+#else
+        const ULONG iterations = 10000;
+#endif
+        //
+        // One full allocation extent plus a 4K element
+        //
+        ULONG ioBufferSize = ThrottledKIoBufferAllocator::AsyncAllocateKIoBufferContext::GetAllocationExtentSize() + 0x1000;
+        ThrottledKIoBufferAllocator::AsyncAllocateKIoBufferContext::SPtr alloc;
+        ThrottledKIoBufferAllocator::SPtr throttledAllocator;
+        KIoBuffer::SPtr ioBuffer;
+        ULONGLONG startTime;
+        ULONGLONG endTime;
+
+        KtlLogManager::MemoryThrottleLimits memoryThrottleLimits;
+        memoryThrottleLimits.WriteBufferMemoryPoolMax = 4 * ioBufferSize;
+        memoryThrottleLimits.WriteBufferMemoryPoolMin = 4 * ioBufferSize;
+        memoryThrottleLimits.AllocationTimeoutInMs = KtlLogManager::MemoryThrottleLimits::_NoAllocationTimeoutInMs;
+
+        status = ThrottledKIoBufferAllocator::CreateThrottledKIoBufferAllocator(
+            memoryThrottleLimits,
+            *g_Allocator,
+            KTL_TAG_TEST,
+            throttledAllocator);
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+        status = throttledAllocator->CreateAsyncAllocateKIoBufferContext(alloc);
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+        startTime = GetTickCount64();
+        for (ULONG i = 0; i < iterations; i++)
+        {
+            alloc->Reuse();
+            alloc->StartAllocateKIoBuffer(ioBufferSize,
+                                          KtlLogManager::MemoryThrottleLimits::_UseDefaultAllocationTimeoutInMs,
+                                          ioBuffer, NULL, sync);
+            status = sync.WaitForCompletion();
+            VERIFY_IS_TRUE(NT_SUCCESS(status));
+            VERIFY_IS_TRUE(ioBuffer->QuerySize() == ioBufferSize);
+            VERIFY_IS_TRUE(ioBuffer->QueryNumberOfIoBufferElements() == 2);
+
+            ioBuffer = nullptr;
+            throttledAllocator->FreeKIoBuffer(0, ioBufferSize);
+        }
+        endTime = GetTickCount64();
+
+        VERIFY_IS_TRUE(throttledAllocator->GetCurrentAllocations() == 0);
+
+        LONGLONG hitCount = throttledAllocator->GetElementPool().GetHitCount();
+        LONGLONG missCount = throttledAllocator->GetElementPool().GetMissCount();
+        VERIFY_IS_TRUE((hitCount + missCount) == (LONGLONG)(2 * iterations));
+
+        printf("ThrottledAllocatorTest: %d allocations of %d bytes in %lld ms, element pool hits %lld misses %lld\n",
+               iterations, ioBufferSize, (endTime - startTime), hitCount, missCount);
+
+        throttledAllocator->Shutdown();
+        throttledAllocator.Reset();
+    }
+
 }
 #endif
 
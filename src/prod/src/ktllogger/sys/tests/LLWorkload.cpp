@@ -124,6 +124,8 @@ NTSTATUS StartLLWorkload(
 
     llWorkloadInfo->AverageWriteLatencyInMs = 0;
     llWorkloadInfo->HighestWriteLatencyInMs = 0;
+    llWorkloadInfo->TotalRecordsWritten = 0;
+    llWorkloadInfo->AppendsPerSecond = 0;
         
     //
     // Open up our log container
@@ -254,6 +256,7 @@ NTSTATUS StartLLWorkload(
     //
     // Timebound this test
     //
+    ULONGLONG startTime = GetTickCount64();
     ULONGLONG endTime;
     if (TestDurationInSeconds == 0)
     {
@@ -466,6 +469,7 @@ NTSTATUS StartLLWorkload(
                                              &latency);
             VERIFY_IS_TRUE(NT_SUCCESS(status));
             llWorkloadInfo->TotalBytesWritten += (KLogicalLogInformation::FixedMetadataSize + iodata->QuerySize());
+            llWorkloadInfo->TotalRecordsWritten++;
 
             if (latency > llWorkloadInfo->HighestWriteLatencyInMs)
             {
@@ -495,6 +499,25 @@ NTSTATUS StartLLWorkload(
         completionSignal.WaitForCompletion(INFINITE);        
     };
 
+    //
+    // Report the append rate. The write path allocates its coalescing
+    // buffers from the shim's throttled allocator so this reflects the
+    // allocator cost along with the write latency.
+    //
+    ULONGLONG elapsedInMs = GetTickCount64() - startTime;
+    if (elapsedInMs > 0)
+    {
+        llWorkloadInfo->AppendsPerSecond = (llWorkloadInfo->TotalRecordsWritten * 1000) / elapsedInMs;
+    }
+
+    _printf("LLWorkload: %lld appends in %lld ms, %lld appends/sec, %lld bytes, average latency %lld ms, highest latency %lld ms\n",
+            llWorkloadInfo->TotalRecordsWritten,
+            elapsedInMs,
+            llWorkloadInfo->AppendsPerSecond,
+            llWorkloadInfo->TotalBytesWritten,
+            llWorkloadInfo->AverageWriteLatencyInMs,
+            llWorkloadInfo->HighestWriteLatencyInMs);
+
     //
     // All done, close up the log container
     //
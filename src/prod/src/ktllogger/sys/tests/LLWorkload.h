@@ -10,6 +10,8 @@ typedef struct
     ULONGLONG AverageWriteLatencyInMs;
     ULONGLONG HighestWriteLatencyInMs;
 	ULONGLONG TotalBytesWritten;
+    ULONGLONG TotalRecordsWritten;
+    ULONGLONG AppendsPerSecond;
 } LLWORKLOADSHAREDINFO;
 
 NTSTATUS StartLLWorkload(    